@@ -1,19 +1,31 @@
 #include "LvglTask.h"
 #include "hal/SdlDisplay.h"
 #include "hal/SdlKeyboard.h"
-#include "hal/SimulatorPower.h"
 #include "hal/SimulatorSdCard.h"
 
 #include <src/lv_init.h> // LVGL
 #include <Tactility/hal/Configuration.h>
+#include <Tactility/hal/power/SimulatedPowerDevice.h>
+#include <Tactility/service/development/LvglScreenSource.h>
+#include <Tactility/service/development/ScreenStreamServer.h>
 
 #define TAG "hardware"
 
 using namespace tt::hal;
+using tt::service::development::LvglScreenSource;
+using tt::service::development::ScreenStreamServer;
+
+/** The development service only runs on devices: this serves the same screen stream to local clients */
+static std::unique_ptr<ScreenStreamServer> screenStreamServer;
 
 static bool initBoot() {
     lv_init();
     lvgl_task_start();
+    screenStreamServer = std::make_unique<ScreenStreamServer>(
+        std::make_shared<LvglScreenSource>(),
+        ScreenStreamServer::Configuration { .address = "127.0.0.1" }
+    );
+    screenStreamServer->start();
     return true;
 }
 
@@ -32,7 +44,12 @@ static std::vector<std::shared_ptr<Device>> createDevices() {
     return {
         std::make_shared<SdlDisplay>(),
         std::make_shared<SdlKeyboard>(),
-        std::make_shared<SimulatorPower>(),
+        std::make_shared<power::SimulatedPowerDevice>(power::SimulatedPowerDevice::Configuration {
+            .batteryVoltage = 4032,
+            .noise = 20,
+            .current = 42,
+            .isExternalPowerConnected = true
+        }),
         std::make_shared<SimulatorSdCard>()
     };
 }
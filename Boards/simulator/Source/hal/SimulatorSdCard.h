@@ -25,11 +25,13 @@ public:
     bool mount(const std::string& newMountPath) override {
         state = State::Mounted;
         mountPath = newMountPath;
+        onMounted(mountPath);
         return true;
     }
 
     bool unmount() override {
         state = State::Unmounted;
+        onUnmounted(mountPath);
         mountPath = "";
         return true;
     }
@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""
+Converts PNG images into a Tactility asset pack: a single file with pre-decoded images
+in a color format that LVGL can draw directly, so the device doesn't have to decode PNG files.
+
+Usage: asset-pack.py --format rgb565a8|argb8888 --root <dir> --output <file> <path> [<path> ...]
+
+Paths are files or directories (searched recursively for PNG files), relative to the root directory.
+Images are stored by their path relative to the root (e.g. "service/Statusbar/assets/power_0.png").
+Images that only contain a single color are stored as A8 (alpha only) with the color in the index.
+
+Pack layout (little-endian):
+  header:  magic "TTAP", u16 version, u16 entry count, u32 names offset, u32 names size
+  entries: u32 name hash (FNV-1a), u32 name offset, u16 width, u16 height, u16 stride,
+           u8 color format (lv_color_format_t), u8 reserved, u32 color (0xRRGGBB), u32 data offset, u32 data size
+  names:   null-terminated UTF-8 strings
+  data:    pixel data, every image aligned to 4 bytes
+Entries are sorted by hash and then by name.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+PACK_MAGIC = b"TTAP"
+PACK_VERSION = 1
+HEADER_FORMAT = "<4sHHII"
+ENTRY_FORMAT = "<IIHHHBBIII"
+
+# Values of lv_color_format_t
+COLOR_FORMAT_A8 = 0x0E
+COLOR_FORMAT_ARGB8888 = 0x10
+COLOR_FORMAT_RGB565A8 = 0x14
+
+
+def fnv1a(data):
+    result = 0x811C9DC5
+    for value in data:
+        result ^= value
+        result = (result * 0x01000193) & 0xFFFFFFFF
+    return result
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa = abs(p - a)
+    pb = abs(p - b)
+    pc = abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    if pb <= pc:
+        return b
+    return c
+
+
+def decode_png(path):
+    """Returns (width, height, pixels) where pixels is a list of (r, g, b, a) tuples"""
+    with open(path, "rb") as file:
+        data = file.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError(f"{path}: not a PNG file")
+
+    offset = 8
+    compressed = b""
+    palette = []
+    transparency = b""
+    width = height = bit_depth = color_type = interlace = None
+    while offset < len(data):
+        length, chunk_type = struct.unpack(">I4s", data[offset:offset + 8])
+        chunk = data[offset + 8:offset + 8 + length]
+        offset += 12 + length
+        if chunk_type == b"IHDR":
+            width, height, bit_depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif chunk_type == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif chunk_type == b"tRNS":
+            transparency = chunk
+        elif chunk_type == b"IDAT":
+            compressed += chunk
+        elif chunk_type == b"IEND":
+            break
+
+    if bit_depth != 8 or interlace != 0:
+        raise ValueError(f"{path}: only 8 bit, non-interlaced images are supported")
+    channels = { 0: 1, 2: 3, 3: 1, 4: 2, 6: 4 }.get(color_type)
+    if channels is None:
+        raise ValueError(f"{path}: unsupported color type {color_type}")
+
+    raw = zlib.decompress(compressed)
+    row_size = width * channels
+    previous = bytearray(row_size)
+    pixels = []
+    for y in range(height):
+        start = y * (row_size + 1)
+        filter_type = raw[start]
+        row = bytearray(raw[start + 1:start + 1 + row_size])
+        for x in range(row_size):
+            a = row[x - channels] if x >= channels else 0
+            b = previous[x]
+            c = previous[x - channels] if x >= channels else 0
+            if filter_type == 1:
+                row[x] = (row[x] + a) & 0xFF
+            elif filter_type == 2:
+                row[x] = (row[x] + b) & 0xFF
+            elif filter_type == 3:
+                row[x] = (row[x] + ((a + b) >> 1)) & 0xFF
+            elif filter_type == 4:
+                row[x] = (row[x] + paeth(a, b, c)) & 0xFF
+        for x in range(width):
+            values = row[x * channels:(x + 1) * channels]
+            if color_type == 0:
+                pixels.append((values[0], values[0], values[0], 255))
+            elif color_type == 2:
+                pixels.append((values[0], values[1], values[2], 255))
+            elif color_type == 3:
+                alpha = transparency[values[0]] if values[0] < len(transparency) else 255
+                pixels.append(palette[values[0]] + (alpha,))
+            elif color_type == 4:
+                pixels.append((values[0], values[0], values[0], values[1]))
+            else:
+                pixels.append(tuple(values))
+        previous = row
+
+    return width, height, pixels
+
+
+def get_single_color(pixels):
+    """Returns the color of all visible pixels, or None when there are several colors"""
+    colors = { (r, g, b) for (r, g, b, a) in pixels if a > 0 }
+    if len(colors) > 1:
+        return None
+    return colors.pop() if colors else (0, 0, 0)
+
+
+def encode_image(width, height, pixels, color_format):
+    """Returns (color format, stride, color, data)"""
+    color = get_single_color(pixels)
+    if color is not None:
+        data = bytes(a for (_, _, _, a) in pixels)
+        return COLOR_FORMAT_A8, width, (color[0] << 16) | (color[1] << 8) | color[2], data
+
+    if color_format == "rgb565a8":
+        # The RGB565 plane is followed by the alpha plane
+        rgb = bytearray()
+        for (r, g, b, _) in pixels:
+            rgb += struct.pack("<H", ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+        alpha = bytes(a for (_, _, _, a) in pixels)
+        return COLOR_FORMAT_RGB565A8, width * 2, 0, bytes(rgb) + alpha
+    else:
+        data = bytearray()
+        for (r, g, b, a) in pixels:
+            data += bytes((b, g, r, a))
+        return COLOR_FORMAT_ARGB8888, width * 4, 0, bytes(data)
+
+
+def find_images(root, paths):
+    result = []
+    for path in paths:
+        absolute_path = os.path.join(root, path)
+        if os.path.isdir(absolute_path):
+            for directory, _, files in os.walk(absolute_path):
+                for file in files:
+                    if file.lower().endswith(".png"):
+                        result.append(os.path.relpath(os.path.join(directory, file), root))
+        elif os.path.isfile(absolute_path):
+            result.append(path)
+        else:
+            raise ValueError(f"{absolute_path} not found")
+    return sorted({ path.replace(os.sep, "/") for path in result })
+
+
+def create_pack(root, paths, color_format):
+    images = []
+    for name in find_images(root, paths):
+        width, height, pixels = decode_png(os.path.join(root, name))
+        if width > 0xFFFF or height > 0xFFFF:
+            raise ValueError(f"{name}: image is too large")
+        encoded_format, stride, color, data = encode_image(width, height, pixels, color_format)
+        name_bytes = name.encode("utf-8")
+        images.append((fnv1a(name_bytes), name_bytes, width, height, stride, encoded_format, color, data))
+    images.sort(key=lambda image: (image[0], image[1]))
+
+    names = bytearray()
+    name_offsets = []
+    for image in images:
+        name_offsets.append(len(names))
+        names += image[1] + b"\0"
+
+    names_offset = struct.calcsize(HEADER_FORMAT) + len(images) * struct.calcsize(ENTRY_FORMAT)
+    data_offset = (names_offset + len(names) + 3) & ~3
+
+    entries = bytearray()
+    data = bytearray()
+    for image, name_offset in zip(images, name_offsets):
+        name_hash, _, width, height, stride, encoded_format, color, image_data = image
+        entries += struct.pack(
+            ENTRY_FORMAT,
+            name_hash,
+            name_offset,
+            width,
+            height,
+            stride,
+            encoded_format,
+            0,
+            color,
+            data_offset + len(data),
+            len(image_data)
+        )
+        data += image_data
+        data += bytes((4 - len(data) % 4) % 4)
+
+    header = struct.pack(HEADER_FORMAT, PACK_MAGIC, PACK_VERSION, len(images), names_offset, len(names))
+    padding = bytes(data_offset - names_offset - len(names))
+    return header + entries + names + padding + data, len(images)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Create a Tactility asset pack from PNG images")
+    parser.add_argument("--format", choices=["rgb565a8", "argb8888"], required=True, help="color format for multicolor images")
+    parser.add_argument("--root", required=True, help="the directory that image names are relative to")
+    parser.add_argument("--output", required=True, help="the asset pack file to create")
+    parser.add_argument("paths", nargs="+", help="PNG files or directories, relative to the root")
+    arguments = parser.parse_args()
+
+    try:
+        pack, count = create_pack(arguments.root, arguments.paths, arguments.format)
+    except (ValueError, OSError, zlib.error) as error:
+        print(f"asset-pack: {error}", file=sys.stderr)
+        return 1
+
+    output_directory = os.path.dirname(arguments.output)
+    if output_directory:
+        os.makedirs(output_directory, exist_ok=True)
+    with open(arguments.output, "wb") as file:
+        file.write(pack)
+    print(f"asset-pack: {count} images, {len(pack)} bytes -> {arguments.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
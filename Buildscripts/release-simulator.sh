@@ -15,3 +15,6 @@ cp version.txt $target_path
 cp $build_path/Firmware/FirmwareSim $target_path/
 cp -r Data/data $target_path/
 cp -r Data/system $target_path/
+# The simulator uses a 32 bit color depth (see lv_conf.h)
+python3 Buildscripts/asset-pack.py --format argb8888 --root Data/system --output $target_path/system/assets_argb8888.pack \
+    spinner.png app/Launcher/assets service/Statusbar/assets
@@ -24,4 +24,5 @@ public:
 
     bool supportsMetric(MetricType type) const override;
     bool getMetric(MetricType type, MetricData& data) override;
+    bool isChargeLevelEstimatedFromVoltage() const override { return true; }
 };
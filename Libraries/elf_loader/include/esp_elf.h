@@ -12,6 +12,24 @@
 extern "C" {
 #endif
 
+/** @brief Reads parts of an ELF file for esp_elf_relocate_stream() */
+
+typedef struct esp_elf_reader {
+    void *context;                      /*!< user data that is passed to "read" */
+
+    /**
+     * @brief Read bytes from the ELF file.
+     *
+     * @param context - User data
+     * @param offset - Offset in the ELF file
+     * @param buffer - Output buffer
+     * @param size - Amount of bytes to read: less is a failure
+     *
+     * @return 0 if success or other if failed.
+     */
+    int (*read)(void *context, uint32_t offset, void *buffer, uint32_t size);
+} esp_elf_reader_t;
+
 /**
  * @brief Map symbol's address of ELF to physic space.
  *
@@ -41,6 +59,20 @@ int esp_elf_init(esp_elf_t *elf);
  */
 int esp_elf_relocate(esp_elf_t *elf, const uint8_t *pbuf);
 
+/**
+ * @brief Decode and relocate ELF data that is read in parts.
+ *
+ * Sections are read straight into their final memory, so the ELF file doesn't have to fit in memory.
+ *
+ * @param elf - ELF object pointer
+ * @param reader - ELF file reader
+ * @param estimated_peak_memory - Optional output: an estimate of the peak amount of heap memory that the loader used.
+ *                                It is the sum of the requested buffer sizes, without allocator overhead.
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+int esp_elf_relocate_stream(esp_elf_t *elf, const esp_elf_reader_t *reader, uint32_t *estimated_peak_memory);
+
 /**
  * @brief Request running relocated ELF function.
  *
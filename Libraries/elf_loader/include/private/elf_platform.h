@@ -36,6 +36,8 @@ void *esp_elf_malloc(uint32_t n, bool exec);
  */
 void esp_elf_free(void *ptr);
 
+void *esp_elf_malloc_rodata(uint32_t n);
+
 /**
  * @brief Relocates target architecture symbol of ELF
  *
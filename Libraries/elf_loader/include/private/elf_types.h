@@ -230,6 +230,8 @@ typedef struct esp_elf {
 
     unsigned char   *pdata;             /*!< data buffer pointer */
 
+    unsigned char   *prodata;           /*!< read-only data buffer pointer (only used by the streaming loader) */
+
     esp_elf_sec_t   sec[ELF_SECS];      /*!< ".bss", "data", "rodata", ".text" */
 
     int (*entry)(int argc, char *argv[]);               /*!< Entry pointer of ELF */
@@ -24,6 +24,7 @@
 #define stype(_s, _t)               ((_s)->type == (_t))
 #define sflags(_s, _f)              (((_s)->flags & (_f)) == (_f))
 #define ADDR_OFFSET                 (0x400)
+#define ELF_STREAM_RELA_CHUNK       (32)
 
 uintptr_t elf_find_sym_default(const char *sym_name);
 
@@ -52,15 +53,20 @@ uintptr_t elf_find_sym(const char *sym_name) {
  * @return ESP_OK if success or other if failed.
  */
 
-static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
-{
-    uint32_t entry;
-    uint32_t size;
-
-    const elf32_hdr_t *ehdr = (const elf32_hdr_t *)pbuf;
-    const elf32_shdr_t *shdr = (const elf32_shdr_t *)(pbuf + ehdr->shoff);
-    const char *shstrab = (const char *)pbuf + shdr[ehdr->shstrndx].offset;
+/**
+ * @brief Find the sections that are loaded into memory.
+ *
+ * @param elf - ELF object pointer
+ * @param ehdr - ELF header
+ * @param shdr - ELF section headers
+ * @param shstrab - ELF section header string table
+ *
+ * @return ESP_OK if success or other if failed.
+ */
 
+static int esp_elf_find_sections(esp_elf_t *elf, const elf32_hdr_t *ehdr,
+                                 const elf32_shdr_t *shdr, const char *shstrab)
+{
     /* Calculate ELF image size */
 
     for (uint32_t i = 0; i < ehdr->shnum; i++) {
@@ -134,6 +140,51 @@ static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
         return -EINVAL;
     }
 
+    return 0;
+}
+
+/**
+ * @brief Set the ELF entry after the ".text" section was loaded.
+ *
+ * @param elf - ELF object pointer
+ * @param ehdr - ELF header
+ */
+
+static void esp_elf_set_section_entry(esp_elf_t *elf, const elf32_hdr_t *ehdr)
+{
+    uint32_t entry = ehdr->entry + elf->sec[ELF_SEC_TEXT].addr -
+                     elf->sec[ELF_SEC_TEXT].v_addr;
+
+#ifdef CONFIG_ELF_LOADER_CACHE_OFFSET
+    elf->entry = (void *)elf_remap_text(elf, (uintptr_t)entry);
+#else
+    elf->entry = (void *)entry;
+#endif
+}
+
+/**
+ * @brief Load ELF section.
+ *
+ * @param elf - ELF object pointer
+ * @param pbuf - ELF data buffer
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+
+static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
+{
+    int ret;
+    uint32_t size;
+
+    const elf32_hdr_t *ehdr = (const elf32_hdr_t *)pbuf;
+    const elf32_shdr_t *shdr = (const elf32_shdr_t *)(pbuf + ehdr->shoff);
+    const char *shstrab = (const char *)pbuf + shdr[ehdr->shstrndx].offset;
+
+    ret = esp_elf_find_sections(elf, ehdr, shdr, shstrab);
+    if (ret) {
+        return ret;
+    }
+
     elf->ptext = esp_elf_malloc(elf->sec[ELF_SEC_TEXT].size, true);
     if (!elf->ptext) {
         return -ENOMEM;
@@ -207,18 +258,119 @@ static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
         }
     }
 
-    /* Set ELF entry */
+    esp_elf_set_section_entry(elf, ehdr);
 
-    entry = ehdr->entry + elf->sec[ELF_SEC_TEXT].addr -
-            elf->sec[ELF_SEC_TEXT].v_addr;
+    return 0;
+}
 
-#ifdef CONFIG_ELF_LOADER_CACHE_OFFSET
-    elf->entry = (void *)elf_remap_text(elf, (uintptr_t)entry);
-#else
-    elf->entry = (void *)entry;
+/**
+ * @brief Load ELF sections straight from a reader into their final memory.
+ *
+ * ".rodata" and ".data.rel.ro" are placed in a separate block, which goes to PSRAM when it is large enough.
+ *
+ * @param elf - ELF object pointer
+ * @param reader - ELF file reader
+ * @param ehdr - ELF header
+ * @param shdr - ELF section headers
+ * @param shstrab - ELF section header string table
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+
+static int esp_elf_stream_load_section(esp_elf_t *elf, const esp_elf_reader_t *reader,
+                                       const elf32_hdr_t *ehdr, const elf32_shdr_t *shdr,
+                                       const char *shstrab)
+{
+    int ret;
+    uint32_t data_size;
+    uint32_t rodata_size;
+
+    ret = esp_elf_find_sections(elf, ehdr, shdr, shstrab);
+    if (ret) {
+        return ret;
+    }
+
+    elf->ptext = esp_elf_malloc(elf->sec[ELF_SEC_TEXT].size, true);
+    if (!elf->ptext) {
+        return -ENOMEM;
+    }
+
+    elf->sec[ELF_SEC_TEXT].addr = (Elf32_Addr)elf->ptext;
+    if (reader->read(reader->context, elf->sec[ELF_SEC_TEXT].offset, elf->ptext,
+                     elf->sec[ELF_SEC_TEXT].size)) {
+        ret = -EIO;
+        goto fail;
+    }
+
+#ifdef CONFIG_ELF_LOADER_SET_MMU
+    if (esp_elf_arch_init_mmu(elf)) {
+        ret = -EIO;
+        goto fail;
+    }
 #endif
 
+    data_size = elf->sec[ELF_SEC_DATA].size + elf->sec[ELF_SEC_BSS].size;
+    rodata_size = elf->sec[ELF_SEC_RODATA].size + elf->sec[ELF_SEC_DRLRO].size;
+
+    if (data_size) {
+        elf->pdata = esp_elf_malloc(data_size, false);
+        if (!elf->pdata) {
+            ret = -ENOMEM;
+            goto fail;
+        }
+    }
+
+    if (rodata_size) {
+        elf->prodata = esp_elf_malloc_rodata(rodata_size);
+        if (!elf->prodata) {
+            ret = -ENOMEM;
+            goto fail;
+        }
+    }
+
+    if (elf->sec[ELF_SEC_DATA].size) {
+        elf->sec[ELF_SEC_DATA].addr = (uint32_t)elf->pdata;
+        if (reader->read(reader->context, elf->sec[ELF_SEC_DATA].offset, elf->pdata,
+                         elf->sec[ELF_SEC_DATA].size)) {
+            ret = -EIO;
+            goto fail;
+        }
+    }
+
+    if (elf->sec[ELF_SEC_BSS].size) {
+        uint8_t *pbss = elf->pdata + elf->sec[ELF_SEC_DATA].size;
+
+        elf->sec[ELF_SEC_BSS].addr = (uint32_t)pbss;
+        memset(pbss, 0, elf->sec[ELF_SEC_BSS].size);
+    }
+
+    if (elf->sec[ELF_SEC_RODATA].size) {
+        elf->sec[ELF_SEC_RODATA].addr = (uint32_t)elf->prodata;
+        if (reader->read(reader->context, elf->sec[ELF_SEC_RODATA].offset, elf->prodata,
+                         elf->sec[ELF_SEC_RODATA].size)) {
+            ret = -EIO;
+            goto fail;
+        }
+    }
+
+    if (elf->sec[ELF_SEC_DRLRO].size) {
+        uint8_t *pdrlro = elf->prodata + elf->sec[ELF_SEC_RODATA].size;
+
+        elf->sec[ELF_SEC_DRLRO].addr = (uint32_t)pdrlro;
+        if (reader->read(reader->context, elf->sec[ELF_SEC_DRLRO].offset, pdrlro,
+                         elf->sec[ELF_SEC_DRLRO].size)) {
+            ret = -EIO;
+            goto fail;
+        }
+    }
+
+    esp_elf_set_section_entry(elf, ehdr);
+
     return 0;
+
+fail:
+    esp_elf_deinit(elf);
+    return ret;
 }
 
 #else
@@ -232,16 +384,24 @@ static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
  * @return ESP_OK if success or other if failed.
  */
 
-static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
+/**
+ * @brief Validate the loadable segments and find the memory range they span.
+ *
+ * @param ehdr - ELF header
+ * @param phdr - ELF program headers
+ * @param start - Output: start virtual address
+ * @param end - Output: end virtual address
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+
+static int esp_elf_get_segment_range(const elf32_hdr_t *ehdr, const elf32_phdr_t *phdr,
+                                     Elf32_Addr *start, Elf32_Addr *end)
 {
-    uint32_t size;
     bool first_segment = false;
     Elf32_Addr vaddr_s = 0;
     Elf32_Addr vaddr_e = 0;
 
-    const elf32_hdr_t *ehdr = (const elf32_hdr_t *)pbuf;
-    const elf32_phdr_t *phdr = (const elf32_phdr_t *)(pbuf + ehdr->phoff);
-
     for (int i = 0; i < ehdr->phnum; i++) {
         if (phdr[i].type != PT_LOAD) {
             continue;
@@ -286,11 +446,42 @@ static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
                  i, phdr[i].vaddr, phdr[i].memsz);
     }
 
-    size = vaddr_e - vaddr_s;
-    if (size == 0) {
+    if (vaddr_e == vaddr_s) {
         return -EINVAL;
     }
 
+    *start = vaddr_s;
+    *end = vaddr_e;
+
+    return 0;
+}
+
+/**
+ * @brief Load ELF segment.
+ *
+ * @param elf - ELF object pointer
+ * @param pbuf - ELF data buffer
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+
+static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
+{
+    int ret;
+    uint32_t size;
+    Elf32_Addr vaddr_s;
+    Elf32_Addr vaddr_e;
+
+    const elf32_hdr_t *ehdr = (const elf32_hdr_t *)pbuf;
+    const elf32_phdr_t *phdr = (const elf32_phdr_t *)(pbuf + ehdr->phoff);
+
+    ret = esp_elf_get_segment_range(ehdr, phdr, &vaddr_s, &vaddr_e);
+    if (ret) {
+        return ret;
+    }
+
+    size = vaddr_e - vaddr_s;
+
     elf->svaddr = vaddr_s;
     elf->psegment = esp_elf_malloc(size, true);
     if (!elf->psegment) {
@@ -319,6 +510,76 @@ static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
 
     return 0;
 }
+
+/**
+ * @brief Load ELF segments straight from a reader into their final memory.
+ *
+ * @param elf - ELF object pointer
+ * @param reader - ELF file reader
+ * @param ehdr - ELF header
+ * @param image_size - Output: the size of the allocated segment memory
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+
+static int esp_elf_stream_load_segment(esp_elf_t *elf, const esp_elf_reader_t *reader,
+                                       const elf32_hdr_t *ehdr, uint32_t *image_size)
+{
+    int ret;
+    uint32_t size;
+    Elf32_Addr vaddr_s;
+    Elf32_Addr vaddr_e;
+    uint32_t phdr_size = ehdr->phnum * sizeof(elf32_phdr_t);
+    elf32_phdr_t *phdr = malloc(phdr_size);
+
+    if (!phdr) {
+        return -ENOMEM;
+    }
+
+    if (reader->read(reader->context, ehdr->phoff, phdr, phdr_size)) {
+        ret = -EIO;
+        goto out;
+    }
+
+    ret = esp_elf_get_segment_range(ehdr, phdr, &vaddr_s, &vaddr_e);
+    if (ret) {
+        goto out;
+    }
+
+    size = vaddr_e - vaddr_s;
+    elf->svaddr = vaddr_s;
+    elf->psegment = esp_elf_malloc(size, true);
+    if (!elf->psegment) {
+        ret = -ENOMEM;
+        goto out;
+    }
+
+    *image_size = size;
+
+    memset(elf->psegment, 0, size);
+
+    for (int i = 0; i < ehdr->phnum; i++) {
+        if (phdr[i].type == PT_LOAD && phdr[i].filesz) {
+            if (reader->read(reader->context, phdr[i].offset,
+                             elf->psegment + phdr[i].vaddr - vaddr_s, phdr[i].filesz)) {
+                esp_elf_free(elf->psegment);
+                elf->psegment = NULL;
+                ret = -EIO;
+                goto out;
+            }
+        }
+    }
+
+#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
+    cache_ll_writeback_all(CACHE_LL_LEVEL_INT_MEM, CACHE_TYPE_DATA, CACHE_LL_ID_ALL);
+#endif
+
+    elf->entry = (void *)((uint8_t *)elf->psegment + ehdr->entry - vaddr_s);
+
+out:
+    free(phdr);
+    return ret;
+}
 #endif
 
 /**
@@ -373,6 +634,79 @@ int esp_elf_init(esp_elf_t *elf)
     return 0;
 }
 
+/**
+ * @brief Free the loaded sections or segments after a failed relocation.
+ *
+ * @param elf - ELF object pointer
+ */
+static void esp_elf_free_image(esp_elf_t *elf)
+{
+#if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
+    esp_elf_free(elf->pdata);
+    esp_elf_free(elf->prodata);
+    esp_elf_free(elf->ptext);
+    elf->pdata = NULL;
+    elf->prodata = NULL;
+    elf->ptext = NULL;
+#else
+    esp_elf_free(elf->psegment);
+    elf->psegment = NULL;
+#endif
+}
+
+/**
+ * @brief Resolve the symbol of a relocation entry and apply the relocation.
+ *
+ * @param elf - ELF object pointer
+ * @param rela - Relocation entry
+ * @param symtab - Symbol table that the relocation entry refers to
+ * @param strtab - String table of the symbol table
+ *
+ * @return ESP_OK if success or -ENOSYS when the symbol can't be found.
+ */
+static int esp_elf_relocate_entry(esp_elf_t *elf, const elf32_rela_t *rela,
+                                  const elf32_sym_t *symtab, const char *strtab)
+{
+    int type;
+    uintptr_t addr = 0;
+    const elf32_sym_t *sym = &symtab[ELF_R_SYM(rela->info)];
+
+    type = ELF_R_TYPE(rela->info);
+    if (type == STT_COMMON || type == STT_OBJECT || type == STT_SECTION) {
+        const char *comm_name = strtab + sym->name;
+
+        if (comm_name[0]) {
+            addr = elf_find_sym(comm_name);
+
+            if (!addr) {
+                ESP_LOGE(TAG, "Can't find common %s", strtab + sym->name);
+                return -ENOSYS;
+            }
+
+            ESP_LOGD(TAG, "Find common %s addr=%x", comm_name, addr);
+        }
+    } else if (type == STT_FILE) {
+        const char *func_name = strtab + sym->name;
+
+        if (sym->value) {
+            addr = esp_elf_map_sym(elf, sym->value);
+        } else {
+            addr = elf_find_sym(func_name);
+        }
+
+        if (!addr) {
+            ESP_LOGE(TAG, "Can't find symbol %s", func_name);
+            return -ENOSYS;
+        }
+
+        ESP_LOGD(TAG, "Find function %s addr=%x", func_name, addr);
+    }
+
+    esp_elf_arch_relocate(elf, rela, sym, addr);
+
+    return 0;
+}
+
 /**
  * @brief Decode and relocate ELF data.
  *
@@ -429,58 +763,199 @@ int esp_elf_relocate(esp_elf_t *elf, const uint8_t *pbuf)
             ESP_LOGD(TAG, "Section %s has %d symbol tables", shstrab + shdr[i].name, (int)nr_reloc);
 
             for (int i = 0; i < nr_reloc; i++) {
-                int type;
-                uintptr_t addr = 0;
                 elf32_rela_t rela_buf;
 
                 memcpy(&rela_buf, &rela[i], sizeof(elf32_rela_t));
 
-                const elf32_sym_t *sym = &symtab[ELF_R_SYM(rela_buf.info)];
+                ret = esp_elf_relocate_entry(elf, &rela_buf, symtab, strtab);
+                if (ret) {
+                    esp_elf_free_image(elf);
+                    return ret;
+                }
+            }
+        }
+    }
+
+#ifdef CONFIG_ELF_LOADER_LOAD_PSRAM
+    esp_elf_arch_flush();
+#endif
+
+    return 0;
+}
 
-                type = ELF_R_TYPE(rela_buf.info);
-                if (type == STT_COMMON || type == STT_OBJECT || type == STT_SECTION) {
-                    const char *comm_name = strtab + sym->name;
+/**
+ * @brief Read a part of the ELF file into a new transient buffer.
+ *
+ * @param reader - ELF file reader
+ * @param offset - Offset in the ELF file
+ * @param size - Amount of bytes to read
+ * @param ret - Output: error code if failed
+ *
+ * @return Buffer pointer if success (free with "free") or NULL if failed.
+ */
+static void *esp_elf_stream_read_alloc(const esp_elf_reader_t *reader, uint32_t offset,
+                                       uint32_t size, int *ret)
+{
+    void *buffer = malloc(size ? size : 1);
 
-                    if (comm_name[0]) {
-                        addr = elf_find_sym(comm_name);
+    if (!buffer) {
+        *ret = -ENOMEM;
+        return NULL;
+    }
 
-                        if (!addr) {
-                            ESP_LOGE(TAG, "Can't find common %s", strtab + sym->name);
-#if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
-                            esp_elf_free(elf->pdata);
-                            esp_elf_free(elf->ptext);
-#else
-                            esp_elf_free(elf->psegment);
-#endif
-                            return -ENOSYS;
-                        }
+    if (reader->read(reader->context, offset, buffer, size)) {
+        free(buffer);
+        *ret = -EIO;
+        return NULL;
+    }
 
-                        ESP_LOGD(TAG, "Find common %s addr=%x", comm_name, addr);
-                    }
-                } else if (type == STT_FILE) {
-                    const char *func_name = strtab + sym->name;
+    return buffer;
+}
 
-                    if (sym->value) {
-                        addr = esp_elf_map_sym(elf, sym->value);
-                    } else {
-                        addr = elf_find_sym(func_name);
-                    }
+/**
+ * @brief Decode and relocate an ELF file that is read in parts.
+ *
+ * Unlike "esp_elf_relocate", the file is never loaded into memory as a whole:
+ * sections are read straight into their final memory, and only the section headers,
+ * the symbol table, its string table and a small window of relocation entries are buffered.
+ * These buffers are freed before this function returns.
+ *
+ * @param elf - ELF object pointer
+ * @param reader - ELF file reader
+ * @param estimated_peak_memory - Optional output: an estimate of the peak amount of heap memory that the loader used.
+ *                                It is the sum of the requested buffer sizes, without allocator overhead.
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+int esp_elf_relocate_stream(esp_elf_t *elf, const esp_elf_reader_t *reader, uint32_t *estimated_peak_memory)
+{
+    int ret = 0;
+    elf32_hdr_t ehdr;
+    elf32_shdr_t *shdr = NULL;
+    char *shstrab = NULL;
+    elf32_sym_t *symtab = NULL;
+    char *strtab = NULL;
+    uint32_t symtab_index = 0;
+    uint32_t image_size = 0;
+    uint32_t transient_size = 0;
+    uint32_t transient_peak = 0;
+    elf32_rela_t rela[ELF_STREAM_RELA_CHUNK];
+
+    if (!elf || !reader || !reader->read) {
+        return -EINVAL;
+    }
+
+    if (reader->read(reader->context, 0, &ehdr, sizeof(ehdr))) {
+        return -EIO;
+    }
+
+    if (memcmp(ehdr.ident, "\x7f" "ELF", 4) != 0 ||
+            ehdr.shentsize != sizeof(elf32_shdr_t) ||
+            ehdr.shstrndx >= ehdr.shnum) {
+        ESP_LOGE(TAG, "Invalid ELF header");
+        return -EINVAL;
+    }
+
+    shdr = esp_elf_stream_read_alloc(reader, ehdr.shoff, ehdr.shnum * sizeof(elf32_shdr_t), &ret);
+    if (!shdr) {
+        goto out;
+    }
+    transient_size += ehdr.shnum * sizeof(elf32_shdr_t);
+
+    shstrab = esp_elf_stream_read_alloc(reader, shdr[ehdr.shstrndx].offset, shdr[ehdr.shstrndx].size, &ret);
+    if (!shstrab) {
+        goto out;
+    }
+    transient_size += shdr[ehdr.shstrndx].size;
+
+    /* Load section or segment to memory space */
 
-                    if (!addr) {
-                        ESP_LOGE(TAG, "Can't find symbol %s", func_name);
 #if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
-                        esp_elf_free(elf->pdata);
-                        esp_elf_free(elf->ptext);
+    transient_peak = transient_size;
+    ret = esp_elf_stream_load_section(elf, reader, &ehdr, shdr, shstrab);
+    for (int i = 0; i < ELF_SECS; i++) {
+        image_size += elf->sec[i].size;
+    }
 #else
-                        esp_elf_free(elf->psegment);
+    transient_peak = transient_size + ehdr.phnum * sizeof(elf32_phdr_t);
+    ret = esp_elf_stream_load_segment(elf, reader, &ehdr, &image_size);
 #endif
-                        return -ENOSYS;
-                    }
 
-                    ESP_LOGD(TAG, "Find function %s addr=%x", func_name, addr);
+    if (ret) {
+        ESP_LOGE(TAG, "Error to load elf file, ret=%d", ret);
+        goto out;
+    }
+
+    ESP_LOGI(TAG, "elf->entry=%p", elf->entry);
+
+    free(shstrab);
+    shstrab = NULL;
+    transient_size -= shdr[ehdr.shstrndx].size;
+
+    /* Relocation section data */
+
+    for (uint32_t i = 0; i < ehdr.shnum; i++) {
+        if (stype(&shdr[i], SHT_RELA)) {
+            uint32_t nr_reloc = shdr[i].size / sizeof(elf32_rela_t);
+            uint32_t link = shdr[i].link;
+
+            if (link == 0 || link >= ehdr.shnum || shdr[link].link >= ehdr.shnum) {
+                ESP_LOGE(TAG, "Section %d has an invalid symbol table", (int)i);
+                ret = -EINVAL;
+                esp_elf_free_image(elf);
+                goto out;
+            }
+
+            /* Usually all relocation sections share 1 symbol table, so it is only read once */
+
+            if (link != symtab_index) {
+                if (symtab) {
+                    transient_size -= shdr[symtab_index].size + shdr[shdr[symtab_index].link].size;
+                    free(symtab);
+                    free(strtab);
+                    symtab = NULL;
+                    strtab = NULL;
+                }
+
+                symtab = esp_elf_stream_read_alloc(reader, shdr[link].offset, shdr[link].size, &ret);
+                if (symtab) {
+                    strtab = esp_elf_stream_read_alloc(reader, shdr[shdr[link].link].offset,
+                                                       shdr[shdr[link].link].size, &ret);
+                }
+
+                if (!symtab || !strtab) {
+                    free(symtab);
+                    symtab = NULL;
+                    esp_elf_free_image(elf);
+                    goto out;
+                }
+
+                symtab_index = link;
+                transient_size += shdr[link].size + shdr[shdr[link].link].size;
+                transient_peak = MAX(transient_peak, transient_size);
+            }
+
+            ESP_LOGD(TAG, "Section %d has %d symbol tables", (int)i, (int)nr_reloc);
+
+            for (uint32_t done = 0; done < nr_reloc;) {
+                uint32_t count = MIN(nr_reloc - done, ELF_STREAM_RELA_CHUNK);
+
+                if (reader->read(reader->context, shdr[i].offset + done * sizeof(elf32_rela_t),
+                                 rela, count * sizeof(elf32_rela_t))) {
+                    ret = -EIO;
+                    esp_elf_free_image(elf);
+                    goto out;
+                }
+
+                for (uint32_t j = 0; j < count; j++) {
+                    ret = esp_elf_relocate_entry(elf, &rela[j], symtab, strtab);
+                    if (ret) {
+                        esp_elf_free_image(elf);
+                        goto out;
+                    }
                 }
 
-                esp_elf_arch_relocate(elf, &rela_buf, sym, addr);
+                done += count;
             }
         }
     }
@@ -489,7 +964,20 @@ int esp_elf_relocate(esp_elf_t *elf, const uint8_t *pbuf)
     esp_elf_arch_flush();
 #endif
 
-    return 0;
+    ESP_LOGI(TAG, "Loaded %u bytes of sections, estimated peak transient memory was %u bytes",
+             (unsigned int)image_size, (unsigned int)transient_peak);
+
+out:
+    free(strtab);
+    free(symtab);
+    free(shstrab);
+    free(shdr);
+
+    if (estimated_peak_memory) {
+        *estimated_peak_memory = image_size + transient_peak;
+    }
+
+    return ret;
 }
 
 /**
@@ -528,14 +1016,19 @@ void esp_elf_deinit(esp_elf_t *elf)
         elf->pdata = NULL;
     }
 
+    if (elf->prodata) {
+        esp_elf_free(elf->prodata);
+        elf->prodata = NULL;
+    }
+
     if (elf->ptext) {
         esp_elf_free(elf->ptext);
         elf->ptext = NULL;
     }
 #else
     if (elf->psegment) {
-        esp_elf_free(elf->ptext);
-        elf->ptext = NULL;
+        esp_elf_free(elf->psegment);
+        elf->psegment = NULL;
     }
 #endif
 
@@ -50,6 +50,30 @@ void *esp_elf_malloc(uint32_t n, bool exec)
     return heap_caps_malloc(n, caps);
 }
 
+/**
+ * @brief Allocate block of memory for read-only data (".rodata" and ".data.rel.ro").
+ *
+ * Large blocks go to PSRAM when it is available, to keep internal RAM free.
+ *
+ * @param n - Memory size in byte
+ *
+ * @return Memory pointer if success or NULL if failed.
+ */
+void *esp_elf_malloc_rodata(uint32_t n)
+{
+#if defined(CONFIG_SPIRAM) && !defined(CONFIG_ELF_LOADER_LOAD_PSRAM)
+    if (n >= CONFIG_ELF_LOADER_RODATA_PSRAM_THRESHOLD) {
+        void *ptr = heap_caps_malloc(n, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+
+        if (ptr) {
+            return ptr;
+        }
+    }
+#endif
+
+    return esp_elf_malloc(n, false);
+}
+
 /**
  * @brief Free block of memory.
  *
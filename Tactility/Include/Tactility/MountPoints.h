@@ -21,6 +21,10 @@ constexpr auto* MOUNT_POINT_DATA = "/data";
 constexpr auto* MOUNT_POINT_DATA = "data";
 #endif
 
+/**
+ * @return the root entries: the data partition, mounted devices (e.g. SD cards) and optionally the system partition.
+ * The list is cached and only rebuilt when the file::MountTable changes.
+ */
 std::vector<dirent> getMountPoints();
 
 } // namespace
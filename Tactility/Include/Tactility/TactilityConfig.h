@@ -4,6 +4,8 @@
 #include <sdkconfig.h>
 #endif
 
+#include <cstddef>
+
 #define TT_CONFIG_FORCE_ONSCREEN_KEYBOARD false // for development/debug purposes
 
 #ifdef ESP_PLATFORM
@@ -16,4 +18,10 @@ namespace tt::config {
 
 constexpr auto SHOW_SYSTEM_PARTITION = false;
 
+/** The maximum amount of memory that is used by retained app views (see AppManifest::Flags::RetainView) */
+constexpr size_t RETAINED_VIEW_MEMORY_BUDGET = 48 * 1024;
+
+/** The amount of decoded image data that lvgl::findCachedImage() keeps in memory when it is no longer used */
+constexpr size_t IMAGE_CACHE_MEMORY_BUDGET = 32 * 1024;
+
 }
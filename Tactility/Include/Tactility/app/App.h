@@ -44,6 +44,11 @@ public:
     virtual void onDestroy(AppContext& appContext) {}
     virtual void onShow(AppContext& appContext, lv_obj_t* parent) {}
     virtual void onHide(AppContext& appContext) {}
+    /**
+     * Called instead of onShow() when the view of an app with AppManifest::Flags::RetainView is shown again.
+     * The widgets that were created in onShow() still exist. onHide() was called when the app was hidden.
+     */
+    virtual void onShowRetained(AppContext& appContext, lv_obj_t* parent) {}
     virtual void onResult(AppContext& appContext, LaunchId launchId, Result result, std::unique_ptr<Bundle> _Nullable resultData) {}
 
     Mutex& getMutex() { return mutex; }
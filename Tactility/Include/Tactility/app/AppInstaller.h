@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Tactility/file/TarExtractor.h>
+#include <Tactility/StreamBuffer.h>
+#include <Tactility/Thread.h>
+
+#include <mbedtls/sha256.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace tt::app {
+
+/**
+ * Installs an app package (a tar file) while its data is still arriving.
+ *
+ * The caller (e.g. an HTTP request handler) passes the data to write(). A worker thread reads it from a
+ * bounded StreamBuffer, then hashes and extracts it, so receiving and writing to storage happen in parallel.
+ * write() blocks while the buffer is full, so memory usage doesn't depend on the package size.
+ *
+ * The package is extracted into a staging directory. finish() verifies the SHA-256 hash and then replaces
+ * the existing installation (if any) with renames, so an app is never left partially updated.
+ *
+ * @warning The SHA-256 verification is optional: it only happens when the caller passes an expected hash.
+ * Without it, a package is only checked for a valid tar structure (header checksums), which doesn't detect
+ * corrupted file contents or a modified package. Callers that receive packages from untrusted sources
+ * should require a hash.
+ */
+class AppInstaller final {
+
+public:
+
+    static constexpr size_t defaultBufferSize = 8192;
+
+private:
+
+    const std::string stagingPath;
+    StreamBuffer streamBuffer;
+    std::unique_ptr<uint8_t[]> chunk;
+    file::TarExtractor extractor;
+    mbedtls_sha256_context sha256Context;
+    Thread thread;
+    std::atomic<bool> inputEnded = false;
+    std::atomic<bool> failed = false;
+    bool started = false;
+    bool finished = false;
+    std::string sha256;
+
+    int32_t extractMain();
+
+    void cleanup();
+
+public:
+
+    /** @param[in] bufferSize the maximum amount of bytes that are buffered between write() and the extraction */
+    explicit AppInstaller(size_t bufferSize = defaultBufferSize);
+
+    /** Aborts the installation when it was started but not finished */
+    ~AppInstaller();
+
+    /** Start the extraction thread */
+    bool start();
+
+    /**
+     * Pass the next part of the package. Blocks while the buffer is full.
+     * @return false when the extraction failed: the installation can only be aborted
+     */
+    bool write(const void* data, size_t size);
+
+    /**
+     * Wait for the extraction to finish, verify the package and install it.
+     * When the app is running, it is stopped first.
+     * @param[in] expectedSha256 the hex-encoded SHA-256 of the package, or an empty string to skip verification (see the class documentation)
+     * @return true when the app was installed
+     */
+    bool finish(const std::string& expectedSha256 = "");
+
+    /** Stop the extraction and delete the extracted data */
+    void abort();
+
+    /** @return the hex-encoded SHA-256 of the package (only available after finish()) */
+    const std::string& getSha256() const { return sha256; }
+};
+
+} // namespace tt::app
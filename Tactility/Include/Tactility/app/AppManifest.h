@@ -61,6 +61,11 @@ struct AppManifest {
         constexpr static uint32_t HideStatusBar = 1 << 0;
         /** Hint to other systems to not show this app (e.g. in launcher or settings) */
         constexpr static uint32_t Hidden = 1 << 1;
+        /**
+         * Keep the view in memory while another app is shown on top, so it doesn't have to be rebuilt.
+         * Retained views are deleted when they exceed the memory budget (see App::onShowRetained())
+         */
+        constexpr static uint32_t RetainView = 1 << 2;
     };
 
     /** The SDK version that was used to compile this app. (e.g. "0.6.0") */
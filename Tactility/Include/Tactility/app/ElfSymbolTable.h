@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace tt::app {
+
+/**
+ * The names of the symbols that ELF apps can link against, sorted at compile time.
+ *
+ * It is built from name tables that have the same order as the symbol tables with the addresses.
+ * A lookup is a binary search that returns where the symbol is in those tables,
+ * so nothing has to be sorted (or allocated) at startup.
+ *
+ * @tparam Size the amount of names in all tables (see getElfSymbolCount())
+ */
+template<size_t Size>
+class ElfSymbolTable final {
+
+public:
+
+    struct Entry {
+        const char* name;
+        /** The index of the table that has the symbol */
+        uint16_t table;
+        /** The index of the symbol in its table */
+        uint16_t index;
+    };
+
+private:
+
+    std::array<Entry, Size> entries {};
+
+    static constexpr int compareNames(const char* left, const char* right) {
+        if consteval {
+            while (*left != '\0' && *left == *right) {
+                left++;
+                right++;
+            }
+            return static_cast<unsigned char>(*left) - static_cast<unsigned char>(*right);
+        } else {
+            return strcmp(left, right);
+        }
+    }
+
+public:
+
+    consteval explicit ElfSymbolTable(std::span<const std::span<const char* const>> tables) {
+        size_t count = 0;
+        for (size_t table = 0; table < tables.size(); table++) {
+            for (size_t index = 0; index < tables[table].size(); index++) {
+                entries[count] = { tables[table][index], static_cast<uint16_t>(table), static_cast<uint16_t>(index) };
+                count++;
+            }
+        }
+
+        std::ranges::sort(entries, [](const Entry& left, const Entry& right) {
+            return compareNames(left.name, right.name) < 0;
+        });
+    }
+
+    /**
+     * Used in a static_assert, so that a duplicate name fails the build.
+     * @return the first name that occurs more than once, or nullptr when all names are unique
+     */
+    consteval const char* findDuplicate() const {
+        for (size_t i = 1; i < Size; i++) {
+            if (compareNames(entries[i - 1].name, entries[i].name) == 0) {
+                return entries[i].name;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @param[in] name the symbol name
+     * @return the entry or nullptr when the name wasn't found
+     */
+    constexpr const Entry* find(const char* name) const {
+        auto iterator = std::ranges::lower_bound(entries, name, [](const char* left, const char* right) {
+            return compareNames(left, right) < 0;
+        }, &Entry::name);
+
+        if (iterator != entries.end() && compareNames(iterator->name, name) == 0) {
+            return &*iterator;
+        } else {
+            return nullptr;
+        }
+    }
+
+    /** @return the amount of symbols */
+    static constexpr size_t getSize() { return Size; }
+};
+
+/** @return the amount of names in all tables, to use as the ElfSymbolTable size */
+consteval size_t getElfSymbolCount(std::span<const std::span<const char* const>> tables) {
+    size_t count = 0;
+    for (auto table : tables) {
+        count += table.size();
+    }
+    return count;
+}
+
+} // namespace tt::app
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tt::app::timezone {
+
+/**
+ * All timezones from a timezones.csv file (lines formatted as "Europe/Amsterdam","CET-1CEST,M3.5.0,M10.5.0/3"),
+ * sorted by name.
+ *
+ * Names and codes are stored in a single buffer, together with a lowercase copy of the names,
+ * so filtering doesn't allocate memory or convert names per query.
+ */
+class TimeZoneIndex final {
+
+    struct Entry {
+        uint32_t nameOffset;
+        uint32_t codeOffset;
+    };
+
+    /** Null-terminated names and codes */
+    std::vector<char> strings;
+    /** The lowercase names, at the same offsets as in strings */
+    std::vector<char> lowercaseStrings;
+    std::vector<Entry> entries;
+
+    TimeZoneIndex() = default;
+
+public:
+
+    /**
+     * Read and index a timezones.csv file.
+     * @return the index, or nullptr when the file couldn't be read
+     */
+    static std::unique_ptr<TimeZoneIndex> load(const std::string& filePath);
+
+    size_t getCount() const { return entries.size(); }
+
+    /** @return the name (e.g. "Europe/Amsterdam") of the timezone at the specified index */
+    const char* getName(size_t index) const { return strings.data() + entries[index].nameOffset; }
+
+    /** @return the POSIX TZ code (e.g. "CET-1CEST,M3.5.0,M10.5.0/3") of the timezone at the specified index */
+    const char* getCode(size_t index) const { return strings.data() + entries[index].codeOffset; }
+
+    /** @return the lowercase name of the timezone at the specified index */
+    const char* getLowercaseName(size_t index) const { return lowercaseStrings.data() + entries[index].nameOffset; }
+};
+
+/**
+ * Finds the timezones with a name that contains a query (case-insensitive).
+ *
+ * When a query contains the previous query (e.g. while typing), only the previous matches are checked again.
+ */
+class TimeZoneFilter final {
+
+    std::shared_ptr<const TimeZoneIndex> index;
+    std::string query;
+    std::vector<uint16_t> matches;
+    /** The amount of names that were compared in the last setQuery() call */
+    size_t lastComparisonCount = 0;
+
+public:
+
+    explicit TimeZoneFilter(std::shared_ptr<const TimeZoneIndex> index);
+
+    /**
+     * Update the matches.
+     * @param[in] query the text to search for: an empty query matches all timezones
+     */
+    void setQuery(const std::string& query);
+
+    /** @return the indices of the matching timezones, in the order of the index */
+    const std::vector<uint16_t>& getMatches() const { return matches; }
+
+    size_t getLastComparisonCount() const { return lastComparisonCount; }
+};
+
+} // namespace tt::app::timezone
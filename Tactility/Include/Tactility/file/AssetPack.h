@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Tactility/file/File.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @warning The functionality below does NOT safely acquire file locks. Use file::getLock() or file::withLock() when using the functionality below.
+ */
+namespace tt::file {
+
+/**
+ * Reads images from an asset pack: a file with pre-decoded images that is created at build time
+ * by Buildscripts/asset-pack.py (see that script for the file layout).
+ *
+ * The index is read once when the pack is opened. Image data is only read when an image is loaded.
+ * Images are stored in a color format that LVGL can draw directly, so they don't have to be decoded.
+ */
+class AssetPack final {
+
+public:
+
+    /** The values match lv_color_format_t */
+    enum class ColorFormat : uint8_t {
+        /** Alpha only: the image is drawn in a single color (see Image::color) */
+        A8 = 0x0E,
+        Argb8888 = 0x10,
+        /** An RGB565 plane followed by an alpha plane */
+        Rgb565A8 = 0x14
+    };
+
+    struct Image {
+        uint16_t width;
+        uint16_t height;
+        /** The amount of bytes per row (for Rgb565A8 this is the stride of the RGB565 plane) */
+        uint16_t stride;
+        ColorFormat colorFormat;
+        /** The color (0xRRGGBB) of an A8 image */
+        uint32_t color;
+        size_t dataSize;
+        std::unique_ptr<uint8_t[]> data;
+    };
+
+private:
+
+    struct Entry {
+        uint32_t nameHash;
+        uint32_t nameOffset;
+        uint16_t width;
+        uint16_t height;
+        uint16_t stride;
+        uint8_t colorFormat;
+        uint8_t reserved;
+        uint32_t color;
+        uint32_t dataOffset;
+        uint32_t dataSize;
+    };
+
+    const std::string filePath;
+    std::vector<Entry> entries;
+    std::vector<char> names;
+
+    AssetPack(std::string filePath, std::vector<Entry> entries, std::vector<char> names) :
+        filePath(std::move(filePath)),
+        entries(std::move(entries)),
+        names(std::move(names))
+    {}
+
+    const Entry* find(const std::string& name) const;
+
+public:
+
+    static constexpr uint16_t version = 1;
+
+    /**
+     * Read the index of an asset pack.
+     * @param[in] filePath the path of the pack file
+     * @return the pack, or nullptr when the file doesn't exist or is invalid
+     */
+    static std::unique_ptr<AssetPack> open(const std::string& filePath);
+
+    /** @return the path of the pack file */
+    const std::string& getFilePath() const { return filePath; }
+
+    size_t getImageCount() const { return entries.size(); }
+
+    /** @param[in] name the path of the original image, relative to the directory that the pack was created from */
+    bool contains(const std::string& name) const { return find(name) != nullptr; }
+
+    /**
+     * Read an image from the pack file.
+     * @param[in] name the path of the original image, relative to the directory that the pack was created from
+     * @param[out] image the image
+     * @return false when the pack doesn't contain the image or when it couldn't be read
+     */
+    bool load(const std::string& name, Image& image) const;
+};
+
+} // namespace tt::file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Tactility/file/File.h>
+#include <Tactility/MessageQueue.h>
+#include <Tactility/Thread.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace tt::file {
+
+/**
+ * Writes a file in large blocks on a separate thread.
+ *
+ * There are 2 blocks: the caller fills one block while the other one is written to storage.
+ * The caller can fill a block directly (e.g. with a network read) by using getBuffer() and commit(),
+ * so the data doesn't have to be copied.
+ *
+ * The file lock is acquired per block, so other users of the storage device (e.g. the display on a shared SPI bus)
+ * only have to wait for a single block write.
+ *
+ * The blocks and the thread are re-used when the writer is opened again, so memory usage is fixed.
+ * All functions must be called from the same thread.
+ */
+class DoubleBufferedWriter final {
+
+    struct Message {
+        enum class Type : uint32_t {
+            Write,
+            Flush,
+            Stop
+        };
+        Type type;
+        uint32_t blockIndex;
+        size_t size;
+    };
+
+    const size_t blockSize;
+    std::unique_ptr<uint8_t[]> blocks[2];
+    /** Indices of blocks that can be filled */
+    MessageQueue freeBlocks;
+    /** Blocks to write, and other requests for the writer thread */
+    MessageQueue requests;
+    /** Sent by the writer thread when all requests before a flush were handled */
+    MessageQueue flushed;
+    Thread thread;
+    std::unique_ptr<FILE, FileCloser> file;
+    std::shared_ptr<Lock> fileLock;
+    std::atomic<bool> failed = false;
+    bool threadStarted = false;
+    int32_t currentBlockIndex = -1;
+    size_t currentBlockSize = 0;
+    uint64_t bytesCommitted = 0;
+
+    int32_t threadMain();
+
+    void submitCurrentBlock();
+
+    /** Wait until all submitted blocks are written */
+    void flush();
+
+public:
+
+    static constexpr size_t defaultBlockSize = 4096;
+
+    /** @param[in] blockSize the size of a single block: a multiple of the storage sector size works best */
+    explicit DoubleBufferedWriter(size_t blockSize = defaultBlockSize);
+
+    ~DoubleBufferedWriter();
+
+    DoubleBufferedWriter(const DoubleBufferedWriter&) = delete;
+    DoubleBufferedWriter& operator=(const DoubleBufferedWriter&) = delete;
+
+    /**
+     * @param[in] path the file to write to
+     * @param[in] append true to add the data to the end of an existing file, false to replace the file
+     * @return true when the file was opened
+     */
+    bool open(const std::string& path, bool append);
+
+    /**
+     * Get the free space of the current block. Blocks when both blocks are full and the first one is still being written.
+     * @param[out] size the amount of bytes that can be written to the returned buffer
+     * @return the buffer to write to, followed by a call to commit()
+     */
+    uint8_t* getBuffer(size_t& size);
+
+    /**
+     * Add data that was written to the buffer from getBuffer(). A full block is passed on to the writer thread.
+     * @param[in] size the amount of bytes that were written to the buffer
+     * @return false when writing a previous block failed
+     */
+    bool commit(size_t size);
+
+    /** Copy data into the blocks (see getBuffer() and commit()) */
+    bool write(const uint8_t* data, size_t size);
+
+    /**
+     * Write the remaining data and close the file.
+     * @return true when all data was written
+     */
+    bool close();
+
+    bool isOpen() const { return file != nullptr; }
+
+    bool hasFailed() const { return failed; }
+
+    /** @return the amount of bytes that were committed since the file was opened */
+    uint64_t getBytesCommitted() const { return bytesCommitted; }
+};
+
+} // namespace tt::file
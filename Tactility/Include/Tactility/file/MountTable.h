@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Tactility/Lock.h>
+#include <Tactility/PubSub.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * The mount table keeps track of the file systems that are mounted by devices (e.g. SD cards).
+ * It resolves any path to the mount that owns it, without querying devices or the device registry.
+ */
+namespace tt::file {
+
+struct Mount {
+    /** The absolute path where the file system is mounted (e.g. "/sdcard") */
+    std::string path;
+    /** Optional: the lock for accessing files on this mount (e.g. for a shared SPI bus) */
+    std::shared_ptr<Lock> lock;
+    /** The identifier of the device that owns the mount (see hal::Device::Id) */
+    uint32_t deviceId;
+};
+
+struct MountEvent {
+    enum class Action {
+        Mounted,
+        Unmounted
+    };
+
+    Action action;
+    /** The path that was mounted or unmounted */
+    std::string path;
+    /** The generation of the mount table after this change */
+    uint32_t generation;
+};
+
+/**
+ * Register a mounted file system. Replaces an existing mount on the same path.
+ * @param[in] mount the mount information
+ */
+void addMount(const Mount& mount);
+
+/**
+ * Remove a mounted file system.
+ * @param[in] path the path that the file system was mounted on
+ * @return true when the mount was found and removed
+ */
+bool removeMount(const std::string& path);
+
+/**
+ * Find the mount that owns the specified path with a longest-prefix match on whole path components.
+ * This is O(path length) and doesn't take any lock.
+ * @param[in] path an absolute path
+ * @param[out] mount the mount that owns the path
+ * @return true when a mount was found
+ */
+bool findMount(const std::string& path, Mount& mount);
+
+/**
+ * @param[in] path an absolute path
+ * @return the lock of the mount that owns the path, or nullptr when the path has no (locked) mount
+ */
+std::shared_ptr<Lock> _Nullable findMountLock(const std::string& path);
+
+/** @return all current mounts, ordered by path */
+std::vector<Mount> getMounts();
+
+/** @return a number that changes every time a file system is mounted or unmounted */
+uint32_t getMountGeneration();
+
+/** @return the PubSub that publishes a MountEvent for every mount and unmount */
+std::shared_ptr<PubSub<MountEvent>> getMountPubsub();
+
+} // namespace
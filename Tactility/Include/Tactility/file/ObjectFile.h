@@ -2,11 +2,23 @@
 
 #include <Tactility/file/File.h>
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "FileLock.h"
 
 /**
+ * A file with fixed-size records.
+ *
+ * Version 2 files store the records in blocks of up to 64 records. Every block has a CRC.
+ * Changes are appended: a commit writes the changed blocks and then a trailer.
+ * A block that is written again replaces the older copy, and blocks without a trailer after them are ignored.
+ * This means that an interrupted commit (e.g. a power loss) leaves the previous commit intact.
+ * Deleted records are marked with a tombstone. Use compactObjectFile() to remove them and the replaced blocks.
+ *
+ * Version 1 files (a header followed by the records) can still be read. Writing always produces version 2.
+ *
  * @warning The functionality below does NOT safely acquire file locks. Use file::getLock() or file::withLock() when using the functionality below.
  */
 namespace tt::file {
@@ -15,51 +27,145 @@ class ObjectFileReader {
 
     const std::string filePath;
     const uint32_t recordSize = 0;
+    const bool memoryMap;
 
     std::unique_ptr<FILE, FileCloser> file;
+    uint32_t fileVersion = 0;
     uint32_t recordCount = 0;
     uint32_t recordVersion = 0;
+    uint32_t deletedRecordCount = 0;
+    uint32_t garbageSize = 0;
+    /** The amount of records that readNext() returned */
     uint32_t recordsRead = 0;
+    /** The index of the record that readNext() reads next */
+    uint32_t nextIndex = 0;
+    /** The record index at the current position in the file (version 1) */
+    uint32_t streamIndex = 0;
+
+    uint32_t recordsPerBlock = 0;
+    std::vector<uint32_t> blockOffsets;
+    std::vector<bool> verifiedBlocks;
+    /** The most recently read block (when the file isn't memory-mapped) */
+    std::unique_ptr<uint8_t[]> blockBuffer;
+    uint32_t bufferedBlock = UINT32_MAX;
+
+    void* mappedData = nullptr;
+    size_t mappedSize = 0;
+
+    bool openVersion2(FILE* openingFile);
+    void unmap();
+
+    uint32_t getBlockRecordCount(uint32_t blockIndex) const;
+    /** @return the block header followed by the records, or nullptr when the block can't be read or is corrupt */
+    const uint8_t* getBlock(uint32_t blockIndex);
+    /** @return a pointer to the record in a memory-mapped version 1 file, or in a block */
+    const uint8_t* getRecord(uint32_t index, bool& isDeleted);
 
 public:
 
-    ObjectFileReader(std::string filePath, uint32_t recordSize) :
+    /**
+     * @param[in] filePath the file to read
+     * @param[in] recordSize the size of a record in bytes
+     * @param[in] memoryMap map the file into memory for faster random access (ignored on ESP32: it can't map files)
+     */
+    ObjectFileReader(std::string filePath, uint32_t recordSize, bool memoryMap = true) :
         filePath(std::move(filePath)),
-        recordSize(recordSize)
+        recordSize(recordSize),
+        memoryMap(memoryMap)
     {}
 
+    ObjectFileReader(const ObjectFileReader&) = delete;
+    ObjectFileReader& operator=(const ObjectFileReader&) = delete;
+
+    ~ObjectFileReader() { close(); }
+
     bool open();
     void close();
 
-    bool hasNext() const { return recordsRead < recordCount; }
+    /** @return true when there are more records that aren't deleted */
+    bool hasNext() const { return recordsRead < recordCount - deletedRecordCount; }
+
+    /** Read the next record that isn't deleted */
     bool readNext(void* output);
 
+    /**
+     * Read any record in constant time.
+     * @param[in] index the record index (0 to getRecordCount() - 1)
+     * @param[out] output the record
+     * @return false when the record can't be read, when it is corrupt or when it was deleted
+     */
+    bool read(uint32_t index, void* output);
+
+    /** @return true when the record was deleted or can't be read */
+    bool isDeleted(uint32_t index);
+
+    /** @return the amount of records, including the deleted ones */
     uint32_t getRecordCount() const { return recordCount; }
+    uint32_t getDeletedRecordCount() const { return deletedRecordCount; }
     uint32_t getRecordSize() const { return recordSize; }
     uint32_t getRecordVersion() const { return recordVersion; }
+    uint32_t getFileVersion() const { return fileVersion; }
+
+    /** @return the approximate amount of bytes that compactObjectFile() would free */
+    uint32_t getGarbageSize() const { return garbageSize; }
 };
 
 class ObjectFileWriter {
 
+    struct Block {
+        std::unique_ptr<uint8_t[]> records;
+        uint64_t tombstones = 0;
+        uint32_t recordCount = 0;
+    };
+
+    /** The amount of changed blocks that are kept in memory until they are written */
+    static constexpr size_t maxChangedBlocks = 4;
+
     const std::string filePath;
     const uint32_t recordSize;
     const uint32_t recordVersion;
     const bool append;
+    uint32_t recordsPerBlock;
     const std::shared_ptr<Lock> lock;
 
     std::unique_ptr<FILE, FileCloser> file;
+    /** The file offset of every block, including the ones that weren't committed yet */
+    std::vector<uint32_t> blockOffsets;
+    /** Blocks with changes that weren't written yet */
+    std::map<uint32_t, Block> changedBlocks;
     uint32_t recordsWritten = 0;
+    uint32_t deletedRecordCount = 0;
+    /** The sequence of the last commit */
+    uint32_t sequence = 0;
+    uint32_t writeOffset = 0;
+    bool hasChanges = false;
+
+    bool openExisting(std::unique_ptr<FILE, FileCloser>& openingFile);
+    Block* getBlock(uint32_t blockIndex);
+    bool writeBlock(uint32_t blockIndex, const Block& block);
 
 public:
 
-    ObjectFileWriter(std::string filePath, uint32_t recordSize, uint32_t recordVersion, bool append) :
+    static constexpr uint32_t defaultRecordsPerBlock = 64;
+
+    /**
+     * @param[in] filePath the file to write
+     * @param[in] recordSize the size of a record in bytes
+     * @param[in] recordVersion the version of the record format
+     * @param[in] append keep the records of an existing file (a version 1 file is converted to version 2)
+     * @param[in] recordsPerBlock the amount of records that share a CRC (1 to 64): ignored when appending to a version 2 file
+     */
+    ObjectFileWriter(std::string filePath, uint32_t recordSize, uint32_t recordVersion, bool append, uint32_t recordsPerBlock = defaultRecordsPerBlock) :
         filePath(std::move(filePath)),
         recordSize(recordSize),
         recordVersion(recordVersion),
         append(append),
-        lock(getLock(filePath))
+        recordsPerBlock(recordsPerBlock),
+        lock(getLock(this->filePath))
     {}
 
+    ObjectFileWriter(const ObjectFileWriter&) = delete;
+    ObjectFileWriter& operator=(const ObjectFileWriter&) = delete;
 
     ~ObjectFileWriter() {
         if (file != nullptr) {
@@ -68,9 +174,41 @@ public:
     }
 
     bool open();
+
+    /** Commit and close the file */
     void close();
 
-    bool write(void* data);
+    /**
+     * Make all changes durable: they are only visible to readers after a commit.
+     * Every commit appends the blocks that changed (including a partially filled last block), so commit in batches.
+     */
+    bool commit();
+
+    /** Append a record */
+    bool write(const void* data);
+
+    /** Replace a record that isn't deleted */
+    bool update(uint32_t index, const void* data);
+
+    /** Delete a record: the indices of the other records don't change until the file is compacted */
+    bool remove(uint32_t index);
+
+    /** @return the amount of records, including the deleted ones */
+    uint32_t getRecordCount() const { return recordsWritten; }
+    uint32_t getDeletedRecordCount() const { return deletedRecordCount; }
 };
 
+/**
+ * Rewrite a file without the deleted records and without the blocks that were replaced.
+ * This renumbers the records and converts version 1 files to version 2.
+ * It reads and writes the whole file, so call it from a background task (e.g. a DispatcherThread) while holding the file lock.
+ * A new file (with a ".tmp" suffix) is written first, so the original file stays intact when compaction is interrupted.
+ * When the file system can't rename onto an existing file, the original file is removed before the new file is renamed:
+ * ObjectFileReader::open() and ObjectFileWriter::open() finish such an interrupted compaction.
+ * @param[in] filePath the file to compact
+ * @param[in] recordSize the size of a record in bytes
+ * @return true when the file was compacted
+ */
+bool compactObjectFile(const std::string& filePath, uint32_t recordSize);
+
 }
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace tt::file {
+
+/**
+ * Encodes an RGB image as PNG, row by row, so the image never has to be in memory as a whole.
+ *
+ * Compression is optimized for speed: every row gets the PNG filter (Sub or Up) that results in the fewest byte changes,
+ * which turns flat areas and repeated rows into runs of equal bytes. Deflate then only looks for matches at 3 fixed distances
+ * (the previous byte, the previous pixel and the same position in the previous row) and uses the fixed Huffman codes,
+ * so there is no hash table and no code table to build.
+ * This compresses user interfaces well, at a fraction of the CPU time and memory of a regular PNG encoder.
+ */
+class PngEncoder final {
+
+public:
+
+    /** Receives the encoded data: return false to stop encoding */
+    typedef std::function<bool(const uint8_t* data, size_t size)> Writer;
+
+private:
+
+    const uint32_t width;
+    const uint32_t height;
+    const size_t rowSize;
+    Writer writer;
+
+    /** The previous row (unfiltered), for the Up filter */
+    std::unique_ptr<uint8_t[]> previousRow;
+    /** The candidate filtered rows, each starting with the filter type */
+    std::unique_ptr<uint8_t[]> subRow;
+    std::unique_ptr<uint8_t[]> upRow;
+    /** The previous filtered row, for matches at the distance of a row */
+    std::unique_ptr<uint8_t[]> previousFilteredRow;
+    bool hasPreviousFilteredRow = false;
+    /** The code for the distance of a row: 0 bits when a row is larger than the deflate window */
+    uint32_t rowDistanceBits = 0;
+    uint32_t rowDistanceBitCount = 0;
+
+    /** Compressed data that wasn't written as an IDAT chunk yet */
+    std::unique_ptr<uint8_t[]> chunkBuffer;
+    size_t chunkSize = 0;
+
+    uint64_t bitBuffer = 0;
+    uint32_t bitCount = 0;
+
+    uint32_t adler = 1;
+    uint32_t rowsWritten = 0;
+    uint64_t bytesWritten = 0;
+    bool failed = false;
+
+    bool write(const uint8_t* data, size_t size);
+    bool writeChunk(const char* type, const uint8_t* data, size_t size);
+    void flushChunk();
+    void writeBits(uint32_t bits, uint32_t count);
+    void flushBits();
+    void compressRow(const uint8_t* filteredRow, const uint8_t* _Nullable previousFiltered);
+    void updateAdler(const uint8_t* data, size_t size);
+
+public:
+
+    static constexpr size_t chunkCapacity = 4096;
+
+    /**
+     * Writes the PNG header.
+     * @param[in] width the image width in pixels
+     * @param[in] height the image height in pixels
+     * @param[in] writer receives the encoded data
+     */
+    PngEncoder(uint32_t width, uint32_t height, Writer writer);
+
+    PngEncoder(const PngEncoder&) = delete;
+    PngEncoder& operator=(const PngEncoder&) = delete;
+
+    /**
+     * @param[in] rgb the pixels of the next row: 3 bytes (red, green, blue) per pixel
+     * @return false when the writer failed or when all rows were already written
+     */
+    bool writeRow(const uint8_t* rgb);
+
+    /**
+     * Writes the end of the image. All rows must be written first.
+     * @return true when the complete image was written
+     */
+    bool finish();
+
+    bool hasFailed() const { return failed; }
+
+    /** @return the amount of bytes that were passed to the writer */
+    uint64_t getBytesWritten() const { return bytesWritten; }
+};
+
+} // namespace tt::file
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <Tactility/file/File.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+/**
+ * @warning The functionality below does NOT safely acquire file locks. Use file::getLock() or file::withLock() when using the functionality below.
+ */
+namespace tt::file {
+
+/**
+ * Extracts a (ustar) tar archive while it is being received.
+ *
+ * Data can be written in chunks of any size: file contents are written straight from the input chunks,
+ * so the only buffer is the 512 byte header block. Directories that were created (or found) once are cached,
+ * so a directory is only checked once per archive instead of once per file.
+ *
+ * Long paths from GNU ('L') and pax ('x') extended headers are applied to the entry that follows them.
+ * Pax "size" records are applied too, other pax records and global pax headers ('g') are ignored.
+ *
+ * Entries with an absolute path or with ".." in their path are rejected.
+ * Symlinks, hardlinks and devices are skipped.
+ */
+class TarExtractor final {
+
+public:
+
+    struct Statistics {
+        /** The amount of regular files that were extracted */
+        uint32_t fileCount;
+        /** The amount of directory entries in the archive */
+        uint32_t directoryCount;
+        /** The amount of times that the file system was checked for a directory */
+        uint32_t directoryLookupCount;
+        /** The amount of file content bytes that were written */
+        uint64_t bytesWritten;
+    };
+
+private:
+
+    static constexpr size_t blockSize = 512;
+    /** Extended headers are kept in memory until the next entry, so their size is limited */
+    static constexpr size_t maxExtendedHeaderSize = 4096;
+
+    enum class State {
+        Header,
+        FileData,
+        ExtendedData,
+        SkipData,
+        Padding,
+        End,
+        Error
+    };
+
+    const std::string destinationPath;
+    State state = State::Header;
+    std::array<uint8_t, blockSize> header;
+    size_t headerSize = 0;
+    std::unique_ptr<FILE, FileCloser> file;
+    std::string filePath;
+    uint32_t fileMode = 0;
+    /** Bytes of the current entry that have not been received yet */
+    uint64_t entryRemaining = 0;
+    /** Bytes that pad the current entry to a block boundary */
+    size_t paddingRemaining = 0;
+    /** The type of the extended header that is being received */
+    char extendedType = 0;
+    std::string extendedData;
+    /** Path from an extended header, for the next entry */
+    std::string nextPath;
+    /** Size from a pax header, for the next entry */
+    std::optional<uint64_t> nextSize;
+    /** Relative paths of directories that are known to exist ("" is the destination path) */
+    std::unordered_set<std::string> knownDirectories;
+    Statistics statistics = { 0, 0, 0, 0 };
+
+    bool ensureDirectory(const std::string& relativePath);
+
+    bool processHeader();
+
+    /** Apply the extended header after all its data was received */
+    bool processExtendedData();
+
+    bool processPaxRecords();
+
+    /** Close the current file after all its data was written */
+    void closeFile();
+
+    /** Sets the error state and closes the current file */
+    bool fail();
+
+public:
+
+    /** @param[in] destinationPath the directory to extract into: it is created when it doesn't exist */
+    explicit TarExtractor(std::string destinationPath) : destinationPath(std::move(destinationPath)) {}
+
+    /**
+     * Process the next part of the archive.
+     * @param[in] data the data
+     * @param[in] size the size of the data in bytes
+     * @return false when the archive is invalid or when writing failed: all following calls will fail too
+     */
+    bool write(const uint8_t* data, size_t size);
+
+    /**
+     * Close the current file (if any) and check that the archive wasn't truncated.
+     * @return true when all entries were fully extracted
+     */
+    bool finish();
+
+    bool hasFailed() const { return state == State::Error; }
+
+    const Statistics& getStatistics() const { return statistics; }
+};
+
+} // namespace tt::file
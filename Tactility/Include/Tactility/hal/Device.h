@@ -1,9 +1,13 @@
 #pragma once
 
+#include <Tactility/PubSub.h>
+
+#include <array>
 #include <functional>
 #include <memory>
 #include <ranges>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <cassert>
 
@@ -24,6 +28,9 @@ public:
         Gps
     };
 
+    /** The amount of values in Type */
+    static constexpr size_t TYPE_COUNT = static_cast<size_t>(Type::Gps) + 1;
+
     typedef uint32_t Id;
 
 private:
@@ -50,6 +57,37 @@ public:
     virtual std::string getDescription() const = 0;
 };
 
+/**
+ * An immutable view of the device registry at a point in time.
+ * It is indexed by type and by identifier, so lookups don't need to filter the full device list.
+ */
+struct DeviceSnapshot {
+    /** Incremented every time a device is registered or deregistered */
+    uint32_t generation = 0;
+    /** All devices in order of registration */
+    std::vector<std::shared_ptr<Device>> devices;
+    /** All devices per Device::Type, in order of registration */
+    std::array<std::vector<std::shared_ptr<Device>>, Device::TYPE_COUNT> devicesByType;
+    std::unordered_map<Device::Id, std::shared_ptr<Device>> devicesById;
+
+    const std::vector<std::shared_ptr<Device>>& getDevices(Device::Type type) const {
+        return devicesByType[static_cast<size_t>(type)];
+    }
+};
+
+struct DeviceEvent {
+    enum class Action {
+        Registered,
+        Deregistered
+    };
+
+    Action action;
+    Device::Id id;
+    Device::Type type;
+    /** The generation of the registry after this change */
+    uint32_t generation;
+};
+
 /**
  * Adds a device to the registry.
  * @warning This will leak memory if you want to destroy a device and don't call deregisterDevice()!
@@ -77,28 +115,45 @@ std::vector<std::shared_ptr<Device>> findDevices(Device::Type type);
 /** Get a copy of the entire device registry in its current state. */
 std::vector<std::shared_ptr<Device>> getDevices();
 
+/**
+ * Get the current state of the registry without taking any lock.
+ * The snapshot doesn't change: get a new one to see registrations that happened afterwards.
+ */
+std::shared_ptr<const DeviceSnapshot> getDeviceSnapshot();
+
+/**
+ * @return a number that changes every time a device is registered or deregistered.
+ * Consumers can cache lookups and only repeat them when the generation changes.
+ */
+uint32_t getDeviceGeneration();
+
+/** @return the PubSub that publishes a DeviceEvent for every registration and deregistration */
+std::shared_ptr<PubSub<DeviceEvent>> getDevicePubsub();
+
 /** Find devices of a certain type and cast them to the specified class */
 template<class DeviceType>
 std::vector<std::shared_ptr<DeviceType>> findDevices(Device::Type type) {
-    auto devices = findDevices(type);
-    if (devices.empty()) {
-        return {};
-    } else {
-        std::vector<std::shared_ptr<DeviceType>> result;
-        result.reserve(devices.size());
-        for (auto& device : devices) {
-            auto target_device = std::static_pointer_cast<DeviceType>(device);
-            assert(target_device != nullptr);
-            result.push_back(target_device);
-        }
-        return std::move(result);
+    auto snapshot = getDeviceSnapshot();
+    const auto& devices = snapshot->getDevices(type);
+    std::vector<std::shared_ptr<DeviceType>> result;
+    result.reserve(devices.size());
+    for (auto& device : devices) {
+        auto target_device = std::static_pointer_cast<DeviceType>(device);
+        assert(target_device != nullptr);
+        result.push_back(target_device);
     }
+    return result;
 }
 
+/**
+ * Iterate over the devices of a certain type without copying the device list.
+ * @param[in] type the type of the devices to iterate over
+ * @param[in] onDeviceFound return true to continue iterating, false to stop
+ */
 template<class DeviceType>
 void findDevices(Device::Type type, std::function<bool(const std::shared_ptr<DeviceType>&)> onDeviceFound) {
-    auto devices_view = findDevices(type);
-    for (auto& device : devices_view) {
+    auto snapshot = getDeviceSnapshot();
+    for (auto& device : snapshot->getDevices(type)) {
         auto typed_device = std::static_pointer_cast<DeviceType>(device);
         if (!onDeviceFound(typed_device)) {
             break;
@@ -109,12 +164,12 @@ void findDevices(Device::Type type, std::function<bool(const std::shared_ptr<Dev
 /** Find the first device of the specified type and cast it to the specified class */
 template<class DeviceType>
 std::shared_ptr<DeviceType> findFirstDevice(Device::Type type) {
-    auto devices = findDevices(type);
+    auto snapshot = getDeviceSnapshot();
+    const auto& devices = snapshot->getDevices(type);
     if (devices.empty()) {
         return {};
     } else {
-        auto& first = devices[0];
-        return std::static_pointer_cast<DeviceType>(first);
+        return std::static_pointer_cast<DeviceType>(devices.front());
     }
 }
 
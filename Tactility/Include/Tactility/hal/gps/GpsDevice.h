@@ -2,6 +2,7 @@
 
 #include "../Device.h"
 #include "GpsConfiguration.h"
+#include "NmeaParser.h"
 #include "Satellites.h"
 
 #include <Tactility/Mutex.h>
@@ -23,9 +24,6 @@ class GpsDevice : public Device {
 
 public:
 
-    typedef int GgaSubscriptionId;
-    typedef int RmcSubscriptionId;
-
     enum class State {
         PendingOn,
         On,
@@ -36,24 +34,11 @@ public:
 
 private:
 
-    struct GgaSubscription {
-        GgaSubscriptionId id;
-        std::shared_ptr<std::function<void(Device::Id id, const minmea_sentence_gga&)>> onData;
-    };
-
-    struct RmcSubscription {
-        RmcSubscriptionId id;
-        std::shared_ptr<std::function<void(Device::Id id, const minmea_sentence_rmc&)>> onData;
-    };
-
     const GpsConfiguration configuration;
     Mutex mutex = Mutex(Mutex::Type::Recursive);
     std::unique_ptr<Thread> _Nullable thread;
     bool threadInterrupted = false;
-    std::vector<GgaSubscription> ggaSubscriptions;
-    std::vector<RmcSubscription> rmcSubscriptions;
-    GgaSubscriptionId lastSatelliteSubscriptionId = 0;
-    RmcSubscriptionId lastRmcSubscriptionId = 0;
+    NmeaParser parser = NmeaParser(getId());
     GpsModel model = GpsModel::Unknown;
     State state = State::Off;
 
@@ -84,37 +69,18 @@ public:
     bool start();
     bool stop();
 
-    GgaSubscriptionId subscribeGga(const std::function<void(Device::Id deviceId, const minmea_sentence_gga&)>& onData) {
-        auto lock = mutex.asScopedLock();
-        lock.lock();
-        ggaSubscriptions.push_back({
-            .id = ++lastSatelliteSubscriptionId,
-            .onData = std::make_shared<std::function<void(Device::Id, const minmea_sentence_gga&)>>(onData)
-        });
-        return lastSatelliteSubscriptionId;
-    }
-
-    void unsubscribeGga(GgaSubscriptionId subscriptionId) {
-        auto lock = mutex.asScopedLock();
-        lock.lock();
-        std::erase_if(ggaSubscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
-    }
-
-    RmcSubscriptionId subscribeRmc(const std::function<void(Device::Id deviceId, const minmea_sentence_rmc&)>& onData) {
-        auto lock = mutex.asScopedLock();
-        lock.lock();
-        rmcSubscriptions.push_back({
-            .id = ++lastRmcSubscriptionId,
-            .onData = std::make_shared<std::function<void(Device::Id, const minmea_sentence_rmc&)>>(onData)
-        });
-        return lastRmcSubscriptionId;
-    }
-
-    void unsubscribeRmc(GgaSubscriptionId subscriptionId) {
-        auto lock = mutex.asScopedLock();
-        lock.lock();
-        std::erase_if(rmcSubscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
-    }
+    /**
+     * The PubSub instances below publish on the GPS thread.
+     * Subscribers that might be slow should subscribe with a Dispatcher or DispatcherThread,
+     * so they don't delay the reading of the UART.
+     * Sentence types without subscribers are not decoded.
+     */
+
+    std::shared_ptr<PubSub<RmcFrame>> getRmcPubsub() const { return parser.getRmcPubsub(); }
+    std::shared_ptr<PubSub<GgaFrame>> getGgaPubsub() const { return parser.getGgaPubsub(); }
+    std::shared_ptr<PubSub<GsaFrame>> getGsaPubsub() const { return parser.getGsaPubsub(); }
+    std::shared_ptr<PubSub<GsvFrame>> getGsvPubsub() const { return parser.getGsvPubsub(); }
+    std::shared_ptr<PubSub<VtgFrame>> getVtgPubsub() const { return parser.getVtgPubsub(); }
 
     GpsModel getModel() const;
 
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../Device.h"
+
+#include <Tactility/PubSub.h>
+
+#include <minmea.h>
+
+namespace tt::hal::gps {
+
+/** A decoded NMEA sentence and the device that received it */
+template<typename SentenceType>
+struct NmeaFrame {
+    Device::Id deviceId;
+    /** The null-terminated talker ID (e.g. "GP" for GPS, "GN" for combined constellations) */
+    char talkerId[3];
+    SentenceType sentence;
+};
+
+typedef NmeaFrame<minmea_sentence_rmc> RmcFrame;
+typedef NmeaFrame<minmea_sentence_gga> GgaFrame;
+typedef NmeaFrame<minmea_sentence_gsa> GsaFrame;
+typedef NmeaFrame<minmea_sentence_gsv> GsvFrame;
+typedef NmeaFrame<minmea_sentence_vtg> VtgFrame;
+
+/**
+ * Decodes NMEA sentences and publishes them per sentence type.
+ *
+ * The sentence type is read straight from the line, before the checksum is verified.
+ * Sentences of a type that has no subscribers are skipped without validating or decoding them.
+ * Publishing doesn't take any lock (see PubSub), so subscribers can't block the caller on a mutex,
+ * but synchronous subscribers still run on the caller's thread.
+ *
+ * process() must be called from a single thread. Subscribing is thread-safe.
+ */
+class NmeaParser final {
+
+public:
+
+    struct Statistics {
+        /** The amount of lines passed to process() */
+        uint32_t sentenceCount;
+        /** The amount of sentences that were decoded and published */
+        uint32_t publishedCount;
+        /** The amount of sentences that were ignored because of their type or a lack of subscribers */
+        uint32_t skippedCount;
+        /** The amount of sentences with an invalid checksum or invalid content */
+        uint32_t errorCount;
+    };
+
+private:
+
+    const Device::Id deviceId;
+    std::shared_ptr<PubSub<RmcFrame>> rmcPubSub = std::make_shared<PubSub<RmcFrame>>();
+    std::shared_ptr<PubSub<GgaFrame>> ggaPubSub = std::make_shared<PubSub<GgaFrame>>();
+    std::shared_ptr<PubSub<GsaFrame>> gsaPubSub = std::make_shared<PubSub<GsaFrame>>();
+    std::shared_ptr<PubSub<GsvFrame>> gsvPubSub = std::make_shared<PubSub<GsvFrame>>();
+    std::shared_ptr<PubSub<VtgFrame>> vtgPubSub = std::make_shared<PubSub<VtgFrame>>();
+    Statistics statistics = { 0, 0, 0, 0 };
+
+    template<typename SentenceType>
+    bool decodeAndPublish(
+        const char* sentence,
+        PubSub<NmeaFrame<SentenceType>>& pubSub,
+        bool (*parse)(SentenceType*, const char*)
+    );
+
+public:
+
+    /** @param[in] deviceId the identifier that is set in all published frames */
+    explicit NmeaParser(Device::Id deviceId) : deviceId(deviceId) {}
+
+    /**
+     * Decode a sentence and publish it when its type has subscribers.
+     * @param[in] sentence a null-terminated NMEA sentence (trailing CR/LF are allowed)
+     * @return true when the sentence was decoded and published
+     */
+    bool process(const char* sentence);
+
+    /** @return the statistics (only safe to read from the thread that calls process()) */
+    const Statistics& getStatistics() const { return statistics; }
+
+    /** @return the PubSub for RMC (recommended minimum data) sentences */
+    std::shared_ptr<PubSub<RmcFrame>> getRmcPubsub() const { return rmcPubSub; }
+
+    /** @return the PubSub for GGA (fix data) sentences */
+    std::shared_ptr<PubSub<GgaFrame>> getGgaPubsub() const { return ggaPubSub; }
+
+    /** @return the PubSub for GSA (dilution of precision and active satellites) sentences */
+    std::shared_ptr<PubSub<GsaFrame>> getGsaPubsub() const { return gsaPubSub; }
+
+    /** @return the PubSub for GSV (satellites in view) sentences */
+    std::shared_ptr<PubSub<GsvFrame>> getGsvPubsub() const { return gsvPubSub; }
+
+    /** @return the PubSub for VTG (track and ground speed) sentences */
+    std::shared_ptr<PubSub<VtgFrame>> getVtgPubsub() const { return vtgPubSub; }
+};
+
+} // namespace tt::hal::gps
@@ -5,55 +5,139 @@
 
 #include <minmea.h>
 
-#include <ranges>
-#include <memory>
+#include <array>
+#include <bit>
+#include <functional>
+#include <span>
 
 namespace tt::hal::gps {
 
-/** Thread-safe storage of recent satellites */
+/** The satellite system that a satellite belongs to, derived from the NMEA talker ID */
+enum class Constellation : uint8_t {
+    Unknown,
+    Gps,
+    Glonass,
+    Galileo,
+    BeiDou,
+    Qzss,
+    Navic
+};
+
+/**
+ * @param[in] talkerId the 2 characters after the "$" of an NMEA sentence (e.g. "GP")
+ * @return the constellation or Unknown
+ */
+Constellation toConstellation(const char* talkerId);
+
+/** A satellite as stored by SatelliteStorage */
+struct Satellite {
+    Constellation constellation;
+    minmea_sat_info info;
+    TickType_t lastUpdated;
+};
+
+/**
+ * Thread-safe storage of recent satellites.
+ *
+ * Satellites are stored in a fixed pool and are found through an open-addressed hash table
+ * that is keyed by constellation and PRN. The pool records form an intrusive LRU list:
+ * when the pool is full, the satellite that wasn't updated for the longest time is recycled.
+ */
 class SatelliteStorage {
 
 public:
 
-    static constexpr size_t recordCount = 32;
+    static constexpr size_t recordCount = 64;
 
 private:
 
+    static constexpr uint8_t noIndex = 0xFF;
+    /** Twice the record count keeps the load factor at or below 50% */
+    static constexpr size_t slotCount = recordCount * 2;
+
     struct SatelliteRecord {
-        minmea_sat_info data {
-            .nr = 0,
-            .elevation = 0,
-            .azimuth = 0,
-            .snr = 0
+        Satellite satellite = {
+            .constellation = Constellation::Unknown,
+            .info = {
+                .nr = 0,
+                .elevation = 0,
+                .azimuth = 0,
+                .snr = 0
+            },
+            .lastUpdated = 0
         };
-        TickType_t lastUpdated = 0;
-        bool inUse = false;
+        /** LRU list links (or the free list link in "next" when the record is unused) */
+        uint8_t previous = noIndex;
+        uint8_t next = noIndex;
     };
 
+    static_assert(recordCount < noIndex);
+
     Mutex mutex = Mutex(Mutex::Type::Recursive);
     std::array<SatelliteRecord, recordCount> records;
-    uint16_t recycleTimeSeconds;
+    /** Hash slots that hold record indices or noIndex */
+    std::array<uint8_t, slotCount> slots;
+    /** Most recently updated record */
+    uint8_t newestIndex = noIndex;
+    /** Least recently updated record: the first to be recycled */
+    uint8_t oldestIndex = noIndex;
+    uint8_t freeIndex = 0;
     uint16_t recentTimeSeconds;
 
-    SatelliteRecord* findRecord(int number);
+    static uint32_t toKey(Constellation constellation, int number) {
+        return (static_cast<uint32_t>(constellation) << 16) | (static_cast<uint32_t>(number) & 0xFFFFU);
+    }
+
+    static size_t toSlot(uint32_t key) {
+        // Fibonacci hashing spreads the sequential PRNs over the slots
+        return (key * 2654435769U) >> (32 - std::countr_zero(slotCount));
+    }
 
-    SatelliteRecord* findUnusedRecord();
+    uint32_t getKey(uint8_t recordIndex) const {
+        const auto& satellite = records[recordIndex].satellite;
+        return toKey(satellite.constellation, satellite.info.nr);
+    }
 
-    SatelliteRecord* findRecordToRecycle();
+    /** @return the slot that holds the key, or the empty slot where it should be inserted */
+    size_t findSlot(uint32_t key) const;
 
-    /** Tries to find an existing record, otherwise return a free one, otherwise return the oldest active one */
-    SatelliteRecord* findWithFallback(int number);
+    void removeFromSlots(uint8_t recordIndex);
+
+    void unlink(uint8_t recordIndex);
+
+    void linkAsNewest(uint8_t recordIndex);
+
+    /** Must be called while holding the mutex */
+    void update(Constellation constellation, const minmea_sat_info& info, TickType_t now);
 
 public:
 
-    explicit SatelliteStorage(
-        uint16_t recycleTimeSeconds = 120,
-        uint16_t recentTimeSeconds = 60
-    ) : recycleTimeSeconds(recycleTimeSeconds), recentTimeSeconds(recentTimeSeconds) {}
+    /**
+     * @param[in] recentTimeSeconds the time after which a satellite is no longer considered visible
+     */
+    explicit SatelliteStorage(uint16_t recentTimeSeconds = 60);
 
-    void notify(const minmea_sat_info& info);
+    /** Add or update a satellite */
+    void notify(Constellation constellation, const minmea_sat_info& info);
 
+    /** Add or update a satellite of an unknown constellation */
+    void notify(const minmea_sat_info& info) { notify(Constellation::Unknown, info); }
+
+    /** Add or update all satellites of a GSV sentence with a single lock */
+    void notify(Constellation constellation, const minmea_sentence_gsv& gsv);
+
+    /**
+     * Call the function for every visible satellite while holding the lock.
+     * Prefer getSnapshot() when the function is slow (e.g. when it updates a UI).
+     */
     void getRecords(const std::function<void(const minmea_sat_info&)>& onRecord) const;
+
+    /**
+     * Copy the visible satellites without allocating.
+     * @param[out] output the storage for the satellites (recordCount is always enough)
+     * @return the amount of satellites that were written to the output
+     */
+    size_t getSnapshot(std::span<Satellite> output) const;
 };
 
 } // namespace tt::hal::gps
@@ -36,6 +36,12 @@ public:
      */
     virtual bool getMetric(MetricType type, MetricData& data) = 0;
 
+    /**
+     * @return true when the ChargeLevel metric is derived from the BatteryVoltage metric (e.g. a linear estimate)
+     * instead of being measured by a fuel gauge. The power service then derives the charge level from the filtered voltage.
+     */
+    virtual bool isChargeLevelEstimatedFromVoltage() const { return false; }
+
     virtual bool supportsChargeControl() const { return false; }
     virtual bool isAllowedToCharge() const { return false; }
     virtual void setAllowedToCharge(bool canCharge) { /* NO-OP*/ }
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "PowerDevice.h"
+
+#include <Tactility/Mutex.h>
+
+#include <atomic>
+
+namespace tt::hal::power {
+
+/**
+ * A power device with a simulated battery, for the simulator and for tests.
+ * Like an ADC-based device, it measures the battery voltage with noise and estimates the charge level from it.
+ * The noise is pseudo-random with a fixed seed, so tests are deterministic.
+ */
+class SimulatedPowerDevice final : public PowerDevice {
+
+public:
+
+    struct Configuration {
+        uint32_t batteryVoltage = 3900; // mV
+        /** The amplitude of the measurement noise in mV */
+        uint32_t noise = 0;
+        int32_t current = -120; // mA
+        bool isExternalPowerConnected = false;
+    };
+
+private:
+
+    mutable Mutex mutex;
+    Configuration configuration;
+    bool allowedToCharge = true;
+    uint32_t noiseState = 0x2545F491U;
+    std::atomic<uint32_t> measurementCount = 0;
+
+    uint32_t measureBatteryVoltage();
+
+public:
+
+    explicit SimulatedPowerDevice(const Configuration& configuration) : configuration(configuration) {}
+    SimulatedPowerDevice() : SimulatedPowerDevice(Configuration()) {}
+    ~SimulatedPowerDevice() override = default;
+
+    std::string getName() const override { return "Simulated Power"; }
+    std::string getDescription() const override { return "Power device with a simulated battery"; }
+
+    bool supportsMetric(MetricType type) const override;
+    bool getMetric(MetricType type, MetricData& data) override;
+    bool isChargeLevelEstimatedFromVoltage() const override { return true; }
+
+    bool supportsChargeControl() const override { return true; }
+    bool isAllowedToCharge() const override;
+    void setAllowedToCharge(bool canCharge) override;
+
+    void setBatteryVoltage(uint32_t milliVolt);
+    void setExternalPowerConnected(bool connected);
+
+    /** @return the amount of times that the "hardware" was accessed by getMetric() */
+    uint32_t getMeasurementCount() const { return measurementCount; }
+};
+
+} // namespace tt::hal::power
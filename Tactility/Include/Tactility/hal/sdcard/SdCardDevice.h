@@ -31,6 +31,17 @@ private:
 
     MountBehaviour mountBehaviour;
 
+protected:
+
+    /**
+     * Implementations must call this after mounting successfully.
+     * It registers the mount in the file::MountTable, so paths resolve to this device without querying it.
+     */
+    void onMounted(const std::string& mountPath);
+
+    /** Implementations must call this after unmounting successfully. */
+    void onUnmounted(const std::string& mountPath);
+
 public:
 
     explicit SdCardDevice(MountBehaviour mountBehaviour) : mountBehaviour(mountBehaviour) {}
@@ -66,7 +77,7 @@ public:
     bool isMounted(TickType_t timeout = portMAX_DELAY) const { return getState(timeout) == State::Mounted; }
 };
 
-/** Return the SdCard device if the path is within the SdCard mounted path (path std::string::starts_with() check)*/
+/** Return the SdCard device if the path is within the SdCard mounted path (longest matching mount path in the file::MountTable) */
 std::shared_ptr<SdCardDevice> _Nullable find(const std::string& path);
 
 /**
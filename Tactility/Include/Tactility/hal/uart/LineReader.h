@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Uart.h"
+
+#include <memory>
+#include <string_view>
+
+namespace tt::hal::uart {
+
+/**
+ * Buffered line framing on top of a Uart.
+ *
+ * Instead of reading a byte at a time, it reads all available data in large chunks into its buffer,
+ * then finds delimiters with memchr(). Lines are handed out as views into the buffer, so they are never copied.
+ *
+ * Lines that don't fit in the buffer are discarded (see Statistics::overflowCount).
+ * Not thread-safe: use 1 LineReader per reading thread.
+ */
+class LineReader final {
+
+public:
+
+    struct Statistics {
+        /** The total amount of bytes received from the Uart */
+        uint64_t bytesRead;
+        /** The amount of lines returned by readLine() */
+        uint32_t lineCount;
+        /** The amount of lines that were discarded because they didn't fit in the buffer */
+        uint32_t overflowCount;
+        /** The amount of readBytes() calls on the Uart */
+        uint32_t readCount;
+    };
+
+private:
+
+    Uart& uart;
+    const uint8_t delimiter;
+    const size_t bufferSize;
+    std::unique_ptr<char[]> buffer;
+    /** Start of unprocessed data */
+    size_t start = 0;
+    /** End of received data */
+    size_t end = 0;
+    /** Position up to which the data was already searched for a delimiter */
+    size_t scanned = 0;
+    /** When true, data is dropped until the next delimiter because the current line overflowed */
+    bool discarding = false;
+    Statistics statistics = { 0, 0, 0, 0 };
+
+    /** Move unprocessed data to the start of the buffer */
+    void compact();
+
+    /** Read as much as is available (and fits), waiting up to the timeout for the first byte */
+    bool fill(TickType_t timeout);
+
+public:
+
+    /**
+     * @param[in] uart the started Uart to read from (must outlive this LineReader)
+     * @param[in] bufferSize the buffer size in bytes, which is also the maximum line length (including delimiter)
+     * @param[in] delimiter the byte that ends a line
+     */
+    explicit LineReader(Uart& uart, size_t bufferSize = 512, uint8_t delimiter = '\n');
+
+    /**
+     * Read the next line.
+     * The view excludes the delimiter, and the delimiter in the buffer is replaced by a null terminator,
+     * so line.data() can be passed to C APIs that expect a C string.
+     * @warning the line is only valid until the next call to readLine()
+     * @param[out] line the line
+     * @param[in] timeout the maximum time to wait for a full line
+     * @return true when a line was read
+     */
+    bool readLine(std::string_view& line, TickType_t timeout = defaultTimeout);
+
+    /** Discard all buffered data */
+    void reset();
+
+    const Statistics& getStatistics() const { return statistics; }
+};
+
+} // namespace tt::hal::uart
@@ -107,6 +107,7 @@ public:
 
     /**
      * Read a buffer as a byte array until the specified character (the "untilChar" is included in the result)
+     * @warning this reads 1 byte at a time: use LineReader for continuous line-based input (e.g. NMEA)
      * @return the amount of bytes read from UART
      */
     size_t readUntil(std::byte* buffer, size_t bufferSize, uint8_t untilByte, TickType_t timeout = defaultTimeout, bool addNullTerminator = true);
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace tt::i18n {
@@ -9,41 +12,61 @@ namespace tt::i18n {
  * Holds localized text data.
  *
  * It is used with data generated from Translations/ with the python generation scripts.
- * It's used with a header file that specifies the indexes, and generated text files (.i18n)
+ * It's used with a header file that specifies the indexes, and generated data files:
+ * binary string tables (.i18nb) or text files with one translation per line (.i18n).
+ *
+ * The file is loaded into a single buffer and all texts are views into that buffer.
+ * A binary string table is used as-is, so loading it doesn't parse or copy the texts.
  */
 class TextResources {
 
-    std::vector<std::string> data;
     std::string path;
-    static std::string ERROR_RESULT;
+    /** The file contents */
+    std::unique_ptr<uint8_t[]> buffer;
+    /** The start of the strings in the buffer */
+    const char* strings = nullptr;
+    /** For binary files: the little-endian offset table in the buffer */
+    const uint8_t* binaryOffsets = nullptr;
+    /** For text files: the offset of every line */
+    std::vector<uint32_t> lineOffsets;
+    size_t count = 0;
+
+    bool loadBinary(const std::string& filePath);
+
+    bool loadText(const std::string& filePath);
 
 public:
+
+    static constexpr std::string_view ERROR_RESULT = "TXT_RES_ERROR";
+
     /**
-     * @param[in] path
+     * @param[in] path the directory that contains the data files (e.g. "en-US.i18nb")
      */
     TextResources(const std::string& path) : path(path) {}
 
-    const std::string& get(const int index) const {
-        if (index < data.size()) {
-            return data[index];
-        } else {
-            return ERROR_RESULT;
-        }
-    }
+    /**
+     * @return the text, which is null-terminated: data() can be passed to C APIs such as LVGL.
+     * The text is valid until the next load() call or until this object is destroyed.
+     */
+    std::string_view get(const int index) const;
 
     template <typename EnumType>
-    const std::string& get(EnumType value) const { return get(static_cast<int>(value)); }
+    std::string_view get(EnumType value) const { return get(static_cast<int>(value)); }
 
-    const std::string& operator[](const int index) const { return get(index); }
+    std::string_view operator[](const int index) const { return get(index); }
 
     template <typename EnumType>
-    const std::string& operator[](const EnumType index) const { return get(index); }
+    std::string_view operator[](const EnumType index) const { return get(index); }
+
+    /** @return the amount of texts */
+    size_t getCount() const { return count; }
 
     /**
      * Load or reload an i18n file with the system's current locale settings.
+     * A binary file (.i18nb) is used when available, otherwise the text file (.i18n) is used.
      * @return true on success
      */
     bool load();
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <lvgl.h>
+
+#include <memory>
+#include <string>
+
+namespace tt::lvgl {
+
+/**
+ * An image from the system asset pack, in a color format that LVGL draws without decoding.
+ * Widgets refer to the descriptor by pointer, so keep the shared_ptr for as long as a widget uses it.
+ */
+struct CachedImage {
+    lv_image_dsc_t descriptor;
+    /** The color of an alpha-only (A8) image: LVGL draws these with the image recolor style */
+    lv_color_t color;
+
+    bool isAlphaOnly() const { return descriptor.header.cf == LV_COLOR_FORMAT_A8; }
+};
+
+struct ImageCacheStatistics {
+    /** Lookups that were served from memory */
+    uint32_t hitCount;
+    /** Lookups that had to read the image from the asset pack */
+    uint32_t missCount;
+    /** Images that were removed from memory to stay within the budget */
+    uint32_t evictionCount;
+    /** The amount of bytes used by cached image data */
+    size_t usedMemory;
+};
+
+/**
+ * Find a pre-decoded image in the system asset pack.
+ * Images are kept in memory until the cache exceeds config::IMAGE_CACHE_MEMORY_BUDGET:
+ * then the least recently used images that are no longer referenced are removed.
+ * @param[in] path an LVGL image path, e.g. lvgl::PATH_PREFIX + paths->getAssetsPath("icon.png")
+ * @return the image, or nullptr when the asset pack doesn't contain it (use the path instead)
+ */
+std::shared_ptr<const CachedImage> findCachedImage(const std::string& path);
+
+/**
+ * Set the image of an image widget from the asset pack, or from the file when the pack doesn't contain it.
+ * The widget keeps the cached image alive until it is deleted.
+ * An alpha-only image gets its original color as recolor style: set recolor styles afterwards to override it.
+ * @param[in] image the image widget
+ * @param[in] path an LVGL image path, e.g. lvgl::PATH_PREFIX + paths->getAssetsPath("icon.png")
+ */
+void image_set_src_cached(lv_obj_t* image, const std::string& path);
+
+ImageCacheStatistics getImageCacheStatistics();
+
+} // namespace tt::lvgl
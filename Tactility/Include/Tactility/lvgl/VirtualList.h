@@ -0,0 +1,62 @@
+#pragma once
+
+#include <lvgl.h>
+
+#include <functional>
+
+namespace tt::lvgl {
+
+/**
+ * Shows the item at the specified index in a row.
+ * Rows are re-used for other items while scrolling, so the callback must set all the content of the row.
+ */
+typedef std::function<void(lv_obj_t* row, size_t index)> VirtualListBindFunction;
+
+typedef std::function<void(size_t index)> VirtualListClickFunction;
+
+/**
+ * Create a list that only has widgets for the rows that are visible.
+ *
+ * All rows have the same height. While scrolling, rows that move out of view are bound to the items that
+ * move into view, so the amount of LVGL objects doesn't depend on the item count.
+ * A row stays bound to the same item while it is in view, so the focused row doesn't change while scrolling.
+ *
+ * @param[in] parent the parent widget
+ * @param[in] bind the function that sets the content of a row (see virtual_list_row_set_text())
+ * @param[in] onClick the function that is called when a row is clicked
+ * @return the list widget
+ */
+lv_obj_t* virtual_list_create(lv_obj_t* parent, VirtualListBindFunction bind, VirtualListClickFunction onClick);
+
+/**
+ * Set the amount of items: the list scrolls back to the top and all visible rows are bound again.
+ * @param[in] list the list widget
+ * @param[in] count the amount of items
+ */
+void virtual_list_set_item_count(lv_obj_t* list, size_t count);
+
+/**
+ * Set the function that is called when a row is long-pressed
+ * @param[in] list the list widget
+ * @param[in] onLongPress the callback, or nullptr to remove it
+ */
+void virtual_list_set_long_press_callback(lv_obj_t* list, VirtualListClickFunction onLongPress);
+
+/** @return the amount of items in the list */
+size_t virtual_list_get_item_count(lv_obj_t* list);
+
+/** Bind all visible rows again (e.g. after the data of the items changed) */
+void virtual_list_refresh(lv_obj_t* list);
+
+/**
+ * Set the content of a row (for use in the bind function)
+ * @param[in] row the row widget
+ * @param[in] icon an LVGL image source (e.g. a symbol) or nullptr for no icon
+ * @param[in] text the row text
+ */
+void virtual_list_row_set_content(lv_obj_t* row, const void* icon, const char* text);
+
+/** Set the text of a row without an icon (for use in the bind function) */
+void virtual_list_row_set_text(lv_obj_t* row, const char* text);
+
+} // namespace tt::lvgl
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Tactility/DispatcherThread.h>
+#include <Tactility/file/DoubleBufferedWriter.h>
+#include <Tactility/Mutex.h>
+
+#include <functional>
+#include <string>
+
+namespace tt::network::http {
+
+struct DownloadProgress {
+    /** The amount of bytes in the file, including the bytes of a resumed download */
+    uint64_t bytesReceived;
+    /** The expected file size, or -1 when the server didn't send a Content-Length */
+    int64_t totalBytes;
+    /** The average transfer rate since the (re)connect */
+    uint32_t bytesPerSecond;
+};
+
+struct DownloadRequest {
+    std::string url;
+    /** The .pem file for HTTPS */
+    std::string certFilePath;
+    /** The destination file. The parent directories must exist. */
+    std::string filePath;
+    /**
+     * Continue a previous download that was interrupted, if any.
+     * Only use this when the content of the URL doesn't change (e.g. a versioned file).
+     */
+    bool resume = false;
+    /** Called from the download thread after every block that was received */
+    std::function<void(const DownloadProgress& progress)> onProgress;
+    /** Called from the download thread */
+    std::function<void()> onSuccess;
+    /** Called from the download thread */
+    std::function<void(const char* errorMessage)> onError;
+};
+
+/**
+ * Downloads files on its own thread, one at a time.
+ *
+ * The data is received straight into a DoubleBufferedWriter block: while the next block is received,
+ * the previous one is written to storage. Memory usage is fixed to 2 blocks, regardless of the file size.
+ *
+ * Data is written to "<filePath>.part" and renamed when the download is complete.
+ * When a connection fails during the transfer, it reconnects and requests the remaining data with a Range header.
+ * When a request has "resume" set, an existing .part file from an earlier attempt is continued in the same way.
+ */
+class DownloadManager final {
+
+public:
+
+    struct Statistics {
+        uint32_t completedCount;
+        uint32_t failedCount;
+        /** The amount of range requests that were accepted by the server */
+        uint32_t resumedCount;
+        /** The amount of body bytes received over all downloads */
+        uint64_t bytesReceived;
+    };
+
+    /** The maximum amount of connections per download */
+    static constexpr uint32_t maxAttempts = 3;
+
+private:
+
+    file::DoubleBufferedWriter writer;
+    DispatcherThread dispatcherThread;
+    mutable Mutex mutex;
+    Statistics statistics = { 0, 0, 0, 0 };
+
+    void run(const DownloadRequest& request);
+
+    /** @return nullptr on success, or an error message */
+    const char* transfer(const DownloadRequest& request, const std::string& partFilePath);
+
+    /**
+     * Make a single request and receive (the rest of) the file.
+     * @param[in,out] offset the amount of bytes in the .part file
+     * @param[out] retry whether it makes sense to try again after a failure
+     * @return nullptr when all data was received, or an error message
+     */
+    const char* receive(const DownloadRequest& request, const std::string& partFilePath, uint64_t& offset, bool& retry);
+
+public:
+
+    /** @param[in] blockSize the size of each of the 2 write buffers */
+    explicit DownloadManager(size_t blockSize = file::DoubleBufferedWriter::defaultBlockSize);
+
+    ~DownloadManager();
+
+    /** Queue a download: it starts after earlier downloads are finished */
+    void enqueue(DownloadRequest request);
+
+    Statistics getStatistics() const;
+};
+
+/** @return the download manager that is shared by all apps and services */
+DownloadManager& getDownloadManager();
+
+} // namespace tt::network::http
@@ -34,6 +34,11 @@ public:
         return client != nullptr;
     }
 
+    bool setHeader(const char* key, const char* value) {
+        assert(client != nullptr);
+        return esp_http_client_set_header(client, key, value) == ESP_OK;
+    }
+
     bool open() {
         assert(client != nullptr);
         TT_LOG_I(TAG, "open()");
@@ -74,7 +79,7 @@ public:
 
     int read(char* bytes, int size) const {
         assert(client != nullptr);
-        TT_LOG_I(TAG, "read(%d)", size);
+        TT_LOG_V(TAG, "read(%d)", size);
         return esp_http_client_read(client, bytes, size);
     }
 
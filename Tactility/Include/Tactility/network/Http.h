@@ -5,8 +5,8 @@
 
 namespace tt::network::http {
     /**
-     * Download a file from a URL.
-     * The server must send the Content-Length header.
+     * Download a file from a URL with the DownloadManager.
+     * The callbacks are called from the main dispatcher.
      * @param url download source URL
      * @param certFilePath the path to the .pem file
      * @param downloadFilePath The path to downloadd the file to. The parent directories must exist.
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace tt::network::http {
+
+/**
+ * A single HTTP GET request and its response body.
+ *
+ * On ESP32 this uses esp_http_client. HTTPS certificates are parsed once and then cached,
+ * as long as the same certificate file is used.
+ * On other platforms only plain "http://" URLs are supported.
+ */
+class HttpConnection {
+
+public:
+
+    virtual ~HttpConnection() = default;
+
+    /**
+     * Connect, send the request and read the response headers.
+     * @param[in] url the URL to request
+     * @param[in] certFilePath the path to the .pem file for HTTPS
+     * @param[in] rangeStart when non-zero, only the data starting at this offset is requested (with a Range header)
+     * @return true when the response headers were received
+     */
+    virtual bool open(const std::string& url, const std::string& certFilePath, uint64_t rangeStart) = 0;
+
+    /** @return the response status code (e.g. 206 when a range request was accepted) */
+    virtual int getStatusCode() const = 0;
+
+    /** @return the Content-Length of the response, or -1 when it is unknown */
+    virtual int64_t getContentLength() const = 0;
+
+    /**
+     * Read the next part of the response body.
+     * @param[out] data the buffer to read into
+     * @param[in] size the size of the buffer
+     * @return the amount of bytes read, 0 at the end of the body or a negative value on error
+     */
+    virtual int read(uint8_t* data, size_t size) = 0;
+};
+
+/** @return a connection for the current platform */
+std::unique_ptr<HttpConnection> createHttpConnection();
+
+} // namespace tt::network::http
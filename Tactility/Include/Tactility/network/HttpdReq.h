@@ -3,10 +3,9 @@
 #ifdef ESP_PLATFORM
 
 #include <esp_http_server.h>
-#include <map>
+#include <functional>
 #include <memory>
 #include <string>
-#include <vector>
 
 namespace tt::network {
 
@@ -18,11 +17,15 @@ bool getQueryOrSendError(httpd_req_t* request, std::string& query);
 
 std::unique_ptr<char[]> receiveByteArray(httpd_req_t* request, size_t length, size_t& bytesRead);
 
-std::string receiveTextUntil(httpd_req_t* request, const std::string& terminator);
-
-std::map<std::string, std::string> parseContentDisposition(const std::vector<std::string>& input);
-
-bool readAndDiscardOrSendError(httpd_req_t* request, const std::string& toRead);
+/**
+ * Receive the request body in chunks, without storing all of it.
+ * Multipart bodies can be passed on to a MultipartParser.
+ * @param[in] request the request
+ * @param[in] length the amount of bytes to receive
+ * @param[in] onChunk called for every received chunk: return false to stop receiving
+ * @return the amount of bytes that were received and accepted by onChunk
+ */
+size_t receiveChunks(httpd_req_t* request, size_t length, const std::function<bool(const char* data, size_t size)>& onChunk);
 
 size_t receiveFile(httpd_req_t* request, size_t length, const std::string& filePath);
 
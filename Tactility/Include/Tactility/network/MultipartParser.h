@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tt::network {
+
+/**
+ * Parses a multipart/form-data body (RFC 7578) while it is being received.
+ *
+ * The body can be passed in chunks of any size. Part data is passed on as slices of the input chunks,
+ * so it is never copied. Only the header lines of a part and the few bytes at the end of a chunk that
+ * could be the start of a boundary are buffered.
+ *
+ * Boundaries are found with a Boyer-Moore-Horspool search, so most bytes of a part aren't even inspected.
+ *
+ * The parser doesn't depend on the HTTP server: see network::receiveChunks() for use with httpd requests.
+ */
+class MultipartParser final {
+
+public:
+
+    /**
+     * Called when the headers of a part were received.
+     * @param[in] headers the header lines without line endings (e.g. "Content-Type: text/plain")
+     * @return false to stop parsing
+     */
+    typedef std::function<bool(const std::vector<std::string>& headers)> PartBeginFunction;
+
+    /**
+     * Called with the next slice of the data of the current part. Slices can have any size (including 1 byte).
+     * @return false to stop parsing
+     */
+    typedef std::function<bool(const char* data, size_t size)> PartDataFunction;
+
+    /**
+     * Called when all data of the current part was passed on.
+     * @return false to stop parsing
+     */
+    typedef std::function<bool()> PartEndFunction;
+
+    /** The maximum size of the headers of a single part */
+    static constexpr size_t maxHeaderSize = 1024;
+
+    struct Statistics {
+        /** The amount of parts that were started */
+        uint32_t partCount;
+        /** The amount of part data bytes that were passed to the PartDataFunction */
+        uint64_t dataBytes;
+    };
+
+private:
+
+    enum class State {
+        /** Data before the first boundary, which is ignored */
+        Preamble,
+        /** The 2 characters after a boundary: "\r\n" for another part or "--" for the end */
+        AfterBoundary,
+        Headers,
+        Data,
+        /** Data after the final boundary, which is ignored */
+        End,
+        Error
+    };
+
+    /** "\r\n--" followed by the boundary */
+    const std::string delimiter;
+    PartBeginFunction onPartBegin;
+    PartDataFunction onPartData;
+    PartEndFunction onPartEnd;
+    /** Boyer-Moore-Horspool shift for every byte value */
+    std::array<uint8_t, 256> shiftTable;
+    State state = State::Preamble;
+    /** The start of the input that might be a delimiter, kept until the next chunk shows whether it is one */
+    std::string pending;
+    std::string headers;
+    char afterBoundary[2];
+    size_t afterBoundarySize = 0;
+    Statistics statistics = { 0, 0 };
+
+    /** @return the index of the first delimiter in the data, or size when there is none */
+    size_t findDelimiter(const char* data, size_t size) const;
+
+    /** @return the index of the shortest suffix that is the start of a delimiter, or size when there is none */
+    size_t findPartialDelimiter(const char* data, size_t size) const;
+
+    /** Handle data in the Preamble or Data state */
+    bool consumeContent(const char*& data, size_t& size);
+
+    bool consumeAfterBoundary(const char*& data, size_t& size);
+
+    bool consumeHeaders(const char*& data, size_t& size);
+
+    /** Pass part data on (or ignore it in the preamble) */
+    bool emit(const char* data, size_t size);
+
+    /** Called when a delimiter was found in the Preamble or Data state */
+    bool onDelimiter();
+
+    bool fail();
+
+public:
+
+    /**
+     * @param[in] boundary the boundary from the Content-Type header (without the leading "--")
+     * @param[in] onPartBegin called when a new part starts
+     * @param[in] onPartData called with the part data
+     * @param[in] onPartEnd called when a part ends
+     */
+    MultipartParser(
+        const std::string& boundary,
+        PartBeginFunction onPartBegin,
+        PartDataFunction onPartData,
+        PartEndFunction onPartEnd
+    );
+
+    /**
+     * Process the next chunk of the body.
+     * @return false when the body is invalid or when a callback returned false: all following calls will fail too
+     */
+    bool write(const char* data, size_t size);
+
+    /** @return true when the final boundary was received */
+    bool finish() const { return state == State::End; }
+
+    bool hasFailed() const { return state == State::Error; }
+
+    const Statistics& getStatistics() const { return statistics; }
+};
+
+/**
+ * Parse the Content-Disposition header of a multipart part.
+ * @param[in] headers the header lines of a part
+ * @return the parameters (e.g. "name" and "filename") or an empty map when the header wasn't found
+ */
+std::map<std::string, std::string> parseContentDisposition(const std::vector<std::string>& headers);
+
+} // namespace tt::network
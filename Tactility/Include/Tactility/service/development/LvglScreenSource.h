@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Tactility/Mutex.h>
+#include <Tactility/service/development/ScreenSource.h>
+
+#include <deque>
+#include <lvgl.h>
+
+namespace tt::service::development {
+
+/**
+ * Streams the default LVGL display.
+ * The pixels are taken from the flush path: every area that LVGL sends to the display driver is copied into the buffer.
+ * This works for all display drivers, as it happens before the driver swaps bytes or rotates pixels.
+ * Input is injected through a pointer and a keypad input device that are only registered while streaming.
+ */
+class LvglScreenSource final : public ScreenSource {
+
+    struct PointerEvent {
+        uint32_t sequence;
+        int16_t x;
+        int16_t y;
+        bool pressed;
+    };
+
+    struct KeyEvent {
+        uint32_t sequence;
+        uint32_t key;
+        bool pressed;
+    };
+
+    /** Limits the input that is queued when the UI is busy */
+    static constexpr size_t MAX_QUEUED_EVENTS = 32;
+
+    Mutex mutex = Mutex(Mutex::Type::Recursive);
+    std::shared_ptr<ScreenBuffer> buffer;
+    lv_display_t* _Nullable display = nullptr;
+    lv_indev_t* _Nullable pointer = nullptr;
+    lv_indev_t* _Nullable keypad = nullptr;
+    std::deque<PointerEvent> pointerEvents;
+    std::deque<KeyEvent> keyEvents;
+    PointerEvent pointerState = { 0, 0, 0, false };
+    KeyEvent keyState = { 0, 0, false };
+
+    static void onFlushStart(lv_event_t* event);
+    static void onResolutionChanged(lv_event_t* event);
+    static void readPointer(lv_indev_t* indev, lv_indev_data_t* data);
+    static void readKeypad(lv_indev_t* indev, lv_indev_data_t* data);
+
+public:
+
+    ~LvglScreenSource() override;
+
+    bool start(std::shared_ptr<ScreenBuffer> buffer) override;
+
+    void stop() override;
+
+    void refresh() override;
+
+    void injectPointer(uint32_t sequence, int16_t x, int16_t y, bool pressed) override;
+
+    void injectKey(uint32_t sequence, uint32_t key, bool pressed) override;
+};
+
+} // namespace tt::service::development
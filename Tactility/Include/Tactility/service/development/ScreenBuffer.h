@@ -0,0 +1,118 @@
+#pragma once
+
+#include <Tactility/EventFlag.h>
+#include <Tactility/Mutex.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tt::service::development {
+
+/**
+ * A copy of the screen in RGB565 that keeps track of the areas that changed.
+ * The display flush path writes to it, while the screen stream takes the changes and encodes them at its own pace.
+ * Changes that happen in the meantime are merged, so a slow client skips frames instead of building a backlog.
+ */
+class ScreenBuffer final {
+
+public:
+
+    struct Area {
+        uint16_t x = 0;
+        uint16_t y = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+
+        uint32_t getSize() const { return static_cast<uint32_t>(width) * height; }
+    };
+
+    /** The formats that can be written: these are stored the same way as the LVGL color formats */
+    enum class PixelFormat {
+        RGB565,
+        /** Blue first */
+        RGB888,
+        /** Blue first */
+        XRGB8888
+    };
+
+    struct Changes {
+        std::vector<Area> areas;
+        /** When the oldest change was written */
+        TickType_t time = 0;
+        /** The last input that the UI consumed before the changes were rendered */
+        uint32_t inputSequence = 0;
+    };
+
+    /** The amount of separate areas that are tracked before they are merged */
+    static constexpr size_t MAX_DIRTY_AREAS = 8;
+
+private:
+
+    Mutex mutex;
+    /** Set when an area changed or when the buffer was resized */
+    EventFlag changeFlag;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    std::unique_ptr<uint16_t[]> pixels;
+    std::vector<Area> dirtyAreas;
+    TickType_t dirtyTime = 0;
+    uint32_t consumedInputSequence = 0;
+    uint32_t renderedInputSequence = 0;
+
+    void addDirtyArea(Area area);
+
+public:
+
+    /**
+     * Resize the buffer. Its pixels are black until they are written.
+     * @return false when the memory couldn't be allocated
+     */
+    bool setSize(uint16_t newWidth, uint16_t newHeight);
+
+    uint16_t getWidth() const;
+
+    uint16_t getHeight() const;
+
+    /**
+     * Copy pixels into the buffer and mark their area as changed.
+     * The area is clipped to the buffer.
+     * @param[in] area the area to write
+     * @param[in] data the first pixel of the area
+     * @param[in] stride the distance between rows in bytes
+     * @param[in] format the pixel format of the data
+     */
+    void write(const Area& area, const uint8_t* data, size_t stride, PixelFormat format);
+
+    /** Mark the entire buffer as changed */
+    void invalidate();
+
+    /** Called when the UI consumed an input: the changes that are written afterwards are its result */
+    void setConsumedInputSequence(uint32_t sequence);
+
+    bool hasChanges() const;
+
+    /**
+     * Wait until an area changed or the buffer was resized.
+     * @param[in] timeout the maximum amount of ticks to wait
+     * @return true when there are changes to take
+     */
+    bool waitForChanges(TickType_t timeout) const;
+
+    /**
+     * Take the areas that changed since the last call.
+     * @param[out] changes
+     * @return false when nothing changed
+     */
+    bool takeChanges(Changes& changes);
+
+    /**
+     * Encode an area as a screen stream rect.
+     * The area is clipped to the buffer: it can be larger when the buffer was resized after the changes were taken.
+     * @param[in] area
+     * @param[out] output the buffer to append the rect to
+     */
+    void encode(const Area& area, std::vector<uint8_t>& output) const;
+};
+
+} // namespace tt::service::development
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Tactility/service/development/ScreenBuffer.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace tt::service::development {
+
+/** Provides the pixels of a screen stream and receives the input of its client */
+class ScreenSource {
+
+public:
+
+    virtual ~ScreenSource() = default;
+
+    /**
+     * Start writing the screen into the buffer: first all of it, then the areas that change.
+     * @param[in] buffer the buffer to write to
+     * @return false when the screen can't be streamed
+     */
+    virtual bool start(std::shared_ptr<ScreenBuffer> buffer) = 0;
+
+    virtual void stop() = 0;
+
+    /** Write the entire screen into the buffer again */
+    virtual void refresh() = 0;
+
+    /**
+     * @param[in] sequence passed on to ScreenBuffer::setConsumedInputSequence() when the UI consumed the input
+     * @param[in] x
+     * @param[in] y
+     * @param[in] pressed
+     */
+    virtual void injectPointer(uint32_t sequence, int16_t x, int16_t y, bool pressed) = 0;
+
+    /**
+     * @param[in] sequence passed on to ScreenBuffer::setConsumedInputSequence() when the UI consumed the input
+     * @param[in] key an LVGL key (LV_KEY_*) or a character
+     * @param[in] pressed
+     */
+    virtual void injectKey(uint32_t sequence, uint32_t key, bool pressed) = 0;
+};
+
+} // namespace tt::service::development
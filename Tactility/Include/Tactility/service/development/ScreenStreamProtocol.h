@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The binary protocol of the screen stream (see Documentation/screen-stream.md)
+ * All integers are little-endian. Every message starts with its MessageType.
+ */
+namespace tt::service::development::screenstream {
+
+constexpr uint8_t PROTOCOL_VERSION = 1;
+constexpr uint16_t DEFAULT_PORT = 6667;
+
+enum class MessageType : uint8_t {
+    // Device to client
+    Hello = 1,
+    Frame = 2,
+    // Client to device
+    Configure = 16,
+    Pointer = 17,
+    Key = 18,
+    Refresh = 19
+};
+
+enum class Encoding : uint8_t {
+    Raw = 0,
+    Rle = 1
+};
+
+/** The pixel format of the stream */
+enum class PixelFormat : uint8_t {
+    RGB565 = 0
+};
+
+/** type, version, width, height, pixel format, max frames per second, max bytes per second */
+constexpr size_t HELLO_SIZE = 1 + 1 + 2 + 2 + 1 + 2 + 4;
+/** type, sequence, time, input sequence, rect count */
+constexpr size_t FRAME_HEADER_SIZE = 1 + 4 + 4 + 4 + 2;
+/** x, y, width, height, encoding, CRC-32, payload size */
+constexpr size_t RECT_HEADER_SIZE = 2 + 2 + 2 + 2 + 1 + 4 + 4;
+/** type, max frames per second, max bytes per second */
+constexpr size_t CONFIGURE_SIZE = 1 + 2 + 4;
+/** type, sequence, x, y, pressed */
+constexpr size_t POINTER_SIZE = 1 + 4 + 2 + 2 + 1;
+/** type, sequence, key, pressed */
+constexpr size_t KEY_SIZE = 1 + 4 + 4 + 1;
+/** type */
+constexpr size_t REFRESH_SIZE = 1;
+
+/** @return the size of a message from the client, or 0 when the type is unknown */
+size_t getClientMessageSize(uint8_t type);
+
+void appendUint16(std::vector<uint8_t>& output, uint16_t value);
+void appendUint32(std::vector<uint8_t>& output, uint32_t value);
+uint16_t readUint16(const uint8_t* data);
+uint32_t readUint32(const uint8_t* data);
+
+/**
+ * Run-length encode RGB565 pixels.
+ * The output is a series of packets that start with a control byte:
+ *  - 0x00 to 0x7F: 1 to 128 literal pixels follow
+ *  - 0x80 to 0xFF: the pixel that follows is repeated 2 to 129 times
+ * @param[out] output the buffer to append the packets to
+ * @param[in] pixels the first pixel of the area
+ * @param[in] width the area width in pixels
+ * @param[in] height the area height in pixels
+ * @param[in] stride the distance between rows in pixels
+ */
+void appendRle(std::vector<uint8_t>& output, const uint16_t* pixels, uint16_t width, uint16_t height, size_t stride);
+
+/**
+ * Append a rect record: its header and its pixels, run-length encoded when that makes them smaller.
+ * The CRC-32 covers the pixels as they are after decoding, so a client can verify them.
+ * @param[out] output the buffer to append the rect to
+ * @param[in] x the left of the area
+ * @param[in] y the top of the area
+ * @param[in] pixels the first pixel of the area
+ * @param[in] width the area width in pixels
+ * @param[in] height the area height in pixels
+ * @param[in] stride the distance between rows in pixels
+ */
+void appendRect(std::vector<uint8_t>& output, uint16_t x, uint16_t y, const uint16_t* pixels, uint16_t width, uint16_t height, size_t stride);
+
+} // namespace tt::service::development::screenstream
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Tactility/Mutex.h>
+#include <Tactility/Thread.h>
+#include <Tactility/service/development/ScreenSource.h>
+#include <Tactility/service/development/ScreenStreamProtocol.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace tt::service::development {
+
+/**
+ * Streams a screen to a TCP client and injects the client's input (see Documentation/screen-stream.md)
+ * Only the areas that changed are sent. Frames are paced by a frame rate and a bandwidth limit:
+ * changes that happen in the meantime are merged into the next frame.
+ * It serves one client at a time, on a thread of its own.
+ */
+class ScreenStreamServer final {
+
+public:
+
+    struct Configuration {
+        std::string address = "0.0.0.0";
+        /** Use 0 to pick a free port */
+        uint16_t port = screenstream::DEFAULT_PORT;
+        /** The client can lower this */
+        uint16_t maxFramesPerSecond = 15;
+        /** The client can lower this */
+        uint32_t maxBytesPerSecond = 512 * 1024;
+        /** Areas are sent in bands of at most this amount of pixels, which limits the memory that encoding uses */
+        uint32_t maxBandPixels = 8192;
+    };
+
+private:
+
+    const Configuration configuration;
+    const std::shared_ptr<ScreenSource> source;
+    Mutex mutex = Mutex(Mutex::Type::Recursive);
+    std::unique_ptr<Thread> thread;
+    std::atomic<bool> interrupted = false;
+    int serverSocket = -1;
+    uint16_t port = 0;
+
+    struct Session;
+
+    int32_t threadMain();
+    void serve(int clientSocket);
+    bool sendAll(int socket, const uint8_t* data, size_t size) const;
+    bool sendHello(Session& session);
+    bool sendFrame(Session& session);
+    bool receive(Session& session);
+    void handleMessage(Session& session, const uint8_t* message);
+
+public:
+
+    ScreenStreamServer(std::shared_ptr<ScreenSource> source, Configuration configuration);
+
+    ~ScreenStreamServer();
+
+    ScreenStreamServer(const ScreenStreamServer&) = delete;
+    ScreenStreamServer& operator=(const ScreenStreamServer&) = delete;
+
+    /** @return false when the server socket couldn't be created */
+    bool start();
+
+    void stop();
+
+    bool isStarted() const;
+
+    /** @return the port that the server listens on, or 0 when it's not started */
+    uint16_t getPort() const;
+};
+
+} // namespace tt::service::development
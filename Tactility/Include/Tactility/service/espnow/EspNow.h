@@ -1,24 +1,40 @@
 #pragma once
-#ifdef ESP_PLATFORM
 
 #include <cstdint>
 #include <cstring>
-#include <esp_now.h>
 #include <functional>
+#include <span>
+#include <vector>
+
+#ifdef ESP_PLATFORM
+#include <esp_now.h>
+#endif
 
 namespace tt::service::espnow {
 
 typedef int ReceiverSubscription;
 constexpr ReceiverSubscription NO_SUBSCRIPTION = -1;
 
+/** The length of a MAC address */
+constexpr size_t ADDRESS_LENGTH = 6;
+/** The length of the primary master key */
+constexpr size_t KEY_LENGTH = 16;
+/** The maximum payload of a frame: larger frames are dropped */
+constexpr size_t MAX_DATA_LENGTH = 250;
+
+#ifdef ESP_PLATFORM
+static_assert(ADDRESS_LENGTH == ESP_NOW_ETH_ALEN);
+static_assert(KEY_LENGTH == ESP_NOW_KEY_LEN);
+#endif
+
 enum class Mode {
     Station,
     AccessPoint
 };
 
 struct EspNowConfig {
-    uint8_t masterKey[ESP_NOW_KEY_LEN];
-    uint8_t address[ESP_NOW_ETH_ALEN];
+    uint8_t masterKey[KEY_LENGTH];
+    uint8_t address[ADDRESS_LENGTH];
     Mode mode;
     uint8_t channel;
     bool longRange;
@@ -35,20 +51,87 @@ struct EspNowConfig {
     }
 };
 
+/** A received frame, as it was copied out of the driver's receive callback */
+struct ReceivedFrame {
+    uint8_t sourceAddress[ADDRESS_LENGTH];
+    uint8_t destinationAddress[ADDRESS_LENGTH];
+    int8_t rssi;
+    uint16_t length;
+    /** The time of arrival in milliseconds (see kernel::getMillis()) */
+    uint32_t timestamp;
+    uint8_t data[MAX_DATA_LENGTH];
+};
+
+struct Statistics {
+    /** Frames that were passed to the subscribers */
+    uint32_t receivedFrames;
+    /** Frames that were dropped because the receive queue was full */
+    uint32_t receiveDroppedFrames;
+    /** Frames that were dropped because they were larger than MAX_DATA_LENGTH */
+    uint32_t receiveOversizedFrames;
+    /** The amount of batches that were passed to the subscribers */
+    uint32_t receiveBatches;
+    /** The highest amount of frames that were waiting in the receive queue */
+    uint32_t receiveQueueHighWaterMark;
+    /** Frames that were transmitted successfully */
+    uint32_t sentFrames;
+    /** Frames that failed to transmit */
+    uint32_t sendFailedFrames;
+    /** Frames that were rejected because the send queue was full */
+    uint32_t sendDroppedFrames;
+};
+
+struct PeerStatistics {
+    uint8_t address[ADDRESS_LENGTH];
+    uint32_t frames;
+    uint64_t bytes;
+    /** The receive rate over the last full second */
+    uint32_t framesPerSecond;
+    /** The receive rate over the last full second */
+    uint32_t bytesPerSecond;
+    /** The signal strength of the last frame */
+    int8_t rssi;
+};
+
+/**
+ * Called from the ESP-NOW task with the frames that were received since the previous call.
+ * A burst of frames is passed on in several batches.
+ * @warning don't block for long: the receive queue fills up while the subscribers run
+ */
+typedef std::function<void(std::span<const ReceivedFrame> frames)> ReceiveFunction;
+
+/** Called from the ESP-NOW task when a frame was transmitted or when transmitting failed */
+typedef std::function<void(bool success)> SendCompleteFunction;
+
 void enable(const EspNowConfig& config);
 
 void disable();
 
 bool isEnabled();
 
+#ifdef ESP_PLATFORM
 bool addPeer(const esp_now_peer_info_t& peer);
+#endif
 
-bool send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength);
+/**
+ * Queue a frame for sending. Frames are transmitted in order, one at a time.
+ * @param[in] address the address of the peer
+ * @param[in] buffer the data, which is copied
+ * @param[in] bufferLength the data length, up to MAX_DATA_LENGTH
+ * @param[in] onComplete optional callback for the result
+ * @return false when ESP-NOW is disabled, the data is too large or the send queue is full
+ */
+bool send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength, SendCompleteFunction onComplete = nullptr);
 
-ReceiverSubscription subscribeReceiver(std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive);
+/** After unsubscribing, the receiver is never called again */
+ReceiverSubscription subscribeReceiver(ReceiveFunction onReceive);
 
 void unsubscribeReceiver(ReceiverSubscription subscription);
 
-}
+/** @return the statistics since ESP-NOW was enabled */
+Statistics getStatistics();
 
-#endif // ESP_PLATFORM
\ No newline at end of file
+/** @return the statistics of the most recently seen peers */
+std::vector<PeerStatistics> getPeerStatistics();
+
+}
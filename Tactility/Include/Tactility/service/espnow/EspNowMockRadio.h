@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Tactility/service/espnow/EspNowRadio.h"
+
+#include <Tactility/Mutex.h>
+
+#include <atomic>
+
+namespace tt::service::espnow {
+
+/**
+ * A radio without hardware, for the simulator and for measuring the throughput of EspNowTransport.
+ * Sent frames are transmitted successfully right away. With loopback enabled, they are also received
+ * again as if a peer echoed them back.
+ */
+class EspNowMockRadio final : public EspNowRadio {
+
+    Mutex mutex;
+    ReceiveFunction onReceive;
+    SendCompleteFunction onSendComplete;
+    const bool loopback;
+    bool started = false;
+    std::atomic<uint32_t> sentFrames = 0;
+
+public:
+
+    /** The address of the mock radio (locally administered) */
+    static constexpr uint8_t address[ADDRESS_LENGTH] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+    explicit EspNowMockRadio(bool loopback = false) : loopback(loopback) {}
+
+    bool start(const EspNowConfig& config, ReceiveFunction onReceive, SendCompleteFunction onSendComplete) override;
+
+    void stop() override;
+
+    bool send(const uint8_t* address, const uint8_t* data, size_t length) override;
+
+    /** Simulate a frame that arrived from another device */
+    void receive(const uint8_t* sourceAddress, int8_t rssi, const uint8_t* data, size_t length);
+
+    uint32_t getSentFrames() const { return sentFrames; }
+};
+
+}
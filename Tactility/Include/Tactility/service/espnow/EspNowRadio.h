@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Tactility/service/espnow/EspNow.h"
+
+#include <functional>
+#include <memory>
+
+namespace tt::service::espnow {
+
+/**
+ * The link between EspNowTransport and the hardware.
+ * The callbacks are called from the driver's task, so they must return quickly.
+ */
+class EspNowRadio {
+
+public:
+
+    /** Called for every received frame */
+    typedef std::function<void(const uint8_t* sourceAddress, const uint8_t* destinationAddress, int8_t rssi, const uint8_t* data, size_t length)> ReceiveFunction;
+
+    /** Called when the frame of the last successful send() call was transmitted (or when that failed) */
+    typedef std::function<void(bool success)> SendCompleteFunction;
+
+    virtual ~EspNowRadio() = default;
+
+    virtual bool start(const EspNowConfig& config, ReceiveFunction onReceive, SendCompleteFunction onSendComplete) = 0;
+
+    virtual void stop() = 0;
+
+    /**
+     * Start transmitting a frame.
+     * @return false when the frame wasn't accepted: the SendCompleteFunction isn't called in that case
+     */
+    virtual bool send(const uint8_t* address, const uint8_t* data, size_t length) = 0;
+};
+
+/** @return the ESP-NOW driver on ESP32 or a loopback EspNowMockRadio on the simulator */
+std::unique_ptr<EspNowRadio> createRadio();
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Tactility/service/espnow/EspNow.h"
+#include "Tactility/service/espnow/EspNowRadio.h"
+
+#include <Tactility/EventFlag.h>
+#include <Tactility/MpscQueue.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/Thread.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+namespace tt::service::espnow {
+
+/**
+ * Decouples the ESP-NOW driver from the code that handles the frames.
+ *
+ * The driver's receive callback only copies a frame into a preallocated slot of the receive queue.
+ * A worker task passes the frames on in batches, so a burst of traffic doesn't stall the Wi-Fi task.
+ * When the queue is full, frames are dropped and counted.
+ *
+ * Frames are sent by the same worker, one at a time: the next frame is sent when the driver
+ * reported the result of the previous one.
+ */
+class EspNowTransport final {
+
+public:
+
+    static constexpr size_t defaultReceiveQueueSize = 32;
+    static constexpr size_t defaultSendQueueSize = 16;
+    /** The maximum amount of frames that is passed to the ReceiveFunction at once */
+    static constexpr size_t maxBatchSize = 8;
+    /** The amount of peers that statistics are kept for */
+    static constexpr size_t maxPeers = 8;
+
+private:
+
+    struct SendItem {
+        uint8_t address[ADDRESS_LENGTH];
+        uint16_t length;
+        uint8_t data[MAX_DATA_LENGTH];
+        SendCompleteFunction onComplete;
+    };
+
+    struct PeerEntry {
+        PeerStatistics statistics;
+        uint32_t lastSeen;
+        uint32_t windowStart;
+        uint32_t windowFrames;
+        uint32_t windowBytes;
+    };
+
+    enum Flag {
+        FlagReceive = 1U << 0U,
+        FlagSend = 1U << 1U,
+        FlagSendComplete = 1U << 2U,
+        FlagStop = 1U << 3U
+    };
+
+    std::unique_ptr<EspNowRadio> radio;
+    ReceiveFunction onReceive;
+    MpscQueue<ReceivedFrame> receiveQueue;
+    MpscQueue<SendItem> sendQueue;
+    std::unique_ptr<ReceivedFrame[]> batch;
+    EventFlag eventFlag;
+    Mutex mutex;
+    std::unique_ptr<Thread> thread;
+    std::atomic<bool> started = false;
+    std::atomic<bool> sendSuccess = false;
+
+    Mutex peerMutex;
+    std::array<PeerEntry, maxPeers> peers;
+    size_t peerCount = 0;
+
+    std::atomic<uint32_t> receivedFrames = 0;
+    std::atomic<uint32_t> receiveDroppedFrames = 0;
+    std::atomic<uint32_t> receiveOversizedFrames = 0;
+    std::atomic<uint32_t> receiveBatches = 0;
+    std::atomic<uint32_t> sentFrames = 0;
+    std::atomic<uint32_t> sendFailedFrames = 0;
+    std::atomic<uint32_t> sendDroppedFrames = 0;
+
+    /** Called by the radio from the driver task */
+    void onRadioReceive(const uint8_t* sourceAddress, const uint8_t* destinationAddress, int8_t rssi, const uint8_t* data, size_t length);
+
+    /** Called by the radio from the driver task */
+    void onRadioSendComplete(bool success);
+
+    int32_t threadMain();
+
+    void deliverReceived();
+
+    void updatePeerStatistics(std::span<const ReceivedFrame> frames);
+
+    void completeSend(SendItem& item, bool success);
+
+public:
+
+    /**
+     * @param[in] radio the driver
+     * @param[in] onReceive called from the worker task with batches of received frames
+     * @param[in] receiveQueueSize the amount of frames that can wait to be passed on
+     * @param[in] sendQueueSize the amount of frames that can wait to be sent
+     */
+    EspNowTransport(
+        std::unique_ptr<EspNowRadio> radio,
+        ReceiveFunction onReceive,
+        size_t receiveQueueSize = defaultReceiveQueueSize,
+        size_t sendQueueSize = defaultSendQueueSize
+    );
+
+    ~EspNowTransport();
+
+    EspNowTransport(const EspNowTransport&) = delete;
+    EspNowTransport& operator=(const EspNowTransport&) = delete;
+
+    /** Start the radio and the worker task */
+    bool start(const EspNowConfig& config);
+
+    /**
+     * Stop the worker task and the radio. Frames that weren't sent yet fail.
+     * @warning don't call this from a ReceiveFunction or SendCompleteFunction
+     */
+    void stop();
+
+    bool isStarted() const;
+
+    /**
+     * Queue a frame for sending.
+     * @param[in] onComplete optional: called from the worker task
+     * @return false when the transport isn't started, the data is too large or the send queue is full
+     */
+    bool send(const uint8_t* address, const uint8_t* data, size_t length, SendCompleteFunction onComplete = nullptr);
+
+    Statistics getStatistics() const;
+
+    std::vector<PeerStatistics> getPeerStatistics() const;
+};
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Tactility/DispatcherThread.h"
 #include "Tactility/Mutex.h"
 #include "Tactility/PubSub.h"
 #include "Tactility/hal/gps/GpsDevice.h"
@@ -13,15 +14,24 @@ class GpsService final : public Service {
 
     struct GpsDeviceRecord {
         std::shared_ptr<hal::gps::GpsDevice> device = nullptr;
-        hal::gps::GpsDevice::GgaSubscriptionId satelliteSubscriptionId = -1;
-        hal::gps::GpsDevice::RmcSubscriptionId rmcSubscriptionId = -1;
+        PubSub<hal::gps::GgaFrame>::SubscriptionHandle ggaSubscription = nullptr;
+        PubSub<hal::gps::RmcFrame>::SubscriptionHandle rmcSubscription = nullptr;
+        PubSub<hal::gps::GsvFrame>::SubscriptionHandle gsvSubscription = nullptr;
     };
 
+    /** Decoded frames are queued here by the GPS threads, so handling them never stalls UART reading */
+    static constexpr size_t FRAME_QUEUE_CAPACITY = 16;
+
+    /** Guards rmcRecord and rmcTime. Separate from the main mutex, because that is held while unsubscribing. */
+    Mutex rmcMutex = Mutex(Mutex::Type::Recursive);
     minmea_sentence_rmc rmcRecord;
     TickType_t rmcTime = 0;
 
+    hal::gps::SatelliteStorage satellites;
+
     Mutex mutex = Mutex(Mutex::Type::Recursive);
     Mutex stateMutex;
+    DispatcherThread frameDispatcher = DispatcherThread("gps_service", 4096, FRAME_QUEUE_CAPACITY, Dispatcher::OverflowPolicy::Reject);
     std::vector<GpsDeviceRecord> deviceRecords;
     std::shared_ptr<PubSub<State>> statePubSub = std::make_shared<PubSub<State>>();
     std::unique_ptr<ServicePaths> paths;
@@ -32,8 +42,8 @@ class GpsService final : public Service {
 
     GpsDeviceRecord* _Nullable findGpsRecord(const std::shared_ptr<hal::gps::GpsDevice>& record);
 
-    void onGgaSentence(hal::Device::Id deviceId, const minmea_sentence_gga& gga);
-    void onRmcSentence(hal::Device::Id deviceId, const minmea_sentence_rmc& rmc);
+    void onGgaFrame(const hal::gps::GgaFrame& frame);
+    void onRmcFrame(const hal::gps::RmcFrame& frame);
 
     void setState(State newState);
 
@@ -58,6 +68,13 @@ public:
     bool hasCoordinates() const;
     bool getCoordinates(minmea_sentence_rmc& rmc) const;
 
+    /**
+     * Copy the satellites that are currently in view of any GPS device.
+     * @param[out] output the storage for the satellites (hal::gps::SatelliteStorage::recordCount is always enough)
+     * @return the amount of satellites that were written to the output
+     */
+    size_t getSatellites(std::span<hal::gps::Satellite> output) const { return satellites.getSnapshot(output); }
+
     /** @return GPS service pubsub that broadcasts State* objects */
     std::shared_ptr<PubSub<State>> getStatePubsub() const { return statePubSub; }
 };
@@ -32,8 +32,10 @@ private:
 
     /** The dispatcher thread needs a callstack large enough to accommodate all the dispatched methods.
      * This includes full LVGL redraw via Gui::redraw()
+     * The queue is bounded: app transitions are posted from many threads and normally don't allocate queue storage.
+     * Apps start and stop other apps from within transitions, which run on this thread, so it spills instead of dropping transitions when it is full.
      */
-    std::unique_ptr<DispatcherThread> dispatcherThread = std::make_unique<DispatcherThread>("loader_dispatcher", 6144); // Files app requires ~5k
+    std::unique_ptr<DispatcherThread> dispatcherThread = std::make_unique<DispatcherThread>("loader_dispatcher", 6144, 16, Dispatcher::OverflowPolicy::Spill); // Files app requires ~5k
 
     void onStartAppMessage(const std::string& id, app::LaunchId launchId, std::shared_ptr<const Bundle> parameters);
 
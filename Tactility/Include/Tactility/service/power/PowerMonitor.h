@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Tactility/hal/power/PowerDevice.h>
+#include <Tactility/PubSub.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace tt::service::power {
+
+/** The filtered metrics of a power device at one moment. Metrics that aren't supported or available are empty. */
+struct PowerSnapshot {
+    std::shared_ptr<hal::power::PowerDevice> device;
+    std::optional<bool> isCharging;
+    std::optional<int32_t> current; // mA
+    std::optional<uint32_t> batteryVoltage; // mV
+    std::optional<uint8_t> chargeLevel; // [0, 100]
+    /** The tick count at the time of sampling */
+    TickType_t sampleTime = 0;
+};
+
+/**
+ * Estimate the state of charge of a single Li-ion/LiPo cell from its voltage, using a typical discharge curve.
+ * This is more accurate than a linear estimate, because the voltage is almost flat between 30% and 80%.
+ * @param[in] milliVolt the (filtered) battery voltage
+ * @return a value in the range [0, 100]
+ */
+uint8_t getChargeLevelFromVoltage(uint32_t milliVolt);
+
+/**
+ * Removes spikes with a median over the last samples, and then smooths the result with an exponential moving average.
+ */
+class VoltageFilter final {
+
+    static constexpr size_t WINDOW_SIZE = 5;
+
+    std::array<uint32_t, WINDOW_SIZE> window = {};
+    size_t windowCount = 0;
+    size_t windowIndex = 0;
+    float average = 0.f;
+    float alpha;
+
+public:
+
+    /** @param[in] alpha the weight of a new sample in the moving average: (0, 1] */
+    explicit VoltageFilter(float alpha = 0.3f) : alpha(alpha) {}
+
+    /** @return the filtered value, including the new sample */
+    uint32_t add(uint32_t sample);
+
+    /** Forget the history, e.g. when the voltage jumps because a charger was connected */
+    void reset() { windowCount = 0; windowIndex = 0; }
+
+    bool isEmpty() const { return windowCount == 0; }
+};
+
+/**
+ * Samples all power devices on their own schedule and keeps a filtered snapshot of each of them.
+ * Readers get the snapshots without locking and without accessing hardware.
+ * Subscribers are only notified when the primary device changes significantly:
+ * when the charge level crosses a threshold, or when the charging state or availability changes.
+ *
+ * update() should be called from a single thread. All other functions are thread-safe.
+ */
+class PowerMonitor final {
+
+public:
+
+    struct Configuration {
+        uint32_t sampleIntervalMillis = 2000;
+        /** Devices that estimate charge from voltage typically use blocking ADC bursts, so they are sampled less often */
+        uint32_t estimatedSampleIntervalMillis = 5000;
+        /** Subscribers are notified when the charge level crosses any of these values */
+        std::vector<uint8_t> chargeLevelThresholds = { 5, 15, 25, 35, 45, 55, 65, 75, 85, 95 };
+        /** The charge level must pass a threshold by this much, so noise around a threshold doesn't cause notifications */
+        uint8_t chargeLevelHysteresis = 1;
+    };
+
+private:
+
+    struct DeviceRecord {
+        std::shared_ptr<hal::power::PowerDevice> device;
+        TickType_t interval = 0;
+        TickType_t nextSampleTime = 0;
+        bool supportsIsCharging = false;
+        bool supportsCurrent = false;
+        bool supportsBatteryVoltage = false;
+        bool supportsChargeLevel = false;
+        bool isChargeLevelEstimated = false;
+        VoltageFilter voltageFilter;
+        PowerSnapshot snapshot;
+    };
+
+    typedef std::vector<PowerSnapshot> Snapshots;
+
+    const Configuration configuration;
+    std::vector<DeviceRecord> records;
+    uint32_t deviceGeneration = UINT32_MAX;
+    std::atomic<bool> isSampleRequested = false;
+
+    std::atomic<std::shared_ptr<const Snapshots>> snapshots = std::make_shared<const Snapshots>();
+    std::shared_ptr<PubSub<PowerSnapshot>> pubsub = std::make_shared<PubSub<PowerSnapshot>>();
+
+    /** The state of the last notification */
+    bool hasNotified = false;
+    std::shared_ptr<hal::power::PowerDevice> notifiedDevice;
+    std::optional<bool> notifiedIsCharging;
+    std::optional<size_t> notifiedChargeBand;
+
+    void updateDevices(TickType_t now);
+    void sample(DeviceRecord& record, TickType_t now);
+    size_t getChargeBand(int32_t chargeLevel) const;
+    bool shouldNotify(const PowerSnapshot& primary) const;
+    void publish(TickType_t now);
+
+public:
+
+    explicit PowerMonitor(Configuration configuration) : configuration(std::move(configuration)) {}
+    PowerMonitor() : PowerMonitor(Configuration()) {}
+
+    /**
+     * Samples the devices that are due and publishes the results.
+     * @param[in] now the current tick count
+     * @return the amount of ticks until the next device is due
+     */
+    TickType_t update(TickType_t now);
+
+    /** Makes all devices due on the next update(), e.g. after charging was enabled or disabled */
+    void requestSample() { isSampleRequested = true; }
+
+    /**
+     * @return the snapshot of the primary device: the first one that reports a charge level, or otherwise the first one.
+     * Returns nullptr when there are no power devices or when they weren't sampled yet.
+     */
+    std::shared_ptr<const PowerSnapshot> getSnapshot() const;
+
+    /** @return the snapshots of all power devices, with the primary device first */
+    std::shared_ptr<const std::vector<PowerSnapshot>> getSnapshots() const { return snapshots.load(); }
+
+    /** @return the pubsub that publishes the snapshot of the primary device on significant changes */
+    std::shared_ptr<PubSub<PowerSnapshot>> getPubsub() const { return pubsub; }
+};
+
+} // namespace tt::service::power
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "PowerMonitor.h"
+
+#include <Tactility/EventFlag.h>
+#include <Tactility/hal/Device.h>
+#include <Tactility/service/Service.h>
+#include <Tactility/Thread.h>
+
+namespace tt::service::power {
+
+/**
+ * Samples the power devices on a background thread, so that UI code never has to access power hardware.
+ * @see PowerMonitor
+ */
+class PowerService final : public Service {
+
+    PowerMonitor monitor;
+    EventFlag threadFlags;
+    std::unique_ptr<Thread> thread;
+    PubSub<hal::DeviceEvent>::SubscriptionHandle deviceSubscription = nullptr;
+
+    int32_t threadMain();
+
+public:
+
+    bool onStart(ServiceContext& serviceContext) override;
+    void onStop(ServiceContext& serviceContext) override;
+
+    /** @copydoc PowerMonitor::getSnapshot() */
+    std::shared_ptr<const PowerSnapshot> getSnapshot() const { return monitor.getSnapshot(); }
+
+    /** @copydoc PowerMonitor::getSnapshots() */
+    std::shared_ptr<const std::vector<PowerSnapshot>> getSnapshots() const { return monitor.getSnapshots(); }
+
+    /** @copydoc PowerMonitor::getPubsub() */
+    std::shared_ptr<PubSub<PowerSnapshot>> getPubsub() const { return monitor.getPubsub(); }
+
+    /** Sample all devices as soon as possible, e.g. after charging was enabled or disabled */
+    void requestSample();
+};
+
+std::shared_ptr<PowerService> findPowerService();
+
+} // namespace tt::service::power
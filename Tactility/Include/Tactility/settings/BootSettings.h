@@ -12,9 +12,9 @@ struct BootSettings {
 };
 
 /**
- * Load the boot properties file from the relevant file location(s).
- * It will first attempt to load them from the SD card and if no file was found,
- * then it will try to load the one from the data mount point.
+ * Load the boot settings.
+ * It will first attempt to load them from a properties file on the SD card and if no file was found,
+ * then it will load them from the settings store.
  *
  * @param[out] properties the resulting properties
  * @return true when the properties were successfully loaded and the result was set
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <Tactility/Mutex.h>
+#include <Tactility/PubSub.h>
+#include <Tactility/Timer.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace tt::settings {
+
+/**
+ * A key-value store for settings, with an in-memory cache and a crash-safe journal file.
+ *
+ * Keys are grouped in namespaces (e.g. "display" or "wifi.ap.MyNetwork"). Reads are served from memory.
+ * Changes are applied to the cache right away and are written to the journal after a short delay,
+ * so that a burst of changes (e.g. dragging a slider) results in a single write.
+ * The changes of one flush are written as a batch that ends with a commit entry: a batch that was
+ * interrupted (e.g. by a power loss) is ignored when the journal is loaded.
+ * Every entry has a CRC, so corrupt data is never loaded.
+ * The journal is compacted when it is mostly made up of values that were replaced.
+ */
+class SettingsStore final {
+
+public:
+
+    typedef std::variant<bool, int32_t, std::string> Value;
+
+    /** Published when a value was changed or removed: the key is empty when the whole namespace was removed */
+    struct Change {
+        std::string namespaceName;
+        std::string key;
+    };
+
+private:
+
+    typedef std::map<std::string, Value> Namespace;
+
+    /** An uncommitted change: no value means that the key was removed */
+    typedef std::map<std::pair<std::string, std::string>, std::optional<Value>> PendingChanges;
+
+    const std::string filePath;
+    const uint32_t flushDelayMillis;
+
+    /** Guards the cache and the pending changes */
+    Mutex mutex;
+    /** Guards the journal file: it is held during writes, so that readers of the cache aren't blocked by file IO */
+    Mutex fileMutex;
+
+    bool isLoaded = false;
+    bool isLoadSuccessful = false;
+    std::map<std::string, Namespace> namespaces;
+    std::set<std::string> pendingNamespaceRemovals;
+    PendingChanges pendingChanges;
+
+    /** The end of the last commit: new batches are written here (0 when the journal doesn't exist) */
+    uint32_t writeOffset = 0;
+    /** Set when the journal has data after the last commit that must be removed before appending */
+    bool hasUncommittedData = false;
+    uint32_t compactionCount = 0;
+
+    /** Shared with the flushes that the timer dispatched, so they are skipped when the store was destroyed */
+    struct FlushGuard {
+        /** Held while a dispatched flush runs */
+        Mutex mutex;
+        bool isAlive = true;
+    };
+
+    std::shared_ptr<PubSub<Change>> pubsub = std::make_shared<PubSub<Change>>();
+    std::unique_ptr<Timer> flushTimer;
+    std::shared_ptr<FlushGuard> flushGuard = std::make_shared<FlushGuard>();
+
+    /** Must be called while holding the mutex */
+    void ensureLoaded();
+    bool load();
+    bool writeBatch(const std::vector<uint8_t>& batch);
+    bool compact();
+    bool change(const std::string& namespaceName, const std::string& key, std::optional<Value> value);
+    void scheduleFlush();
+
+public:
+
+    static constexpr uint32_t defaultFlushDelayMillis = 1000;
+
+    /**
+     * @param[in] filePath the journal file
+     * @param[in] flushDelayMillis the time between the first change and writing it (0 means that changes are only written by flush())
+     * Delayed writes happen on the main dispatcher (see getMainDispatcher())
+     */
+    explicit SettingsStore(std::string filePath, uint32_t flushDelayMillis = defaultFlushDelayMillis);
+
+    SettingsStore(const SettingsStore&) = delete;
+    SettingsStore& operator=(const SettingsStore&) = delete;
+
+    /** Writes the pending changes */
+    ~SettingsStore();
+
+    /**
+     * Load the journal. This is done automatically on first use: calling it is only needed to check for errors.
+     * @return true when the journal was loaded or when it doesn't exist yet
+     */
+    bool open();
+
+    std::optional<Value> get(const std::string& namespaceName, const std::string& key);
+
+    bool getBool(const std::string& namespaceName, const std::string& key, bool defaultValue);
+    int32_t getInt(const std::string& namespaceName, const std::string& key, int32_t defaultValue);
+    std::string getString(const std::string& namespaceName, const std::string& key, const std::string& defaultValue = "");
+
+    bool contains(const std::string& namespaceName, const std::string& key);
+
+    /** @return true when the namespace has at least one key */
+    bool containsNamespace(const std::string& namespaceName);
+
+    /** @return the names of all namespaces that start with the prefix */
+    std::vector<std::string> getNamespaces(const std::string& prefix = "");
+
+    /** The maximum length of a namespace name or a key */
+    static constexpr size_t maxNameLength = UINT8_MAX;
+
+    /** @return false when the namespace name or the key is longer than maxNameLength */
+    bool set(const std::string& namespaceName, const std::string& key, Value value);
+    /** Prevents string literals from being stored as a bool */
+    bool set(const std::string& namespaceName, const std::string& key, const char* value) { return set(namespaceName, key, Value(std::string(value))); }
+    bool setBool(const std::string& namespaceName, const std::string& key, bool value) { return set(namespaceName, key, Value(value)); }
+    bool setInt(const std::string& namespaceName, const std::string& key, int32_t value) { return set(namespaceName, key, Value(value)); }
+    bool setString(const std::string& namespaceName, const std::string& key, const std::string& value) { return set(namespaceName, key, Value(value)); }
+
+    /** @return false when the namespace name or the key is longer than maxNameLength */
+    bool remove(const std::string& namespaceName, const std::string& key);
+    void removeNamespace(const std::string& namespaceName);
+
+    /**
+     * Import the key-values of a properties file as strings into a namespace, unless the file was imported before.
+     * Existing keys are overwritten. The file isn't changed.
+     * @return true when the file was imported and the import was written to the journal
+     */
+    bool importPropertiesFile(const std::string& propertiesFilePath, const std::string& namespaceName);
+
+    /**
+     * Write the pending changes to the journal and wait until they are stored.
+     * @return true when there were no changes or when the changes were written
+     */
+    bool flush();
+
+    /** @return the size of the journal file in bytes */
+    uint32_t getJournalSize();
+
+    /** @return the amount of times the journal was compacted since it was opened */
+    uint32_t getCompactionCount() const { return compactionCount; }
+
+    std::shared_ptr<PubSub<Change>> getPubsub() const { return pubsub; }
+};
+
+/** @return the store for the system settings (in the data partition) */
+SettingsStore& getSettingsStore();
+
+}
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <Tactility/DispatcherThread.h>
 #include <Tactility/Mutex.h>
+#include <Tactility/file/DirectoryListing.h>
 
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
 #include <string>
-#include <vector>
-#include <dirent.h>
 
 namespace tt::app::files {
 
@@ -18,38 +22,60 @@ public:
         ActionRename
     };
 
+    /** Called from the loader task when the entries of the current path were loaded */
+    typedef std::function<void()> EntriesChangedFunction;
+
 private:
 
+    /** Listings of recently visited paths are kept, so navigating back doesn't read them again */
+    static constexpr size_t maxCachedListings = 8;
+    /** The cache can exceed this for a single (large) listing */
+    static constexpr size_t maxCacheMemory = 32 * 1024;
+
     Mutex mutex = Mutex(Mutex::Type::Recursive);
-    std::vector<dirent> dir_entries;
+    /** Protects onEntriesChanged */
+    Mutex callbackMutex;
+    std::shared_ptr<const file::DirectoryListing> listing;
+    /** The most recently used listing first */
+    std::list<std::shared_ptr<const file::DirectoryListing>> cache;
     std::string current_path;
     std::string selected_child_entry;
     PendingAction action = ActionNone;
+    EntriesChangedFunction onEntriesChanged;
+    /** Reads directories, so a large directory doesn't block the UI */
+    DispatcherThread loaderThread = DispatcherThread("files_loader", 4096);
+    /** Changes with every navigation, so a load for a previous path is cancelled */
+    std::atomic<uint32_t> loadGeneration = 0;
 
-public:
+    void load(const std::string& path, uint32_t generation);
 
+    void addToCache(const std::shared_ptr<const file::DirectoryListing>& newListing);
+
+public:
 
     State();
 
-    void freeEntries() {
-        dir_entries.clear();
-    }
+    ~State();
 
-    ~State() {
-        freeEntries();
-    }
+    /**
+     * @param[in] function called when the entries were loaded, or nullptr
+     * @warning a call that is already running isn't waited for: the function must handle being called after it was removed
+     */
+    void setOnEntriesChanged(EntriesChangedFunction function);
 
     bool setEntriesForChildPath(const std::string& child_path);
+
+    /** Navigate to a path: its entries are loaded in the background, unless they are cached */
     bool setEntriesForPath(const std::string& path);
 
-    template <std::invocable<const std::vector<dirent> &> Func>
-    void withEntries(Func&& onEntries) const {
-        mutex.withLock([&] {
-            std::invoke(std::forward<Func>(onEntries), dir_entries);
-        });
-    }
+    /** Forget the cached entries of a path and its subdirectories: call this after changing them */
+    void invalidate(const std::string& path);
+
+    /** Load the entries of the current path again */
+    void refresh();
 
-    bool getDirent(uint32_t index, dirent& dirent);
+    /** @return the entries of the current path, or nullptr while they are being loaded */
+    std::shared_ptr<const file::DirectoryListing> getListing() const;
 
     void setSelectedChildEntry(const std::string& newFile) {
         selected_child_entry = newFile;
@@ -15,6 +15,11 @@ class View final {
     lv_obj_t* dir_entry_list = nullptr;
     lv_obj_t* action_list = nullptr;
     lv_obj_t* navigate_up_button = nullptr;
+    lv_obj_t* loading_spinner = nullptr;
+    /** The listing that is shown: only accessed with the LVGL lock */
+    std::shared_ptr<const file::DirectoryListing> listing;
+    /** Cleared by deinit(): the loader thread can still call the entries changed callback afterwards (only accessed with the LVGL lock) */
+    std::shared_ptr<bool> shown;
 
     std::string installAppPath = { 0 };
     LaunchId installAppLaunchId = 0;
@@ -23,19 +28,21 @@ class View final {
     void showActionsForFile();
 
     void viewFile(const std::string&path, const std::string&filename);
-    void createDirEntryWidget(lv_obj_t* parent, dirent& dir_entry);
+    void onBindDirEntry(lv_obj_t* row, size_t index);
     void onNavigate();
+    void updateLocked();
 
 public:
 
     explicit View(const std::shared_ptr<State>& state) : state(state) {}
 
     void init(const AppContext& appContext, lv_obj_t* parent);
+    void deinit();
     void update();
 
     void onNavigateUpPressed();
-    void onDirEntryPressed(uint32_t index);
-    void onDirEntryLongPressed(int32_t index);
+    void onDirEntryPressed(size_t index);
+    void onDirEntryLongPressed(size_t index);
     void onRenamePressed();
     void onDeletePressed();
     void onDirEntryListScrollBegin();
@@ -1,19 +1,105 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
 namespace tt::file {
 
 constexpr uint32_t OBJECT_FILE_IDENTIFIER = 0x13371337;
-constexpr uint32_t OBJECT_FILE_VERSION = 1;
+/** Version 1: a ContentHeader followed by the records */
+constexpr uint32_t OBJECT_FILE_VERSION_1 = 1;
+/** Version 2: a ContentHeaderV2 followed by blocks and trailers (see ObjectFile.h) */
+constexpr uint32_t OBJECT_FILE_VERSION = 2;
+
+constexpr uint32_t OBJECT_FILE_BLOCK_IDENTIFIER = 0x4B4C4254; // "TBLK"
+constexpr uint32_t OBJECT_FILE_TRAILER_IDENTIFIER = 0x544D4354; // "TCMT"
+
+/** The tombstones of a block are a bitmask, so this is the maximum amount of records per block */
+constexpr uint32_t OBJECT_FILE_MAX_RECORDS_PER_BLOCK = 64;
 
 struct FileHeader {
     uint32_t identifier = OBJECT_FILE_IDENTIFIER;
     uint32_t version = OBJECT_FILE_VERSION;
 };
 
+/** Version 1 */
 struct ContentHeader {
     uint32_t recordVersion = 0;
     uint32_t recordSize = 0;
     uint32_t recordCount = 0;
 };
 
+struct ContentHeaderV2 {
+    uint32_t recordVersion = 0;
+    uint32_t recordSize = 0;
+    uint32_t recordsPerBlock = 0;
+    /** CRC of the fields above */
+    uint32_t crc = 0;
+};
+
+/** Followed by recordCount records */
+struct BlockHeader {
+    uint32_t identifier = OBJECT_FILE_BLOCK_IDENTIFIER;
+    /** The sequence of the commit that the block belongs to */
+    uint32_t sequence = 0;
+    /** The logical block index: a newer block with the same index replaces the older one */
+    uint32_t blockIndex = 0;
+    /** CRC of this header (with crc set to 0) and the records */
+    uint32_t crc = 0;
+    /** A bit is set for every deleted record */
+    uint64_t tombstones = 0;
+    uint32_t recordCount = 0;
+    uint32_t reserved = 0;
+};
+
+/** Written after the blocks of a commit: blocks without a valid trailer after them are ignored */
+struct Trailer {
+    uint32_t identifier = OBJECT_FILE_TRAILER_IDENTIFIER;
+    /** Starts at 1 and increases by 1 with every commit */
+    uint32_t sequence = 0;
+    uint32_t recordCount = 0;
+    uint32_t deletedRecordCount = 0;
+    uint32_t blockCount = 0;
+    /** CRC of the fields above */
+    uint32_t crc = 0;
+};
+
+constexpr uint32_t OBJECT_FILE_DATA_OFFSET = sizeof(FileHeader) + sizeof(ContentHeaderV2);
+
+/** The committed state of a version 2 file */
+struct ObjectFileIndex {
+    /** The file offset of every logical block */
+    std::vector<uint32_t> blockOffsets;
+    uint32_t recordCount = 0;
+    uint32_t deletedRecordCount = 0;
+    /** The sequence of the last commit */
+    uint32_t sequence = 0;
+    /** The end of the last commit: the next commit is written here */
+    uint32_t endOffset = OBJECT_FILE_DATA_OFFSET;
+};
+
+/** Read size bytes at offset: returns false when the file is too short */
+typedef std::function<bool(uint32_t offset, void* output, size_t size)> ObjectFileReadFunction;
+
+uint32_t getContentHeaderCrc(const ContentHeaderV2& header);
+
+uint32_t getBlockCrc(const BlockHeader& header, const void* records, size_t recordsSize);
+
+uint32_t getTrailerCrc(const Trailer& trailer);
+
+/**
+ * Scan the blocks and trailers of a version 2 file.
+ * Scanning stops at the first item that is invalid: that is where an interrupted commit was written.
+ * The CRCs of the records are not checked (readers check them when a block is first accessed).
+ */
+void readObjectFileIndex(const ObjectFileReadFunction& read, const ContentHeaderV2& header, ObjectFileIndex& index);
+
+/**
+ * Finish or roll back a compaction that was interrupted, based on the ".tmp" file that it left behind.
+ * Called by readers and writers before they open the file.
+ */
+void recoverObjectFile(const std::string& filePath);
+
 }
@@ -4,6 +4,8 @@
 #include <Tactility/service/Service.h>
 
 #include <Tactility/Mutex.h>
+#include <Tactility/service/development/LvglScreenSource.h>
+#include <Tactility/service/development/ScreenStreamServer.h>
 
 #include <esp_event.h>
 #include <esp_http_server.h>
@@ -45,6 +47,11 @@ class DevelopmentService final : public Service {
             }
         }
     );
+    /** Streams the display and injects input, on a port of its own: the HTTP server handles one request at a time */
+    ScreenStreamServer screenStreamServer = ScreenStreamServer(
+        std::make_shared<LvglScreenSource>(),
+        ScreenStreamServer::Configuration()
+    );
 
     void startServer();
     void stopServer();
@@ -1,9 +1,8 @@
 #pragma once
-#ifdef ESP_PLATFORM
 
-#include "Tactility/MessageQueue.h"
 #include "Tactility/service/Service.h"
 #include "Tactility/service/espnow/EspNow.h"
+#include "Tactility/service/espnow/EspNowTransport.h"
 
 #include <Tactility/Mutex.h>
 
@@ -17,26 +16,24 @@ private:
 
     struct ReceiverSubscriptionData {
         ReceiverSubscription id;
-        std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive;
-    };
-
-    struct SendCallback {
-        uint8_t macAddress[ESP_NOW_ETH_ALEN];
-        bool success;
+        ReceiveFunction onReceive;
     };
 
     Mutex mutex = Mutex(Mutex::Type::Recursive);
+    /** Only exists while enabled, so the queues don't take memory otherwise */
+    std::unique_ptr<EspNowTransport> transport;
+    /** Separate from the main mutex, so disabling doesn't wait for the subscribers */
+    Mutex subscriptionMutex = Mutex(Mutex::Type::Recursive);
     std::vector<ReceiverSubscriptionData> subscriptions;
     ReceiverSubscription lastSubscriptionId = 0;
-    bool enabled = false;
 
     // Dispatcher calls this and forwards to non-static function
     void enableFromDispatcher(const EspNowConfig& config);
 
     void disableFromDispatcher();
 
-    static void receiveCallback(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length);
-    void onReceive(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length);
+    /** Called by the transport from its worker task */
+    void onReceive(std::span<const ReceivedFrame> frames);
 
 public:
 
@@ -55,19 +52,23 @@ public:
 
     bool isEnabled() const;
 
+#ifdef ESP_PLATFORM
     bool addPeer(const esp_now_peer_info_t& peer);
+#endif
 
-    bool send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength);
+    bool send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength, SendCompleteFunction onComplete);
 
-    ReceiverSubscription subscribeReceiver(std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive);
+    ReceiverSubscription subscribeReceiver(ReceiveFunction onReceive);
 
     void unsubscribeReceiver(ReceiverSubscription subscription);
 
+    Statistics getStatistics() const;
+
+    std::vector<PeerStatistics> getPeerStatistics() const;
+
     // region Internal API
 };
 
 std::shared_ptr<EspNowService> findService();
 
 }
-
-#endif // ESP_PLATFORM
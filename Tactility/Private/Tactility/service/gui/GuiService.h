@@ -8,6 +8,7 @@
 #include <Tactility/service/loader/Loader.h>
 
 #include <cstdio>
+#include <list>
 #include <lvgl.h>
 
 namespace tt::service::gui {
@@ -19,6 +20,39 @@ constexpr auto GUI_THREAD_FLAG_ALL = (GUI_THREAD_FLAG_DRAW | GUI_THREAD_FLAG_INP
 
 class GuiService final : public Service {
 
+public:
+
+    struct ShowStatistics {
+        /** The amount of app views that were built with App::onShow() */
+        uint32_t buildCount;
+        /** The amount of retained app views that were shown again */
+        uint32_t retainedCount;
+        /** The amount of retained app views that were deleted to stay within the memory budget */
+        uint32_t evictionCount;
+        /** The total time spent on building app views in microseconds */
+        uint64_t buildTimeTotal;
+        /** The total time spent on showing retained app views in microseconds */
+        uint64_t retainedTimeTotal;
+        /** The time it took to show the last app view in microseconds */
+        uint32_t lastShowTime;
+    };
+
+private:
+
+    struct AppView {
+        /** Used to find the app when it's still alive, without keeping it alive */
+        std::weak_ptr<app::AppInstance> app;
+        app::LaunchId launchId;
+        /** Holds the app container and the keyboard */
+        lv_obj_t* root;
+        /** The parent that was passed to App::onShow() */
+        lv_obj_t* container;
+        lv_obj_t* _Nullable keyboard;
+        lv_group_t* group;
+        /** The estimated memory usage of the widgets */
+        size_t memorySize;
+    };
+
     // Thread and lock
     Thread* thread = nullptr;
     Mutex mutex = Mutex(Mutex::Type::Recursive);
@@ -34,6 +68,13 @@ class GuiService final : public Service {
     lv_obj_t* _Nullable keyboard = nullptr;
     lv_group_t* keyboardGroup = nullptr;
 
+    /** The view of the app that is currently shown */
+    std::unique_ptr<AppView> currentView;
+    /** Views of hidden apps that have AppManifest::Flags::RetainView: the most recently hidden one first */
+    std::list<AppView> retainedViews;
+    size_t retainedMemorySize = 0;
+    ShowStatistics showStatistics = { 0, 0, 0, 0, 0, 0 };
+
     bool isStarted = false;
 
     static int32_t guiMain();
@@ -42,6 +83,21 @@ class GuiService final : public Service {
 
     lv_obj_t* createAppViews(lv_obj_t* parent);
 
+    /** Build the view of an app with App::onShow() */
+    std::unique_ptr<AppView> buildAppView(const std::shared_ptr<app::AppInstance>& app);
+
+    /** Show a retained view again, if the app has one */
+    std::unique_ptr<AppView> restoreAppView(const std::shared_ptr<app::AppInstance>& app);
+
+    /** Must be called while holding the LVGL lock */
+    static void deleteAppView(const AppView& view);
+
+    /** Delete the least recently hidden views until they fit in the memory budget */
+    void evictRetainedViews();
+
+    /** Delete the retained views of apps that were stopped */
+    void removeStoppedAppViews();
+
     void redraw();
 
     void lock() const {
@@ -64,6 +120,12 @@ public:
 
     void requestDraw();
 
+    ShowStatistics getShowStatistics() const {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        return showStatistics;
+    }
+
     /**
      * Show the on-screen keyboard.
      * @param[in] textarea the textarea to focus the input for
@@ -1,10 +1,10 @@
 #include "Tactility/MountPoints.h"
 
 #include "Tactility/TactilityConfig.h"
-#include "Tactility/hal/Device.h"
-#include "Tactility/hal/sdcard/SdCardDevice.h"
 
 #include <Tactility/file/File.h>
+#include <Tactility/file/MountTable.h>
+#include <Tactility/Mutex.h>
 
 #include <cstring>
 #include <vector>
@@ -12,9 +12,8 @@
 
 namespace tt::file {
 
-std::vector<dirent> getMountPoints() {
+static std::vector<dirent> createMountPoints() {
     std::vector<dirent> dir_entries;
-    dir_entries.clear();
 
     // Data partition
     auto data_dirent = dirent{
@@ -25,21 +24,17 @@ std::vector<dirent> getMountPoints() {
     strcpy(data_dirent.d_name, DATA_PARTITION_NAME);
     dir_entries.push_back(data_dirent);
 
-    // SD card partitions
-    auto sdcards = tt::hal::findDevices<hal::sdcard::SdCardDevice>(hal::Device::Type::SdCard);
-    for (auto& sdcard : sdcards) {
-        auto state = sdcard->getState();
-        if (state == hal::sdcard::SdCardDevice::State::Mounted) {
-            auto mount_name = sdcard->getMountPath().substr(1);
-            auto dir_entry = dirent {
-                .d_ino = 2,
-                .d_type = TT_DT_DIR,
-                .d_name = { 0 }
-            };
-            assert(mount_name.length() < sizeof(dirent::d_name));
-            strcpy(dir_entry.d_name, mount_name.c_str());
-            dir_entries.push_back(dir_entry);
-        }
+    // Device partitions (e.g. SD cards)
+    for (auto& mount : getMounts()) {
+        auto mount_name = mount.path.substr(1);
+        auto dir_entry = dirent {
+            .d_ino = 2,
+            .d_type = TT_DT_DIR,
+            .d_name = { 0 }
+        };
+        assert(mount_name.length() < sizeof(dirent::d_name));
+        strcpy(dir_entry.d_name, mount_name.c_str());
+        dir_entries.push_back(dir_entry);
     }
 
     if (config::SHOW_SYSTEM_PARTITION) {
@@ -56,4 +51,22 @@ std::vector<dirent> getMountPoints() {
     return dir_entries;
 }
 
+std::vector<dirent> getMountPoints() {
+    static Mutex mutex;
+    static std::vector<dirent> cached_mount_points;
+    static uint32_t cached_generation = UINT32_MAX;
+
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    // Only rebuild the list when something was mounted or unmounted
+    auto generation = getMountGeneration();
+    if (generation != cached_generation) {
+        cached_mount_points = createMountPoints();
+        cached_generation = generation;
+    }
+
+    return cached_mount_points;
+}
+
 }
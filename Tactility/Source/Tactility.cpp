@@ -28,17 +28,22 @@ namespace tt {
 constexpr auto* TAG = "Tactility";
 
 static const Configuration* config_instance = nullptr;
-static Dispatcher mainDispatcher;
+/**
+ * Bounded and lock-free: it is dispatched to from Wi-Fi, GPS and UI threads.
+ * Code that runs on the main task dispatches to it too, so it spills instead of dropping functions when it is full.
+ */
+static Dispatcher mainDispatcher(64, Dispatcher::OverflowPolicy::Spill);
 
 // region Default services
 namespace service {
     // Primary
     namespace gps { extern const ServiceManifest manifest; }
+    namespace power { extern const ServiceManifest manifest; }
     namespace wifi { extern const ServiceManifest manifest; }
     namespace sdcard { extern const ServiceManifest manifest; }
+    namespace espnow { extern const ServiceManifest manifest; }
 #ifdef ESP_PLATFORM
     namespace development { extern const ServiceManifest manifest; }
-    namespace espnow { extern const ServiceManifest manifest; }
 #endif
     // Secondary (UI)
     namespace gui { extern const ServiceManifest manifest; }
@@ -223,13 +228,14 @@ static void registerAndStartSecondaryServices() {
 static void registerAndStartPrimaryServices() {
     TT_LOG_I(TAG, "Registering and starting system services");
     addService(service::gps::manifest);
+    addService(service::power::manifest);
     if (hal::hasDevice(hal::Device::Type::SdCard)) {
         addService(service::sdcard::manifest);
     }
     addService(service::wifi::manifest);
+    addService(service::espnow::manifest);
 #ifdef ESP_PLATFORM
     addService(service::development::manifest);
-    addService(service::espnow::manifest);
 #endif
 }
 
@@ -275,6 +281,9 @@ void registerApps() {
 }
 
 void run(const Configuration& config) {
+    // Format log messages on a low-priority task instead of on the calling task
+    startLogThread();
+
     TT_LOG_I(TAG, "Tactility v%s on %s (%s)", TT_VERSION, CONFIG_TT_BOARD_NAME, CONFIG_TT_BOARD_ID);
 
     assert(config.hardware);
@@ -1,4 +1,5 @@
 #include <Tactility/app/App.h>
+#include <Tactility/app/AppInstaller.h>
 #include <Tactility/app/AppManifestParsing.h>
 #include <Tactility/app/AppManifest.h>
 #include <Tactility/app/AppRegistration.h>
@@ -8,7 +9,10 @@
 #include <Tactility/hal/Device.h>
 #include <Tactility/hal/sdcard/SdCardDevice.h>
 #include <Tactility/Paths.h>
+#include <Tactility/StringUtils.h>
 
+#include <array>
+#include <atomic>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
@@ -19,171 +23,246 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-#include <minitar.h>
-
 constexpr auto* TAG = "App";
 
 namespace tt::app {
 
-static bool untarFile(minitar mp, const minitar_entry* entry, const std::string& destinationPath) {
-    const auto absolute_path = destinationPath + "/" + entry->metadata.path;
-    if (!file::findOrCreateDirectory(destinationPath, 0777)) {
-        TT_LOG_E(TAG, "Can't find or create directory %s", destinationPath.c_str());
+constexpr size_t CHUNK_SIZE = 2048;
+constexpr TickType_t POLL_TICKS = pdMS_TO_TICKS(50);
+
+static std::atomic<uint32_t> installCounter = 0;
+
+void cleanupInstallDirectory(const std::string& path) {
+    if (!file::deleteRecursively(path)) {
+        TT_LOG_W(TAG, "Failed to delete existing installation at %s", path.c_str());
+    }
+}
+
+/** Move the extracted app into place, replacing the existing installation (if any) */
+static bool installFromStagingPath(const std::string& stagingPath) {
+    auto manifest_path = stagingPath + "/manifest.properties";
+    if (!file::isFile(manifest_path)) {
+        TT_LOG_E(TAG, "Manifest not found at %s", manifest_path.c_str());
+        return false;
+    }
+
+    std::map<std::string, std::string> properties;
+    if (!file::loadPropertiesFile(manifest_path, properties)) {
+        TT_LOG_E(TAG, "Failed to load manifest at %s", manifest_path.c_str());
+        return false;
+    }
+
+    AppManifest manifest;
+    if (!parseManifest(properties, manifest)) {
+        TT_LOG_W(TAG, "Invalid manifest");
+        return false;
+    }
+
+    // If the app was already running, then stop it
+    if (isRunning(manifest.appId)) {
+        stopAll(manifest.appId);
+    }
+
+    auto app_parent_path = getAppInstallPath();
+    if (!file::findOrCreateDirectory(app_parent_path, 0777)) {
+        TT_LOG_E(TAG, "Failed to create directory %s", app_parent_path.c_str());
         return false;
     }
 
-    // minitar_read_contents(&mp, &entry, file_buffer, entry.metadata.size);
-    if (minitar_read_contents_to_file(&mp, entry, absolute_path.c_str()) <= 0) {
-        TT_LOG_E(TAG, "Failed to write data to %s", absolute_path.c_str());
+    // Each rename is atomic: the app directory always holds either the old or the new version
+    const std::string target_path = getAppInstallPath(manifest.appId);
+    const std::string backup_path = stagingPath + "_old";
+    auto lock = file::getLock(app_parent_path)->asScopedLock();
+    lock.lock();
+
+    bool has_backup = file::isDirectory(target_path);
+    if (has_backup && rename(target_path.c_str(), backup_path.c_str()) != 0) {
+        TT_LOG_E(TAG, "Failed to move existing installation at %s", target_path.c_str());
         return false;
     }
 
-    // Note: fchmod() doesn't exist on ESP-IDF and chmod() does nothing on that platform
-    if (chmod(absolute_path.c_str(), entry->metadata.mode) < 0) {
+    if (rename(stagingPath.c_str(), target_path.c_str()) != 0) {
+        TT_LOG_E(TAG, "Failed to rename \"%s\" to \"%s\"", stagingPath.c_str(), target_path.c_str());
+        if (has_backup && rename(backup_path.c_str(), target_path.c_str()) != 0) {
+            TT_LOG_E(TAG, "Failed to restore existing installation at %s", target_path.c_str());
+        }
         return false;
     }
 
+    lock.unlock();
+
+    if (has_backup) {
+        cleanupInstallDirectory(backup_path);
+    }
+
+    manifest.appLocation = Location::external(target_path);
+
+    addAppManifest(manifest);
+
     return true;
 }
 
-static bool untarDirectory(const minitar_entry* entry, const std::string& destinationPath) {
-    auto absolute_path = destinationPath + "/" + entry->metadata.path;
-    if (!file::findOrCreateDirectory(absolute_path, 0777)) return false;
-    return true;
+AppInstaller::AppInstaller(size_t bufferSize) :
+    stagingPath(std::format("{}/install_{}", getTempPath(), installCounter++)),
+    // Wake up the worker per storage block instead of per received byte
+    streamBuffer(bufferSize, 512),
+    chunk(std::make_unique<uint8_t[]>(CHUNK_SIZE)),
+    extractor(stagingPath),
+    thread("app_install", 4096, [this] { return extractMain(); })
+{
+    mbedtls_sha256_init(&sha256Context);
 }
 
-static bool untar(const std::string& tarPath, const std::string& destinationPath) {
-    minitar mp;
-    if (minitar_open(tarPath.c_str(), &mp) != 0) {
-        perror(tarPath.c_str());
-        return 1;
-    }
-    bool success = true;
-    minitar_entry entry;
-
-    do {
-        if (minitar_read_entry(&mp, &entry) == 0) {
-            TT_LOG_I(TAG, "Extracting %s", entry.metadata.path);
-            if (entry.metadata.type == MTAR_DIRECTORY) {
-                if (!strcmp(entry.metadata.name, ".") || !strcmp(entry.metadata.name, "..") || !strcmp(entry.metadata.name, "/")) continue;
-                if (!untarDirectory(&entry, destinationPath)) {
-                    TT_LOG_E(TAG, "Failed to create directory %s/%s: %s", destinationPath.c_str(), entry.metadata.name, strerror(errno));
-                    success = false;
-                    break;
-                }
-            } else if (entry.metadata.type == MTAR_REGULAR) {
-                if (!untarFile(mp, &entry, destinationPath)) {
-                    TT_LOG_E(TAG, "Failed to extract file %s: %s", entry.metadata.path, strerror(errno));
-                    success = false;
-                    break;
-                }
-            } else if (entry.metadata.type == MTAR_SYMLINK) {
-                TT_LOG_E(TAG, "SYMLINK not supported");
-            } else if (entry.metadata.type == MTAR_HARDLINK) {
-                TT_LOG_E(TAG, "HARDLINK not supported");
-            } else if (entry.metadata.type == MTAR_FIFO) {
-                TT_LOG_E(TAG, "FIFO not supported");
-            } else if (entry.metadata.type == MTAR_BLKDEV) {
-                TT_LOG_E(TAG, "BLKDEV not supported");
-            } else if (entry.metadata.type == MTAR_CHRDEV) {
-                TT_LOG_E(TAG, "CHRDEV not supported");
-            } else {
-                TT_LOG_E(TAG, "Unknown entry type: %d", entry.metadata.type);
-                success = false;
-                break;
-            }
-        } else break;
-    } while (true);
-    minitar_close(&mp);
-    return success;
+AppInstaller::~AppInstaller() {
+    if (started && !finished) {
+        abort();
+    }
+    mbedtls_sha256_free(&sha256Context);
 }
 
-void cleanupInstallDirectory(const std::string& path) {
-    if (!file::deleteRecursively(path)) {
-        TT_LOG_W(TAG, "Failed to delete existing installation at %s", path.c_str());
+void AppInstaller::cleanup() {
+    if (file::isDirectory(stagingPath)) {
+        cleanupInstallDirectory(stagingPath);
     }
 }
 
-bool install(const std::string& path) {
-    // We lock and unlock frequently because SPI SD card devices share
-    // the lock with the display. We don't want to lock the display for very long.
+int32_t AppInstaller::extractMain() {
+    auto lock = file::getLock(stagingPath);
+    while (!failed) {
+        auto size = streamBuffer.receive(chunk.get(), CHUNK_SIZE, POLL_TICKS);
+        if (size > 0) {
+            mbedtls_sha256_update(&sha256Context, chunk.get(), size);
+            // We lock per chunk because SPI SD card devices share the lock with the display
+            auto scoped_lock = lock->asScopedLock();
+            scoped_lock.lock();
+            if (!extractor.write(chunk.get(), size)) {
+                failed = true;
+            }
+        } else if (inputEnded && streamBuffer.isEmpty()) {
+            return 0;
+        }
+    }
+    return -1;
+}
 
-    auto app_parent_path = getAppInstallPath();
-    TT_LOG_I(TAG, "Installing app %s to %s", path.c_str(), app_parent_path.c_str());
+bool AppInstaller::start() {
+    assert(!started);
+    TT_LOG_I(TAG, "Extracting app to %s", stagingPath.c_str());
+    // Remove leftovers from an installation that was interrupted by a reset
+    cleanup();
+    mbedtls_sha256_starts(&sha256Context, 0);
+    thread.start();
+    started = true;
+    return true;
+}
 
-    auto filename = file::getLastPathSegment(path);
-    const std::string app_target_path = std::format("{}/{}", app_parent_path, filename);
-    if (file::isDirectory(app_target_path) && !file::deleteRecursively(app_target_path)) {
-        TT_LOG_W(TAG, "Failed to delete %s", app_target_path.c_str());
+bool AppInstaller::write(const void* data, size_t size) {
+    assert(started && !finished);
+    auto* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0 && !failed) {
+        auto sent = streamBuffer.send(bytes, size, POLL_TICKS);
+        bytes += sent;
+        size -= sent;
     }
+    return !failed;
+}
 
-    if (!file::findOrCreateDirectory(app_target_path, 0777)) {
-        TT_LOG_I(TAG, "Failed to create directory %s", app_target_path.c_str());
-        return false;
+bool AppInstaller::finish(const std::string& expectedSha256) {
+    assert(started && !finished);
+    inputEnded = true;
+    thread.join();
+    finished = true;
+
+    std::array<uint8_t, 32> hash;
+    mbedtls_sha256_finish(&sha256Context, hash.data());
+    sha256.clear();
+    for (auto value : hash) {
+        sha256 += std::format("{:02x}", value);
     }
 
-    auto target_path_lock = file::getLock(app_parent_path)->asScopedLock();
-    auto source_path_lock = file::getLock(path)->asScopedLock();
-    target_path_lock.lock();
-    source_path_lock.lock();
-    TT_LOG_I(TAG, "Extracting app from %s to %s", path.c_str(), app_target_path.c_str());
-    if (!untar(path, app_target_path)) {
+    auto lock = file::getLock(stagingPath)->asScopedLock();
+    lock.lock();
+    bool extracted = !failed && extractor.finish();
+    lock.unlock();
+    if (!extracted) {
         TT_LOG_E(TAG, "Failed to extract");
+        cleanup();
         return false;
     }
-    source_path_lock.unlock();
-    target_path_lock.unlock();
 
-    auto manifest_path = app_target_path + "/manifest.properties";
-    if (!file::isFile(manifest_path)) {
-        TT_LOG_E(TAG, "Manifest not found at %s", manifest_path.c_str());
-        cleanupInstallDirectory(app_target_path);
+    const auto& statistics = extractor.getStatistics();
+    TT_LOG_I(TAG, "Extracted %lu files (%llu bytes) with %lu directory lookups, SHA-256 %s",
+        (unsigned long)statistics.fileCount,
+        (unsigned long long)statistics.bytesWritten,
+        (unsigned long)statistics.directoryLookupCount,
+        sha256.c_str()
+    );
+
+    if (!expectedSha256.empty() && string::lowercase(expectedSha256) != sha256) {
+        TT_LOG_E(TAG, "SHA-256 mismatch: expected %s", expectedSha256.c_str());
+        cleanup();
         return false;
     }
 
-    std::map<std::string, std::string> properties;
-    if (!file::loadPropertiesFile(manifest_path, properties)) {
-        TT_LOG_E(TAG, "Failed to load manifest at %s", manifest_path.c_str());
-        cleanupInstallDirectory(app_target_path);
+    if (!installFromStagingPath(stagingPath)) {
+        cleanup();
         return false;
     }
 
-    AppManifest manifest;
-    if (!parseManifest(properties, manifest)) {
-        TT_LOG_W(TAG, "Invalid manifest");
-        cleanupInstallDirectory(app_target_path);
+    return true;
+}
+
+void AppInstaller::abort() {
+    assert(started && !finished);
+    failed = true;
+    thread.join();
+    finished = true;
+    cleanup();
+}
+
+bool install(const std::string& path) {
+    TT_LOG_I(TAG, "Installing app %s", path.c_str());
+
+    auto source_lock = file::getLock(path)->asScopedLock();
+    source_lock.lock();
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(path.c_str(), "rb"));
+    source_lock.unlock();
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "Failed to open %s", path.c_str());
         return false;
     }
 
-    // If the app was already running, then stop it
-    if (isRunning(manifest.appId)) {
-        stopAll(manifest.appId);
+    AppInstaller installer;
+    if (!installer.start()) {
+        return false;
     }
 
-    const std::string renamed_target_path = std::format("{}/{}", app_parent_path, manifest.appId);
-    if (file::isDirectory(renamed_target_path)) {
-        if (!file::deleteRecursively(renamed_target_path)) {
-            TT_LOG_W(TAG, "Failed to delete existing installation at %s", renamed_target_path.c_str());
-            cleanupInstallDirectory(app_target_path);
+    auto buffer = std::make_unique<uint8_t[]>(CHUNK_SIZE);
+    while (true) {
+        // Don't hold the lock while writing: the installer needs it to extract the data
+        source_lock.lock();
+        auto bytes_read = fread(buffer.get(), 1, CHUNK_SIZE, file.get());
+        source_lock.unlock();
+        if (bytes_read == 0) {
+            break;
+        }
+        if (!installer.write(buffer.get(), bytes_read)) {
+            installer.abort();
             return false;
         }
     }
 
-    target_path_lock.lock();
-    bool rename_success = rename(app_target_path.c_str(), renamed_target_path.c_str()) == 0;
-    target_path_lock.unlock();
-
-    if (!rename_success) {
-        TT_LOG_E(TAG, "Failed to rename \"%s\" to \"%s\"", app_target_path.c_str(), manifest.appId.c_str());
-        cleanupInstallDirectory(app_target_path);
+    source_lock.lock();
+    bool read_error = ferror(file.get()) != 0;
+    file = nullptr;
+    source_lock.unlock();
+    if (read_error) {
+        TT_LOG_E(TAG, "Failed to read %s", path.c_str());
+        installer.abort();
         return false;
     }
 
-    manifest.appLocation = Location::external(renamed_target_path);
-
-    addAppManifest(manifest);
-
-    return true;
+    return installer.finish();
 }
 
 bool uninstall(const std::string& appId) {
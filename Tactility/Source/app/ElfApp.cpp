@@ -9,7 +9,9 @@
 #include <Tactility/StringUtils.h>
 
 #include <esp_elf.h>
+#include <esp_heap_caps.h>
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -25,11 +27,58 @@ static std::string getErrorCodeString(int error_code) {
             return "missing symbol";
         case EINVAL:
             return "invalid argument or main() missing";
+        case EIO:
+            return "failed to read file";
         default:
             return std::format("code {}", error_code);
     }
 }
 
+/**
+ * Measures the heap usage of a load with the allocator statistics, so allocator overhead and fragmentation are included.
+ * Allocations by other tasks during the load are included too.
+ */
+class HeapUsageMeasurement final {
+
+    struct Region {
+        const char* name;
+        uint32_t caps;
+        size_t freeBefore;
+    };
+
+    Region regions[2] = {
+        { "internal", MALLOC_CAP_INTERNAL, 0 },
+        { "PSRAM", MALLOC_CAP_SPIRAM, 0 }
+    };
+
+public:
+
+    void start() {
+        // Resets the minimum free size, so it only covers this measurement
+        heap_caps_monitor_local_minimum_free_size_start();
+        for (auto& region : regions) {
+            region.freeBefore = heap_caps_get_free_size(region.caps);
+        }
+    }
+
+    void stop(const char* label) {
+        for (const auto& region : regions) {
+            if (region.freeBefore == 0) {
+                continue; // Region not available
+            }
+            const auto free_after = heap_caps_get_free_size(region.caps);
+            const auto minimum_free = heap_caps_get_minimum_free_size(region.caps);
+            TT_LOG_I(TAG, "%s loader %s heap: peak usage %zu bytes, retained %zu bytes",
+                label,
+                region.name,
+                region.freeBefore - std::min(minimum_free, region.freeBefore),
+                region.freeBefore - std::min(free_after, region.freeBefore)
+            );
+        }
+        heap_caps_monitor_local_minimum_free_size_stop();
+    }
+};
+
 class ElfApp final : public App {
 
 public:
@@ -56,12 +105,12 @@ private:
     static std::shared_ptr<Lock> staticParametersLock;
 
     const std::string appPath;
-    std::unique_ptr<uint8_t[]> elfFileData;
     esp_elf_t elf {
         .psegment = nullptr,
         .svaddr = 0,
         .ptext = nullptr,
         .pdata = nullptr,
+        .prodata = nullptr,
         .sec = { },
         .entry = nullptr
     };
@@ -70,36 +119,109 @@ private:
     void* data = nullptr;
     std::string lastError = "";
 
-    bool startElf() {
-        const std::string elf_path = std::format("{}/elf/{}.elf", appPath, CONFIG_IDF_TARGET);
-        TT_LOG_I(TAG, "Starting ELF %s", elf_path.c_str());
-        assert(elfFileData == nullptr);
+    struct ElfFile {
+        FILE* file;
+        std::shared_ptr<Lock> lock;
+    };
+
+    /**
+     * Reads parts of the ELF file on demand, so the loader never needs the whole file in memory.
+     * The file lock is only held while reading, so the storage isn't blocked while the loader relocates.
+     */
+    static int readElfFile(void* context, uint32_t offset, void* buffer, uint32_t size) {
+        auto* elf_file = static_cast<ElfFile*>(context);
+        auto lock = elf_file->lock->asScopedLock();
+        lock.lock();
+        if (fseek(elf_file->file, static_cast<long>(offset), SEEK_SET) != 0) {
+            return -EIO;
+        }
+        return (fread(buffer, 1, size, elf_file->file) == size) ? 0 : -EIO;
+    }
 
+#ifdef CONFIG_TT_ELF_MEASURE_LEGACY_LOAD
+    /** Load the file the way it was done before streaming: read it into memory as a whole and then relocate it */
+    static void measureLegacyLoad(const std::string& elfPath) {
+        esp_elf_t legacy_elf {};
+        if (esp_elf_init(&legacy_elf) != ESP_OK) {
+            return;
+        }
+
+        HeapUsageMeasurement measurement;
+        measurement.start();
         size_t size = 0;
-        file::getLock(elf_path)->withLock([this, &elf_path, &size]{
-            elfFileData = file::readBinary(elf_path, size);
+        std::unique_ptr<uint8_t[]> file_data;
+        file::getLock(elfPath)->withLock([&elfPath, &size, &file_data] {
+            file_data = file::readBinary(elfPath, size);
         });
-
-        if (elfFileData == nullptr) {
-            return false;
+        const int relocate_result = (file_data != nullptr) ? esp_elf_relocate(&legacy_elf, file_data.get()) : -EIO;
+        // The legacy loader kept the file data for as long as the app was running
+        measurement.stop("Legacy");
+        if (relocate_result != 0) {
+            TT_LOG_W(TAG, "Legacy loader failed: %s", getErrorCodeString(-relocate_result).c_str());
         }
 
+        file_data = nullptr;
+        esp_elf_deinit(&legacy_elf);
+    }
+#endif
+
+    bool startElf() {
+        const std::string elf_path = std::format("{}/elf/{}.elf", appPath, CONFIG_IDF_TARGET);
+        TT_LOG_I(TAG, "Starting ELF %s", elf_path.c_str());
+
+#ifdef CONFIG_TT_ELF_MEASURE_LEGACY_LOAD
+        // Done first and cleaned up completely, so it doesn't affect the measurement below
+        measureLegacyLoad(elf_path);
+#endif
+
         if (esp_elf_init(&elf) != ESP_OK) {
             lastError = "Failed to initialize";
             TT_LOG_E(TAG, "%s", lastError.c_str());
-            elfFileData  = nullptr;
             return false;
         }
 
-        auto relocate_result = esp_elf_relocate(&elf, elfFileData.get());
+        HeapUsageMeasurement measurement;
+        measurement.start();
+
+        ElfFile elf_file = {
+            .file = nullptr,
+            .lock = file::getLock(elf_path)
+        };
+        long file_size = 0;
+        elf_file.lock->withLock([&elf_file, &elf_path, &file_size] {
+            elf_file.file = fopen(elf_path.c_str(), "rb");
+            if (elf_file.file != nullptr && fseek(elf_file.file, 0, SEEK_END) == 0) {
+                file_size = ftell(elf_file.file);
+            }
+        });
+
+        if (elf_file.file == nullptr) {
+            measurement.stop("Streaming");
+            lastError = "Failed to open file";
+            TT_LOG_E(TAG, "Failed to open %s", elf_path.c_str());
+            return false;
+        }
+
+        const esp_elf_reader_t reader = {
+            .context = &elf_file,
+            .read = readElfFile
+        };
+        uint32_t estimated_peak_memory = 0;
+        const int relocate_result = esp_elf_relocate_stream(&elf, &reader, &estimated_peak_memory);
+        elf_file.lock->withLock([&elf_file] {
+            fclose(elf_file.file);
+        });
+        measurement.stop("Streaming");
+
         if (relocate_result != 0) {
             // Note: the result code maps to values from cstdlib's errno.h
             lastError = getErrorCodeString(-relocate_result);
             TT_LOG_E(TAG, "Application failed to load: %s", lastError.c_str());
-            elfFileData  = nullptr;
             return false;
         }
 
+        TT_LOG_I(TAG, "Estimated peak memory while loading was %lu bytes for a file of %ld bytes", (unsigned long)estimated_peak_memory, file_size);
+
         int argc = 0;
         char* argv[] = {};
 
@@ -107,7 +229,6 @@ private:
             lastError = "Executable returned error code";
             TT_LOG_E(TAG, "%s", lastError.c_str());
             esp_elf_deinit(&elf);
-            elfFileData  = nullptr;
             return false;
         }
 
@@ -121,10 +242,6 @@ private:
         if (shouldCleanupElf) {
             esp_elf_deinit(&elf);
         }
-
-        if (elfFileData != nullptr) {
-            elfFileData = nullptr;
-        }
     }
 
 public:
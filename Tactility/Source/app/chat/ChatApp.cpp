@@ -49,18 +49,19 @@ class ChatApp : public App {
         }
     }
 
-    void onReceive(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length) {
-        // Append \0 to make it a string
-        auto buffer = static_cast<char*>(malloc(length + 1));
-        memcpy(buffer, data, length);
-        buffer[length] = 0x00;
-        const std::string message_prefixed = std::string("Received: ") + buffer;
-
-        lvgl::getSyncLock()->lock();
-        addMessage(message_prefixed.c_str());
-        lvgl::getSyncLock()->unlock();
-
-        free(buffer);
+    void onReceive(std::span<const service::espnow::ReceivedFrame> frames) {
+        // Add the whole batch with a single lock, and don't stall the ESP-NOW task when the UI is busy
+        if (!lvgl::lock(100 / portTICK_PERIOD_MS)) {
+            TT_LOG_W(TAG, "Dropped %zu messages", frames.size());
+            return;
+        }
+
+        for (const auto& frame : frames) {
+            const auto message_prefixed = std::string("Received: ") + std::string(reinterpret_cast<const char*>(frame.data), frame.length);
+            addMessage(message_prefixed.c_str());
+        }
+
+        lvgl::unlock();
     }
 
 public:
@@ -78,8 +79,8 @@ public:
 
         service::espnow::enable(config);
 
-        receiveSubscription = service::espnow::subscribeReceiver([this](const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length) {
-            onReceive(receiveInfo, data, length);
+        receiveSubscription = service::espnow::subscribeReceiver([this](std::span<const service::espnow::ReceivedFrame> frames) {
+            onReceive(frames);
         });
     }
 
@@ -27,6 +27,10 @@ public:
         view->init(appContext, parent);
     }
 
+    void onHide(TT_UNUSED AppContext& appContext) override {
+        view->deinit();
+    }
+
     void onResult(AppContext& appContext, TT_UNUSED LaunchId launchId, Result result, std::unique_ptr<Bundle> bundle) override {
         view->onResult(launchId, result, std::move(bundle));
     }
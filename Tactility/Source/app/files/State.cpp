@@ -7,16 +7,17 @@
 #include <Tactility/MountPoints.h>
 #include <Tactility/kernel/Kernel.h>
 
+#include <algorithm>
 #include <cstring>
 #include <unistd.h>
-#include <vector>
-#include <dirent.h>
 
 namespace tt::app::files {
 
 constexpr auto* TAG = "Files";
 
 State::State() {
+    loaderThread.start();
+
     if (kernel::getPlatform() == kernel::PlatformSimulator) {
         char cwd[PATH_MAX];
         if (getcwd(cwd, sizeof(cwd)) != nullptr) {
@@ -30,10 +31,22 @@ State::State() {
     }
 }
 
+State::~State() {
+    // Cancel the running load
+    loadGeneration++;
+    loaderThread.stop();
+}
+
 std::string State::getSelectedChildPath() const {
     return file::getChildPath(current_path, selected_child_entry);
 }
 
+void State::setOnEntriesChanged(EntriesChangedFunction function) {
+    auto lock = callbackMutex.asScopedLock();
+    lock.lock();
+    onEntriesChanged = std::move(function);
+}
+
 bool State::setEntriesForPath(const std::string& path) {
     auto lock = mutex.asScopedLock();
     if (!lock.lock(100)) {
@@ -43,6 +56,11 @@ bool State::setEntriesForPath(const std::string& path) {
 
     TT_LOG_I(TAG, "Changing path: %s -> %s", current_path.c_str(), path.c_str());
 
+    current_path = path;
+    selected_child_entry = "";
+    action = ActionNone;
+    auto generation = ++loadGeneration;
+
     /**
      * On PC, the root entry point ("/") is a folder.
      * On ESP32, the root entry point contains the various mount points.
@@ -50,44 +68,116 @@ bool State::setEntriesForPath(const std::string& path) {
     bool get_mount_points = (kernel::getPlatform() == kernel::PlatformEsp) && (path == "/");
     if (get_mount_points) {
         TT_LOG_I(TAG, "Setting custom root");
-        dir_entries = file::getMountPoints();
-        current_path = path;
-        selected_child_entry = "";
-        action = ActionNone;
+        auto mount_points = std::make_shared<file::DirectoryListing>(path);
+        for (const auto& entry : file::getMountPoints()) {
+            mount_points->add(entry.d_name, entry.d_type);
+        }
+        listing = std::move(mount_points);
+        return true;
+    }
+
+    auto cached = std::ranges::find_if(cache, [&path](const auto& item) {
+        return item->getPath() == path;
+    });
+    if (cached != cache.end()) {
+        TT_LOG_I(TAG, "%s has %zu entries (cached)", path.c_str(), (*cached)->getCount());
+        listing = *cached;
+        cache.splice(cache.begin(), cache, cached);
         return true;
+    }
+
+    listing = nullptr;
+    return loaderThread.dispatch([this, path, generation] {
+        load(path, generation);
+    });
+}
+
+void State::load(const std::string& path, uint32_t generation) {
+    auto is_current = [this, generation] {
+        return loadGeneration == generation;
+    };
+
+    if (!is_current()) {
+        return;
+    }
+
+    auto start_time = kernel::getMillis();
+    std::shared_ptr<const file::DirectoryListing> new_listing = file::DirectoryListing::read(path, [&is_current](size_t) {
+        return is_current();
+    });
+
+    if (new_listing != nullptr) {
+        TT_LOG_I(TAG, "%s has %zu entries (%zu bytes, %zu ms)", path.c_str(), new_listing->getCount(), new_listing->getMemoryUsage(), kernel::getMillis() - start_time);
+    } else if (is_current()) {
+        TT_LOG_E(TAG, "Failed to fetch entries for %s", path.c_str());
+        // Show an empty directory, so the view doesn't keep waiting
+        new_listing = std::make_shared<file::DirectoryListing>(path);
     } else {
-        dir_entries.clear();
-        int count = file::scandir(path, dir_entries, &file::direntFilterDotEntries, file::direntSortAlphaAndType);
-        if (count >= 0) {
-            TT_LOG_I(TAG, "%s has %u entries", path.c_str(), count);
-            current_path = path;
-            selected_child_entry = "";
-            action = ActionNone;
-            return true;
-        } else {
-            TT_LOG_E(TAG, "Failed to fetch entries for %s", path.c_str());
-            return false;
-        }
+        return;
+    }
+
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    if (!is_current()) {
+        return;
+    }
+    listing = new_listing;
+    if (!new_listing->isEmpty()) {
+        addToCache(new_listing);
+    }
+    lock.unlock();
+
+    // Called without holding callbackMutex: the callback takes the LVGL lock, while setOnEntriesChanged() is called with the LVGL lock held
+    auto callback_lock = callbackMutex.asScopedLock();
+    callback_lock.lock();
+    auto on_entries_changed = onEntriesChanged;
+    callback_lock.unlock();
+
+    if (on_entries_changed != nullptr) {
+        on_entries_changed();
+    }
+}
+
+void State::addToCache(const std::shared_ptr<const file::DirectoryListing>& newListing) {
+    cache.push_front(newListing);
+
+    size_t memory_usage = 0;
+    for (const auto& item : cache) {
+        memory_usage += item->getMemoryUsage();
+    }
+
+    while (cache.size() > 1 && (cache.size() > maxCachedListings || memory_usage > maxCacheMemory)) {
+        memory_usage -= cache.back()->getMemoryUsage();
+        cache.pop_back();
     }
 }
 
+void State::invalidate(const std::string& path) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    auto child_prefix = file::getChildPath(path, "");
+    std::erase_if(cache, [&path, &child_prefix](const auto& item) {
+        return item->getPath() == path || item->getPath().starts_with(child_prefix);
+    });
+}
+
+void State::refresh() {
+    auto path = getCurrentPath();
+    invalidate(path);
+    setEntriesForPath(path);
+}
+
 bool State::setEntriesForChildPath(const std::string& childPath) {
     auto path = file::getChildPath(current_path, childPath);
     TT_LOG_I(TAG, "Navigating from %s to %s", current_path.c_str(), path.c_str());
     return setEntriesForPath(path);
 }
 
-bool State::getDirent(uint32_t index, dirent& dirent) {
+std::shared_ptr<const file::DirectoryListing> State::getListing() const {
     auto lock = mutex.asScopedLock();
-    if (!lock.lock(50 / portTICK_PERIOD_MS)) {
-        return false;
-    }
-
-    if (index < dir_entries.size()) {
-        dirent = dir_entries[index];
-        return true;
-    } else {
-        return false;
-    }
+    lock.lock();
+    return listing;
 }
+
 }
@@ -8,6 +8,7 @@
 #include <Tactility/app/ElfApp.h>
 #include <Tactility/lvgl/Toolbar.h>
 #include <Tactility/lvgl/LvglSync.h>
+#include <Tactility/lvgl/VirtualList.h>
 
 #include <Tactility/Tactility.h>
 #include <Tactility/file/File.h>
@@ -33,20 +34,6 @@ static void dirEntryListScrollBeginCallback(lv_event_t* event) {
     view->onDirEntryListScrollBegin();
 }
 
-static void onDirEntryPressedCallback(lv_event_t* event) {
-    auto* view = static_cast<View*>(lv_event_get_user_data(event));
-    auto* button = lv_event_get_target_obj(event);
-    auto index = lv_obj_get_index(button);
-    view->onDirEntryPressed(index);
-}
-
-static void onDirEntryLongPressedCallback(lv_event_t* event) {
-    auto* view = static_cast<View*>(lv_event_get_user_data(event));
-    auto* button = lv_event_get_target_obj(event);
-    auto index = lv_obj_get_index(button);
-    view->onDirEntryLongPressed(index);
-}
-
 static void onRenamePressedCallback(lv_event_t* event) {
     auto* view = static_cast<View*>(lv_event_get_user_data(event));
     view->onRenamePressed();
@@ -111,77 +98,80 @@ void View::viewFile(const std::string& path, const std::string& filename) {
     onNavigate();
 }
 
-void View::onDirEntryPressed(uint32_t index) {
-    dirent dir_entry;
-    if (state->getDirent(index, dir_entry)) {
-        TT_LOG_I(TAG, "Pressed %s %d", dir_entry.d_name, dir_entry.d_type);
-        state->setSelectedChildEntry(dir_entry.d_name);
-        using namespace tt::file;
-        switch (dir_entry.d_type) {
-            case TT_DT_DIR:
-            case TT_DT_CHR:
-                state->setEntriesForChildPath(dir_entry.d_name);
-                onNavigate();
-                update();
-                break;
-            case TT_DT_LNK:
-                TT_LOG_W(TAG, "opening links is not supported");
-                break;
-            case TT_DT_REG:
-                viewFile(state->getCurrentPath(), dir_entry.d_name);
-                onNavigate();
-                break;
-            default:
-                // Assume it's a file
-                // TODO: Find a better way to identify a file
-                viewFile(state->getCurrentPath(), dir_entry.d_name);
-                onNavigate();
-                break;
-        }
+void View::onDirEntryPressed(size_t index) {
+    if (listing == nullptr || index >= listing->getCount()) {
+        return;
+    }
+
+    std::string name = listing->getName(index);
+    auto type = listing->getType(index);
+    TT_LOG_I(TAG, "Pressed %s %d", name.c_str(), type);
+    state->setSelectedChildEntry(name);
+    using namespace tt::file;
+    switch (type) {
+        case TT_DT_DIR:
+        case TT_DT_CHR:
+            state->setEntriesForChildPath(name);
+            onNavigate();
+            update();
+            break;
+        case TT_DT_LNK:
+            TT_LOG_W(TAG, "opening links is not supported");
+            break;
+        case TT_DT_REG:
+            viewFile(state->getCurrentPath(), name);
+            onNavigate();
+            break;
+        default:
+            // Assume it's a file
+            // TODO: Find a better way to identify a file
+            viewFile(state->getCurrentPath(), name);
+            onNavigate();
+            break;
     }
 }
 
-void View::onDirEntryLongPressed(int32_t index) {
-    dirent dir_entry;
-    if (state->getDirent(index, dir_entry)) {
-        TT_LOG_I(TAG, "Pressed %s %d", dir_entry.d_name, dir_entry.d_type);
-        state->setSelectedChildEntry(dir_entry.d_name);
-        using namespace file;
-        switch (dir_entry.d_type) {
-            case TT_DT_DIR:
-            case TT_DT_CHR:
-                showActionsForDirectory();
-                break;
-            case TT_DT_LNK:
-                TT_LOG_W(TAG, "opening links is not supported");
-                break;
-            case TT_DT_REG:
-                showActionsForFile();
-                break;
-            default:
-                // Assume it's a file
-                // TODO: Find a better way to identify a file
-                showActionsForFile();
-                break;
-        }
+void View::onDirEntryLongPressed(size_t index) {
+    if (listing == nullptr || index >= listing->getCount()) {
+        return;
+    }
+
+    auto type = listing->getType(index);
+    TT_LOG_I(TAG, "Long-pressed %s %d", listing->getName(index), type);
+    state->setSelectedChildEntry(listing->getName(index));
+    using namespace file;
+    switch (type) {
+        case TT_DT_DIR:
+        case TT_DT_CHR:
+            showActionsForDirectory();
+            break;
+        case TT_DT_LNK:
+            TT_LOG_W(TAG, "opening links is not supported");
+            break;
+        case TT_DT_REG:
+            showActionsForFile();
+            break;
+        default:
+            // Assume it's a file
+            // TODO: Find a better way to identify a file
+            showActionsForFile();
+            break;
     }
 }
 
-void View::createDirEntryWidget(lv_obj_t* list, dirent& dir_entry) {
-    tt_check(list);
+void View::onBindDirEntry(lv_obj_t* row, size_t index) {
+    const char* name = listing->getName(index);
     const char* symbol;
-    if (dir_entry.d_type == file::TT_DT_DIR || dir_entry.d_type == file::TT_DT_CHR) {
+    if (listing->isDirectory(index)) {
         symbol = LV_SYMBOL_DIRECTORY;
-    } else if (isSupportedImageFile(dir_entry.d_name)) {
+    } else if (isSupportedImageFile(name)) {
         symbol = LV_SYMBOL_IMAGE;
-    } else if (dir_entry.d_type == file::TT_DT_LNK) {
+    } else if (listing->getType(index) == file::TT_DT_LNK) {
         symbol = LV_SYMBOL_LOOP;
     } else {
         symbol = LV_SYMBOL_FILE;
     }
-    lv_obj_t* button = lv_list_add_button(list, symbol, dir_entry.d_name);
-    lv_obj_add_event_cb(button, &onDirEntryPressedCallback, LV_EVENT_SHORT_CLICKED, this);
-    lv_obj_add_event_cb(button, &onDirEntryLongPressedCallback, LV_EVENT_LONG_PRESSED, this);
+    lvgl::virtual_list_row_set_content(row, symbol, name);
 }
 
 void View::onNavigateUpPressed() {
@@ -234,23 +224,34 @@ void View::showActionsForFile() {
     lv_obj_remove_flag(action_list, LV_OBJ_FLAG_HIDDEN);
 }
 
+/** Requires the LVGL lock */
+void View::updateLocked() {
+    // The view was hidden while loading
+    if (dir_entry_list == nullptr) {
+        return;
+    }
+
+    // Keep a reference, so the rows stay valid when the state moves on to another listing
+    listing = state->getListing();
+    lvgl::virtual_list_set_item_count(dir_entry_list, (listing != nullptr) ? listing->getCount() : 0);
+
+    if (listing == nullptr) {
+        lv_obj_remove_flag(loading_spinner, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(loading_spinner, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    if (state->getCurrentPath() == "/") {
+        lv_obj_add_flag(navigate_up_button, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_remove_flag(navigate_up_button, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
 void View::update() {
     auto scoped_lockable = lvgl::getSyncLock()->asScopedLock();
     if (scoped_lockable.lock(lvgl::defaultLockTime)) {
-        lv_obj_clean(dir_entry_list);
-
-        state->withEntries([this](const std::vector<dirent>& entries) {
-            for (auto entry : entries) {
-                TT_LOG_D(TAG, "Entry: %s %d", entry.d_name, entry.d_type);
-                createDirEntryWidget(dir_entry_list, entry);
-            }
-        });
-
-        if (state->getCurrentPath() == "/") {
-            lv_obj_add_flag(navigate_up_button, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_remove_flag(navigate_up_button, LV_OBJ_FLAG_HIDDEN);
-        }
+        updateLocked();
     } else {
         TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "lvgl");
     }
@@ -262,6 +263,7 @@ void View::init(const AppContext& appContext, lv_obj_t* parent) {
 
     auto* toolbar = lvgl::toolbar_create(parent, appContext);
     navigate_up_button = lvgl::toolbar_add_image_button_action(toolbar, LV_SYMBOL_UP, &onNavigateUpPressedCallback, this);
+    loading_spinner = lvgl::toolbar_add_spinner_action(toolbar);
 
     auto* wrapper = lv_obj_create(parent);
     lv_obj_set_width(wrapper, LV_PCT(100));
@@ -270,7 +272,13 @@ void View::init(const AppContext& appContext, lv_obj_t* parent) {
     lv_obj_set_flex_grow(wrapper, 1);
     lv_obj_set_flex_flow(wrapper, LV_FLEX_FLOW_ROW);
 
-    dir_entry_list = lv_list_create(wrapper);
+    // Only the visible entries get widgets, so large directories don't run out of memory
+    dir_entry_list = lvgl::virtual_list_create(
+        wrapper,
+        [this](lv_obj_t* row, size_t index) { onBindDirEntry(row, index); },
+        [this](size_t index) { onDirEntryPressed(index); }
+    );
+    lvgl::virtual_list_set_long_press_callback(dir_entry_list, [this](size_t index) { onDirEntryLongPressed(index); });
     lv_obj_set_height(dir_entry_list, LV_PCT(100));
     lv_obj_set_flex_grow(dir_entry_list, 1);
 
@@ -281,9 +289,31 @@ void View::init(const AppContext& appContext, lv_obj_t* parent) {
     lv_obj_set_flex_grow(action_list, 1);
     lv_obj_add_flag(action_list, LV_OBJ_FLAG_HIDDEN);
 
+    shown = std::make_shared<bool>(true);
+    // The flag is checked before the view is used: the view might be hidden or destroyed when the loader thread calls this
+    state->setOnEntriesChanged([this, shown = shown] {
+        auto scoped_lockable = lvgl::getSyncLock()->asScopedLock();
+        if (!scoped_lockable.lock(lvgl::defaultLockTime)) {
+            TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "lvgl");
+        } else if (*shown) {
+            updateLocked();
+        }
+    });
     update();
 }
 
+/** Called with the LVGL lock held */
+void View::deinit() {
+    state->setOnEntriesChanged(nullptr);
+    *shown = false;
+    shown = nullptr;
+    dir_entry_list = nullptr;
+    action_list = nullptr;
+    navigate_up_button = nullptr;
+    loading_spinner = nullptr;
+    listing = nullptr;
+}
+
 void View::onDirEntryListScrollBegin() {
     auto scoped_lockable = lvgl::getSyncLock()->asScopedLock();
     if (scoped_lockable.lock(lvgl::defaultLockTime)) {
@@ -331,7 +361,8 @@ void View::onResult(LaunchId launchId, Result result, std::unique_ptr<Bundle> bu
                     lock->unlock();
                 }
 
-                state->setEntriesForPath(state->getCurrentPath());
+                state->invalidate(filepath);
+                state->refresh();
                 update();
             }
             break;
@@ -349,7 +380,8 @@ void View::onResult(LaunchId launchId, Result result, std::unique_ptr<Bundle> bu
                 }
                 lock->unlock();
 
-                state->setEntriesForPath(state->getCurrentPath());
+                state->invalidate(filepath);
+                state->refresh();
                 update();
             }
             break;
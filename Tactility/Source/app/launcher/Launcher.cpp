@@ -4,6 +4,7 @@
 #include <Tactility/app/AppPaths.h>
 #include <Tactility/app/AppRegistration.h>
 #include <Tactility/hal/power/PowerDevice.h>
+#include <Tactility/lvgl/ImageCache.h>
 #include <Tactility/lvgl/Lvgl.h>
 #include <Tactility/service/loader/Loader.h>
 #include <Tactility/settings/BootSettings.h>
@@ -24,7 +25,7 @@ static int getButtonSize(hal::UiScale scale) {
 
 class LauncherApp final : public App {
 
-    static lv_obj_t* createAppButton(lv_obj_t* parent, hal::UiScale uiScale, const char* imageFile, const char* appId, int32_t itemMargin, bool isLandscape) {
+    static lv_obj_t* createAppButton(lv_obj_t* parent, hal::UiScale uiScale, const std::string& imageFile, const char* appId, int32_t itemMargin, bool isLandscape) {
         auto button_size = getButtonSize(uiScale);
 
         auto* apps_button = lv_button_create(parent);
@@ -39,7 +40,7 @@ class LauncherApp final : public App {
         lv_obj_set_style_bg_opa(apps_button, 0, LV_STATE_DEFAULT);
 
         auto* button_image = lv_image_create(apps_button);
-        lv_image_set_src(button_image, imageFile);
+        lvgl::image_set_src_cached(button_image, imageFile);
         lv_obj_set_style_image_recolor(button_image, lv_theme_get_color_primary(parent), LV_STATE_DEFAULT);
         lv_obj_set_style_image_recolor_opa(button_image, LV_OPA_COVER, LV_STATE_DEFAULT);
         // Ensure buttons are still tappable when the asset fails to load
@@ -129,9 +130,9 @@ public:
         const auto files_icon_path = lvgl::PATH_PREFIX + paths->getAssetsPath("icon_files.png");
         const auto settings_icon_path = lvgl::PATH_PREFIX + paths->getAssetsPath("icon_settings.png");
 
-        createAppButton(buttons_wrapper, ui_scale, apps_icon_path.c_str(), "AppList", margin, is_landscape_display);
-        createAppButton(buttons_wrapper, ui_scale, files_icon_path.c_str(), "Files", margin, is_landscape_display);
-        createAppButton(buttons_wrapper, ui_scale, settings_icon_path.c_str(), "Settings", margin, is_landscape_display);
+        createAppButton(buttons_wrapper, ui_scale, apps_icon_path, "AppList", margin, is_landscape_display);
+        createAppButton(buttons_wrapper, ui_scale, files_icon_path, "Files", margin, is_landscape_display);
+        createAppButton(buttons_wrapper, ui_scale, settings_icon_path, "Settings", margin, is_landscape_display);
 
         if (shouldShowPowerButton()) {
             auto* power_button = lv_btn_create(parent);
@@ -152,7 +153,7 @@ extern const AppManifest manifest = {
     .appId = "Launcher",
     .appName = "Launcher",
     .appCategory = Category::System,
-    .appFlags = AppManifest::Flags::Hidden,
+    .appFlags = AppManifest::Flags::Hidden | AppManifest::Flags::RetainView,
     .createApp = create<LauncherApp>
 };
 
@@ -43,19 +43,19 @@ class LocaleSettingsApp final : public App {
         for (int i = 0; i < static_cast<int>(settings::Language::count); i++) {
             switch (static_cast<settings::Language>(i)) {
                 case settings::Language::en_GB:
-                    items.push_back(textResources[i18n::Text::EN_GB]);
+                    items.emplace_back(textResources[i18n::Text::EN_GB]);
                     break;
                 case settings::Language::en_US:
-                    items.push_back(textResources[i18n::Text::EN_US]);
+                    items.emplace_back(textResources[i18n::Text::EN_US]);
                     break;
                 case settings::Language::fr_FR:
-                    items.push_back(textResources[i18n::Text::FR_FR]);
+                    items.emplace_back(textResources[i18n::Text::FR_FR]);
                     break;
                 case settings::Language::nl_BE:
-                    items.push_back(textResources[i18n::Text::NL_BE]);
+                    items.emplace_back(textResources[i18n::Text::NL_BE]);
                     break;
                 case settings::Language::nl_NL:
-                    items.push_back(textResources[i18n::Text::NL_NL]);
+                    items.emplace_back(textResources[i18n::Text::NL_NL]);
                     break;
                 case settings::Language::count:
                     break;
@@ -67,8 +67,8 @@ class LocaleSettingsApp final : public App {
     void updateViews() {
         textResources.load();
 
-        lv_label_set_text(regionLabel , textResources[i18n::Text::REGION].c_str());
-        lv_label_set_text(languageLabel, textResources[i18n::Text::LANGUAGE].c_str());
+        lv_label_set_text(regionLabel , textResources[i18n::Text::REGION].data());
+        lv_label_set_text(languageLabel, textResources[i18n::Text::LANGUAGE].data());
 
         std::string language_options = getLanguageOptions();
         lv_dropdown_set_options(languageDropdown, language_options.c_str());
@@ -111,7 +111,7 @@ public:
         lv_obj_set_style_border_width(region_wrapper, 0, 0);
 
         regionLabel = lv_label_create(region_wrapper);
-        lv_label_set_text(regionLabel , textResources[i18n::Text::REGION].c_str());
+        lv_label_set_text(regionLabel , textResources[i18n::Text::REGION].data());
         lv_obj_align(regionLabel , LV_ALIGN_LEFT_MID, 0, 0);
 
         auto* region_button = lv_button_create(region_wrapper);
@@ -139,7 +139,7 @@ public:
         lv_obj_set_style_border_width(language_wrapper, 0, 0);
 
         languageLabel = lv_label_create(language_wrapper);
-        lv_label_set_text(languageLabel, textResources[i18n::Text::LANGUAGE].c_str());
+        lv_label_set_text(languageLabel, textResources[i18n::Text::LANGUAGE].data());
         lv_obj_align(languageLabel, LV_ALIGN_LEFT_MID, 0, 0);
 
         languageDropdown = lv_dropdown_create(language_wrapper);
@@ -3,6 +3,7 @@
 #include "Tactility/lvgl/Style.h"
 #include "Tactility/lvgl/Toolbar.h"
 #include "Tactility/service/loader/Loader.h"
+#include "Tactility/service/power/PowerService.h"
 
 #include "Tactility/hal/power/PowerDevice.h"
 #include <Tactility/Assets.h>
@@ -11,6 +12,8 @@
 
 #include <lvgl.h>
 
+#include <algorithm>
+
 namespace tt::app::power {
 
 #define TAG "power"
@@ -57,6 +60,8 @@ class PowerApp : public App {
 
             if (power->isAllowedToCharge() != is_on) {
                 power->setAllowedToCharge(is_on);
+                // The charging state is shown on the next update
+                service::power::findPowerService()->requestSample();
                 updateUi();
             }
         }
@@ -67,39 +72,30 @@ class PowerApp : public App {
         app->onPowerEnabledChanged(event);
     }
 
+    /** @return the latest sample of the power service: reading the device directly could block the UI on ADC measurements */
+    std::optional<service::power::PowerSnapshot> findSnapshot() const {
+        auto snapshots = service::power::findPowerService()->getSnapshots();
+        auto snapshot = std::ranges::find_if(*snapshots, [this](const auto& item) { return item.device == power; });
+        if (snapshot != snapshots->end()) {
+            return *snapshot;
+        } else {
+            return std::nullopt;
+        }
+    }
+
     void updateUi() {
+        auto snapshot = findSnapshot().value_or(service::power::PowerSnapshot());
+
         const char* charge_state;
-        hal::power::PowerDevice::MetricData metric_data;
-        if (power->getMetric(hal::power::PowerDevice::MetricType::IsCharging, metric_data)) {
-            charge_state = metric_data.valueAsBool ? "yes" : "no";
+        if (snapshot.isCharging.has_value()) {
+            charge_state = *snapshot.isCharging ? "yes" : "no";
         } else {
             charge_state = "N/A";
         }
 
-        uint8_t charge_level;
-        bool charge_level_scaled_set = false;
-        if (power->getMetric(hal::power::PowerDevice::MetricType::ChargeLevel, metric_data)) {
-            charge_level = metric_data.valueAsUint8;
-            charge_level_scaled_set = true;
-        }
-
         bool charging_enabled_set = power->supportsChargeControl();
         bool charging_enabled_and_allowed = power->supportsChargeControl() && power->isAllowedToCharge();
 
-        int32_t current;
-        bool current_set = false;
-        if (power->getMetric(hal::power::PowerDevice::MetricType::Current, metric_data)) {
-            current = metric_data.valueAsInt32;
-            current_set = true;
-        }
-
-        uint32_t battery_voltage;
-        bool battery_voltage_set = false;
-        if (power->getMetric(hal::power::PowerDevice::MetricType::BatteryVoltage, metric_data)) {
-            battery_voltage = metric_data.valueAsUint32;
-            battery_voltage_set = true;
-        }
-
         lvgl::lock(kernel::millisToTicks(1000));
 
         if (charging_enabled_set) {
@@ -113,20 +109,20 @@ class PowerApp : public App {
 
         lv_label_set_text_fmt(chargeStateLabel, "Charging: %s", charge_state);
 
-        if (battery_voltage_set) {
-            lv_label_set_text_fmt(batteryVoltageLabel, "Battery voltage: %lu mV", battery_voltage);
+        if (snapshot.batteryVoltage.has_value()) {
+            lv_label_set_text_fmt(batteryVoltageLabel, "Battery voltage: %lu mV", *snapshot.batteryVoltage);
         } else {
             lv_label_set_text_fmt(batteryVoltageLabel, "Battery voltage: N/A");
         }
 
-        if (charge_level_scaled_set) {
-            lv_label_set_text_fmt(chargeLevelLabel, "Charge level: %d%%", charge_level);
+        if (snapshot.chargeLevel.has_value()) {
+            lv_label_set_text_fmt(chargeLevelLabel, "Charge level: %d%%", *snapshot.chargeLevel);
         } else {
             lv_label_set_text_fmt(chargeLevelLabel, "Charge level: N/A");
         }
 
-        if (current_set) {
-            lv_label_set_text_fmt(currentLabel, "Current: %ld mAh", current);
+        if (snapshot.current.has_value()) {
+            lv_label_set_text_fmt(currentLabel, "Current: %ld mAh", *snapshot.current);
         } else {
             lv_label_set_text_fmt(currentLabel, "Current: N/A");
         }
@@ -50,7 +50,7 @@ extern const AppManifest manifest = {
     .appName = "Settings",
     .appIcon = TT_ASSETS_APP_ICON_SETTINGS,
     .appCategory = Category::System,
-    .appFlags = AppManifest::Flags::Hidden,
+    .appFlags = AppManifest::Flags::Hidden | AppManifest::Flags::RetainView,
     .createApp = create<SettingsApp>
 };
 
@@ -2,14 +2,13 @@
 #include <Tactility/app/AppManifest.h>
 #include <Tactility/app/AppPaths.h>
 #include <Tactility/app/timezone/TimeZone.h>
+#include <Tactility/app/timezone/TimeZoneIndex.h>
 #include <Tactility/lvgl/Lvgl.h>
 #include <Tactility/lvgl/Toolbar.h>
-#include <Tactility/lvgl/LvglSync.h>
+#include <Tactility/lvgl/VirtualList.h>
 #include <Tactility/service/loader/Loader.h>
 
 #include <Tactility/MountPoints.h>
-#include <Tactility/StringUtils.h>
-#include <Tactility/Timer.h>
 
 #include <lvgl.h>
 #include <memory>
@@ -22,23 +21,6 @@ constexpr auto* RESULT_BUNDLE_NAME_INDEX = "name";
 
 extern const AppManifest manifest;
 
-struct TimeZoneEntry {
-    std::string name;
-    std::string code;
-};
-
-static bool parseEntry(const std::string& input, std::string& outName, std::string& outCode) {
-    std::string partial_strip = input.substr(1, input.size() - 3);
-    auto first_end_quote = partial_strip.find('"');
-    if (first_end_quote == std::string::npos) {
-        return false;
-    } else {
-        outName = partial_strip.substr(0, first_end_quote);
-        outCode = partial_strip.substr(first_end_quote + 3);
-        return true;
-    }
-}
-
 // region Result
 
 std::string getResultName(const Bundle& bundle) {
@@ -65,124 +47,56 @@ void setResultCode(Bundle& bundle, const std::string& code) {
 
 class TimeZoneApp final : public App {
 
-    Mutex mutex;
-    std::vector<TimeZoneEntry> entries;
-    std::unique_ptr<Timer> updateTimer;
+    std::shared_ptr<const TimeZoneIndex> index;
+    std::unique_ptr<TimeZoneFilter> filter;
     lv_obj_t* listWidget = nullptr;
     lv_obj_t* filterTextareaWidget = nullptr;
 
-    static void onTextareaValueChangedCallback(TT_UNUSED lv_event_t* e) {
+    static void onTextareaValueChangedCallback(lv_event_t* e) {
         auto* app = (TimeZoneApp*)lv_event_get_user_data(e);
-        app->onTextareaValueChanged(e);
+        app->onTextareaValueChanged();
     }
 
-    void onTextareaValueChanged(TT_UNUSED lv_event_t* e) {
-        if (mutex.lock(100 / portTICK_PERIOD_MS)) {
-            if (updateTimer->isRunning()) {
-                updateTimer->stop();
-            }
-
-            updateTimer->start(500 / portTICK_PERIOD_MS);
-
-            mutex.unlock();
+    void onTextareaValueChanged() {
+        if (filter == nullptr) {
+            return;
         }
+
+        // Filtering is fast enough to do on every key press (the previous matches are refined while typing)
+        filter->setQuery(lv_textarea_get_text(filterTextareaWidget));
+        lvgl::virtual_list_set_item_count(listWidget, filter->getMatches().size());
     }
 
-    static void onListItemSelectedCallback(lv_event_t* e) {
-        auto index = reinterpret_cast<std::size_t>(lv_event_get_user_data(e));
-        auto app = std::static_pointer_cast<TimeZoneApp>(getCurrentApp());
-        assert(app != nullptr);
-        app->onListItemSelected(index);
+    void onBindListItem(lv_obj_t* row, size_t listIndex) {
+        auto timezone_index = filter->getMatches()[listIndex];
+        lvgl::virtual_list_row_set_text(row, index->getName(timezone_index));
     }
 
-    void onListItemSelected(std::size_t index) {
-        TT_LOG_I(TAG, "Selected item at index %zu", index);
+    void onListItemSelected(size_t listIndex) {
+        TT_LOG_I(TAG, "Selected item at index %zu", listIndex);
 
-        auto& entry = entries[index];
+        auto timezone_index = filter->getMatches()[listIndex];
 
         auto bundle = std::make_unique<Bundle>();
-        setResultName(*bundle, entry.name);
-        setResultCode(*bundle, entry.code);
+        setResultName(*bundle, index->getName(timezone_index));
+        setResultCode(*bundle, index->getCode(timezone_index));
 
         setResult(Result::Ok, std::move(bundle));
         stop(manifest.appId);
     }
 
-    static void createListItem(lv_obj_t* list, const std::string& title, size_t index) {
-        auto* btn = lv_list_add_button(list, nullptr, title.c_str());
-        lv_obj_add_event_cb(btn, &onListItemSelectedCallback, LV_EVENT_SHORT_CLICKED, (void*)index);
-    }
+public:
 
-    void readTimeZones(std::string filter) {
+    void onCreate(TT_UNUSED AppContext& app) override {
         auto path = std::string(file::MOUNT_POINT_SYSTEM) + "/timezones.csv";
-        auto* file = fopen(path.c_str(), "rb");
-        if (file == nullptr) {
-            TT_LOG_E(TAG, "Failed to open %s", path.c_str());
-            return;
-        }
-        char line[96];
-        std::string name;
-        std::string code;
-        uint32_t count = 0;
-        std::vector<TimeZoneEntry> new_entries;
-        while (fgets(line, 96, file)) {
-            if (parseEntry(line, name, code)) {
-                if (string::lowercase(name).find(filter) != std::string::npos) {
-                    count++;
-                    new_entries.push_back({.name = name, .code = code});
-
-                    // Safety guard
-                    if (count > 50) {
-                        // TODO: Show warning that we're not displaying a complete list
-                        break;
-                    }
-                }
-            } else {
-                TT_LOG_E(TAG, "Parse error at line %lu", count);
-            }
-        }
-
-        fclose(file);
-
-        if (mutex.lock(100 / portTICK_PERIOD_MS)) {
-            entries = std::move(new_entries);
-            mutex.unlock();
+        index = TimeZoneIndex::load(path);
+        if (index != nullptr) {
+            filter = std::make_unique<TimeZoneFilter>(index);
         } else {
-            TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
+            TT_LOG_E(TAG, "Failed to load %s", path.c_str());
         }
-
-        TT_LOG_I(TAG, "Processed %lu entries", count);
     }
 
-    void updateList() {
-        if (lvgl::lock(100 / portTICK_PERIOD_MS)) {
-            std::string filter = string::lowercase(std::string(lv_textarea_get_text(filterTextareaWidget)));
-            readTimeZones(filter);
-            lvgl::unlock();
-        } else {
-            TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
-            return;
-        }
-
-        if (lvgl::lock(100 / portTICK_PERIOD_MS)) {
-            if (mutex.lock(100 / portTICK_PERIOD_MS)) {
-                lv_obj_clean(listWidget);
-
-                uint32_t index = 0;
-                for (auto& entry : entries) {
-                    createListItem(listWidget, entry.name, index);
-                    index++;
-                }
-
-                mutex.unlock();
-            }
-
-            lvgl::unlock();
-        }
-    }
-
-public:
-
     void onShow(AppContext& app, lv_obj_t* parent) override {
         lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_COLUMN);
         lv_obj_set_style_pad_row(parent, 0, LV_STATE_DEFAULT);
@@ -212,17 +126,21 @@ public:
         filterTextareaWidget = textarea;
         lv_obj_set_flex_grow(textarea, 1);
 
-        auto* list = lv_list_create(parent);
+        // Only the visible rows are created, so all timezones can be listed
+        auto* list = lvgl::virtual_list_create(
+            parent,
+            [this](lv_obj_t* row, size_t listIndex) { onBindListItem(row, listIndex); },
+            [this](size_t listIndex) { onListItemSelected(listIndex); }
+        );
         lv_obj_set_width(list, LV_PCT(100));
         lv_obj_set_flex_grow(list, 1);
         lv_obj_set_style_border_width(list, 0, 0);
         listWidget = list;
-    }
 
-    void onCreate(AppContext& app) override {
-        updateTimer = std::make_unique<Timer>(Timer::Type::Once, [this] {
-            updateList();
-        });
+        if (filter != nullptr) {
+            filter->setQuery("");
+            lvgl::virtual_list_set_item_count(list, filter->getMatches().size());
+        }
     }
 };
 
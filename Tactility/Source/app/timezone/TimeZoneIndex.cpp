@@ -0,0 +1,117 @@
+#include "Tactility/app/timezone/TimeZoneIndex.h"
+
+#include <Tactility/Log.h>
+#include <Tactility/StringUtils.h>
+#include <Tactility/file/File.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <numeric>
+
+namespace tt::app::timezone {
+
+constexpr auto* TAG = "TimeZoneIndex";
+
+/** Parse a line like "Europe/Amsterdam","CET-1CEST,M3.5.0,M10.5.0/3" without copying it */
+static bool parseLine(const char* line, std::string_view& outName, std::string_view& outCode) {
+    const char* name_start = strchr(line, '"');
+    if (name_start == nullptr) {
+        return false;
+    }
+    name_start++;
+    const char* name_end = strchr(name_start, '"');
+    if (name_end == nullptr) {
+        return false;
+    }
+    const char* code_start = strchr(name_end + 1, '"');
+    if (code_start == nullptr) {
+        return false;
+    }
+    code_start++;
+    const char* code_end = strchr(code_start, '"');
+    if (code_end == nullptr) {
+        return false;
+    }
+    outName = std::string_view(name_start, name_end - name_start);
+    outCode = std::string_view(code_start, code_end - code_start);
+    return !outName.empty();
+}
+
+std::unique_ptr<TimeZoneIndex> TimeZoneIndex::load(const std::string& filePath) {
+    auto index = std::unique_ptr<TimeZoneIndex>(new TimeZoneIndex());
+    std::vector<Entry> unsorted_entries;
+    uint32_t line_number = 0;
+    bool read = file::readLines(filePath, true, [&index, &unsorted_entries, &line_number](const char* line) {
+        line_number++;
+        std::string_view name, code;
+        if (!parseLine(line, name, code)) {
+            if (line[0] != '\0' && line[0] != '\r') {
+                TT_LOG_E(TAG, "Parse error at line %lu", line_number);
+            }
+            return;
+        }
+        auto& strings = index->strings;
+        Entry entry = {
+            .nameOffset = static_cast<uint32_t>(strings.size()),
+            .codeOffset = static_cast<uint32_t>(strings.size() + name.size() + 1)
+        };
+        strings.insert(strings.end(), name.begin(), name.end());
+        strings.push_back('\0');
+        strings.insert(strings.end(), code.begin(), code.end());
+        strings.push_back('\0');
+        unsorted_entries.push_back(entry);
+    });
+
+    if (!read) {
+        TT_LOG_E(TAG, "Failed to read %s", filePath.c_str());
+        return nullptr;
+    }
+
+    index->strings.shrink_to_fit();
+    index->lowercaseStrings.resize(index->strings.size());
+    std::ranges::transform(index->strings, index->lowercaseStrings.begin(), [](char character) {
+        return static_cast<char>(tolower(static_cast<unsigned char>(character)));
+    });
+
+    const char* strings = index->strings.data();
+    std::ranges::sort(unsorted_entries, [strings](const Entry& left, const Entry& right) {
+        return strcmp(strings + left.nameOffset, strings + right.nameOffset) < 0;
+    });
+    index->entries = std::move(unsorted_entries);
+    index->entries.shrink_to_fit();
+
+    TT_LOG_I(TAG, "Indexed %d timezones", (int)index->entries.size());
+    return index;
+}
+
+TimeZoneFilter::TimeZoneFilter(std::shared_ptr<const TimeZoneIndex> index) : index(std::move(index)) {
+    matches.resize(this->index->getCount());
+    std::iota(matches.begin(), matches.end(), 0);
+}
+
+void TimeZoneFilter::setQuery(const std::string& newQuery) {
+    auto lowercase_query = string::lowercase(newQuery);
+    if (lowercase_query == query) {
+        lastComparisonCount = 0;
+        return;
+    }
+
+    // Matches of a longer query are always a subset of the current matches
+    bool refine = lowercase_query.find(query) != std::string::npos;
+    if (!refine) {
+        matches.resize(index->getCount());
+        std::iota(matches.begin(), matches.end(), 0);
+    }
+
+    lastComparisonCount = matches.size();
+    if (!lowercase_query.empty()) {
+        std::erase_if(matches, [this, &lowercase_query](uint16_t match) {
+            return strstr(index->getLowercaseName(match), lowercase_query.c_str()) == nullptr;
+        });
+    }
+
+    query = std::move(lowercase_query);
+}
+
+} // namespace tt::app::timezone
@@ -0,0 +1,155 @@
+#include "Tactility/file/AssetPack.h"
+
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tt::file {
+
+constexpr auto* TAG = "AssetPack";
+
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t ENTRY_SIZE = 28;
+
+static uint16_t readUint16(const uint8_t* data) {
+    return data[0] | (data[1] << 8);
+}
+
+static uint32_t readUint32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+/** FNV-1a, as used by asset-pack.py */
+static uint32_t getNameHash(const std::string& name) {
+    uint32_t hash = 0x811C9DC5U;
+    for (auto character : name) {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= 0x01000193U;
+    }
+    return hash;
+}
+
+static bool isValidColorFormat(uint8_t colorFormat) {
+    switch (static_cast<AssetPack::ColorFormat>(colorFormat)) {
+        case AssetPack::ColorFormat::A8:
+        case AssetPack::ColorFormat::Argb8888:
+        case AssetPack::ColorFormat::Rgb565A8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::unique_ptr<AssetPack> AssetPack::open(const std::string& filePath) {
+    auto file = std::unique_ptr<FILE, FileCloser>(fopen(filePath.c_str(), "rb"));
+    if (file == nullptr) {
+        TT_LOG_W(TAG, "Failed to open %s", filePath.c_str());
+        return nullptr;
+    }
+
+    uint8_t header[HEADER_SIZE];
+    if (fread(header, 1, HEADER_SIZE, file.get()) != HEADER_SIZE || memcmp(header, "TTAP", 4) != 0) {
+        TT_LOG_E(TAG, "Invalid header in %s", filePath.c_str());
+        return nullptr;
+    }
+
+    auto pack_version = readUint16(header + 4);
+    if (pack_version != version) {
+        TT_LOG_E(TAG, "Unsupported version %d in %s", pack_version, filePath.c_str());
+        return nullptr;
+    }
+
+    auto entry_count = readUint16(header + 6);
+    auto names_offset = readUint32(header + 8);
+    auto names_size = readUint32(header + 12);
+    if (names_offset != HEADER_SIZE + entry_count * ENTRY_SIZE) {
+        TT_LOG_E(TAG, "Invalid index in %s", filePath.c_str());
+        return nullptr;
+    }
+
+    // The index is small, so it's read in one go
+    std::vector<uint8_t> index(entry_count * ENTRY_SIZE);
+    std::vector<char> names(names_size);
+    if (fread(index.data(), 1, index.size(), file.get()) != index.size() ||
+        fread(names.data(), 1, names.size(), file.get()) != names.size()) {
+        TT_LOG_E(TAG, "Failed to read index of %s", filePath.c_str());
+        return nullptr;
+    }
+
+    auto file_size = getSize(file.get());
+    std::vector<Entry> entries(entry_count);
+    for (uint16_t i = 0; i < entry_count; i++) {
+        const uint8_t* data = index.data() + i * ENTRY_SIZE;
+        auto& entry = entries[i];
+        entry.nameHash = readUint32(data);
+        entry.nameOffset = readUint32(data + 4);
+        entry.width = readUint16(data + 8);
+        entry.height = readUint16(data + 10);
+        entry.stride = readUint16(data + 12);
+        entry.colorFormat = data[14];
+        entry.reserved = data[15];
+        entry.color = readUint32(data + 16);
+        entry.dataOffset = readUint32(data + 20);
+        entry.dataSize = readUint32(data + 24);
+
+        if (
+            entry.nameOffset >= names_size ||
+            memchr(names.data() + entry.nameOffset, '\0', names_size - entry.nameOffset) == nullptr ||
+            !isValidColorFormat(entry.colorFormat) ||
+            file_size < 0 ||
+            static_cast<uint64_t>(entry.dataOffset) + entry.dataSize > static_cast<uint64_t>(file_size)
+        ) {
+            TT_LOG_E(TAG, "Invalid entry %d in %s", i, filePath.c_str());
+            return nullptr;
+        }
+    }
+
+    TT_LOG_I(TAG, "Opened %s with %d images", filePath.c_str(), entry_count);
+    return std::unique_ptr<AssetPack>(new AssetPack(filePath, std::move(entries), std::move(names)));
+}
+
+const AssetPack::Entry* AssetPack::find(const std::string& name) const {
+    auto hash = getNameHash(name);
+    // Entries are sorted by hash, so the entries with the same hash are next to each other
+    auto iterator = std::ranges::lower_bound(entries, hash, {}, &Entry::nameHash);
+    for (; iterator != entries.end() && iterator->nameHash == hash; ++iterator) {
+        if (name == names.data() + iterator->nameOffset) {
+            return &*iterator;
+        }
+    }
+    return nullptr;
+}
+
+bool AssetPack::load(const std::string& name, Image& image) const {
+    const auto* entry = find(name);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    auto file = std::unique_ptr<FILE, FileCloser>(fopen(filePath.c_str(), "rb"));
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "Failed to open %s", filePath.c_str());
+        return false;
+    }
+
+    auto data = std::make_unique<uint8_t[]>(entry->dataSize);
+    if (
+        fseek(file.get(), static_cast<long>(entry->dataOffset), SEEK_SET) != 0 ||
+        fread(data.get(), 1, entry->dataSize, file.get()) != entry->dataSize
+    ) {
+        TT_LOG_E(TAG, "Failed to read %s from %s", name.c_str(), filePath.c_str());
+        return false;
+    }
+
+    image.width = entry->width;
+    image.height = entry->height;
+    image.stride = entry->stride;
+    image.colorFormat = static_cast<ColorFormat>(entry->colorFormat);
+    image.color = entry->color;
+    image.dataSize = entry->dataSize;
+    image.data = std::move(data);
+    return true;
+}
+
+} // namespace tt::file
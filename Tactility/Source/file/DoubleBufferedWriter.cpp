@@ -0,0 +1,167 @@
+#include "Tactility/file/DoubleBufferedWriter.h"
+
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tt::file {
+
+constexpr auto* TAG = "DoubleBufferedWriter";
+
+DoubleBufferedWriter::DoubleBufferedWriter(size_t blockSize) :
+    blockSize(blockSize),
+    freeBlocks(2, sizeof(uint32_t)),
+    requests(3, sizeof(Message)),
+    flushed(1, sizeof(uint32_t)),
+    thread("file_writer", 4096, [this] { return threadMain(); })
+{
+    for (uint32_t i = 0; i < 2; i++) {
+        blocks[i] = std::make_unique<uint8_t[]>(blockSize);
+        freeBlocks.put(&i, 0);
+    }
+}
+
+DoubleBufferedWriter::~DoubleBufferedWriter() {
+    if (isOpen()) {
+        close();
+    }
+
+    if (threadStarted) {
+        Message message = { .type = Message::Type::Stop, .blockIndex = 0, .size = 0 };
+        requests.put(&message, portMAX_DELAY);
+        thread.join();
+    }
+}
+
+int32_t DoubleBufferedWriter::threadMain() {
+    Message message;
+    while (requests.get(&message, portMAX_DELAY)) {
+        switch (message.type) {
+            case Message::Type::Write: {
+                if (!failed) {
+                    // Lock per block, so other users of the storage don't have to wait for the whole file
+                    auto lock = fileLock->asScopedLock();
+                    lock.lock();
+                    if (fwrite(blocks[message.blockIndex].get(), 1, message.size, file.get()) != message.size) {
+                        TT_LOG_E(TAG, "Failed to write %zu bytes", message.size);
+                        failed = true;
+                    }
+                }
+                freeBlocks.put(&message.blockIndex, portMAX_DELAY);
+                break;
+            }
+            case Message::Type::Flush: {
+                uint32_t done = 1;
+                flushed.put(&done, portMAX_DELAY);
+                break;
+            }
+            case Message::Type::Stop:
+                return 0;
+        }
+    }
+    return -1;
+}
+
+bool DoubleBufferedWriter::open(const std::string& path, bool append) {
+    assert(!isOpen());
+
+    if (!threadStarted) {
+        thread.start();
+        threadStarted = true;
+    }
+
+    fileLock = getLock(path);
+    auto lock = fileLock->asScopedLock();
+    lock.lock();
+    file = std::unique_ptr<FILE, FileCloser>(fopen(path.c_str(), append ? "ab" : "wb"));
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "Failed to open %s", path.c_str());
+        return false;
+    }
+
+    failed = false;
+    bytesCommitted = 0;
+    return true;
+}
+
+uint8_t* DoubleBufferedWriter::getBuffer(size_t& size) {
+    assert(isOpen());
+    if (currentBlockIndex < 0) {
+        uint32_t index;
+        freeBlocks.get(&index, portMAX_DELAY);
+        currentBlockIndex = static_cast<int32_t>(index);
+        currentBlockSize = 0;
+    }
+    size = blockSize - currentBlockSize;
+    return blocks[currentBlockIndex].get() + currentBlockSize;
+}
+
+void DoubleBufferedWriter::submitCurrentBlock() {
+    Message message = {
+        .type = Message::Type::Write,
+        .blockIndex = static_cast<uint32_t>(currentBlockIndex),
+        .size = currentBlockSize
+    };
+    requests.put(&message, portMAX_DELAY);
+    currentBlockIndex = -1;
+    currentBlockSize = 0;
+}
+
+bool DoubleBufferedWriter::commit(size_t size) {
+    assert(currentBlockIndex >= 0);
+    assert(currentBlockSize + size <= blockSize);
+    currentBlockSize += size;
+    bytesCommitted += size;
+    if (currentBlockSize == blockSize) {
+        submitCurrentBlock();
+    }
+    return !failed;
+}
+
+bool DoubleBufferedWriter::write(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        size_t available;
+        auto* buffer = getBuffer(available);
+        auto length = std::min(available, size);
+        memcpy(buffer, data, length);
+        if (!commit(length)) {
+            return false;
+        }
+        data += length;
+        size -= length;
+    }
+    return !failed;
+}
+
+void DoubleBufferedWriter::flush() {
+    if (currentBlockIndex >= 0) {
+        if (currentBlockSize > 0) {
+            submitCurrentBlock();
+        } else {
+            auto index = static_cast<uint32_t>(currentBlockIndex);
+            freeBlocks.put(&index, portMAX_DELAY);
+            currentBlockIndex = -1;
+        }
+    }
+
+    Message message = { .type = Message::Type::Flush, .blockIndex = 0, .size = 0 };
+    requests.put(&message, portMAX_DELAY);
+    uint32_t done;
+    flushed.get(&done, portMAX_DELAY);
+}
+
+bool DoubleBufferedWriter::close() {
+    assert(isOpen());
+    flush();
+
+    auto lock = fileLock->asScopedLock();
+    lock.lock();
+    bool closed = fclose(file.release()) == 0;
+    lock.unlock();
+
+    fileLock = nullptr;
+    return closed && !failed;
+}
+
+} // namespace tt::file
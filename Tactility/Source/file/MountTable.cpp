@@ -0,0 +1,184 @@
+#include "Tactility/file/MountTable.h"
+
+#include <Tactility/Log.h>
+#include <Tactility/Mutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+
+namespace tt::file {
+
+constexpr auto* TAG = "MountTable";
+
+/** A node per path component. Fan-out is tiny, so children are a plain list. */
+struct TrieNode {
+    std::vector<std::pair<std::string, std::unique_ptr<TrieNode>>> children;
+    /** Index into MountTableState::mounts, or -1 when no file system is mounted at this node */
+    int mountIndex = -1;
+
+    const TrieNode* _Nullable findChild(std::string_view name) const {
+        for (const auto& [child_name, child] : children) {
+            if (child_name == name) {
+                return child.get();
+            }
+        }
+        return nullptr;
+    }
+
+    TrieNode& getOrCreateChild(std::string_view name) {
+        for (auto& [child_name, child] : children) {
+            if (child_name == name) {
+                return *child;
+            }
+        }
+        children.emplace_back(std::string(name), std::make_unique<TrieNode>());
+        return *children.back().second;
+    }
+};
+
+/** Immutable: a new state is created for every change */
+struct MountTableState {
+    std::vector<Mount> mounts;
+    TrieNode root;
+    uint32_t generation = 0;
+};
+
+static Mutex mutex;
+static std::atomic<std::shared_ptr<const MountTableState>> state;
+static std::atomic<uint32_t> generation = 0;
+
+/**
+ * Call the function for every non-empty component of the path.
+ * @param[in] onComponent return true to continue, false to stop
+ */
+template<typename Function>
+static void forEachPathComponent(std::string_view path, Function onComponent) {
+    size_t start = 0;
+    while (start < path.size()) {
+        size_t end = path.find('/', start);
+        if (end == std::string_view::npos) {
+            end = path.size();
+        }
+        if (end > start && !onComponent(path.substr(start, end - start))) {
+            return;
+        }
+        start = end + 1;
+    }
+}
+
+static std::shared_ptr<const MountTableState> loadState() {
+    static const auto empty_state = std::make_shared<const MountTableState>();
+    auto result = state.load(std::memory_order_acquire);
+    return (result != nullptr) ? result : empty_state;
+}
+
+static std::shared_ptr<const MountTableState> createState(std::vector<Mount> mounts, uint32_t newGeneration) {
+    std::ranges::sort(mounts, [](const auto& left, const auto& right) {
+        return left.path < right.path;
+    });
+
+    auto result = std::make_shared<MountTableState>();
+    result->generation = newGeneration;
+    for (int i = 0; i < mounts.size(); i++) {
+        TrieNode* node = &result->root;
+        forEachPathComponent(mounts[i].path, [&node](auto component) {
+            node = &node->getOrCreateChild(component);
+            return true;
+        });
+        node->mountIndex = i;
+    }
+    result->mounts = std::move(mounts);
+    return result;
+}
+
+/** Must be called while holding the mutex */
+static void updateState(std::vector<Mount> mounts, MountEvent::Action action, const std::string& path) {
+    auto new_generation = generation.load(std::memory_order_relaxed) + 1;
+    state.store(createState(std::move(mounts), new_generation), std::memory_order_release);
+    generation.store(new_generation, std::memory_order_release);
+
+    getMountPubsub()->publish({
+        .action = action,
+        .path = path,
+        .generation = new_generation
+    });
+}
+
+void addMount(const Mount& mount) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    auto mounts = loadState()->mounts;
+    std::erase_if(mounts, [&mount](const auto& item) {
+        return item.path == mount.path;
+    });
+    mounts.push_back(mount);
+
+    TT_LOG_I(TAG, "Mounted %s", mount.path.c_str());
+    updateState(std::move(mounts), MountEvent::Action::Mounted, mount.path);
+}
+
+bool removeMount(const std::string& path) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    auto mounts = loadState()->mounts;
+    if (std::erase_if(mounts, [&path](const auto& item) { return item.path == path; }) == 0) {
+        TT_LOG_W(TAG, "Can't unmount %s: not found", path.c_str());
+        return false;
+    }
+
+    TT_LOG_I(TAG, "Unmounted %s", path.c_str());
+    updateState(std::move(mounts), MountEvent::Action::Unmounted, path);
+    return true;
+}
+
+/** @return the index of the mount that owns the path, or -1 */
+static int findMountIndex(const MountTableState& current, const std::string& path) {
+    const TrieNode* node = &current.root;
+    int mount_index = node->mountIndex;
+    forEachPathComponent(path, [&node, &mount_index](auto component) {
+        node = node->findChild(component);
+        if (node == nullptr) {
+            return false;
+        }
+        if (node->mountIndex != -1) {
+            mount_index = node->mountIndex;
+        }
+        return true;
+    });
+    return mount_index;
+}
+
+bool findMount(const std::string& path, Mount& mount) {
+    auto current = loadState();
+    auto mount_index = findMountIndex(*current, path);
+    if (mount_index == -1) {
+        return false;
+    }
+
+    mount = current->mounts[mount_index];
+    return true;
+}
+
+std::shared_ptr<Lock> _Nullable findMountLock(const std::string& path) {
+    auto current = loadState();
+    auto mount_index = findMountIndex(*current, path);
+    return (mount_index != -1) ? current->mounts[mount_index].lock : nullptr;
+}
+
+std::vector<Mount> getMounts() {
+    return loadState()->mounts;
+}
+
+uint32_t getMountGeneration() {
+    return generation.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<PubSub<MountEvent>> getMountPubsub() {
+    static auto pubsub = std::make_shared<PubSub<MountEvent>>();
+    return pubsub;
+}
+
+} // namespace
@@ -0,0 +1,155 @@
+#include "Tactility/file/ObjectFile.h"
+#include "Tactility/file/ObjectFilePrivate.h"
+
+#include <Tactility/Crc32.h>
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+
+namespace tt::file {
+
+constexpr auto* TAG = "ObjectFile";
+
+uint32_t getContentHeaderCrc(const ContentHeaderV2& header) {
+    return crc32(&header, offsetof(ContentHeaderV2, crc));
+}
+
+uint32_t getBlockCrc(const BlockHeader& header, const void* records, size_t recordsSize) {
+    BlockHeader header_copy = header;
+    header_copy.crc = 0;
+    auto crc = crc32(&header_copy, sizeof(BlockHeader));
+    return crc32(records, recordsSize, crc);
+}
+
+uint32_t getTrailerCrc(const Trailer& trailer) {
+    return crc32(&trailer, offsetof(Trailer, crc));
+}
+
+void readObjectFileIndex(const ObjectFileReadFunction& read, const ContentHeaderV2& header, ObjectFileIndex& index) {
+    index = ObjectFileIndex();
+
+    // Blocks of the commit that is being read: { block index, file offset }
+    std::vector<std::pair<uint32_t, uint32_t>> pending_blocks;
+    uint32_t offset = OBJECT_FILE_DATA_OFFSET;
+    uint32_t identifier;
+    while (read(offset, &identifier, sizeof(identifier))) {
+        if (identifier == OBJECT_FILE_BLOCK_IDENTIFIER) {
+            BlockHeader block;
+            if (
+                !read(offset, &block, sizeof(BlockHeader)) ||
+                block.sequence != index.sequence + 1 ||
+                block.recordCount == 0 ||
+                block.recordCount > header.recordsPerBlock
+            ) {
+                break;
+            }
+            pending_blocks.emplace_back(block.blockIndex, offset);
+            offset += sizeof(BlockHeader) + block.recordCount * header.recordSize;
+        } else if (identifier == OBJECT_FILE_TRAILER_IDENTIFIER) {
+            Trailer trailer;
+            if (
+                !read(offset, &trailer, sizeof(Trailer)) ||
+                trailer.crc != getTrailerCrc(trailer) ||
+                trailer.sequence != index.sequence + 1 ||
+                trailer.recordCount < index.recordCount ||
+                trailer.blockCount != (trailer.recordCount + header.recordsPerBlock - 1) / header.recordsPerBlock
+            ) {
+                break;
+            }
+
+            auto block_offsets = index.blockOffsets;
+            block_offsets.resize(trailer.blockCount, 0);
+            bool valid = true;
+            for (auto [block_index, block_offset] : pending_blocks) {
+                if (block_index >= trailer.blockCount) {
+                    valid = false;
+                    break;
+                }
+                block_offsets[block_index] = block_offset;
+            }
+            if (!valid || std::ranges::find(block_offsets, 0) != block_offsets.end()) {
+                break;
+            }
+
+            index.blockOffsets = std::move(block_offsets);
+            index.recordCount = trailer.recordCount;
+            index.deletedRecordCount = trailer.deletedRecordCount;
+            index.sequence = trailer.sequence;
+            offset += sizeof(Trailer);
+            index.endOffset = offset;
+            pending_blocks.clear();
+        } else {
+            break;
+        }
+    }
+
+    if (offset != index.endOffset) {
+        TT_LOG_W(TAG, "Ignoring uncommitted data at offset %lu", index.endOffset);
+    }
+}
+
+void recoverObjectFile(const std::string& filePath) {
+    auto temp_path = filePath + ".tmp";
+    if (!isFile(temp_path)) {
+        return;
+    }
+
+    if (!isFile(filePath)) {
+        // The original file was removed, so the new file was complete
+        TT_LOG_W(TAG, "Recovering %s from an interrupted compaction", filePath.c_str());
+        if (rename(temp_path.c_str(), filePath.c_str()) != 0) {
+            TT_LOG_E(TAG, "Failed to recover %s", filePath.c_str());
+        }
+    } else {
+        // The original file is intact, but the new file might not be
+        TT_LOG_W(TAG, "Removing %s from an interrupted compaction", temp_path.c_str());
+        ::remove(temp_path.c_str());
+    }
+}
+
+bool compactObjectFile(const std::string& filePath, uint32_t recordSize) {
+    ObjectFileReader reader(filePath, recordSize, false);
+    if (!reader.open()) {
+        return false;
+    }
+
+    auto temp_path = filePath + ".tmp";
+    ObjectFileWriter writer(temp_path, recordSize, reader.getRecordVersion(), false);
+    if (!writer.open()) {
+        return false;
+    }
+
+    auto record = std::make_unique<uint8_t[]>(recordSize);
+    while (reader.hasNext()) {
+        if (!reader.readNext(record.get()) || !writer.write(record.get())) {
+            TT_LOG_E(TAG, "Failed to compact %s", filePath.c_str());
+            writer.close();
+            ::remove(temp_path.c_str());
+            return false;
+        }
+    }
+
+    if (!writer.commit()) {
+        writer.close();
+        ::remove(temp_path.c_str());
+        return false;
+    }
+
+    TT_LOG_I(TAG, "Compacted %s: %lu records, %lu bytes freed", filePath.c_str(), writer.getRecordCount(), reader.getGarbageSize());
+    writer.close();
+    reader.close();
+
+    // Not all file systems can rename onto an existing file (e.g. FAT on ESP32): recoverObjectFile() handles an interruption in between
+    if (rename(temp_path.c_str(), filePath.c_str()) != 0) {
+        if (::remove(filePath.c_str()) != 0 || rename(temp_path.c_str(), filePath.c_str()) != 0) {
+            TT_LOG_E(TAG, "Failed to replace %s", filePath.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
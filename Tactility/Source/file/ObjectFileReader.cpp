@@ -1,15 +1,23 @@
 #include "Tactility/file/ObjectFile.h"
 #include "Tactility/file/ObjectFilePrivate.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <Tactility/Log.h>
 
+#ifndef ESP_PLATFORM
+#include <sys/mman.h>
+#endif
+
 namespace tt::file {
 
 constexpr auto* TAG = "ObjectFileReader";
 
 bool ObjectFileReader::open() {
-    auto opening_file = std::unique_ptr<FILE, FileCloser>(fopen(filePath.c_str(), "r"));
+    recoverObjectFile(filePath);
+
+    auto opening_file = std::unique_ptr<FILE, FileCloser>(fopen(filePath.c_str(), "rb"));
     if (opening_file == nullptr) {
         TT_LOG_E(TAG, "Failed to open file %s", filePath.c_str());
         return false;
@@ -26,53 +34,273 @@ bool ObjectFileReader::open() {
         return false;
     }
 
-    if (file_header.version != OBJECT_FILE_VERSION) {
-        TT_LOG_E(TAG, "Unknown version for %s: %lu", filePath.c_str(), file_header.identifier);
+    if (file_header.version == OBJECT_FILE_VERSION_1) {
+        ContentHeader content_header;
+        if (fread(&content_header, sizeof(ContentHeader), 1, opening_file.get()) != 1) {
+            TT_LOG_E(TAG, "Failed to read content header from %s", filePath.c_str());
+            return false;
+        }
+
+        if (recordSize != content_header.recordSize) {
+            TT_LOG_E(TAG, "Record size mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordSize, content_header.recordSize);
+            return false;
+        }
+
+        recordCount = content_header.recordCount;
+        recordVersion = content_header.recordVersion;
+        TT_LOG_D(TAG, "Content: version = %lu, size = %lu bytes, count = %lu", content_header.recordVersion, content_header.recordSize, content_header.recordCount);
+    } else if (file_header.version == OBJECT_FILE_VERSION) {
+        if (!openVersion2(opening_file.get())) {
+            return false;
+        }
+    } else {
+        TT_LOG_E(TAG, "Unknown version for %s: %lu", filePath.c_str(), file_header.version);
         return false;
     }
 
-    ContentHeader content_header;
-    if (fread(&content_header, sizeof(ContentHeader), 1, opening_file.get()) != 1) {
+    fileVersion = file_header.version;
+
+#ifndef ESP_PLATFORM
+    if (memoryMap) {
+        auto file_size = getSize(opening_file.get());
+        if (file_size > 0) {
+            auto* data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fileno(opening_file.get()), 0);
+            if (data != MAP_FAILED) {
+                mappedData = data;
+                mappedSize = file_size;
+            } else {
+                TT_LOG_W(TAG, "Failed to map %s: %s", filePath.c_str(), strerror(errno));
+            }
+        }
+    }
+#endif
+
+    if (fileVersion == OBJECT_FILE_VERSION_1) {
+        // The file position is after the header: at the first record
+        streamIndex = 0;
+        if (mappedData != nullptr && mappedSize < sizeof(FileHeader) + sizeof(ContentHeader) + (size_t)recordCount * recordSize) {
+            TT_LOG_E(TAG, "File %s is too short for %lu records", filePath.c_str(), recordCount);
+            unmap();
+            return false;
+        }
+    } else if (mappedData == nullptr) {
+        blockBuffer = std::make_unique<uint8_t[]>(sizeof(BlockHeader) + recordsPerBlock * recordSize);
+    }
+
+    file = std::move(opening_file);
+
+    TT_LOG_D(TAG, "File version: %lu", file_header.version);
+
+    return true;
+}
+
+bool ObjectFileReader::openVersion2(FILE* openingFile) {
+    ContentHeaderV2 content_header;
+    if (fread(&content_header, sizeof(ContentHeaderV2), 1, openingFile) != 1) {
         TT_LOG_E(TAG, "Failed to read content header from %s", filePath.c_str());
         return false;
     }
 
+    if (content_header.crc != getContentHeaderCrc(content_header)) {
+        TT_LOG_E(TAG, "Content header of %s is corrupt", filePath.c_str());
+        return false;
+    }
+
     if (recordSize != content_header.recordSize) {
         TT_LOG_E(TAG, "Record size mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordSize, content_header.recordSize);
         return false;
     }
 
-    recordCount = content_header.recordCount;
-    recordVersion = content_header.recordVersion;
+    if (content_header.recordsPerBlock == 0 || content_header.recordsPerBlock > OBJECT_FILE_MAX_RECORDS_PER_BLOCK) {
+        TT_LOG_E(TAG, "Invalid block size for %s: %lu", filePath.c_str(), content_header.recordsPerBlock);
+        return false;
+    }
 
-    file = std::move(opening_file);
+    ObjectFileIndex index;
+    readObjectFileIndex([openingFile](uint32_t offset, void* output, size_t size) {
+        return fseek(openingFile, offset, SEEK_SET) == 0 && fread(output, size, 1, openingFile) == 1;
+    }, content_header, index);
 
-    TT_LOG_D(TAG, "File version: %lu", file_header.version);
-    TT_LOG_D(TAG, "Content: version = %lu, size = %lu bytes, count = %lu", content_header.recordVersion, content_header.recordSize, content_header.recordCount);
+    recordVersion = content_header.recordVersion;
+    recordsPerBlock = content_header.recordsPerBlock;
+    recordCount = index.recordCount;
+    deletedRecordCount = index.deletedRecordCount;
+    blockOffsets = std::move(index.blockOffsets);
+    verifiedBlocks.assign(blockOffsets.size(), false);
 
+    uint32_t live_size = blockOffsets.size() * sizeof(BlockHeader) + (recordCount - deletedRecordCount) * recordSize + sizeof(Trailer);
+    uint32_t data_size = index.endOffset - OBJECT_FILE_DATA_OFFSET;
+    garbageSize = (data_size > live_size) ? (data_size - live_size) : 0;
+
+    TT_LOG_D(TAG, "Content: version = %lu, size = %lu bytes, count = %lu, deleted = %lu", recordVersion, recordSize, recordCount, deletedRecordCount);
     return true;
 }
 
+void ObjectFileReader::unmap() {
+#ifndef ESP_PLATFORM
+    if (mappedData != nullptr) {
+        munmap(mappedData, mappedSize);
+        mappedData = nullptr;
+        mappedSize = 0;
+    }
+#endif
+}
+
 void ObjectFileReader::close() {
+    unmap();
+
+    fileVersion = 0;
     recordCount = 0;
     recordVersion = 0;
+    deletedRecordCount = 0;
+    garbageSize = 0;
     recordsRead = 0;
+    nextIndex = 0;
+    blockOffsets.clear();
+    verifiedBlocks.clear();
+    blockBuffer = nullptr;
+    bufferedBlock = UINT32_MAX;
 
     file = nullptr;
 }
 
+uint32_t ObjectFileReader::getBlockRecordCount(uint32_t blockIndex) const {
+    return std::min(recordsPerBlock, recordCount - blockIndex * recordsPerBlock);
+}
+
+const uint8_t* ObjectFileReader::getBlock(uint32_t blockIndex) {
+    auto offset = blockOffsets[blockIndex];
+    auto record_count = getBlockRecordCount(blockIndex);
+    size_t block_size = sizeof(BlockHeader) + record_count * recordSize;
+
+    const uint8_t* block;
+    if (mappedData != nullptr) {
+        if (offset + block_size > mappedSize) {
+            return nullptr;
+        }
+        block = static_cast<const uint8_t*>(mappedData) + offset;
+    } else {
+        if (bufferedBlock != blockIndex) {
+            bufferedBlock = UINT32_MAX;
+            if (fseek(file.get(), offset, SEEK_SET) != 0 || fread(blockBuffer.get(), block_size, 1, file.get()) != 1) {
+                TT_LOG_E(TAG, "Failed to read block %lu from %s", blockIndex, filePath.c_str());
+                return nullptr;
+            }
+            bufferedBlock = blockIndex;
+        }
+        block = blockBuffer.get();
+    }
+
+    if (!verifiedBlocks[blockIndex]) {
+        BlockHeader header;
+        memcpy(&header, block, sizeof(BlockHeader));
+        if (
+            header.blockIndex != blockIndex ||
+            header.recordCount != record_count ||
+            header.crc != getBlockCrc(header, block + sizeof(BlockHeader), record_count * recordSize)
+        ) {
+            TT_LOG_E(TAG, "Block %lu of %s is corrupt", blockIndex, filePath.c_str());
+            return nullptr;
+        }
+        verifiedBlocks[blockIndex] = true;
+    }
+
+    return block;
+}
+
+const uint8_t* ObjectFileReader::getRecord(uint32_t index, bool& isDeleted) {
+    isDeleted = false;
+    if (fileVersion == OBJECT_FILE_VERSION_1) {
+        return static_cast<const uint8_t*>(mappedData) + sizeof(FileHeader) + sizeof(ContentHeader) + index * recordSize;
+    }
+
+    auto block_index = index / recordsPerBlock;
+    auto slot = index % recordsPerBlock;
+    auto* block = getBlock(block_index);
+    if (block == nullptr) {
+        return nullptr;
+    }
+
+    uint64_t tombstones;
+    memcpy(&tombstones, block + offsetof(BlockHeader, tombstones), sizeof(tombstones));
+    isDeleted = (tombstones & (1ULL << slot)) != 0;
+    return block + sizeof(BlockHeader) + slot * recordSize;
+}
+
+bool ObjectFileReader::read(uint32_t index, void* output) {
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "File not open");
+        return false;
+    }
+
+    if (index >= recordCount) {
+        return false;
+    }
+
+    // Version 1 without a memory map: read from the file
+    if (fileVersion == OBJECT_FILE_VERSION_1 && mappedData == nullptr) {
+        if (streamIndex != index) {
+            auto offset = sizeof(FileHeader) + sizeof(ContentHeader) + index * recordSize;
+            if (fseek(file.get(), offset, SEEK_SET) != 0) {
+                return false;
+            }
+        }
+        bool result = fread(output, recordSize, 1, file.get()) == 1;
+        streamIndex = result ? index + 1 : UINT32_MAX;
+        return result;
+    }
+
+    bool is_deleted;
+    auto* record = getRecord(index, is_deleted);
+    if (record == nullptr || is_deleted) {
+        return false;
+    }
+
+    memcpy(output, record, recordSize);
+    return true;
+}
+
+bool ObjectFileReader::isDeleted(uint32_t index) {
+    if (fileVersion != OBJECT_FILE_VERSION) {
+        return index >= recordCount;
+    }
+
+    bool is_deleted;
+    return index >= recordCount || getRecord(index, is_deleted) == nullptr || is_deleted;
+}
+
 bool ObjectFileReader::readNext(void* output) {
     if (file == nullptr) {
         TT_LOG_E(TAG, "File not open");
         return false;
     }
 
-    bool result = fread(output, recordSize, 1, file.get()) == 1;
-    if (result) {
-        recordsRead++;
+    if (fileVersion == OBJECT_FILE_VERSION_1) {
+        bool result = nextIndex < recordCount && read(nextIndex, output);
+        if (result) {
+            nextIndex++;
+            recordsRead++;
+        }
+        return result;
     }
 
-    return result;
+    // Skip deleted records
+    while (nextIndex < recordCount) {
+        bool is_deleted;
+        auto* record = getRecord(nextIndex, is_deleted);
+        if (record == nullptr) {
+            return false;
+        }
+
+        nextIndex++;
+        if (!is_deleted) {
+            memcpy(output, record, recordSize);
+            recordsRead++;
+            return true;
+        }
+    }
+
+    return false;
 }
 
-}
\ No newline at end of file
+}
@@ -1,4 +1,4 @@
-#include "../../Include/Tactility/file/ObjectFile.h"
+#include "Tactility/file/ObjectFile.h"
 #include "Tactility/file/ObjectFilePrivate.h"
 
 #include <cstring>
@@ -10,72 +10,148 @@ namespace tt::file {
 constexpr auto* TAG = "ObjectFileWriter";
 
 bool ObjectFileWriter::open() {
+    if (recordsPerBlock == 0 || recordsPerBlock > OBJECT_FILE_MAX_RECORDS_PER_BLOCK) {
+        TT_LOG_E(TAG, "Invalid block size for %s: %lu", filePath.c_str(), recordsPerBlock);
+        return false;
+    }
+
+    recoverObjectFile(filePath);
+
     bool edit_existing = append && access(filePath.c_str(), F_OK) == 0;
     if (append && !edit_existing) {
         TT_LOG_W(TAG, "access() to %s failed: %s", filePath.c_str(), strerror(errno));
     }
 
-    // Edit existing or create a new file
-    auto opening_file = std::unique_ptr<FILE, FileCloser>(std::fopen(filePath.c_str(), "wb"));
+    if (edit_existing) {
+        // Edit the existing file
+        auto opening_file = std::unique_ptr<FILE, FileCloser>(std::fopen(filePath.c_str(), "r+b"));
+        if (opening_file == nullptr) {
+            TT_LOG_E(TAG, "Failed to open file %s", filePath.c_str());
+            return false;
+        }
+
+        if (getSize(opening_file.get()) > 0) {
+            if (!openExisting(opening_file)) {
+                return false;
+            }
+            file = std::move(opening_file);
+            return true;
+        }
+    }
+
+    // Create a new file (or replace the existing one)
+    auto opening_file = std::unique_ptr<FILE, FileCloser>(std::fopen(filePath.c_str(), "w+b"));
     if (opening_file == nullptr) {
         TT_LOG_E(TAG, "Failed to open file %s", filePath.c_str());
         return false;
     }
 
-    auto file_size = getSize(opening_file.get());
-    if (file_size > 0 && edit_existing) {
+    FileHeader file_header;
+    if (fwrite(&file_header, sizeof(FileHeader), 1, opening_file.get()) != 1) {
+        TT_LOG_E(TAG, "Failed to write file header for %s", filePath.c_str());
+        return false;
+    }
 
-        // Read and parse file header
+    ContentHeaderV2 content_header = {
+        .recordVersion = recordVersion,
+        .recordSize = recordSize,
+        .recordsPerBlock = recordsPerBlock
+    };
+    content_header.crc = getContentHeaderCrc(content_header);
+    if (fwrite(&content_header, sizeof(ContentHeaderV2), 1, opening_file.get()) != 1) {
+        TT_LOG_E(TAG, "Failed to write content header for %s", filePath.c_str());
+        return false;
+    }
 
-        FileHeader file_header;
-        if (fread(&file_header, sizeof(FileHeader), 1, opening_file.get()) != 1) {
-            TT_LOG_E(TAG, "Failed to read file header from %s", filePath.c_str());
-            return false;
-        }
+    blockOffsets.clear();
+    changedBlocks.clear();
+    recordsWritten = 0;
+    deletedRecordCount = 0;
+    sequence = 0;
+    writeOffset = OBJECT_FILE_DATA_OFFSET;
+    // An empty file has a commit, so it is never mistaken for a corrupt one
+    hasChanges = true;
 
-        if (file_header.identifier != OBJECT_FILE_IDENTIFIER) {
-            TT_LOG_E(TAG, "Invalid file type for %s", filePath.c_str());
-            return false;
-        }
+    file = std::move(opening_file);
+    return true;
+}
 
-        if (file_header.version != OBJECT_FILE_VERSION) {
-            TT_LOG_E(TAG, "Unknown version for %s: %lu", filePath.c_str(), file_header.identifier);
-            return false;
-        }
+bool ObjectFileWriter::openExisting(std::unique_ptr<FILE, FileCloser>& openingFile) {
+    // Read and parse file header
 
-        // Read and parse content header
+    FileHeader file_header;
+    if (fread(&file_header, sizeof(FileHeader), 1, openingFile.get()) != 1) {
+        TT_LOG_E(TAG, "Failed to read file header from %s", filePath.c_str());
+        return false;
+    }
 
-        ContentHeader content_header;
-        if (fread(&content_header, sizeof(ContentHeader), 1, opening_file.get()) != 1) {
-            TT_LOG_E(TAG, "Failed to read content header from %s", filePath.c_str());
-            return false;
-        }
+    if (file_header.identifier != OBJECT_FILE_IDENTIFIER) {
+        TT_LOG_E(TAG, "Invalid file type for %s", filePath.c_str());
+        return false;
+    }
 
-        if (recordSize != content_header.recordSize) {
-            TT_LOG_E(TAG, "Record size mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordSize, content_header.recordSize);
+    if (file_header.version == OBJECT_FILE_VERSION_1) {
+        TT_LOG_I(TAG, "Converting %s to version %lu", filePath.c_str(), OBJECT_FILE_VERSION);
+        openingFile = nullptr;
+        if (!compactObjectFile(filePath, recordSize)) {
             return false;
         }
-
-        if (recordVersion != content_header.recordVersion) {
-            TT_LOG_E(TAG, "Version mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordVersion, content_header.recordVersion);
+        openingFile.reset(std::fopen(filePath.c_str(), "r+b"));
+        if (openingFile == nullptr || fread(&file_header, sizeof(FileHeader), 1, openingFile.get()) != 1) {
+            TT_LOG_E(TAG, "Failed to open converted file %s", filePath.c_str());
             return false;
         }
+    }
 
-        recordsWritten = content_header.recordCount;
-        fseek(opening_file.get(), 0, SEEK_END);
-    } else {
-        FileHeader file_header;
-        if (fwrite(&file_header, sizeof(FileHeader), 1, opening_file.get()) != 1) {
-            TT_LOG_E(TAG, "Failed to write file header for %s", filePath.c_str());
-            return false;
-        }
+    if (file_header.version != OBJECT_FILE_VERSION) {
+        TT_LOG_E(TAG, "Unknown version for %s: %lu", filePath.c_str(), file_header.version);
+        return false;
+    }
+
+    // Read and parse content header
+
+    ContentHeaderV2 content_header;
+    if (fread(&content_header, sizeof(ContentHeaderV2), 1, openingFile.get()) != 1) {
+        TT_LOG_E(TAG, "Failed to read content header from %s", filePath.c_str());
+        return false;
+    }
+
+    if (content_header.crc != getContentHeaderCrc(content_header)) {
+        TT_LOG_E(TAG, "Content header of %s is corrupt", filePath.c_str());
+        return false;
+    }
 
-        // Seek forward (skip ContentHeader that will be written later)
-        fseek(opening_file.get(), sizeof(ContentHeader), SEEK_CUR);
+    if (recordSize != content_header.recordSize) {
+        TT_LOG_E(TAG, "Record size mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordSize, content_header.recordSize);
+        return false;
     }
 
+    if (recordVersion != content_header.recordVersion) {
+        TT_LOG_E(TAG, "Version mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordVersion, content_header.recordVersion);
+        return false;
+    }
+
+    if (content_header.recordsPerBlock == 0 || content_header.recordsPerBlock > OBJECT_FILE_MAX_RECORDS_PER_BLOCK) {
+        TT_LOG_E(TAG, "Invalid block size for %s: %lu", filePath.c_str(), content_header.recordsPerBlock);
+        return false;
+    }
+
+    auto* opening_file = openingFile.get();
+    ObjectFileIndex index;
+    readObjectFileIndex([opening_file](uint32_t offset, void* output, size_t size) {
+        return fseek(opening_file, offset, SEEK_SET) == 0 && fread(output, size, 1, opening_file) == 1;
+    }, content_header, index);
+
+    recordsPerBlock = content_header.recordsPerBlock;
+    blockOffsets = std::move(index.blockOffsets);
+    changedBlocks.clear();
+    recordsWritten = index.recordCount;
+    deletedRecordCount = index.deletedRecordCount;
+    sequence = index.sequence;
+    // Uncommitted data after the last commit is overwritten
+    writeOffset = index.endOffset;
+    hasChanges = false;
 
-    file = std::move(opening_file);
     return true;
 }
 
@@ -85,40 +161,195 @@ void ObjectFileWriter::close() {
         return;
     }
 
-    if (fseek(file.get(), sizeof(FileHeader), SEEK_SET) != 0) {
-        TT_LOG_E(TAG, "File seek failed: %s", filePath.c_str());
-        return;
+    commit();
+
+    file = nullptr;
+}
+
+ObjectFileWriter::Block* ObjectFileWriter::getBlock(uint32_t blockIndex) {
+    auto iterator = changedBlocks.find(blockIndex);
+    if (iterator != changedBlocks.end()) {
+        return &iterator->second;
+    }
+
+    // Limit the memory usage: written blocks only become visible after a commit
+    if (changedBlocks.size() >= maxChangedBlocks) {
+        auto oldest = changedBlocks.begin();
+        if (!writeBlock(oldest->first, oldest->second)) {
+            return nullptr;
+        }
+        changedBlocks.erase(oldest);
+    }
+
+    Block block;
+    block.records = std::make_unique<uint8_t[]>(recordsPerBlock * recordSize);
+
+    // Load a block that was written before: it's replaced when it is written again
+    if (blockIndex < blockOffsets.size()) {
+        BlockHeader header;
+        if (
+            fseek(file.get(), blockOffsets[blockIndex], SEEK_SET) != 0 ||
+            fread(&header, sizeof(BlockHeader), 1, file.get()) != 1 ||
+            header.recordCount > recordsPerBlock ||
+            fread(block.records.get(), header.recordCount * recordSize, 1, file.get()) != 1 ||
+            header.crc != getBlockCrc(header, block.records.get(), header.recordCount * recordSize)
+        ) {
+            TT_LOG_E(TAG, "Failed to read block %lu from %s", blockIndex, filePath.c_str());
+            return nullptr;
+        }
+        block.tombstones = header.tombstones;
+        block.recordCount = header.recordCount;
     }
 
-    ContentHeader content_header = {
-        .recordVersion = this->recordVersion,
-        .recordSize = this->recordSize,
-        .recordCount = this->recordsWritten
+    auto result = changedBlocks.emplace(blockIndex, std::move(block));
+    return &result.first->second;
+}
+
+bool ObjectFileWriter::writeBlock(uint32_t blockIndex, const Block& block) {
+    BlockHeader header = {
+        .sequence = sequence + 1,
+        .blockIndex = blockIndex,
+        .tombstones = block.tombstones,
+        .recordCount = block.recordCount
     };
+    auto records_size = block.recordCount * recordSize;
+    header.crc = getBlockCrc(header, block.records.get(), records_size);
 
-    if (fwrite(&content_header, sizeof(ContentHeader), 1, file.get()) != 1) {
-        TT_LOG_E(TAG, "Failed to write content header to %s", filePath.c_str());
+    if (
+        fseek(file.get(), writeOffset, SEEK_SET) != 0 ||
+        fwrite(&header, sizeof(BlockHeader), 1, file.get()) != 1 ||
+        fwrite(block.records.get(), records_size, 1, file.get()) != 1
+    ) {
+        TT_LOG_E(TAG, "Failed to write block %lu to %s", blockIndex, filePath.c_str());
+        return false;
     }
 
-    file = nullptr;
+    if (blockIndex >= blockOffsets.size()) {
+        blockOffsets.resize(blockIndex + 1);
+    }
+    blockOffsets[blockIndex] = writeOffset;
+    writeOffset += sizeof(BlockHeader) + records_size;
+    return true;
 }
 
-bool ObjectFileWriter::write(void* data) {
+bool ObjectFileWriter::commit() {
     if (file == nullptr) {
         TT_LOG_E(TAG, "File not opened: %s", filePath.c_str());
         return false;
     }
 
-    if (fwrite(data, recordSize, 1, file.get()) != 1) {
-        TT_LOG_E(TAG, "Failed to write record to %s", filePath.c_str());
+    if (!hasChanges) {
+        return true;
+    }
+
+    for (const auto& [block_index, block] : changedBlocks) {
+        if (!writeBlock(block_index, block)) {
+            return false;
+        }
+    }
+    changedBlocks.clear();
+
+    // The blocks must be stored before the trailer, so a trailer is never valid without its blocks
+    if (fflush(file.get()) != 0 || fsync(fileno(file.get())) != 0) {
+        TT_LOG_E(TAG, "Failed to flush %s", filePath.c_str());
         return false;
     }
 
+    Trailer trailer = {
+        .sequence = sequence + 1,
+        .recordCount = recordsWritten,
+        .deletedRecordCount = deletedRecordCount,
+        .blockCount = static_cast<uint32_t>(blockOffsets.size())
+    };
+    trailer.crc = getTrailerCrc(trailer);
+
+    if (
+        fseek(file.get(), writeOffset, SEEK_SET) != 0 ||
+        fwrite(&trailer, sizeof(Trailer), 1, file.get()) != 1 ||
+        fflush(file.get()) != 0 ||
+        fsync(fileno(file.get())) != 0
+    ) {
+        TT_LOG_E(TAG, "Failed to write trailer to %s", filePath.c_str());
+        return false;
+    }
+
+    sequence++;
+    writeOffset += sizeof(Trailer);
+    hasChanges = false;
+    return true;
+}
+
+bool ObjectFileWriter::write(const void* data) {
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "File not opened: %s", filePath.c_str());
+        return false;
+    }
+
+    auto block_index = recordsWritten / recordsPerBlock;
+    auto* block = getBlock(block_index);
+    if (block == nullptr) {
+        return false;
+    }
+
+    memcpy(block->records.get() + block->recordCount * recordSize, data, recordSize);
+    block->recordCount++;
     recordsWritten++;
+    hasChanges = true;
+
+    // Write full blocks right away, so the memory usage doesn't depend on the amount of records
+    if (block->recordCount == recordsPerBlock) {
+        if (!writeBlock(block_index, *block)) {
+            block->recordCount--;
+            recordsWritten--;
+            return false;
+        }
+        changedBlocks.erase(block_index);
+    }
 
     return true;
 }
 
-// endregion Writer
+bool ObjectFileWriter::update(uint32_t index, const void* data) {
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "File not opened: %s", filePath.c_str());
+        return false;
+    }
+
+    if (index >= recordsWritten) {
+        return false;
+    }
+
+    auto* block = getBlock(index / recordsPerBlock);
+    auto slot = index % recordsPerBlock;
+    if (block == nullptr || (block->tombstones & (1ULL << slot)) != 0) {
+        return false;
+    }
+
+    memcpy(block->records.get() + slot * recordSize, data, recordSize);
+    hasChanges = true;
+    return true;
+}
 
-}
\ No newline at end of file
+bool ObjectFileWriter::remove(uint32_t index) {
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "File not opened: %s", filePath.c_str());
+        return false;
+    }
+
+    if (index >= recordsWritten) {
+        return false;
+    }
+
+    auto* block = getBlock(index / recordsPerBlock);
+    auto slot_mask = 1ULL << (index % recordsPerBlock);
+    if (block == nullptr || (block->tombstones & slot_mask) != 0) {
+        return false;
+    }
+
+    block->tombstones |= slot_mask;
+    deletedRecordCount++;
+    hasChanges = true;
+    return true;
+}
+
+}
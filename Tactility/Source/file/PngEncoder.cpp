@@ -0,0 +1,325 @@
+#include "Tactility/file/PngEncoder.h"
+
+#include <Tactility/Crc32.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace tt::file {
+
+struct HuffmanCode {
+    uint32_t bits;
+    uint32_t length;
+};
+
+constexpr uint8_t PNG_SIGNATURE[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+constexpr uint8_t PNG_COLOR_TYPE_RGB = 2;
+constexpr uint8_t PNG_FILTER_SUB = 1;
+constexpr uint8_t PNG_FILTER_UP = 2;
+constexpr size_t BYTES_PER_PIXEL = 3;
+
+constexpr uint32_t END_OF_BLOCK = 256;
+constexpr uint32_t MATCH_LENGTH_MIN = 3;
+constexpr uint32_t MATCH_LENGTH_MAX = 258;
+constexpr size_t DEFLATE_WINDOW_SIZE = 32768;
+
+/** Deflate writes Huffman codes starting with the most significant bit, while all other values start with the least significant bit */
+static constexpr uint32_t reverseBits(uint32_t value, uint32_t length) {
+    uint32_t result = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        result = (result << 1) | ((value >> i) & 1U);
+    }
+    return result;
+}
+
+/** The fixed Huffman codes for literals and lengths (RFC 1951, 3.2.6) */
+static constexpr std::array<HuffmanCode, 288> createLiteralCodes() {
+    std::array<HuffmanCode, 288> codes {};
+    for (uint32_t symbol = 0; symbol < codes.size(); symbol++) {
+        if (symbol < 144) {
+            codes[symbol] = { reverseBits(0x30 + symbol, 8), 8 };
+        } else if (symbol < 256) {
+            codes[symbol] = { reverseBits(0x190 + symbol - 144, 9), 9 };
+        } else if (symbol < 280) {
+            codes[symbol] = { reverseBits(symbol - 256, 7), 7 };
+        } else {
+            codes[symbol] = { reverseBits(0xC0 + symbol - 280, 8), 8 };
+        }
+    }
+    return codes;
+}
+
+static constexpr auto literalCodes = createLiteralCodes();
+
+/** For every match length: the length code followed by its extra bits */
+static constexpr std::array<HuffmanCode, MATCH_LENGTH_MAX + 1> createLengthCodes() {
+    constexpr uint32_t base_lengths[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    constexpr uint32_t extra_bits[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+    std::array<HuffmanCode, MATCH_LENGTH_MAX + 1> codes {};
+    for (uint32_t length = MATCH_LENGTH_MIN; length <= MATCH_LENGTH_MAX; length++) {
+        size_t index = std::size(base_lengths) - 1;
+        while (base_lengths[index] > length) {
+            index--;
+        }
+        const auto& code = literalCodes[257 + index];
+        codes[length] = { code.bits | ((length - base_lengths[index]) << code.length), code.length + extra_bits[index] };
+    }
+    return codes;
+}
+
+static constexpr auto lengthCodes = createLengthCodes();
+
+/** @return the fixed Huffman code for a distance, followed by its extra bits */
+static constexpr HuffmanCode getDistanceCode(uint32_t distance) {
+    constexpr uint32_t base_distances[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    constexpr uint32_t extra_bits[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    uint32_t index = std::size(base_distances) - 1;
+    while (base_distances[index] > distance) {
+        index--;
+    }
+    return { reverseBits(index, 5) | ((distance - base_distances[index]) << 5), 5 + extra_bits[index] };
+}
+
+constexpr auto BYTE_DISTANCE_CODE = getDistanceCode(1);
+constexpr auto PIXEL_DISTANCE_CODE = getDistanceCode(BYTES_PER_PIXEL);
+
+/** @return the amount of bytes (up to maxLength) that are the same */
+static uint32_t getMatchLength(const uint8_t* data, const uint8_t* source, uint32_t maxLength) {
+    uint32_t length = 0;
+    while (length < maxLength && data[length] == source[length]) {
+        length++;
+    }
+    return length;
+}
+
+static void writeUint32(uint8_t* target, uint32_t value) {
+    target[0] = static_cast<uint8_t>(value >> 24);
+    target[1] = static_cast<uint8_t>(value >> 16);
+    target[2] = static_cast<uint8_t>(value >> 8);
+    target[3] = static_cast<uint8_t>(value);
+}
+
+PngEncoder::PngEncoder(uint32_t width, uint32_t height, Writer writer) :
+    width(width),
+    height(height),
+    rowSize(static_cast<size_t>(width) * BYTES_PER_PIXEL),
+    writer(std::move(writer)),
+    previousRow(std::make_unique<uint8_t[]>(rowSize)),
+    subRow(std::make_unique<uint8_t[]>(rowSize + 1)),
+    upRow(std::make_unique<uint8_t[]>(rowSize + 1)),
+    previousFilteredRow(std::make_unique<uint8_t[]>(rowSize + 1)),
+    chunkBuffer(std::make_unique<uint8_t[]>(chunkCapacity))
+{
+    if (rowSize + 1 <= DEFLATE_WINDOW_SIZE) {
+        auto code = getDistanceCode(rowSize + 1);
+        rowDistanceBits = code.bits;
+        rowDistanceBitCount = code.length;
+    }
+
+    uint8_t header[13];
+    writeUint32(header, width);
+    writeUint32(header + 4, height);
+    header[8] = 8; // Bit depth
+    header[9] = PNG_COLOR_TYPE_RGB;
+    header[10] = 0; // Compression: deflate
+    header[11] = 0; // Filter method: adaptive
+    header[12] = 0; // Interlace: none
+
+    if (write(PNG_SIGNATURE, sizeof(PNG_SIGNATURE))) {
+        writeChunk("IHDR", header, sizeof(header));
+    }
+
+    // zlib header: deflate with a 32 KiB window, no dictionary, fastest compression
+    chunkBuffer[0] = 0x78;
+    chunkBuffer[1] = 0x01;
+    chunkSize = 2;
+    // A single block for all data: final block, fixed Huffman codes
+    writeBits(0b011, 3);
+}
+
+bool PngEncoder::write(const uint8_t* data, size_t size) {
+    if (!failed) {
+        if (writer(data, size)) {
+            bytesWritten += size;
+        } else {
+            failed = true;
+        }
+    }
+    return !failed;
+}
+
+bool PngEncoder::writeChunk(const char* type, const uint8_t* data, size_t size) {
+    uint8_t header[8];
+    writeUint32(header, size);
+    memcpy(header + 4, type, 4);
+    uint8_t footer[4];
+    auto crc = crc32(header + 4, 4);
+    crc = crc32(data, size, crc);
+    writeUint32(footer, crc);
+    return write(header, sizeof(header)) && (size == 0 || write(data, size)) && write(footer, sizeof(footer));
+}
+
+void PngEncoder::flushChunk() {
+    if (chunkSize > 0) {
+        writeChunk("IDAT", chunkBuffer.get(), chunkSize);
+        chunkSize = 0;
+    }
+}
+
+void PngEncoder::writeBits(uint32_t bits, uint32_t count) {
+    bitBuffer |= static_cast<uint64_t>(bits) << bitCount;
+    bitCount += count;
+    if (bitCount >= 32) {
+        if (chunkSize + 4 > chunkCapacity) {
+            flushChunk();
+        }
+        auto* target = chunkBuffer.get() + chunkSize;
+        target[0] = static_cast<uint8_t>(bitBuffer);
+        target[1] = static_cast<uint8_t>(bitBuffer >> 8);
+        target[2] = static_cast<uint8_t>(bitBuffer >> 16);
+        target[3] = static_cast<uint8_t>(bitBuffer >> 24);
+        chunkSize += 4;
+        bitBuffer >>= 32;
+        bitCount -= 32;
+    }
+}
+
+void PngEncoder::flushBits() {
+    while (bitCount > 0) {
+        if (chunkSize == chunkCapacity) {
+            flushChunk();
+        }
+        chunkBuffer[chunkSize++] = static_cast<uint8_t>(bitBuffer);
+        bitBuffer >>= 8;
+        bitCount = (bitCount > 8) ? bitCount - 8 : 0;
+    }
+    bitBuffer = 0;
+}
+
+void PngEncoder::compressRow(const uint8_t* filteredRow, const uint8_t* previousFiltered) {
+    const size_t size = rowSize + 1;
+    updateAdler(filteredRow, size);
+
+    size_t index = 0;
+    while (index < size) {
+        const auto* data = filteredRow + index;
+        const auto max_length = static_cast<uint32_t>(std::min<size_t>(MATCH_LENGTH_MAX, size - index));
+
+        // Shorter distances have shorter codes, so they win when the lengths are equal
+        uint32_t best_length = 0;
+        const HuffmanCode* best_distance = nullptr;
+        if (index >= 1) {
+            best_length = getMatchLength(data, data - 1, max_length);
+            best_distance = &BYTE_DISTANCE_CODE;
+        }
+        if (index >= BYTES_PER_PIXEL && best_length < max_length) {
+            auto length = getMatchLength(data, data - BYTES_PER_PIXEL, max_length);
+            if (length > best_length) {
+                best_length = length;
+                best_distance = &PIXEL_DISTANCE_CODE;
+            }
+        }
+        if (previousFiltered != nullptr && best_length < max_length) {
+            auto length = getMatchLength(data, previousFiltered + index, max_length);
+            if (length > best_length) {
+                best_length = length;
+                best_distance = nullptr;
+            }
+        }
+
+        if (best_length >= MATCH_LENGTH_MIN) {
+            const auto& length_code = lengthCodes[best_length];
+            writeBits(length_code.bits, length_code.length);
+            if (best_distance != nullptr) {
+                writeBits(best_distance->bits, best_distance->length);
+            } else {
+                writeBits(rowDistanceBits, rowDistanceBitCount);
+            }
+            index += best_length;
+        } else {
+            const auto& code = literalCodes[*data];
+            writeBits(code.bits, code.length);
+            index++;
+        }
+    }
+}
+
+void PngEncoder::updateAdler(const uint8_t* data, size_t size) {
+    constexpr uint32_t ADLER_MODULO = 65521;
+    // The largest amount of bytes before the sum can overflow
+    constexpr size_t ADLER_BLOCK_SIZE = 5552;
+
+    uint32_t a = adler & 0xFFFFU;
+    uint32_t b = adler >> 16;
+    while (size > 0) {
+        auto block_size = std::min(size, ADLER_BLOCK_SIZE);
+        size -= block_size;
+        while (block_size-- > 0) {
+            a += *data++;
+            b += a;
+        }
+        a %= ADLER_MODULO;
+        b %= ADLER_MODULO;
+    }
+    adler = (b << 16) | a;
+}
+
+bool PngEncoder::writeRow(const uint8_t* rgb) {
+    if (failed || rowsWritten >= height) {
+        return false;
+    }
+
+    // Filter with Sub and Up, and count the byte changes of both: fewer changes means longer matches
+    subRow[0] = PNG_FILTER_SUB;
+    upRow[0] = PNG_FILTER_UP;
+    auto* sub = subRow.get() + 1;
+    auto* up = upRow.get() + 1;
+    const auto* previous = previousRow.get();
+    uint32_t sub_changes = 0;
+    uint32_t up_changes = 0;
+    for (size_t i = 0; i < rowSize; i++) {
+        sub[i] = (i >= BYTES_PER_PIXEL) ? static_cast<uint8_t>(rgb[i] - rgb[i - BYTES_PER_PIXEL]) : rgb[i];
+        up[i] = static_cast<uint8_t>(rgb[i] - previous[i]);
+        if (i > 0) {
+            sub_changes += (sub[i] != sub[i - 1]);
+            up_changes += (up[i] != up[i - 1]);
+        }
+    }
+
+    // On the first row, Up is the same as no filter
+    auto& filtered = (up_changes <= sub_changes) ? upRow : subRow;
+    const bool can_match_previous_row = hasPreviousFilteredRow && rowDistanceBitCount > 0;
+    compressRow(filtered.get(), can_match_previous_row ? previousFilteredRow.get() : nullptr);
+
+    // The filtered row becomes the previous one, and the old previous row is re-used as a candidate buffer
+    filtered.swap(previousFilteredRow);
+    hasPreviousFilteredRow = true;
+    memcpy(previousRow.get(), rgb, rowSize);
+    rowsWritten++;
+    return !failed;
+}
+
+bool PngEncoder::finish() {
+    if (failed || rowsWritten != height) {
+        failed = true;
+        return false;
+    }
+
+    const auto& end_code = literalCodes[END_OF_BLOCK];
+    writeBits(end_code.bits, end_code.length);
+    flushBits();
+
+    if (chunkSize + 4 > chunkCapacity) {
+        flushChunk();
+    }
+    writeUint32(chunkBuffer.get() + chunkSize, adler);
+    chunkSize += 4;
+    flushChunk();
+
+    writeChunk("IEND", nullptr, 0);
+    return !failed;
+}
+
+} // namespace tt::file
@@ -0,0 +1,431 @@
+#include "Tactility/file/TarExtractor.h"
+
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <string_view>
+#include <sys/stat.h>
+
+namespace tt::file {
+
+constexpr auto* TAG = "TarExtractor";
+
+// Header field offsets and lengths (POSIX ustar)
+constexpr size_t NAME_OFFSET = 0;
+constexpr size_t NAME_LENGTH = 100;
+constexpr size_t MODE_OFFSET = 100;
+constexpr size_t MODE_LENGTH = 8;
+constexpr size_t SIZE_OFFSET = 124;
+constexpr size_t SIZE_LENGTH = 12;
+constexpr size_t CHECKSUM_OFFSET = 148;
+constexpr size_t CHECKSUM_LENGTH = 8;
+constexpr size_t TYPE_OFFSET = 156;
+constexpr size_t MAGIC_OFFSET = 257;
+constexpr size_t PREFIX_OFFSET = 345;
+constexpr size_t PREFIX_LENGTH = 155;
+
+/** Parse an octal number field, or a base-256 number (used by GNU tar for large sizes) */
+static bool parseNumber(const uint8_t* field, size_t length, uint64_t& output) {
+    output = 0;
+    if ((field[0] & 0x80U) != 0) {
+        output = field[0] & 0x7FU;
+        for (size_t i = 1; i < length; i++) {
+            output = (output << 8) | field[i];
+        }
+        return true;
+    }
+
+    size_t i = 0;
+    while (i < length && field[i] == ' ') {
+        i++;
+    }
+
+    bool has_digits = false;
+    for (; i < length && field[i] != '\0' && field[i] != ' '; i++) {
+        if (field[i] < '0' || field[i] > '7') {
+            return false;
+        }
+        output = (output << 3) | (field[i] - '0');
+        has_digits = true;
+    }
+    return has_digits;
+}
+
+static std::string readString(const uint8_t* field, size_t length) {
+    auto* characters = reinterpret_cast<const char*>(field);
+    return { characters, strnlen(characters, length) };
+}
+
+/** Remove "./" prefixes and trailing "/", and reject paths that could point outside the destination */
+static bool normalizePath(std::string& path) {
+    while (path.starts_with("./")) {
+        path.erase(0, 2);
+    }
+    while (path.ends_with('/')) {
+        path.pop_back();
+    }
+    if (path == ".") {
+        path.clear();
+    }
+
+    if (path.starts_with('/')) {
+        return false;
+    }
+
+    size_t segment_start = 0;
+    while (segment_start <= path.length()) {
+        auto segment_end = path.find('/', segment_start);
+        if (segment_end == std::string::npos) {
+            segment_end = path.length();
+        }
+        if (path.compare(segment_start, segment_end - segment_start, "..") == 0) {
+            return false;
+        }
+        segment_start = segment_end + 1;
+    }
+
+    return true;
+}
+
+static std::string getParentPath(const std::string& path) {
+    auto separator_index = path.rfind('/');
+    return (separator_index == std::string::npos) ? std::string() : path.substr(0, separator_index);
+}
+
+bool TarExtractor::fail() {
+    state = State::Error;
+    file = nullptr;
+    return false;
+}
+
+void TarExtractor::closeFile() {
+    file = nullptr;
+    // Note: chmod() does nothing on ESP-IDF
+    if (chmod(filePath.c_str(), fileMode) < 0) {
+        TT_LOG_W(TAG, "Failed to set mode of %s", filePath.c_str());
+    }
+    statistics.fileCount++;
+    state = (paddingRemaining > 0) ? State::Padding : State::Header;
+}
+
+bool TarExtractor::ensureDirectory(const std::string& relativePath) {
+    if (knownDirectories.contains(relativePath)) {
+        return true;
+    }
+
+    auto absolute_path = relativePath.empty() ? destinationPath : std::format("{}/{}", destinationPath, relativePath);
+    statistics.directoryLookupCount++;
+    if (!findOrCreateDirectory(absolute_path, 0777)) {
+        TT_LOG_E(TAG, "Can't find or create directory %s", absolute_path.c_str());
+        return false;
+    }
+
+    // The directory was created recursively, so its parents exist too
+    std::string path = relativePath;
+    while (knownDirectories.insert(path).second && !path.empty()) {
+        path = getParentPath(path);
+    }
+
+    return true;
+}
+
+bool TarExtractor::processPaxRecords() {
+    // Records are formatted as "<length> <key>=<value>\n", where the length includes the whole record
+    std::string_view records = extendedData;
+    while (!records.empty()) {
+        auto space_index = records.find(' ');
+        if (space_index == std::string_view::npos || space_index == 0) {
+            return false;
+        }
+
+        size_t length = 0;
+        for (size_t i = 0; i < space_index; i++) {
+            if (records[i] < '0' || records[i] > '9') {
+                return false;
+            }
+            length = (length * 10) + (records[i] - '0');
+            if (length > records.length()) {
+                return false;
+            }
+        }
+        if (length <= space_index + 1 || records[length - 1] != '\n') {
+            return false;
+        }
+
+        auto record = records.substr(space_index + 1, length - space_index - 2);
+        auto equals_index = record.find('=');
+        if (equals_index == std::string_view::npos) {
+            return false;
+        }
+        auto key = record.substr(0, equals_index);
+        auto value = record.substr(equals_index + 1);
+        if (key == "path") {
+            nextPath = value;
+        } else if (key == "size") {
+            uint64_t size = 0;
+            if (value.empty() || !std::ranges::all_of(value, [](auto character) { return character >= '0' && character <= '9'; })) {
+                return false;
+            }
+            for (auto character : value) {
+                size = (size * 10) + (character - '0');
+            }
+            nextSize = size;
+        }
+
+        records.remove_prefix(length);
+    }
+
+    return true;
+}
+
+bool TarExtractor::processExtendedData() {
+    if (extendedType == 'L') {
+        // GNU long name: the data is the path, usually including a null terminator
+        nextPath = readString(reinterpret_cast<const uint8_t*>(extendedData.data()), extendedData.size());
+    } else if (!processPaxRecords()) {
+        TT_LOG_E(TAG, "Invalid pax extended header");
+        return fail();
+    }
+
+    extendedData.clear();
+    state = (paddingRemaining > 0) ? State::Padding : State::Header;
+    return true;
+}
+
+bool TarExtractor::processHeader() {
+    if (std::ranges::all_of(header, [](auto value) { return value == 0; })) {
+        if (!nextPath.empty() || nextSize.has_value()) {
+            TT_LOG_E(TAG, "Extended header without entry");
+            return fail();
+        }
+        state = State::End;
+        return true;
+    }
+
+    uint64_t expected_checksum;
+    if (!parseNumber(header.data() + CHECKSUM_OFFSET, CHECKSUM_LENGTH, expected_checksum)) {
+        TT_LOG_E(TAG, "Invalid header");
+        return fail();
+    }
+
+    // The checksum is calculated as if the checksum field contains spaces
+    uint64_t checksum = ' ' * CHECKSUM_LENGTH;
+    for (size_t i = 0; i < blockSize; i++) {
+        if (i < CHECKSUM_OFFSET || i >= CHECKSUM_OFFSET + CHECKSUM_LENGTH) {
+            checksum += header[i];
+        }
+    }
+    if (checksum != expected_checksum) {
+        TT_LOG_E(TAG, "Header checksum mismatch");
+        return fail();
+    }
+
+    uint64_t size;
+    uint64_t mode;
+    if (!parseNumber(header.data() + SIZE_OFFSET, SIZE_LENGTH, size) ||
+        !parseNumber(header.data() + MODE_OFFSET, MODE_LENGTH, mode)) {
+        TT_LOG_E(TAG, "Invalid header");
+        return fail();
+    }
+
+    auto type = static_cast<char>(header[TYPE_OFFSET]);
+    paddingRemaining = (blockSize - (size % blockSize)) % blockSize;
+
+    if (type == 'L' || type == 'x') {
+        if (size > maxExtendedHeaderSize) {
+            TT_LOG_E(TAG, "Extended header too large (%llu bytes)", static_cast<unsigned long long>(size));
+            return fail();
+        }
+        extendedType = type;
+        extendedData.clear();
+        extendedData.reserve(size);
+        entryRemaining = size;
+        state = State::ExtendedData;
+        return (size > 0) ? true : processExtendedData();
+    }
+
+    std::string path;
+    if (!nextPath.empty()) {
+        path = std::move(nextPath);
+        nextPath.clear();
+    } else {
+        path = readString(header.data() + NAME_OFFSET, NAME_LENGTH);
+        // Both POSIX ("ustar\0") and GNU ("ustar ") archives can have a path prefix
+        if (memcmp(header.data() + MAGIC_OFFSET, "ustar", 5) == 0 && header[PREFIX_OFFSET] != '\0') {
+            path = std::format("{}/{}", readString(header.data() + PREFIX_OFFSET, PREFIX_LENGTH), path);
+        }
+    }
+
+    if (nextSize.has_value()) {
+        size = *nextSize;
+        nextSize.reset();
+        paddingRemaining = (blockSize - (size % blockSize)) % blockSize;
+    }
+
+    if (!normalizePath(path)) {
+        TT_LOG_E(TAG, "Path not allowed: %s", path.c_str());
+        return fail();
+    }
+
+    entryRemaining = size;
+    state = State::SkipData;
+
+    switch (type) {
+        case '0':
+        case '\0':
+        case '7': { // Contiguous file
+            if (path.empty()) {
+                TT_LOG_E(TAG, "File without name");
+                return fail();
+            }
+
+            if (!ensureDirectory(getParentPath(path))) {
+                return fail();
+            }
+
+            filePath = std::format("{}/{}", destinationPath, path);
+            fileMode = static_cast<uint32_t>(mode);
+            TT_LOG_I(TAG, "Extracting %s", path.c_str());
+            file = std::unique_ptr<FILE, FileCloser>(fopen(filePath.c_str(), "wb"));
+            if (file == nullptr) {
+                TT_LOG_E(TAG, "Failed to open %s", filePath.c_str());
+                return fail();
+            }
+            state = State::FileData;
+            break;
+        }
+        case '5':
+            statistics.directoryCount++;
+            if (!ensureDirectory(path)) {
+                return fail();
+            }
+            break;
+        case '1':
+            TT_LOG_E(TAG, "HARDLINK not supported");
+            break;
+        case '2':
+            TT_LOG_E(TAG, "SYMLINK not supported");
+            break;
+        case '3':
+            TT_LOG_E(TAG, "CHRDEV not supported");
+            break;
+        case '4':
+            TT_LOG_E(TAG, "BLKDEV not supported");
+            break;
+        case '6':
+            TT_LOG_E(TAG, "FIFO not supported");
+            break;
+        case 'K':
+            // GNU long link name: only relevant for the (unsupported) link that follows
+        case 'g':
+            // Global pax attributes (e.g. modification times) aren't needed for extraction
+            TT_LOG_W(TAG, "Skipping extended header");
+            break;
+        default:
+            TT_LOG_E(TAG, "Unknown entry type: %d", type);
+            return fail();
+    }
+
+    if (entryRemaining == 0) {
+        // Empty entries have no data blocks
+        if (state == State::FileData) {
+            closeFile();
+        } else {
+            state = State::Header;
+        }
+    }
+
+    return true;
+}
+
+bool TarExtractor::write(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        switch (state) {
+            case State::Header: {
+                auto length = std::min(blockSize - headerSize, size);
+                memcpy(header.data() + headerSize, data, length);
+                headerSize += length;
+                data += length;
+                size -= length;
+                if (headerSize == blockSize) {
+                    headerSize = 0;
+                    if (!processHeader()) {
+                        return false;
+                    }
+                }
+                break;
+            }
+            case State::FileData: {
+                auto length = static_cast<size_t>(std::min<uint64_t>(entryRemaining, size));
+                if (length > 0 && fwrite(data, 1, length, file.get()) != length) {
+                    TT_LOG_E(TAG, "Failed to write to %s", filePath.c_str());
+                    return fail();
+                }
+                data += length;
+                size -= length;
+                entryRemaining -= length;
+                statistics.bytesWritten += length;
+                if (entryRemaining == 0) {
+                    closeFile();
+                }
+                break;
+            }
+            case State::ExtendedData: {
+                auto length = static_cast<size_t>(std::min<uint64_t>(entryRemaining, size));
+                extendedData.append(reinterpret_cast<const char*>(data), length);
+                data += length;
+                size -= length;
+                entryRemaining -= length;
+                if (entryRemaining == 0 && !processExtendedData()) {
+                    return false;
+                }
+                break;
+            }
+            case State::SkipData: {
+                auto length = static_cast<size_t>(std::min<uint64_t>(entryRemaining, size));
+                data += length;
+                size -= length;
+                entryRemaining -= length;
+                if (entryRemaining == 0) {
+                    state = (paddingRemaining > 0) ? State::Padding : State::Header;
+                }
+                break;
+            }
+            case State::Padding: {
+                auto length = std::min(paddingRemaining, size);
+                data += length;
+                size -= length;
+                paddingRemaining -= length;
+                if (paddingRemaining == 0) {
+                    state = State::Header;
+                }
+                break;
+            }
+            case State::End:
+                // Ignore the second end-of-archive block and the record padding
+                return true;
+            case State::Error:
+                return false;
+        }
+    }
+
+    return state != State::Error;
+}
+
+bool TarExtractor::finish() {
+    // An extended header must be followed by the entry that it applies to
+    bool is_entry_complete = headerSize == 0 && nextPath.empty() && !nextSize.has_value();
+    if (state == State::End || (state == State::Header && is_entry_complete)) {
+        return true;
+    }
+
+    if (state != State::Error) {
+        TT_LOG_E(TAG, "Archive is truncated");
+        fail();
+    }
+    return false;
+}
+
+} // namespace tt::file
@@ -2,29 +2,61 @@
 
 #include <Tactility/Mutex.h>
 
+#include <atomic>
+
 namespace tt::hal {
 
-std::vector<std::shared_ptr<Device>> devices;
-Mutex mutex = Mutex(Mutex::Type::Recursive);
-static Device::Id nextId = 0;
+/** Serializes registry writers. Readers only load the snapshot. */
+static Mutex mutex = Mutex(Mutex::Type::Recursive);
+static std::atomic<std::shared_ptr<const DeviceSnapshot>> snapshot;
+static std::atomic<uint32_t> generation = 0;
+static std::atomic<Device::Id> nextId = 0;
 
 #define TAG "devices"
 
 Device::Device() : id(nextId++) {}
 
-template <std::ranges::range RangeType>
-auto toVector(RangeType&& range) {
-    auto view = range | std::views::common;
-    return std::vector(view.begin(), view.end());
+static std::shared_ptr<const DeviceSnapshot> loadSnapshot() {
+    static const auto empty_snapshot = std::make_shared<const DeviceSnapshot>();
+    auto result = snapshot.load(std::memory_order_acquire);
+    return (result != nullptr) ? result : empty_snapshot;
+}
+
+/** Build the indexed registry state for the specified device list. */
+static std::shared_ptr<const DeviceSnapshot> createSnapshot(std::vector<std::shared_ptr<Device>> devices, uint32_t newGeneration) {
+    auto result = std::make_shared<DeviceSnapshot>();
+    result->generation = newGeneration;
+    result->devicesById.reserve(devices.size());
+    for (auto& device : devices) {
+        result->devicesByType[static_cast<size_t>(device->getType())].push_back(device);
+        result->devicesById[device->getId()] = device;
+    }
+    result->devices = std::move(devices);
+    return result;
+}
+
+static void publishEvent(DeviceEvent::Action action, const std::shared_ptr<Device>& device, uint32_t eventGeneration) {
+    getDevicePubsub()->publish({
+        .action = action,
+        .id = device->getId(),
+        .type = device->getType(),
+        .generation = eventGeneration
+    });
 }
 
 void registerDevice(const std::shared_ptr<Device>& device) {
     auto scoped_mutex = mutex.asScopedLock();
     scoped_mutex.lock();
 
-    if (findDevice(device->getId()) == nullptr) {
+    auto current = loadSnapshot();
+    if (!current->devicesById.contains(device->getId())) {
+        auto devices = current->devices;
         devices.push_back(device);
+        auto new_generation = generation.load(std::memory_order_relaxed) + 1;
+        snapshot.store(createSnapshot(std::move(devices), new_generation), std::memory_order_release);
+        generation.store(new_generation, std::memory_order_release);
         TT_LOG_I(TAG, "Registered %s with id %lu", device->getName().c_str(), device->getId());
+        publishEvent(DeviceEvent::Action::Registered, device, new_generation);
     } else {
         TT_LOG_W(TAG, "Device %s with id %lu was already registered", device->getName().c_str(), device->getId());
     }
@@ -34,40 +66,45 @@ void deregisterDevice(const std::shared_ptr<Device>& device) {
     auto scoped_mutex = mutex.asScopedLock();
     scoped_mutex.lock();
 
+    auto current = loadSnapshot();
     auto id_to_remove = device->getId();
-    auto remove_iterator = std::remove_if(devices.begin(), devices.end(), [id_to_remove](const auto& device) {
-        return device->getId() == id_to_remove;
-    });
-    if (remove_iterator != devices.end()) {
+    if (current->devicesById.contains(id_to_remove)) {
         TT_LOG_I(TAG, "Deregistering %s with id %lu", device->getName().c_str(), device->getId());
-        devices.erase(remove_iterator);
+        std::vector<std::shared_ptr<Device>> devices;
+        devices.reserve(current->devices.size() - 1);
+        for (auto& registered_device : current->devices) {
+            if (registered_device->getId() != id_to_remove) {
+                devices.push_back(registered_device);
+            }
+        }
+        auto new_generation = generation.load(std::memory_order_relaxed) + 1;
+        snapshot.store(createSnapshot(std::move(devices), new_generation), std::memory_order_release);
+        generation.store(new_generation, std::memory_order_release);
+        publishEvent(DeviceEvent::Action::Deregistered, device, new_generation);
     } else {
         TT_LOG_W(TAG, "Deregistering %s with id %lu failed: not found", device->getName().c_str(), device->getId());
     }
 }
 
 std::vector<std::shared_ptr<Device>> findDevices(const std::function<bool(const std::shared_ptr<Device>&)>& filterFunction) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
-
-    auto devices_view = devices | std::views::filter([&filterFunction](auto& device) {
-        return filterFunction(device);
-    });
-    return toVector(devices_view);
+    auto current = loadSnapshot();
+    std::vector<std::shared_ptr<Device>> result;
+    for (auto& device : current->devices) {
+        if (filterFunction(device)) {
+            result.push_back(device);
+        }
+    }
+    return result;
 }
 
 std::shared_ptr<Device> _Nullable findDevice(const std::function<bool(const std::shared_ptr<Device>&)>& filterFunction) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
-
-    auto result_set = devices | std::views::filter([&filterFunction](auto& device) {
-         return filterFunction(device);
-    });
-    if (!result_set.empty()) {
-        return result_set.front();
-    } else {
-        return nullptr;
+    auto current = loadSnapshot();
+    for (auto& device : current->devices) {
+        if (filterFunction(device)) {
+            return device;
+        }
     }
+    return nullptr;
 }
 
 std::shared_ptr<Device> _Nullable findDevice(std::string name) {
@@ -77,28 +114,34 @@ std::shared_ptr<Device> _Nullable findDevice(std::string name) {
 }
 
 std::shared_ptr<Device> _Nullable findDevice(Device::Id id) {
-    return findDevice([id](auto& device){
-      return device->getId() == id;
-    });
+    auto current = loadSnapshot();
+    auto iterator = current->devicesById.find(id);
+    return (iterator != current->devicesById.end()) ? iterator->second : nullptr;
 }
 
 std::vector<std::shared_ptr<Device>> findDevices(Device::Type type) {
-    return findDevices([type](auto& device) {
-        return device->getType() == type;
-    });
+    return loadSnapshot()->getDevices(type);
 }
 
 std::vector<std::shared_ptr<Device>> getDevices() {
-    return devices;
+    return loadSnapshot()->devices;
+}
+
+std::shared_ptr<const DeviceSnapshot> getDeviceSnapshot() {
+    return loadSnapshot();
+}
+
+uint32_t getDeviceGeneration() {
+    return generation.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<PubSub<DeviceEvent>> getDevicePubsub() {
+    static auto pubsub = std::make_shared<PubSub<DeviceEvent>>();
+    return pubsub;
 }
 
 bool hasDevice(Device::Type type) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
-    auto result_set = devices | std::views::filter([&type](auto& device) {
-         return device->getType() == type;
-    });
-    return !result_set.empty();
+    return !loadSnapshot()->getDevices(type).empty();
 }
 
 }
@@ -1,6 +1,7 @@
 #include "Tactility/hal/gps/GpsDevice.h"
 #include "Tactility/hal/gps/GpsInit.h"
 #include "Tactility/hal/gps/Probe.h"
+#include "Tactility/hal/uart/LineReader.h"
 #include "Tactility/hal/uart/Uart.h"
 #include <cstring>
 #include <minmea.h>
@@ -11,8 +12,6 @@ constexpr uint32_t GPS_UART_BUFFER_SIZE = 256;
 constexpr const char* TAG = "GpsDevice";
 
 int32_t GpsDevice::threadMain() {
-    uint8_t buffer[GPS_UART_BUFFER_SIZE];
-
     auto uart = uart::open(configuration.uartName);
     if (uart == nullptr) {
         TT_LOG_E(TAG, "Failed to open UART %s", configuration.uartName);
@@ -50,52 +49,35 @@ int32_t GpsDevice::threadMain() {
 
     setState(State::On);
 
+    uart::LineReader line_reader(*uart, GPS_UART_BUFFER_SIZE);
+    std::string_view line;
+
     // Reference: https://gpsd.gitlab.io/gpsd/NMEA.html
     while (!isThreadInterrupted()) {
-        size_t bytes_read = uart->readUntil(reinterpret_cast<std::byte*>(buffer), GPS_UART_BUFFER_SIZE, '\n', 100 / portTICK_PERIOD_MS);
+        bool line_read = line_reader.readLine(line, 100 / portTICK_PERIOD_MS);
 
         // Thread might've been interrupted in the meanwhile
         if (isThreadInterrupted()) {
             break;
         }
 
-        if (bytes_read > 0U) {
-
-            TT_LOG_I(TAG, "[%ul] %s", bytes_read, buffer);
-
-            switch (minmea_sentence_id((char*)buffer, false)) {
-                case MINMEA_SENTENCE_RMC:
-                    minmea_sentence_rmc rmc_frame;
-                    if (minmea_parse_rmc(&rmc_frame, (char*)buffer)) {
-                        mutex.lock();
-                        for (auto& subscription : rmcSubscriptions) {
-                            (*subscription.onData)(getId(), rmc_frame);
-                        }
-                        mutex.unlock();
-                        TT_LOG_D(TAG, "RMC %f lat, %f lon, %f m/s", minmea_tocoord(&rmc_frame.latitude), minmea_tocoord(&rmc_frame.longitude), minmea_tofloat(&rmc_frame.speed));
-                    } else {
-                        TT_LOG_W(TAG, "RMC parse error: %s", buffer);
-                    }
-                    break;
-                case MINMEA_SENTENCE_GGA:
-                    minmea_sentence_gga gga_frame;
-                    if (minmea_parse_gga(&gga_frame, (char*)buffer)) {
-                        mutex.lock();
-                        for (auto& subscription : ggaSubscriptions) {
-                            (*subscription.onData)(getId(), gga_frame);
-                        }
-                        mutex.unlock();
-                        TT_LOG_D(TAG, "GGA %f lat, %f lon", minmea_tocoord(&gga_frame.latitude), minmea_tocoord(&gga_frame.longitude));
-                    } else {
-                        TT_LOG_W(TAG, "GGA parse error: %s", buffer);
-                    }
-                    break;
-                default:
-                    break;
-            }
+        if (line_read && !line.empty()) {
+            // The line is null-terminated inside the reader's buffer
+            const char* buffer = line.data();
+
+            TT_LOG_V(TAG, "[%u] %s", (unsigned int)line.size(), buffer);
+            parser.process(buffer);
         }
     }
 
+    const auto& statistics = parser.getStatistics();
+    TT_LOG_I(TAG, "Processed %lu sentences: %lu published, %lu skipped, %lu errors",
+        statistics.sentenceCount,
+        statistics.publishedCount,
+        statistics.skippedCount,
+        statistics.errorCount
+    );
+
     if (uart->isStarted() && !uart->stop()) {
         TT_LOG_W(TAG, "Failed to stop UART %s", configuration.uartName);
     }
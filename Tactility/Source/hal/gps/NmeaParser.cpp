@@ -0,0 +1,85 @@
+#include "Tactility/hal/gps/NmeaParser.h"
+
+#include <Tactility/Log.h>
+
+#include <cstring>
+
+namespace tt::hal::gps {
+
+constexpr auto* TAG = "NmeaParser";
+
+/**
+ * Read the sentence type from "$TTSSS," (T = talker, S = sentence) without validating the sentence.
+ * @return the sentence type or MINMEA_UNKNOWN
+ */
+static enum minmea_sentence_id peekSentenceId(const char* sentence) {
+    // Also stops at the null terminator for short lines
+    if (sentence[0] != '$' || sentence[1] == '\0' || sentence[2] == '\0' ||
+        sentence[3] == '\0' || sentence[4] == '\0' || sentence[5] == '\0' || sentence[6] != ',') {
+        return MINMEA_UNKNOWN;
+    }
+
+    const char* type = sentence + 3;
+    if (strncmp(type, "RMC", 3) == 0) {
+        return MINMEA_SENTENCE_RMC;
+    } else if (strncmp(type, "GGA", 3) == 0) {
+        return MINMEA_SENTENCE_GGA;
+    } else if (strncmp(type, "GSV", 3) == 0) {
+        return MINMEA_SENTENCE_GSV;
+    } else if (strncmp(type, "GSA", 3) == 0) {
+        return MINMEA_SENTENCE_GSA;
+    } else if (strncmp(type, "VTG", 3) == 0) {
+        return MINMEA_SENTENCE_VTG;
+    } else {
+        return MINMEA_UNKNOWN;
+    }
+}
+
+template<typename SentenceType>
+bool NmeaParser::decodeAndPublish(
+    const char* sentence,
+    PubSub<NmeaFrame<SentenceType>>& pubSub,
+    bool (*parse)(SentenceType*, const char*)
+) {
+    if (pubSub.getSubscriptionCount() == 0) {
+        statistics.skippedCount++;
+        return false;
+    }
+
+    NmeaFrame<SentenceType> frame = {
+        .deviceId = deviceId,
+        .talkerId = { sentence[1], sentence[2], '\0' },
+        .sentence = {}
+    };
+    if (!minmea_check(sentence, false) || !parse(&frame.sentence, sentence)) {
+        TT_LOG_W(TAG, "Parse error: %s", sentence);
+        statistics.errorCount++;
+        return false;
+    }
+
+    pubSub.publish(frame);
+    statistics.publishedCount++;
+    return true;
+}
+
+bool NmeaParser::process(const char* sentence) {
+    statistics.sentenceCount++;
+
+    switch (peekSentenceId(sentence)) {
+        case MINMEA_SENTENCE_RMC:
+            return decodeAndPublish(sentence, *rmcPubSub, minmea_parse_rmc);
+        case MINMEA_SENTENCE_GGA:
+            return decodeAndPublish(sentence, *ggaPubSub, minmea_parse_gga);
+        case MINMEA_SENTENCE_GSA:
+            return decodeAndPublish(sentence, *gsaPubSub, minmea_parse_gsa);
+        case MINMEA_SENTENCE_GSV:
+            return decodeAndPublish(sentence, *gsvPubSub, minmea_parse_gsv);
+        case MINMEA_SENTENCE_VTG:
+            return decodeAndPublish(sentence, *vtgPubSub, minmea_parse_vtg);
+        default:
+            statistics.skippedCount++;
+            return false;
+    }
+}
+
+} // namespace tt::hal::gps
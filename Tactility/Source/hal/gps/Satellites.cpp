@@ -1,6 +1,9 @@
 #include "Tactility/hal/gps/Satellites.h"
 
-#include <algorithm>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Log.h>
+
+#include <cstring>
 
 #define TAG "satellites"
 
@@ -10,105 +13,176 @@ constexpr inline bool hasTimeElapsed(TickType_t now, TickType_t timeInThePast, T
     return (TickType_t)(now - timeInThePast) >= expireTimeInTicks;
 }
 
-SatelliteStorage::SatelliteRecord* SatelliteStorage::findRecord(int number) {
-    auto result = records | std::views::filter([number](auto& record) {
-        return record.inUse && record.data.nr == number;
-    });
-
-    if (!result.empty()) {
-        return &result.front();
+Constellation toConstellation(const char* talkerId) {
+    if (strncmp(talkerId, "GP", 2) == 0) {
+        return Constellation::Gps;
+    } else if (strncmp(talkerId, "GL", 2) == 0) {
+        return Constellation::Glonass;
+    } else if (strncmp(talkerId, "GA", 2) == 0) {
+        return Constellation::Galileo;
+    } else if (strncmp(talkerId, "GB", 2) == 0 || strncmp(talkerId, "BD", 2) == 0) {
+        return Constellation::BeiDou;
+    } else if (strncmp(talkerId, "GQ", 2) == 0 || strncmp(talkerId, "QZ", 2) == 0) {
+        return Constellation::Qzss;
+    } else if (strncmp(talkerId, "GI", 2) == 0) {
+        return Constellation::Navic;
     } else {
-        return nullptr;
+        return Constellation::Unknown;
     }
 }
 
-SatelliteStorage::SatelliteRecord* SatelliteStorage::findUnusedRecord() {
-    auto lock = mutex.asScopedLock();
-    lock.lock();
-
-    auto result = records | std::views::filter([](auto& record) {
-        return !record.inUse;
-    });
-
-    if (!result.empty()) {
-        auto* record = &result.front();
-        record->inUse = true;
-        TT_LOG_D(TAG, "Found unused record");
-        return record;
-    } else {
-        return nullptr;
+SatelliteStorage::SatelliteStorage(uint16_t recentTimeSeconds) : recentTimeSeconds(recentTimeSeconds) {
+    slots.fill(noIndex);
+    // All records start in the free list
+    for (uint8_t i = 0; i < recordCount; ++i) {
+        records[i].next = (i + 1 < recordCount) ? (i + 1) : noIndex;
     }
 }
 
-SatelliteStorage::SatelliteRecord* SatelliteStorage::findRecordToRecycle() {
-    auto lock = mutex.asScopedLock();
-    lock.lock();
+size_t SatelliteStorage::findSlot(uint32_t key) const {
+    constexpr size_t mask = slotCount - 1;
+    size_t slot = toSlot(key);
+    while (slots[slot] != noIndex && getKey(slots[slot]) != key) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
 
-    int candidate_index = -1;
-    auto candidate_age = portMAX_DELAY;
-    TickType_t expire_duration = kernel::secondsToTicks(recycleTimeSeconds);
-    TickType_t now = kernel::getTicks();
-    for (int i = 0; i < records.size(); ++i) {
-        // First try to find a record that is "old enough"
-        if (hasTimeElapsed(now, records[i].lastUpdated, expire_duration)) {
-            TT_LOG_D(TAG, "! [%d] %lu < %lu", i, records[i].lastUpdated, expire_duration);
-            candidate_index = i;
+void SatelliteStorage::removeFromSlots(uint8_t recordIndex) {
+    constexpr size_t mask = slotCount - 1;
+    size_t empty_slot = findSlot(getKey(recordIndex));
+    assert(slots[empty_slot] == recordIndex);
+    slots[empty_slot] = noIndex;
+
+    // Backward-shift deletion: move later entries of the probe sequence into the gap, so lookups never stop early
+    size_t slot = empty_slot;
+    while (true) {
+        slot = (slot + 1) & mask;
+        if (slots[slot] == noIndex) {
             break;
         }
-
-        // Otherwise keep finding the oldest record
-        if (records[i].inUse && records[i].lastUpdated < candidate_age) {
-            candidate_index = i;
-            candidate_age = records[i].lastUpdated;
-            TT_LOG_D(TAG, "? [%d] %lu < %lu", i, records[i].lastUpdated, candidate_age);
+        size_t home_slot = toSlot(getKey(slots[slot]));
+        // Distance from the home slot to both positions, taking wrap-around into account
+        if (((slot - home_slot) & mask) >= ((slot - empty_slot) & mask)) {
+            slots[empty_slot] = slots[slot];
+            slots[slot] = noIndex;
+            empty_slot = slot;
         }
     }
+}
+
+void SatelliteStorage::unlink(uint8_t recordIndex) {
+    auto& record = records[recordIndex];
+    if (record.previous != noIndex) {
+        records[record.previous].next = record.next;
+    } else {
+        newestIndex = record.next;
+    }
+    if (record.next != noIndex) {
+        records[record.next].previous = record.previous;
+    } else {
+        oldestIndex = record.previous;
+    }
+    record.previous = noIndex;
+    record.next = noIndex;
+}
 
-    assert(candidate_index != -1);
+void SatelliteStorage::linkAsNewest(uint8_t recordIndex) {
+    auto& record = records[recordIndex];
+    record.previous = noIndex;
+    record.next = newestIndex;
+    if (newestIndex != noIndex) {
+        records[newestIndex].previous = recordIndex;
+    }
+    newestIndex = recordIndex;
+    if (oldestIndex == noIndex) {
+        oldestIndex = recordIndex;
+    }
+}
 
-    TT_LOG_D(TAG, "Recycled record %d", candidate_index);
+void SatelliteStorage::update(Constellation constellation, const minmea_sat_info& info, TickType_t now) {
+    auto key = toKey(constellation, info.nr);
+    auto slot = findSlot(key);
+    uint8_t record_index;
+    if (slots[slot] != noIndex) {
+        record_index = slots[slot];
+        unlink(record_index);
+    } else {
+        if (freeIndex != noIndex) {
+            record_index = freeIndex;
+            freeIndex = records[record_index].next;
+            TT_LOG_D(TAG, "Found unused record");
+        } else {
+            record_index = oldestIndex;
+            unlink(record_index);
+            removeFromSlots(record_index);
+            // Removal might have shifted entries of this key's probe sequence
+            slot = findSlot(key);
+            TT_LOG_D(TAG, "Recycled record %d", record_index);
+        }
+        records[record_index].satellite.constellation = constellation;
+        records[record_index].satellite.info.nr = info.nr;
+        slots[slot] = record_index;
+    }
 
-    return &records[candidate_index];
+    auto& satellite = records[record_index].satellite;
+    satellite.info = info;
+    satellite.lastUpdated = now;
+    linkAsNewest(record_index);
+    TT_LOG_D(TAG, "Updated satellite %d: elevation %d, azimuth %d, snr %d", info.nr, info.elevation, info.azimuth, info.snr);
 }
 
-SatelliteStorage::SatelliteRecord* SatelliteStorage::findWithFallback(int number) {
+void SatelliteStorage::notify(Constellation constellation, const minmea_sat_info& info) {
     auto lock = mutex.asScopedLock();
     lock.lock();
+    update(constellation, info, kernel::getTicks());
+}
 
-    if (auto* found_record = findRecord(number)) {
-        return found_record;
-    } else if (auto* unused_record = findUnusedRecord()) {
-        return unused_record;
-    } else {
-        return findRecordToRecycle();
+void SatelliteStorage::notify(Constellation constellation, const minmea_sentence_gsv& gsv) {
+    TickType_t now = kernel::getTicks();
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    for (const auto& info : gsv.sats) {
+        // Unused entries of the last sentence in a GSV sequence are zeroed
+        if (info.nr != 0) {
+            update(constellation, info, now);
+        }
     }
 }
 
-void SatelliteStorage::notify(const minmea_sat_info& data) {
+void SatelliteStorage::getRecords(const std::function<void(const minmea_sat_info&)>& onRecord) const {
     auto lock = mutex.asScopedLock();
     lock.lock();
 
-    auto* record = findWithFallback(data.nr);
-    if (record != nullptr) {
-        record->inUse = true;
-        record->lastUpdated = kernel::getTicks();
-        record->data = data;
-        TT_LOG_D(TAG, "Updated satellite %d: elevation %d, azimuth %d, snr %d", record->data.nr, record->data.elevation, record->data.elevation, record->data.snr);
+    TickType_t expire_duration = kernel::secondsToTicks(recentTimeSeconds);
+    TickType_t now = kernel::getTicks();
+
+    // The list is ordered from new to old, so we can stop at the first expired record
+    for (auto index = newestIndex; index != noIndex; index = records[index].next) {
+        const auto& satellite = records[index].satellite;
+        if (hasTimeElapsed(now, satellite.lastUpdated, expire_duration)) {
+            break;
+        }
+        onRecord(satellite.info);
     }
 }
 
-void SatelliteStorage::getRecords(const std::function<void(const minmea_sat_info&)>& onRecord) const {
+size_t SatelliteStorage::getSnapshot(std::span<Satellite> output) const {
     auto lock = mutex.asScopedLock();
     lock.lock();
 
     TickType_t expire_duration = kernel::secondsToTicks(recentTimeSeconds);
     TickType_t now = kernel::getTicks();
 
-    for (auto& record: records) {
-        if (record.inUse && !hasTimeElapsed(now, record.lastUpdated, expire_duration)) {
-            onRecord(record.data);
+    size_t count = 0;
+    for (auto index = newestIndex; index != noIndex && count < output.size(); index = records[index].next) {
+        const auto& satellite = records[index].satellite;
+        if (hasTimeElapsed(now, satellite.lastUpdated, expire_duration)) {
+            break;
         }
+        output[count++] = satellite;
     }
+    return count;
 }
 
 } // namespace tt::hal::gps
@@ -0,0 +1,91 @@
+#include <Tactility/hal/power/SimulatedPowerDevice.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace tt::hal::power {
+
+constexpr uint32_t BATTERY_VOLTAGE_MIN = 3200;
+constexpr uint32_t BATTERY_VOLTAGE_MAX = 4200;
+
+uint32_t SimulatedPowerDevice::measureBatteryVoltage() {
+    // Called while holding the mutex
+    if (configuration.noise == 0) {
+        return configuration.batteryVoltage;
+    }
+
+    // xorshift32
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    auto range = configuration.noise * 2 + 1;
+    auto offset = static_cast<int32_t>(noiseState % range) - static_cast<int32_t>(configuration.noise);
+    return static_cast<uint32_t>(std::max<int32_t>(0, static_cast<int32_t>(configuration.batteryVoltage) + offset));
+}
+
+bool SimulatedPowerDevice::supportsMetric(MetricType type) const {
+    switch (type) {
+        using enum MetricType;
+        case IsCharging:
+        case Current:
+        case BatteryVoltage:
+        case ChargeLevel:
+            return true;
+    }
+
+    return false; // Safety guard for when new enum values are introduced
+}
+
+bool SimulatedPowerDevice::getMetric(MetricType type, MetricData& data) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    measurementCount++;
+
+    const bool is_charging = configuration.isExternalPowerConnected && allowedToCharge;
+    switch (type) {
+        using enum MetricType;
+        case IsCharging:
+            data.valueAsBool = is_charging;
+            return true;
+        case Current:
+            data.valueAsInt32 = is_charging ? std::abs(configuration.current) : -std::abs(configuration.current);
+            return true;
+        case BatteryVoltage:
+            data.valueAsUint32 = measureBatteryVoltage();
+            return true;
+        case ChargeLevel: {
+            // A linear estimate, like the ADC-based drivers
+            auto voltage = std::clamp(measureBatteryVoltage(), BATTERY_VOLTAGE_MIN, BATTERY_VOLTAGE_MAX);
+            data.valueAsUint8 = static_cast<uint8_t>((voltage - BATTERY_VOLTAGE_MIN) * 100 / (BATTERY_VOLTAGE_MAX - BATTERY_VOLTAGE_MIN));
+            return true;
+        }
+    }
+
+    return false; // Safety guard for when new enum values are introduced
+}
+
+bool SimulatedPowerDevice::isAllowedToCharge() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return allowedToCharge;
+}
+
+void SimulatedPowerDevice::setAllowedToCharge(bool canCharge) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    allowedToCharge = canCharge;
+}
+
+void SimulatedPowerDevice::setBatteryVoltage(uint32_t milliVolt) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    configuration.batteryVoltage = milliVolt;
+}
+
+void SimulatedPowerDevice::setExternalPowerConnected(bool connected) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    configuration.isExternalPowerConnected = connected;
+}
+
+} // namespace tt::hal::power
@@ -1,26 +1,38 @@
 #include "Tactility/hal/Device.h"
 #include "Tactility/hal/sdcard/SdCardDevice.h"
 
+#include <Tactility/file/MountTable.h>
+
 namespace tt::hal::sdcard {
 
+void SdCardDevice::onMounted(const std::string& mountPath) {
+    file::addMount({
+        .path = mountPath,
+        .lock = getLock(),
+        .deviceId = getId()
+    });
+}
+
+void SdCardDevice::onUnmounted(const std::string& mountPath) {
+    file::removeMount(mountPath);
+}
+
 std::shared_ptr<SdCardDevice> _Nullable find(const std::string& path) {
-    auto sdcards = findDevices<SdCardDevice>(Device::Type::SdCard);
-    for (auto& sdcard : sdcards) {
-        if (sdcard->isMounted() && path.starts_with(sdcard->getMountPath())) {
-            return sdcard;
-        }
+    file::Mount mount;
+    if (!file::findMount(path, mount)) {
+        return nullptr;
     }
 
-    return nullptr;
+    auto device = findDevice(mount.deviceId);
+    if (device == nullptr || device->getType() != Device::Type::SdCard) {
+        return nullptr;
+    }
+
+    return std::static_pointer_cast<SdCardDevice>(device);
 }
 
 std::shared_ptr<Lock> findSdCardLock(const std::string& path) {
-    auto sdcard = find(path);
-    if (sdcard != nullptr) {
-        return sdcard->getLock();
-    }
-
-    return nullptr;
+    return file::findMountLock(path);
 }
 
 }
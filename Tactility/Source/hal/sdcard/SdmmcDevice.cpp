@@ -64,6 +64,7 @@ bool SdmmcDevice::mount(const std::string& newMountPath) {
     if (mountInternal(newMountPath)) {
         TT_LOG_I(TAG, "Mounted at %s", newMountPath.c_str());
         sdmmc_card_print_info(stdout, card);
+        onMounted(newMountPath);
         return true;
     } else {
         TT_LOG_E(TAG, "Mount failed for %s", newMountPath.c_str());
@@ -86,6 +87,7 @@ bool SdmmcDevice::unmount() {
     }
 
     TT_LOG_I(TAG, "Unmounted %s", mountPath.c_str());
+    onUnmounted(mountPath);
     mountPath = "";
     card = nullptr;
     return true;
@@ -95,6 +95,7 @@ bool SpiSdCardDevice::mount(const std::string& newMountPath) {
     if (mountInternal(newMountPath)) {
         TT_LOG_I(TAG, "Mounted at %s", newMountPath.c_str());
         sdmmc_card_print_info(stdout, card);
+        onMounted(newMountPath);
         return true;
     } else {
         TT_LOG_E(TAG, "Mount failed for %s", newMountPath.c_str());
@@ -117,6 +118,7 @@ bool SpiSdCardDevice::unmount() {
     }
 
     TT_LOG_I(TAG, "Unmounted %s", mountPath.c_str());
+    onUnmounted(mountPath);
     mountPath = "";
     card = nullptr;
     return true;
@@ -0,0 +1,120 @@
+#include "Tactility/hal/uart/LineReader.h"
+
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tt::hal::uart {
+
+constexpr auto* TAG = "LineReader";
+
+LineReader::LineReader(Uart& uart, size_t bufferSize, uint8_t delimiter) :
+    uart(uart),
+    delimiter(delimiter),
+    bufferSize(bufferSize),
+    buffer(std::make_unique<char[]>(bufferSize))
+{}
+
+void LineReader::compact() {
+    if (start > 0) {
+        auto length = end - start;
+        if (length > 0) {
+            memmove(buffer.get(), buffer.get() + start, length);
+        }
+        scanned -= start;
+        end = length;
+        start = 0;
+    }
+}
+
+bool LineReader::fill(TickType_t timeout) {
+    if (end == bufferSize) {
+        compact();
+    }
+
+    auto space = bufferSize - end;
+    if (space == 0) {
+        return false;
+    }
+
+    // Read everything that's already there in 1 call, or block for the first byte to arrive
+    auto pending = uart.available(0);
+    auto to_read = (pending > 0) ? std::min(pending, space) : 1U;
+    auto bytes_read = uart.readBytes(reinterpret_cast<std::byte*>(buffer.get() + end), to_read, timeout);
+    statistics.readCount++;
+    if (bytes_read == 0) {
+        return false;
+    }
+
+    end += bytes_read;
+    statistics.bytesRead += bytes_read;
+
+    // When we had to wait for the first byte, the rest of the data might have arrived in the meantime
+    if (pending == 0 && end < bufferSize) {
+        pending = uart.available(0);
+        if (pending > 0) {
+            bytes_read = uart.readBytes(reinterpret_cast<std::byte*>(buffer.get() + end), std::min(pending, bufferSize - end), 0);
+            statistics.readCount++;
+            end += bytes_read;
+            statistics.bytesRead += bytes_read;
+        }
+    }
+
+    return true;
+}
+
+bool LineReader::readLine(std::string_view& line, TickType_t timeout) {
+    TickType_t start_time = kernel::getTicks();
+    while (true) {
+        auto* found = static_cast<char*>(memchr(buffer.get() + scanned, delimiter, end - scanned));
+        if (found != nullptr) {
+            auto delimiter_index = static_cast<size_t>(found - buffer.get());
+            auto line_start = start;
+            start = delimiter_index + 1;
+            scanned = start;
+            if (discarding) {
+                // This was the tail of a line that overflowed
+                discarding = false;
+                continue;
+            }
+
+            *found = '\0';
+            line = std::string_view(buffer.get() + line_start, delimiter_index - line_start);
+            statistics.lineCount++;
+            return true;
+        }
+
+        scanned = end;
+
+        // Line doesn't fit in the buffer: drop it and skip until the next delimiter
+        if (start == 0 && end == bufferSize) {
+            if (!discarding) {
+                TT_LOG_W(TAG, "Line exceeds %d bytes: discarded", (int)bufferSize);
+                statistics.overflowCount++;
+                discarding = true;
+            }
+            start = end = scanned = 0;
+        } else if (start == end) {
+            // Nothing buffered: start at the beginning to have maximum space
+            start = end = scanned = 0;
+        }
+
+        TickType_t elapsed = kernel::getTicks() - start_time;
+        if (elapsed > timeout) {
+            return false;
+        }
+
+        if (!fill(timeout - elapsed)) {
+            return false;
+        }
+    }
+}
+
+void LineReader::reset() {
+    start = end = scanned = 0;
+    discarding = false;
+}
+
+} // namespace tt::hal::uart
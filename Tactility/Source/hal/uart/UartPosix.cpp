@@ -6,6 +6,7 @@
 #include <Tactility/Log.h>
 
 #include <cstring>
+#include <poll.h>
 #include <sstream>
 #include <sys/ioctl.h>
 #include <unistd.h>
@@ -23,7 +24,8 @@ bool UartPosix::start() {
         return false;
     }
 
-    auto file = fopen(configuration.name.c_str(), "w");
+    // Read and write access: "w" would make every read fail
+    auto file = fopen(configuration.name.c_str(), "r+");
     if (file == nullptr) {
         TT_LOG_E(TAG, "[%s] Open device failed", configuration.name.c_str());
         return false;
@@ -99,7 +101,8 @@ size_t UartPosix::readBytes(std::byte* buffer, size_t bufferSize, TickType_t tim
     }
 
     if (awaitAvailable(timeout)) {
-        return read(fileno(device.get()), buffer, bufferSize);
+        auto bytes_read = read(fileno(device.get()), buffer, bufferSize);
+        return (bytes_read > 0) ? static_cast<size_t>(bytes_read) : 0U;
     } else {
         return 0;
     }
@@ -114,7 +117,8 @@ bool UartPosix::readByte(std::byte* output, TickType_t timeout) {
 }
 
 size_t UartPosix::writeBytes(const std::byte* buffer, size_t bufferSize, TickType_t timeout) {
-    if (!mutex.lock(timeout)) {
+    auto lock = mutex.asScopedLock();
+    if (!lock.lock(timeout)) {
         return false;
     }
 
@@ -127,9 +131,11 @@ size_t UartPosix::available(TickType_t timeout) {
         return false;
     }
 
-    uint32_t bytes_available = 0;
-    ioctl(fileno(device.get()), FIONREAD, bytes_available);
-    return bytes_available;
+    int bytes_available = 0;
+    if (ioctl(fileno(device.get()), FIONREAD, &bytes_available) != 0) {
+        return 0;
+    }
+    return static_cast<size_t>(bytes_available);
 }
 
 void UartPosix::flushInput() {
@@ -172,14 +178,23 @@ bool UartPosix::setBaudRate(uint32_t baudRate, TickType_t timeout) {
 }
 
 bool UartPosix::awaitAvailable(TickType_t timeout) {
+    // Doesn't lock: it's called while holding the lock
+    pollfd poll_fd = {
+        .fd = fileno(device.get()),
+        .events = POLLIN,
+        .revents = 0
+    };
     auto start_time = kernel::getTicks();
-    do {
-        if (available(timeout) > 0) {
+    while (true) {
+        // Don't block inside poll(): that would stall the FreeRTOS scheduler on POSIX
+        if (poll(&poll_fd, 1, 0) > 0 && (poll_fd.revents & POLLIN) != 0) {
             return true;
         }
-        kernel::delayTicks(timeout / 10);
-    } while ((kernel::getTicks() - start()) < timeout);
-    return false;
+        if ((kernel::getTicks() - start_time) >= timeout) {
+            return false;
+        }
+        kernel::delayTicks(1);
+    }
 }
 
 std::unique_ptr<Uart> create(const Configuration& configuration) {
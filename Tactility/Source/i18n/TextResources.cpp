@@ -12,6 +12,9 @@ namespace tt::i18n {
 
 constexpr auto* TAG = "I18n";
 
+constexpr size_t BINARY_HEADER_SIZE = 16;
+constexpr uint16_t BINARY_VERSION = 1;
+
 static std::string getFallbackLocale() {
     return "en-US";
 }
@@ -33,30 +36,142 @@ static std::string getDesiredLocale() {
     }
 }
 
+/** @return the path of the binary or text file for the locale, or an empty string when neither exists */
+static std::string findI18nDataFile(const std::string& path, const std::string& locale) {
+    auto binary_file_path = std::format("{}/{}.i18nb", path, locale);
+    if (file::isFile(binary_file_path)) {
+        return binary_file_path;
+    }
+
+    auto text_file_path = std::format("{}/{}.i18n", path, locale);
+    if (file::isFile(text_file_path)) {
+        return text_file_path;
+    }
+
+    return "";
+}
+
 static std::string getI18nDataFilePath(const std::string& path) {
     auto locale = getDesiredLocale();
-    auto desired_file_path = std::format("{}/{}.i18n", path, locale);
-    if (file::isFile(desired_file_path)) {
+    auto desired_file_path = findI18nDataFile(path, locale);
+    if (!desired_file_path.empty()) {
         return desired_file_path;
     } else {
-        TT_LOG_W(TAG, "Translations not found for %s at %s", locale.c_str(), desired_file_path.c_str());
+        TT_LOG_W(TAG, "Translations not found for %s at %s", locale.c_str(), path.c_str());
     }
 
     auto fallback_locale = getFallbackLocale();
-    auto fallback_file_path = std::format("{}/{}.i18n", path, getFallbackLocale());
-    if (file::isFile(fallback_file_path)) {
+    auto fallback_file_path = findI18nDataFile(path, fallback_locale);
+    if (!fallback_file_path.empty()) {
         return fallback_file_path;
     } else {
-        TT_LOG_W(TAG, "Fallback translations not found for %s at %s", fallback_locale.c_str(), fallback_file_path.c_str());
+        TT_LOG_W(TAG, "Fallback translations not found for %s at %s", fallback_locale.c_str(), path.c_str());
         return "";
     }
 }
 
-std::string TextResources::ERROR_RESULT = "TXT_RES_ERROR";
+static uint32_t readUint32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
 
-bool TextResources::load() {
-    std::vector<std::string> new_data;
+std::string_view TextResources::get(const int index) const {
+    if (index < 0 || static_cast<size_t>(index) >= count) {
+        return ERROR_RESULT;
+    } else if (binaryOffsets != nullptr) {
+        auto offset = readUint32(binaryOffsets + index * 4);
+        // The length excludes the null terminator
+        return { strings + offset, readUint32(binaryOffsets + (index + 1) * 4) - offset - 1 };
+    } else {
+        return { strings + lineOffsets[index] };
+    }
+}
+
+bool TextResources::loadBinary(const std::string& filePath) {
+    size_t size;
+    auto new_buffer = file::readBinary(filePath, size);
+    // The header is followed by at least one offset (the end of the last string)
+    if (new_buffer == nullptr || size < BINARY_HEADER_SIZE + 4 || memcmp(new_buffer.get(), "TTI1", 4) != 0) {
+        TT_LOG_E(TAG, "Invalid file %s", filePath.c_str());
+        return false;
+    }
+
+    const auto* header = new_buffer.get();
+    auto version = header[4] | (header[5] << 8);
+    auto new_count = readUint32(header + 8);
+    auto blob_size = readUint32(header + 12);
+    // Check the count before calculating with it, so the offset can't overflow on 32-bit targets
+    if (version != BINARY_VERSION || new_count > (size - BINARY_HEADER_SIZE) / 4 - 1) {
+        TT_LOG_E(TAG, "Unsupported file %s", filePath.c_str());
+        return false;
+    }
+
+    auto blob_offset = BINARY_HEADER_SIZE + (static_cast<size_t>(new_count) + 1) * 4;
+    if (blob_size != size - blob_offset) {
+        TT_LOG_E(TAG, "Unsupported file %s", filePath.c_str());
+        return false;
+    }
 
+    // Validate once, so get() doesn't have to
+    const auto* offsets = new_buffer.get() + BINARY_HEADER_SIZE;
+    const auto* blob = new_buffer.get() + blob_offset;
+    for (size_t i = 0; i < new_count; i++) {
+        auto start = readUint32(offsets + i * 4);
+        auto end = readUint32(offsets + (i + 1) * 4);
+        if (start >= end || end > blob_size || blob[end - 1] != '\0') {
+            TT_LOG_E(TAG, "Invalid string %d in %s", (int)i, filePath.c_str());
+            return false;
+        }
+    }
+    if (readUint32(offsets + new_count * 4) != blob_size) {
+        TT_LOG_E(TAG, "Invalid string table in %s", filePath.c_str());
+        return false;
+    }
+
+    buffer = std::move(new_buffer);
+    strings = reinterpret_cast<const char*>(buffer.get() + blob_offset);
+    binaryOffsets = buffer.get() + BINARY_HEADER_SIZE;
+    lineOffsets.clear();
+    lineOffsets.shrink_to_fit();
+    count = new_count;
+    return true;
+}
+
+bool TextResources::loadText(const std::string& filePath) {
+    // readString() adds a null terminator, which terminates the last line
+    auto new_buffer = file::readString(filePath);
+    if (new_buffer == nullptr) {
+        return false;
+    }
+
+    auto* text = reinterpret_cast<char*>(new_buffer.get());
+    auto text_length = strlen(text);
+    std::vector<uint32_t> new_offsets;
+    size_t line_start = 0;
+    while (line_start < text_length) {
+        new_offsets.push_back(line_start);
+        auto* line_end = strchr(text + line_start, '\n');
+        auto line_end_offset = (line_end != nullptr) ? static_cast<size_t>(line_end - text) : text_length;
+        // Lines become null-terminated strings in the same buffer
+        text[line_end_offset] = '\0';
+        if (line_end_offset > line_start && text[line_end_offset - 1] == '\r') {
+            text[line_end_offset - 1] = '\0';
+        }
+        line_start = line_end_offset + 1;
+    }
+
+    if (new_offsets.empty()) {
+        return false;
+    }
+
+    buffer = std::move(new_buffer);
+    strings = reinterpret_cast<const char*>(buffer.get());
+    binaryOffsets = nullptr;
+    count = new_offsets.size();
+    lineOffsets = std::move(new_offsets);
+    return true;
+}
+
+bool TextResources::load() {
     // Resolve the language file that we need (depends on system language selection)
     auto file_path = getI18nDataFilePath(path);
     if (file_path.empty()) {
@@ -64,16 +179,12 @@ bool TextResources::load() {
         return false;
     }
 
-    file::readLines(file_path, true, [&new_data](const char* line) {
-        new_data.push_back(line);
-    });
-
-    if (new_data.empty()) {
+    bool loaded = file_path.ends_with(".i18nb") ? loadBinary(file_path) : loadText(file_path);
+    if (!loaded) {
         TT_LOG_E(TAG, "Couldn't find i18n data for %s", path.c_str());
         return false;
     }
 
-    data = std::move(new_data);
     return true;
 }
 
@@ -0,0 +1,178 @@
+#include "Tactility/lvgl/ImageCache.h"
+
+#include <Tactility/MountPoints.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/TactilityConfig.h>
+#include <Tactility/file/AssetPack.h>
+#include <Tactility/file/FileLock.h>
+
+#include <list>
+
+namespace tt::lvgl {
+
+constexpr auto* TAG = "ImageCache";
+
+// Created by Buildscripts/asset-pack.py in the system partition
+#if LV_COLOR_DEPTH == 16
+constexpr auto* ASSET_PACK_FILE_NAME = "assets_rgb565a8.pack";
+#else
+constexpr auto* ASSET_PACK_FILE_NAME = "assets_argb8888.pack";
+#endif
+
+static_assert(static_cast<uint8_t>(file::AssetPack::ColorFormat::A8) == LV_COLOR_FORMAT_A8);
+static_assert(static_cast<uint8_t>(file::AssetPack::ColorFormat::Argb8888) == LV_COLOR_FORMAT_ARGB8888);
+static_assert(static_cast<uint8_t>(file::AssetPack::ColorFormat::Rgb565A8) == LV_COLOR_FORMAT_RGB565A8);
+
+/** Owns the pixel data that the descriptor points to */
+struct CachedImageData final : CachedImage {
+    std::unique_ptr<uint8_t[]> data;
+};
+
+struct CacheEntry {
+    std::string name;
+    std::shared_ptr<CachedImageData> image;
+};
+
+struct ImageCacheData {
+    Mutex mutex;
+    bool packOpened = false;
+    std::unique_ptr<file::AssetPack> pack;
+    /** Most recently used first */
+    std::list<CacheEntry> entries;
+    ImageCacheStatistics statistics = { 0, 0, 0, 0 };
+};
+
+static ImageCacheData cacheData;
+
+/** @return the name of the image in the system asset pack, or an empty string when the path is outside the system partition */
+static std::string getAssetName(const std::string& path) {
+    // Paths can be "A:/system/..." (ESP), "A:system/..." or "A:/system/..." (simulator)
+    size_t offset = path.starts_with("A:") ? 2 : 0;
+    while (offset < path.size() && path[offset] == '/') {
+        offset++;
+    }
+
+    std::string system_path = file::MOUNT_POINT_SYSTEM;
+    size_t system_offset = system_path.starts_with('/') ? 1 : 0;
+    auto system_path_length = system_path.size() - system_offset;
+    if (
+        path.compare(offset, system_path_length, system_path, system_offset) != 0 ||
+        path.size() <= offset + system_path_length + 1 ||
+        path[offset + system_path_length] != '/'
+    ) {
+        return {};
+    }
+
+    return path.substr(offset + system_path_length + 1);
+}
+
+/** Remove the least recently used images that nothing refers to, until the cache fits its budget */
+static void evictImages() {
+    auto iterator = cacheData.entries.end();
+    while (cacheData.statistics.usedMemory > config::IMAGE_CACHE_MEMORY_BUDGET && iterator != cacheData.entries.begin()) {
+        --iterator;
+        if (iterator->image.use_count() == 1) {
+            TT_LOG_D(TAG, "Evicting %s", iterator->name.c_str());
+            cacheData.statistics.usedMemory -= iterator->image->descriptor.data_size;
+            cacheData.statistics.evictionCount++;
+            iterator = cacheData.entries.erase(iterator);
+        }
+    }
+}
+
+static std::shared_ptr<CachedImageData> loadImage(const std::string& name) {
+    if (!cacheData.packOpened) {
+        cacheData.packOpened = true;
+        auto pack_path = std::string(file::MOUNT_POINT_SYSTEM) + "/" + ASSET_PACK_FILE_NAME;
+        auto lock = file::getLock(pack_path)->asScopedLock();
+        lock.lock();
+        cacheData.pack = file::AssetPack::open(pack_path);
+    }
+
+    if (cacheData.pack == nullptr || !cacheData.pack->contains(name)) {
+        return nullptr;
+    }
+
+    file::AssetPack::Image pack_image;
+    {
+        auto lock = file::getLock(cacheData.pack->getFilePath())->asScopedLock();
+        lock.lock();
+        if (!cacheData.pack->load(name, pack_image)) {
+            return nullptr;
+        }
+    }
+
+    auto image = std::make_shared<CachedImageData>();
+    image->data = std::move(pack_image.data);
+    image->descriptor = {};
+    image->descriptor.header.magic = LV_IMAGE_HEADER_MAGIC;
+    image->descriptor.header.cf = static_cast<uint8_t>(pack_image.colorFormat);
+    image->descriptor.header.w = pack_image.width;
+    image->descriptor.header.h = pack_image.height;
+    image->descriptor.header.stride = pack_image.stride;
+    image->descriptor.data_size = pack_image.dataSize;
+    image->descriptor.data = image->data.get();
+    image->color = lv_color_hex(pack_image.color);
+    return image;
+}
+
+std::shared_ptr<const CachedImage> findCachedImage(const std::string& path) {
+    auto name = getAssetName(path);
+    if (name.empty()) {
+        return nullptr;
+    }
+
+    auto lock = cacheData.mutex.asScopedLock();
+    lock.lock();
+
+    for (auto iterator = cacheData.entries.begin(); iterator != cacheData.entries.end(); ++iterator) {
+        if (iterator->name == name) {
+            cacheData.statistics.hitCount++;
+            cacheData.entries.splice(cacheData.entries.begin(), cacheData.entries, iterator);
+            return cacheData.entries.front().image;
+        }
+    }
+
+    auto image = loadImage(name);
+    if (image == nullptr) {
+        return nullptr;
+    }
+
+    cacheData.statistics.missCount++;
+    cacheData.statistics.usedMemory += image->descriptor.data_size;
+    cacheData.entries.push_front({ name, image });
+    evictImages();
+    if (cacheData.statistics.usedMemory > config::IMAGE_CACHE_MEMORY_BUDGET) {
+        TT_LOG_W(TAG, "Images in use exceed the budget (%d bytes)", (int)cacheData.statistics.usedMemory);
+    }
+
+    return image;
+}
+
+void image_set_src_cached(lv_obj_t* image, const std::string& path) {
+    auto cached_image = findCachedImage(path);
+    if (cached_image == nullptr) {
+        lv_image_set_src(image, path.c_str());
+        return;
+    }
+
+    // The widget owns a reference until it is deleted
+    auto* reference = new std::shared_ptr<const CachedImage>(cached_image);
+    lv_obj_add_event_cb(image, [](lv_event_t* event) {
+        delete static_cast<std::shared_ptr<const CachedImage>*>(lv_event_get_user_data(event));
+    }, LV_EVENT_DELETE, reference);
+
+    lv_image_set_src(image, &cached_image->descriptor);
+    if (cached_image->isAlphaOnly()) {
+        lv_obj_set_style_image_recolor(image, cached_image->color, LV_STATE_DEFAULT);
+        lv_obj_set_style_image_recolor_opa(image, LV_OPA_COVER, LV_STATE_DEFAULT);
+    }
+}
+
+ImageCacheStatistics getImageCacheStatistics() {
+    auto lock = cacheData.mutex.asScopedLock();
+    lock.lock();
+    return cacheData.statistics;
+}
+
+} // namespace tt::lvgl
@@ -3,6 +3,7 @@
 #include <Tactility/Assets.h>
 #include <Tactility/CoreDefines.h>
 #include <Tactility/Log.h>
+#include <Tactility/lvgl/ImageCache.h>
 
 #include <lvgl.h>
 
@@ -29,7 +30,7 @@ lv_obj_t* spinner_create(lv_obj_t* parent) {
     lv_obj_t* obj = lv_obj_class_create_obj(&tt_spinner_class, parent);
     lv_obj_class_init_obj(obj);
 
-    lv_image_set_src(obj, TT_ASSETS_UI_SPINNER);
+    image_set_src_cached(obj, TT_ASSETS_UI_SPINNER);
 
     return obj;
 }
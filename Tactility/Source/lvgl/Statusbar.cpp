@@ -2,6 +2,7 @@
 
 #include "Tactility/lvgl/Statusbar.h"
 
+#include "Tactility/lvgl/ImageCache.h"
 #include "Tactility/lvgl/Style.h"
 #include "Tactility/lvgl/LvglSync.h"
 
@@ -23,6 +24,8 @@ static void onUpdateTime();
 
 struct StatusbarIcon {
     std::string image;
+    /** The pre-decoded image, or nullptr when the asset pack doesn't contain the image */
+    std::shared_ptr<const CachedImage> cachedImage;
     bool visible = false;
     bool claimed = false;
 };
@@ -45,6 +48,8 @@ typedef struct {
     lv_obj_t* time;
     lv_obj_t* icons[STATUSBAR_ICON_LIMIT];
     lv_obj_t* battery_icon;
+    /** The cached images that the icon widgets point to (kept alive while they are shown) */
+    std::shared_ptr<const CachedImage>* icon_images;
     PubSub<void*>::SubscriptionHandle pubsub_subscription;
 } Statusbar;
 
@@ -127,6 +132,7 @@ static void statusbar_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj)
     lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
     LV_TRACE_OBJ_CREATE("finished");
     auto* statusbar = (Statusbar*)obj;
+    statusbar->icon_images = new std::shared_ptr<const CachedImage>[STATUSBAR_ICON_LIMIT];
     statusbar->pubsub_subscription = statusbar_data.pubsub->subscribe([statusbar](auto) {
         statusbar_pubsub_event(statusbar);
     });
@@ -143,11 +149,38 @@ static void statusbar_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj)
 static void statusbar_destructor(TT_UNUSED const lv_obj_class_t* class_p, lv_obj_t* obj) {
     auto* statusbar = (Statusbar*)obj;
     statusbar_data.pubsub->unsubscribe(statusbar->pubsub_subscription);
+    delete[] statusbar->icon_images;
 }
 
-static void update_icon(lv_obj_t* image, const StatusbarIcon* icon) {
+static void update_icon_source(lv_obj_t* image, std::shared_ptr<const CachedImage>& shownImage, const StatusbarIcon* icon) {
+    if (icon->cachedImage != nullptr) {
+        // Switching between pre-decoded images only swaps a pointer
+        if (shownImage != icon->cachedImage) {
+            lv_image_set_src(image, &icon->cachedImage->descriptor);
+            if (icon->cachedImage->isAlphaOnly()) {
+                lv_obj_set_style_image_recolor(image, icon->cachedImage->color, LV_STATE_DEFAULT);
+                lv_obj_set_style_image_recolor_opa(image, LV_OPA_COVER, LV_STATE_DEFAULT);
+            } else {
+                lv_obj_set_style_image_recolor_opa(image, LV_OPA_TRANSP, LV_STATE_DEFAULT);
+            }
+            shownImage = icon->cachedImage;
+        }
+    } else {
+        const auto* source = lv_image_get_src(image);
+        bool is_same_file = shownImage == nullptr &&
+            lv_image_src_get_type(source) == LV_IMAGE_SRC_FILE &&
+            icon->image == static_cast<const char*>(source);
+        if (!is_same_file) {
+            lv_obj_set_style_image_recolor_opa(image, LV_OPA_TRANSP, LV_STATE_DEFAULT);
+            lv_image_set_src(image, icon->image.c_str());
+            shownImage = nullptr;
+        }
+    }
+}
+
+static void update_icon(lv_obj_t* image, std::shared_ptr<const CachedImage>& shownImage, const StatusbarIcon* icon) {
     if (!icon->image.empty() && icon->visible && icon->claimed) {
-        lv_image_set_src(image, icon->image.c_str());
+        update_icon_source(image, shownImage, icon);
         lv_obj_remove_flag(image, LV_OBJ_FLAG_HIDDEN);
     } else {
         lv_obj_add_flag(image, LV_OBJ_FLAG_HIDDEN);
@@ -186,7 +219,7 @@ lv_obj_t* statusbar_create(lv_obj_t* parent) {
         obj_set_style_bg_blacken(image);
         statusbar->icons[i] = image;
 
-        update_icon(image, &(statusbar_data.icons[i]));
+        update_icon(image, statusbar->icon_images[i], &(statusbar_data.icons[i]));
     }
     statusbar_data.mutex.unlock();
 
@@ -208,7 +241,7 @@ static void update_main(Statusbar* statusbar) {
 
     if (statusbar_data.mutex.lock(200 / portTICK_PERIOD_MS)) {
         for (int i = 0; i < STATUSBAR_ICON_LIMIT; ++i) {
-            update_icon(statusbar->icons[i], &(statusbar_data.icons[i]));
+            update_icon(statusbar->icons[i], statusbar->icon_images[i], &(statusbar_data.icons[i]));
         }
         statusbar_data.mutex.unlock();
     }
@@ -230,6 +263,7 @@ static void statusbar_event(TT_UNUSED const lv_obj_class_t* class_p, lv_event_t*
 }
 
 int8_t statusbar_icon_add(const std::string& image) {
+    auto cached_image = image.empty() ? nullptr : findCachedImage(image);
     statusbar_data.mutex.lock();
     int8_t result = -1;
     for (int8_t i = 0; i < STATUSBAR_ICON_LIMIT; ++i) {
@@ -237,6 +271,7 @@ int8_t statusbar_icon_add(const std::string& image) {
             statusbar_data.icons[i].claimed = true;
             statusbar_data.icons[i].visible = !image.empty();
             statusbar_data.icons[i].image = image;
+            statusbar_data.icons[i].cachedImage = cached_image;
             result = i;
             TT_LOG_D(TAG, "id %d: added", i);
             break;
@@ -259,6 +294,7 @@ void statusbar_icon_remove(int8_t id) {
     icon->claimed = false;
     icon->visible = false;
     icon->image = "";
+    icon->cachedImage = nullptr;
     statusbar_data.mutex.unlock();
     statusbar_data.pubsub->publish(nullptr);
 }
@@ -266,10 +302,13 @@ void statusbar_icon_remove(int8_t id) {
 void statusbar_icon_set_image(int8_t id, const std::string& image) {
     TT_LOG_D(TAG, "id %d: set image %s", id, image.empty() ? "(none)" : image.c_str());
     tt_check(id >= 0 && id < STATUSBAR_ICON_LIMIT);
+    // Read from the asset pack (when needed) before locking, so other icon changes don't wait for it
+    auto cached_image = image.empty() ? nullptr : findCachedImage(image);
     statusbar_data.mutex.lock();
     StatusbarIcon* icon = &statusbar_data.icons[id];
     tt_check(icon->claimed);
     icon->image = image;
+    icon->cachedImage = cached_image;
     statusbar_data.mutex.unlock();
     statusbar_data.pubsub->publish(nullptr);
 }
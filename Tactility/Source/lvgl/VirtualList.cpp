@@ -0,0 +1,196 @@
+#include "Tactility/lvgl/VirtualList.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace tt::lvgl {
+
+constexpr auto UNBOUND = SIZE_MAX;
+
+/** Extra rows above and below the visible rows, so keyboard/encoder focus can move to the next or previous item */
+constexpr size_t EXTRA_ROW_COUNT = 3;
+
+struct VirtualListData {
+    VirtualListBindFunction bind;
+    VirtualListClickFunction onClick;
+    VirtualListClickFunction onLongPress;
+    size_t itemCount = 0;
+    int32_t rowHeight = 0;
+    lv_obj_t* spacer = nullptr;
+    /** Item N is shown by rows[N % rows.size()] */
+    std::vector<lv_obj_t*> rows;
+    /** The item index per row */
+    std::vector<size_t> rowItems;
+};
+
+static VirtualListData* getData(lv_obj_t* list) {
+    return static_cast<VirtualListData*>(lv_obj_get_user_data(list));
+}
+
+static void onRowClicked(lv_event_t* event) {
+    auto* row = static_cast<lv_obj_t*>(lv_event_get_current_target(event));
+    auto* data = static_cast<VirtualListData*>(lv_event_get_user_data(event));
+    auto index = reinterpret_cast<size_t>(lv_obj_get_user_data(row));
+    if (index != UNBOUND && index < data->itemCount && data->onClick != nullptr) {
+        data->onClick(index);
+    }
+}
+
+static void onRowLongPressed(lv_event_t* event) {
+    auto* row = static_cast<lv_obj_t*>(lv_event_get_current_target(event));
+    auto* data = static_cast<VirtualListData*>(lv_event_get_user_data(event));
+    auto index = reinterpret_cast<size_t>(lv_obj_get_user_data(row));
+    if (index != UNBOUND && index < data->itemCount && data->onLongPress != nullptr) {
+        data->onLongPress(index);
+    }
+}
+
+static lv_obj_t* createRow(lv_obj_t* list, VirtualListData* data) {
+    // The dummy symbol creates the icon widget, so all rows have the same children
+    auto* row = lv_list_add_button(list, LV_SYMBOL_DUMMY, "");
+    lv_obj_add_event_cb(row, onRowClicked, LV_EVENT_SHORT_CLICKED, data);
+    lv_obj_add_event_cb(row, onRowLongPressed, LV_EVENT_LONG_PRESSED, data);
+    lv_obj_set_user_data(row, reinterpret_cast<void*>(UNBOUND));
+    if (data->rowHeight > 0) {
+        lv_obj_set_height(row, data->rowHeight);
+    }
+    data->rows.push_back(row);
+    data->rowItems.push_back(UNBOUND);
+    return row;
+}
+
+static void updateRows(lv_obj_t* list, bool rebindAll) {
+    auto* data = getData(list);
+    if (data->itemCount > 0 && data->rowHeight == 0) {
+        auto* row = createRow(list, data);
+        lv_obj_update_layout(list);
+        data->rowHeight = std::max<int32_t>(1, lv_obj_get_height(row));
+        // Rows without an icon must have the same height
+        lv_obj_set_height(row, data->rowHeight);
+        lv_obj_set_height(data->spacer, static_cast<int32_t>(data->itemCount) * data->rowHeight);
+    }
+
+    auto visible_count = static_cast<size_t>(lv_obj_get_content_height(list) / std::max<int32_t>(1, data->rowHeight)) + 1;
+    auto needed_count = std::min(data->itemCount, visible_count + EXTRA_ROW_COUNT);
+    if (needed_count > data->rows.size()) {
+        while (data->rows.size() < needed_count) {
+            createRow(list, data);
+        }
+        // The item-to-row mapping depends on the amount of rows
+        rebindAll = true;
+    }
+
+    auto row_count = data->rows.size();
+    if (rebindAll) {
+        std::ranges::fill(data->rowItems, UNBOUND);
+    }
+
+    size_t first_index = 0;
+    if (data->rowHeight > 0) {
+        auto scroll_index = static_cast<size_t>(std::max<int32_t>(0, lv_obj_get_scroll_y(list) / data->rowHeight));
+        first_index = (scroll_index > 0) ? scroll_index - 1 : 0;
+        if (data->itemCount > row_count) {
+            first_index = std::min(first_index, data->itemCount - row_count);
+        } else {
+            first_index = 0;
+        }
+    }
+
+    auto end_index = std::min(first_index + row_count, data->itemCount);
+    for (auto index = first_index; index < end_index; index++) {
+        auto slot = index % row_count;
+        if (data->rowItems[slot] != index) {
+            auto* row = data->rows[slot];
+            data->rowItems[slot] = index;
+            lv_obj_set_user_data(row, reinterpret_cast<void*>(index));
+            lv_obj_set_y(row, static_cast<int32_t>(index) * data->rowHeight);
+            data->bind(row, index);
+            lv_obj_remove_flag(row, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+
+    // Rows without an item (when there are fewer items than rows)
+    for (size_t slot = 0; slot < row_count; slot++) {
+        if (data->rowItems[slot] == UNBOUND || data->rowItems[slot] >= data->itemCount) {
+            data->rowItems[slot] = UNBOUND;
+            lv_obj_set_user_data(data->rows[slot], reinterpret_cast<void*>(UNBOUND));
+            lv_obj_add_flag(data->rows[slot], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
+static void onListEvent(lv_event_t* event) {
+    auto* list = static_cast<lv_obj_t*>(lv_event_get_current_target(event));
+    switch (lv_event_get_code(event)) {
+        case LV_EVENT_SCROLL:
+        case LV_EVENT_SIZE_CHANGED:
+            updateRows(list, false);
+            break;
+        case LV_EVENT_DELETE:
+            delete getData(list);
+            lv_obj_set_user_data(list, nullptr);
+            break;
+        default:
+            break;
+    }
+}
+
+lv_obj_t* virtual_list_create(lv_obj_t* parent, VirtualListBindFunction bind, VirtualListClickFunction onClick) {
+    auto* list = lv_list_create(parent);
+    // Rows are positioned manually
+    lv_obj_set_layout(list, LV_LAYOUT_NONE);
+
+    auto* data = new VirtualListData();
+    data->bind = std::move(bind);
+    data->onClick = std::move(onClick);
+    lv_obj_set_user_data(list, data);
+
+    // Determines the scroll range: it has the height of all rows together
+    data->spacer = lv_obj_create(list);
+    lv_obj_remove_style_all(data->spacer);
+    lv_obj_set_size(data->spacer, 1, 0);
+    lv_obj_remove_flag(data->spacer, LV_OBJ_FLAG_CLICKABLE);
+
+    lv_obj_add_event_cb(list, onListEvent, LV_EVENT_SCROLL, nullptr);
+    lv_obj_add_event_cb(list, onListEvent, LV_EVENT_SIZE_CHANGED, nullptr);
+    lv_obj_add_event_cb(list, onListEvent, LV_EVENT_DELETE, nullptr);
+    return list;
+}
+
+void virtual_list_set_item_count(lv_obj_t* list, size_t count) {
+    auto* data = getData(list);
+    data->itemCount = count;
+    lv_obj_set_height(data->spacer, static_cast<int32_t>(count) * data->rowHeight);
+    lv_obj_scroll_to_y(list, 0, LV_ANIM_OFF);
+    updateRows(list, true);
+}
+
+void virtual_list_set_long_press_callback(lv_obj_t* list, VirtualListClickFunction onLongPress) {
+    getData(list)->onLongPress = std::move(onLongPress);
+}
+
+size_t virtual_list_get_item_count(lv_obj_t* list) {
+    return getData(list)->itemCount;
+}
+
+void virtual_list_refresh(lv_obj_t* list) {
+    updateRows(list, true);
+}
+
+void virtual_list_row_set_content(lv_obj_t* row, const void* icon, const char* text) {
+    auto* image = lv_obj_get_child(row, 0);
+    if (icon != nullptr) {
+        lv_image_set_src(image, icon);
+        lv_obj_remove_flag(image, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(image, LV_OBJ_FLAG_HIDDEN);
+    }
+    lv_label_set_text(lv_obj_get_child(row, 1), text);
+}
+
+void virtual_list_row_set_text(lv_obj_t* row, const char* text) {
+    virtual_list_row_set_content(row, nullptr, text);
+}
+
+} // namespace tt::lvgl
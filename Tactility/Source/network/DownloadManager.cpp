@@ -0,0 +1,193 @@
+#include "Tactility/network/DownloadManager.h"
+#include "Tactility/network/HttpConnection.h"
+
+#include <Tactility/file/File.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Log.h>
+
+#include <sys/stat.h>
+
+namespace tt::network::http {
+
+constexpr auto* TAG = "DownloadManager";
+
+DownloadManager::DownloadManager(size_t blockSize) :
+    writer(blockSize),
+    // TLS handshakes need a large stack
+    dispatcherThread("download", 6144)
+{
+    dispatcherThread.start();
+}
+
+DownloadManager::~DownloadManager() {
+    dispatcherThread.stop();
+}
+
+void DownloadManager::enqueue(DownloadRequest request) {
+    dispatcherThread.dispatch([this, request = std::move(request)] {
+        run(request);
+    });
+}
+
+DownloadManager::Statistics DownloadManager::getStatistics() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return statistics;
+}
+
+const char* DownloadManager::receive(const DownloadRequest& request, const std::string& partFilePath, uint64_t& offset, bool& retry) {
+    retry = true;
+    auto connection = createHttpConnection();
+    if (!connection->open(request.url, request.certFilePath, offset)) {
+        return "Failed to open connection";
+    }
+
+    auto status_code = connection->getStatusCode();
+    if (offset > 0 && status_code == 206) {
+        TT_LOG_I(TAG, "Resuming at %llu bytes", (unsigned long long)offset);
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        statistics.resumedCount++;
+    } else if (offset > 0 && (status_code == 416 || (status_code >= 200 && status_code < 300))) {
+        // The server can't or won't send a part of the file: start over
+        TT_LOG_W(TAG, "Range request not accepted (%d)", status_code);
+        writer.close();
+        offset = 0;
+        if (!writer.open(partFilePath, false)) {
+            retry = false;
+            return "Failed to open file";
+        }
+        if (status_code == 416) {
+            return "Range not satisfiable";
+        }
+    } else if (status_code < 200 || status_code >= 300) {
+        TT_LOG_E(TAG, "Status code %d", status_code);
+        retry = false;
+        return "Server response is not OK";
+    }
+
+    auto content_length = connection->getContentLength();
+    int64_t total_bytes = (content_length >= 0) ? static_cast<int64_t>(offset) + content_length : -1;
+    auto start_time = kernel::getMillis();
+    uint64_t connection_bytes = 0;
+
+    while (total_bytes < 0 || offset < static_cast<uint64_t>(total_bytes)) {
+        size_t space;
+        auto* buffer = writer.getBuffer(space);
+        auto length = connection->read(buffer, space);
+        if (length < 0) {
+            return "Failed to read data";
+        } else if (length == 0) {
+            if (total_bytes < 0) {
+                break;
+            }
+            return "Connection closed before all data was received";
+        }
+
+        if (!writer.commit(length)) {
+            retry = false;
+            return "Failed to write file";
+        }
+
+        offset += length;
+        connection_bytes += length;
+
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        statistics.bytesReceived += length;
+        lock.unlock();
+
+        // Report once per block
+        if (request.onProgress != nullptr && (static_cast<size_t>(length) == space || offset == static_cast<uint64_t>(total_bytes))) {
+            auto duration = kernel::getMillis() - start_time;
+            request.onProgress({
+                .bytesReceived = offset,
+                .totalBytes = total_bytes,
+                .bytesPerSecond = static_cast<uint32_t>((connection_bytes * 1000) / (duration > 0 ? duration : 1))
+            });
+        }
+    }
+
+    return nullptr;
+}
+
+const char* DownloadManager::transfer(const DownloadRequest& request, const std::string& partFilePath) {
+    uint64_t offset = 0;
+    if (request.resume) {
+        auto lock = file::getLock(partFilePath)->asScopedLock();
+        lock.lock();
+        struct stat info;
+        if (stat(partFilePath.c_str(), &info) == 0) {
+            offset = info.st_size;
+        }
+    }
+
+    if (!writer.open(partFilePath, offset > 0)) {
+        return "Failed to open file";
+    }
+
+    const char* error = nullptr;
+    for (uint32_t attempt = 1; attempt <= maxAttempts; attempt++) {
+        bool retry;
+        error = receive(request, partFilePath, offset, retry);
+        if (error == nullptr || !retry) {
+            break;
+        }
+        TT_LOG_W(TAG, "Attempt %lu failed at %llu bytes: %s", (unsigned long)attempt, (unsigned long long)offset, error);
+    }
+
+    // The writer is closed when re-opening a file failed
+    if (writer.isOpen() && !writer.close() && error == nullptr) {
+        error = "Failed to write file";
+    }
+
+    return error;
+}
+
+void DownloadManager::run(const DownloadRequest& request) {
+    TT_LOG_I(TAG, "Downloading %s to %s", request.url.c_str(), request.filePath.c_str());
+    auto part_file_path = request.filePath + ".part";
+    auto* error = transfer(request, part_file_path);
+
+    if (error == nullptr) {
+        auto lock = file::getLock(request.filePath)->asScopedLock();
+        lock.lock();
+        // rename() doesn't replace existing files on FAT
+        remove(request.filePath.c_str());
+        if (rename(part_file_path.c_str(), request.filePath.c_str()) != 0) {
+            error = "Failed to rename file";
+        }
+    } else if (!request.resume) {
+        auto lock = file::getLock(part_file_path)->asScopedLock();
+        lock.lock();
+        remove(part_file_path.c_str());
+    }
+
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    if (error == nullptr) {
+        statistics.completedCount++;
+    } else {
+        statistics.failedCount++;
+    }
+    lock.unlock();
+
+    if (error == nullptr) {
+        TT_LOG_I(TAG, "Downloaded %s to %s", request.url.c_str(), request.filePath.c_str());
+        if (request.onSuccess != nullptr) {
+            request.onSuccess();
+        }
+    } else {
+        TT_LOG_E(TAG, "Failed to download %s: %s", request.url.c_str(), error);
+        if (request.onError != nullptr) {
+            request.onError(error);
+        }
+    }
+}
+
+DownloadManager& getDownloadManager() {
+    static DownloadManager manager;
+    return manager;
+}
+
+} // namespace tt::network::http
@@ -0,0 +1,115 @@
+#ifdef ESP_PLATFORM
+
+#include "Tactility/network/HttpConnection.h"
+#include "Tactility/network/EspHttpClient.h"
+
+#include <Tactility/file/File.h>
+#include <Tactility/Log.h>
+#include <Tactility/Mutex.h>
+
+#include <esp_tls.h>
+
+#include <cstring>
+#include <format>
+
+namespace tt::network::http {
+
+constexpr auto* TAG = "HttpConnection";
+
+static Mutex certificateMutex;
+/** The certificate file that is currently parsed into the global CA store */
+static std::string globalCertificatePath;
+
+/**
+ * Parse the certificate into the esp-tls global CA store, unless it's already there.
+ * This saves reading and parsing the .pem file for every connection.
+ */
+static bool setGlobalCertificate(const std::string& certFilePath) {
+    auto lock = certificateMutex.asScopedLock();
+    lock.lock();
+
+    if (globalCertificatePath == certFilePath) {
+        return true;
+    }
+
+    TT_LOG_I(TAG, "Loading certificate %s", certFilePath.c_str());
+    auto certificate = file::readString(certFilePath);
+    if (certificate == nullptr) {
+        TT_LOG_E(TAG, "Failed to read certificate");
+        return false;
+    }
+
+    auto certificate_length = strlen(reinterpret_cast<const char*>(certificate.get())) + 1;
+    if (esp_tls_set_global_ca_store(certificate.get(), certificate_length) != ESP_OK) {
+        TT_LOG_E(TAG, "Failed to parse certificate");
+        globalCertificatePath.clear();
+        return false;
+    }
+
+    globalCertificatePath = certFilePath;
+    return true;
+}
+
+class HttpConnectionEsp final : public HttpConnection {
+
+    std::string url;
+    EspHttpClient client;
+    int statusCode = 0;
+    int64_t contentLength = -1;
+
+public:
+
+    bool open(const std::string& inUrl, const std::string& certFilePath, uint64_t rangeStart) override {
+        url = inUrl;
+        bool is_https = url.starts_with("https://");
+        if (is_https && !setGlobalCertificate(certFilePath)) {
+            return false;
+        }
+
+        auto config = std::make_unique<esp_http_client_config_t>(esp_http_client_config_t {
+            .url = url.c_str(),
+            .auth_type = HTTP_AUTH_TYPE_NONE,
+            .tls_version = ESP_HTTP_CLIENT_TLS_VER_TLS_1_3,
+            .method = HTTP_METHOD_GET,
+            .timeout_ms = 5000,
+            .transport_type = is_https ? HTTP_TRANSPORT_OVER_SSL : HTTP_TRANSPORT_OVER_TCP,
+            .use_global_ca_store = is_https
+        });
+
+        if (!client.init(std::move(config))) {
+            TT_LOG_E(TAG, "Failed to initialize client");
+            return false;
+        }
+
+        if (rangeStart > 0) {
+            auto range = std::format("bytes={}-", rangeStart);
+            if (!client.setHeader("Range", range.c_str())) {
+                return false;
+            }
+        }
+
+        if (!client.open() || !client.fetchHeaders()) {
+            return false;
+        }
+
+        statusCode = client.getStatusCode();
+        contentLength = client.getContentLength();
+        return true;
+    }
+
+    int getStatusCode() const override { return statusCode; }
+
+    int64_t getContentLength() const override { return contentLength; }
+
+    int read(uint8_t* data, size_t size) override {
+        return client.read(reinterpret_cast<char*>(data), static_cast<int>(size));
+    }
+};
+
+std::unique_ptr<HttpConnection> createHttpConnection() {
+    return std::make_unique<HttpConnectionEsp>();
+}
+
+} // namespace tt::network::http
+
+#endif
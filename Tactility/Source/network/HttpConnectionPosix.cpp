@@ -0,0 +1,226 @@
+#ifndef ESP_PLATFORM
+
+#include "Tactility/network/HttpConnection.h"
+
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // Not available on macOS
+#endif
+
+namespace tt::network::http {
+
+constexpr auto* TAG = "HttpConnection";
+constexpr size_t MAX_HEADER_SIZE = 4096;
+constexpr int TIMEOUT_SECONDS = 5;
+
+/** Split "http://host:port/path" into its parts */
+static bool parseHttpUrl(const std::string& url, std::string& host, std::string& port, std::string& path) {
+    constexpr std::string_view scheme = "http://";
+    if (!url.starts_with(scheme)) {
+        TT_LOG_E(TAG, "Only http:// URLs are supported on this platform");
+        return false;
+    }
+
+    auto host_start = scheme.size();
+    auto path_start = url.find('/', host_start);
+    if (path_start == std::string::npos) {
+        path_start = url.size();
+        path = "/";
+    } else {
+        path = url.substr(path_start);
+    }
+
+    auto authority = url.substr(host_start, path_start - host_start);
+    auto port_separator = authority.rfind(':');
+    if (port_separator == std::string::npos) {
+        host = authority;
+        port = "80";
+    } else {
+        host = authority.substr(0, port_separator);
+        port = authority.substr(port_separator + 1);
+    }
+
+    return !host.empty() && !port.empty();
+}
+
+static bool equalsIgnoreCase(std::string_view left, std::string_view right) {
+    return std::ranges::equal(left, right, [](char a, char b) { return tolower(a) == tolower(b); });
+}
+
+/** A minimal HTTP/1.1 client for the simulator and host tests */
+class HttpConnectionPosix final : public HttpConnection {
+
+    int socketFd = -1;
+    int statusCode = 0;
+    int64_t contentLength = -1;
+    /** Body data that was received together with the headers */
+    std::string pending;
+    size_t pendingOffset = 0;
+
+    bool connectTo(const std::string& host, const std::string& port) {
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+            TT_LOG_E(TAG, "Failed to resolve %s", host.c_str());
+            return false;
+        }
+
+        for (auto* address = addresses; address != nullptr; address = address->ai_next) {
+            socketFd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (socketFd < 0) {
+                continue;
+            }
+            timeval timeout = { .tv_sec = TIMEOUT_SECONDS, .tv_usec = 0 };
+            setsockopt(socketFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            setsockopt(socketFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            if (connect(socketFd, address->ai_addr, address->ai_addrlen) == 0) {
+                break;
+            }
+            ::close(socketFd);
+            socketFd = -1;
+        }
+
+        freeaddrinfo(addresses);
+        if (socketFd < 0) {
+            TT_LOG_E(TAG, "Failed to connect to %s:%s", host.c_str(), port.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    ssize_t receive(void* data, size_t size) const {
+        ssize_t result;
+        do {
+            result = recv(socketFd, data, size, 0);
+        } while (result < 0 && errno == EINTR);
+        return result;
+    }
+
+    bool sendAll(const std::string& data) const {
+        size_t offset = 0;
+        while (offset < data.size()) {
+            auto result = send(socketFd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            } else if (result <= 0) {
+                return false;
+            }
+            offset += result;
+        }
+        return true;
+    }
+
+    bool parseHeaders(std::string_view headers) {
+        // Status line: "HTTP/1.1 200 OK"
+        auto line_end = headers.find("\r\n");
+        auto status_line = headers.substr(0, line_end);
+        auto status_start = status_line.find(' ');
+        if (!status_line.starts_with("HTTP/") || status_start == std::string_view::npos) {
+            TT_LOG_E(TAG, "Invalid status line");
+            return false;
+        }
+        statusCode = atoi(std::string(status_line.substr(status_start + 1, 3)).c_str());
+
+        while (line_end != std::string_view::npos) {
+            auto line_start = line_end + 2;
+            line_end = headers.find("\r\n", line_start);
+            auto line = headers.substr(line_start, line_end - line_start);
+            auto separator = line.find(':');
+            if (separator == std::string_view::npos) {
+                continue;
+            }
+            auto key = line.substr(0, separator);
+            auto value = std::string(line.substr(separator + 1));
+            if (equalsIgnoreCase(key, "Content-Length")) {
+                contentLength = strtoll(value.c_str(), nullptr, 10);
+            } else if (equalsIgnoreCase(key, "Transfer-Encoding") && value.find("chunked") != std::string::npos) {
+                TT_LOG_E(TAG, "Chunked transfer encoding is not supported");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+public:
+
+    ~HttpConnectionPosix() override {
+        if (socketFd >= 0) {
+            ::close(socketFd);
+        }
+    }
+
+    bool open(const std::string& url, const std::string& certFilePath, uint64_t rangeStart) override {
+        std::string host, port, path;
+        if (!parseHttpUrl(url, host, port, path) || !connectTo(host, port)) {
+            return false;
+        }
+
+        auto request = std::format("GET {} HTTP/1.1\r\nHost: {}\r\nConnection: close\r\n", path, host);
+        if (rangeStart > 0) {
+            request += std::format("Range: bytes={}-\r\n", rangeStart);
+        }
+        request += "\r\n";
+        if (!sendAll(request)) {
+            TT_LOG_E(TAG, "Failed to send request");
+            return false;
+        }
+
+        // Receive until the end of the headers: anything after that is body data
+        char buffer[512];
+        size_t headers_end;
+        while ((headers_end = pending.find("\r\n\r\n")) == std::string::npos) {
+            if (pending.size() > MAX_HEADER_SIZE) {
+                TT_LOG_E(TAG, "Headers too large");
+                return false;
+            }
+            auto result = receive(buffer, sizeof(buffer));
+            if (result <= 0) {
+                TT_LOG_E(TAG, "Failed to receive headers");
+                return false;
+            }
+            pending.append(buffer, result);
+        }
+
+        if (!parseHeaders(std::string_view(pending).substr(0, headers_end))) {
+            return false;
+        }
+
+        pendingOffset = headers_end + 4;
+        return true;
+    }
+
+    int getStatusCode() const override { return statusCode; }
+
+    int64_t getContentLength() const override { return contentLength; }
+
+    int read(uint8_t* data, size_t size) override {
+        if (pendingOffset < pending.size()) {
+            auto length = std::min(size, pending.size() - pendingOffset);
+            memcpy(data, pending.data() + pendingOffset, length);
+            pendingOffset += length;
+            return static_cast<int>(length);
+        }
+        return static_cast<int>(receive(data, size));
+    }
+};
+
+std::unique_ptr<HttpConnection> createHttpConnection() {
+    return std::make_unique<HttpConnectionPosix>();
+}
+
+} // namespace tt::network::http
+
+#endif
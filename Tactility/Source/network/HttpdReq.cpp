@@ -4,8 +4,6 @@
 #include <Tactility/file/File.h>
 
 #include <memory>
-#include <ranges>
-#include <sstream>
 
 #ifdef ESP_PLATFORM
 
@@ -96,77 +94,29 @@ std::unique_ptr<char[]> receiveByteArray(httpd_req_t* request, size_t length, si
     return std::unique_ptr<char[]>(std::move(buffer));
 }
 
-std::string receiveTextUntil(httpd_req_t* request, const std::string& terminator) {
-    size_t read_index = 0;
-    std::stringstream result;
-    while (!result.str().ends_with(terminator)) {
-        char buffer;
-        size_t bytes_read = httpd_req_recv(request, &buffer, 1);
-        if (bytes_read <= 0) {
-            return "";
-        } else {
-            read_index += bytes_read;
-        }
-
-        result << buffer;
-    }
-
-    return result.str();
-}
-
-std::map<std::string, std::string> parseContentDisposition(const std::vector<std::string>& input) {
-    std::map<std::string, std::string> result;
-    static std::string prefix = "Content-Disposition: ";
-
-    // Find header
-    auto content_disposition_header = std::ranges::find_if(input, [](const std::string& header) {
-        return header.starts_with(prefix);
-    });
-
-    // Header not found
-    if (content_disposition_header == input.end()) {
-        return result;
-    }
+size_t receiveChunks(httpd_req_t* request, size_t length, const std::function<bool(const char* data, size_t size)>& onChunk) {
+    // Large chunks, so parsers and writers are called as little as possible
+    constexpr auto BUFFER_SIZE = 4096;
+    auto buffer = std::make_unique<char[]>(BUFFER_SIZE);
+    size_t bytes_received = 0;
 
-    auto parseable = content_disposition_header->substr(prefix.size());
-    auto parts = string::split(parseable, "; ");
-    for (auto part : parts) {
-        auto key_value = string::split(part, "=");
-        if (key_value.size() == 2) {
-            // Trim trailing newlines
-            auto value = string::trim(key_value[1], "\r\n");
-            if (value.size() > 2) {
-                result[key_value[0]] = value.substr(1, value.size() - 2);
-            } else {
-                result[key_value[0]] = "";
-            }
+    while (bytes_received < length) {
+        auto expected_chunk_size = std::min<size_t>(BUFFER_SIZE, length - bytes_received);
+        int receive_chunk_size = httpd_req_recv(request, buffer.get(), expected_chunk_size);
+        if (receive_chunk_size <= 0) {
+            TT_LOG_E(TAG, "Receive failed");
+            break;
         }
+        if (!onChunk(buffer.get(), receive_chunk_size)) {
+            break;
+        }
+        bytes_received += receive_chunk_size;
     }
 
-    return result;
-}
-
-bool readAndDiscardOrSendError(httpd_req_t* request, const std::string& toRead) {
-    size_t bytes_read;
-    auto buffer = receiveByteArray(request, toRead.length(), bytes_read);
-    if (bytes_read != toRead.length()) {
-        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "failed to read discardable data");
-        return false;
-    }
-
-    if (memcmp(buffer.get(), toRead.c_str(), bytes_read) != 0) {
-        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "discardable data mismatch");
-        return false;
-    }
-
-    return true;
+    return bytes_received;
 }
 
 size_t receiveFile(httpd_req_t* request, size_t length, const std::string& filePath) {
-    constexpr auto BUFFER_SIZE = 512;
-    char buffer[BUFFER_SIZE];
-    size_t bytes_received = 0;
-
     auto lock = file::getLock(filePath)->asScopedLock();
     lock.lock();
 
@@ -176,19 +126,13 @@ size_t receiveFile(httpd_req_t* request, size_t length, const std::string& fileP
         return 0;
     }
 
-    while (bytes_received < length) {
-        auto expected_chunk_size = std::min<size_t>(BUFFER_SIZE, length - bytes_received);
-        size_t receive_chunk_size = httpd_req_recv(request, buffer, expected_chunk_size);
-        if (receive_chunk_size <= 0) {
-            TT_LOG_E(TAG, "Receive failed");
-            break;
-        }
-        if (fwrite(buffer, 1, receive_chunk_size, file) != receive_chunk_size) {
+    auto bytes_received = receiveChunks(request, length, [file](const char* data, size_t size) {
+        if (fwrite(data, 1, size, file) != size) {
             TT_LOG_E(TAG, "Failed to write all bytes");
-            break;
+            return false;
         }
-        bytes_received += receive_chunk_size;
-    }
+        return true;
+    });
 
     // Write file
     fclose(file);
@@ -0,0 +1,265 @@
+#include "Tactility/network/MultipartParser.h"
+
+#include <Tactility/Log.h>
+#include <Tactility/StringUtils.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tt::network {
+
+constexpr auto* TAG = "MultipartParser";
+
+/** RFC 2046 */
+constexpr size_t MAX_BOUNDARY_LENGTH = 70;
+
+MultipartParser::MultipartParser(
+    const std::string& boundary,
+    PartBeginFunction onPartBegin,
+    PartDataFunction onPartData,
+    PartEndFunction onPartEnd
+) :
+    delimiter("\r\n--" + boundary),
+    onPartBegin(std::move(onPartBegin)),
+    onPartData(std::move(onPartData)),
+    onPartEnd(std::move(onPartEnd))
+{
+    // The boundary can't contain a CR: consumeContent() relies on it
+    if (boundary.empty() || boundary.size() > MAX_BOUNDARY_LENGTH || boundary.find('\r') != std::string::npos) {
+        TT_LOG_E(TAG, "Invalid boundary");
+        state = State::Error;
+    }
+
+    shiftTable.fill(static_cast<uint8_t>(delimiter.size()));
+    for (size_t i = 0; i < delimiter.size() - 1; i++) {
+        shiftTable[static_cast<uint8_t>(delimiter[i])] = static_cast<uint8_t>(delimiter.size() - 1 - i);
+    }
+
+    // The first boundary isn't preceded by a line break when there is no preamble
+    pending = "\r\n";
+}
+
+bool MultipartParser::fail() {
+    state = State::Error;
+    return false;
+}
+
+size_t MultipartParser::findDelimiter(const char* data, size_t size) const {
+    const auto delimiter_size = delimiter.size();
+    if (size < delimiter_size) {
+        return size;
+    }
+
+    const auto last_character = static_cast<uint8_t>(delimiter[delimiter_size - 1]);
+    size_t index = 0;
+    while (index <= size - delimiter_size) {
+        auto character = static_cast<uint8_t>(data[index + delimiter_size - 1]);
+        if (character == last_character && memcmp(data + index, delimiter.data(), delimiter_size - 1) == 0) {
+            return index;
+        }
+        index += shiftTable[character];
+    }
+
+    return size;
+}
+
+size_t MultipartParser::findPartialDelimiter(const char* data, size_t size) const {
+    // The delimiter only contains a CR at its start, so only the last CR can start a partial delimiter
+    auto window_start = size - std::min(size, delimiter.size() - 1);
+    for (auto index = size; index > window_start; index--) {
+        if (data[index - 1] == '\r') {
+            return (memcmp(data + index - 1, delimiter.data(), size - index + 1) == 0) ? (index - 1) : size;
+        }
+    }
+    return size;
+}
+
+bool MultipartParser::emit(const char* data, size_t size) {
+    if (state == State::Preamble || size == 0) {
+        return true;
+    }
+    statistics.dataBytes += size;
+    return onPartData(data, size);
+}
+
+bool MultipartParser::onDelimiter() {
+    if (state == State::Data && !onPartEnd()) {
+        return false;
+    }
+    state = State::AfterBoundary;
+    afterBoundarySize = 0;
+    return true;
+}
+
+bool MultipartParser::consumeContent(const char*& data, size_t& size) {
+    // Find out whether the data that was kept from the previous chunk is a delimiter
+    if (!pending.empty()) {
+        auto needed = delimiter.size() - pending.size();
+        auto length = std::min(needed, size);
+        if (memcmp(data, delimiter.data() + pending.size(), length) == 0) {
+            if (length < needed) {
+                pending.append(data, length);
+                data += length;
+                size -= length;
+                return true;
+            }
+            data += length;
+            size -= length;
+            pending.clear();
+            return onDelimiter();
+        }
+
+        // A delimiter can't start later in the pending data, because it only contains a CR at its start
+        if (!emit(pending.data(), pending.size())) {
+            return false;
+        }
+        pending.clear();
+    }
+
+    auto index = findDelimiter(data, size);
+    if (index < size) {
+        if (!emit(data, index)) {
+            return false;
+        }
+        data += index + delimiter.size();
+        size -= index + delimiter.size();
+        return onDelimiter();
+    }
+
+    // Keep the end of the data when it might be the start of a delimiter
+    auto partial_index = findPartialDelimiter(data, size);
+    if (!emit(data, partial_index)) {
+        return false;
+    }
+    pending.assign(data + partial_index, size - partial_index);
+    data += size;
+    size = 0;
+    return true;
+}
+
+bool MultipartParser::consumeAfterBoundary(const char*& data, size_t& size) {
+    while (size > 0 && afterBoundarySize < 2) {
+        afterBoundary[afterBoundarySize++] = *data;
+        data++;
+        size--;
+    }
+
+    if (afterBoundarySize < 2) {
+        return true;
+    }
+
+    if (afterBoundary[0] == '-' && afterBoundary[1] == '-') {
+        state = State::End;
+        return true;
+    } else if (afterBoundary[0] == '\r' && afterBoundary[1] == '\n') {
+        state = State::Headers;
+        headers.clear();
+        return true;
+    } else {
+        TT_LOG_E(TAG, "Invalid data after boundary");
+        return false;
+    }
+}
+
+bool MultipartParser::consumeHeaders(const char*& data, size_t& size) {
+    auto previous_size = headers.size();
+    auto length = std::min(size, maxHeaderSize + 4 - previous_size);
+    headers.append(data, length);
+
+    // The headers end with an empty line, which is the first line when there are no headers
+    size_t headers_size;
+    size_t terminator_end;
+    if (headers.starts_with("\r\n")) {
+        headers_size = 0;
+        terminator_end = 2;
+    } else {
+        auto terminator_index = headers.find("\r\n\r\n", (previous_size >= 3) ? (previous_size - 3) : 0);
+        if (terminator_index == std::string::npos) {
+            if (headers.size() >= maxHeaderSize + 4) {
+                TT_LOG_E(TAG, "Headers too large");
+                return false;
+            }
+            data += length;
+            size -= length;
+            return true;
+        }
+        headers_size = terminator_index;
+        terminator_end = terminator_index + 4;
+    }
+
+    auto consumed = terminator_end - previous_size;
+    data += consumed;
+    size -= consumed;
+
+    std::vector<std::string> lines;
+    if (headers_size > 0) {
+        lines = string::split(headers.substr(0, headers_size), "\r\n");
+    }
+
+    statistics.partCount++;
+    state = State::Data;
+    return onPartBegin(lines);
+}
+
+bool MultipartParser::write(const char* data, size_t size) {
+    while (size > 0) {
+        bool success;
+        switch (state) {
+            case State::Preamble:
+            case State::Data:
+                success = consumeContent(data, size);
+                break;
+            case State::AfterBoundary:
+                success = consumeAfterBoundary(data, size);
+                break;
+            case State::Headers:
+                success = consumeHeaders(data, size);
+                break;
+            case State::End:
+                // Ignore the epilogue
+                return true;
+            case State::Error:
+                return false;
+        }
+
+        if (!success) {
+            return fail();
+        }
+    }
+
+    return state != State::Error;
+}
+
+std::map<std::string, std::string> parseContentDisposition(const std::vector<std::string>& headers) {
+    std::map<std::string, std::string> result;
+    static std::string prefix = "Content-Disposition: ";
+
+    // Find header
+    auto content_disposition_header = std::ranges::find_if(headers, [](const std::string& header) {
+        return header.starts_with(prefix);
+    });
+
+    // Header not found
+    if (content_disposition_header == headers.end()) {
+        return result;
+    }
+
+    auto parseable = content_disposition_header->substr(prefix.size());
+    auto parts = string::split(parseable, "; ");
+    for (auto part : parts) {
+        auto key_value = string::split(part, "=");
+        if (key_value.size() == 2) {
+            // Trim trailing newlines
+            auto value = string::trim(key_value[1], "\r\n");
+            if (value.size() > 2) {
+                result[key_value[0]] = value.substr(1, value.size() - 2);
+            } else {
+                result[key_value[0]] = "";
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace tt::network
@@ -3,16 +3,16 @@
 #include <Tactility/service/development/DevelopmentService.h>
 
 #include <Tactility/app/App.h>
+#include <Tactility/app/AppInstaller.h>
 #include <Tactility/app/AppRegistration.h>
 #include <Tactility/file/File.h>
 #include <Tactility/network/HttpdReq.h>
+#include <Tactility/network/MultipartParser.h>
 #include <Tactility/network/Url.h>
 #include <Tactility/Paths.h>
 #include <Tactility/service/development/DevelopmentSettings.h>
 #include <Tactility/service/ServiceRegistration.h>
-#include <Tactility/StringUtils.h>
 
-#include <ranges>
 #include <sstream>
 
 namespace tt::service::development {
@@ -26,7 +26,8 @@ bool DevelopmentService::onStart(ServiceContext& service) {
     stream << "{";
     stream << "\"cpuFamily\":\"" << CONFIG_IDF_TARGET << "\", ";
     stream << "\"osVersion\":\"" << TT_VERSION << "\", ";
-    stream << "\"protocolVersion\":\"1.0.0\"";
+    stream << "\"protocolVersion\":\"1.1.0\", ";
+    stream << "\"screenStreamPort\":" << screenstream::DEFAULT_PORT;
     stream << "}";
     deviceResponse = stream.str();
 
@@ -49,10 +50,16 @@ void DevelopmentService::setEnabled(bool enabled) {
         if (!httpServer.isStarted()) {
             httpServer.start();
         }
+        if (!screenStreamServer.isStarted()) {
+            screenStreamServer.start();
+        }
     } else {
         if (httpServer.isStarted()) {
             httpServer.stop();
         }
+        if (screenStreamServer.isStarted()) {
+            screenStreamServer.stop();
+        }
     }
 }
 
@@ -115,78 +122,88 @@ esp_err_t DevelopmentService::handleAppRun(httpd_req_t* request) {
 esp_err_t DevelopmentService::handleAppInstall(httpd_req_t* request) {
     TT_LOG_I(TAG, "PUT /app/install");
 
+    // Optional: the SHA-256 of the package, to verify its integrity (e.g. "/app/install?sha256=<hex>").
+    // It's not required, because existing development tools don't send it. Without it, the package is installed
+    // as long as it's a valid tar archive.
+    std::string expected_sha256;
+    if (httpd_req_get_url_query_len(request) > 0) {
+        std::string query;
+        if (!network::getQueryOrSendError(request, query)) {
+            return ESP_FAIL;
+        }
+        auto parameters = network::parseUrlQuery(query);
+        auto sha256_key_pos = parameters.find("sha256");
+        if (sha256_key_pos != parameters.end()) {
+            expected_sha256 = sha256_key_pos->second;
+        }
+    }
+
     std::string boundary;
     if (!network::getMultiPartBoundaryOrSendError(request, boundary)) {
         return false;
     }
 
-    size_t content_left = request->content_len;
-
-    // Skip newline after reading boundary
-    auto content_headers_data = network::receiveTextUntil(request, "\r\n\r\n");
-    content_left -= content_headers_data.length();
-    auto content_headers = string::split(content_headers_data, "\r\n")
-        | std::views::filter([](const std::string& line) {
-            return line.length() > 0;
-        })
-        | std::ranges::to<std::vector>();
-
-    auto content_disposition_map = network::parseContentDisposition(content_headers);
-    if (content_disposition_map.empty()) {
-        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Multipart form error: invalid content disposition");
-        return ESP_FAIL;
-    }
-
-    auto name_entry = content_disposition_map.find("name");
-    auto filename_entry = content_disposition_map.find("filename");
-    if (
-        name_entry == content_disposition_map.end() ||
-        filename_entry == content_disposition_map.end() ||
-        name_entry->second != "elf"
-    ) {
-        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Multipart form error: name or filename parameter missing or mismatching");
-        return ESP_FAIL;
-    }
-
-    // Receive boundary
-    auto boundary_and_newlines_after_file = std::format("\r\n--{}--\r\n", boundary);
-    auto file_size = content_left - boundary_and_newlines_after_file.length();
+    // Extract the package while it's being received
+    app::AppInstaller installer;
+    std::string file_name;
+    bool has_package = false;
+    const char* error = nullptr;
+    network::MultipartParser parser(
+        boundary,
+        [&installer, &file_name, &has_package, &error](const std::vector<std::string>& headers) {
+            auto content_disposition_map = network::parseContentDisposition(headers);
+            if (content_disposition_map.empty()) {
+                error = "Multipart form error: invalid content disposition";
+                return false;
+            }
+
+            auto name_entry = content_disposition_map.find("name");
+            auto filename_entry = content_disposition_map.find("filename");
+            if (
+                name_entry == content_disposition_map.end() ||
+                filename_entry == content_disposition_map.end() ||
+                name_entry->second != "elf" ||
+                has_package
+            ) {
+                error = "Multipart form error: name or filename parameter missing or mismatching";
+                return false;
+            }
+
+            file_name = filename_entry->second;
+            has_package = true;
+            return installer.start();
+        },
+        [&installer](const char* data, size_t size) {
+            return installer.write(data, size);
+        },
+        [] { return true; }
+    );
 
-    // Create tmp directory
-    const std::string tmp_path = getTempPath();
-    if (!file::findOrCreateDirectory(tmp_path, 0777)) {
-        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to save file");
-        return ESP_FAIL;
-    }
+    auto bytes_received = network::receiveChunks(request, request->content_len, [&parser](const char* data, size_t size) {
+        return parser.write(data, size);
+    });
 
-    auto file_path = std::format("{}/{}", tmp_path, filename_entry->second);
-    if (network::receiveFile(request, file_size, file_path) != file_size) {
-        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to save file");
+    // When the installer was started, its destructor aborts the installation
+    if (error != nullptr) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, error);
         return ESP_FAIL;
     }
 
-    content_left -= file_size;
-
-    // Read and verify part
-    if (!network::readAndDiscardOrSendError(request, boundary_and_newlines_after_file)) {
+    if (bytes_received != request->content_len || !parser.finish() || !has_package) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to install");
         return ESP_FAIL;
     }
-    content_left -= boundary_and_newlines_after_file.length();
 
-    if (content_left != 0) {
-        TT_LOG_W(TAG, "We have more bytes at the end of the request parsing?!");
+    if (expected_sha256.empty()) {
+        TT_LOG_W(TAG, "/app/install without sha256 parameter: package integrity is not verified");
     }
 
-    if (!app::install(file_path)) {
+    if (!installer.finish(expected_sha256)) {
         httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to install");
         return ESP_FAIL;
     }
 
-    if (!file::deleteFile(file_path.c_str())) {
-        TT_LOG_W(TAG, "Failed to delete %s", file_path.c_str());
-    }
-
-    TT_LOG_I(TAG, "[200] /app/install -> %s", file_path.c_str());
+    TT_LOG_I(TAG, "[200] /app/install -> %s (SHA-256 %s)", file_name.c_str(), installer.getSha256().c_str());
 
     httpd_resp_send(request, nullptr, 0);
 
@@ -0,0 +1,211 @@
+#include <Tactility/service/development/LvglScreenSource.h>
+
+#include <Tactility/Log.h>
+#include <Tactility/lvgl/LvglSync.h>
+
+namespace tt::service::development {
+
+constexpr auto* TAG = "LvglScreenSource";
+
+static bool toPixelFormat(lv_color_format_t colorFormat, ScreenBuffer::PixelFormat& pixelFormat) {
+    switch (colorFormat) {
+        case LV_COLOR_FORMAT_RGB565:
+            pixelFormat = ScreenBuffer::PixelFormat::RGB565;
+            return true;
+        case LV_COLOR_FORMAT_RGB888:
+            pixelFormat = ScreenBuffer::PixelFormat::RGB888;
+            return true;
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_ARGB8888:
+            pixelFormat = ScreenBuffer::PixelFormat::XRGB8888;
+            return true;
+        default:
+            return false;
+    }
+}
+
+LvglScreenSource::~LvglScreenSource() {
+    stop();
+}
+
+/** Called by LVGL right before an area is passed to the display driver */
+void LvglScreenSource::onFlushStart(lv_event_t* event) {
+    auto* source = static_cast<LvglScreenSource*>(lv_event_get_user_data(event));
+    const auto* area = static_cast<const lv_area_t*>(lv_event_get_param(event));
+    auto* display = source->display;
+    const lv_draw_buf_t* draw_buffer = lv_display_get_buf_active(display);
+    ScreenBuffer::PixelFormat pixel_format;
+    if (area == nullptr || draw_buffer == nullptr || !toPixelFormat(lv_display_get_color_format(display), pixel_format)) {
+        return;
+    }
+
+    const int32_t width = lv_area_get_width(area);
+    const int32_t height = lv_area_get_height(area);
+    const uint8_t* data = draw_buffer->data;
+    if (static_cast<int32_t>(draw_buffer->header.w) != width || static_cast<int32_t>(draw_buffer->header.h) != height) {
+        // Full and direct render modes: the buffer holds the entire screen
+        const uint32_t pixel_size = lv_color_format_get_size(lv_display_get_color_format(display));
+        data += area->y1 * draw_buffer->header.stride + area->x1 * pixel_size;
+    }
+
+    source->buffer->write(
+        {
+            .x = static_cast<uint16_t>(area->x1),
+            .y = static_cast<uint16_t>(area->y1),
+            .width = static_cast<uint16_t>(width),
+            .height = static_cast<uint16_t>(height)
+        },
+        data,
+        draw_buffer->header.stride,
+        pixel_format
+    );
+}
+
+void LvglScreenSource::onResolutionChanged(lv_event_t* event) {
+    auto* source = static_cast<LvglScreenSource*>(lv_event_get_user_data(event));
+    auto* display = source->display;
+    // LVGL redraws the entire screen afterwards
+    source->buffer->setSize(lv_display_get_horizontal_resolution(display), lv_display_get_vertical_resolution(display));
+}
+
+void LvglScreenSource::readPointer(lv_indev_t* indev, lv_indev_data_t* data) {
+    auto* source = static_cast<LvglScreenSource*>(lv_indev_get_user_data(indev));
+    auto lock = source->mutex.asScopedLock();
+    lock.lock();
+
+    if (!source->pointerEvents.empty()) {
+        source->pointerState = source->pointerEvents.front();
+        source->pointerEvents.pop_front();
+        source->buffer->setConsumedInputSequence(source->pointerState.sequence);
+        // Don't wait for the next read period: presses and releases would get lost
+        data->continue_reading = !source->pointerEvents.empty();
+    }
+
+    data->point.x = source->pointerState.x;
+    data->point.y = source->pointerState.y;
+    data->state = source->pointerState.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void LvglScreenSource::readKeypad(lv_indev_t* indev, lv_indev_data_t* data) {
+    auto* source = static_cast<LvglScreenSource*>(lv_indev_get_user_data(indev));
+    auto lock = source->mutex.asScopedLock();
+    lock.lock();
+
+    if (!source->keyEvents.empty()) {
+        source->keyState = source->keyEvents.front();
+        source->keyEvents.pop_front();
+        source->buffer->setConsumedInputSequence(source->keyState.sequence);
+        data->continue_reading = !source->keyEvents.empty();
+    }
+
+    data->key = source->keyState.key;
+    data->state = source->keyState.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+bool LvglScreenSource::start(std::shared_ptr<ScreenBuffer> newBuffer) {
+    // The LVGL lock protects the display and the input devices: the callbacks run while it's held
+    if (!lvgl::lock(lvgl::defaultLockTime)) {
+        TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
+        return false;
+    }
+
+    bool success = false;
+    auto* default_display = lv_display_get_default();
+    ScreenBuffer::PixelFormat pixel_format;
+    if (display != nullptr) {
+        TT_LOG_W(TAG, "Already started");
+    } else if (default_display == nullptr) {
+        TT_LOG_E(TAG, "No display");
+    } else if (!toPixelFormat(lv_display_get_color_format(default_display), pixel_format)) {
+        TT_LOG_E(TAG, "Color format %d is not supported", lv_display_get_color_format(default_display));
+    } else if (newBuffer->setSize(lv_display_get_horizontal_resolution(default_display), lv_display_get_vertical_resolution(default_display))) {
+        buffer = std::move(newBuffer);
+        display = default_display;
+
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        pointerEvents.clear();
+        keyEvents.clear();
+        pointerState = { 0, 0, 0, false };
+        keyState = { 0, 0, false };
+        lock.unlock();
+
+        lv_display_add_event_cb(display, onFlushStart, LV_EVENT_FLUSH_START, this);
+        lv_display_add_event_cb(display, onResolutionChanged, LV_EVENT_RESOLUTION_CHANGED, this);
+
+        pointer = lv_indev_create();
+        lv_indev_set_type(pointer, LV_INDEV_TYPE_POINTER);
+        lv_indev_set_display(pointer, display);
+        lv_indev_set_user_data(pointer, this);
+        lv_indev_set_read_cb(pointer, readPointer);
+
+        keypad = lv_indev_create();
+        lv_indev_set_type(keypad, LV_INDEV_TYPE_KEYPAD);
+        lv_indev_set_display(keypad, display);
+        lv_indev_set_user_data(keypad, this);
+        lv_indev_set_read_cb(keypad, readKeypad);
+        lv_indev_set_group(keypad, lv_group_get_default());
+
+        // Render everything once, so the buffer gets the current screen
+        lv_obj_invalidate(lv_display_get_screen_active(display));
+        success = true;
+    }
+
+    lvgl::unlock();
+    return success;
+}
+
+void LvglScreenSource::stop() {
+    // Waits for LVGL, so the callbacks aren't running anymore afterwards
+    if (!lvgl::lock(portMAX_DELAY)) {
+        return;
+    }
+
+    if (display != nullptr) {
+        lv_display_remove_event_cb_with_user_data(display, onFlushStart, this);
+        lv_display_remove_event_cb_with_user_data(display, onResolutionChanged, this);
+        lv_indev_delete(pointer);
+        lv_indev_delete(keypad);
+        pointer = nullptr;
+        keypad = nullptr;
+        display = nullptr;
+        buffer = nullptr;
+    }
+
+    lvgl::unlock();
+}
+
+void LvglScreenSource::refresh() {
+    if (lvgl::lock(lvgl::defaultLockTime)) {
+        if (display != nullptr) {
+            lv_obj_invalidate(lv_display_get_screen_active(display));
+        }
+        lvgl::unlock();
+    }
+}
+
+void LvglScreenSource::injectPointer(uint32_t sequence, int16_t x, int16_t y, bool pressed) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (pointerEvents.size() >= MAX_QUEUED_EVENTS) {
+        TT_LOG_W(TAG, "Pointer queue full");
+        return;
+    }
+
+    pointerEvents.push_back({ sequence, x, y, pressed });
+}
+
+void LvglScreenSource::injectKey(uint32_t sequence, uint32_t key, bool pressed) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (keyEvents.size() >= MAX_QUEUED_EVENTS) {
+        TT_LOG_W(TAG, "Key queue full");
+        return;
+    }
+
+    keyEvents.push_back({ sequence, key, pressed });
+}
+
+} // namespace tt::service::development
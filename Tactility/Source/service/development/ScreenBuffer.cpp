@@ -0,0 +1,213 @@
+#include <Tactility/service/development/ScreenBuffer.h>
+
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Log.h>
+#include <Tactility/service/development/ScreenStreamProtocol.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace tt::service::development {
+
+constexpr auto* TAG = "ScreenBuffer";
+constexpr uint32_t CHANGE_FLAG = 1;
+
+using Area = ScreenBuffer::Area;
+
+static bool contains(const Area& outer, const Area& inner) {
+    return inner.x >= outer.x &&
+        inner.y >= outer.y &&
+        inner.x + inner.width <= outer.x + outer.width &&
+        inner.y + inner.height <= outer.y + outer.height;
+}
+
+static Area getUnion(const Area& first, const Area& second) {
+    const uint16_t left = std::min(first.x, second.x);
+    const uint16_t top = std::min(first.y, second.y);
+    const uint16_t right = std::max(first.x + first.width, second.x + second.width);
+    const uint16_t bottom = std::max(first.y + first.height, second.y + second.height);
+    return {
+        .x = left,
+        .y = top,
+        .width = static_cast<uint16_t>(right - left),
+        .height = static_cast<uint16_t>(bottom - top)
+    };
+}
+
+static uint16_t toRgb565(uint8_t red, uint8_t green, uint8_t blue) {
+    return ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3);
+}
+
+void ScreenBuffer::addDirtyArea(Area area) {
+    if (area.getSize() == 0) {
+        return;
+    }
+
+    changeFlag.set(CHANGE_FLAG);
+    if (dirtyAreas.empty()) {
+        dirtyTime = kernel::getTicks();
+    }
+
+    // Merge with the areas that it touches or overlaps, as long as that doesn't add unchanged pixels
+    bool merged;
+    do {
+        merged = false;
+        for (auto iterator = dirtyAreas.begin(); iterator != dirtyAreas.end(); ++iterator) {
+            if (contains(*iterator, area)) {
+                return;
+            }
+            const auto merged_area = getUnion(*iterator, area);
+            if (merged_area.getSize() <= iterator->getSize() + area.getSize()) {
+                area = merged_area;
+                dirtyAreas.erase(iterator);
+                merged = true;
+                break;
+            }
+        }
+    } while (merged);
+
+    if (dirtyAreas.size() >= MAX_DIRTY_AREAS) {
+        // Merge with the area that grows the least
+        auto best = std::ranges::min_element(dirtyAreas, {}, [&area](const auto& existing) {
+            return getUnion(existing, area).getSize() - existing.getSize();
+        });
+        area = getUnion(*best, area);
+        dirtyAreas.erase(best);
+        std::erase_if(dirtyAreas, [&area](const auto& existing) { return contains(area, existing); });
+    }
+
+    dirtyAreas.push_back(area);
+}
+
+bool ScreenBuffer::setSize(uint16_t newWidth, uint16_t newHeight) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (newWidth != width || newHeight != height || pixels == nullptr) {
+        pixels = nullptr;
+        width = 0;
+        height = 0;
+        dirtyAreas.clear();
+
+        auto* new_pixels = new(std::nothrow) uint16_t[static_cast<size_t>(newWidth) * newHeight];
+        if (new_pixels == nullptr) {
+            TT_LOG_E(TAG, "Failed to allocate %ux%u pixels", newWidth, newHeight);
+            return false;
+        }
+
+        std::memset(new_pixels, 0, static_cast<size_t>(newWidth) * newHeight * sizeof(uint16_t));
+        pixels.reset(new_pixels);
+        width = newWidth;
+        height = newHeight;
+        changeFlag.set(CHANGE_FLAG);
+    }
+
+    return true;
+}
+
+uint16_t ScreenBuffer::getWidth() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return width;
+}
+
+uint16_t ScreenBuffer::getHeight() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return height;
+}
+
+void ScreenBuffer::write(const Area& area, const uint8_t* data, size_t stride, PixelFormat format) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (area.x >= width || area.y >= height || area.width == 0 || area.height == 0) {
+        return;
+    }
+
+    const uint16_t clipped_width = std::min<uint16_t>(area.width, width - area.x);
+    const uint16_t clipped_height = std::min<uint16_t>(area.height, height - area.y);
+
+    for (uint16_t row = 0; row < clipped_height; row++) {
+        const uint8_t* source = data + row * stride;
+        uint16_t* target = pixels.get() + (area.y + row) * width + area.x;
+        switch (format) {
+            case PixelFormat::RGB565:
+                std::memcpy(target, source, clipped_width * sizeof(uint16_t));
+                break;
+            case PixelFormat::RGB888:
+                for (uint16_t column = 0; column < clipped_width; column++) {
+                    target[column] = toRgb565(source[2], source[1], source[0]);
+                    source += 3;
+                }
+                break;
+            case PixelFormat::XRGB8888:
+                for (uint16_t column = 0; column < clipped_width; column++) {
+                    target[column] = toRgb565(source[2], source[1], source[0]);
+                    source += 4;
+                }
+                break;
+        }
+    }
+
+    renderedInputSequence = consumedInputSequence;
+    addDirtyArea({ .x = area.x, .y = area.y, .width = clipped_width, .height = clipped_height });
+}
+
+void ScreenBuffer::invalidate() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    dirtyAreas.clear();
+    addDirtyArea({ .x = 0, .y = 0, .width = width, .height = height });
+}
+
+void ScreenBuffer::setConsumedInputSequence(uint32_t sequence) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    consumedInputSequence = sequence;
+}
+
+bool ScreenBuffer::hasChanges() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return !dirtyAreas.empty();
+}
+
+bool ScreenBuffer::waitForChanges(TickType_t timeout) const {
+    if (hasChanges()) {
+        return true;
+    }
+    // The flag can be left over from changes that were already taken, so the changes are checked again
+    changeFlag.wait(CHANGE_FLAG, EventFlag::WaitAny, timeout);
+    return hasChanges();
+}
+
+bool ScreenBuffer::takeChanges(Changes& changes) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (dirtyAreas.empty()) {
+        return false;
+    }
+
+    changes.areas = std::move(dirtyAreas);
+    changes.time = dirtyTime;
+    changes.inputSequence = renderedInputSequence;
+    dirtyAreas.clear();
+    return true;
+}
+
+void ScreenBuffer::encode(const Area& area, std::vector<uint8_t>& output) const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    const uint16_t x = std::min(area.x, width);
+    const uint16_t y = std::min(area.y, height);
+    const uint16_t clipped_width = std::min<uint16_t>(area.width, width - x);
+    const uint16_t clipped_height = std::min<uint16_t>(area.height, height - y);
+    const uint16_t* first_pixel = (pixels != nullptr) ? pixels.get() + y * width + x : nullptr;
+    screenstream::appendRect(output, x, y, first_pixel, clipped_width, clipped_height, width);
+}
+
+} // namespace tt::service::development
@@ -0,0 +1,133 @@
+#include <Tactility/service/development/ScreenStreamProtocol.h>
+
+#include <Tactility/Crc32.h>
+
+namespace tt::service::development::screenstream {
+
+constexpr size_t MAX_LITERAL_COUNT = 128;
+constexpr size_t MAX_RUN_LENGTH = 129;
+
+size_t getClientMessageSize(uint8_t type) {
+    switch (static_cast<MessageType>(type)) {
+        case MessageType::Configure:
+            return CONFIGURE_SIZE;
+        case MessageType::Pointer:
+            return POINTER_SIZE;
+        case MessageType::Key:
+            return KEY_SIZE;
+        case MessageType::Refresh:
+            return REFRESH_SIZE;
+        default:
+            return 0;
+    }
+}
+
+void appendUint16(std::vector<uint8_t>& output, uint16_t value) {
+    output.push_back(value & 0xFF);
+    output.push_back(value >> 8);
+}
+
+void appendUint32(std::vector<uint8_t>& output, uint32_t value) {
+    appendUint16(output, value & 0xFFFF);
+    appendUint16(output, value >> 16);
+}
+
+uint16_t readUint16(const uint8_t* data) {
+    return data[0] | (data[1] << 8);
+}
+
+uint32_t readUint32(const uint8_t* data) {
+    return readUint16(data) | (static_cast<uint32_t>(readUint16(data + 2)) << 16);
+}
+
+void appendRle(std::vector<uint8_t>& output, const uint16_t* pixels, uint16_t width, uint16_t height, size_t stride) {
+    uint16_t literals[MAX_LITERAL_COUNT];
+    size_t literal_count = 0;
+    uint16_t run_pixel = 0;
+    size_t run_length = 0;
+
+    auto flush_literals = [&] {
+        if (literal_count > 0) {
+            output.push_back(literal_count - 1);
+            for (size_t i = 0; i < literal_count; i++) {
+                appendUint16(output, literals[i]);
+            }
+            literal_count = 0;
+        }
+    };
+
+    auto flush_run = [&] {
+        // A repeat packet ends the current literal packet: only worth it for runs of 3 or more
+        if (run_length >= 3 || (run_length == 2 && literal_count == 0)) {
+            flush_literals();
+            output.push_back(0x80 + (run_length - 2));
+            appendUint16(output, run_pixel);
+        } else {
+            for (size_t i = 0; i < run_length; i++) {
+                literals[literal_count++] = run_pixel;
+                if (literal_count == MAX_LITERAL_COUNT) {
+                    flush_literals();
+                }
+            }
+        }
+        run_length = 0;
+    };
+
+    for (uint16_t y = 0; y < height; y++) {
+        const uint16_t* row = pixels + y * stride;
+        for (uint16_t x = 0; x < width; x++) {
+            const uint16_t pixel = row[x];
+            if (run_length > 0 && pixel == run_pixel && run_length < MAX_RUN_LENGTH) {
+                run_length++;
+            } else {
+                flush_run();
+                run_pixel = pixel;
+                run_length = 1;
+            }
+        }
+    }
+
+    flush_run();
+    flush_literals();
+}
+
+void appendRect(std::vector<uint8_t>& output, uint16_t x, uint16_t y, const uint16_t* pixels, uint16_t width, uint16_t height, size_t stride) {
+    uint32_t crc = 0;
+    for (uint16_t row = 0; row < height; row++) {
+        crc = crc32(pixels + row * stride, width * sizeof(uint16_t), crc);
+    }
+
+    appendUint16(output, x);
+    appendUint16(output, y);
+    appendUint16(output, width);
+    appendUint16(output, height);
+    const size_t encoding_offset = output.size();
+    output.push_back(static_cast<uint8_t>(Encoding::Rle));
+    appendUint32(output, crc);
+    const size_t payload_size_offset = output.size();
+    appendUint32(output, 0);
+
+    const size_t payload_offset = output.size();
+    const size_t raw_size = static_cast<size_t>(width) * height * sizeof(uint16_t);
+    appendRle(output, pixels, width, height, stride);
+
+    if (output.size() - payload_offset >= raw_size) {
+        // Noise-like content: the raw pixels are smaller
+        output.resize(payload_offset);
+        output[encoding_offset] = static_cast<uint8_t>(Encoding::Raw);
+        for (uint16_t row = 0; row < height; row++) {
+            const uint16_t* row_pixels = pixels + row * stride;
+            for (uint16_t column = 0; column < width; column++) {
+                appendUint16(output, row_pixels[column]);
+            }
+        }
+    }
+
+    const uint32_t payload_size = output.size() - payload_offset;
+    output[payload_size_offset] = payload_size & 0xFF;
+    output[payload_size_offset + 1] = (payload_size >> 8) & 0xFF;
+    output[payload_size_offset + 2] = (payload_size >> 16) & 0xFF;
+    output[payload_size_offset + 3] = payload_size >> 24;
+}
+
+} // namespace tt::service::development::screenstream
@@ -0,0 +1,355 @@
+#include <Tactility/service/development/ScreenStreamServer.h>
+
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // Not available on macOS
+#endif
+
+namespace tt::service::development {
+
+constexpr auto* TAG = "ScreenStream";
+constexpr uint32_t SEND_TIMEOUT_MILLIS = 5000;
+constexpr uint32_t ACCEPT_POLL_INTERVAL_MILLIS = 50;
+/** How often the socket is checked for input while waiting for changes to the screen */
+constexpr uint32_t INPUT_POLL_INTERVAL_MILLIS = 10;
+
+using namespace screenstream;
+
+struct ScreenStreamServer::Session {
+    int socket = -1;
+    std::shared_ptr<ScreenBuffer> buffer;
+    uint16_t maxFramesPerSecond = 0;
+    uint32_t maxBytesPerSecond = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint32_t frameSequence = 0;
+    TickType_t nextFrameTime = 0;
+    uint8_t received[32] = {};
+    size_t receivedSize = 0;
+    std::vector<uint8_t> output;
+};
+
+static bool setNonBlocking(int socket) {
+    const int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/** Sockets are non-blocking, as a blocking call would stall the FreeRTOS scheduler on POSIX */
+static bool isWouldBlock() {
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+ScreenStreamServer::ScreenStreamServer(std::shared_ptr<ScreenSource> source, Configuration configuration) :
+    configuration(std::move(configuration)),
+    source(std::move(source))
+{}
+
+ScreenStreamServer::~ScreenStreamServer() {
+    stop();
+}
+
+bool ScreenStreamServer::start() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (thread != nullptr) {
+        TT_LOG_W(TAG, "Already started");
+        return true;
+    }
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(configuration.port);
+    if (inet_pton(AF_INET, configuration.address.c_str(), &address.sin_addr) != 1) {
+        TT_LOG_E(TAG, "Invalid address %s", configuration.address.c_str());
+        return false;
+    }
+
+    serverSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (serverSocket < 0) {
+        TT_LOG_E(TAG, "Failed to create socket");
+        return false;
+    }
+
+    const int reuse = 1;
+    setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    socklen_t address_size = sizeof(address);
+    if (
+        bind(serverSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(serverSocket, 1) != 0 ||
+        !setNonBlocking(serverSocket) ||
+        getsockname(serverSocket, reinterpret_cast<sockaddr*>(&address), &address_size) != 0
+    ) {
+        TT_LOG_E(TAG, "Failed to listen on %s:%u (%s)", configuration.address.c_str(), configuration.port, strerror(errno));
+        close(serverSocket);
+        serverSocket = -1;
+        return false;
+    }
+
+    port = ntohs(address.sin_port);
+    interrupted = false;
+    thread = std::make_unique<Thread>(
+        "screen_stream",
+        4096,
+        [this] { return threadMain(); }
+    );
+    thread->setPriority(Thread::Priority::Low);
+    thread->start();
+
+    TT_LOG_I(TAG, "Listening on %s:%u", configuration.address.c_str(), port);
+    return true;
+}
+
+void ScreenStreamServer::stop() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (thread == nullptr) {
+        return;
+    }
+
+    interrupted = true;
+    thread->join();
+    thread = nullptr;
+    close(serverSocket);
+    serverSocket = -1;
+    port = 0;
+}
+
+bool ScreenStreamServer::isStarted() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return thread != nullptr;
+}
+
+uint16_t ScreenStreamServer::getPort() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return port;
+}
+
+int32_t ScreenStreamServer::threadMain() {
+    while (!interrupted) {
+        const int client_socket = accept(serverSocket, nullptr, nullptr);
+        if (client_socket >= 0) {
+            serve(client_socket);
+            close(client_socket);
+        } else if (isWouldBlock()) {
+            kernel::delayMillis(ACCEPT_POLL_INTERVAL_MILLIS);
+        } else {
+            TT_LOG_E(TAG, "Accept failed (%s)", strerror(errno));
+            kernel::delayMillis(1000);
+        }
+    }
+    return 0;
+}
+
+void ScreenStreamServer::serve(int clientSocket) {
+    const int no_delay = 1;
+    setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    if (!setNonBlocking(clientSocket)) {
+        TT_LOG_E(TAG, "Failed to configure client socket");
+        return;
+    }
+
+    Session session;
+    session.socket = clientSocket;
+    session.buffer = std::make_shared<ScreenBuffer>();
+    session.maxFramesPerSecond = configuration.maxFramesPerSecond;
+    session.maxBytesPerSecond = configuration.maxBytesPerSecond;
+    session.nextFrameTime = kernel::getTicks();
+
+    if (!source->start(session.buffer)) {
+        TT_LOG_E(TAG, "Failed to start the screen source");
+        return;
+    }
+
+    TT_LOG_I(TAG, "Client connected");
+
+    while (!interrupted && receive(session)) {
+        const auto width = session.buffer->getWidth();
+        const auto height = session.buffer->getHeight();
+        if ((width != session.width || height != session.height) && !sendHello(session)) {
+            break;
+        }
+
+        // Waits on the buffer instead of the socket: a blocking socket call would stall the FreeRTOS scheduler on POSIX
+        const auto input_poll_interval = kernel::millisToTicks(INPUT_POLL_INTERVAL_MILLIS);
+        const auto frame_delay = static_cast<int32_t>(session.nextFrameTime - kernel::getTicks());
+        if (frame_delay > 0) {
+            // Changes are merged until the next frame can be sent
+            kernel::delayTicks(std::min<TickType_t>(frame_delay, input_poll_interval));
+        } else if (session.buffer->waitForChanges(input_poll_interval) && !sendFrame(session)) {
+            break;
+        }
+    }
+
+    source->stop();
+    TT_LOG_I(TAG, "Client disconnected after %lu frames", static_cast<unsigned long>(session.frameSequence));
+}
+
+bool ScreenStreamServer::sendAll(int socket, const uint8_t* data, size_t size) const {
+    const auto start_time = kernel::getTicks();
+    const auto timeout = kernel::millisToTicks(SEND_TIMEOUT_MILLIS);
+    while (size > 0) {
+        const auto sent = send(socket, data, size, MSG_NOSIGNAL);
+        if (sent > 0) {
+            data += sent;
+            size -= sent;
+        } else if (sent < 0 && isWouldBlock() && !interrupted && (kernel::getTicks() - start_time) < timeout) {
+            kernel::delayTicks(1);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ScreenStreamServer::sendHello(Session& session) {
+    session.width = session.buffer->getWidth();
+    session.height = session.buffer->getHeight();
+
+    auto& output = session.output;
+    output.clear();
+    output.push_back(static_cast<uint8_t>(MessageType::Hello));
+    output.push_back(PROTOCOL_VERSION);
+    appendUint16(output, session.width);
+    appendUint16(output, session.height);
+    output.push_back(static_cast<uint8_t>(PixelFormat::RGB565));
+    appendUint16(output, session.maxFramesPerSecond);
+    appendUint32(output, session.maxBytesPerSecond);
+    return sendAll(session.socket, output.data(), output.size());
+}
+
+bool ScreenStreamServer::sendFrame(Session& session) {
+    const auto frame_start_time = kernel::getTicks();
+    ScreenBuffer::Changes changes;
+    if (!session.buffer->takeChanges(changes)) {
+        return true;
+    }
+
+    // Split the areas into bands, so a band can be encoded without a lot of memory
+    std::vector<ScreenBuffer::Area> bands;
+    for (const auto& area : changes.areas) {
+        const uint16_t band_height = std::max<uint32_t>(1, configuration.maxBandPixels / area.width);
+        for (uint32_t y = area.y; y < area.y + area.height; y += band_height) {
+            bands.push_back({
+                .x = area.x,
+                .y = static_cast<uint16_t>(y),
+                .width = area.width,
+                .height = static_cast<uint16_t>(std::min<uint32_t>(band_height, area.y + area.height - y))
+            });
+        }
+    }
+
+    session.frameSequence++;
+    auto& output = session.output;
+    output.clear();
+    output.push_back(static_cast<uint8_t>(MessageType::Frame));
+    appendUint32(output, session.frameSequence);
+    appendUint32(output, (frame_start_time - changes.time) * portTICK_PERIOD_MS);
+    appendUint32(output, changes.inputSequence);
+    appendUint16(output, bands.size());
+    size_t bytes_sent = output.size();
+    if (!sendAll(session.socket, output.data(), output.size())) {
+        return false;
+    }
+
+    for (const auto& band : bands) {
+        output.clear();
+        session.buffer->encode(band, output);
+        bytes_sent += output.size();
+        if (!sendAll(session.socket, output.data(), output.size())) {
+            return false;
+        }
+        // Incoming input shouldn't wait for a large frame
+        if (!receive(session)) {
+            return false;
+        }
+    }
+
+    const uint32_t frame_millis = 1000 / std::max<uint16_t>(session.maxFramesPerSecond, 1);
+    const uint32_t bandwidth_millis = static_cast<uint64_t>(bytes_sent) * 1000 / std::max<uint32_t>(session.maxBytesPerSecond, 1);
+    session.nextFrameTime = frame_start_time + kernel::millisToTicks(std::max(frame_millis, bandwidth_millis));
+    return true;
+}
+
+bool ScreenStreamServer::receive(Session& session) {
+    while (true) {
+        const auto received = recv(
+            session.socket,
+            session.received + session.receivedSize,
+            sizeof(session.received) - session.receivedSize,
+            0
+        );
+
+        if (received == 0) {
+            return false; // Closed by the client
+        } else if (received < 0) {
+            return isWouldBlock();
+        }
+
+        session.receivedSize += received;
+        size_t offset = 0;
+        while (offset < session.receivedSize) {
+            const size_t message_size = getClientMessageSize(session.received[offset]);
+            if (message_size == 0) {
+                TT_LOG_E(TAG, "Unknown message type %u", session.received[offset]);
+                return false;
+            }
+            if (session.receivedSize - offset < message_size) {
+                break;
+            }
+            handleMessage(session, session.received + offset);
+            offset += message_size;
+        }
+
+        session.receivedSize -= offset;
+        std::memmove(session.received, session.received + offset, session.receivedSize);
+    }
+}
+
+void ScreenStreamServer::handleMessage(Session& session, const uint8_t* message) {
+    switch (static_cast<MessageType>(message[0])) {
+        case MessageType::Configure: {
+            const uint16_t max_frames_per_second = readUint16(message + 1);
+            const uint32_t max_bytes_per_second = readUint32(message + 3);
+            // The client can lower the limits, but not raise them: 0 means the maximum
+            session.maxFramesPerSecond = (max_frames_per_second == 0) ? configuration.maxFramesPerSecond : std::min(max_frames_per_second, configuration.maxFramesPerSecond);
+            session.maxBytesPerSecond = (max_bytes_per_second == 0) ? configuration.maxBytesPerSecond : std::min(max_bytes_per_second, configuration.maxBytesPerSecond);
+            TT_LOG_I(TAG, "Limited to %u fps and %lu bytes/s", session.maxFramesPerSecond, static_cast<unsigned long>(session.maxBytesPerSecond));
+            break;
+        }
+        case MessageType::Pointer:
+            source->injectPointer(
+                readUint32(message + 1),
+                static_cast<int16_t>(readUint16(message + 5)),
+                static_cast<int16_t>(readUint16(message + 7)),
+                message[9] != 0
+            );
+            break;
+        case MessageType::Key:
+            source->injectKey(readUint32(message + 1), readUint32(message + 5), message[9] != 0);
+            break;
+        case MessageType::Refresh:
+            source->refresh();
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace tt::service::development
@@ -1,5 +1,3 @@
-#ifdef ESP_PLATFORM
-
 #include "Tactility/service/espnow/EspNow.h"
 #include "Tactility/service/espnow/EspNowService.h"
 
@@ -36,6 +34,7 @@ bool isEnabled() {
     }
 }
 
+#ifdef ESP_PLATFORM
 bool addPeer(const esp_now_peer_info_t& peer) {
     auto service = findService();
     if (service != nullptr) {
@@ -45,18 +44,19 @@ bool addPeer(const esp_now_peer_info_t& peer) {
         return false;
     }
 }
+#endif
 
-bool send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength) {
+bool send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength, SendCompleteFunction onComplete) {
     auto service = findService();
     if (service != nullptr) {
-        return service->send(address, buffer, bufferLength);
+        return service->send(address, buffer, bufferLength, std::move(onComplete));
     } else {
         TT_LOG_E(TAG, "Service not found");
         return false;
     }
 }
 
-ReceiverSubscription subscribeReceiver(std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive) {
+ReceiverSubscription subscribeReceiver(ReceiveFunction onReceive) {
     auto service = findService();
     if (service != nullptr) {
         return service->subscribeReceiver(onReceive);
@@ -75,6 +75,22 @@ void unsubscribeReceiver(ReceiverSubscription subscription) {
     }
 }
 
+Statistics getStatistics() {
+    auto service = findService();
+    if (service != nullptr) {
+        return service->getStatistics();
+    } else {
+        return {};
+    }
+}
+
+std::vector<PeerStatistics> getPeerStatistics() {
+    auto service = findService();
+    if (service != nullptr) {
+        return service->getPeerStatistics();
+    } else {
+        return {};
+    }
 }
 
-#endif // ESP_PLATFORM
+}
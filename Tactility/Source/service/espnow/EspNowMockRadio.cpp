@@ -0,0 +1,47 @@
+#include "Tactility/service/espnow/EspNowMockRadio.h"
+
+namespace tt::service::espnow {
+
+bool EspNowMockRadio::start(const EspNowConfig& config, ReceiveFunction newOnReceive, SendCompleteFunction newOnSendComplete) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    onReceive = std::move(newOnReceive);
+    onSendComplete = std::move(newOnSendComplete);
+    started = true;
+    return true;
+}
+
+void EspNowMockRadio::stop() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    started = false;
+    onReceive = nullptr;
+    onSendComplete = nullptr;
+}
+
+bool EspNowMockRadio::send(const uint8_t* destinationAddress, const uint8_t* data, size_t length) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (!started) {
+        return false;
+    }
+
+    sentFrames++;
+    if (loopback) {
+        onReceive(destinationAddress, address, 0, data, length);
+    }
+    onSendComplete(true);
+    return true;
+}
+
+void EspNowMockRadio::receive(const uint8_t* sourceAddress, int8_t rssi, const uint8_t* data, size_t length) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (started) {
+        onReceive(sourceAddress, address, rssi, data, length);
+    }
+}
+
+}
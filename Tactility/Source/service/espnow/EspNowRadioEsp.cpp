@@ -0,0 +1,134 @@
+#ifdef ESP_PLATFORM
+
+#include "Tactility/service/espnow/EspNowRadio.h"
+#include "Tactility/service/espnow/EspNowWifi.h"
+
+#include <Tactility/Log.h>
+
+#include <atomic>
+#include <cstring>
+#include <esp_now.h>
+
+namespace tt::service::espnow {
+
+constexpr const char* TAG = "EspNowRadio";
+
+class EspNowRadioEsp;
+
+/** The ESP-NOW callbacks don't have a context parameter */
+static std::atomic<EspNowRadioEsp*> activeRadio = nullptr;
+
+class EspNowRadioEsp final : public EspNowRadio {
+
+    ReceiveFunction onReceive;
+    SendCompleteFunction onSendComplete;
+    bool started = false;
+
+    static void receiveCallback(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length) {
+        auto* radio = activeRadio.load();
+        if (radio != nullptr) {
+            radio->onReceive(receiveInfo->src_addr, receiveInfo->des_addr, receiveInfo->rx_ctrl->rssi, data, length);
+        }
+    }
+
+    /** The type of the first parameter differs between ESP-IDF versions, and it isn't used */
+    template<typename SendInfo>
+    static void sendCallback(SendInfo sendInfo, esp_now_send_status_t status) {
+        auto* radio = activeRadio.load();
+        if (radio != nullptr) {
+            radio->onSendComplete(status == ESP_NOW_SEND_SUCCESS);
+        }
+    }
+
+    void deinit() {
+        activeRadio = nullptr;
+
+        if (esp_now_deinit() != ESP_OK) {
+            TT_LOG_E(TAG, "esp_now_deinit() failed");
+        }
+
+        if (!deinitWifi()) {
+            TT_LOG_E(TAG, "deinitWifi() failed");
+        }
+    }
+
+public:
+
+    ~EspNowRadioEsp() override {
+        stop();
+    }
+
+    bool start(const EspNowConfig& config, ReceiveFunction newOnReceive, SendCompleteFunction newOnSendComplete) override {
+        if (started) {
+            return true;
+        }
+
+        if (!initWifi(config)) {
+            TT_LOG_E(TAG, "initWifi() failed");
+            return false;
+        }
+
+        if (esp_now_init() != ESP_OK) {
+            TT_LOG_E(TAG, "esp_now_init() failed");
+            deinitWifi();
+            return false;
+        }
+
+        onReceive = std::move(newOnReceive);
+        onSendComplete = std::move(newOnSendComplete);
+        activeRadio = this;
+
+        if (esp_now_register_recv_cb(receiveCallback) != ESP_OK) {
+            TT_LOG_E(TAG, "esp_now_register_recv_cb() failed");
+            deinit();
+            return false;
+        }
+
+        if (esp_now_register_send_cb(sendCallback) != ESP_OK) {
+            TT_LOG_E(TAG, "esp_now_register_send_cb() failed");
+            deinit();
+            return false;
+        }
+
+//#if CONFIG_ESPNOW_ENABLE_POWER_SAVE
+//    ESP_ERROR_CHECK( esp_now_set_wake_window(CONFIG_ESPNOW_WAKE_WINDOW) );
+//    ESP_ERROR_CHECK( esp_wifi_connectionless_module_set_wake_interval(CONFIG_ESPNOW_WAKE_INTERVAL) );
+//#endif
+
+        if (esp_now_set_pmk(config.masterKey) != ESP_OK) {
+            TT_LOG_E(TAG, "esp_now_set_pmk() failed");
+            deinit();
+            return false;
+        }
+
+        // Add default unencrypted broadcast peer
+        esp_now_peer_info_t broadcast_peer;
+        memset(&broadcast_peer, 0, sizeof(esp_now_peer_info_t));
+        memset(broadcast_peer.peer_addr, 0xFF, ESP_NOW_ETH_ALEN);
+        if (esp_now_add_peer(&broadcast_peer) != ESP_OK) {
+            TT_LOG_E(TAG, "Failed to add broadcast peer");
+        }
+
+        started = true;
+        return true;
+    }
+
+    void stop() override {
+        if (started) {
+            deinit();
+            started = false;
+        }
+    }
+
+    bool send(const uint8_t* address, const uint8_t* data, size_t length) override {
+        return esp_now_send(address, data, length) == ESP_OK;
+    }
+};
+
+std::unique_ptr<EspNowRadio> createRadio() {
+    return std::make_unique<EspNowRadioEsp>();
+}
+
+}
+
+#endif // ESP_PLATFORM
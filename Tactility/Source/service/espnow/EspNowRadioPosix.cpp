@@ -0,0 +1,14 @@
+#ifndef ESP_PLATFORM
+
+#include "Tactility/service/espnow/EspNowMockRadio.h"
+
+namespace tt::service::espnow {
+
+std::unique_ptr<EspNowRadio> createRadio() {
+    // There is no radio on the simulator: sent frames are received again
+    return std::make_unique<EspNowMockRadio>(true);
+}
+
+}
+
+#endif // ESP_PLATFORM
@@ -1,41 +1,27 @@
-#ifdef ESP_PLATFORM
-
 #include <Tactility/Tactility.h>
 #include <Tactility/service/espnow/EspNowService.h>
 #include <Tactility/service/ServiceManifest.h>
 #include <Tactility/service/ServiceRegistration.h>
-#include <Tactility/service/espnow/EspNowWifi.h>
 
 #include <cstring>
+
+#ifdef ESP_PLATFORM
 #include <esp_now.h>
-#include <esp_random.h>
+#endif
 
 namespace tt::service::espnow {
 
 extern const ServiceManifest manifest;
 
 constexpr const char* TAG = "EspNowService";
-constexpr TickType_t MAX_DELAY = 1000U / portTICK_PERIOD_MS;
-static uint8_t BROADCAST_MAC[ESP_NOW_ETH_ALEN];
-
-constexpr bool isBroadcastAddress(uint8_t address[ESP_NOW_ETH_ALEN]) { return memcmp(address, BROADCAST_MAC, ESP_NOW_ETH_ALEN) == 0; }
 
 bool EspNowService::onStart(ServiceContext& service) {
-    auto lock = mutex.asScopedLock();
-    lock.lock();
-
-    memset(BROADCAST_MAC, 0xFF, sizeof(BROADCAST_MAC));
-
     return true;
 }
 
 void EspNowService::onStop(ServiceContext& service) {
-    auto lock = mutex.asScopedLock();
-    lock.lock();
-
-    if (isEnabled()) {
-        disable();
-    }
+    // Not dispatched: the service is gone by the time the dispatcher would run it
+    disableFromDispatcher();
 }
 
 // region Enable
@@ -50,42 +36,23 @@ void EspNowService::enableFromDispatcher(const EspNowConfig& config) {
     auto lock = mutex.asScopedLock();
     lock.lock();
 
-    if (enabled) {
-        return;
-    }
-
-    if (!initWifi(config)) {
-        TT_LOG_E(TAG, "initWifi() failed");
-        return;
-    }
-
-    if (esp_now_init() != ESP_OK) {
-        TT_LOG_E(TAG, "esp_now_init() failed");
-        return;
-    }
-
-    if (esp_now_register_recv_cb(receiveCallback) != ESP_OK) {
-        TT_LOG_E(TAG, "esp_now_register_recv_cb() failed");
+    if (transport != nullptr) {
         return;
     }
 
-//#if CONFIG_ESPNOW_ENABLE_POWER_SAVE
-//    ESP_ERROR_CHECK( esp_now_set_wake_window(CONFIG_ESPNOW_WAKE_WINDOW) );
-//    ESP_ERROR_CHECK( esp_wifi_connectionless_module_set_wake_interval(CONFIG_ESPNOW_WAKE_INTERVAL) );
-//#endif
+    auto new_transport = std::make_unique<EspNowTransport>(
+        createRadio(),
+        [this](std::span<const ReceivedFrame> frames) {
+            onReceive(frames);
+        }
+    );
 
-    if (esp_now_set_pmk(config.masterKey) != ESP_OK) {
-        TT_LOG_E(TAG, "esp_now_set_pmk() failed");
+    if (!new_transport->start(config)) {
+        TT_LOG_E(TAG, "Failed to start transport");
         return;
     }
 
-    // Add default unencrypted broadcast peer
-    esp_now_peer_info_t broadcast_peer;
-    memset(&broadcast_peer, 0, sizeof(esp_now_peer_info_t));
-    memcpy(broadcast_peer.peer_addr, BROADCAST_MAC, sizeof(BROADCAST_MAC));
-    service::espnow::addPeer(broadcast_peer);
-
-    enabled = true;
+    transport = std::move(new_transport);
 }
 
 // endregion Enable
@@ -101,43 +68,26 @@ void EspNowService::disable() {
 void EspNowService::disableFromDispatcher() {
     auto lock = mutex.asScopedLock();
     lock.lock();
+    auto old_transport = std::move(transport);
+    lock.unlock();
 
-    if (!enabled) {
-        return;
-    }
-
-    if (esp_now_deinit() != ESP_OK) {
-        TT_LOG_E(TAG, "esp_now_deinit() failed");
-    }
-
-    if (!deinitWifi()) {
-        TT_LOG_E(TAG, "deinitWifi() failed");
-    }
-
-    enabled = false;
+    // Stops the worker and the radio.
+    // This happens outside the lock, because the worker might call send() from a SendCompleteFunction.
+    old_transport = nullptr;
 }
 
 // region Disable
 
 // region Callbacks
 
-void EspNowService::receiveCallback(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length) {
-    auto service = findService();
-    if (service == nullptr) {
-        TT_LOG_E(TAG, "Service not running");
-        return;
-    }
-    service->onReceive(receiveInfo, data, length);
-}
-
-void EspNowService::onReceive(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length) {
-    auto lock = mutex.asScopedLock();
+void EspNowService::onReceive(std::span<const ReceivedFrame> frames) {
+    auto lock = subscriptionMutex.asScopedLock();
     lock.lock();
 
-    TT_LOG_D(TAG, "Received %d bytes", length);
+    TT_LOG_D(TAG, "Received %zu frames", frames.size());
 
     for (const auto& item: subscriptions) {
-        item.onReceive(receiveInfo, data, length);
+        item.onReceive(frames);
     }
 }
 
@@ -146,9 +96,10 @@ void EspNowService::onReceive(const esp_now_recv_info_t* receiveInfo, const uint
 bool EspNowService::isEnabled() const {
     auto lock = mutex.asScopedLock();
     lock.lock();
-    return enabled;
+    return transport != nullptr;
 }
 
+#ifdef ESP_PLATFORM
 bool EspNowService::addPeer(const esp_now_peer_info_t& peer) {
     if (esp_now_add_peer(&peer) != ESP_OK) {
         TT_LOG_E(TAG, "Failed to add peer");
@@ -158,20 +109,21 @@ bool EspNowService::addPeer(const esp_now_peer_info_t& peer) {
         return true;
     }
 }
+#endif
 
-bool EspNowService::send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength) {
+bool EspNowService::send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength, SendCompleteFunction onComplete) {
     auto lock = mutex.asScopedLock();
     lock.lock();
 
-    if (!isEnabled()) {
+    if (transport == nullptr) {
         return false;
     } else {
-        return esp_now_send(address, buffer, bufferLength) == ESP_OK;
+        return transport->send(address, buffer, bufferLength, std::move(onComplete));
     }
 }
 
-ReceiverSubscription EspNowService::subscribeReceiver(std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive) {
-    auto lock = mutex.asScopedLock();
+ReceiverSubscription EspNowService::subscribeReceiver(ReceiveFunction onReceive) {
+    auto lock = subscriptionMutex.asScopedLock();
     lock.lock();
 
     auto id = lastSubscriptionId++;
@@ -185,11 +137,23 @@ ReceiverSubscription EspNowService::subscribeReceiver(std::function<void(const e
 }
 
 void EspNowService::unsubscribeReceiver(tt::service::espnow::ReceiverSubscription subscriptionId) {
-    auto lock = mutex.asScopedLock();
+    auto lock = subscriptionMutex.asScopedLock();
     lock.lock();
     std::erase_if(subscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
 }
 
+Statistics EspNowService::getStatistics() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return (transport != nullptr) ? transport->getStatistics() : Statistics {};
+}
+
+std::vector<PeerStatistics> EspNowService::getPeerStatistics() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return (transport != nullptr) ? transport->getPeerStatistics() : std::vector<PeerStatistics>();
+}
+
 std::shared_ptr<EspNowService> findService() {
     return std::static_pointer_cast<EspNowService>(
         service::findServiceById(manifest.id)
@@ -202,5 +166,3 @@ extern const ServiceManifest manifest = {
 };
 
 }
-
-#endif // ESP_PLATFORM
@@ -0,0 +1,309 @@
+#include "Tactility/service/espnow/EspNowTransport.h"
+
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tt::service::espnow {
+
+constexpr auto* TAG = "EspNowTransport";
+
+/** The driver reports the result of a send within milliseconds: this is only a safety net */
+constexpr uint32_t SEND_TIMEOUT_MILLIS = 500;
+/** The rates of a peer are reset when it hasn't been heard from for this long */
+constexpr uint32_t PEER_RATE_TIMEOUT_MILLIS = 2000;
+
+EspNowTransport::EspNowTransport(
+    std::unique_ptr<EspNowRadio> radio,
+    ReceiveFunction onReceive,
+    size_t receiveQueueSize,
+    size_t sendQueueSize
+) :
+    radio(std::move(radio)),
+    onReceive(std::move(onReceive)),
+    receiveQueue(receiveQueueSize),
+    sendQueue(sendQueueSize),
+    batch(std::make_unique<ReceivedFrame[]>(maxBatchSize))
+{}
+
+EspNowTransport::~EspNowTransport() {
+    stop();
+}
+
+bool EspNowTransport::start(const EspNowConfig& config) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (thread != nullptr) {
+        TT_LOG_W(TAG, "Already started");
+        return true;
+    }
+
+    bool radio_started = radio->start(
+        config,
+        [this](const uint8_t* sourceAddress, const uint8_t* destinationAddress, int8_t rssi, const uint8_t* data, size_t length) {
+            onRadioReceive(sourceAddress, destinationAddress, rssi, data, length);
+        },
+        [this](bool success) {
+            onRadioSendComplete(success);
+        }
+    );
+
+    if (!radio_started) {
+        TT_LOG_E(TAG, "Failed to start radio");
+        return false;
+    }
+
+    eventFlag.clear(FlagStop | FlagSendComplete);
+    thread = std::make_unique<Thread>(
+        "espnow",
+        4096,
+        [this]() {
+            return threadMain();
+        }
+    );
+    // Stay ahead of the UI, so the receive queue is emptied quickly
+    thread->setPriority(Thread::Priority::High);
+    started = true;
+    thread->start();
+
+    return true;
+}
+
+void EspNowTransport::stop() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (thread == nullptr) {
+        return;
+    }
+
+    started = false;
+    eventFlag.set(FlagStop);
+    thread->join();
+    thread = nullptr;
+
+    radio->stop();
+
+    SendItem item;
+    while (sendQueue.pop(item)) {
+        completeSend(item, false);
+    }
+
+    // Discard the frames that arrived after the worker stopped
+    while (receiveQueue.pop(batch[0])) {}
+}
+
+bool EspNowTransport::isStarted() const {
+    return started;
+}
+
+bool EspNowTransport::send(const uint8_t* address, const uint8_t* data, size_t length, SendCompleteFunction onComplete) {
+    if (!started) {
+        return false;
+    }
+
+    if (length > MAX_DATA_LENGTH) {
+        TT_LOG_E(TAG, "Frame too large (%zu bytes)", length);
+        return false;
+    }
+
+    bool queued = sendQueue.pushInPlace([address, data, length, &onComplete](SendItem& item) {
+        memcpy(item.address, address, ADDRESS_LENGTH);
+        item.length = static_cast<uint16_t>(length);
+        memcpy(item.data, data, length);
+        item.onComplete = std::move(onComplete);
+    });
+
+    if (!queued) {
+        sendDroppedFrames++;
+        return false;
+    }
+
+    eventFlag.set(FlagSend);
+    return true;
+}
+
+void EspNowTransport::onRadioReceive(const uint8_t* sourceAddress, const uint8_t* destinationAddress, int8_t rssi, const uint8_t* data, size_t length) {
+    if (length > MAX_DATA_LENGTH) {
+        receiveOversizedFrames++;
+        return;
+    }
+
+    auto timestamp = static_cast<uint32_t>(kernel::getMillis());
+    bool queued = receiveQueue.pushInPlace([=](ReceivedFrame& frame) {
+        memcpy(frame.sourceAddress, sourceAddress, ADDRESS_LENGTH);
+        memcpy(frame.destinationAddress, destinationAddress, ADDRESS_LENGTH);
+        frame.rssi = rssi;
+        frame.length = static_cast<uint16_t>(length);
+        frame.timestamp = timestamp;
+        memcpy(frame.data, data, length);
+    });
+
+    if (queued) {
+        eventFlag.set(FlagReceive);
+    } else {
+        receiveDroppedFrames++;
+    }
+}
+
+void EspNowTransport::onRadioSendComplete(bool success) {
+    sendSuccess = success;
+    eventFlag.set(FlagSendComplete);
+}
+
+int32_t EspNowTransport::threadMain() {
+    SendItem item;
+    bool sending = false;
+    uint32_t send_start_time = 0;
+
+    while (true) {
+        auto timeout = sending ? kernel::millisToTicks(SEND_TIMEOUT_MILLIS) : portMAX_DELAY;
+        auto flags = eventFlag.wait(FlagReceive | FlagSend | FlagSendComplete | FlagStop, EventFlag::WaitAny, timeout);
+        if ((flags & EventFlag::Error) != 0) {
+            // Timeout
+            flags = 0;
+        }
+
+        if ((flags & FlagStop) != 0) {
+            break;
+        }
+
+        deliverReceived();
+
+        if (sending) {
+            if ((flags & FlagSendComplete) != 0) {
+                sending = false;
+                completeSend(item, sendSuccess);
+            } else if (static_cast<uint32_t>(kernel::getMillis()) - send_start_time >= SEND_TIMEOUT_MILLIS) {
+                TT_LOG_W(TAG, "Send timed out");
+                sending = false;
+                completeSend(item, false);
+            }
+        }
+
+        while (!sending && sendQueue.pop(item)) {
+            eventFlag.clear(FlagSendComplete);
+            if (radio->send(item.address, item.data, item.length)) {
+                sending = true;
+                send_start_time = static_cast<uint32_t>(kernel::getMillis());
+            } else {
+                completeSend(item, false);
+            }
+        }
+    }
+
+    if (sending) {
+        completeSend(item, false);
+    }
+
+    return 0;
+}
+
+void EspNowTransport::deliverReceived() {
+    size_t count;
+    do {
+        count = 0;
+        while (count < maxBatchSize && receiveQueue.pop(batch[count])) {
+            count++;
+        }
+
+        if (count > 0) {
+            std::span<const ReceivedFrame> frames(batch.get(), count);
+            updatePeerStatistics(frames);
+            receivedFrames += count;
+            receiveBatches++;
+            onReceive(frames);
+        }
+    } while (count == maxBatchSize);
+}
+
+void EspNowTransport::updatePeerStatistics(std::span<const ReceivedFrame> frames) {
+    auto lock = peerMutex.asScopedLock();
+    lock.lock();
+
+    for (const auto& frame : frames) {
+        auto* entry = std::find_if(peers.begin(), peers.begin() + peerCount, [&frame](const PeerEntry& peer) {
+            return memcmp(peer.statistics.address, frame.sourceAddress, ADDRESS_LENGTH) == 0;
+        });
+
+        if (entry == peers.begin() + peerCount) {
+            if (peerCount < maxPeers) {
+                peerCount++;
+            } else {
+                // Replace the peer that was heard from the longest time ago
+                entry = std::min_element(peers.begin(), peers.end(), [&frame](const PeerEntry& left, const PeerEntry& right) {
+                    return (frame.timestamp - left.lastSeen) > (frame.timestamp - right.lastSeen);
+                });
+            }
+            *entry = PeerEntry {};
+            memcpy(entry->statistics.address, frame.sourceAddress, ADDRESS_LENGTH);
+            entry->windowStart = frame.timestamp;
+        }
+
+        entry->statistics.frames++;
+        entry->statistics.bytes += frame.length;
+        entry->statistics.rssi = frame.rssi;
+        entry->lastSeen = frame.timestamp;
+        entry->windowFrames++;
+        entry->windowBytes += frame.length;
+
+        auto elapsed = frame.timestamp - entry->windowStart;
+        if (elapsed >= 1000) {
+            entry->statistics.framesPerSecond = static_cast<uint32_t>((static_cast<uint64_t>(entry->windowFrames) * 1000) / elapsed);
+            entry->statistics.bytesPerSecond = static_cast<uint32_t>((static_cast<uint64_t>(entry->windowBytes) * 1000) / elapsed);
+            entry->windowStart = frame.timestamp;
+            entry->windowFrames = 0;
+            entry->windowBytes = 0;
+        }
+    }
+}
+
+void EspNowTransport::completeSend(SendItem& item, bool success) {
+    if (success) {
+        sentFrames++;
+    } else {
+        sendFailedFrames++;
+    }
+
+    if (item.onComplete != nullptr) {
+        item.onComplete(success);
+        // Release the captured state
+        item.onComplete = nullptr;
+    }
+}
+
+Statistics EspNowTransport::getStatistics() const {
+    return {
+        .receivedFrames = receivedFrames,
+        .receiveDroppedFrames = receiveDroppedFrames,
+        .receiveOversizedFrames = receiveOversizedFrames,
+        .receiveBatches = receiveBatches,
+        .receiveQueueHighWaterMark = static_cast<uint32_t>(receiveQueue.getHighWaterMark()),
+        .sentFrames = sentFrames,
+        .sendFailedFrames = sendFailedFrames,
+        .sendDroppedFrames = sendDroppedFrames
+    };
+}
+
+std::vector<PeerStatistics> EspNowTransport::getPeerStatistics() const {
+    auto lock = peerMutex.asScopedLock();
+    lock.lock();
+
+    auto now = static_cast<uint32_t>(kernel::getMillis());
+    std::vector<PeerStatistics> result;
+    result.reserve(peerCount);
+    for (size_t i = 0; i < peerCount; i++) {
+        auto statistics = peers[i].statistics;
+        if (now - peers[i].lastSeen >= PEER_RATE_TIMEOUT_MILLIS) {
+            statistics.framesPerSecond = 0;
+            statistics.bytesPerSecond = 0;
+        }
+        result.push_back(statistics);
+    }
+    return result;
+}
+
+}
@@ -63,6 +63,7 @@ bool GpsService::onStart(ServiceContext& serviceContext) {
     auto lock = mutex.asScopedLock();
     lock.lock();
     paths = serviceContext.getPaths();
+    frameDispatcher.start();
     return true;
 }
 
@@ -70,6 +71,7 @@ void GpsService::onStop(ServiceContext& serviceContext) {
     if (getState() == State::On) {
         stopReceiving();
     }
+    frameDispatcher.stop();
 }
 
 bool GpsService::startGpsDevice(GpsDeviceRecord& record) {
@@ -85,21 +87,17 @@ bool GpsService::startGpsDevice(GpsDeviceRecord& record) {
         return false;
     }
 
-    record.satelliteSubscriptionId = device->subscribeGga([this](hal::Device::Id deviceId, auto& record) {
-        mutex.lock();
-        onGgaSentence(deviceId, record);
-        mutex.unlock();
-    });
+    record.ggaSubscription = device->getGgaPubsub()->subscribe([this](auto& frame) {
+        onGgaFrame(frame);
+    }, frameDispatcher);
 
-    record.rmcSubscriptionId = device->subscribeRmc([this](hal::Device::Id deviceId, auto& record) {
-        mutex.lock();
-        if (record.longitude.value != 0 && record.longitude.scale != 0) {
-            rmcRecord = record;
-            rmcTime = kernel::getTicks();
-        }
-        onRmcSentence(deviceId, record);
-        mutex.unlock();
-    });
+    record.rmcSubscription = device->getRmcPubsub()->subscribe([this](auto& frame) {
+        onRmcFrame(frame);
+    }, frameDispatcher);
+
+    record.gsvSubscription = device->getGsvPubsub()->subscribe([this](auto& frame) {
+        satellites.notify(hal::gps::toConstellation(frame.talkerId), frame.sentence);
+    }, frameDispatcher);
 
     return true;
 }
@@ -109,11 +107,20 @@ bool GpsService::stopGpsDevice(GpsDeviceRecord& record) {
 
     auto device = record.device;
 
-    device->unsubscribeGga(record.satelliteSubscriptionId);
-    device->unsubscribeRmc(record.rmcSubscriptionId);
+    if (record.ggaSubscription != nullptr) {
+        device->getGgaPubsub()->unsubscribe(record.ggaSubscription);
+        record.ggaSubscription = nullptr;
+    }
+
+    if (record.rmcSubscription != nullptr) {
+        device->getRmcPubsub()->unsubscribe(record.rmcSubscription);
+        record.rmcSubscription = nullptr;
+    }
 
-    record.satelliteSubscriptionId = -1;
-    record.rmcSubscriptionId = -1;
+    if (record.gsvSubscription != nullptr) {
+        device->getGsvPubsub()->unsubscribe(record.gsvSubscription);
+        record.gsvSubscription = nullptr;
+    }
 
     if (!device->stop()) {
         TT_LOG_E(TAG, "[device %lu] stopping failed", record.device->getId());
@@ -162,7 +169,9 @@ bool GpsService::startReceiving() {
         started_one_or_more |= startGpsDevice(record);
     }
 
+    rmcMutex.lock();
     rmcTime = 0;
+    rmcMutex.unlock();
 
     if (started_one_or_more) {
         setState(State::On);
@@ -185,17 +194,27 @@ void GpsService::stopReceiving() {
         stopGpsDevice(record);
     }
 
+    rmcMutex.lock();
     rmcTime = 0;
+    rmcMutex.unlock();
 
     setState(State::Off);
 }
 
-void GpsService::onGgaSentence(hal::Device::Id deviceId, const minmea_sentence_gga& gga) {
-    TT_LOG_D(TAG, "[device %lu] LAT %f LON %f, satellites: %d", deviceId, minmea_tocoord(&gga.latitude), minmea_tocoord(&gga.longitude), gga.satellites_tracked);
+void GpsService::onGgaFrame(const hal::gps::GgaFrame& frame) {
+    const auto& gga = frame.sentence;
+    TT_LOG_D(TAG, "[device %lu] LAT %f LON %f, satellites: %d", frame.deviceId, minmea_tocoord(&gga.latitude), minmea_tocoord(&gga.longitude), gga.satellites_tracked);
 }
 
-void GpsService::onRmcSentence(hal::Device::Id deviceId, const minmea_sentence_rmc& rmc) {
-    TT_LOG_D(TAG, "[device %lu] LAT %f LON %f, speed: %.2f", deviceId, minmea_tocoord(&rmc.latitude), minmea_tocoord(&rmc.longitude), minmea_tofloat(&rmc.speed));
+void GpsService::onRmcFrame(const hal::gps::RmcFrame& frame) {
+    const auto& rmc = frame.sentence;
+    if (rmc.longitude.value != 0 && rmc.longitude.scale != 0) {
+        auto lock = rmcMutex.asScopedLock();
+        lock.lock();
+        rmcRecord = rmc;
+        rmcTime = kernel::getTicks();
+    }
+    TT_LOG_D(TAG, "[device %lu] LAT %f LON %f, speed: %.2f", frame.deviceId, minmea_tocoord(&rmc.latitude), minmea_tocoord(&rmc.longitude), minmea_tofloat(&rmc.speed));
 }
 
 State GpsService::getState() const {
@@ -213,12 +232,14 @@ void GpsService::setState(State newState) {
 }
 
 bool GpsService::hasCoordinates() const {
-    auto lock = mutex.asScopedLock();
+    auto lock = rmcMutex.asScopedLock();
     lock.lock();
     return getState() == State::On && rmcTime != 0 && !hasTimeElapsed(kernel::getTicks(), rmcTime, kernel::secondsToTicks(10));
 }
 
 bool GpsService::getCoordinates(minmea_sentence_rmc& rmc) const {
+    auto lock = rmcMutex.asScopedLock();
+    lock.lock();
     if (hasCoordinates()) {
         rmc = rmcRecord;
         return true;
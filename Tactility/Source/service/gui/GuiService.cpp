@@ -1,11 +1,19 @@
 #include <Tactility/service/gui/GuiService.h>
 
 #include <Tactility/app/AppInstance.h>
+#include <Tactility/kernel/Kernel.h>
 #include <Tactility/lvgl/LvglSync.h>
 #include <Tactility/lvgl/Statusbar.h>
 #include <Tactility/service/loader/Loader.h>
 #include <Tactility/service/ServiceRegistration.h>
 #include <Tactility/Tactility.h>
+#include <Tactility/TactilityConfig.h>
+
+#include <algorithm>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
 
 namespace tt::service::gui {
 
@@ -21,7 +29,35 @@ void GuiService::onLoaderEvent(LoaderService::Event event) {
         showApp(app_instance);
     } else if (event == LoaderService::Event::ApplicationHiding) {
         hideApp();
+    } else if (event == LoaderService::Event::ApplicationStopped) {
+        removeStoppedAppViews();
+    }
+}
+
+/** @return the memory that is in use by LVGL, or by the heap when LVGL uses the C library */
+static size_t getUsedMemory() {
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    return monitor.total_size - monitor.free_size;
+#elif defined(ESP_PLATFORM)
+    return heap_caps_get_total_size(MALLOC_CAP_DEFAULT) - heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Make the group the default, which adds all new objects automatically, and assign all indevs to it.
+ * This enables navigation with limited input, such as encoder wheels.
+ */
+static void activateGroup(lv_group_t* group) {
+    auto* indev = lv_indev_get_next(nullptr);
+    while (indev) {
+        lv_indev_set_group(indev, group);
+        indev = lv_indev_get_next(indev);
     }
+    lv_group_set_default(group);
 }
 
 int32_t GuiService::guiMain() {
@@ -53,7 +89,6 @@ int32_t GuiService::guiMain() {
 }
 
 lv_obj_t* GuiService::createAppViews(lv_obj_t* parent) {
-    lv_obj_send_event(statusbarWidget, LV_EVENT_DRAW_MAIN, nullptr);
     lv_obj_t* child_container = lv_obj_create(parent);
     lv_obj_set_style_pad_all(child_container, 0, LV_STATE_DEFAULT);
     lv_obj_set_width(child_container, LV_PCT(100));
@@ -70,25 +105,107 @@ lv_obj_t* GuiService::createAppViews(lv_obj_t* parent) {
     return child_container;
 }
 
+std::unique_ptr<GuiService::AppView> GuiService::buildAppView(const std::shared_ptr<app::AppInstance>& app) {
+    auto memory_before = getUsedMemory();
+
+    lv_group_t* group = lv_group_create();
+    activateGroup(group);
+
+    // A root per app, so the whole view can be hidden and retained
+    lv_obj_t* root = lv_obj_create(appRootWidget);
+    lv_obj_set_style_pad_all(root, 0, LV_STATE_DEFAULT);
+    lv_obj_set_style_border_width(root, 0, LV_STATE_DEFAULT);
+    lv_obj_set_width(root, LV_PCT(100));
+    lv_obj_set_flex_grow(root, 1);
+    lv_obj_set_flex_flow(root, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t* container = createAppViews(root);
+    app->getApp()->onShow(*app, container);
+
+    auto memory_after = getUsedMemory();
+    return std::make_unique<AppView>(AppView {
+        .app = app,
+        .launchId = app->getLaunchId(),
+        .root = root,
+        .container = container,
+        .keyboard = keyboard,
+        .group = group,
+        .memorySize = (memory_after > memory_before) ? (memory_after - memory_before) : 0
+    });
+}
+
+std::unique_ptr<GuiService::AppView> GuiService::restoreAppView(const std::shared_ptr<app::AppInstance>& app) {
+    auto iterator = std::ranges::find_if(retainedViews, [&app](const auto& view) {
+        return view.launchId == app->getLaunchId();
+    });
+    if (iterator == retainedViews.end()) {
+        return nullptr;
+    }
+
+    auto view = std::make_unique<AppView>(*iterator);
+    retainedMemorySize -= view->memorySize;
+    retainedViews.erase(iterator);
+
+    activateGroup(view->group);
+    keyboard = view->keyboard;
+    lv_obj_remove_flag(view->root, LV_OBJ_FLAG_HIDDEN);
+    app->getApp()->onShowRetained(*app, view->container);
+    return view;
+}
+
+void GuiService::deleteAppView(const AppView& view) {
+    lv_obj_delete(view.root);
+    // Also removes it from the indevs and resets the default group
+    lv_group_delete(view.group);
+}
+
+void GuiService::evictRetainedViews() {
+    while (retainedMemorySize > config::RETAINED_VIEW_MEMORY_BUDGET && !retainedViews.empty()) {
+        const auto& view = retainedViews.back();
+        TT_LOG_I(TAG, "Evicting retained view of launch %u (%zu bytes)", view.launchId, view.memorySize);
+        deleteAppView(view);
+        retainedMemorySize -= view.memorySize;
+        retainedViews.pop_back();
+        showStatistics.evictionCount++;
+    }
+}
+
+void GuiService::removeStoppedAppViews() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (retainedViews.empty()) {
+        return;
+    }
+
+    lvgl::lock(portMAX_DELAY);
+    std::erase_if(retainedViews, [this](const auto& view) {
+        auto app = view.app.lock();
+        if (app == nullptr || app->getState() == app::State::Destroyed) {
+            deleteAppView(view);
+            retainedMemorySize -= view.memorySize;
+            return true;
+        }
+        return false;
+    });
+    lvgl::unlock();
+}
+
 void GuiService::redraw() {
     // Lock GUI and LVGL
     lock();
 
     if (lvgl::lock(1000)) {
-        lv_obj_clean(appRootWidget);
+        if (currentView != nullptr) {
+            deleteAppView(*currentView);
+            currentView = nullptr;
+            keyboard = nullptr;
+        }
 
         if (appToRender != nullptr) {
+            auto start_time = kernel::getMicros();
 
-            // Create a default group which adds all objects automatically,
-            // and assign all indevs to it.
-            // This enables navigation with limited input, such as encoder wheels.
-            lv_group_t* group = lv_group_create();
-            auto* indev = lv_indev_get_next(nullptr);
-            while (indev) {
-                lv_indev_set_group(indev, group);
-                indev = lv_indev_get_next(indev);
-            }
-            lv_group_set_default(group);
+            lv_obj_send_event(statusbarWidget, LV_EVENT_DRAW_MAIN, nullptr);
 
             app::Flags flags = std::static_pointer_cast<app::AppInstance>(appToRender)->getFlags();
             if (flags.hideStatusbar) {
@@ -97,8 +214,22 @@ void GuiService::redraw() {
                 lv_obj_remove_flag(statusbarWidget, LV_OBJ_FLAG_HIDDEN);
             }
 
-            lv_obj_t* container = createAppViews(appRootWidget);
-            appToRender->getApp()->onShow(*appToRender, container);
+            currentView = restoreAppView(appToRender);
+            bool is_retained = (currentView != nullptr);
+            if (!is_retained) {
+                currentView = buildAppView(appToRender);
+            }
+
+            auto show_time = static_cast<uint32_t>(kernel::getMicros() - start_time);
+            showStatistics.lastShowTime = show_time;
+            if (is_retained) {
+                showStatistics.retainedCount++;
+                showStatistics.retainedTimeTotal += show_time;
+            } else {
+                showStatistics.buildCount++;
+                showStatistics.buildTimeTotal += show_time;
+            }
+            TT_LOG_I(TAG, "Showed %s in %lu us (%s)", appToRender->getManifest().appId.c_str(), (unsigned long)show_time, is_retained ? "retained" : "built");
         } else {
             TT_LOG_W(TAG, "nothing to draw");
         }
@@ -185,6 +316,15 @@ void GuiService::onStop(TT_UNUSED ServiceContext& service) {
     unlock();
 
     tt_check(lvgl::lock(1000 / portTICK_PERIOD_MS));
+    if (currentView != nullptr) {
+        deleteAppView(*currentView);
+        currentView = nullptr;
+    }
+    for (const auto& view : retainedViews) {
+        deleteAppView(view);
+    }
+    retainedViews.clear();
+    retainedMemorySize = 0;
     lv_group_delete(keyboardGroup);
     lvgl::unlock();
 }
@@ -236,6 +376,22 @@ void GuiService::hideApp() {
     // might call LVGL APIs (e.g. to remove the keyboard from the screen root)
     lvgl::lock(portMAX_DELAY);
     appToRender->getApp()->onHide(*appToRender);
+
+    bool retain_view = (appToRender->getManifest().appFlags & app::AppManifest::Flags::RetainView) != 0;
+    if (currentView != nullptr && currentView->launchId == appToRender->getLaunchId() && retain_view) {
+        // Keep the view around (hidden flex children don't take up space) until the app is shown again
+        if (currentView->keyboard != nullptr) {
+            lv_obj_add_flag(currentView->keyboard, LV_OBJ_FLAG_HIDDEN);
+        }
+        lv_obj_add_flag(currentView->root, LV_OBJ_FLAG_HIDDEN);
+        lv_group_set_default(nullptr);
+        keyboard = nullptr;
+        retainedMemorySize += currentView->memorySize;
+        retainedViews.push_front(*currentView);
+        currentView = nullptr;
+        evictRetainedViews();
+    }
+
     lvgl::unlock();
     appToRender = nullptr;
 }
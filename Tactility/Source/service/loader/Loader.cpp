@@ -241,6 +241,7 @@ void LoaderService::transitionAppToState(const std::shared_ptr<app::AppInstance>
         appStateToString(state)
     );
 
+    Event event;
     switch (state) {
         using enum app::State;
         case Initial:
@@ -248,32 +249,37 @@ void LoaderService::transitionAppToState(const std::shared_ptr<app::AppInstance>
         case Created:
             assert(app->getState() == app::State::Initial);
             app->getApp()->onCreate(*app);
-            pubsubExternal->publish(Event::ApplicationStarted);
+            event = Event::ApplicationStarted;
             break;
         case Showing: {
             assert(app->getState() == app::State::Hiding || app->getState() == app::State::Created);
-            pubsubExternal->publish(Event::ApplicationShowing);
+            event = Event::ApplicationShowing;
             break;
         }
         case Hiding: {
             assert(app->getState() == app::State::Showing);
-            pubsubExternal->publish(Event::ApplicationHiding);
+            event = Event::ApplicationHiding;
             break;
         }
         case Destroyed:
             app->getApp()->onDestroy(*app);
-            pubsubExternal->publish(Event::ApplicationStopped);
+            event = Event::ApplicationStopped;
             break;
     }
 
+    // Subscribers can check the new state (e.g. to find which app was destroyed)
     app->setState(state);
+    pubsubExternal->publish(event);
 }
 
 app::LaunchId LoaderService::start(const std::string& id, std::shared_ptr<const Bundle> parameters) {
     const auto launch_id = nextLaunchId++;
-    dispatcherThread->dispatch([this, id, launch_id, parameters]() {
+    const bool dispatched = dispatcherThread->dispatch([this, id, launch_id, parameters]() {
         onStartAppMessage(id, launch_id, parameters);
     });
+    if (!dispatched) {
+        TT_LOG_E(TAG, "Failed to dispatch start(%s)", id.c_str());
+    }
     return launch_id;
 }
 
@@ -284,16 +290,22 @@ void LoaderService::stopTop() {
 
 void LoaderService::stopTop(const std::string& id) {
     TT_LOG_I(TAG, "dispatching stopTop(%s)", id.c_str());
-    dispatcherThread->dispatch([this, id] {
+    const bool dispatched = dispatcherThread->dispatch([this, id] {
         onStopTopAppMessage(id);
     });
+    if (!dispatched) {
+        TT_LOG_E(TAG, "Failed to dispatch stopTop(%s)", id.c_str());
+    }
 }
 
 void LoaderService::stopAll(const std::string& id) {
     TT_LOG_I(TAG, "dispatching stopAll(%s)", id.c_str());
-    dispatcherThread->dispatch([this, id] {
+    const bool dispatched = dispatcherThread->dispatch([this, id] {
         onStopAllAppMessage(id);
     });
+    if (!dispatched) {
+        TT_LOG_E(TAG, "Failed to dispatch stopAll(%s)", id.c_str());
+    }
 }
 
 std::shared_ptr<app::AppContext> _Nullable LoaderService::getCurrentAppContext() {
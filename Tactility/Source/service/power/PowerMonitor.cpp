@@ -0,0 +1,262 @@
+#include <Tactility/service/power/PowerMonitor.h>
+
+#include <Tactility/hal/Device.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tt::service::power {
+
+constexpr auto* TAG = "PowerMonitor";
+
+using hal::power::PowerDevice;
+using MetricType = PowerDevice::MetricType;
+
+struct VoltageChargePoint {
+    uint32_t milliVolt;
+    uint8_t chargeLevel;
+};
+
+/** Resting voltage of a typical Li-ion/LiPo cell, from full to empty */
+static constexpr VoltageChargePoint dischargeCurve[] = {
+    { 4200, 100 },
+    { 4150, 95 },
+    { 4110, 90 },
+    { 4080, 85 },
+    { 4020, 80 },
+    { 3980, 75 },
+    { 3950, 70 },
+    { 3910, 65 },
+    { 3870, 60 },
+    { 3850, 55 },
+    { 3840, 50 },
+    { 3820, 45 },
+    { 3800, 40 },
+    { 3790, 35 },
+    { 3770, 30 },
+    { 3750, 25 },
+    { 3730, 20 },
+    { 3710, 15 },
+    { 3690, 10 },
+    { 3610, 5 },
+    { 3270, 0 }
+};
+
+uint8_t getChargeLevelFromVoltage(uint32_t milliVolt) {
+    if (milliVolt >= dischargeCurve[0].milliVolt) {
+        return 100;
+    }
+
+    for (size_t i = 1; i < std::size(dischargeCurve); i++) {
+        const auto& lower = dischargeCurve[i];
+        if (milliVolt >= lower.milliVolt) {
+            const auto& upper = dischargeCurve[i - 1];
+            auto offset = (milliVolt - lower.milliVolt) * (upper.chargeLevel - lower.chargeLevel);
+            auto range = upper.milliVolt - lower.milliVolt;
+            return lower.chargeLevel + (offset + range / 2) / range;
+        }
+    }
+
+    return 0;
+}
+
+uint32_t VoltageFilter::add(uint32_t sample) {
+    window[windowIndex] = sample;
+    windowIndex = (windowIndex + 1) % WINDOW_SIZE;
+    if (windowCount < WINDOW_SIZE) {
+        windowCount++;
+    }
+
+    auto sorted = window;
+    auto middle = sorted.begin() + windowCount / 2;
+    std::nth_element(sorted.begin(), middle, sorted.begin() + windowCount);
+    auto median = static_cast<float>(*middle);
+
+    if (windowCount == 1) {
+        average = median;
+    } else {
+        average += alpha * (median - average);
+    }
+
+    return static_cast<uint32_t>(std::lround(average));
+}
+
+void PowerMonitor::updateDevices(TickType_t now) {
+    auto device_snapshot = hal::getDeviceSnapshot();
+    if (device_snapshot->generation == deviceGeneration) {
+        return;
+    }
+    deviceGeneration = device_snapshot->generation;
+
+    std::vector<DeviceRecord> new_records;
+    for (const auto& device : device_snapshot->getDevices(hal::Device::Type::Power)) {
+        auto power_device = std::static_pointer_cast<PowerDevice>(device);
+        auto existing = std::ranges::find_if(records, [&power_device](const auto& record) {
+            return record.device == power_device;
+        });
+
+        if (existing != records.end()) {
+            new_records.push_back(std::move(*existing));
+        } else {
+            DeviceRecord record;
+            record.device = power_device;
+            record.supportsIsCharging = power_device->supportsMetric(MetricType::IsCharging);
+            record.supportsCurrent = power_device->supportsMetric(MetricType::Current);
+            record.supportsBatteryVoltage = power_device->supportsMetric(MetricType::BatteryVoltage);
+            record.supportsChargeLevel = power_device->supportsMetric(MetricType::ChargeLevel);
+            record.isChargeLevelEstimated = record.supportsBatteryVoltage && power_device->isChargeLevelEstimatedFromVoltage();
+            auto interval_millis = record.isChargeLevelEstimated ? configuration.estimatedSampleIntervalMillis : configuration.sampleIntervalMillis;
+            record.interval = std::max<TickType_t>(1, kernel::millisToTicks(interval_millis));
+            record.nextSampleTime = now;
+            TT_LOG_I(TAG, "Monitoring %s", power_device->getName().c_str());
+            new_records.push_back(std::move(record));
+        }
+    }
+
+    records = std::move(new_records);
+}
+
+void PowerMonitor::sample(DeviceRecord& record, TickType_t now) {
+    auto& device = *record.device;
+    auto& snapshot = record.snapshot;
+    PowerDevice::MetricData data;
+
+    std::optional<bool> is_charging;
+    if (record.supportsIsCharging && device.getMetric(MetricType::IsCharging, data)) {
+        is_charging = data.valueAsBool;
+    }
+    if (snapshot.isCharging.has_value() && snapshot.isCharging != is_charging) {
+        // The voltage jumps when a charger is connected or disconnected: don't average it with older samples
+        record.voltageFilter.reset();
+    }
+
+    std::optional<int32_t> current;
+    if (record.supportsCurrent && device.getMetric(MetricType::Current, data)) {
+        current = data.valueAsInt32;
+    }
+
+    std::optional<uint32_t> battery_voltage;
+    if (record.supportsBatteryVoltage && device.getMetric(MetricType::BatteryVoltage, data)) {
+        battery_voltage = record.voltageFilter.add(data.valueAsUint32);
+    }
+
+    std::optional<uint8_t> charge_level;
+    if (record.isChargeLevelEstimated) {
+        // The device would estimate it from another voltage measurement, so don't read it
+        if (battery_voltage.has_value()) {
+            charge_level = getChargeLevelFromVoltage(*battery_voltage);
+        }
+    } else if (record.supportsChargeLevel && device.getMetric(MetricType::ChargeLevel, data)) {
+        charge_level = std::min<uint8_t>(data.valueAsUint8, 100);
+    }
+
+    snapshot.device = record.device;
+    snapshot.isCharging = is_charging;
+    snapshot.current = current;
+    snapshot.batteryVoltage = battery_voltage;
+    snapshot.chargeLevel = charge_level;
+    snapshot.sampleTime = now;
+}
+
+size_t PowerMonitor::getChargeBand(int32_t chargeLevel) const {
+    return std::ranges::count_if(configuration.chargeLevelThresholds, [chargeLevel](auto threshold) {
+        return chargeLevel >= threshold;
+    });
+}
+
+bool PowerMonitor::shouldNotify(const PowerSnapshot& primary) const {
+    if (!hasNotified || primary.device != notifiedDevice || primary.isCharging != notifiedIsCharging) {
+        return true;
+    }
+
+    if (primary.chargeLevel.has_value() != notifiedChargeBand.has_value()) {
+        return true;
+    }
+
+    if (primary.chargeLevel.has_value()) {
+        const int32_t charge_level = *primary.chargeLevel;
+        const auto band = getChargeBand(charge_level);
+        if (band > *notifiedChargeBand) {
+            return getChargeBand(charge_level - configuration.chargeLevelHysteresis) > *notifiedChargeBand;
+        } else if (band < *notifiedChargeBand) {
+            return getChargeBand(charge_level + configuration.chargeLevelHysteresis) < *notifiedChargeBand;
+        }
+    }
+
+    return false;
+}
+
+void PowerMonitor::publish(TickType_t now) {
+    auto new_snapshots = std::make_shared<Snapshots>();
+    new_snapshots->reserve(records.size());
+
+    auto primary = std::ranges::find_if(records, [](const auto& record) { return record.supportsChargeLevel; });
+    if (primary != records.end()) {
+        new_snapshots->push_back(primary->snapshot);
+    }
+    for (auto iterator = records.begin(); iterator != records.end(); ++iterator) {
+        if (iterator != primary) {
+            new_snapshots->push_back(iterator->snapshot);
+        }
+    }
+
+    snapshots.store(std::move(new_snapshots));
+
+    PowerSnapshot primary_snapshot;
+    if (!records.empty()) {
+        primary_snapshot = (primary != records.end()) ? primary->snapshot : records.front().snapshot;
+    } else {
+        primary_snapshot.sampleTime = now;
+    }
+
+    if (shouldNotify(primary_snapshot)) {
+        hasNotified = true;
+        notifiedDevice = primary_snapshot.device;
+        notifiedIsCharging = primary_snapshot.isCharging;
+        if (primary_snapshot.chargeLevel.has_value()) {
+            notifiedChargeBand = getChargeBand(*primary_snapshot.chargeLevel);
+        } else {
+            notifiedChargeBand = std::nullopt;
+        }
+        pubsub->publish(primary_snapshot);
+    }
+}
+
+TickType_t PowerMonitor::update(TickType_t now) {
+    const auto generation = deviceGeneration;
+    updateDevices(now);
+    bool changed = (generation != deviceGeneration);
+
+    const bool sample_all = isSampleRequested.exchange(false);
+    for (auto& record : records) {
+        if (sample_all || static_cast<int32_t>(record.nextSampleTime - now) <= 0) {
+            sample(record, now);
+            record.nextSampleTime = now + record.interval;
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        publish(now);
+    }
+
+    TickType_t next_wait = portMAX_DELAY;
+    for (const auto& record : records) {
+        auto wait = static_cast<int32_t>(record.nextSampleTime - now);
+        next_wait = std::min<TickType_t>(next_wait, std::max<int32_t>(wait, 0));
+    }
+    return next_wait;
+}
+
+std::shared_ptr<const PowerSnapshot> PowerMonitor::getSnapshot() const {
+    auto all = snapshots.load();
+    if (all->empty()) {
+        return nullptr;
+    }
+    // Shares ownership with the list
+    return { all, &all->front() };
+}
+
+} // namespace tt::service::power
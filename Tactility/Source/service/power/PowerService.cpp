@@ -0,0 +1,75 @@
+#include <Tactility/service/power/PowerService.h>
+
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Log.h>
+#include <Tactility/service/ServiceManifest.h>
+#include <Tactility/service/ServiceRegistration.h>
+
+namespace tt::service::power {
+
+constexpr auto* TAG = "PowerService";
+
+constexpr uint32_t THREAD_FLAG_EXIT = 1U << 0U;
+constexpr uint32_t THREAD_FLAG_UPDATE = 1U << 1U;
+constexpr uint32_t THREAD_FLAGS_ALL = THREAD_FLAG_EXIT | THREAD_FLAG_UPDATE;
+
+extern const ServiceManifest manifest;
+
+int32_t PowerService::threadMain() {
+    while (true) {
+        auto wait_ticks = monitor.update(kernel::getTicks());
+        auto flags = threadFlags.wait(THREAD_FLAGS_ALL, EventFlag::WaitAny, wait_ticks);
+        if ((flags & EventFlag::Error) == 0 && (flags & THREAD_FLAG_EXIT) != 0) {
+            break;
+        }
+    }
+    return 0;
+}
+
+bool PowerService::onStart(ServiceContext& serviceContext) {
+    // Devices that are registered later are picked up on the next update
+    deviceSubscription = hal::getDevicePubsub()->subscribe([this](const auto& event) {
+        if (event.type == hal::Device::Type::Power) {
+            threadFlags.set(THREAD_FLAG_UPDATE);
+        }
+    });
+
+    thread = std::make_unique<Thread>(
+        "power",
+        4096,
+        [this] { return threadMain(); }
+    );
+    // Sampling is never urgent: it must not delay rendering or other services
+    thread->setPriority(Thread::Priority::Low);
+    thread->start();
+
+    TT_LOG_I(TAG, "Started");
+    return true;
+}
+
+void PowerService::onStop(ServiceContext& serviceContext) {
+    hal::getDevicePubsub()->unsubscribe(deviceSubscription);
+    deviceSubscription = nullptr;
+
+    threadFlags.set(THREAD_FLAG_EXIT);
+    thread->join();
+    thread = nullptr;
+}
+
+void PowerService::requestSample() {
+    monitor.requestSample();
+    threadFlags.set(THREAD_FLAG_UPDATE);
+}
+
+std::shared_ptr<PowerService> findPowerService() {
+    auto service = findServiceById(manifest.id);
+    assert(service != nullptr);
+    return std::static_pointer_cast<PowerService>(service);
+}
+
+extern const ServiceManifest manifest = {
+    .id = "Power",
+    .createService = create<PowerService>
+};
+
+} // namespace tt::service::power
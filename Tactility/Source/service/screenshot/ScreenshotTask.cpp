@@ -7,10 +7,13 @@
 #include "Tactility/service/loader/Loader.h"
 #include "Tactility/lvgl/LvglSync.h"
 
-#include <lv_screenshot.h>
+#include <Tactility/file/DoubleBufferedWriter.h>
+#include <Tactility/file/PngEncoder.h>
 #include <Tactility/TactilityCore.h>
 
+#include <algorithm>
 #include <format>
+#include <lvgl.h>
 #include <Tactility/CpuAffinity.h>
 
 namespace tt::service::screenshot {
@@ -47,16 +50,112 @@ void ScreenshotTask::setFinished() {
     finished = true;
 }
 
+/** @return the snapshot format that is closest to the display, so rendering the snapshot doesn't have to convert colors */
+static lv_color_format_t getSnapshotColorFormat() {
+    auto* display = lv_display_get_default();
+    if (display != nullptr) {
+        switch (lv_display_get_color_format(display)) {
+            case LV_COLOR_FORMAT_RGB565:
+                return LV_COLOR_FORMAT_RGB565;
+            case LV_COLOR_FORMAT_XRGB8888:
+            case LV_COLOR_FORMAT_ARGB8888:
+                return LV_COLOR_FORMAT_XRGB8888;
+            default:
+                break;
+        }
+    }
+    return LV_COLOR_FORMAT_RGB888;
+}
+
+/** Convert a row of the snapshot to RGB888 (red first) for the PNG encoder */
+static void convertRow(lv_color_format_t colorFormat, const uint8_t* source, uint8_t* target, uint32_t width) {
+    if (colorFormat == LV_COLOR_FORMAT_RGB565) {
+        const auto* pixels = reinterpret_cast<const uint16_t*>(source);
+        for (uint32_t x = 0; x < width; x++) {
+            const uint16_t pixel = pixels[x];
+            const uint8_t red = (pixel >> 11) & 0x1F;
+            const uint8_t green = (pixel >> 5) & 0x3F;
+            const uint8_t blue = pixel & 0x1F;
+            target[0] = (red << 3) | (red >> 2);
+            target[1] = (green << 2) | (green >> 4);
+            target[2] = (blue << 3) | (blue >> 2);
+            target += 3;
+        }
+    } else {
+        // LVGL stores blue first
+        const uint32_t source_pixel_size = (colorFormat == LV_COLOR_FORMAT_XRGB8888) ? 4 : 3;
+        for (uint32_t x = 0; x < width; x++) {
+            target[0] = source[2];
+            target[1] = source[1];
+            target[2] = source[0];
+            source += source_pixel_size;
+            target += 3;
+        }
+    }
+}
+
+/**
+ * The LVGL lock is only held while the screen is rendered into a snapshot.
+ * Encoding and writing happen afterwards, so the UI keeps running.
+ * The file is written in blocks on a separate thread while the next rows are encoded.
+ */
 static void makeScreenshot(const std::string& filename) {
-    if (lvgl::lock(50 / portTICK_PERIOD_MS)) {
-        if (lv_screenshot_create(lv_scr_act(), LV_100ASK_SCREENSHOT_SV_PNG, filename.c_str())) {
-            TT_LOG_I(TAG, "Screenshot saved to %s", filename.c_str());
-        } else {
-            TT_LOG_E(TAG, "Screenshot not saved to %s", filename.c_str());
+    const auto color_format = getSnapshotColorFormat();
+
+    if (!lvgl::lock(50 / portTICK_PERIOD_MS)) {
+        TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
+        return;
+    }
+    const auto capture_start_time = kernel::getMicros();
+    lv_draw_buf_t* snapshot = lv_snapshot_take(lv_screen_active(), color_format);
+    lvgl::unlock();
+    const auto capture_duration = kernel::getMicros() - capture_start_time;
+
+    if (snapshot == nullptr) {
+        TT_LOG_E(TAG, "Failed to take snapshot");
+        return;
+    }
+
+    const auto encode_start_time = kernel::getMicros();
+    const uint32_t width = snapshot->header.w;
+    const uint32_t height = snapshot->header.h;
+    const uint32_t stride = snapshot->header.stride;
+    bool success = false;
+    uint64_t bytes_written = 0;
+
+    file::DoubleBufferedWriter writer;
+    if (writer.open(filename, false)) {
+        auto row = std::make_unique<uint8_t[]>(width * 3);
+        file::PngEncoder encoder(width, height, [&writer](const uint8_t* data, size_t size) {
+            return writer.write(data, size);
+        });
+        for (uint32_t y = 0; y < height && !encoder.hasFailed(); y++) {
+            convertRow(color_format, snapshot->data + y * stride, row.get(), width);
+            encoder.writeRow(row.get());
         }
+        success = encoder.finish();
+        success = writer.close() && success;
+        bytes_written = encoder.getBytesWritten();
+    }
+    const auto encode_duration = kernel::getMicros() - encode_start_time;
+
+    // The buffer was allocated by LVGL
+    if (lvgl::lock(portMAX_DELAY)) {
+        lv_draw_buf_destroy(snapshot);
         lvgl::unlock();
+    }
+
+    if (success) {
+        const auto pixel_bytes = static_cast<double>(width) * height * 3;
+        TT_LOG_I(TAG, "Screenshot saved to %s: LVGL locked for %lld ms, encoded %llu bytes in %lld ms (%.2f MB/s)",
+            filename.c_str(),
+            static_cast<long long>(capture_duration / 1000),
+            static_cast<unsigned long long>(bytes_written),
+            static_cast<long long>(encode_duration / 1000),
+            pixel_bytes / static_cast<double>(std::max<int64_t>(encode_duration, 1))
+        );
     } else {
-        TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
+        TT_LOG_E(TAG, "Screenshot not saved to %s", filename.c_str());
     }
 }
 
@@ -109,7 +208,7 @@ void ScreenshotTask::taskStart() {
     tt_check(thread == nullptr);
     thread = new Thread(
         "screenshot",
-        8192,
+        4096,
         [this] {
             this->taskMain();
             return 0;
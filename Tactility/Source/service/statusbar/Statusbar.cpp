@@ -1,17 +1,19 @@
 #include <Tactility/lvgl/Statusbar.h>
 
-#include <Tactility/hal/power/PowerDevice.h>
 #include <Tactility/hal/sdcard/SdCardDevice.h>
 #include <Tactility/lvgl/Lvgl.h>
 #include <Tactility/lvgl/LvglSync.h>
 #include <Tactility/Mutex.h>
 #include <Tactility/service/gps/GpsService.h>
+#include <Tactility/service/power/PowerService.h>
 #include <Tactility/service/ServiceContext.h>
 #include <Tactility/service/ServicePaths.h>
 #include <Tactility/service/ServiceRegistration.h>
 #include <Tactility/service/wifi/Wifi.h>
 #include <Tactility/Timer.h>
 
+#include <atomic>
+
 namespace tt::service::statusbar {
 
 constexpr auto* TAG = "StatusbarService";
@@ -88,27 +90,12 @@ static const char* getSdCardStatusIcon(hal::sdcard::SdCardDevice::State state) {
     }
 }
 
-static _Nullable const char* getPowerStatusIcon() {
-    // TODO: Support multiple power devices?
-    std::shared_ptr<hal::power::PowerDevice> power;
-    hal::findDevices<hal::power::PowerDevice>(hal::Device::Type::Power, [&power](const auto& device) {
-        if (device->supportsMetric(hal::power::PowerDevice::MetricType::ChargeLevel)) {
-            power = device;
-            return false;
-        }
-        return true;
-    });
-
-    if (power == nullptr) {
-        return nullptr;
-    }
-
-    hal::power::PowerDevice::MetricData charge_level;
-    if (!power->getMetric(hal::power::PowerDevice::MetricType::ChargeLevel, charge_level)) {
+static _Nullable const char* getPowerStatusIcon(const power::PowerSnapshot& snapshot) {
+    if (!snapshot.chargeLevel.has_value()) {
         return nullptr;
     }
 
-    uint8_t charge = charge_level.valueAsUint8;
+    uint8_t charge = *snapshot.chargeLevel;
 
     if (charge >= 95) {
         return STATUSBAR_ICON_POWER_100;
@@ -147,6 +134,13 @@ class StatusbarService final : public Service {
     const char* sdcard_last_icon = nullptr;
     int8_t power_icon_id;
     const char* power_last_icon = nullptr;
+    /** Set by the power service when the charge level crosses a threshold, so the UI never reads power hardware */
+    std::atomic<const char*> power_desired_icon = nullptr;
+    PubSub<power::PowerSnapshot>::SubscriptionHandle power_subscription = nullptr;
+
+    /** Device lookups are cached until the device registry changes */
+    uint32_t cached_device_generation = UINT32_MAX;
+    std::shared_ptr<hal::sdcard::SdCardDevice> sdcard_device;
 
     std::unique_ptr<ServicePaths> paths;
 
@@ -158,6 +152,15 @@ class StatusbarService final : public Service {
         mutex.unlock();
     }
 
+    void updateDevices() {
+        auto generation = hal::getDeviceGeneration();
+        if (generation != cached_device_generation) {
+            // TODO: Support multiple SD cards
+            sdcard_device = hal::findFirstDevice<hal::sdcard::SdCardDevice>(hal::Device::Type::SdCard);
+            cached_device_generation = generation;
+        }
+    }
+
     void updateGpsIcon() {
         auto gps_state = gps::findGpsService()->getState();
         bool show_icon = (gps_state == gps::State::OnPending) || (gps_state == gps::State::On);
@@ -190,7 +193,7 @@ class StatusbarService final : public Service {
     }
 
     void updatePowerStatusIcon() {
-        const char* desired_icon = getPowerStatusIcon();
+        const char* desired_icon = power_desired_icon;
         if (power_last_icon != desired_icon) {
             if (desired_icon != nullptr) {
                 auto icon_path = "A:" + paths->getAssetsPath(desired_icon);
@@ -204,11 +207,8 @@ class StatusbarService final : public Service {
     }
 
     void updateSdCardIcon() {
-        auto sdcards = hal::findDevices<hal::sdcard::SdCardDevice>(hal::Device::Type::SdCard);
-        // TODO: Support multiple SD cards
-        auto sdcard = sdcards.empty() ? nullptr : sdcards[0];
-        if (sdcard != nullptr) {
-            auto state = sdcard->getState(50 / portTICK_PERIOD_MS);
+        if (sdcard_device != nullptr) {
+            auto state = sdcard_device->getState(50 / portTICK_PERIOD_MS);
             if (state != hal::sdcard::SdCardDevice::State::Timeout) {
                 auto* desired_icon = getSdCardStatusIcon(state);
                 if (sdcard_last_icon != desired_icon) {
@@ -225,6 +225,7 @@ class StatusbarService final : public Service {
     void update() {
         if (lvgl::isStarted()) {
             if (lvgl::lock(100)) {
+                updateDevices();
                 updateGpsIcon();
                 updateWifiIcon();
                 updateSdCardIcon();
@@ -258,6 +259,16 @@ public:
 
         paths = serviceContext.getPaths();
 
+        auto power_service = power::findPowerService();
+        power_subscription = power_service->getPubsub()->subscribe([this](const auto& snapshot) {
+            power_desired_icon = getPowerStatusIcon(snapshot);
+        });
+        // Read after subscribing, so no change is missed
+        auto power_snapshot = power_service->getSnapshot();
+        if (power_snapshot != nullptr) {
+            power_desired_icon = getPowerStatusIcon(*power_snapshot);
+        }
+
         // TODO: Make thread-safe for LVGL
         lvgl::statusbar_icon_set_visibility(wifi_icon_id, true);
 
@@ -278,6 +289,9 @@ public:
     void onStop(ServiceContext& service) override{
         updateTimer->stop();
         updateTimer = nullptr;
+
+        power::findPowerService()->getPubsub()->unsubscribe(power_subscription);
+        power_subscription = nullptr;
     }
 };
 
@@ -1,8 +1,8 @@
 #include "Tactility/service/wifi/WifiApSettings.h"
-#include "Tactility/file/PropertiesFile.h"
 
 #include <Tactility/crypt/Crypt.h>
 #include <Tactility/file/File.h>
+#include <Tactility/settings/SettingsStore.h>
 
 #include <cstring>
 #include <format>
@@ -15,7 +15,9 @@ namespace tt::service::wifi::settings {
 
 constexpr auto* TAG = "WifiApSettings";
 
-constexpr auto* AP_SETTINGS_FORMAT = "/data/settings/{}.ap.properties";
+constexpr auto* AP_SETTINGS_NAMESPACE_FORMAT = "wifi.ap.{}";
+/** Older versions stored every access point in a properties file: it is imported into the settings store */
+constexpr auto* AP_LEGACY_SETTINGS_FORMAT = "/data/settings/{}.ap.properties";
 
 constexpr auto* AP_PROPERTIES_KEY_SSID = "ssid";
 constexpr auto* AP_PROPERTIES_KEY_PASSWORD = "password";
@@ -48,8 +50,8 @@ bool readHex(const std::string& input, uint8_t* buffer, int length) {
     return true;
 }
 
-static std::string getApPropertiesFilePath(const std::string& ssid) {
-    return std::format(AP_SETTINGS_FORMAT, ssid);
+static std::string getApNamespace(const std::string& ssid) {
+    return std::format(AP_SETTINGS_NAMESPACE_FORMAT, ssid);
 }
 
 static bool encrypt(const std::string& ssidInput, std::string& ssidOutput) {
@@ -111,50 +113,35 @@ static bool decrypt(const std::string& ssidInput, std::string& ssidOutput) {
 }
 
 bool contains(const std::string& ssid) {
-    const auto file_path = getApPropertiesFilePath(ssid);
-    return file::isFile(file_path);
+    return tt::settings::getSettingsStore().contains(getApNamespace(ssid), AP_PROPERTIES_KEY_SSID);
 }
 
 bool load(const std::string& ssid, WifiApSettings& apSettings) {
-    const auto file_path = getApPropertiesFilePath(ssid);
-    std::map<std::string, std::string> map;
-    if (!file::loadPropertiesFile(file_path, map)) {
-        return false;
-    }
+    auto& store = tt::settings::getSettingsStore();
+    const auto ap_namespace = getApNamespace(ssid);
 
     // SSID is required
-    if (!map.contains(AP_PROPERTIES_KEY_SSID)) {
+    if (!store.contains(ap_namespace, AP_PROPERTIES_KEY_SSID)) {
         return false;
     }
 
-    apSettings.ssid = map[AP_PROPERTIES_KEY_SSID];
+    apSettings.ssid = store.getString(ap_namespace, AP_PROPERTIES_KEY_SSID);
     assert(ssid == apSettings.ssid);
 
-    if (map.contains(AP_PROPERTIES_KEY_PASSWORD)) {
+    const auto encrypted_password = store.getString(ap_namespace, AP_PROPERTIES_KEY_PASSWORD);
+    if (encrypted_password.empty()) {
+        apSettings.password = "";
+    } else {
         std::string password_decrypted;
-        const auto& encrypted_password = map[AP_PROPERTIES_KEY_PASSWORD];
-        if (encrypted_password.empty()) {
-            apSettings.password = "";
-        } else if (decrypt(encrypted_password, password_decrypted)) {
+        if (decrypt(encrypted_password, password_decrypted)) {
             apSettings.password = password_decrypted;
         } else {
             return false;
         }
-    } else {
-        apSettings.password = "";
     }
 
-    if (map.contains(AP_PROPERTIES_KEY_AUTO_CONNECT)) {
-        apSettings.autoConnect = (map[AP_PROPERTIES_KEY_AUTO_CONNECT] == "true");
-    } else {
-        apSettings.autoConnect = true;
-    }
-
-    if (map.contains(AP_PROPERTIES_KEY_CHANNEL)) {
-        apSettings.channel = std::stoi(map[AP_PROPERTIES_KEY_CHANNEL]);
-    } else {
-        apSettings.channel = 0;
-    }
+    apSettings.autoConnect = store.getBool(ap_namespace, AP_PROPERTIES_KEY_AUTO_CONNECT, true);
+    apSettings.channel = store.getInt(ap_namespace, AP_PROPERTIES_KEY_CHANNEL, 0);
 
     return true;
 
@@ -165,10 +152,6 @@ bool save(const WifiApSettings& apSettings) {
         return false;
     }
 
-    const auto file_path = getApPropertiesFilePath(apSettings.ssid);
-
-    std::map<std::string, std::string> map;
-
     std::string password_encrypted;
     if (!apSettings.password.empty()) {
         if (!encrypt(apSettings.password, password_encrypted)) {
@@ -178,20 +161,33 @@ bool save(const WifiApSettings& apSettings) {
         password_encrypted = "";
     }
 
-    map[AP_PROPERTIES_KEY_PASSWORD] = password_encrypted;
-    map[AP_PROPERTIES_KEY_SSID] = apSettings.ssid;
-    map[AP_PROPERTIES_KEY_AUTO_CONNECT] = apSettings.autoConnect ? "true" : "false";
-    map[AP_PROPERTIES_KEY_CHANNEL] = std::to_string(apSettings.channel);
+    auto& store = tt::settings::getSettingsStore();
+    const auto ap_namespace = getApNamespace(apSettings.ssid);
+    store.setString(ap_namespace, AP_PROPERTIES_KEY_PASSWORD, password_encrypted);
+    store.setString(ap_namespace, AP_PROPERTIES_KEY_SSID, apSettings.ssid);
+    store.setBool(ap_namespace, AP_PROPERTIES_KEY_AUTO_CONNECT, apSettings.autoConnect);
+    store.setInt(ap_namespace, AP_PROPERTIES_KEY_CHANNEL, apSettings.channel);
 
-    return file::savePropertiesFile(file_path, map);
+    // Write the credentials right away, so they survive a power loss shortly after connecting
+    return store.flush();
 }
 
 bool remove(const std::string& ssid) {
-    const auto path = getApPropertiesFilePath(ssid);
-    if (!file::isFile(path)) {
+    auto& store = tt::settings::getSettingsStore();
+    const auto ap_namespace = getApNamespace(ssid);
+    if (!store.containsNamespace(ap_namespace)) {
         return false;
     }
-    return ::remove(path.c_str()) == 0;
+
+    store.removeNamespace(ap_namespace);
+
+    // The imported file holds the (encrypted) password too
+    const auto legacy_path = std::format(AP_LEGACY_SETTINGS_FORMAT, ssid);
+    if (file::isFile(legacy_path)) {
+        ::remove(legacy_path.c_str());
+    }
+
+    return store.flush();
 }
 
 }
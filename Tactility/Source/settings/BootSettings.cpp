@@ -1,9 +1,9 @@
-#include <Tactility/MountPoints.h>
 #include <Tactility/file/File.h>
 #include <Tactility/file/PropertiesFile.h>
 #include <Tactility/hal/sdcard/SdCardDevice.h>
 #include <Tactility/Log.h>
 #include <Tactility/settings/BootSettings.h>
+#include <Tactility/settings/SettingsStore.h>
 
 #include <format>
 #include <string>
@@ -13,10 +13,12 @@ namespace tt::settings {
 
 constexpr auto* TAG = "BootSettings";
 constexpr auto* PROPERTIES_FILE_FORMAT = "{}/settings/boot.properties";
+constexpr auto* SETTINGS_NAMESPACE = "boot";
 constexpr auto* PROPERTIES_KEY_LAUNCHER_APP_ID = "launcherAppId";
 constexpr auto* PROPERTIES_KEY_AUTO_START_APP_ID = "autoStartAppId";
 
-static std::string getPropertiesFilePath() {
+/** @return the path of the boot properties file on an SD card, or an empty string */
+static std::string getSdCardPropertiesFilePath() {
     const auto sdcards = hal::findDevices<hal::sdcard::SdCardDevice>(hal::Device::Type::SdCard);
     for (auto& sdcard : sdcards) {
         std::string path = std::format(PROPERTIES_FILE_FORMAT, sdcard->getMountPath());
@@ -24,20 +26,27 @@ static std::string getPropertiesFilePath() {
             return path;
         }
     }
-    return std::format(PROPERTIES_FILE_FORMAT, file::MOUNT_POINT_DATA);
+    return "";
 }
 
 bool loadBootSettings(BootSettings& properties) {
-    const std::string path = getPropertiesFilePath();
-    if (!file::loadPropertiesFile(path, [&properties](auto& key, auto& value) {
-        if (key == PROPERTIES_KEY_AUTO_START_APP_ID) {
-            properties.autoStartAppId = value;
-        } else if (key == PROPERTIES_KEY_LAUNCHER_APP_ID) {
-            properties.launcherAppId = value;
+    // A file on the SD card overrides the settings in the store
+    const std::string path = getSdCardPropertiesFilePath();
+    if (!path.empty()) {
+        if (!file::loadPropertiesFile(path, [&properties](auto& key, auto& value) {
+            if (key == PROPERTIES_KEY_AUTO_START_APP_ID) {
+                properties.autoStartAppId = value;
+            } else if (key == PROPERTIES_KEY_LAUNCHER_APP_ID) {
+                properties.launcherAppId = value;
+            }
+        })) {
+            TT_LOG_E(TAG, "Failed to load %s", path.c_str());
+            return false;
         }
-    })) {
-        TT_LOG_E(TAG, "Failed to load %s", path.c_str());
-        return false;
+    } else {
+        auto& store = getSettingsStore();
+        properties.launcherAppId = store.getString(SETTINGS_NAMESPACE, PROPERTIES_KEY_LAUNCHER_APP_ID, properties.launcherAppId);
+        properties.autoStartAppId = store.getString(SETTINGS_NAMESPACE, PROPERTIES_KEY_AUTO_START_APP_ID, properties.autoStartAppId);
     }
 
     return !properties.launcherAppId.empty();
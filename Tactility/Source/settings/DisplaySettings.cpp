@@ -1,17 +1,16 @@
 #include <Tactility/settings/DisplaySettings.h>
 
-#include <Tactility/file/PropertiesFile.h>
 #include <Tactility/hal/Device.h>
 #include <Tactility/hal/display/DisplayDevice.h>
+#include <Tactility/settings/SettingsStore.h>
 
-#include <map>
 #include <string>
 #include <utility>
 
 namespace tt::settings::display {
 
 constexpr auto* TAG = "DisplaySettings";
-constexpr auto* SETTINGS_FILE = "/data/settings/display.properties";
+constexpr auto* SETTINGS_NAMESPACE = "display";
 constexpr auto* SETTINGS_KEY_ORIENTATION = "orientation";
 constexpr auto* SETTINGS_KEY_GAMMA_CURVE = "gammaCurve";
 constexpr auto* SETTINGS_KEY_BACKLIGHT_DUTY = "backlightDuty";
@@ -64,35 +63,19 @@ static bool fromString(const std::string& str, Orientation& orientation) {
 }
 
 bool load(DisplaySettings& settings) {
-    std::map<std::string, std::string> map;
-    if (!file::loadPropertiesFile(SETTINGS_FILE, map)) {
+    auto& store = getSettingsStore();
+    if (!store.containsNamespace(SETTINGS_NAMESPACE)) {
         return false;
     }
 
-    auto orientation_entry = map.find(SETTINGS_KEY_ORIENTATION);
     Orientation orientation;
-    if (orientation_entry == map.end() || !fromString(orientation_entry->second, orientation)) {
+    if (!fromString(store.getString(SETTINGS_NAMESPACE, SETTINGS_KEY_ORIENTATION), orientation)) {
         orientation = getDefaultOrientation();
     }
 
-    auto gamma_entry = map.find(SETTINGS_KEY_GAMMA_CURVE);
-    int gamma_curve = 0;
-    if (gamma_entry != map.end()) {
-        gamma_curve = atoi(gamma_entry->second.c_str());
-    }
-
-    auto backlight_duty_entry = map.find(SETTINGS_KEY_BACKLIGHT_DUTY);
-    int backlight_duty = 200; // default
-    if (backlight_duty_entry != map.end()) {
-        backlight_duty = atoi(backlight_duty_entry->second.c_str());
-        if (backlight_duty_entry->second != "0" && backlight_duty == 0) {
-            backlight_duty = 200;
-        }
-    }
-
     settings.orientation = orientation;
-    settings.gammaCurve = gamma_curve;
-    settings.backlightDuty = backlight_duty;
+    settings.gammaCurve = store.getInt(SETTINGS_NAMESPACE, SETTINGS_KEY_GAMMA_CURVE, 0);
+    settings.backlightDuty = store.getInt(SETTINGS_NAMESPACE, SETTINGS_KEY_BACKLIGHT_DUTY, 200);
 
     return true;
 }
@@ -114,11 +97,11 @@ DisplaySettings loadOrGetDefault() {
 }
 
 bool save(const DisplaySettings& settings) {
-    std::map<std::string, std::string> map;
-    map[SETTINGS_KEY_BACKLIGHT_DUTY] = std::to_string(settings.backlightDuty);
-    map[SETTINGS_KEY_GAMMA_CURVE] = std::to_string(settings.gammaCurve);
-    map[SETTINGS_KEY_ORIENTATION] = toString(settings.orientation);
-    return file::savePropertiesFile(SETTINGS_FILE, map);
+    auto& store = getSettingsStore();
+    store.setInt(SETTINGS_NAMESPACE, SETTINGS_KEY_BACKLIGHT_DUTY, settings.backlightDuty);
+    store.setInt(SETTINGS_NAMESPACE, SETTINGS_KEY_GAMMA_CURVE, settings.gammaCurve);
+    store.setString(SETTINGS_NAMESPACE, SETTINGS_KEY_ORIENTATION, toString(settings.orientation));
+    return true;
 }
 
 lv_display_rotation_t toLvglDisplayRotation(Orientation orientation) {
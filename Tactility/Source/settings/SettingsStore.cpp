@@ -0,0 +1,705 @@
+#include <Tactility/settings/SettingsStore.h>
+
+#include <Tactility/Crc32.h>
+#include <Tactility/Log.h>
+#include <Tactility/MountPoints.h>
+#include <Tactility/Tactility.h>
+#include <Tactility/file/File.h>
+#include <Tactility/file/PropertiesFile.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <cassert>
+#include <cstring>
+#include <dirent.h>
+#include <format>
+#include <unistd.h>
+
+namespace tt::settings {
+
+constexpr auto* TAG = "SettingsStore";
+
+// region Journal format
+
+constexpr uint32_t JOURNAL_IDENTIFIER = 0x4A535454; // "TTSJ"
+constexpr uint32_t JOURNAL_VERSION = 1;
+/** Remembers which properties files were imported */
+constexpr auto* IMPORT_NAMESPACE = "imported";
+/** The journal isn't compacted while it is smaller than this */
+constexpr uint32_t JOURNAL_COMPACTION_MIN_SIZE = 4096;
+
+struct JournalHeader {
+    uint32_t identifier = JOURNAL_IDENTIFIER;
+    uint32_t version = JOURNAL_VERSION;
+};
+
+enum class EntryType : uint8_t {
+    /** Ends a batch: the value is the amount of entries in the batch */
+    Commit = 1,
+    Remove = 2,
+    RemoveNamespace = 3,
+    Bool = 4,
+    Int = 5,
+    String = 6
+};
+
+/** Followed by the namespace name, the key and the value */
+struct EntryHeader {
+    /** The CRC of the rest of the header and the data that follows it */
+    uint32_t crc;
+    EntryType type;
+    uint8_t namespaceSize;
+    uint8_t keySize;
+    uint8_t reserved;
+    uint32_t valueSize;
+};
+
+static void appendEntry(std::vector<uint8_t>& output, EntryType type, const std::string& namespaceName, const std::string& key, const void* value, uint32_t valueSize) {
+    EntryHeader header = {
+        .crc = 0,
+        .type = type,
+        .namespaceSize = static_cast<uint8_t>(namespaceName.size()),
+        .keySize = static_cast<uint8_t>(key.size()),
+        .reserved = 0,
+        .valueSize = valueSize
+    };
+
+    auto offset = output.size();
+    output.resize(offset + sizeof(EntryHeader) + header.namespaceSize + header.keySize + valueSize);
+    auto* data = output.data() + offset;
+    memcpy(data, &header, sizeof(EntryHeader));
+    memcpy(data + sizeof(EntryHeader), namespaceName.data(), header.namespaceSize);
+    memcpy(data + sizeof(EntryHeader) + header.namespaceSize, key.data(), header.keySize);
+    if (valueSize > 0) {
+        memcpy(data + sizeof(EntryHeader) + header.namespaceSize + header.keySize, value, valueSize);
+    }
+
+    header.crc = crc32(data + sizeof(uint32_t), output.size() - offset - sizeof(uint32_t));
+    memcpy(data, &header.crc, sizeof(uint32_t));
+}
+
+static void appendValueEntry(std::vector<uint8_t>& output, const std::string& namespaceName, const std::string& key, const SettingsStore::Value& value) {
+    if (const auto* bool_value = std::get_if<bool>(&value)) {
+        uint8_t data = *bool_value ? 1 : 0;
+        appendEntry(output, EntryType::Bool, namespaceName, key, &data, sizeof(data));
+    } else if (const auto* int_value = std::get_if<int32_t>(&value)) {
+        appendEntry(output, EntryType::Int, namespaceName, key, int_value, sizeof(int32_t));
+    } else {
+        const auto& string_value = std::get<std::string>(value);
+        appendEntry(output, EntryType::String, namespaceName, key, string_value.data(), string_value.size());
+    }
+}
+
+static void appendCommitEntry(std::vector<uint8_t>& output, uint32_t entryCount) {
+    appendEntry(output, EntryType::Commit, "", "", &entryCount, sizeof(entryCount));
+}
+
+static void appendJournalHeader(std::vector<uint8_t>& output) {
+    JournalHeader header;
+    auto* data = reinterpret_cast<const uint8_t*>(&header);
+    output.insert(output.end(), data, data + sizeof(JournalHeader));
+}
+
+/** A parsed entry that refers to the data of the journal */
+struct Entry {
+    EntryType type;
+    std::string_view namespaceName;
+    std::string_view key;
+    const uint8_t* value;
+    uint32_t valueSize;
+};
+
+/**
+ * Parse the entry at the offset.
+ * @return the size of the entry, or 0 when the entry is incomplete or corrupt
+ */
+static size_t parseEntry(const std::vector<uint8_t>& data, size_t offset, Entry& entry) {
+    if (data.size() - offset < sizeof(EntryHeader)) {
+        return 0;
+    }
+
+    EntryHeader header;
+    memcpy(&header, data.data() + offset, sizeof(EntryHeader));
+    size_t payload_size = (size_t)header.namespaceSize + header.keySize + header.valueSize;
+    if (header.valueSize > data.size() || data.size() - offset - sizeof(EntryHeader) < payload_size) {
+        return 0;
+    }
+
+    auto entry_size = sizeof(EntryHeader) + payload_size;
+    if (header.crc != crc32(data.data() + offset + sizeof(uint32_t), entry_size - sizeof(uint32_t))) {
+        return 0;
+    }
+
+    auto* payload = reinterpret_cast<const char*>(data.data() + offset + sizeof(EntryHeader));
+    entry.type = header.type;
+    entry.namespaceName = std::string_view(payload, header.namespaceSize);
+    entry.key = std::string_view(payload + header.namespaceSize, header.keySize);
+    entry.value = reinterpret_cast<const uint8_t*>(payload + header.namespaceSize + header.keySize);
+    entry.valueSize = header.valueSize;
+    return entry_size;
+}
+
+static bool toValue(const Entry& entry, SettingsStore::Value& value) {
+    switch (entry.type) {
+        case EntryType::Bool:
+            if (entry.valueSize != 1) {
+                return false;
+            }
+            value = (entry.value[0] != 0);
+            return true;
+        case EntryType::Int: {
+            if (entry.valueSize != sizeof(int32_t)) {
+                return false;
+            }
+            int32_t int_value;
+            memcpy(&int_value, entry.value, sizeof(int32_t));
+            value = int_value;
+            return true;
+        }
+        case EntryType::String:
+            value = std::string(reinterpret_cast<const char*>(entry.value), entry.valueSize);
+            return true;
+        default:
+            return false;
+    }
+}
+
+/** @return false when the file couldn't be stored completely */
+static bool writeFile(FILE* file, const void* data, size_t size) {
+    return fwrite(data, size, 1, file) == 1 && fflush(file) == 0 && fsync(fileno(file)) == 0;
+}
+
+// endregion
+
+SettingsStore::SettingsStore(std::string filePath, uint32_t flushDelayMillis) :
+    filePath(std::move(filePath)),
+    flushDelayMillis(flushDelayMillis)
+{
+    if (flushDelayMillis > 0) {
+        // The timer task has a small stack and is shared by all timers: the file IO happens on the main dispatcher
+        flushTimer = std::make_unique<Timer>(Timer::Type::Once, [this] {
+            getMainDispatcher().dispatch([this, guard = flushGuard] {
+                auto lock = guard->mutex.asScopedLock();
+                lock.lock();
+                if (guard->isAlive) {
+                    flush();
+                }
+            });
+        });
+    }
+}
+
+SettingsStore::~SettingsStore() {
+    if (flushTimer != nullptr) {
+        flushTimer->stop();
+        flushTimer = nullptr;
+    }
+
+    // Waits for a dispatched flush that is running
+    auto guard_lock = flushGuard->mutex.asScopedLock();
+    guard_lock.lock();
+    flushGuard->isAlive = false;
+    guard_lock.unlock();
+
+    flush();
+}
+
+// region Loading
+
+bool SettingsStore::open() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ensureLoaded();
+    return isLoadSuccessful;
+}
+
+void SettingsStore::ensureLoaded() {
+    if (!isLoaded) {
+        isLoadSuccessful = load();
+        isLoaded = true;
+    }
+}
+
+bool SettingsStore::load() {
+    auto file_lock = file::getLock(filePath)->asScopedLock();
+    file_lock.lock();
+
+    // A compaction was interrupted after the journal was removed: the new journal is complete
+    auto temp_path = filePath + ".tmp";
+    if (file::isFile(temp_path)) {
+        if (!file::isFile(filePath)) {
+            TT_LOG_W(TAG, "Recovering %s from an interrupted compaction", filePath.c_str());
+            rename(temp_path.c_str(), filePath.c_str());
+        } else {
+            ::remove(temp_path.c_str());
+        }
+    }
+
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(filePath.c_str(), "rb"));
+    if (file == nullptr) {
+        TT_LOG_I(TAG, "No journal at %s", filePath.c_str());
+        writeOffset = 0;
+        return true;
+    }
+
+    auto file_size = file::getSize(file.get());
+    std::vector<uint8_t> data(file_size > 0 ? file_size : 0);
+    if (!data.empty() && fread(data.data(), data.size(), 1, file.get()) != 1) {
+        TT_LOG_E(TAG, "Failed to read %s", filePath.c_str());
+        return false;
+    }
+    file = nullptr;
+
+    JournalHeader header;
+    if (data.size() < sizeof(JournalHeader)) {
+        // Interrupted while the journal was created
+        writeOffset = 0;
+        return true;
+    }
+
+    memcpy(&header, data.data(), sizeof(JournalHeader));
+    if (header.identifier != JOURNAL_IDENTIFIER || header.version != JOURNAL_VERSION) {
+        TT_LOG_E(TAG, "Invalid journal %s", filePath.c_str());
+        return false;
+    }
+
+    // Collect the entries of a batch until its commit
+    std::vector<Entry> batch;
+    size_t offset = sizeof(JournalHeader);
+    size_t committed_offset = offset;
+    uint32_t batch_count = 0;
+    while (offset < data.size()) {
+        Entry entry;
+        auto entry_size = parseEntry(data, offset, entry);
+        if (entry_size == 0) {
+            break;
+        }
+        offset += entry_size;
+
+        if (entry.type != EntryType::Commit) {
+            batch.push_back(entry);
+            continue;
+        }
+
+        uint32_t entry_count = 0;
+        if (entry.valueSize == sizeof(uint32_t)) {
+            memcpy(&entry_count, entry.value, sizeof(uint32_t));
+        }
+        if (entry_count != batch.size()) {
+            break;
+        }
+
+        for (const auto& batch_entry : batch) {
+            std::string namespace_name(batch_entry.namespaceName);
+            if (batch_entry.type == EntryType::RemoveNamespace) {
+                namespaces.erase(namespace_name);
+            } else if (batch_entry.type == EntryType::Remove) {
+                auto namespace_iterator = namespaces.find(namespace_name);
+                if (namespace_iterator != namespaces.end()) {
+                    namespace_iterator->second.erase(std::string(batch_entry.key));
+                    if (namespace_iterator->second.empty()) {
+                        namespaces.erase(namespace_iterator);
+                    }
+                }
+            } else {
+                Value value;
+                if (toValue(batch_entry, value)) {
+                    namespaces[namespace_name][std::string(batch_entry.key)] = std::move(value);
+                } else {
+                    TT_LOG_W(TAG, "Skipping invalid entry for %s/%.*s", namespace_name.c_str(), (int)batch_entry.key.size(), batch_entry.key.data());
+                }
+            }
+        }
+
+        batch.clear();
+        batch_count++;
+        committed_offset = offset;
+    }
+
+    writeOffset = committed_offset;
+    hasUncommittedData = (committed_offset < data.size());
+    if (hasUncommittedData) {
+        TT_LOG_W(TAG, "Ignoring %lu bytes after the last commit in %s", (unsigned long)(data.size() - committed_offset), filePath.c_str());
+    }
+
+    TT_LOG_I(TAG, "Loaded %s: %lu batches, %lu namespaces", filePath.c_str(), (unsigned long)batch_count, (unsigned long)namespaces.size());
+    return true;
+}
+
+// endregion
+
+// region Reading
+
+std::optional<SettingsStore::Value> SettingsStore::get(const std::string& namespaceName, const std::string& key) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ensureLoaded();
+
+    auto namespace_iterator = namespaces.find(namespaceName);
+    if (namespace_iterator == namespaces.end()) {
+        return std::nullopt;
+    }
+
+    auto value_iterator = namespace_iterator->second.find(key);
+    if (value_iterator == namespace_iterator->second.end()) {
+        return std::nullopt;
+    }
+
+    return value_iterator->second;
+}
+
+bool SettingsStore::getBool(const std::string& namespaceName, const std::string& key, bool defaultValue) {
+    auto value = get(namespaceName, key);
+    if (!value.has_value()) {
+        return defaultValue;
+    } else if (const auto* bool_value = std::get_if<bool>(&*value)) {
+        return *bool_value;
+    } else if (const auto* string_value = std::get_if<std::string>(&*value)) {
+        // Imported from a properties file
+        if (*string_value == "true") {
+            return true;
+        } else if (*string_value == "false") {
+            return false;
+        }
+    }
+    return defaultValue;
+}
+
+int32_t SettingsStore::getInt(const std::string& namespaceName, const std::string& key, int32_t defaultValue) {
+    auto value = get(namespaceName, key);
+    if (!value.has_value()) {
+        return defaultValue;
+    } else if (const auto* int_value = std::get_if<int32_t>(&*value)) {
+        return *int_value;
+    } else if (const auto* string_value = std::get_if<std::string>(&*value)) {
+        // Imported from a properties file
+        char* end;
+        auto result = strtol(string_value->c_str(), &end, 10);
+        if (!string_value->empty() && *end == '\0') {
+            return static_cast<int32_t>(result);
+        }
+    }
+    return defaultValue;
+}
+
+std::string SettingsStore::getString(const std::string& namespaceName, const std::string& key, const std::string& defaultValue) {
+    auto value = get(namespaceName, key);
+    if (!value.has_value()) {
+        return defaultValue;
+    } else if (const auto* string_value = std::get_if<std::string>(&*value)) {
+        return *string_value;
+    } else if (const auto* int_value = std::get_if<int32_t>(&*value)) {
+        return std::to_string(*int_value);
+    } else {
+        return std::get<bool>(*value) ? "true" : "false";
+    }
+}
+
+bool SettingsStore::contains(const std::string& namespaceName, const std::string& key) {
+    return get(namespaceName, key).has_value();
+}
+
+bool SettingsStore::containsNamespace(const std::string& namespaceName) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ensureLoaded();
+    return namespaces.contains(namespaceName);
+}
+
+std::vector<std::string> SettingsStore::getNamespaces(const std::string& prefix) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ensureLoaded();
+
+    std::vector<std::string> result;
+    for (auto iterator = namespaces.lower_bound(prefix); iterator != namespaces.end() && iterator->first.starts_with(prefix); ++iterator) {
+        result.push_back(iterator->first);
+    }
+    return result;
+}
+
+// endregion
+
+// region Writing
+
+bool SettingsStore::change(const std::string& namespaceName, const std::string& key, std::optional<Value> value) {
+    // The journal stores the lengths in a single byte
+    if (namespaceName.size() > maxNameLength || key.size() > maxNameLength) {
+        TT_LOG_E(TAG, "Name too long: %.32s/%.32s", namespaceName.c_str(), key.c_str());
+        return false;
+    }
+
+    {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        ensureLoaded();
+
+        auto namespace_iterator = namespaces.find(namespaceName);
+        if (value.has_value()) {
+            if (namespace_iterator != namespaces.end()) {
+                auto value_iterator = namespace_iterator->second.find(key);
+                if (value_iterator != namespace_iterator->second.end() && value_iterator->second == *value) {
+                    return true;
+                }
+            }
+            namespaces[namespaceName][key] = *value;
+        } else {
+            if (namespace_iterator == namespaces.end() || namespace_iterator->second.erase(key) == 0) {
+                return true;
+            }
+            if (namespace_iterator->second.empty()) {
+                namespaces.erase(namespace_iterator);
+            }
+        }
+
+        // Only the last change of a key is written
+        pendingChanges[{namespaceName, key}] = std::move(value);
+    }
+
+    pubsub->publish({ .namespaceName = namespaceName, .key = key });
+    scheduleFlush();
+    return true;
+}
+
+bool SettingsStore::set(const std::string& namespaceName, const std::string& key, Value value) {
+    return change(namespaceName, key, std::move(value));
+}
+
+bool SettingsStore::remove(const std::string& namespaceName, const std::string& key) {
+    return change(namespaceName, key, std::nullopt);
+}
+
+void SettingsStore::removeNamespace(const std::string& namespaceName) {
+    {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        ensureLoaded();
+
+        if (namespaces.erase(namespaceName) == 0) {
+            return;
+        }
+
+        // The removal is written before the other changes of the batch, so earlier changes to the namespace are obsolete
+        auto iterator = pendingChanges.lower_bound({ namespaceName, "" });
+        while (iterator != pendingChanges.end() && iterator->first.first == namespaceName) {
+            iterator = pendingChanges.erase(iterator);
+        }
+        pendingNamespaceRemovals.insert(namespaceName);
+    }
+
+    pubsub->publish({ .namespaceName = namespaceName, .key = "" });
+    scheduleFlush();
+}
+
+void SettingsStore::scheduleFlush() {
+    if (flushTimer != nullptr && !flushTimer->isRunning()) {
+        flushTimer->start(kernel::millisToTicks(flushDelayMillis));
+    }
+}
+
+bool SettingsStore::importPropertiesFile(const std::string& propertiesFilePath, const std::string& namespaceName) {
+    if (getBool(IMPORT_NAMESPACE, propertiesFilePath, false) || !file::isFile(propertiesFilePath)) {
+        return false;
+    }
+
+    std::map<std::string, std::string> properties;
+    if (!file::loadPropertiesFile(propertiesFilePath, properties)) {
+        return false;
+    }
+
+    // Keys that are too long are skipped (and logged)
+    for (const auto& [key, value] : properties) {
+        set(namespaceName, key, value);
+    }
+    if (!setBool(IMPORT_NAMESPACE, propertiesFilePath, true)) {
+        return false;
+    }
+
+    TT_LOG_I(TAG, "Imported %s into %s", propertiesFilePath.c_str(), namespaceName.c_str());
+    return flush();
+}
+
+bool SettingsStore::flush() {
+    // Batches must be written in the order they were taken from the pending changes
+    auto file_mutex_lock = fileMutex.asScopedLock();
+    file_mutex_lock.lock();
+
+    std::set<std::string> namespace_removals;
+    PendingChanges changes;
+    std::vector<uint8_t> batch;
+    {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        ensureLoaded();
+
+        if (pendingNamespaceRemovals.empty() && pendingChanges.empty()) {
+            return true;
+        }
+
+        // Never replace a journal that couldn't be read: the changes are only kept in memory
+        if (!isLoadSuccessful) {
+            TT_LOG_E(TAG, "Not writing changes: %s couldn't be loaded", filePath.c_str());
+            return false;
+        }
+
+        namespace_removals = std::move(pendingNamespaceRemovals);
+        changes = std::move(pendingChanges);
+        pendingNamespaceRemovals.clear();
+        pendingChanges.clear();
+    }
+
+    if (writeOffset == 0) {
+        appendJournalHeader(batch);
+    }
+    for (const auto& namespace_name : namespace_removals) {
+        appendEntry(batch, EntryType::RemoveNamespace, namespace_name, "", nullptr, 0);
+    }
+    for (const auto& [name, value] : changes) {
+        if (value.has_value()) {
+            appendValueEntry(batch, name.first, name.second, *value);
+        } else {
+            appendEntry(batch, EntryType::Remove, name.first, name.second, nullptr, 0);
+        }
+    }
+    appendCommitEntry(batch, namespace_removals.size() + changes.size());
+
+    if (!writeBatch(batch)) {
+        // Keep the changes for the next attempt, unless they were replaced in the meantime
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        for (auto& [name, value] : changes) {
+            if (!pendingNamespaceRemovals.contains(name.first)) {
+                pendingChanges.try_emplace(name, std::move(value));
+            }
+        }
+        pendingNamespaceRemovals.merge(namespace_removals);
+        return false;
+    }
+
+    if (writeOffset > JOURNAL_COMPACTION_MIN_SIZE) {
+        compact();
+    }
+
+    return true;
+}
+
+bool SettingsStore::writeBatch(const std::vector<uint8_t>& batch) {
+    auto file_lock = file::getLock(filePath)->asScopedLock();
+    file_lock.lock();
+
+    // The journal is created when the first batch is written
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(filePath.c_str(), (writeOffset == 0) ? "wb" : "r+b"));
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "Failed to open %s", filePath.c_str());
+        return false;
+    }
+
+    // Remove the data of an interrupted batch: otherwise it could follow the new commit
+    if (hasUncommittedData) {
+        if (ftruncate(fileno(file.get()), writeOffset) != 0) {
+            TT_LOG_E(TAG, "Failed to truncate %s", filePath.c_str());
+            return false;
+        }
+        hasUncommittedData = false;
+    }
+
+    if (fseek(file.get(), writeOffset, SEEK_SET) != 0 || !writeFile(file.get(), batch.data(), batch.size())) {
+        TT_LOG_E(TAG, "Failed to write %s", filePath.c_str());
+        hasUncommittedData = true;
+        return false;
+    }
+
+    writeOffset += batch.size();
+    return true;
+}
+
+bool SettingsStore::compact() {
+    std::vector<uint8_t> snapshot;
+    appendJournalHeader(snapshot);
+    {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+
+        uint32_t entry_count = 0;
+        for (const auto& [namespace_name, values] : namespaces) {
+            for (const auto& [key, value] : values) {
+                appendValueEntry(snapshot, namespace_name, key, value);
+                entry_count++;
+            }
+        }
+        appendCommitEntry(snapshot, entry_count);
+    }
+
+    // Compact when most of the journal is made up of replaced values
+    if (writeOffset <= snapshot.size() * 2) {
+        return false;
+    }
+
+    auto file_lock = file::getLock(filePath)->asScopedLock();
+    file_lock.lock();
+
+    auto temp_path = filePath + ".tmp";
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(temp_path.c_str(), "wb"));
+    if (file == nullptr || !writeFile(file.get(), snapshot.data(), snapshot.size())) {
+        TT_LOG_E(TAG, "Failed to write %s", temp_path.c_str());
+        file = nullptr;
+        ::remove(temp_path.c_str());
+        return false;
+    }
+    file = nullptr;
+
+    // Not all file systems can rename onto an existing file (e.g. FAT on ESP32): load() recovers from an interruption in between
+    if (rename(temp_path.c_str(), filePath.c_str()) != 0) {
+        if (::remove(filePath.c_str()) != 0 || rename(temp_path.c_str(), filePath.c_str()) != 0) {
+            TT_LOG_E(TAG, "Failed to replace %s", filePath.c_str());
+            return false;
+        }
+    }
+
+    TT_LOG_I(TAG, "Compacted %s from %lu to %lu bytes", filePath.c_str(), (unsigned long)writeOffset, (unsigned long)snapshot.size());
+    writeOffset = snapshot.size();
+    hasUncommittedData = false;
+    compactionCount++;
+    return true;
+}
+
+uint32_t SettingsStore::getJournalSize() {
+    auto file_mutex_lock = fileMutex.asScopedLock();
+    file_mutex_lock.lock();
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ensureLoaded();
+    return writeOffset;
+}
+
+// endregion
+
+/** Import the properties files that older versions used for the settings that are now in the store */
+static bool importLegacySettings(SettingsStore& store) {
+    auto settings_path = std::format("{}/settings", file::MOUNT_POINT_DATA);
+    store.importPropertiesFile(settings_path + "/display.properties", "display");
+    store.importPropertiesFile(settings_path + "/system.properties", "system");
+    store.importPropertiesFile(settings_path + "/boot.properties", "boot");
+
+    // Wi-Fi access points: {ssid}.ap.properties
+    constexpr std::string_view ap_suffix = ".ap.properties";
+    std::vector<dirent> dirent_list;
+    file::scandir(settings_path, dirent_list, [](const dirent* entry) {
+        return (entry->d_type == file::TT_DT_REG && std::string_view(entry->d_name).ends_with(".ap.properties")) ? 0 : -1;
+    }, nullptr);
+    for (const auto& entry : dirent_list) {
+        std::string_view name = entry.d_name;
+        auto ssid = name.substr(0, name.size() - ap_suffix.size());
+        store.importPropertiesFile(std::format("{}/{}", settings_path, name), std::format("wifi.ap.{}", ssid));
+    }
+
+    return true;
+}
+
+SettingsStore& getSettingsStore() {
+    static SettingsStore store(std::format("{}/settings/settings.journal", file::MOUNT_POINT_DATA));
+    static bool is_imported = importLegacySettings(store);
+    assert(is_imported);
+    return store;
+}
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <private/elf_symbol.h>
+
+/**
+ * The symbol lists (the .inc files in this directory) consist of TT_ELF_SYMBOL() and TT_ELF_SYMBOL_NAMED() entries.
+ * Here they become esp_elfsym entries, like ESP_ELFSYM_EXPORT() does.
+ * symbols/names.h includes the same lists to get only the names.
+ */
+#define TT_ELF_SYMBOL(symbol) { #symbol, (void*)&symbol },
+/** For symbols that are exported by another name (e.g. a mangled C++ name) */
+#define TT_ELF_SYMBOL_NAMED(name, symbol) { name, (void*)&(symbol) },
@@ -0,0 +1,59 @@
+#pragma once
+
+// main.inc checks __HAVE_LOCALE_INFO__
+#include <ctype.h>
+#include <span>
+
+// The names of the exported symbols, in the same order as the esp_elfsym tables.
+// They don't need the declarations of the symbols, so they can be sorted at compile time.
+
+#pragma push_macro("TT_ELF_SYMBOL")
+#pragma push_macro("TT_ELF_SYMBOL_NAMED")
+#undef TT_ELF_SYMBOL
+#undef TT_ELF_SYMBOL_NAMED
+#define TT_ELF_SYMBOL(symbol) #symbol,
+#define TT_ELF_SYMBOL_NAMED(name, symbol) name,
+
+constexpr const char* main_symbol_names[] = {
+#include "main.inc"
+};
+
+constexpr const char* gcc_soft_float_symbol_names[] = {
+#include "gcc_soft_float.inc"
+};
+
+constexpr const char* stl_symbol_names[] = {
+#include "stl.inc"
+};
+
+constexpr const char* cplusplus_symbol_names[] = {
+#include "cplusplus.inc"
+};
+
+constexpr const char* esp_event_symbol_names[] = {
+#include "esp_event.inc"
+};
+
+constexpr const char* esp_http_client_symbol_names[] = {
+#include "esp_http_client.inc"
+};
+
+constexpr const char* pthread_symbol_names[] = {
+#include "pthread.inc"
+};
+
+#undef TT_ELF_SYMBOL
+#undef TT_ELF_SYMBOL_NAMED
+#pragma pop_macro("TT_ELF_SYMBOL_NAMED")
+#pragma pop_macro("TT_ELF_SYMBOL")
+
+/** Must have the same order as the esp_elfsym tables that the resolver uses */
+constexpr std::span<const char* const> symbol_name_tables[] = {
+    main_symbol_names,
+    gcc_soft_float_symbol_names,
+    stl_symbol_names,
+    cplusplus_symbol_names,
+    esp_event_symbol_names,
+    esp_http_client_symbol_names,
+    pthread_symbol_names
+};
@@ -1,4 +1,4 @@
-#include <private/elf_symbol.h>
+#include <symbols/export.h>
 #include <cstddef>
 
 #include <symbols/cplusplus.h>
@@ -10,9 +10,7 @@ extern "C" {
 }
 
 const esp_elfsym cplusplus_symbols[] = {
-    ESP_ELFSYM_EXPORT(_Znwj), // operator new(unsigned int)
-    ESP_ELFSYM_EXPORT(_ZdlPvj), // operator delete(void*, unsigned int)
-    ESP_ELFSYM_EXPORT(__cxa_pure_virtual), // class-related, see https://arobenko.github.io/bare_metal_cpp/
+#include "symbols/cplusplus.inc"
     // delimiter
     ESP_ELFSYM_END
 };
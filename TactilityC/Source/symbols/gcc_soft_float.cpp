@@ -1,4 +1,4 @@
-#include <private/elf_symbol.h>
+#include <symbols/export.h>
 #include <cstddef>
 
 #include <symbols/gcc_soft_float.h>
@@ -146,139 +146,7 @@ int __gtdf2(double a, double b);
 } // extern "C"
 
 const esp_elfsym gcc_soft_float_symbols[] = {
-    ESP_ELFSYM_EXPORT(__addsf3),
-    ESP_ELFSYM_EXPORT(__adddf3),
-    // ESP_ELFSYM_EXPORT(__addtf3),
-    // ESP_ELFSYM_EXPORT(__addxf3),
-
-    ESP_ELFSYM_EXPORT(__subsf3),
-    ESP_ELFSYM_EXPORT(__subdf3),
-    // ESP_ELFSYM_EXPORT(__subtf3),
-    // ESP_ELFSYM_EXPORT(__subxf3),
-
-    ESP_ELFSYM_EXPORT(__mulsf3),
-    ESP_ELFSYM_EXPORT(__muldf3),
-    // ESP_ELFSYM_EXPORT(__multf3),
-    // ESP_ELFSYM_EXPORT(__mulxf3),
-
-    ESP_ELFSYM_EXPORT(__divsf3),
-    ESP_ELFSYM_EXPORT(__divdf3),
-    // ESP_ELFSYM_EXPORT(__divtf3),
-    // ESP_ELFSYM_EXPORT(__divxf3),
-
-    ESP_ELFSYM_EXPORT(__negsf2),
-    ESP_ELFSYM_EXPORT(__negdf2),
-    // ESP_ELFSYM_EXPORT(__negtf2),
-    // ESP_ELFSYM_EXPORT(__negxf2),
-
-    ESP_ELFSYM_EXPORT(__extendsfdf2),
-    // ESP_ELFSYM_EXPORT(__extendsftf2),
-    // ESP_ELFSYM_EXPORT(__extendsfxf2),
-    // ESP_ELFSYM_EXPORT(__extenddftf2),
-    // ESP_ELFSYM_EXPORT(__extenddfxf2),
-
-    // ESP_ELFSYM_EXPORT(__truncxfdf2),
-    // ESP_ELFSYM_EXPORT(__trunctfdf2),
-    // ESP_ELFSYM_EXPORT(__truncxfsf2),
-    // ESP_ELFSYM_EXPORT(__trunctfsf2),
-    ESP_ELFSYM_EXPORT(__truncdfsf2),
-
-    ESP_ELFSYM_EXPORT(__fixsfsi),
-    ESP_ELFSYM_EXPORT(__fixdfsi),
-    // ESP_ELFSYM_EXPORT(__fixtfsi),
-    // ESP_ELFSYM_EXPORT(__fixxfsi),
-
-    ESP_ELFSYM_EXPORT(__fixsfdi),
-    ESP_ELFSYM_EXPORT(__fixdfdi),
-    // ESP_ELFSYM_EXPORT(__fixtfdi),
-    // ESP_ELFSYM_EXPORT(__fixxfdi),
-
-    // ESP_ELFSYM_EXPORT(__fixsfti),
-    // ESP_ELFSYM_EXPORT(__fixdfti),
-    // ESP_ELFSYM_EXPORT(__fixtfti),
-    // ESP_ELFSYM_EXPORT(__fixxfti),
-
-    // ESP_ELFSYM_EXPORT(__fixunssfsi),
-    // ESP_ELFSYM_EXPORT(__fixunsdfsi),
-    // ESP_ELFSYM_EXPORT(__fixunstfsi),
-    // ESP_ELFSYM_EXPORT(__fixunsxfsi),
-
-    ESP_ELFSYM_EXPORT(__fixunssfdi),
-    ESP_ELFSYM_EXPORT(__fixunsdfdi),
-    // ESP_ELFSYM_EXPORT(__fixunstfdi),
-    // ESP_ELFSYM_EXPORT(__fixunsxfdi),
-
-    // ESP_ELFSYM_EXPORT(__fixunssfti),
-    // ESP_ELFSYM_EXPORT(__fixunsdfti),
-    // ESP_ELFSYM_EXPORT(__fixunstfti),
-    // ESP_ELFSYM_EXPORT(__fixunsxfti),
-
-    // ESP_ELFSYM_EXPORT(__floatsisf),
-    // ESP_ELFSYM_EXPORT(__floatsidf),
-    // ESP_ELFSYM_EXPORT(__floatsitf),
-    // ESP_ELFSYM_EXPORT(__floatsixf),
-
-    ESP_ELFSYM_EXPORT(__floatdisf),
-    ESP_ELFSYM_EXPORT(__floatdidf),
-    // ESP_ELFSYM_EXPORT(__floatditf),
-    // ESP_ELFSYM_EXPORT(__floatdixf),
-
-    // ESP_ELFSYM_EXPORT(__floattisf),
-    // ESP_ELFSYM_EXPORT(__floattidf),
-    // ESP_ELFSYM_EXPORT(__floattitf),
-    // ESP_ELFSYM_EXPORT(__floattixf),
-
-    ESP_ELFSYM_EXPORT(__floatunsisf),
-    ESP_ELFSYM_EXPORT(__floatunsidf),
-    // ESP_ELFSYM_EXPORT(__floatunsitf),
-    // ESP_ELFSYM_EXPORT(__floatunsixf),
-
-    ESP_ELFSYM_EXPORT(__floatundisf),
-    ESP_ELFSYM_EXPORT(__floatundidf),
-    // ESP_ELFSYM_EXPORT(__floatunditf),
-    // ESP_ELFSYM_EXPORT(__floatundixf),
-
-    // ESP_ELFSYM_EXPORT(__floatuntisf),
-    // ESP_ELFSYM_EXPORT(__floatuntidf),
-    // ESP_ELFSYM_EXPORT(__floatuntitf),
-    // ESP_ELFSYM_EXPORT(__floatuntixf),
-
-    ESP_ELFSYM_EXPORT(__powisf2),
-    ESP_ELFSYM_EXPORT(__powidf2),
-    // ESP_ELFSYM_EXPORT(__powitf2),
-    // ESP_ELFSYM_EXPORT(__powixf2),
-
-    // ESP_ELFSYM_EXPORT(__cmpsf2),
-    // ESP_ELFSYM_EXPORT(__cmpdf2),
-    // ESP_ELFSYM_EXPORT(__cmptf2),
-
-    ESP_ELFSYM_EXPORT(__unordsf2),
-    ESP_ELFSYM_EXPORT(__unorddf2),
-    // ESP_ELFSYM_EXPORT(__unordtf2),
-
-    ESP_ELFSYM_EXPORT(__eqsf2),
-    ESP_ELFSYM_EXPORT(__eqdf2),
-    // ESP_ELFSYM_EXPORT(__eqtf2),
-
-    ESP_ELFSYM_EXPORT(__nesf2),
-    ESP_ELFSYM_EXPORT(__nedf2),
-    // ESP_ELFSYM_EXPORT(__netf2),
-
-    ESP_ELFSYM_EXPORT(__gesf2),
-    ESP_ELFSYM_EXPORT(__gedf2),
-    // ESP_ELFSYM_EXPORT(__getf2),
-
-    ESP_ELFSYM_EXPORT(__ltsf2),
-    ESP_ELFSYM_EXPORT(__ltdf2),
-    // ESP_ELFSYM_EXPORT(__lttf2),
-
-    ESP_ELFSYM_EXPORT(__lesf2),
-    ESP_ELFSYM_EXPORT(__ledf2),
-    // ESP_ELFSYM_EXPORT(__letf2),
-
-    ESP_ELFSYM_EXPORT(__gtsf2),
-    ESP_ELFSYM_EXPORT(__gtdf2),
-    // ESP_ELFSYM_EXPORT(__gttf2),
-
+#include "symbols/gcc_soft_float.inc"
+    // delimiter
     ESP_ELFSYM_END
 };
@@ -1,4 +1,4 @@
-#include <private/elf_symbol.h>
+#include <symbols/export.h>
 #include <cstddef>
 
 #include <symbols/pthread.h>
@@ -6,12 +6,7 @@
 #include <pthread.h>
 
 const esp_elfsym pthread_symbols[] = {
-    ESP_ELFSYM_EXPORT(pthread_create),
-    ESP_ELFSYM_EXPORT(pthread_attr_init),
-    ESP_ELFSYM_EXPORT(pthread_attr_setstacksize),
-    ESP_ELFSYM_EXPORT(pthread_detach),
-    ESP_ELFSYM_EXPORT(pthread_join),
-    ESP_ELFSYM_EXPORT(pthread_exit),
+#include "symbols/pthread.inc"
     // delimiter
     ESP_ELFSYM_END
 };
@@ -1,4 +1,4 @@
-#include <private/elf_symbol.h>
+#include <symbols/export.h>
 #include <cstddef>
 
 #include <symbols/stl.h>
@@ -6,12 +6,7 @@
 #include <bits/functexcept.h>
 
 const esp_elfsym stl_symbols[] = {
-    // Note: You have to use the mangled names here
-    { "_ZSt17__throw_bad_allocv", (void*)&(std::__throw_bad_alloc) },
-    { "_ZSt28__throw_bad_array_new_lengthv", (void*)&(std::__throw_bad_array_new_length) },
-    { "_ZSt25__throw_bad_function_callv", (void*)&(std::__throw_bad_function_call) },
-    { "_ZSt20__throw_length_errorPKc", (void*)&(std::__throw_length_error) },
-    // { "", (void*)&(std::) },
+#include "symbols/stl.inc"
     // delimiter
     ESP_ELFSYM_END
 };
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tt {
+
+/**
+ * Calculate the CRC-32 (IEEE 802.3, as used by zlib) of a buffer.
+ * @param[in] data the data
+ * @param[in] size the size of the data in bytes
+ * @param[in] crc the result of the previous call when calculating the CRC over multiple buffers
+ * @return the CRC
+ */
+uint32_t crc32(const void* data, size_t size, uint32_t crc = 0);
+
+} // namespace tt
@@ -6,9 +6,11 @@
 #pragma once
 
 #include "MessageQueue.h"
+#include "MpscQueue.h"
 #include "Mutex.h"
 #include "EventFlag.h"
 
+#include <atomic>
 #include <memory>
 #include <queue>
 
@@ -18,6 +20,14 @@ namespace tt {
  * A thread-safe way to defer code execution.
  * Generally, one task would dispatch the execution,
  * while the other thread consumes and executes the work.
+ *
+ * A Dispatcher can work in 2 modes:
+ * - Unbounded (capacity 0): a mutex-guarded queue that grows as needed.
+ * - Bounded (capacity > 0): a preallocated lock-free multi-producer single-consumer ring.
+ *   Dispatching doesn't take a lock and doesn't allocate queue storage.
+ *   When the ring is full, the OverflowPolicy decides whether dispatch() fails, waits or spills
+ *   into a mutex-guarded overflow queue. Spilled functions are consumed after the ring,
+ *   and a producer keeps spilling while the overflow queue isn't empty, so the order is preserved.
  */
 class Dispatcher final {
 
@@ -25,32 +35,88 @@ public:
 
     typedef std::function<void()> Function;
 
+    /** What to do when dispatching to a bounded Dispatcher that is full */
+    enum class OverflowPolicy {
+        /** Fail immediately */
+        Reject,
+        /**
+         * Wait for space until the dispatch timeout passes.
+         * The consumer can't wait for itself: it spills when it dispatches to its own full queue.
+         */
+        Block,
+        /** Queue in the overflow queue, which grows as needed, until the ring has space again */
+        Spill
+    };
+
+    struct Statistics {
+        /** The amount of functions waiting to be consumed */
+        uint32_t pending;
+        /** The maximum amount of queued functions (0 means unbounded) */
+        uint32_t capacity;
+        /** The highest amount of functions that were queued at any given time */
+        uint32_t highWaterMark;
+        /** The amount of functions that failed to dispatch because the queue was full */
+        uint32_t rejected;
+        /** The amount of functions that were queued in the overflow queue because the ring was full */
+        uint32_t spilled;
+    };
+
 private:
 
     Mutex mutex;
+    /** The queue of an unbounded Dispatcher, or the overflow queue of a bounded one */
     std::queue<Function> queue = {};
+    std::unique_ptr<MpscQueue<Function>> ring;
+    OverflowPolicy overflowPolicy;
     EventFlag eventFlag;
+    /** Set by the consumer when it makes space while producers wait for it (OverflowPolicy::Block) */
+    EventFlag spaceFlag;
+    std::atomic<uint32_t> waitingProducers = 0;
+    std::atomic<TaskHandle_t> consumerTask = nullptr;
+    std::atomic<uint32_t> rejectedCount = 0;
+    /** The amount of functions in the overflow queue: read without locking */
+    std::atomic<uint32_t> overflowCount = 0;
+    std::atomic<uint32_t> spilledCount = 0;
+    uint32_t unboundedHighWaterMark = 0;
+
+    bool dispatchUnbounded(Function function, TickType_t timeout);
+    bool dispatchBounded(Function function, TickType_t timeout);
+    bool spill(Function function, TickType_t timeout);
+    bool popBounded(Function& function);
+    bool popQueue(Function& function);
 
 public:
 
-    explicit Dispatcher() = default;
+    /**
+     * @param[in] capacity the maximum amount of queued functions, or 0 for an unbounded queue.
+     * A bounded capacity is rounded up to the next power of 2.
+     * @param[in] overflowPolicy what to do when a bounded queue is full (ignored for unbounded queues).
+     * Use OverflowPolicy::Spill when functions must never be dropped, e.g. when the consumer dispatches to itself.
+     */
+    explicit Dispatcher(size_t capacity = 0, OverflowPolicy overflowPolicy = OverflowPolicy::Block);
     ~Dispatcher();
 
     /**
      * Queue a function to be consumed elsewhere.
+     * When a bounded Dispatcher with OverflowPolicy::Block is full and this is called from the consuming task,
+     * the function is spilled into the overflow queue: waiting would never end.
      * @param[in] function the function to execute elsewhere
-     * @param[in] timeout lock acquisition timeout
+     * @param[in] timeout lock acquisition timeout (unbounded and spilling) or the time to wait for space (bounded with OverflowPolicy::Block)
      * @return true if dispatching was successful (timeout not reached)
      */
     bool dispatch(Function function, TickType_t timeout = portMAX_DELAY);
 
     /**
-     * Consume 1 or more dispatched function (if any) until the queue is empty.
+     * Consume 1 or more dispatched function (if any) until the queue is empty or maxCount is reached.
      * @warning The timeout is only the wait time before consuming the message! It is not a limit to the total execution time when calling this method.
      * @param[in] timeout the ticks to wait for a message
+     * @param[in] maxCount the maximum amount of functions to consume in this batch
      * @return the amount of messages that were consumed
      */
-    uint32_t consume(TickType_t timeout = portMAX_DELAY);
+    uint32_t consume(TickType_t timeout = portMAX_DELAY, uint32_t maxCount = UINT32_MAX);
+
+    /** @return the current queue statistics */
+    Statistics getStatistics() const;
 };
 
 } // namespace
@@ -15,7 +15,18 @@ class DispatcherThread final {
 
 public:
 
-    explicit DispatcherThread(const std::string& threadName, size_t threadStackSize = 4096);
+    /**
+     * @param[in] threadName the name of the thread that consumes the dispatched functions
+     * @param[in] threadStackSize the stack size in bytes of the consumer thread
+     * @param[in] queueCapacity the maximum amount of queued functions, or 0 for an unbounded queue (see Dispatcher)
+     * @param[in] overflowPolicy what to do when a bounded queue is full
+     */
+    explicit DispatcherThread(
+        const std::string& threadName,
+        size_t threadStackSize = 4096,
+        size_t queueCapacity = 0,
+        Dispatcher::OverflowPolicy overflowPolicy = Dispatcher::OverflowPolicy::Block
+    );
     ~DispatcherThread();
 
     /**
@@ -23,6 +34,9 @@ public:
      */
     bool dispatch(Dispatcher::Function function, TickType_t timeout = portMAX_DELAY);
 
+    /** @return the queue statistics of the underlying Dispatcher */
+    Dispatcher::Statistics getStatistics() const { return dispatcher.getStatistics(); }
+
     /** Start the thread (blocking). */
     void start();
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace tt {
 
 /** Used for log output filtering */
@@ -11,4 +13,46 @@ enum class LogLevel : int {
     Verbose /*!< Bigger chunks of debugging information, or frequent messages which can potentially flood the output. */
 };
 
-}
\ No newline at end of file
+struct LogStatistics {
+    /** Messages that were recorded for the log thread */
+    uint32_t deferred;
+    /** Messages that were written by the calling task (errors, or all messages when the log thread isn't running) */
+    uint32_t immediate;
+    /** Messages that were lost because the buffer was full */
+    uint32_t dropped;
+    /** Messages that were skipped because of their level */
+    uint32_t filtered;
+    /** The highest amount of messages that were waiting to be written */
+    uint32_t highWaterMark;
+};
+
+/** Use the TT_LOG_* macros instead */
+void log(LogLevel level, const char* tag, const char* format, ...);
+
+/**
+ * Set the most detailed level that is logged for a tag.
+ * @param[in] tag the tag, or nullptr to set the level for all tags that don't have their own level
+ * @param[in] level the level
+ */
+void setLogLevel(const char* tag, LogLevel level);
+
+/** @return the most detailed level that is logged for a tag (or the default level when tag is nullptr) */
+LogLevel getLogLevel(const char* tag);
+
+LogStatistics getLogStatistics();
+
+/**
+ * Start the low-priority task that formats and writes messages.
+ * From then on the TT_LOG_* macros only record the format arguments, which is much faster than formatting.
+ * Errors are still written right away, so they're not lost when the device crashes right after.
+ * Messages of different tasks can be written in a different order than they were logged in.
+ */
+void startLogThread();
+
+/** Stop the log task and write the messages that were still waiting */
+void stopLogThread();
+
+/** Wait until the log task wrote all messages that were recorded so far */
+void flushLog();
+
+}
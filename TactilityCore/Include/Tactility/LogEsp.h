@@ -5,15 +5,19 @@
 #include <esp_log.h>
 #include "Tactility/LogCommon.h"
 
+// Like ESP_LOGx: the messages above the maximum level of the project configuration are removed at compile time
+#define TT_LOG_LEVEL_LOCAL(esp_level, level, tag, format, ...) \
+    do { if (LOG_LOCAL_LEVEL >= (esp_level)) tt::log(level, tag, format, ##__VA_ARGS__); } while (0)
+
 #define TT_LOG_E(tag, format, ...) \
-    ESP_LOGE(tag, format, ##__VA_ARGS__)
+    TT_LOG_LEVEL_LOCAL(ESP_LOG_ERROR, tt::LogLevel::Error, tag, format, ##__VA_ARGS__)
 #define TT_LOG_W(tag, format, ...) \
-    ESP_LOGW(tag, format, ##__VA_ARGS__)
+    TT_LOG_LEVEL_LOCAL(ESP_LOG_WARN, tt::LogLevel::Warning, tag, format, ##__VA_ARGS__)
 #define TT_LOG_I(tag, format, ...) \
-    ESP_LOGI(tag, format, ##__VA_ARGS__)
+    TT_LOG_LEVEL_LOCAL(ESP_LOG_INFO, tt::LogLevel::Info, tag, format, ##__VA_ARGS__)
 #define TT_LOG_D(tag, format, ...) \
-    ESP_LOGD(tag, format, ##__VA_ARGS__)
+    TT_LOG_LEVEL_LOCAL(ESP_LOG_DEBUG, tt::LogLevel::Debug, tag, format, ##__VA_ARGS__)
 #define TT_LOG_V(tag, format, ...) \
-    ESP_LOGV(tag, format, ##__VA_ARGS__)
+    TT_LOG_LEVEL_LOCAL(ESP_LOG_VERBOSE, tt::LogLevel::Verbose, tag, format, ##__VA_ARGS__)
 
 #endif // ESP_PLATFORM
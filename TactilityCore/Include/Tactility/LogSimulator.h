@@ -7,12 +7,6 @@
 #include <cstdarg>
 #include <cstdio>
 
-namespace tt {
-
-void log(LogLevel level, const char* tag, const char* format, ...);
-
-} // namespace
-
 #define TT_LOG_E(tag, format, ...) \
     tt::log(tt::LogLevel::Error, tag, format, ##__VA_ARGS__)
 #define TT_LOG_W(tag, format, ...) \
@@ -0,0 +1,169 @@
+/**
+ * @file MpscQueue.h
+ *
+ * A bounded, lock-free multi-producer single-consumer queue.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace tt {
+
+/**
+ * Bounded multi-producer single-consumer queue without locks.
+ * Based on Dmitry Vyukov's bounded queue: every cell carries a sequence number
+ * that tells producers and the consumer whether the cell is free or holds a value.
+ *
+ * Cells are allocated once at construction time, so pushing and popping never allocates
+ * (as long as moving a T doesn't allocate).
+ *
+ * Any amount of tasks can call push() concurrently, but only 1 task at a time may call pop().
+ * T must be default-constructible and move-assignable.
+ */
+template<typename T>
+class MpscQueue final {
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    const size_t mask;
+    std::atomic<size_t> enqueuePosition = 0;
+    std::atomic<size_t> dequeuePosition = 0;
+    std::atomic<size_t> highWaterMark = 0;
+
+    static constexpr size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    void updateHighWaterMark(size_t count) {
+        size_t current = highWaterMark.load(std::memory_order_relaxed);
+        while (count > current && !highWaterMark.compare_exchange_weak(current, count, std::memory_order_relaxed)) {}
+    }
+
+public:
+
+    /**
+     * @param[in] capacity the minimum amount of items the queue can hold (rounded up to the next power of 2)
+     */
+    explicit MpscQueue(size_t capacity) :
+        cells(std::make_unique<Cell[]>(roundUpToPowerOfTwo(capacity))),
+        mask(roundUpToPowerOfTwo(capacity) - 1)
+    {
+        for (size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Move an item into the queue. Safe to call from multiple tasks at once.
+     * @param[in] item the item to move into the queue
+     * @return false when the queue is full (item is left untouched)
+     */
+    bool push(T&& item) {
+        return pushInPlace([&item](T& value) {
+            value = std::move(item);
+        });
+    }
+
+    /**
+     * Fill the next free cell in place, which avoids a temporary copy of large items.
+     * Safe to call from multiple tasks at once.
+     * @param[in] fill called with the item in the cell. This is not a freshly constructed T: when the cell was
+     * used before, its previous item was moved out and then assigned T() by pop(). fill must assign the whole item.
+     * @return false when the queue is full (fill isn't called)
+     */
+    template<typename Fill>
+    bool pushInPlace(Fill&& fill) {
+        Cell* cell;
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells[position & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // Full
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(cell->value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        // The consumer might already have popped this item (and more), so only count positive differences
+        const auto count = static_cast<intptr_t>(position + 1) - static_cast<intptr_t>(dequeuePosition.load(std::memory_order_relaxed));
+        if (count > 0) {
+            updateHighWaterMark(static_cast<size_t>(count));
+        }
+        return true;
+    }
+
+    /**
+     * Look at the oldest item without removing it. Must only be called by the single consumer.
+     * @return the item (valid until it is popped), or nullptr when the queue is empty
+     */
+    const T* peek() const {
+        const size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        const Cell& cell = cells[position & mask];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1) < 0) {
+            return nullptr;
+        }
+        return &cell.value;
+    }
+
+    /**
+     * Move the oldest item out of the queue. Must only be called by the single consumer.
+     * @param[out] item the destination for the popped item
+     * @return false when the queue is empty
+     */
+    bool pop(T& item) {
+        const size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        Cell& cell = cells[position & mask];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1) < 0) {
+            return false; // Empty (or the producer hasn't finished writing yet)
+        }
+
+        item = std::move(cell.value);
+        cell.value = T();
+        cell.sequence.store(position + mask + 1, std::memory_order_release);
+        dequeuePosition.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** @return the maximum amount of items in the queue */
+    size_t getCapacity() const { return mask + 1; }
+
+    /** @return the approximate amount of items in the queue (exact when no pushes are in progress) */
+    size_t getCount() const {
+        const size_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+        const size_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+        return enqueued - dequeued;
+    }
+
+    /** @return true when there are no items in the queue */
+    bool isEmpty() const { return getCount() == 0; }
+
+    /** @return the highest amount of items that were in the queue at any given time */
+    size_t getHighWaterMark() const { return highWaterMark.load(std::memory_order_relaxed); }
+};
+
+} // namespace
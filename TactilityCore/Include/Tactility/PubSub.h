@@ -1,88 +1,207 @@
 #pragma once
 
+#include "Dispatcher.h"
+#include "DispatcherThread.h"
 #include "Mutex.h"
-#include <list>
+
+#include <atomic>
+#include <vector>
 
 namespace tt {
 
-/** Publish and subscribe to messages in a thread-safe manner. */
+/**
+ * Publish and subscribe to messages in a thread-safe manner.
+ *
+ * Subscriptions are stored in an immutable snapshot (copy-on-write):
+ * subscribe() and unsubscribe() create a new snapshot, while publish() only takes a reference to the current one.
+ * Publishing never holds a lock while callbacks run, so slow subscribers don't block other publishers,
+ * and subscribers can safely publish, subscribe or unsubscribe from within their callback.
+ * Old snapshots are freed when the last publisher that uses them releases its reference.
+ */
 template<typename DataType>
 class PubSub final {
 
+public:
+
+    typedef std::function<void(const DataType&)> Callback;
+    typedef void* SubscriptionHandle;
+
+private:
+
+    typedef std::function<bool(Dispatcher::Function)> Poster;
+
     struct Subscription {
         uint64_t id;
-        std::function<void(DataType)> callback;
+        Callback callback;
+        /** Optional: when set, messages are delivered through this queue instead of on the publishing thread */
+        Poster poster;
+        /**
+         * Cleared on unsubscribe, so in-flight publishers and queued async deliveries skip the callback.
+         * This and invocations use sequential consistency: invoke() writes invocations and then reads active,
+         * while unsubscribe() writes active and then reads invocations. Acquire/release would allow both reads to see the old value.
+         */
+        std::atomic<bool> active = true;
+        /** The amount of callback invocations that are currently running */
+        std::atomic<uint32_t> invocations = 0;
     };
 
-    typedef std::list<Subscription> Subscriptions;
+    /** A callback that is running on the current thread, linked to the callback that it was called from (if any) */
+    struct Invocation {
+        const Subscription* subscription;
+        const Invocation* previous;
+    };
+
+    typedef std::vector<std::shared_ptr<Subscription>> Subscriptions;
+
+    std::atomic<std::shared_ptr<const Subscriptions>> snapshot = std::make_shared<const Subscriptions>();
+    /** Serializes writers (subscribe/unsubscribe) only: publishers never take it */
+    Mutex writeMutex;
     uint64_t lastId = 0;
-    Subscriptions items;
-    Mutex mutex;
 
-public:
+    /** The innermost callback that is running on the current thread (to detect unsubscription from within a callback) */
+    static inline thread_local const Invocation* currentInvocation = nullptr;
 
-    typedef void* SubscriptionHandle;
+    static void invoke(Subscription& subscription, const DataType& data) {
+        subscription.invocations.fetch_add(1);
+        if (subscription.active.load()) {
+            const Invocation invocation = { &subscription, currentInvocation };
+            currentInvocation = &invocation;
+            subscription.callback(data);
+            currentInvocation = invocation.previous;
+        }
+        subscription.invocations.fetch_sub(1);
+    }
+
+    /** @return the amount of callbacks of the subscription that the current thread is running (nested or re-entered) */
+    static uint32_t getOwnInvocations(const Subscription* subscription) {
+        uint32_t count = 0;
+        for (auto* invocation = currentInvocation; invocation != nullptr; invocation = invocation->previous) {
+            if (invocation->subscription == subscription) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    static void deliver(const std::shared_ptr<Subscription>& subscription, const DataType& data) {
+        if (subscription->poster == nullptr) {
+            invoke(*subscription, data);
+        } else if (subscription->active.load(std::memory_order_acquire)) {
+            subscription->poster([subscription, data] {
+                invoke(*subscription, data);
+            });
+        }
+    }
+
+    SubscriptionHandle addSubscription(Callback callback, Poster poster) {
+        writeMutex.lock();
+        auto subscription = std::make_shared<Subscription>();
+        subscription->id = ++lastId;
+        subscription->callback = std::move(callback);
+        subscription->poster = std::move(poster);
+
+        auto current = snapshot.load(std::memory_order_acquire);
+        auto updated = std::make_shared<Subscriptions>(*current);
+        updated->push_back(subscription);
+        snapshot.store(std::move(updated), std::memory_order_release);
+        writeMutex.unlock();
+
+        return reinterpret_cast<SubscriptionHandle>(subscription->id);
+    }
+
+public:
 
     PubSub() = default;
 
     ~PubSub() {
-        if (!items.empty()) {
-            TT_LOG_W("Loader", "Destroying PubSub with %d active subscriptions", items.size());
+        auto current = snapshot.load(std::memory_order_acquire);
+        if (!current->empty()) {
+            TT_LOG_W("PubSub", "Destroying PubSub with %d active subscriptions", (int)current->size());
         }
     }
 
     /** Start receiving messages at the specified handle (Threadsafe, Re-entrable)
-     * @param[in] callback
+     * @param[in] callback called on the publishing thread
      * @return subscription instance
      */
-    SubscriptionHandle subscribe(std::function<void(DataType)> callback) {
-        mutex.lock();
-        items.push_back({
-            .id = (++lastId),
-            .callback = std::move(callback)
-        });
+    SubscriptionHandle subscribe(Callback callback) {
+        return addSubscription(std::move(callback), nullptr);
+    }
 
-        mutex.unlock();
+    /** Start receiving messages asynchronously (Threadsafe, Re-entrable)
+     * The published data is copied and the callback is executed by the specified dispatcher,
+     * so a slow subscriber never delays the publisher.
+     * @warning the dispatcher must outlive the subscription and the messages that are still queued on it
+     * @param[in] callback called by the consumer of the dispatcher
+     * @param[in] dispatcher the queue to deliver messages on
+     * @return subscription instance
+     */
+    SubscriptionHandle subscribe(Callback callback, Dispatcher& dispatcher) {
+        return addSubscription(std::move(callback), [&dispatcher](Dispatcher::Function function) {
+            return dispatcher.dispatch(std::move(function));
+        });
+    }
 
-        return reinterpret_cast<SubscriptionHandle>(lastId);
+    /** @see subscribe(Callback, Dispatcher&) */
+    SubscriptionHandle subscribe(Callback callback, DispatcherThread& dispatcherThread) {
+        return addSubscription(std::move(callback), [&dispatcherThread](Dispatcher::Function function) {
+            return dispatcherThread.dispatch(std::move(function));
+        });
     }
 
     /** Stop receiving messages at the specified handle (Threadsafe, Re-entrable.)
-     * No use of `tt_pubsub_subscription` allowed after call of this method
+     * Waits for callbacks of this subscription that are running on other threads.
+     * No use of the subscription is allowed after call of this method.
+     * Messages that are still queued for an asynchronous subscription are dropped.
      * @param[in] subscription
      */
     void unsubscribe(SubscriptionHandle subscription) {
         assert(subscription);
 
-        mutex.lock();
-        bool result = false;
         auto id = reinterpret_cast<uint64_t>(subscription);
-        for (auto it = items.begin(); it != items.end(); ++it) {
-            if (it->id == id) {
-                items.erase(it);
-                result = true;
-                break;
+        std::shared_ptr<Subscription> removed;
+
+        writeMutex.lock();
+        auto current = snapshot.load(std::memory_order_acquire);
+        auto updated = std::make_shared<Subscriptions>();
+        updated->reserve(current->size());
+        for (auto& item : *current) {
+            if (item->id == id) {
+                removed = item;
+            } else {
+                updated->push_back(item);
             }
         }
+        if (removed != nullptr) {
+            snapshot.store(std::move(updated), std::memory_order_release);
+        }
+        writeMutex.unlock();
 
-        mutex.unlock();
-        tt_check(result);
+        tt_check(removed != nullptr);
+
+        removed->active.store(false);
+        // Callbacks that are running on other threads might still use the subscriber: wait for them
+        const uint32_t own_invocations = getOwnInvocations(removed.get());
+        while (removed->invocations.load() > own_invocations) {
+            kernel::delayTicks(1);
+        }
     }
 
     /** Publish something to all subscribers (Threadsafe, Re-entrable.)
      * @param[in] data the data to publish
      */
-    void publish(DataType data) {
-        mutex.lock();
-
-        // Iterate over subscribers
-        for (auto& it : items) {
-            it.callback(data);
+    void publish(const DataType& data) {
+        // Keeps the snapshot alive until all callbacks are called
+        auto current = snapshot.load(std::memory_order_acquire);
+        for (auto& subscription : *current) {
+            deliver(subscription, data);
         }
+    }
 
-        mutex.unlock();
+    /** @return the amount of active subscriptions */
+    size_t getSubscriptionCount() const {
+        return snapshot.load(std::memory_order_acquire)->size();
     }
 };
 
-
 } // namespace
@@ -7,6 +7,8 @@
  * The key is built from data including:
  *  - the internal factory MAC address
  *  - random data stored in NVS
+ * The key is derived once and then cached in memory.
+ * See Session.h for encrypting many records or large amounts of data.
  *
  * It's important to use flash encryption to avoid an attacker to get
  * access to your encrypted data. If flash encryption is disabled,
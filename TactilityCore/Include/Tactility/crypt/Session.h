@@ -0,0 +1,93 @@
+#pragma once
+
+#include <mbedtls/aes.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tt::crypt {
+
+/**
+ * AES-256 with the device key (see Crypt.h), for encrypting many records or large buffers.
+ *
+ * The device key is derived once and then cached for all sessions.
+ * A session expands the key schedules once, so every encryption or decryption call
+ * only does the actual AES work. The key schedules are cleared when the session is destroyed.
+ *
+ * A session is not thread-safe: use one session per thread.
+ */
+class Session final {
+
+    mbedtls_aes_context encryptContext;
+    mbedtls_aes_context decryptContext;
+
+    friend class CtrStream;
+
+public:
+
+    /** Create a session with the device key */
+    Session();
+
+    /** Create a session with a custom key */
+    explicit Session(const uint8_t key[32]);
+
+    ~Session();
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    /**
+     * Encrypt data with AES 256 CBC. The output is the same as crypt::encrypt().
+     * @param[in] iv the AES IV (not modified)
+     * @param[in] inData input data
+     * @param[out] outData output data (can be the same as inData)
+     * @param[in] dataLength data length, a multiple of 16 (for both inData and outData)
+     * @return 0 on success or an MBEDTLS_ERR_* code
+     */
+    int encryptCbc(const uint8_t iv[16], const uint8_t* inData, uint8_t* outData, size_t dataLength);
+
+    /**
+     * Decrypt data with AES 256 CBC. The output is the same as crypt::decrypt().
+     * @param[in] iv the AES IV (not modified)
+     * @param[in] inData input data
+     * @param[out] outData output data (can be the same as inData)
+     * @param[in] dataLength data length, a multiple of 16 (for both inData and outData)
+     * @return 0 on success or an MBEDTLS_ERR_* code
+     */
+    int decryptCbc(const uint8_t iv[16], const uint8_t* inData, uint8_t* outData, size_t dataLength);
+};
+
+/**
+ * Encrypts or decrypts a stream of data with AES 256 CTR (the same operation does both).
+ *
+ * Data can be passed in chunks of any size: the output doesn't depend on how the data is split up.
+ * Never re-use a nonce with the same key: generate a new (random) nonce for every stream.
+ */
+class CtrStream final {
+
+    Session& session;
+    uint8_t counter[16];
+    uint8_t streamBlock[16];
+    size_t streamBlockOffset = 0;
+
+public:
+
+    /**
+     * @param[in] session the session with the key (must outlive the stream)
+     * @param[in] nonce the initial counter block
+     */
+    CtrStream(Session& session, const uint8_t nonce[16]);
+
+    ~CtrStream();
+
+    /**
+     * Process the next chunk of data.
+     * @param[in] inData input data
+     * @param[out] outData output data (can be the same as inData)
+     * @param[in] dataLength the length of the data: any length is allowed
+     * @return 0 on success or an MBEDTLS_ERR_* code
+     */
+    int update(const uint8_t* inData, uint8_t* outData, size_t dataLength);
+};
+
+} // namespace tt::crypt
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tt::file {
+
+/**
+ * The entries of a directory in a compact form: an alternative to scandir() for large directories.
+ *
+ * Every entry takes 8 bytes plus the length of its name (instead of a full dirent of about 280 bytes).
+ * The names are stored back-to-back in a single buffer.
+ */
+class DirectoryListing final {
+
+public:
+
+    /**
+     * Called while reading, after every page of entries.
+     * @param[in] count the amount of entries that were read so far
+     * @return false to cancel reading
+     */
+    typedef std::function<bool(size_t count)> PageFunction;
+
+    static constexpr size_t defaultPageSize = 64;
+
+private:
+
+    struct Entry {
+        /** The offset of the name in the names buffer */
+        uint32_t nameOffset;
+        uint16_t nameLength;
+        /** One of the TT_DT_* values */
+        uint8_t type;
+    };
+
+    std::string path;
+    std::vector<Entry> entries;
+    /** All names, each followed by a '\0' */
+    std::string names;
+
+public:
+
+    explicit DirectoryListing(std::string path) : path(std::move(path)) {}
+
+    /**
+     * Read the entries of a directory, except "." and "..", and sort them (see sort()).
+     * The file lock of the directory is released between pages, so other tasks can use the storage.
+     * @param[in] path the directory to read
+     * @param[in] onPage optional callback for the progress (and cancellation)
+     * @param[in] pageSize the amount of entries per page
+     * @return the listing, or nullptr when the directory can't be read or when reading was cancelled
+     */
+    static std::unique_ptr<DirectoryListing> read(const std::string& path, const PageFunction& onPage = nullptr, size_t pageSize = defaultPageSize);
+
+    void add(const char* name, uint8_t type);
+
+    /** Sort the entries: directories first, then by name (same order as direntSortAlphaAndType()) */
+    void sort();
+
+    /** Release the memory that was reserved for adding more entries */
+    void shrinkToFit();
+
+    const std::string& getPath() const { return path; }
+
+    size_t getCount() const { return entries.size(); }
+
+    bool isEmpty() const { return entries.empty(); }
+
+    const char* getName(size_t index) const { return names.data() + entries[index].nameOffset; }
+
+    size_t getNameLength(size_t index) const { return entries[index].nameLength; }
+
+    /** @return one of the TT_DT_* values */
+    uint8_t getType(size_t index) const { return entries[index].type; }
+
+    /** @return true for directories and character devices (which is how mount points show up) */
+    bool isDirectory(size_t index) const;
+
+    /** @return the amount of heap memory that is used for the entries */
+    size_t getMemoryUsage() const { return entries.capacity() * sizeof(Entry) + names.capacity(); }
+};
+
+}
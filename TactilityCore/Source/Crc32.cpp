@@ -0,0 +1,45 @@
+#include "Tactility/Crc32.h"
+
+#ifdef ESP_PLATFORM
+#include <esp_rom_crc.h>
+#else
+#include <array>
+#endif
+
+namespace tt {
+
+#ifdef ESP_PLATFORM
+
+uint32_t crc32(const void* data, size_t size, uint32_t crc) {
+    // The ROM implementation saves the flash space of the lookup table
+    return esp_rom_crc32_le(crc, static_cast<const uint8_t*>(data), size);
+}
+
+#else
+
+static constexpr std::array<uint32_t, 256> createCrc32Table() {
+    std::array<uint32_t, 256> table = {};
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t value = i;
+        for (int bit = 0; bit < 8; bit++) {
+            value = (value & 1) ? (value >> 1) ^ 0xEDB88320 : (value >> 1);
+        }
+        table[i] = value;
+    }
+    return table;
+}
+
+static constexpr auto crc32Table = createCrc32Table();
+
+uint32_t crc32(const void* data, size_t size, uint32_t crc) {
+    auto* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = crc32Table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+#endif
+
+} // namespace tt
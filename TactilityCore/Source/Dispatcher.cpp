@@ -8,6 +8,12 @@ namespace tt {
 #define TAG "dispatcher"
 #define BACKPRESSURE_WARNING_COUNT ((EventBits_t)100)
 #define WAIT_FLAG ((EventBits_t)1U)
+#define SPACE_FLAG ((EventBits_t)1U)
+
+Dispatcher::Dispatcher(size_t capacity, OverflowPolicy overflowPolicy) :
+    ring(capacity > 0 ? std::make_unique<MpscQueue<Function>>(capacity) : nullptr),
+    overflowPolicy(overflowPolicy)
+{}
 
 Dispatcher::~Dispatcher() {
     // Wait for Mutex usage
@@ -15,16 +21,16 @@ Dispatcher::~Dispatcher() {
     mutex.unlock();
 }
 
-bool Dispatcher::dispatch(Function function, TickType_t timeout) {
-    // Mutate
+bool Dispatcher::dispatchUnbounded(Function function, TickType_t timeout) {
     if (mutex.lock(timeout)) {
         queue.push(std::move(function));
+        if (queue.size() > unboundedHighWaterMark) {
+            unboundedHighWaterMark = queue.size();
+        }
         if (queue.size() == BACKPRESSURE_WARNING_COUNT) {
             TT_LOG_W(TAG, "Backpressure: You're not consuming fast enough (100 queued)");
         }
         tt_check(mutex.unlock());
-        // Signal
-        eventFlag.set(WAIT_FLAG);
         return true;
     } else {
         TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
@@ -32,7 +38,121 @@ bool Dispatcher::dispatch(Function function, TickType_t timeout) {
     }
 }
 
-uint32_t Dispatcher::consume(TickType_t timeout) {
+bool Dispatcher::spill(Function function, TickType_t timeout) {
+    if (!mutex.lock(timeout)) {
+        TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
+        return false;
+    }
+
+    queue.push(std::move(function));
+    overflowCount.store(queue.size(), std::memory_order_release);
+    spilledCount.fetch_add(1, std::memory_order_relaxed);
+    if (queue.size() == BACKPRESSURE_WARNING_COUNT) {
+        TT_LOG_W(TAG, "Backpressure: You're not consuming fast enough (ring full and 100 spilled)");
+    }
+    tt_check(mutex.unlock());
+    return true;
+}
+
+bool Dispatcher::dispatchBounded(Function function, TickType_t timeout) {
+    // While functions are spilled, spilling producers keep spilling: they are consumed after the ring
+    if (overflowCount.load(std::memory_order_acquire) == 0 && ring->push(std::move(function))) {
+        return true;
+    }
+
+    // The consumer can't make space while it is waiting on itself
+    const bool is_consumer = consumerTask.load(std::memory_order_relaxed) == xTaskGetCurrentTaskHandle();
+    if (overflowPolicy == OverflowPolicy::Spill || (overflowPolicy == OverflowPolicy::Block && is_consumer)) {
+        return spill(std::move(function), timeout);
+    }
+
+    // Only spilled functions of the consumer are in the overflow queue: this producer doesn't have to follow them
+    if (ring->push(std::move(function))) {
+        return true;
+    }
+
+    if (overflowPolicy == OverflowPolicy::Block && timeout > 0) {
+        // Registered before pushing again, so the consumer signals any space that it makes after this
+        waitingProducers.fetch_add(1);
+        // Make sure the consumer is awake to make space
+        eventFlag.set(WAIT_FLAG);
+        TickType_t start_ticks = kernel::getTicks();
+        bool pushed = false;
+        while (true) {
+            spaceFlag.clear(SPACE_FLAG);
+            if (ring->push(std::move(function))) {
+                pushed = true;
+                break;
+            }
+
+            TickType_t wait_ticks = portMAX_DELAY;
+            if (timeout != portMAX_DELAY) {
+                TickType_t elapsed_ticks = kernel::getTicks() - start_ticks;
+                if (elapsed_ticks >= timeout) {
+                    break;
+                }
+                wait_ticks = timeout - elapsed_ticks;
+            }
+            // Another producer might take the space first: then this waits for the next consume
+            spaceFlag.wait(SPACE_FLAG, EventFlag::WaitAny, wait_ticks);
+        }
+        waitingProducers.fetch_sub(1);
+
+        if (pushed) {
+            return true;
+        }
+    }
+
+    rejectedCount.fetch_add(1, std::memory_order_relaxed);
+    TT_LOG_W(TAG, "Queue full (%d items): function rejected", (int)ring->getCapacity());
+    return false;
+}
+
+bool Dispatcher::dispatch(Function function, TickType_t timeout) {
+    bool dispatched = (ring != nullptr)
+        ? dispatchBounded(std::move(function), timeout)
+        : dispatchUnbounded(std::move(function), timeout);
+
+    if (dispatched) {
+        // Signal
+        eventFlag.set(WAIT_FLAG);
+    }
+
+    return dispatched;
+}
+
+bool Dispatcher::popBounded(Function& function) {
+    if (ring->pop(function)) {
+        // Pairs with the increment in dispatchBounded(): either the producer sees the space, or this sees the producer
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waitingProducers.load(std::memory_order_relaxed) > 0) {
+            spaceFlag.set(SPACE_FLAG);
+        }
+        return true;
+    }
+
+    return overflowCount.load(std::memory_order_acquire) > 0 && popQueue(function);
+}
+
+bool Dispatcher::popQueue(Function& function) {
+    if (!mutex.lock(10)) {
+        TT_LOG_W(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
+        return false;
+    }
+
+    bool popped = !queue.empty();
+    if (popped) {
+        function = std::move(queue.front());
+        queue.pop();
+        overflowCount.store(queue.size(), std::memory_order_release);
+    }
+    mutex.unlock();
+    return popped;
+}
+
+uint32_t Dispatcher::consume(TickType_t timeout, uint32_t maxCount) {
+    consumerTask.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+
     // Wait for signal
     uint32_t result = eventFlag.wait(WAIT_FLAG, EventFlag::WaitAny, timeout);
     if (result & EventFlag::Error) {
@@ -41,30 +161,45 @@ uint32_t Dispatcher::consume(TickType_t timeout) {
 
     eventFlag.clear(WAIT_FLAG);
 
-    // Mutate
-    bool processing = true;
+    // Don't keep any lock while calling the function, as callbacks might be slow
     uint32_t consumed = 0;
-    do {
-        if (mutex.lock(10)) {
-            if (!queue.empty()) {
-                auto function = queue.front();
-                queue.pop();
-                consumed++;
-                processing = !queue.empty();
-                // Don't keep lock as callback might be slow
-                mutex.unlock();
-                function();
-            } else {
-                processing = false;
-                mutex.unlock();
-            }
-        } else {
-            TT_LOG_W(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
+    Function function;
+    while (consumed < maxCount) {
+        bool popped = (ring != nullptr) ? popBounded(function) : popQueue(function);
+        if (!popped) {
+            return consumed;
         }
+        consumed++;
+        function();
+    }
 
-    } while (processing);
+    // Batch limit reached: make sure the next call doesn't wait for the remaining items
+    auto statistics = getStatistics();
+    if (statistics.pending > 0) {
+        eventFlag.set(WAIT_FLAG);
+    }
 
     return consumed;
 }
 
+Dispatcher::Statistics Dispatcher::getStatistics() const {
+    if (ring != nullptr) {
+        return {
+            .pending = static_cast<uint32_t>(ring->getCount()) + overflowCount.load(std::memory_order_relaxed),
+            .capacity = static_cast<uint32_t>(ring->getCapacity()),
+            .highWaterMark = static_cast<uint32_t>(ring->getHighWaterMark()),
+            .rejected = rejectedCount.load(std::memory_order_relaxed),
+            .spilled = spilledCount.load(std::memory_order_relaxed)
+        };
+    } else {
+        Statistics statistics = { 0, 0, 0, 0, 0 };
+        if (mutex.lock(10)) {
+            statistics.pending = queue.size();
+            statistics.highWaterMark = unboundedHighWaterMark;
+            mutex.unlock();
+        }
+        return statistics;
+    }
+}
+
 } // namespace
@@ -2,7 +2,9 @@
 
 namespace tt {
 
-DispatcherThread::DispatcherThread(const std::string& threadName, size_t threadStackSize) {
+DispatcherThread::DispatcherThread(const std::string& threadName, size_t threadStackSize, size_t queueCapacity, Dispatcher::OverflowPolicy overflowPolicy) :
+    dispatcher(queueCapacity, overflowPolicy)
+{
     thread = std::make_unique<Thread>(
         threadName,
         threadStackSize,
@@ -31,7 +33,7 @@ int32_t DispatcherThread::threadMain() {
 }
 
 bool DispatcherThread::dispatch(Dispatcher::Function function, TickType_t timeout) {
-    return dispatcher.dispatch(function, timeout);
+    return dispatcher.dispatch(std::move(function), timeout);
 }
 
 void DispatcherThread::start() {
@@ -0,0 +1,636 @@
+#include "Tactility/Log.h"
+
+#include "Tactility/MpscQueue.h"
+#include "Tactility/Thread.h"
+#include "Tactility/kernel/Kernel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+namespace tt {
+
+// region Platform
+
+// Implemented in LogEsp.cpp and LogSimulator.cpp
+uint32_t getLogTimestamp();
+void writeLogMessage(LogLevel level, uint32_t timestamp, const char* tag, const char* format, va_list args);
+void onLogLevelChanged(const char* tag, LogLevel level);
+
+#ifdef ESP_PLATFORM
+// Every core has its own buffer, so tasks on different cores don't compete for the same slots
+constexpr size_t LOG_BUFFER_COUNT = portNUM_PROCESSORS;
+// Matches the default level of ESP_LOGx (LogLevel has no "none")
+constexpr auto LOG_DEFAULT_LEVEL = static_cast<LogLevel>(std::max(CONFIG_LOG_DEFAULT_LEVEL, 1) - 1);
+constexpr size_t LOG_BUFFER_CAPACITY = 64;
+static size_t getLogBufferIndex() { return xPortGetCoreID(); }
+#else
+constexpr size_t LOG_BUFFER_COUNT = 1;
+constexpr auto LOG_DEFAULT_LEVEL = LogLevel::Verbose;
+constexpr size_t LOG_BUFFER_CAPACITY = 256;
+static size_t getLogBufferIndex() { return 0; }
+#endif
+
+// endregion
+
+// region Records
+
+constexpr size_t LOG_RECORD_SIZE = 96;
+constexpr size_t LOG_LINE_SIZE = 256;
+
+/**
+ * A message that wasn't formatted yet: the tag and format must be string literals (or live forever).
+ * String arguments are copied, because they usually don't outlive the log call.
+ */
+struct LogRecord {
+    const char* tag;
+    const char* format;
+    uint32_t timestamp;
+    LogLevel level;
+    uint16_t argumentsSize;
+    uint8_t arguments[LOG_RECORD_SIZE - 2 * sizeof(const char*) - sizeof(uint32_t) - sizeof(LogLevel) - sizeof(uint16_t)];
+};
+
+static_assert(sizeof(LogRecord) == LOG_RECORD_SIZE);
+
+enum class ArgumentType {
+    None,
+    Int,
+    Long,
+    LongLong,
+    IntMax,
+    Size,
+    Double,
+    LongDouble,
+    Pointer,
+    String,
+    /** Wide strings and %n */
+    Unsupported
+};
+
+struct Conversion {
+    ArgumentType type = ArgumentType::None;
+    bool hasWidthArgument = false;
+    bool hasPrecisionArgument = false;
+    /** The precision that is written in the specification itself, or -1 when there is none */
+    int precision = -1;
+    /** The length of the conversion specification, including the '%' */
+    size_t length = 0;
+};
+
+/** Parse the conversion specification that starts at the '%' */
+static Conversion parseConversion(const char* specification) {
+    Conversion conversion;
+    const char* cursor = specification + 1;
+
+    while (*cursor != '\0' && strchr("-+ #0", *cursor) != nullptr) {
+        cursor++;
+    }
+
+    if (*cursor == '*') {
+        conversion.hasWidthArgument = true;
+        cursor++;
+    } else {
+        while (*cursor >= '0' && *cursor <= '9') {
+            cursor++;
+        }
+    }
+
+    if (*cursor == '.') {
+        cursor++;
+        if (*cursor == '*') {
+            conversion.hasPrecisionArgument = true;
+            cursor++;
+        } else {
+            conversion.precision = 0;
+            while (*cursor >= '0' && *cursor <= '9') {
+                conversion.precision = conversion.precision * 10 + (*cursor - '0');
+                cursor++;
+            }
+        }
+    }
+
+    int long_count = 0;
+    bool is_intmax = false;
+    bool is_size = false;
+    bool is_long_double = false;
+    while (*cursor != '\0' && strchr("hlLjzt", *cursor) != nullptr) {
+        switch (*cursor) {
+            case 'l':
+                long_count++;
+                break;
+            case 'L':
+                is_long_double = true;
+                break;
+            case 'j':
+                is_intmax = true;
+                break;
+            case 'z':
+            case 't':
+                is_size = true;
+                break;
+            default:
+                break;
+        }
+        cursor++;
+    }
+
+    switch (*cursor) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            if (is_intmax) {
+                conversion.type = ArgumentType::IntMax;
+            } else if (is_size) {
+                conversion.type = ArgumentType::Size;
+            } else if (long_count >= 2) {
+                conversion.type = ArgumentType::LongLong;
+            } else if (long_count == 1) {
+                conversion.type = ArgumentType::Long;
+            } else {
+                conversion.type = ArgumentType::Int;
+            }
+            break;
+        case 'c':
+            conversion.type = ArgumentType::Int;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            conversion.type = is_long_double ? ArgumentType::LongDouble : ArgumentType::Double;
+            break;
+        case 'p':
+            conversion.type = ArgumentType::Pointer;
+            break;
+        case 's':
+            conversion.type = (long_count == 0) ? ArgumentType::String : ArgumentType::Unsupported;
+            break;
+        case '%':
+            conversion.type = ArgumentType::None;
+            break;
+        default:
+            conversion.type = ArgumentType::Unsupported;
+            break;
+    }
+
+    if (*cursor != '\0') {
+        cursor++;
+    }
+    conversion.length = cursor - specification;
+    return conversion;
+}
+
+template<typename T>
+static bool packValue(LogRecord& record, T value) {
+    if (record.argumentsSize + sizeof(T) > sizeof(LogRecord::arguments)) {
+        return false;
+    }
+    memcpy(record.arguments + record.argumentsSize, &value, sizeof(T));
+    record.argumentsSize += sizeof(T);
+    return true;
+}
+
+/** @return false when the arguments don't fit in the record or can't be packed */
+static bool packArguments(LogRecord& record, va_list args) {
+    for (const char* cursor = strchr(record.format, '%'); cursor != nullptr; cursor = strchr(cursor, '%')) {
+        auto conversion = parseConversion(cursor);
+        cursor += conversion.length;
+
+        if (conversion.hasWidthArgument && !packValue(record, va_arg(args, int))) {
+            return false;
+        }
+        int precision = conversion.precision;
+        if (conversion.hasPrecisionArgument) {
+            precision = va_arg(args, int);
+            if (!packValue(record, precision)) {
+                return false;
+            }
+        }
+
+        bool packed;
+        switch (conversion.type) {
+            using enum ArgumentType;
+            case None:
+                packed = true;
+                break;
+            case Int:
+                packed = packValue(record, va_arg(args, int));
+                break;
+            case Long:
+                packed = packValue(record, va_arg(args, long));
+                break;
+            case LongLong:
+                packed = packValue(record, va_arg(args, long long));
+                break;
+            case IntMax:
+                packed = packValue(record, va_arg(args, intmax_t));
+                break;
+            case Size:
+                packed = packValue(record, va_arg(args, size_t));
+                break;
+            case Double:
+                packed = packValue(record, va_arg(args, double));
+                break;
+            case LongDouble:
+                packed = packValue(record, va_arg(args, long double));
+                break;
+            case Pointer:
+                packed = packValue(record, va_arg(args, void*));
+                break;
+            case String: {
+                const char* value = va_arg(args, const char*);
+                if (value == nullptr) {
+                    value = "(null)";
+                }
+                // With a precision, the string doesn't have to be terminated (e.g. a string_view)
+                size_t length = (precision >= 0) ? strnlen(value, precision) : strlen(value);
+                packed = (record.argumentsSize + length + 1 <= sizeof(LogRecord::arguments));
+                if (packed) {
+                    memcpy(record.arguments + record.argumentsSize, value, length);
+                    record.arguments[record.argumentsSize + length] = '\0';
+                    record.argumentsSize += length + 1;
+                }
+                break;
+            }
+            default:
+                packed = false;
+                break;
+        }
+
+        if (!packed) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename T>
+static T unpackValue(const LogRecord& record, size_t& offset) {
+    T value;
+    memcpy(&value, record.arguments + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+template<typename T>
+static int formatValue(char* output, size_t size, const char* specification, const Conversion& conversion, int width, int precision, T value) {
+    if (conversion.hasWidthArgument && conversion.hasPrecisionArgument) {
+        return snprintf(output, size, specification, width, precision, value);
+    } else if (conversion.hasWidthArgument) {
+        return snprintf(output, size, specification, width, value);
+    } else if (conversion.hasPrecisionArgument) {
+        return snprintf(output, size, specification, precision, value);
+    } else {
+        return snprintf(output, size, specification, value);
+    }
+}
+
+/** Format a record that was packed by packArguments() */
+static void formatRecord(const LogRecord& record, char* output, size_t size) {
+    size_t length = 0;
+    size_t offset = 0;
+    const char* cursor = record.format;
+    while (*cursor != '\0' && length < size - 1) {
+        const char* percent = strchr(cursor, '%');
+        size_t literal_length = (percent != nullptr) ? (percent - cursor) : strlen(cursor);
+        size_t copy_length = std::min(literal_length, size - 1 - length);
+        memcpy(output + length, cursor, copy_length);
+        length += copy_length;
+        if (percent == nullptr) {
+            break;
+        }
+
+        auto conversion = parseConversion(percent);
+        cursor = percent + conversion.length;
+
+        char specification[32];
+        if (conversion.length >= sizeof(specification)) {
+            break;
+        }
+        memcpy(specification, percent, conversion.length);
+        specification[conversion.length] = '\0';
+
+        int width = conversion.hasWidthArgument ? unpackValue<int>(record, offset) : 0;
+        int precision = conversion.hasPrecisionArgument ? unpackValue<int>(record, offset) : 0;
+
+        int result;
+        char* remaining_output = output + length;
+        size_t remaining_size = size - length;
+        switch (conversion.type) {
+            using enum ArgumentType;
+            case None:
+                result = snprintf(remaining_output, remaining_size, "%s", specification + 1);
+                break;
+            case Int:
+                result = formatValue(remaining_output, remaining_size, specification, conversion, width, precision, unpackValue<int>(record, offset));
+                break;
+            case Long:
+                result = formatValue(remaining_output, remaining_size, specification, conversion, width, precision, unpackValue<long>(record, offset));
+                break;
+            case LongLong:
+                result = formatValue(remaining_output, remaining_size, specification, conversion, width, precision, unpackValue<long long>(record, offset));
+                break;
+            case IntMax:
+                result = formatValue(remaining_output, remaining_size, specification, conversion, width, precision, unpackValue<intmax_t>(record, offset));
+                break;
+            case Size:
+                result = formatValue(remaining_output, remaining_size, specification, conversion, width, precision, unpackValue<size_t>(record, offset));
+                break;
+            case Double:
+                result = formatValue(remaining_output, remaining_size, specification, conversion, width, precision, unpackValue<double>(record, offset));
+                break;
+            case LongDouble:
+                result = formatValue(remaining_output, remaining_size, specification, conversion, width, precision, unpackValue<long double>(record, offset));
+                break;
+            case Pointer:
+                result = formatValue(remaining_output, remaining_size, specification, conversion, width, precision, unpackValue<void*>(record, offset));
+                break;
+            case String: {
+                auto* value = reinterpret_cast<const char*>(record.arguments + offset);
+                offset += strlen(value) + 1;
+                result = formatValue(remaining_output, remaining_size, specification, conversion, width, precision, value);
+                break;
+            }
+            default:
+                result = 0;
+                break;
+        }
+
+        if (result > 0) {
+            length = std::min(length + result, size - 1);
+        }
+    }
+    output[length] = '\0';
+}
+
+// endregion
+
+// region State
+
+struct LogTagLevel {
+    char tag[32];
+    std::atomic<LogLevel> level;
+};
+
+/** Tags are only added, so the levels can be read without a lock */
+constexpr size_t LOG_MAX_TAG_LEVELS = 16;
+static LogTagLevel tagLevels[LOG_MAX_TAG_LEVELS];
+static std::atomic<size_t> tagLevelCount = 0;
+static std::atomic_flag tagLevelsLock = ATOMIC_FLAG_INIT;
+static std::atomic<LogLevel> defaultLevel = LOG_DEFAULT_LEVEL;
+
+static MpscQueue<LogRecord>* logBuffers[LOG_BUFFER_COUNT] = {};
+static std::atomic<bool> isDeferring = false;
+static std::atomic<bool> isDraining = false;
+static Thread* logThread = nullptr;
+static std::atomic<bool> isLogThreadInterrupted = false;
+
+static std::atomic<uint32_t> deferredCount = 0;
+static std::atomic<uint32_t> immediateCount = 0;
+static std::atomic<uint32_t> droppedCount = 0;
+static std::atomic<uint32_t> filteredCount = 0;
+
+static bool isEnabled(LogLevel level, const char* tag) {
+    auto limit = defaultLevel.load(std::memory_order_relaxed);
+    auto count = tagLevelCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(tagLevels[i].tag, tag) == 0) {
+            limit = tagLevels[i].level.load(std::memory_order_relaxed);
+            break;
+        }
+    }
+    return level <= limit;
+}
+
+void setLogLevel(const char* tag, LogLevel level) {
+    onLogLevelChanged(tag, level);
+
+    if (tag == nullptr) {
+        defaultLevel = level;
+        return;
+    }
+
+    while (tagLevelsLock.test_and_set(std::memory_order_acquire)) {}
+
+    auto count = tagLevelCount.load(std::memory_order_relaxed);
+    bool found = false;
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(tagLevels[i].tag, tag) == 0) {
+            tagLevels[i].level = level;
+            found = true;
+            break;
+        }
+    }
+
+    if (!found && count < LOG_MAX_TAG_LEVELS && strlen(tag) < sizeof(LogTagLevel::tag)) {
+        strcpy(tagLevels[count].tag, tag);
+        tagLevels[count].level = level;
+        tagLevelCount.store(count + 1, std::memory_order_release);
+        found = true;
+    }
+
+    tagLevelsLock.clear(std::memory_order_release);
+
+    if (!found) {
+        TT_LOG_W("Log", "Can't set level for %s: too many tags or tag too long", tag);
+    }
+}
+
+LogLevel getLogLevel(const char* tag) {
+    if (tag != nullptr) {
+        auto count = tagLevelCount.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++) {
+            if (strcmp(tagLevels[i].tag, tag) == 0) {
+                return tagLevels[i].level;
+            }
+        }
+    }
+    return defaultLevel;
+}
+
+LogStatistics getLogStatistics() {
+    uint32_t high_water_mark = 0;
+    for (auto* buffer : logBuffers) {
+        if (buffer != nullptr) {
+            high_water_mark = std::max<uint32_t>(high_water_mark, buffer->getHighWaterMark());
+        }
+    }
+
+    return {
+        .deferred = deferredCount,
+        .immediate = immediateCount,
+        .dropped = droppedCount,
+        .filtered = filteredCount,
+        .highWaterMark = high_water_mark
+    };
+}
+
+// endregion
+
+// region Writing
+
+static void writeFormattedMessage(LogLevel level, uint32_t timestamp, const char* tag, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    writeLogMessage(level, timestamp, tag, format, args);
+    va_end(args);
+}
+
+static void writeRecord(const LogRecord& record) {
+    char line[LOG_LINE_SIZE];
+    formatRecord(record, line, sizeof(line));
+    writeFormattedMessage(record.level, record.timestamp, record.tag, "%s", line);
+}
+
+/** Write the waiting records in the order they were logged in. Must only be called by 1 task at a time. */
+static bool drainLogBuffers() {
+    bool has_written = false;
+    LogRecord record;
+    while (true) {
+        // Find the oldest record of all buffers
+        MpscQueue<LogRecord>* oldest_buffer = nullptr;
+        uint32_t oldest_timestamp = 0;
+        for (auto* buffer : logBuffers) {
+            const auto* head = buffer->peek();
+            if (head != nullptr && (oldest_buffer == nullptr || (int32_t)(head->timestamp - oldest_timestamp) < 0)) {
+                oldest_buffer = buffer;
+                oldest_timestamp = head->timestamp;
+            }
+        }
+
+        if (oldest_buffer == nullptr || !oldest_buffer->pop(record)) {
+            return has_written;
+        }
+
+        writeRecord(record);
+        has_written = true;
+    }
+}
+
+static int32_t logThreadMain() {
+    uint32_t reported_dropped_count = 0;
+    while (!isLogThreadInterrupted) {
+        isDraining = true;
+        bool has_written = drainLogBuffers();
+        isDraining = false;
+
+        uint32_t dropped_count = droppedCount;
+        if (dropped_count != reported_dropped_count) {
+            writeFormattedMessage(LogLevel::Warning, getLogTimestamp(), "Log", "%lu messages were dropped", (unsigned long)(dropped_count - reported_dropped_count));
+            reported_dropped_count = dropped_count;
+        }
+
+        if (!has_written) {
+            kernel::delayMillis(10);
+        }
+    }
+    return 0;
+}
+
+void startLogThread() {
+    if (logThread != nullptr) {
+        return;
+    }
+
+    for (auto& buffer : logBuffers) {
+        if (buffer == nullptr) {
+            buffer = new MpscQueue<LogRecord>(LOG_BUFFER_CAPACITY);
+        }
+    }
+
+    isLogThreadInterrupted = false;
+    logThread = new Thread("log", 3072, logThreadMain);
+    logThread->setPriority(Thread::Priority::Lower);
+    logThread->start();
+    isDeferring = true;
+}
+
+void stopLogThread() {
+    if (logThread == nullptr) {
+        return;
+    }
+
+    isDeferring = false;
+    isLogThreadInterrupted = true;
+    logThread->join();
+    delete logThread;
+    logThread = nullptr;
+
+    // This task is now the only consumer
+    drainLogBuffers();
+}
+
+void flushLog() {
+    if (logThread == nullptr) {
+        return;
+    }
+
+    for (int attempt = 0; attempt < 1000; attempt++) {
+        bool is_empty = true;
+        for (auto* buffer : logBuffers) {
+            is_empty = is_empty && buffer->isEmpty();
+        }
+        if (is_empty && !isDraining) {
+            return;
+        }
+        kernel::delayMillis(1);
+    }
+}
+
+void log(LogLevel level, const char* tag, const char* format, ...) {
+    if (!isEnabled(level, tag)) {
+        filteredCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto timestamp = getLogTimestamp();
+    va_list args;
+    va_start(args, format);
+
+    bool is_deferred = false;
+    if (level != LogLevel::Error && isDeferring.load(std::memory_order_acquire)) {
+        LogRecord record;
+        record.timestamp = timestamp;
+        record.level = level;
+        record.argumentsSize = 0;
+        record.tag = tag;
+        record.format = format;
+
+        va_list pack_args;
+        va_copy(pack_args, args);
+        // Messages with arguments that don't fit (e.g. long strings) are written right away, so they are never truncated
+        is_deferred = packArguments(record, pack_args);
+        va_end(pack_args);
+
+        if (is_deferred) {
+            if (logBuffers[getLogBufferIndex()]->push(std::move(record))) {
+                deferredCount.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (!is_deferred) {
+        immediateCount.fetch_add(1, std::memory_order_relaxed);
+        writeLogMessage(level, timestamp, tag, format, args);
+    }
+
+    va_end(args);
+}
+
+// endregion
+
+}
@@ -0,0 +1,62 @@
+#ifdef ESP_PLATFORM
+
+#include "Tactility/Log.h"
+
+#include <cstdarg>
+
+namespace tt {
+
+static esp_log_level_t toEspLogLevel(LogLevel level) {
+    using enum LogLevel;
+    switch (level) {
+        case Error:
+            return ESP_LOG_ERROR;
+        case Warning:
+            return ESP_LOG_WARN;
+        case Info:
+            return ESP_LOG_INFO;
+        case Debug:
+            return ESP_LOG_DEBUG;
+        case Verbose:
+        default:
+            return ESP_LOG_VERBOSE;
+    }
+}
+
+static const char* toPrefix(LogLevel level) {
+    using enum LogLevel;
+    switch (level) {
+        case Error:
+            return LOG_COLOR_E "E";
+        case Warning:
+            return LOG_COLOR_W "W";
+        case Info:
+            return LOG_COLOR_I "I";
+        case Debug:
+            return LOG_COLOR_D "D";
+        case Verbose:
+        default:
+            return LOG_COLOR_V "V";
+    }
+}
+
+uint32_t getLogTimestamp() {
+    return esp_log_timestamp();
+}
+
+void writeLogMessage(LogLevel level, uint32_t timestamp, const char* tag, const char* format, va_list args) {
+    // Same layout as ESP_LOGx
+    auto esp_level = toEspLogLevel(level);
+    esp_log_write(esp_level, tag, "%s (%lu) %s: ", toPrefix(level), timestamp, tag);
+    esp_log_writev(esp_level, tag, format, args);
+    esp_log_write(esp_level, tag, LOG_RESET_COLOR "\n");
+}
+
+void onLogLevelChanged(const char* tag, LogLevel level) {
+    // esp_log_write() filters too
+    esp_log_level_set((tag != nullptr) ? tag : "*", toEspLogLevel(level));
+}
+
+} // namespace tt
+
+#endif
@@ -2,9 +2,11 @@
 
 #include "Tactility/Log.h"
 
+#include "Tactility/CoreDefines.h"
+
+#include <cstdarg>
 #include <cstdint>
-#include <iomanip>
-#include <sstream>
+#include <cstdio>
 #include <sys/time.h>
 
 namespace tt {
@@ -27,6 +29,12 @@ static char toPrefix(LogLevel level) {
     }
 }
 
+static uint64_t getTimeMillis() {
+    struct timeval time {};
+    gettimeofday(&time, nullptr);
+    return ((uint64_t)time.tv_sec * 1000U) + (time.tv_usec / 1000U);
+}
+
 static const char* toTagColour(LogLevel level) {
     using enum LogLevel;
     switch (level) {
@@ -60,27 +68,23 @@ static const char* toMessageColour(LogLevel level) {
             return "";
     }
 }
-static uint64_t getLogTimestamp() {
-    static uint64_t base = 0U;
-    struct timeval time {};
-    gettimeofday(&time, nullptr);
-    uint64_t now = ((uint64_t)time.tv_sec * 1000U) + (time.tv_usec / 1000U);
-    if (base == 0U) {
-        base = now;
-    }
-    return now - base;
-}
 
-void log(LogLevel level, const char* tag, const char* format, ...) {
-    std::stringstream buffer;
-    buffer << getLogTimestamp() << " [" << toTagColour(level) << toPrefix(level) << "\033[0m" << "] [" << tag << "] " << toMessageColour(level) << format  << "\033[0m\n";
+uint32_t getLogTimestamp() {
+    static const uint64_t base = getTimeMillis();
+    return getTimeMillis() - base;
+}
 
-    va_list args;
-    va_start(args, format);
-    vprintf(buffer.str().c_str(), args);
-    va_end(args);
+void writeLogMessage(LogLevel level, uint32_t timestamp, const char* tag, const char* format, va_list args) {
+    // Keep the parts of a message together when multiple tasks log at the same time
+    flockfile(stdout);
+    printf("%lu [%s%c\033[0m] [%s] %s", (unsigned long)timestamp, toTagColour(level), toPrefix(level), tag, toMessageColour(level));
+    vprintf(format, args);
+    printf("\033[0m\n");
+    funlockfile(stdout);
 }
 
+void onLogLevelChanged(TT_UNUSED const char* tag, TT_UNUSED LogLevel level) {}
+
 } // namespace tt
 
-#endif
\ No newline at end of file
+#endif
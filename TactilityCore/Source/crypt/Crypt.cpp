@@ -1,9 +1,12 @@
 #include "Tactility/crypt/Crypt.h"
+#include "Tactility/crypt/Session.h"
 
 #include "Tactility/Check.h"
 #include "Tactility/Log.h"
+#include "Tactility/Mutex.h"
 
 #include <mbedtls/aes.h>
+#include <mbedtls/platform_util.h>
 #include <cstring>
 #include <cstdint>
 
@@ -107,7 +110,7 @@ static void xorKey(const uint8_t* inLeft, const uint8_t* inRight, uint8_t* out,
  * Combines a stored key and a hardware key into a single reliable key value.
  * @param[out] key the key output
  */
-static void getKey(uint8_t key[32]) {
+static void deriveKey(uint8_t key[32]) {
 #if !defined(CONFIG_SECURE_BOOT) || !defined(CONFIG_SECURE_FLASH_ENC_ENABLED)
     TT_LOG_W(TAG, "Using tt_secure_* code with secure boot and/or flash encryption disabled.");
     TT_LOG_W(TAG, "An attacker with physical access to your ESP32 can decrypt your secure data.");
@@ -126,6 +129,24 @@ static void getKey(uint8_t key[32]) {
 #endif
 }
 
+static Mutex keyMutex;
+static bool keyDerived = false;
+static uint8_t cachedKey[32];
+
+/**
+ * Get the device key. It is derived once, because that requires reading the MAC and NVS.
+ * @param[out] key the key output
+ */
+static void getKey(uint8_t key[32]) {
+    auto lock = keyMutex.asScopedLock();
+    lock.lock();
+    if (!keyDerived) {
+        deriveKey(cachedKey);
+        keyDerived = true;
+    }
+    memcpy(key, cachedKey, 32);
+}
+
 void getIv(const void* data, size_t dataLength, uint8_t iv[16]) {
     memset(iv, 0, 16);
     auto* data_bytes = (uint8_t*)data;
@@ -135,54 +156,95 @@ void getIv(const void* data, size_t dataLength, uint8_t iv[16]) {
     }
 }
 
-static int aes256CryptCbc(
-    const uint8_t key[32],
-    int mode,
-    size_t length,
-    unsigned char iv[16],
-    const unsigned char* input,
-    unsigned char* output
-) {
-    tt_check(key && iv && input && output);
+// region Session
 
-    if ((length % 16) || (length == 0)) {
-        return -1; // TODO: Proper error code from mbed lib?
-    }
+Session::Session() {
+    uint8_t key[32];
+    getKey(key);
+    mbedtls_aes_init(&encryptContext);
+    mbedtls_aes_init(&decryptContext);
+    tt_check(mbedtls_aes_setkey_enc(&encryptContext, key, 256) == 0);
+    tt_check(mbedtls_aes_setkey_dec(&decryptContext, key, 256) == 0);
+    mbedtls_platform_zeroize(key, sizeof(key));
+}
 
-    mbedtls_aes_context master;
-    mbedtls_aes_init(&master);
-    if (mode == MBEDTLS_AES_ENCRYPT) {
-        mbedtls_aes_setkey_enc(&master, key, 256);
-    } else {
-        mbedtls_aes_setkey_dec(&master, key, 256);
-    }
-    int result = mbedtls_aes_crypt_cbc(&master, mode, length, iv, input, output);
-    mbedtls_aes_free(&master);
-    return result;
+Session::Session(const uint8_t key[32]) {
+    mbedtls_aes_init(&encryptContext);
+    mbedtls_aes_init(&decryptContext);
+    tt_check(mbedtls_aes_setkey_enc(&encryptContext, key, 256) == 0);
+    tt_check(mbedtls_aes_setkey_dec(&decryptContext, key, 256) == 0);
 }
 
-int encrypt(const uint8_t iv[16], const uint8_t* inData, uint8_t* outData, size_t dataLength) {
-    tt_check(dataLength % 16 == 0, "Length is not a multiple of 16 bytes (for AES 256");
-    uint8_t key[32];
-    getKey(key);
+Session::~Session() {
+    // Also clears the key schedules
+    mbedtls_aes_free(&encryptContext);
+    mbedtls_aes_free(&decryptContext);
+}
 
-    // TODO: Is this still needed after switching to regular AES functions?
+int Session::encryptCbc(const uint8_t iv[16], const uint8_t* inData, uint8_t* outData, size_t dataLength) {
+    tt_check(inData && outData);
+    if ((dataLength % 16) || (dataLength == 0)) {
+        return MBEDTLS_ERR_AES_INVALID_INPUT_LENGTH;
+    }
+
+    // mbedtls updates the IV
     uint8_t iv_copy[16];
     memcpy(iv_copy, iv, sizeof(iv_copy));
-
-    return aes256CryptCbc(key, MBEDTLS_AES_ENCRYPT, dataLength, iv_copy, inData, outData);
+    return mbedtls_aes_crypt_cbc(&encryptContext, MBEDTLS_AES_ENCRYPT, dataLength, iv_copy, inData, outData);
 }
 
-int decrypt(const uint8_t iv[16], const uint8_t* inData, uint8_t* outData, size_t dataLength) {
-    tt_check(dataLength % 16 == 0, "Length is not a multiple of 16 bytes (for AES 256");
-    uint8_t key[32];
-    getKey(key);
+int Session::decryptCbc(const uint8_t iv[16], const uint8_t* inData, uint8_t* outData, size_t dataLength) {
+    tt_check(inData && outData);
+    if ((dataLength % 16) || (dataLength == 0)) {
+        return MBEDTLS_ERR_AES_INVALID_INPUT_LENGTH;
+    }
 
-    // TODO: Is this still needed after switching to regular AES functions?
+    // mbedtls updates the IV
     uint8_t iv_copy[16];
     memcpy(iv_copy, iv, sizeof(iv_copy));
+    return mbedtls_aes_crypt_cbc(&decryptContext, MBEDTLS_AES_DECRYPT, dataLength, iv_copy, inData, outData);
+}
 
-    return aes256CryptCbc(key, MBEDTLS_AES_DECRYPT, dataLength, iv_copy, inData, outData);
+CtrStream::CtrStream(Session& session, const uint8_t nonce[16]) : session(session) {
+    memcpy(counter, nonce, sizeof(counter));
+    memset(streamBlock, 0, sizeof(streamBlock));
+}
+
+CtrStream::~CtrStream() {
+    mbedtls_platform_zeroize(streamBlock, sizeof(streamBlock));
+}
+
+int CtrStream::update(const uint8_t* inData, uint8_t* outData, size_t dataLength) {
+    if (dataLength == 0) {
+        return 0;
+    }
+    tt_check(inData && outData);
+    // CTR only uses the encryption key schedule, for both directions
+    return mbedtls_aes_crypt_ctr(&session.encryptContext, dataLength, &streamBlockOffset, counter, streamBlock, inData, outData);
+}
+
+// endregion
+
+/** The session for encrypt() and decrypt() */
+static Session& getSharedSession() {
+    static Session session;
+    return session;
+}
+
+static Mutex sharedSessionMutex;
+
+int encrypt(const uint8_t iv[16], const uint8_t* inData, uint8_t* outData, size_t dataLength) {
+    tt_check(dataLength % 16 == 0, "Length is not a multiple of 16 bytes (for AES 256");
+    auto lock = sharedSessionMutex.asScopedLock();
+    lock.lock();
+    return getSharedSession().encryptCbc(iv, inData, outData, dataLength);
+}
+
+int decrypt(const uint8_t iv[16], const uint8_t* inData, uint8_t* outData, size_t dataLength) {
+    tt_check(dataLength % 16 == 0, "Length is not a multiple of 16 bytes (for AES 256");
+    auto lock = sharedSessionMutex.asScopedLock();
+    lock.lock();
+    return getSharedSession().decryptCbc(iv, inData, outData, dataLength);
 }
 
 } // namespace
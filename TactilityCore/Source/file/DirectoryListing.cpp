@@ -0,0 +1,90 @@
+#include "Tactility/file/DirectoryListing.h"
+#include "Tactility/file/File.h"
+
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+
+namespace tt::file {
+
+constexpr auto* TAG = "DirectoryListing";
+
+std::unique_ptr<DirectoryListing> DirectoryListing::read(const std::string& path, const PageFunction& onPage, size_t pageSize) {
+    auto lock = getLock(path)->asScopedLock();
+    lock.lock();
+
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        TT_LOG_E(TAG, "Failed to open dir %s", path.c_str());
+        return nullptr;
+    }
+
+    auto listing = std::make_unique<DirectoryListing>(path);
+    bool cancelled = false;
+    size_t page_remaining = pageSize;
+    dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        listing->add(entry->d_name, entry->d_type);
+
+        if (--page_remaining == 0) {
+            page_remaining = pageSize;
+            lock.unlock();
+            cancelled = (onPage != nullptr) && !onPage(listing->getCount());
+            lock.lock();
+            if (cancelled) {
+                break;
+            }
+        }
+    }
+
+    closedir(dir);
+
+    if (cancelled) {
+        TT_LOG_I(TAG, "Cancelled reading %s", path.c_str());
+        return nullptr;
+    }
+
+    listing->sort();
+    listing->shrinkToFit();
+    return listing;
+}
+
+void DirectoryListing::add(const char* name, uint8_t type) {
+    auto length = strlen(name);
+    entries.push_back({
+        .nameOffset = static_cast<uint32_t>(names.size()),
+        .nameLength = static_cast<uint16_t>(length),
+        .type = type
+    });
+    names.append(name, length + 1);
+}
+
+bool DirectoryListing::isDirectory(size_t index) const {
+    auto type = entries[index].type;
+    return type == TT_DT_DIR || type == TT_DT_CHR;
+}
+
+void DirectoryListing::sort() {
+    std::ranges::sort(entries, [this](const Entry& left, const Entry& right) {
+        bool left_is_dir = left.type == TT_DT_DIR || left.type == TT_DT_CHR;
+        bool right_is_dir = right.type == TT_DT_DIR || right.type == TT_DT_CHR;
+        if (left_is_dir == right_is_dir) {
+            return strcmp(names.data() + left.nameOffset, names.data() + right.nameOffset) < 0;
+        } else {
+            return left_is_dir > right_is_dir;
+        }
+    });
+}
+
+void DirectoryListing::shrinkToFit() {
+    entries.shrink_to_fit();
+    names.shrink_to_fit();
+}
+
+}
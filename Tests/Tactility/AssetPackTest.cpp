@@ -0,0 +1,178 @@
+#include "doctest.h"
+
+#include <Tactility/file/AssetPack.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace tt;
+
+static constexpr auto* PACK_PATH = "/tmp/asset_pack_test.pack";
+
+static uint32_t getNameHash(const std::string& name) {
+    uint32_t hash = 0x811C9DC5U;
+    for (auto character : name) {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= 0x01000193U;
+    }
+    return hash;
+}
+
+/** Creates asset packs in the same layout as Buildscripts/asset-pack.py */
+class AssetPackBuilder {
+
+    struct Image {
+        std::string name;
+        uint16_t width;
+        uint16_t height;
+        uint8_t colorFormat;
+        uint32_t color;
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<Image> images;
+
+    static void append16(std::vector<uint8_t>& output, uint16_t value) {
+        output.push_back(value & 0xFF);
+        output.push_back(value >> 8);
+    }
+
+    static void append32(std::vector<uint8_t>& output, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            output.push_back((value >> (i * 8)) & 0xFF);
+        }
+    }
+
+public:
+
+    AssetPackBuilder& addA8(const std::string& name, uint16_t width, uint16_t height, uint32_t color) {
+        std::vector<uint8_t> data(width * height);
+        for (size_t i = 0; i < data.size(); i++) {
+            data[i] = static_cast<uint8_t>(i);
+        }
+        images.push_back({ name, width, height, 0x0E, color, data });
+        return *this;
+    }
+
+    AssetPackBuilder& addArgb8888(const std::string& name, uint16_t width, uint16_t height) {
+        images.push_back({ name, width, height, 0x10, 0, std::vector<uint8_t>(width * height * 4, 0xAB) });
+        return *this;
+    }
+
+    std::vector<uint8_t> build(uint16_t version = file::AssetPack::version) {
+        auto sorted = images;
+        std::ranges::sort(sorted, [](const auto& left, const auto& right) {
+            return std::make_pair(getNameHash(left.name), left.name) < std::make_pair(getNameHash(right.name), right.name);
+        });
+
+        std::vector<uint8_t> names;
+        std::vector<uint32_t> name_offsets;
+        for (const auto& image : sorted) {
+            name_offsets.push_back(names.size());
+            names.insert(names.end(), image.name.begin(), image.name.end());
+            names.push_back('\0');
+        }
+
+        uint32_t names_offset = 16 + sorted.size() * 28;
+        uint32_t data_offset = (names_offset + names.size() + 3) & ~3U;
+
+        std::vector<uint8_t> output = { 'T', 'T', 'A', 'P' };
+        append16(output, version);
+        append16(output, sorted.size());
+        append32(output, names_offset);
+        append32(output, names.size());
+
+        std::vector<uint8_t> data;
+        for (size_t i = 0; i < sorted.size(); i++) {
+            const auto& image = sorted[i];
+            append32(output, getNameHash(image.name));
+            append32(output, name_offsets[i]);
+            append16(output, image.width);
+            append16(output, image.height);
+            append16(output, (image.colorFormat == 0x0E) ? image.width : image.width * 4);
+            output.push_back(image.colorFormat);
+            output.push_back(0);
+            append32(output, image.color);
+            append32(output, data_offset + data.size());
+            append32(output, image.data.size());
+            data.insert(data.end(), image.data.begin(), image.data.end());
+            data.resize((data.size() + 3) & ~3U, 0);
+        }
+
+        output.insert(output.end(), names.begin(), names.end());
+        output.resize(data_offset, 0);
+        output.insert(output.end(), data.begin(), data.end());
+        return output;
+    }
+};
+
+static void writePack(const std::vector<uint8_t>& data) {
+    auto* file = fopen(PACK_PATH, "wb");
+    REQUIRE_NE(file, nullptr);
+    fwrite(data.data(), 1, data.size(), file);
+    fclose(file);
+}
+
+TEST_CASE("AssetPack loads images by name") {
+    writePack(AssetPackBuilder()
+        .addA8("service/Statusbar/assets/power_0.png", 16, 16, 0xFFFFFF)
+        .addArgb8888("spinner.png", 3, 2)
+        .addA8("service/Statusbar/assets/power_10.png", 15, 3, 0x123456)
+        .build()
+    );
+
+    auto pack = file::AssetPack::open(PACK_PATH);
+    REQUIRE_NE(pack, nullptr);
+    CHECK_EQ(pack->getImageCount(), 3);
+    CHECK_EQ(pack->contains("spinner.png"), true);
+    CHECK_EQ(pack->contains("missing.png"), false);
+    CHECK_EQ(pack->contains("service/Statusbar/assets/power_1.png"), false);
+
+    file::AssetPack::Image image;
+    REQUIRE_EQ(pack->load("service/Statusbar/assets/power_10.png", image), true);
+    CHECK_EQ(image.width, 15);
+    CHECK_EQ(image.height, 3);
+    CHECK_EQ(image.stride, 15);
+    CHECK_EQ(image.colorFormat, file::AssetPack::ColorFormat::A8);
+    CHECK_EQ(image.color, 0x123456);
+    REQUIRE_EQ(image.dataSize, 45);
+    CHECK_EQ(image.data[0], 0);
+    CHECK_EQ(image.data[44], 44);
+
+    REQUIRE_EQ(pack->load("spinner.png", image), true);
+    CHECK_EQ(image.colorFormat, file::AssetPack::ColorFormat::Argb8888);
+    CHECK_EQ(image.stride, 12);
+    REQUIRE_EQ(image.dataSize, 24);
+    CHECK_EQ(image.data[23], 0xAB);
+
+    CHECK_EQ(pack->load("missing.png", image), false);
+
+    remove(PACK_PATH);
+}
+
+TEST_CASE("AssetPack rejects invalid packs") {
+    CHECK_EQ(file::AssetPack::open("/tmp/asset_pack_test_missing.pack"), nullptr);
+
+    auto data = AssetPackBuilder().addArgb8888("image.png", 4, 4).build();
+
+    auto wrong_version = AssetPackBuilder().addArgb8888("image.png", 4, 4).build(file::AssetPack::version + 1);
+    writePack(wrong_version);
+    CHECK_EQ(file::AssetPack::open(PACK_PATH), nullptr);
+
+    auto wrong_magic = data;
+    wrong_magic[0] = 'X';
+    writePack(wrong_magic);
+    CHECK_EQ(file::AssetPack::open(PACK_PATH), nullptr);
+
+    auto truncated = data;
+    truncated.resize(truncated.size() - 1);
+    writePack(truncated);
+    CHECK_EQ(file::AssetPack::open(PACK_PATH), nullptr);
+
+    writePack(data);
+    CHECK_NE(file::AssetPack::open(PACK_PATH), nullptr);
+
+    remove(PACK_PATH);
+}
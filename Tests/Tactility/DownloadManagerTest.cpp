@@ -0,0 +1,309 @@
+#include "doctest.h"
+
+#include <Tactility/file/File.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/network/DownloadManager.h>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace tt;
+using namespace tt::network::http;
+
+static constexpr auto* DOWNLOAD_PATH = "/tmp/download_manager_test.bin";
+
+/** A local HTTP server that serves a single file, with support for Range requests */
+class TestServer {
+
+    int listenFd = -1;
+    uint16_t port = 0;
+    std::thread thread;
+    std::atomic<bool> stopping = false;
+
+    static bool sendAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            auto result = send(fd, data, size, MSG_NOSIGNAL);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            } else if (result <= 0) {
+                return false;
+            }
+            data += result;
+            size -= result;
+        }
+        return true;
+    }
+
+    void handle(int fd) {
+        std::string request;
+        char buffer[512];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            auto result = recv(fd, buffer, sizeof(buffer), 0);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            } else if (result <= 0) {
+                return;
+            }
+            request.append(buffer, result);
+        }
+
+        auto request_index = requestCount++;
+        auto path_end = request.find(' ', 4);
+        auto path = request.substr(4, path_end - 4);
+        if (path != "/file.bin") {
+            std::string response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+            sendAll(fd, response.data(), response.size());
+            return;
+        }
+
+        size_t start = 0;
+        auto range_index = request.find("Range: bytes=");
+        if (range_index != std::string::npos && acceptRanges) {
+            start = std::stoul(request.substr(range_index + 13));
+            rangeStarts.push_back(start);
+        }
+
+        std::string headers;
+        if (start > content.size()) {
+            headers = "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Length: 0\r\n\r\n";
+            sendAll(fd, headers.data(), headers.size());
+            return;
+        } else if (start > 0) {
+            headers = std::format(
+                "HTTP/1.1 206 Partial Content\r\nContent-Length: {}\r\nContent-Range: bytes {}-{}/{}\r\n\r\n",
+                content.size() - start, start, content.size() - 1, content.size()
+            );
+        } else {
+            headers = std::format("HTTP/1.1 200 OK\r\nContent-Length: {}\r\n\r\n", content.size());
+        }
+
+        if (!sendAll(fd, headers.data(), headers.size())) {
+            return;
+        }
+
+        auto end = content.size();
+        if (request_index == 0 && dropFirstResponseAfter > 0) {
+            // Simulate a connection that breaks during the transfer
+            end = std::min(end, start + dropFirstResponseAfter);
+        }
+        sendAll(fd, content.data() + start, end - start);
+    }
+
+    void serve() {
+        while (!stopping) {
+            auto fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                continue;
+            }
+            handle(fd);
+            shutdown(fd, SHUT_RDWR);
+            close(fd);
+        }
+    }
+
+public:
+
+    std::string content;
+    bool acceptRanges = true;
+    size_t dropFirstResponseAfter = 0;
+    std::atomic<int> requestCount = 0;
+    std::vector<size_t> rangeStarts;
+
+    explicit TestServer(size_t contentSize) {
+        content.resize(contentSize);
+        for (size_t i = 0; i < contentSize; i++) {
+            content[i] = static_cast<char>((i * 7) ^ (i >> 8));
+        }
+
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        socklen_t address_length = sizeof(address);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &address_length);
+        port = ntohs(address.sin_port);
+        listen(listenFd, 4);
+    }
+
+    ~TestServer() {
+        stopping = true;
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    void start() {
+        thread = std::thread([this] { serve(); });
+    }
+
+    std::string getUrl(const std::string& path = "/file.bin") const {
+        return std::format("http://127.0.0.1:{}{}", port, path);
+    }
+};
+
+struct DownloadResult {
+    std::atomic<bool> finished = false;
+    std::atomic<bool> success = false;
+    std::string error;
+    std::vector<DownloadProgress> progress;
+};
+
+static void download(DownloadManager& manager, const std::string& url, bool resume, DownloadResult& result) {
+    manager.enqueue({
+        .url = url,
+        .certFilePath = "",
+        .filePath = DOWNLOAD_PATH,
+        .resume = resume,
+        .onProgress = [&result](const DownloadProgress& progress) {
+            result.progress.push_back(progress);
+        },
+        .onSuccess = [&result] {
+            result.success = true;
+            result.finished = true;
+        },
+        .onError = [&result](const char* errorMessage) {
+            result.error = errorMessage;
+            result.finished = true;
+        }
+    });
+
+    for (int i = 0; i < 500 && !result.finished; i++) {
+        kernel::delayMillis(10);
+    }
+    REQUIRE_EQ(result.finished.load(), true);
+}
+
+static std::string readDownload() {
+    auto* file = fopen(DOWNLOAD_PATH, "rb");
+    if (file == nullptr) {
+        return {};
+    }
+    std::string data;
+    char buffer[1024];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.append(buffer, length);
+    }
+    fclose(file);
+    return data;
+}
+
+static void removeDownload() {
+    remove(DOWNLOAD_PATH);
+    remove(std::format("{}.part", DOWNLOAD_PATH).c_str());
+}
+
+TEST_CASE("DownloadManager downloads a file in blocks and reports progress") {
+    removeDownload();
+    TestServer server(100000);
+    server.start();
+    DownloadManager manager(4096);
+
+    DownloadResult result;
+    download(manager, server.getUrl(), false, result);
+    CHECK_EQ(result.success.load(), true);
+    CHECK_EQ(readDownload(), server.content);
+    CHECK_EQ(file::isFile(std::format("{}.part", DOWNLOAD_PATH)), false);
+
+    // One report per block, and one for the last partial block
+    CHECK_EQ(result.progress.size(), (100000 / 4096) + 1);
+    CHECK_EQ(result.progress.back().bytesReceived, 100000);
+    CHECK_EQ(result.progress.back().totalBytes, 100000);
+    CHECK_EQ(manager.getStatistics().completedCount, 1);
+    CHECK_EQ(manager.getStatistics().bytesReceived, 100000);
+
+    removeDownload();
+}
+
+TEST_CASE("DownloadManager continues with a range request when the connection breaks") {
+    removeDownload();
+    TestServer server(50000);
+    server.dropFirstResponseAfter = 20000;
+    server.start();
+    DownloadManager manager(4096);
+
+    DownloadResult result;
+    download(manager, server.getUrl(), false, result);
+    CHECK_EQ(result.success.load(), true);
+    CHECK_EQ(readDownload(), server.content);
+    CHECK_EQ(server.requestCount.load(), 2);
+    REQUIRE_EQ(server.rangeStarts.size(), 1);
+    CHECK_EQ(server.rangeStarts[0], 20000);
+    CHECK_EQ(manager.getStatistics().resumedCount, 1);
+    CHECK_EQ(manager.getStatistics().bytesReceived, 50000);
+
+    removeDownload();
+}
+
+TEST_CASE("DownloadManager resumes a partial download from an earlier attempt") {
+    removeDownload();
+    TestServer server(30000);
+    server.start();
+
+    auto* part_file = fopen(std::format("{}.part", DOWNLOAD_PATH).c_str(), "wb");
+    REQUIRE_NE(part_file, nullptr);
+    fwrite(server.content.data(), 1, 10000, part_file);
+    fclose(part_file);
+
+    DownloadManager manager(4096);
+    DownloadResult result;
+    download(manager, server.getUrl(), true, result);
+    CHECK_EQ(result.success.load(), true);
+    CHECK_EQ(readDownload(), server.content);
+    REQUIRE_EQ(server.rangeStarts.size(), 1);
+    CHECK_EQ(server.rangeStarts[0], 10000);
+    CHECK_EQ(manager.getStatistics().bytesReceived, 20000);
+
+    removeDownload();
+}
+
+TEST_CASE("DownloadManager starts over when the server doesn't support range requests") {
+    removeDownload();
+    TestServer server(30000);
+    server.acceptRanges = false;
+    server.start();
+
+    auto* part_file = fopen(std::format("{}.part", DOWNLOAD_PATH).c_str(), "wb");
+    REQUIRE_NE(part_file, nullptr);
+    fwrite("garbage", 1, 7, part_file);
+    fclose(part_file);
+
+    DownloadManager manager(4096);
+    DownloadResult result;
+    download(manager, server.getUrl(), true, result);
+    CHECK_EQ(result.success.load(), true);
+    CHECK_EQ(readDownload(), server.content);
+    CHECK_EQ(manager.getStatistics().resumedCount, 0);
+
+    removeDownload();
+}
+
+TEST_CASE("DownloadManager reports server errors without retrying") {
+    removeDownload();
+    TestServer server(1000);
+    server.start();
+    DownloadManager manager(4096);
+
+    DownloadResult result;
+    download(manager, server.getUrl("/missing.bin"), false, result);
+    CHECK_EQ(result.success.load(), false);
+    CHECK_EQ(result.error, "Server response is not OK");
+    CHECK_EQ(server.requestCount.load(), 1);
+    CHECK_EQ(file::isFile(DOWNLOAD_PATH), false);
+    CHECK_EQ(file::isFile(std::format("{}.part", DOWNLOAD_PATH)), false);
+    CHECK_EQ(manager.getStatistics().failedCount, 1);
+}
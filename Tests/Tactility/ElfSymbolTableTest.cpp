@@ -0,0 +1,139 @@
+#include "doctest.h"
+#include <Tactility/app/ElfSymbolTable.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <symbols/names.h>
+
+#include <cstring>
+#include <elf.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace tt;
+
+constexpr const char* firstNames[] = { "malloc", "free" };
+constexpr const char* secondNames[] = { "lv_obj_create" };
+constexpr std::span<const char* const> testTables[] = { firstNames, secondNames };
+
+TEST_CASE("ElfSymbolTable finds symbols of all tables") {
+    constexpr app::ElfSymbolTable<app::getElfSymbolCount(testTables)> table(testTables);
+    static_assert(table.findDuplicate() == nullptr);
+    CHECK_EQ(table.getSize(), 3);
+
+    const auto* malloc_entry = table.find("malloc");
+    REQUIRE_NE(malloc_entry, nullptr);
+    CHECK_EQ(malloc_entry->table, 0);
+    CHECK_EQ(malloc_entry->index, 0);
+
+    const auto* free_entry = table.find("free");
+    REQUIRE_NE(free_entry, nullptr);
+    CHECK_EQ(free_entry->table, 0);
+    CHECK_EQ(free_entry->index, 1);
+
+    const auto* create_entry = table.find("lv_obj_create");
+    REQUIRE_NE(create_entry, nullptr);
+    CHECK_EQ(create_entry->table, 1);
+    CHECK_EQ(create_entry->index, 0);
+
+    CHECK_EQ(table.find("lv_obj"), nullptr);
+    CHECK_EQ(table.find("zzz"), nullptr);
+    CHECK_EQ(table.find(""), nullptr);
+}
+
+TEST_CASE("ElfSymbolTable finds duplicate names at compile time") {
+    static constexpr const char* first[] = { "strcmp" };
+    static constexpr const char* second[] = { "strlen", "strcmp" };
+    static constexpr std::span<const char* const> tables[] = { first, second };
+    constexpr app::ElfSymbolTable<app::getElfSymbolCount(tables)> table(tables);
+
+    constexpr const char* duplicate = table.findDuplicate();
+    CHECK_EQ(std::string(duplicate), "strcmp");
+}
+
+TEST_CASE("ElfSymbolTable contains all exported firmware symbols") {
+    constexpr app::ElfSymbolTable<app::getElfSymbolCount(symbol_name_tables)> table(symbol_name_tables);
+    static_assert(table.findDuplicate() == nullptr);
+
+    for (size_t table_index = 0; table_index < std::size(symbol_name_tables); table_index++) {
+        const auto& names = symbol_name_tables[table_index];
+        for (size_t index = 0; index < names.size(); index++) {
+            const auto* entry = table.find(names[index]);
+            REQUIRE_NE(entry, nullptr);
+            CHECK_EQ(entry->table, table_index);
+            CHECK_EQ(entry->index, index);
+        }
+    }
+}
+
+/** @return the names of the undefined (imported) dynamic symbols of an ELF file */
+static std::vector<std::string> readUndefinedSymbols(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    REQUIRE_GE(data.size(), sizeof(Elf64_Ehdr));
+
+    const auto* header = reinterpret_cast<const Elf64_Ehdr*>(data.data());
+    REQUIRE_EQ(memcmp(header->e_ident, ELFMAG, SELFMAG), 0);
+    REQUIRE_EQ(header->e_ident[EI_CLASS], ELFCLASS64);
+
+    std::vector<std::string> names;
+    const auto* sections = reinterpret_cast<const Elf64_Shdr*>(data.data() + header->e_shoff);
+    for (int i = 0; i < header->e_shnum; i++) {
+        if (sections[i].sh_type != SHT_DYNSYM) {
+            continue;
+        }
+        const char* strings = data.data() + sections[sections[i].sh_link].sh_offset;
+        const auto* symbols = reinterpret_cast<const Elf64_Sym*>(data.data() + sections[i].sh_offset);
+        const auto symbol_count = sections[i].sh_size / sizeof(Elf64_Sym);
+        for (size_t j = 0; j < symbol_count; j++) {
+            if (symbols[j].st_shndx == SHN_UNDEF && symbols[j].st_name != 0) {
+                names.emplace_back(strings + symbols[j].st_name);
+            }
+        }
+    }
+    return names;
+}
+
+/** The lookup that was used before: scan each table in order */
+static const char* findLinear(const char* name) {
+    for (const auto& names : symbol_name_tables) {
+        for (const auto* symbol_name : names) {
+            if (strcmp(symbol_name, name) == 0) {
+                return symbol_name;
+            }
+        }
+    }
+    return nullptr;
+}
+
+TEST_CASE("ElfSymbolTable benchmark: resolve the imports of a real ELF") {
+    constexpr app::ElfSymbolTable<app::getElfSymbolCount(symbol_name_tables)> table(symbol_name_tables);
+
+    // There is no device app in this repository: the test executable's own imports are a real mix
+    // of libc, pthread and C++ runtime symbols that are (or aren't) in the firmware tables.
+    auto app_symbols = readUndefinedSymbols("/proc/self/exe");
+    REQUIRE_FALSE(app_symbols.empty());
+
+    int linear_found = 0;
+    auto linear_start = kernel::getMicros();
+    for (const auto& name : app_symbols) {
+        if (findLinear(name.c_str()) != nullptr) {
+            linear_found++;
+        }
+    }
+    auto linear_duration = kernel::getMicros() - linear_start;
+
+    int table_found = 0;
+    auto table_start = kernel::getMicros();
+    for (const auto& name : app_symbols) {
+        if (table.find(name.c_str()) != nullptr) {
+            table_found++;
+        }
+    }
+    auto table_duration = kernel::getMicros() - table_start;
+
+    CHECK_EQ(linear_found, table_found);
+    MESSAGE("Resolving ", app_symbols.size(), " imports (", table_found, " exported) against ", table.getSize(),
+        " symbols: linear ", linear_duration, " us, sorted table ", table_duration, " us");
+}
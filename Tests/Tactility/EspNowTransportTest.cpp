@@ -0,0 +1,245 @@
+#include "doctest.h"
+
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/service/espnow/EspNowMockRadio.h>
+#include <Tactility/service/espnow/EspNowTransport.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tt;
+using namespace tt::service::espnow;
+
+static constexpr uint8_t PEER_A[ADDRESS_LENGTH] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x0A };
+static constexpr uint8_t PEER_B[ADDRESS_LENGTH] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x0B };
+
+static EspNowConfig createConfig() {
+    uint8_t key[KEY_LENGTH] = {};
+    return EspNowConfig(key, Mode::Station, 1, false, false);
+}
+
+template<typename Predicate>
+static bool waitFor(Predicate predicate, uint32_t timeoutMillis = 2000) {
+    for (uint32_t i = 0; i < timeoutMillis && !predicate(); i++) {
+        kernel::delayMillis(1);
+    }
+    return predicate();
+}
+
+/** A radio that completes sends when the test tells it to */
+class ManualRadio final : public EspNowRadio {
+
+public:
+
+    SendCompleteFunction onSendComplete;
+    std::atomic<int> sendCount = 0;
+    bool acceptSends = true;
+
+    bool start(const EspNowConfig& config, ReceiveFunction onReceive, SendCompleteFunction newOnSendComplete) override {
+        onSendComplete = std::move(newOnSendComplete);
+        return true;
+    }
+
+    void stop() override {}
+
+    bool send(const uint8_t* address, const uint8_t* data, size_t length) override {
+        if (!acceptSends) {
+            return false;
+        }
+        sendCount++;
+        return true;
+    }
+};
+
+TEST_CASE("EspNowTransport passes received frames on in order and in batches") {
+    auto radio = std::make_unique<EspNowMockRadio>();
+    auto* mock = radio.get();
+    std::vector<std::string> messages;
+    std::vector<size_t> batch_sizes;
+    std::atomic<size_t> received = 0;
+    EspNowTransport transport(std::move(radio), [&](std::span<const ReceivedFrame> frames) {
+        batch_sizes.push_back(frames.size());
+        for (const auto& frame : frames) {
+            messages.emplace_back(reinterpret_cast<const char*>(frame.data), frame.length);
+        }
+        received += frames.size();
+    });
+    REQUIRE(transport.start(createConfig()));
+
+    for (int i = 0; i < 20; i++) {
+        auto message = std::to_string(i);
+        mock->receive((i % 2 == 0) ? PEER_A : PEER_B, -40 - (i % 2), reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    }
+
+    REQUIRE(waitFor([&received] { return received == 20; }));
+    transport.stop();
+
+    for (int i = 0; i < 20; i++) {
+        CHECK_EQ(messages[i], std::to_string(i));
+    }
+    for (auto size : batch_sizes) {
+        CHECK_LE(size, EspNowTransport::maxBatchSize);
+    }
+
+    auto statistics = transport.getStatistics();
+    CHECK_EQ(statistics.receivedFrames, 20);
+    CHECK_EQ(statistics.receiveDroppedFrames, 0);
+    CHECK_EQ(statistics.receiveBatches, batch_sizes.size());
+
+    auto peers = transport.getPeerStatistics();
+    REQUIRE_EQ(peers.size(), 2);
+    CHECK_EQ(memcmp(peers[0].address, PEER_A, ADDRESS_LENGTH), 0);
+    CHECK_EQ(peers[0].frames, 10);
+    CHECK_EQ(peers[0].rssi, -40);
+    CHECK_EQ(peers[1].frames, 10);
+    CHECK_EQ(peers[1].rssi, -41);
+}
+
+TEST_CASE("EspNowTransport drops frames when the receive queue is full") {
+    auto radio = std::make_unique<EspNowMockRadio>();
+    auto* mock = radio.get();
+    std::atomic<bool> blocked = true;
+    std::atomic<size_t> received = 0;
+    EspNowTransport transport(std::move(radio), [&](std::span<const ReceivedFrame> frames) {
+        while (blocked) {
+            kernel::delayMillis(1);
+        }
+        received += frames.size();
+    }, 8);
+    REQUIRE(transport.start(createConfig()));
+
+    uint8_t data[MAX_DATA_LENGTH] = {};
+    mock->receive(PEER_A, 0, data, sizeof(data));
+    // Wait for the worker to take the first frame
+    REQUIRE(waitFor([&transport] { return transport.getStatistics().receiveBatches == 1; }));
+    for (int i = 0; i < 20; i++) {
+        mock->receive(PEER_A, 0, data, sizeof(data));
+    }
+    mock->receive(PEER_A, 0, data, MAX_DATA_LENGTH + 1);
+    blocked = false;
+
+    REQUIRE(waitFor([&received] { return received == 9; }));
+    transport.stop();
+
+    auto statistics = transport.getStatistics();
+    CHECK_EQ(statistics.receivedFrames, 9);
+    CHECK_EQ(statistics.receiveDroppedFrames, 12);
+    CHECK_EQ(statistics.receiveOversizedFrames, 1);
+    CHECK_EQ(statistics.receiveQueueHighWaterMark, 8);
+}
+
+TEST_CASE("EspNowTransport sends frames one at a time and reports the results") {
+    auto radio = std::make_unique<ManualRadio>();
+    auto* manual = radio.get();
+    EspNowTransport transport(std::move(radio), [](auto) {}, 8, 4);
+    uint8_t data[4] = { 1, 2, 3, 4 };
+
+    CHECK_EQ(transport.send(PEER_A, data, sizeof(data)), false);
+    REQUIRE(transport.start(createConfig()));
+
+    std::vector<std::pair<int, bool>> results;
+    for (int i = 0; i < 4; i++) {
+        CHECK(transport.send(PEER_A, data, sizeof(data), [&results, i](bool success) {
+            results.emplace_back(i, success);
+        }));
+    }
+    CHECK_EQ(transport.send(PEER_A, data, MAX_DATA_LENGTH + 1), false);
+
+    // The first frame is in flight, so 1 slot is free again
+    REQUIRE(waitFor([manual] { return manual->sendCount == 1; }));
+    CHECK(transport.send(PEER_A, data, sizeof(data)));
+    CHECK_EQ(transport.send(PEER_A, data, sizeof(data)), false);
+
+    manual->onSendComplete(true);
+    REQUIRE(waitFor([manual] { return manual->sendCount == 2; }));
+    manual->onSendComplete(false);
+    REQUIRE(waitFor([manual] { return manual->sendCount == 3; }));
+    CHECK_EQ(manual->sendCount.load(), 3);
+
+    // Frames that weren't sent yet fail
+    transport.stop();
+
+    REQUIRE_EQ(results.size(), 4);
+    CHECK_EQ(results[0], std::pair(0, true));
+    CHECK_EQ(results[1], std::pair(1, false));
+    CHECK_EQ(results[2], std::pair(2, false));
+    CHECK_EQ(results[3], std::pair(3, false));
+
+    auto statistics = transport.getStatistics();
+    CHECK_EQ(statistics.sentFrames, 1);
+    CHECK_EQ(statistics.sendFailedFrames, 4);
+    CHECK_EQ(statistics.sendDroppedFrames, 1);
+}
+
+TEST_CASE("EspNowTransport fails frames that the radio rejects") {
+    auto radio = std::make_unique<ManualRadio>();
+    radio->acceptSends = false;
+    EspNowTransport transport(std::move(radio), [](auto) {});
+    REQUIRE(transport.start(createConfig()));
+
+    std::atomic<int> failures = 0;
+    uint8_t data[1] = { 0 };
+    for (int i = 0; i < 3; i++) {
+        transport.send(PEER_A, data, sizeof(data), [&failures](bool success) {
+            if (!success) {
+                failures++;
+            }
+        });
+    }
+
+    CHECK(waitFor([&failures] { return failures == 3; }));
+}
+
+TEST_CASE("espnow transport benchmark") {
+    constexpr int FRAME_COUNT = 100000;
+    auto radio = std::make_unique<EspNowMockRadio>(true);
+    auto* mock = radio.get();
+    std::atomic<uint64_t> bytes = 0;
+    EspNowTransport transport(std::move(radio), [&bytes](std::span<const ReceivedFrame> frames) {
+        for (const auto& frame : frames) {
+            bytes += frame.length;
+        }
+    });
+    REQUIRE(transport.start(createConfig()));
+
+    uint8_t data[MAX_DATA_LENGTH];
+    memset(data, 0x55, sizeof(data));
+
+    // Receive from a separate task, like the Wi-Fi driver does
+    auto start_time = kernel::getMicros();
+    std::thread driver([mock, &data] {
+        for (int i = 0; i < FRAME_COUNT; i++) {
+            mock->receive(PEER_A, -50, data, sizeof(data));
+        }
+    });
+    driver.join();
+    waitFor([&transport] {
+        auto statistics = transport.getStatistics();
+        return statistics.receivedFrames + statistics.receiveDroppedFrames == FRAME_COUNT;
+    });
+    auto receive_duration = kernel::getMicros() - start_time;
+
+    // Loopback: every sent frame is received again
+    std::atomic<int> sent = 0;
+    start_time = kernel::getMicros();
+    for (int i = 0; i < 10000; i++) {
+        while (!transport.send(PEER_B, data, sizeof(data), [&sent](bool) { sent++; })) {
+            std::this_thread::yield();
+        }
+    }
+    waitFor([&sent] { return sent == 10000; });
+    auto send_duration = kernel::getMicros() - start_time;
+    transport.stop();
+
+    auto statistics = transport.getStatistics();
+    CHECK_EQ(sent.load(), 10000);
+    CHECK_EQ(statistics.receivedFrames + statistics.receiveDroppedFrames, FRAME_COUNT + 10000);
+    auto delivered_frames = statistics.receivedFrames - 10000;
+    MESSAGE("receive: ", (delivered_frames * 1000000.0) / (double)receive_duration, " frames/s delivered of ",
+        (FRAME_COUNT * 1000000.0) / (double)receive_duration, " frames/s offered, ",
+        statistics.receiveDroppedFrames, " dropped, ", statistics.receiveBatches, " batches");
+    MESSAGE("send: ", (10000 * 1000000.0) / (double)send_duration, " frames/s");
+}
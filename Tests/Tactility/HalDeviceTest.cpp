@@ -2,6 +2,7 @@
 #include <Tactility/hal/Device.h>
 
 #include <utility>
+#include <vector>
 
 using namespace tt;
 
@@ -96,3 +97,39 @@ TEST_CASE("find device by type") {
     CHECK_NE(found_device, nullptr);
     CHECK_EQ(found_device->getId(), device->getId());
 }
+
+TEST_CASE("registering a device changes the generation and publishes an event") {
+    auto device = std::make_shared<TestDevice>(hal::Device::Type::Gps, "GpsMock", "");
+    std::vector<hal::DeviceEvent> events;
+    auto subscription = hal::getDevicePubsub()->subscribe([&events](const auto& event) {
+        events.push_back(event);
+    });
+
+    auto initial_generation = hal::getDeviceGeneration();
+    hal::registerDevice(device);
+    auto registered_generation = hal::getDeviceGeneration();
+    hal::deregisterDevice(device);
+
+    hal::getDevicePubsub()->unsubscribe(subscription);
+
+    CHECK_NE(registered_generation, initial_generation);
+    CHECK_NE(hal::getDeviceGeneration(), registered_generation);
+    REQUIRE_EQ(events.size(), 2);
+    CHECK_EQ(events[0].action, hal::DeviceEvent::Action::Registered);
+    CHECK_EQ(events[0].id, device->getId());
+    CHECK_EQ(events[0].type, hal::Device::Type::Gps);
+    CHECK_EQ(events[0].generation, registered_generation);
+    CHECK_EQ(events[1].action, hal::DeviceEvent::Action::Deregistered);
+}
+
+TEST_CASE("device snapshot is not affected by later registrations") {
+    auto snapshot = hal::getDeviceSnapshot();
+    auto device = std::make_shared<TestDevice>(hal::Device::Type::Encoder, "EncoderMock", "");
+    DeviceAutoRegistration auto_registration(device);
+
+    CHECK_EQ(snapshot->devicesById.contains(device->getId()), false);
+
+    auto new_snapshot = hal::getDeviceSnapshot();
+    CHECK_EQ(new_snapshot->devicesById.contains(device->getId()), true);
+    CHECK_EQ(new_snapshot->getDevices(hal::Device::Type::Encoder).size(), snapshot->getDevices(hal::Device::Type::Encoder).size() + 1);
+}
@@ -0,0 +1,59 @@
+#include "doctest.h"
+#include <Tactility/file/MountTable.h>
+#include <Tactility/Mutex.h>
+
+#include <vector>
+
+using namespace tt;
+
+TEST_CASE("mount table resolves the longest matching mount path") {
+    auto root_lock = std::make_shared<Mutex>();
+    auto sdcard_lock = std::make_shared<Mutex>();
+    file::addMount({ .path = "/mnt", .lock = root_lock, .deviceId = 1 });
+    file::addMount({ .path = "/mnt/sdcard", .lock = sdcard_lock, .deviceId = 2 });
+
+    CHECK_EQ(file::findMountLock("/mnt/sdcard/apps/app.elf"), sdcard_lock);
+    CHECK_EQ(file::findMountLock("/mnt/sdcard"), sdcard_lock);
+    CHECK_EQ(file::findMountLock("/mnt/sdcard/"), sdcard_lock);
+    CHECK_EQ(file::findMountLock("/mnt/other/file.txt"), root_lock);
+    CHECK_EQ(file::findMountLock("/data/settings.properties"), nullptr);
+
+    file::Mount mount;
+    CHECK(file::findMount("/mnt/sdcard/file.txt", mount));
+    CHECK_EQ(mount.path, "/mnt/sdcard");
+    CHECK_EQ(mount.deviceId, 2);
+
+    CHECK(file::removeMount("/mnt/sdcard"));
+    CHECK(file::removeMount("/mnt"));
+    CHECK_EQ(file::findMountLock("/mnt/sdcard/file.txt"), nullptr);
+}
+
+TEST_CASE("mount table only matches whole path components") {
+    auto lock = std::make_shared<Mutex>();
+    file::addMount({ .path = "/sdcard", .lock = lock, .deviceId = 1 });
+
+    CHECK_EQ(file::findMountLock("/sdcard/file.txt"), lock);
+    CHECK_EQ(file::findMountLock("/sdcard2/file.txt"), nullptr);
+
+    CHECK(file::removeMount("/sdcard"));
+}
+
+TEST_CASE("mount table publishes events and changes generation") {
+    std::vector<file::MountEvent> events;
+    auto subscription = file::getMountPubsub()->subscribe([&events](const auto& event) {
+        events.push_back(event);
+    });
+
+    auto initial_generation = file::getMountGeneration();
+    file::addMount({ .path = "/sdcard", .lock = nullptr, .deviceId = 1 });
+    CHECK_FALSE(file::removeMount("/unknown"));
+    CHECK(file::removeMount("/sdcard"));
+
+    file::getMountPubsub()->unsubscribe(subscription);
+
+    CHECK_NE(file::getMountGeneration(), initial_generation);
+    REQUIRE_EQ(events.size(), 2);
+    CHECK_EQ(events[0].action, file::MountEvent::Action::Mounted);
+    CHECK_EQ(events[0].path, "/sdcard");
+    CHECK_EQ(events[1].action, file::MountEvent::Action::Unmounted);
+}
@@ -0,0 +1,222 @@
+#include "doctest.h"
+
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/network/MultipartParser.h>
+
+#include <format>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tt;
+using namespace tt::network;
+
+static constexpr auto* BOUNDARY = "----TactilityBoundary7MA4YWxk";
+
+struct ParsedPart {
+    std::vector<std::string> headers;
+    std::string data;
+    bool ended = false;
+};
+
+/** Collects the parts and passes the body in chunks of the given sizes */
+class Collector {
+
+public:
+
+    std::vector<ParsedPart> parts;
+    std::vector<size_t> sliceSizes;
+
+    MultipartParser parser;
+
+    explicit Collector(const std::string& boundary = BOUNDARY) : parser(
+        boundary,
+        [this](const std::vector<std::string>& headers) {
+            parts.push_back({ .headers = headers, .data = "", .ended = false });
+            return true;
+        },
+        [this](const char* data, size_t size) {
+            parts.back().data.append(data, size);
+            sliceSizes.push_back(size);
+            return true;
+        },
+        [this] {
+            parts.back().ended = true;
+            return true;
+        }
+    ) {}
+
+    bool write(const std::string& body, size_t chunkSize) {
+        for (size_t offset = 0; offset < body.size(); offset += chunkSize) {
+            if (!parser.write(body.data() + offset, std::min(chunkSize, body.size() - offset))) {
+                return false;
+            }
+        }
+        return parser.finish();
+    }
+};
+
+static std::string createBody(const std::vector<std::pair<std::string, std::string>>& parts, const std::string& boundary = BOUNDARY) {
+    std::string body;
+    for (const auto& [name, data] : parts) {
+        body += std::format("--{}\r\nContent-Disposition: form-data; name=\"{}\"; filename=\"{}.bin\"\r\nContent-Type: application/octet-stream\r\n\r\n", boundary, name, name);
+        body += data;
+        body += "\r\n";
+    }
+    body += std::format("--{}--\r\n", boundary);
+    return body;
+}
+
+/** Data that contains parts of the delimiter */
+static std::string createTrickyData(size_t size) {
+    std::string data;
+    std::mt19937 random(1234);
+    while (data.size() < size) {
+        switch (random() % 5) {
+            case 0:
+                data += "\r\n--";
+                break;
+            case 1:
+                data += std::string("\r\n--") + std::string(BOUNDARY).substr(0, random() % 20);
+                break;
+            case 2:
+                data += "\r\r\n";
+                break;
+            default:
+                data += static_cast<char>(random());
+                break;
+        }
+    }
+    return data;
+}
+
+TEST_CASE("MultipartParser parses parts regardless of chunk size") {
+    auto first = createTrickyData(3000);
+    auto second = std::string(10000, 'x');
+    auto body = createBody({ { "elf", first }, { "other", second } });
+
+    for (size_t chunk_size : { 1, 2, 3, 7, 31, 64, 512, 4096, 100000 }) {
+        CAPTURE(chunk_size);
+        Collector collector;
+        CHECK_EQ(collector.write(body, chunk_size), true);
+        REQUIRE_EQ(collector.parts.size(), 2);
+        CHECK_EQ(collector.parts[0].data, first);
+        CHECK_EQ(collector.parts[0].ended, true);
+        CHECK_EQ(collector.parts[1].data, second);
+        CHECK_EQ(collector.parts[1].ended, true);
+        REQUIRE_EQ(collector.parts[0].headers.size(), 2);
+        CHECK_EQ(collector.parts[0].headers[1], "Content-Type: application/octet-stream");
+        auto disposition = parseContentDisposition(collector.parts[0].headers);
+        CHECK_EQ(disposition["name"], "elf");
+        CHECK_EQ(disposition["filename"], "elf.bin");
+        CHECK_EQ(collector.parser.getStatistics().partCount, 2);
+        CHECK_EQ(collector.parser.getStatistics().dataBytes, first.size() + second.size());
+    }
+}
+
+TEST_CASE("MultipartParser passes data on without copying it into small slices") {
+    auto body = createBody({ { "elf", std::string(20000, 'x') } });
+    Collector collector;
+    CHECK_EQ(collector.write(body, 4096), true);
+    // Only the chunk boundaries split the data
+    CHECK_LE(collector.sliceSizes.size(), 6);
+}
+
+TEST_CASE("MultipartParser handles random chunk sizes") {
+    std::mt19937 random(42);
+    for (int iteration = 0; iteration < 50; iteration++) {
+        CAPTURE(iteration);
+        auto data = createTrickyData(random() % 2000);
+        auto body = "preamble\r\n" + createBody({ { "a", data }, { "b", "" } }) + "epilogue";
+
+        Collector collector;
+        size_t offset = 0;
+        bool success = true;
+        while (offset < body.size() && success) {
+            auto length = std::min<size_t>(1 + random() % 100, body.size() - offset);
+            success = collector.parser.write(body.data() + offset, length);
+            offset += length;
+        }
+
+        CHECK_EQ(success, true);
+        CHECK_EQ(collector.parser.finish(), true);
+        REQUIRE_EQ(collector.parts.size(), 2);
+        CHECK_EQ(collector.parts[0].data, data);
+        CHECK_EQ(collector.parts[1].data, "");
+    }
+}
+
+TEST_CASE("MultipartParser accepts parts without headers") {
+    auto body = std::format("--{}\r\n\r\nvalue\r\n--{}--", BOUNDARY, BOUNDARY);
+    Collector collector;
+    CHECK_EQ(collector.write(body, 3), true);
+    REQUIRE_EQ(collector.parts.size(), 1);
+    CHECK_EQ(collector.parts[0].headers.empty(), true);
+    CHECK_EQ(collector.parts[0].data, "value");
+}
+
+TEST_CASE("MultipartParser fails on invalid and incomplete bodies") {
+    auto body = createBody({ { "elf", "data" } });
+
+    Collector truncated;
+    CHECK_EQ(truncated.write(body.substr(0, body.size() - 10), 16), false);
+    CHECK_EQ(truncated.parser.hasFailed(), false);
+
+    Collector invalid;
+    auto invalid_body = std::format("--{}XX\r\n\r\ndata", BOUNDARY);
+    CHECK_EQ(invalid.parser.write(invalid_body.data(), invalid_body.size()), false);
+    CHECK_EQ(invalid.parser.hasFailed(), true);
+
+    Collector large_headers;
+    auto large_headers_body = std::format("--{}\r\nX-Header: {}\r\n\r\n", BOUNDARY, std::string(2000, 'h'));
+    CHECK_EQ(large_headers.parser.write(large_headers_body.data(), large_headers_body.size()), false);
+
+    Collector invalid_boundary("");
+    CHECK_EQ(invalid_boundary.parser.write(body.data(), body.size()), false);
+}
+
+TEST_CASE("MultipartParser stops when a callback fails") {
+    auto body = createBody({ { "elf", std::string(5000, 'x') } });
+    size_t data_received = 0;
+    MultipartParser parser(
+        BOUNDARY,
+        [](const auto&) { return true; },
+        [&data_received](const char*, size_t size) {
+            data_received += size;
+            return false;
+        },
+        [] { return true; }
+    );
+    CHECK_EQ(parser.write(body.data(), 1000), false);
+    CHECK_EQ(parser.write(body.data() + 1000, body.size() - 1000), false);
+    CHECK_EQ(parser.hasFailed(), true);
+    CHECK_LT(data_received, 1000);
+}
+
+TEST_CASE("multipart parser benchmark") {
+    constexpr size_t DATA_SIZE = 4 * 1024 * 1024;
+    auto body = createBody({ { "elf", std::string(DATA_SIZE, 'x') } });
+
+    for (size_t chunk_size : { 512, 4096 }) {
+        uint64_t received = 0;
+        MultipartParser parser(
+            BOUNDARY,
+            [](const auto&) { return true; },
+            [&received](const char*, size_t size) {
+                received += size;
+                return true;
+            },
+            [] { return true; }
+        );
+
+        auto start_time = kernel::getMicros();
+        for (size_t offset = 0; offset < body.size(); offset += chunk_size) {
+            parser.write(body.data() + offset, std::min(chunk_size, body.size() - offset));
+        }
+        auto duration = kernel::getMicros() - start_time;
+
+        CHECK_EQ(parser.finish(), true);
+        CHECK_EQ(received, DATA_SIZE);
+        MESSAGE("chunk size ", chunk_size, ": ", (double)body.size() / (double)(duration > 0 ? duration : 1), " MB/s");
+    }
+}
@@ -0,0 +1,118 @@
+#include "doctest.h"
+#include <Tactility/hal/gps/NmeaParser.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <string>
+#include <vector>
+
+using namespace tt;
+using namespace tt::hal::gps;
+
+/** One second of output from a receiver with a fix (RMC, VTG, GGA, GSA, 3x GSV) plus a proprietary sentence */
+static const std::vector<std::string> recording = {
+    "$GPRMC,092750.000,A,5321.6802,N,00630.3372,W,0.02,31.66,280511,,,A*43\r",
+    "$GPVTG,31.66,T,,M,0.02,N,0.04,K,A*09\r",
+    "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76\r",
+    "$GPGSA,A,3,10,07,05,02,29,04,08,13,,,,,1.72,1.03,1.38*0A\r",
+    "$GPGSV,3,1,11,10,63,137,17,07,61,098,15,05,59,290,20,08,54,157,30*70\r",
+    "$GPGSV,3,2,11,02,39,223,19,13,28,070,17,26,23,252,,04,14,186,14*79\r",
+    "$GPGSV,3,3,11,29,09,301,24,16,09,020,,36,,,*76\r",
+    "$PMTK001,314,3*36\r"
+};
+
+TEST_CASE("NmeaParser only decodes sentence types with subscribers") {
+    NmeaParser parser(7);
+    for (auto& sentence : recording) {
+        CHECK_FALSE(parser.process(sentence.c_str()));
+    }
+    CHECK_EQ(parser.getStatistics().skippedCount, recording.size());
+    CHECK_EQ(parser.getStatistics().publishedCount, 0);
+}
+
+TEST_CASE("NmeaParser publishes all supported sentence types") {
+    NmeaParser parser(7);
+    int rmc_count = 0, gga_count = 0, gsa_count = 0, gsv_count = 0, vtg_count = 0;
+
+    auto rmc_subscription = parser.getRmcPubsub()->subscribe([&rmc_count](const RmcFrame& frame) {
+        CHECK_EQ(frame.deviceId, 7);
+        CHECK(frame.sentence.valid);
+        CHECK_EQ(frame.sentence.time.hours, 9);
+        rmc_count++;
+    });
+    auto gga_subscription = parser.getGgaPubsub()->subscribe([&gga_count](const GgaFrame& frame) {
+        CHECK_EQ(frame.sentence.satellites_tracked, 8);
+        gga_count++;
+    });
+    auto gsa_subscription = parser.getGsaPubsub()->subscribe([&gsa_count](const GsaFrame& frame) {
+        CHECK_EQ(frame.sentence.fix_type, 3);
+        gsa_count++;
+    });
+    auto gsv_subscription = parser.getGsvPubsub()->subscribe([&gsv_count](const GsvFrame& frame) {
+        CHECK_EQ(frame.sentence.total_sats, 11);
+        gsv_count++;
+    });
+    auto vtg_subscription = parser.getVtgPubsub()->subscribe([&vtg_count](const VtgFrame& frame) {
+        vtg_count++;
+    });
+
+    for (auto& sentence : recording) {
+        parser.process(sentence.c_str());
+    }
+
+    CHECK_EQ(rmc_count, 1);
+    CHECK_EQ(gga_count, 1);
+    CHECK_EQ(gsa_count, 1);
+    CHECK_EQ(gsv_count, 3);
+    CHECK_EQ(vtg_count, 1);
+    CHECK_EQ(parser.getStatistics().skippedCount, 1);
+    CHECK_EQ(parser.getStatistics().errorCount, 0);
+
+    parser.getRmcPubsub()->unsubscribe(rmc_subscription);
+    parser.getGgaPubsub()->unsubscribe(gga_subscription);
+    parser.getGsaPubsub()->unsubscribe(gsa_subscription);
+    parser.getGsvPubsub()->unsubscribe(gsv_subscription);
+    parser.getVtgPubsub()->unsubscribe(vtg_subscription);
+}
+
+TEST_CASE("NmeaParser rejects sentences with a bad checksum") {
+    NmeaParser parser(0);
+    int rmc_count = 0;
+    auto subscription = parser.getRmcPubsub()->subscribe([&rmc_count](const RmcFrame&) {
+        rmc_count++;
+    });
+
+    CHECK_FALSE(parser.process("$GPRMC,092750.000,A,5321.6802,N,00630.3372,W,0.02,31.66,280511,,,A*44\r"));
+    CHECK_EQ(rmc_count, 0);
+    CHECK_EQ(parser.getStatistics().errorCount, 1);
+
+    parser.getRmcPubsub()->unsubscribe(subscription);
+}
+
+TEST_CASE("NmeaParser benchmark: replay recording") {
+    constexpr int REPLAY_COUNT = 1000;
+    NmeaParser parser(0);
+
+    // Subscribe like GpsService: only RMC and GGA are decoded
+    uint32_t fix_count = 0;
+    auto rmc_subscription = parser.getRmcPubsub()->subscribe([&fix_count](const RmcFrame&) { fix_count++; });
+    auto gga_subscription = parser.getGgaPubsub()->subscribe([](const GgaFrame&) {});
+
+    auto start_time = kernel::getMicros();
+    for (int i = 0; i < REPLAY_COUNT; i++) {
+        for (auto& sentence : recording) {
+            parser.process(sentence.c_str());
+        }
+    }
+    auto duration = kernel::getMicros() - start_time;
+
+    CHECK_EQ(fix_count, REPLAY_COUNT);
+    auto sentence_count = parser.getStatistics().sentenceCount;
+    MESSAGE(
+        sentence_count, " sentences in ", duration, " us: ",
+        (duration > 0) ? (sentence_count * 1000000ULL / duration) : 0, " sentences/s, ",
+        (double)duration / fix_count, " us CPU per fix"
+    );
+
+    parser.getRmcPubsub()->unsubscribe(rmc_subscription);
+    parser.getGgaPubsub()->unsubscribe(gga_subscription);
+}
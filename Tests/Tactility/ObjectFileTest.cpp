@@ -1,5 +1,10 @@
 #include "doctest.h"
 #include <Tactility/file/ObjectFile.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
 
 using tt::file::ObjectFileWriter;
 using tt::file::ObjectFileReader;
@@ -63,3 +68,348 @@ TEST_CASE("Appending records to a file") {
 
     remove(TEMP_FILE);
 }
+
+TEST_CASE("Reading records by index") {
+    ObjectFileWriter writer = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, false, 4);
+    CHECK_EQ(writer.open(), true);
+    for (uint32_t i = 0; i < 10; i++) {
+        TestStruct record = { .value = i * 10 };
+        CHECK_EQ(writer.write(&record), true);
+    }
+    writer.close();
+
+    for (bool memory_map : { false, true }) {
+        ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct), memory_map);
+        CHECK_EQ(reader.open(), true);
+        CHECK_EQ(reader.getFileVersion(), 2);
+        CHECK_EQ(reader.getRecordCount(), 10);
+        TestStruct record_in;
+        for (uint32_t i : { 9, 0, 5, 4, 3 }) {
+            CHECK_EQ(reader.read(i, &record_in), true);
+            CHECK_EQ(record_in.value, i * 10);
+        }
+        CHECK_EQ(reader.read(10, &record_in), false);
+        reader.close();
+    }
+
+    remove(TEMP_FILE);
+}
+
+TEST_CASE("Updating and deleting records") {
+    ObjectFileWriter writer = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, false, 4);
+    CHECK_EQ(writer.open(), true);
+    for (uint32_t i = 0; i < 6; i++) {
+        TestStruct record = { .value = i };
+        CHECK_EQ(writer.write(&record), true);
+    }
+    writer.close();
+
+    ObjectFileWriter editor = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, true);
+    CHECK_EQ(editor.open(), true);
+    CHECK_EQ(editor.getRecordCount(), 6);
+    TestStruct updated = { .value = 100 };
+    CHECK_EQ(editor.update(1, &updated), true);
+    CHECK_EQ(editor.remove(2), true);
+    CHECK_EQ(editor.remove(2), false);
+    CHECK_EQ(editor.update(2, &updated), false);
+    CHECK_EQ(editor.remove(5), true);
+    CHECK_EQ(editor.remove(6), false);
+    editor.close();
+
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+    CHECK_EQ(reader.open(), true);
+    CHECK_EQ(reader.getRecordCount(), 6);
+    CHECK_EQ(reader.getDeletedRecordCount(), 2);
+    CHECK_EQ(reader.isDeleted(2), true);
+    CHECK_EQ(reader.isDeleted(3), false);
+    CHECK_GT(reader.getGarbageSize(), 0);
+
+    std::vector<uint32_t> values;
+    TestStruct record_in;
+    while (reader.hasNext()) {
+        CHECK_EQ(reader.readNext(&record_in), true);
+        values.push_back(record_in.value);
+    }
+    CHECK_EQ(values, std::vector<uint32_t> { 0, 100, 3, 4 });
+    reader.close();
+
+    CHECK_EQ(tt::file::compactObjectFile(TEMP_FILE, sizeof(TestStruct)), true);
+    CHECK_EQ(reader.open(), true);
+    CHECK_EQ(reader.getRecordCount(), 4);
+    CHECK_EQ(reader.getDeletedRecordCount(), 0);
+    CHECK_EQ(reader.getGarbageSize(), 0);
+    CHECK_EQ(reader.read(1, &record_in), true);
+    CHECK_EQ(record_in.value, 100);
+    reader.close();
+
+    remove(TEMP_FILE);
+}
+
+TEST_CASE("An interrupted compaction is recovered when opening the file") {
+    const std::string compacted_path = std::string(TEMP_FILE) + ".tmp";
+    ObjectFileWriter writer = ObjectFileWriter(compacted_path, sizeof(TestStruct), 1, false);
+    CHECK_EQ(writer.open(), true);
+    for (uint32_t i = 0; i < 3; i++) {
+        TestStruct record = { .value = i };
+        CHECK_EQ(writer.write(&record), true);
+    }
+    writer.close();
+
+    // Interrupted after the original file was removed: only the compacted file exists
+    remove(TEMP_FILE);
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+    CHECK_EQ(reader.open(), true);
+    CHECK_EQ(reader.getRecordCount(), 3);
+    TestStruct record_in;
+    CHECK_EQ(reader.read(2, &record_in), true);
+    CHECK_EQ(record_in.value, 2);
+    reader.close();
+    CHECK_EQ(std::filesystem::exists(compacted_path), false);
+
+    // Interrupted before the original file was removed: the (possibly incomplete) compacted file is discarded
+    FILE* partial_file = fopen(compacted_path.c_str(), "wb");
+    REQUIRE_NE(partial_file, nullptr);
+    fputs("partial", partial_file);
+    fclose(partial_file);
+    ObjectFileWriter appender = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, true);
+    CHECK_EQ(appender.open(), true);
+    CHECK_EQ(appender.getRecordCount(), 3);
+    appender.close();
+    CHECK_EQ(std::filesystem::exists(compacted_path), false);
+
+    remove(TEMP_FILE);
+}
+
+TEST_CASE("An interrupted commit leaves the previous commit intact") {
+    ObjectFileWriter writer = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, false, 4);
+    CHECK_EQ(writer.open(), true);
+    for (uint32_t i = 0; i < 6; i++) {
+        TestStruct record = { .value = i };
+        CHECK_EQ(writer.write(&record), true);
+    }
+    writer.close();
+    auto committed_size = std::filesystem::file_size(TEMP_FILE);
+
+    ObjectFileWriter appender = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, true);
+    CHECK_EQ(appender.open(), true);
+    for (uint32_t i = 6; i < 12; i++) {
+        TestStruct record = { .value = i };
+        CHECK_EQ(appender.write(&record), true);
+    }
+    appender.close();
+    auto full_size = std::filesystem::file_size(TEMP_FILE);
+
+    // Cut the second commit off at every possible position
+    for (auto size = committed_size; size < full_size; size++) {
+        std::filesystem::resize_file(TEMP_FILE, size);
+        ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+        CHECK_EQ(reader.open(), true);
+        CHECK_EQ(reader.getRecordCount(), 6);
+        TestStruct record_in;
+        CHECK_EQ(reader.read(5, &record_in), true);
+        CHECK_EQ(record_in.value, 5);
+    }
+
+    // Appending after an interrupted commit overwrites it
+    ObjectFileWriter recovering_appender = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, true);
+    CHECK_EQ(recovering_appender.open(), true);
+    TestStruct record_out = { .value = 6 };
+    CHECK_EQ(recovering_appender.write(&record_out), true);
+    recovering_appender.close();
+
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+    CHECK_EQ(reader.open(), true);
+    CHECK_EQ(reader.getRecordCount(), 7);
+    reader.close();
+
+    remove(TEMP_FILE);
+}
+
+TEST_CASE("Corrupt records are detected") {
+    ObjectFileWriter writer = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, false, 4);
+    CHECK_EQ(writer.open(), true);
+    for (uint32_t i = 0; i < 8; i++) {
+        TestStruct record = { .value = i };
+        CHECK_EQ(writer.write(&record), true);
+    }
+    writer.close();
+
+    // Flip a bit in the last record of the first block
+    auto* file = fopen(TEMP_FILE, "r+b");
+    REQUIRE_NE(file, nullptr);
+    constexpr long LAST_BYTE_OF_FIRST_BLOCK = 8 + 16 + 32 + (4 * sizeof(TestStruct)) - 1;
+    fseek(file, LAST_BYTE_OF_FIRST_BLOCK, SEEK_SET);
+    uint8_t byte = fgetc(file);
+    fseek(file, LAST_BYTE_OF_FIRST_BLOCK, SEEK_SET);
+    fputc(byte ^ 0x01, file);
+    fclose(file);
+
+    for (bool memory_map : { false, true }) {
+        ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct), memory_map);
+        CHECK_EQ(reader.open(), true);
+        TestStruct record_in;
+        CHECK_EQ(reader.read(0, &record_in), false);
+        CHECK_EQ(reader.read(4, &record_in), true);
+        CHECK_EQ(record_in.value, 4);
+        reader.close();
+    }
+
+    remove(TEMP_FILE);
+}
+
+/** Write a file in the version 1 format */
+static void writeVersion1File(const char* path, uint32_t count) {
+    auto* file = fopen(path, "wb");
+    REQUIRE_NE(file, nullptr);
+    uint32_t header[] = { 0x13371337, 1, 1, sizeof(TestStruct), count };
+    fwrite(header, sizeof(header), 1, file);
+    for (uint32_t i = 0; i < count; i++) {
+        TestStruct record = { .value = i };
+        fwrite(&record, sizeof(TestStruct), 1, file);
+    }
+    fclose(file);
+}
+
+TEST_CASE("Reading and appending to a version 1 file") {
+    writeVersion1File(TEMP_FILE, 3);
+
+    for (bool memory_map : { false, true }) {
+        ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct), memory_map);
+        CHECK_EQ(reader.open(), true);
+        CHECK_EQ(reader.getFileVersion(), 1);
+        CHECK_EQ(reader.getRecordCount(), 3);
+        TestStruct record_in;
+        CHECK_EQ(reader.read(2, &record_in), true);
+        CHECK_EQ(record_in.value, 2);
+        CHECK_EQ(reader.readNext(&record_in), true);
+        CHECK_EQ(record_in.value, 0);
+        CHECK_EQ(reader.readNext(&record_in), true);
+        CHECK_EQ(record_in.value, 1);
+        reader.close();
+    }
+
+    ObjectFileWriter appender = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, true);
+    CHECK_EQ(appender.open(), true);
+    TestStruct record_out = { .value = 3 };
+    CHECK_EQ(appender.write(&record_out), true);
+    appender.close();
+
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+    CHECK_EQ(reader.open(), true);
+    CHECK_EQ(reader.getFileVersion(), 2);
+    CHECK_EQ(reader.getRecordCount(), 4);
+    TestStruct record_in;
+    CHECK_EQ(reader.read(3, &record_in), true);
+    CHECK_EQ(record_in.value, 3);
+    reader.close();
+
+    remove(TEMP_FILE);
+}
+
+struct BenchmarkRecord {
+    uint32_t id;
+    uint32_t timestamp;
+    float latitude;
+    float longitude;
+};
+
+TEST_CASE("object file benchmark") {
+    constexpr uint32_t RECORD_COUNT = 100000;
+
+    auto start_time = tt::kernel::getMicros();
+    ObjectFileWriter writer = ObjectFileWriter(TEMP_FILE, sizeof(BenchmarkRecord), 1, false);
+    REQUIRE_EQ(writer.open(), true);
+    for (uint32_t i = 0; i < RECORD_COUNT; i++) {
+        BenchmarkRecord record = { .id = i, .timestamp = i * 2, .latitude = 52.0f, .longitude = 4.0f };
+        REQUIRE_EQ(writer.write(&record), true);
+    }
+    writer.close();
+    auto write_duration = tt::kernel::getMicros() - start_time;
+    MESSAGE("v2 write: ", write_duration, " us for ", RECORD_COUNT, " records, ", std::filesystem::file_size(TEMP_FILE), " bytes");
+
+    // Random indices, so the block cache doesn't help
+    std::vector<uint32_t> indices(RECORD_COUNT);
+    uint32_t random = 12345;
+    for (auto& index : indices) {
+        random = random * 1103515245 + 12345;
+        index = (random >> 8) % RECORD_COUNT;
+    }
+
+    for (bool memory_map : { false, true }) {
+        ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(BenchmarkRecord), memory_map);
+        start_time = tt::kernel::getMicros();
+        REQUIRE_EQ(reader.open(), true);
+        auto open_duration = tt::kernel::getMicros() - start_time;
+
+        BenchmarkRecord record;
+        start_time = tt::kernel::getMicros();
+        uint32_t count = 0;
+        while (reader.hasNext()) {
+            REQUIRE_EQ(reader.readNext(&record), true);
+            REQUIRE_EQ(record.id, count);
+            count++;
+        }
+        auto sequential_duration = tt::kernel::getMicros() - start_time;
+        CHECK_EQ(count, RECORD_COUNT);
+
+        start_time = tt::kernel::getMicros();
+        for (auto index : indices) {
+            REQUIRE_EQ(reader.read(index, &record), true);
+            REQUIRE_EQ(record.id, index);
+        }
+        auto random_duration = tt::kernel::getMicros() - start_time;
+        reader.close();
+
+        MESSAGE("v2 ", std::string(memory_map ? "mmap" : "stream"), ": open ", open_duration, " us, sequential ", sequential_duration, " us, random ", random_duration, " us");
+    }
+
+    // Delete 10% and compact
+    ObjectFileWriter editor = ObjectFileWriter(TEMP_FILE, sizeof(BenchmarkRecord), 1, true);
+    REQUIRE_EQ(editor.open(), true);
+    start_time = tt::kernel::getMicros();
+    for (uint32_t i = 0; i < RECORD_COUNT; i += 10) {
+        REQUIRE_EQ(editor.remove(i), true);
+    }
+    editor.close();
+    auto delete_duration = tt::kernel::getMicros() - start_time;
+
+    start_time = tt::kernel::getMicros();
+    REQUIRE_EQ(tt::file::compactObjectFile(TEMP_FILE, sizeof(BenchmarkRecord)), true);
+    auto compact_duration = tt::kernel::getMicros() - start_time;
+    MESSAGE("v2 delete 10%: ", delete_duration, " us, compact: ", compact_duration, " us");
+
+    ObjectFileReader compacted = ObjectFileReader(TEMP_FILE, sizeof(BenchmarkRecord));
+    REQUIRE_EQ(compacted.open(), true);
+    CHECK_EQ(compacted.getRecordCount(), RECORD_COUNT - RECORD_COUNT / 10);
+    compacted.close();
+
+    // Version 1: sequential reads only (random access seeks for every record)
+    remove(TEMP_FILE);
+    auto* file = fopen(TEMP_FILE, "wb");
+    REQUIRE_NE(file, nullptr);
+    uint32_t header[] = { 0x13371337, 1, 1, sizeof(BenchmarkRecord), RECORD_COUNT };
+    fwrite(header, sizeof(header), 1, file);
+    for (uint32_t i = 0; i < RECORD_COUNT; i++) {
+        BenchmarkRecord record = { .id = i, .timestamp = i * 2, .latitude = 52.0f, .longitude = 4.0f };
+        fwrite(&record, sizeof(BenchmarkRecord), 1, file);
+    }
+    fclose(file);
+
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(BenchmarkRecord), false);
+    REQUIRE_EQ(reader.open(), true);
+    BenchmarkRecord record;
+    start_time = tt::kernel::getMicros();
+    while (reader.hasNext()) {
+        REQUIRE_EQ(reader.readNext(&record), true);
+    }
+    auto sequential_duration = tt::kernel::getMicros() - start_time;
+    start_time = tt::kernel::getMicros();
+    for (auto index : indices) {
+        REQUIRE_EQ(reader.read(index, &record), true);
+    }
+    auto random_duration = tt::kernel::getMicros() - start_time;
+    reader.close();
+    MESSAGE("v1 stream: sequential ", sequential_duration, " us, random ", random_duration, " us");
+
+    remove(TEMP_FILE);
+}
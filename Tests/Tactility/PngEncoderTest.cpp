@@ -0,0 +1,300 @@
+#include "doctest.h"
+#include <Tactility/Crc32.h>
+#include <Tactility/file/PngEncoder.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Mutex.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace tt;
+
+static uint32_t readUint32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+}
+
+/** Reads deflate data: bits start with the least significant bit */
+class BitReader {
+
+    const std::vector<uint8_t>& data;
+    size_t bitPosition = 0;
+
+public:
+
+    explicit BitReader(const std::vector<uint8_t>& data) : data(data) {}
+
+    uint32_t readBits(uint32_t count) {
+        uint32_t result = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            auto byte = data.at(bitPosition / 8);
+            result |= ((byte >> (bitPosition % 8)) & 1U) << i;
+            bitPosition++;
+        }
+        return result;
+    }
+
+    /** Huffman codes start with the most significant bit */
+    uint32_t readCode(uint32_t count) {
+        uint32_t result = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            result = (result << 1) | readBits(1);
+        }
+        return result;
+    }
+
+    size_t getBytePosition() const { return (bitPosition + 7) / 8; }
+};
+
+/** Decodes a fixed Huffman literal/length symbol (RFC 1951, 3.2.6) */
+static uint32_t readFixedSymbol(BitReader& reader) {
+    auto code = reader.readCode(7);
+    if (code <= 0x17) {
+        return 256 + code;
+    }
+    code = (code << 1) | reader.readBits(1);
+    if (code >= 0x30 && code <= 0xBF) {
+        return code - 0x30;
+    } else if (code >= 0xC0 && code <= 0xC7) {
+        return 280 + code - 0xC0;
+    }
+    code = (code << 1) | reader.readBits(1);
+    REQUIRE(code >= 0x190);
+    return 144 + code - 0x190;
+}
+
+/** A minimal zlib decoder that supports blocks with fixed Huffman codes */
+static std::vector<uint8_t> inflateFixed(const std::vector<uint8_t>& data) {
+    constexpr uint32_t base_lengths[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    constexpr uint32_t length_extra_bits[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    constexpr uint32_t base_distances[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    constexpr uint32_t distance_extra_bits[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+    REQUIRE_GE(data.size(), 6);
+    REQUIRE_EQ(data[0] & 0x0F, 8);
+    REQUIRE_EQ(((data[0] << 8) | data[1]) % 31, 0);
+
+    std::vector<uint8_t> output;
+    std::vector<uint8_t> stream(data.begin() + 2, data.end());
+    BitReader reader(stream);
+    bool is_final = false;
+    while (!is_final) {
+        is_final = reader.readBits(1) == 1;
+        REQUIRE_EQ(reader.readBits(2), 1);
+        while (true) {
+            auto symbol = readFixedSymbol(reader);
+            if (symbol < 256) {
+                output.push_back(static_cast<uint8_t>(symbol));
+            } else if (symbol == 256) {
+                break;
+            } else {
+                auto index = symbol - 257;
+                REQUIRE_LT(index, std::size(base_lengths));
+                auto length = base_lengths[index] + reader.readBits(length_extra_bits[index]);
+                auto distance_code = reader.readCode(5);
+                REQUIRE_LT(distance_code, std::size(base_distances));
+                auto distance = base_distances[distance_code] + reader.readBits(distance_extra_bits[distance_code]);
+                REQUIRE_LE(distance, output.size());
+                for (uint32_t i = 0; i < length; i++) {
+                    output.push_back(output[output.size() - distance]);
+                }
+            }
+        }
+    }
+
+    auto adler_position = 2 + reader.getBytePosition();
+    REQUIRE_EQ(adler_position + 4, data.size());
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (auto value : output) {
+        a = (a + value) % 65521;
+        b = (b + a) % 65521;
+    }
+    CHECK_EQ(readUint32(data.data() + adler_position), (b << 16) | a);
+    return output;
+}
+
+/** Decodes a PNG that was written by PngEncoder and returns the RGB pixels */
+static std::vector<uint8_t> decodePng(const std::vector<uint8_t>& png, uint32_t expectedWidth, uint32_t expectedHeight) {
+    REQUIRE_GT(png.size(), 8);
+    REQUIRE_EQ(memcmp(png.data(), "\x89PNG\r\n\x1A\n", 8), 0);
+
+    std::vector<uint8_t> compressed;
+    std::vector<std::string> chunk_types;
+    size_t offset = 8;
+    while (offset < png.size()) {
+        REQUIRE_LE(offset + 12, png.size());
+        auto size = readUint32(png.data() + offset);
+        REQUIRE_LE(offset + 12 + size, png.size());
+        std::string type(reinterpret_cast<const char*>(png.data() + offset + 4), 4);
+        const auto* chunk_data = png.data() + offset + 8;
+        auto crc = crc32(png.data() + offset + 4, 4 + size);
+        CHECK_EQ(readUint32(chunk_data + size), crc);
+        if (type == "IHDR") {
+            REQUIRE_EQ(size, 13);
+            CHECK_EQ(readUint32(chunk_data), expectedWidth);
+            CHECK_EQ(readUint32(chunk_data + 4), expectedHeight);
+            CHECK_EQ(chunk_data[8], 8);
+            CHECK_EQ(chunk_data[9], 2);
+        } else if (type == "IDAT") {
+            CHECK_LE(size, file::PngEncoder::chunkCapacity);
+            compressed.insert(compressed.end(), chunk_data, chunk_data + size);
+        }
+        chunk_types.push_back(type);
+        offset += 12 + size;
+    }
+    REQUIRE_GE(chunk_types.size(), 3);
+    CHECK_EQ(chunk_types.front(), "IHDR");
+    CHECK_EQ(chunk_types.back(), "IEND");
+
+    auto filtered = inflateFixed(compressed);
+    const size_t row_size = expectedWidth * 3;
+    REQUIRE_EQ(filtered.size(), (row_size + 1) * expectedHeight);
+
+    std::vector<uint8_t> pixels(row_size * expectedHeight);
+    for (uint32_t y = 0; y < expectedHeight; y++) {
+        auto filter = filtered[y * (row_size + 1)];
+        const auto* source = filtered.data() + y * (row_size + 1) + 1;
+        auto* row = pixels.data() + y * row_size;
+        for (size_t x = 0; x < row_size; x++) {
+            uint8_t left = (x >= 3) ? row[x - 3] : 0;
+            uint8_t up = (y > 0) ? row[x - row_size] : 0;
+            if (filter == 0) {
+                row[x] = source[x];
+            } else if (filter == 1) {
+                row[x] = source[x] + left;
+            } else if (filter == 2) {
+                row[x] = source[x] + up;
+            } else {
+                FAIL("unexpected filter ", static_cast<int>(filter));
+            }
+        }
+    }
+    return pixels;
+}
+
+/** Something that looks like a user interface: a toolbar, flat areas, text-like details and a gradient */
+static std::vector<uint8_t> createUiImage(uint32_t width, uint32_t height) {
+    std::vector<uint8_t> pixels(width * height * 3);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            auto* pixel = pixels.data() + (y * width + x) * 3;
+            if (y < 20) {
+                pixel[0] = 0x20; pixel[1] = 0x40; pixel[2] = 0x80;
+            } else if ((y % 24) > 6 && (y % 24) < 16 && (x % 7) < 3 && x > 10 && x < width / 2) {
+                pixel[0] = pixel[1] = pixel[2] = 0xFF;
+            } else if (y > height - 30) {
+                pixel[0] = static_cast<uint8_t>(x * 255 / width);
+                pixel[1] = 0x30;
+                pixel[2] = static_cast<uint8_t>(y);
+            } else {
+                pixel[0] = pixel[1] = pixel[2] = 0x10;
+            }
+        }
+    }
+    return pixels;
+}
+
+static std::vector<uint8_t> createNoiseImage(uint32_t width, uint32_t height) {
+    std::vector<uint8_t> pixels(width * height * 3);
+    uint32_t state = 0x12345678U;
+    for (auto& value : pixels) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        value = static_cast<uint8_t>(state);
+    }
+    return pixels;
+}
+
+static std::vector<uint8_t> encode(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height) {
+    std::vector<uint8_t> png;
+    file::PngEncoder encoder(width, height, [&png](const uint8_t* data, size_t size) {
+        png.insert(png.end(), data, data + size);
+        return true;
+    });
+    for (uint32_t y = 0; y < height; y++) {
+        CHECK(encoder.writeRow(pixels.data() + y * width * 3));
+    }
+    CHECK(encoder.finish());
+    CHECK_EQ(encoder.getBytesWritten(), png.size());
+    return png;
+}
+
+TEST_CASE("encoded PNG images decode to the original pixels") {
+    SUBCASE("user interface") {
+        auto pixels = createUiImage(320, 240);
+        auto png = encode(pixels, 320, 240);
+        CHECK_EQ(decodePng(png, 320, 240), pixels);
+        // Flat areas compress well
+        CHECK_LT(png.size(), pixels.size() / 10);
+    }
+
+    SUBCASE("noise") {
+        auto pixels = createNoiseImage(97, 31);
+        auto png = encode(pixels, 97, 31);
+        CHECK_EQ(decodePng(png, 97, 31), pixels);
+    }
+
+    SUBCASE("single pixel") {
+        std::vector<uint8_t> pixels = { 1, 2, 3 };
+        CHECK_EQ(decodePng(encode(pixels, 1, 1), 1, 1), pixels);
+    }
+
+    SUBCASE("long runs") {
+        std::vector<uint8_t> pixels(1000 * 3 * 3, 0xAB);
+        CHECK_EQ(decodePng(encode(pixels, 1000, 3), 1000, 3), pixels);
+    }
+}
+
+TEST_CASE("the PNG encoder stops when the writer fails") {
+    int write_count = 0;
+    file::PngEncoder encoder(16, 2, [&write_count](const uint8_t* data, size_t size) {
+        return ++write_count < 3;
+    });
+    CHECK(encoder.hasFailed());
+    std::vector<uint8_t> row(16 * 3);
+    CHECK_FALSE(encoder.writeRow(row.data()));
+    CHECK_FALSE(encoder.finish());
+}
+
+TEST_CASE("the PNG encoder requires all rows") {
+    file::PngEncoder encoder(4, 2, [](const uint8_t* data, size_t size) { return true; });
+    std::vector<uint8_t> row(4 * 3);
+    CHECK(encoder.writeRow(row.data()));
+    CHECK_FALSE(encoder.finish());
+}
+
+/**
+ * Compares the LVGL lock hold time of the old screenshot path (the lock was held while the frame was converted and encoded)
+ * with the new one (the lock is only held to take the frame), using a mutex in place of the LVGL lock.
+ */
+TEST_CASE("screenshot benchmark: lock hold time and encoding speed") {
+    constexpr uint32_t width = 320;
+    constexpr uint32_t height = 240;
+    constexpr int repeat_count = 10;
+    auto frame = createUiImage(width, height);
+    Mutex lvgl_mutex;
+
+    int64_t capture_duration = 0;
+    int64_t encode_duration = 0;
+    size_t png_size = 0;
+    for (int i = 0; i < repeat_count; i++) {
+        auto start_time = kernel::getMicros();
+        lvgl_mutex.lock();
+        std::vector<uint8_t> captured(frame);
+        lvgl_mutex.unlock();
+        auto captured_time = kernel::getMicros();
+        png_size = encode(captured, width, height).size();
+        capture_duration += captured_time - start_time;
+        encode_duration += kernel::getMicros() - captured_time;
+    }
+
+    auto lock_micros = static_cast<double>(capture_duration) / repeat_count;
+    auto encode_micros = static_cast<double>(encode_duration) / repeat_count;
+    auto megabytes_per_second = static_cast<double>(frame.size()) / encode_micros;
+    MESSAGE("lock hold time when encoding under the lock: ", (lock_micros + encode_micros) / 1000.0, " ms");
+    MESSAGE("lock hold time when only capturing under the lock: ", lock_micros / 1000.0, " ms");
+    MESSAGE("encoding: ", megabytes_per_second, " MB/s, ", frame.size(), " bytes to ", png_size, " bytes");
+    CHECK_LT(png_size, frame.size());
+}
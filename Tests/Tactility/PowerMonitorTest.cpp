@@ -0,0 +1,200 @@
+#include "doctest.h"
+#include <Tactility/hal/power/SimulatedPowerDevice.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/service/power/PowerMonitor.h>
+
+using namespace tt;
+using hal::power::SimulatedPowerDevice;
+using service::power::PowerMonitor;
+using service::power::PowerSnapshot;
+
+/** Registers a device for the duration of a test */
+class PowerDeviceRegistration {
+
+    std::shared_ptr<SimulatedPowerDevice> device;
+
+public:
+
+    explicit PowerDeviceRegistration(std::shared_ptr<SimulatedPowerDevice> inDevice) : device(std::move(inDevice)) {
+        hal::registerDevice(device);
+    }
+
+    ~PowerDeviceRegistration() {
+        hal::deregisterDevice(device);
+    }
+};
+
+/** Updates the monitor as if time passes, until all devices were sampled the specified amount of times */
+static TickType_t sampleRepeatedly(PowerMonitor& monitor, TickType_t now, int count) {
+    for (int i = 0; i < count; i++) {
+        now += monitor.update(now);
+    }
+    return now;
+}
+
+TEST_CASE("the charge level follows the discharge curve") {
+    CHECK_EQ(service::power::getChargeLevelFromVoltage(4300), 100);
+    CHECK_EQ(service::power::getChargeLevelFromVoltage(4200), 100);
+    CHECK_EQ(service::power::getChargeLevelFromVoltage(3840), 50);
+    CHECK_EQ(service::power::getChargeLevelFromVoltage(3890), 63);
+    CHECK_EQ(service::power::getChargeLevelFromVoltage(3270), 0);
+    CHECK_EQ(service::power::getChargeLevelFromVoltage(3000), 0);
+
+    uint8_t previous = 0;
+    for (uint32_t voltage = 3000; voltage <= 4300; voltage += 5) {
+        auto charge_level = service::power::getChargeLevelFromVoltage(voltage);
+        CHECK_GE(charge_level, previous);
+        previous = charge_level;
+    }
+}
+
+TEST_CASE("the voltage filter removes spikes and noise") {
+    service::power::VoltageFilter filter;
+    CHECK(filter.isEmpty());
+    CHECK_EQ(filter.add(3900), 3900);
+    CHECK_EQ(filter.add(3900), 3900);
+    // A single spike is removed by the median
+    CHECK_EQ(filter.add(4500), 3900);
+    CHECK_EQ(filter.add(3900), 3900);
+
+    // A lasting change is followed gradually
+    uint32_t filtered = 0;
+    for (int i = 0; i < 3; i++) {
+        filtered = filter.add(3800);
+    }
+    CHECK_LT(filtered, 3900);
+    CHECK_GT(filtered, 3800);
+    for (int i = 0; i < 30; i++) {
+        filtered = filter.add(3800);
+    }
+    CHECK_EQ(filtered, 3800);
+
+    filter.reset();
+    CHECK(filter.isEmpty());
+    CHECK_EQ(filter.add(4100), 4100);
+}
+
+TEST_CASE("snapshots are filtered and don't access the device") {
+    auto device = std::make_shared<SimulatedPowerDevice>(SimulatedPowerDevice::Configuration {
+        .batteryVoltage = 3840,
+        .noise = 40
+    });
+    PowerDeviceRegistration registration(device);
+    PowerMonitor monitor;
+    CHECK_EQ(monitor.getSnapshot(), nullptr);
+
+    TickType_t now = 1000;
+    auto wait_ticks = monitor.update(now);
+    CHECK_EQ(wait_ticks, kernel::millisToTicks(PowerMonitor::Configuration().estimatedSampleIntervalMillis));
+    // The charge level is derived from the voltage, so it isn't measured separately
+    CHECK_EQ(device->getMeasurementCount(), 3);
+
+    // The device isn't sampled again before it's due
+    monitor.update(now + 1);
+    CHECK_EQ(device->getMeasurementCount(), 3);
+
+    now = sampleRepeatedly(monitor, now + wait_ticks, 50);
+    auto measurement_count = device->getMeasurementCount();
+    CHECK_EQ(measurement_count, 3 * 51);
+
+    auto snapshot = monitor.getSnapshot();
+    REQUIRE_NE(snapshot, nullptr);
+    CHECK_EQ(snapshot->device, device);
+    CHECK_EQ(snapshot->isCharging, false);
+    CHECK_EQ(snapshot->current, -120);
+    REQUIRE(snapshot->batteryVoltage.has_value());
+    CHECK_LE(std::abs(static_cast<int32_t>(*snapshot->batteryVoltage) - 3840), 10);
+    REQUIRE(snapshot->chargeLevel.has_value());
+    CHECK_GE(*snapshot->chargeLevel, 48);
+    CHECK_LE(*snapshot->chargeLevel, 52);
+
+    for (int i = 0; i < 100; i++) {
+        CHECK_NE(monitor.getSnapshot(), nullptr);
+        CHECK_EQ(monitor.getSnapshots()->size(), 1);
+    }
+    CHECK_EQ(device->getMeasurementCount(), measurement_count);
+
+    // A requested sample happens right away
+    monitor.requestSample();
+    monitor.update(now + 1);
+    CHECK_EQ(device->getMeasurementCount(), measurement_count + 3);
+}
+
+TEST_CASE("subscribers are only notified of significant changes") {
+    auto device = std::make_shared<SimulatedPowerDevice>(SimulatedPowerDevice::Configuration {
+        .batteryVoltage = 3900 // 64%
+    });
+    PowerDeviceRegistration registration(device);
+    PowerMonitor monitor;
+
+    std::vector<PowerSnapshot> notifications;
+    auto subscription = monitor.getPubsub()->subscribe([&notifications](const auto& snapshot) {
+        notifications.push_back(snapshot);
+    });
+
+    TickType_t now = sampleRepeatedly(monitor, 0, 10);
+    REQUIRE_EQ(notifications.size(), 1);
+    CHECK_EQ(notifications[0].chargeLevel, 64);
+
+    // 63%: within the same band
+    device->setBatteryVoltage(3890);
+    now = sampleRepeatedly(monitor, now, 30);
+    CHECK_EQ(monitor.getSnapshot()->chargeLevel, 63);
+    CHECK_EQ(notifications.size(), 1);
+
+    // 68%: crosses 65%
+    device->setBatteryVoltage(3930);
+    now = sampleRepeatedly(monitor, now, 30);
+    REQUIRE_EQ(notifications.size(), 2);
+    CHECK_GE(*notifications[1].chargeLevel, 66);
+
+    // 64%: back below 65%, but within the hysteresis
+    device->setBatteryVoltage(3905);
+    now = sampleRepeatedly(monitor, now, 30);
+    CHECK_EQ(monitor.getSnapshot()->chargeLevel, 64);
+    CHECK_EQ(notifications.size(), 2);
+
+    // 63%: beyond the hysteresis
+    device->setBatteryVoltage(3890);
+    now = sampleRepeatedly(monitor, now, 30);
+    REQUIRE_EQ(notifications.size(), 3);
+    CHECK_EQ(notifications[2].chargeLevel, 63);
+
+    // Charging is always notified
+    device->setExternalPowerConnected(true);
+    now = sampleRepeatedly(monitor, now, 1);
+    REQUIRE_EQ(notifications.size(), 4);
+    CHECK_EQ(notifications[3].isCharging, true);
+
+    device->setAllowedToCharge(false);
+    monitor.requestSample();
+    monitor.update(now + 1);
+    REQUIRE_EQ(notifications.size(), 5);
+    CHECK_EQ(notifications[4].isCharging, false);
+
+    monitor.getPubsub()->unsubscribe(subscription);
+}
+
+TEST_CASE("the monitor follows device registrations") {
+    PowerMonitor monitor;
+    std::vector<PowerSnapshot> notifications;
+    auto subscription = monitor.getPubsub()->subscribe([&notifications](const auto& snapshot) {
+        notifications.push_back(snapshot);
+    });
+
+    auto device = std::make_shared<SimulatedPowerDevice>();
+    {
+        PowerDeviceRegistration registration(device);
+        monitor.update(0);
+        REQUIRE_EQ(notifications.size(), 1);
+        CHECK_EQ(notifications[0].device, device);
+    }
+
+    CHECK_EQ(monitor.update(1), portMAX_DELAY);
+    CHECK_EQ(monitor.getSnapshot(), nullptr);
+    REQUIRE_EQ(notifications.size(), 2);
+    CHECK_EQ(notifications[1].device, nullptr);
+    CHECK_FALSE(notifications[1].chargeLevel.has_value());
+
+    monitor.getPubsub()->unsubscribe(subscription);
+}
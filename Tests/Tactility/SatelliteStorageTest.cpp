@@ -0,0 +1,72 @@
+#include "doctest.h"
+#include <Tactility/hal/gps/Satellites.h>
+
+#include <array>
+
+using namespace tt::hal::gps;
+
+static minmea_sat_info createInfo(int number, int snr = 30) {
+    return { .nr = number, .elevation = 45, .azimuth = 90, .snr = snr };
+}
+
+TEST_CASE("SatelliteStorage keys satellites by constellation and PRN") {
+    SatelliteStorage storage;
+    storage.notify(Constellation::Gps, createInfo(5, 10));
+    storage.notify(Constellation::Galileo, createInfo(5, 20));
+    storage.notify(Constellation::Gps, createInfo(5, 15));
+
+    std::array<Satellite, SatelliteStorage::recordCount> snapshot;
+    auto count = storage.getSnapshot(snapshot);
+    REQUIRE_EQ(count, 2);
+    // Most recently updated first
+    CHECK_EQ(snapshot[0].constellation, Constellation::Gps);
+    CHECK_EQ(snapshot[0].info.snr, 15);
+    CHECK_EQ(snapshot[1].constellation, Constellation::Galileo);
+    CHECK_EQ(snapshot[1].info.snr, 20);
+}
+
+TEST_CASE("SatelliteStorage recycles the least recently updated satellite") {
+    SatelliteStorage storage;
+    for (int i = 1; i <= SatelliteStorage::recordCount; i++) {
+        storage.notify(Constellation::BeiDou, createInfo(i));
+    }
+    // Refresh the first satellite, so the second one becomes the oldest
+    storage.notify(Constellation::BeiDou, createInfo(1));
+    storage.notify(Constellation::Glonass, createInfo(1));
+
+    std::array<Satellite, SatelliteStorage::recordCount> snapshot;
+    auto count = storage.getSnapshot(snapshot);
+    REQUIRE_EQ(count, SatelliteStorage::recordCount);
+    bool found_first = false;
+    for (size_t i = 0; i < count; i++) {
+        CHECK_FALSE((snapshot[i].constellation == Constellation::BeiDou && snapshot[i].info.nr == 2));
+        found_first |= (snapshot[i].constellation == Constellation::BeiDou && snapshot[i].info.nr == 1);
+    }
+    CHECK(found_first);
+}
+
+TEST_CASE("SatelliteStorage stores all satellites of a GSV sentence") {
+    SatelliteStorage storage;
+    minmea_sentence_gsv gsv = {
+        .total_msgs = 3,
+        .msg_nr = 3,
+        .total_sats = 11,
+        .sats = { createInfo(29), createInfo(16), createInfo(36), { 0, 0, 0, 0 } }
+    };
+    storage.notify(toConstellation("GL"), gsv);
+
+    int count = 0;
+    storage.getRecords([&count](const minmea_sat_info& info) {
+        CHECK_NE(info.nr, 0);
+        count++;
+    });
+    CHECK_EQ(count, 3);
+}
+
+TEST_CASE("toConstellation maps talker IDs") {
+    CHECK_EQ(toConstellation("GP"), Constellation::Gps);
+    CHECK_EQ(toConstellation("GL"), Constellation::Glonass);
+    CHECK_EQ(toConstellation("GA"), Constellation::Galileo);
+    CHECK_EQ(toConstellation("BD"), Constellation::BeiDou);
+    CHECK_EQ(toConstellation("GN"), Constellation::Unknown);
+}
@@ -0,0 +1,539 @@
+#include "doctest.h"
+
+#include <Tactility/Crc32.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/service/development/ScreenStreamServer.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace tt;
+using namespace tt::service::development;
+using namespace tt::service::development::screenstream;
+using Area = ScreenBuffer::Area;
+
+// region Test client
+
+/** Decodes a rect payload and verifies it against its CRC: this is what a client does */
+static bool decodeRect(const uint8_t* header, const uint8_t* payload, std::vector<uint16_t>& target, uint16_t targetWidth) {
+    const uint16_t x = readUint16(header);
+    const uint16_t y = readUint16(header + 2);
+    const uint16_t width = readUint16(header + 4);
+    const uint16_t height = readUint16(header + 6);
+    const auto encoding = static_cast<Encoding>(header[8]);
+    const uint32_t expected_crc = readUint32(header + 9);
+    const uint32_t payload_size = readUint32(header + 13);
+
+    std::vector<uint16_t> pixels;
+    pixels.reserve(width * height);
+    if (encoding == Encoding::Raw) {
+        for (uint32_t offset = 0; offset + 1 < payload_size; offset += 2) {
+            pixels.push_back(readUint16(payload + offset));
+        }
+    } else if (encoding == Encoding::Rle) {
+        uint32_t offset = 0;
+        while (offset < payload_size) {
+            const uint8_t control = payload[offset++];
+            if (control < 0x80) {
+                for (int i = 0; i <= control; i++) {
+                    pixels.push_back(readUint16(payload + offset));
+                    offset += 2;
+                }
+            } else {
+                const uint16_t pixel = readUint16(payload + offset);
+                offset += 2;
+                pixels.insert(pixels.end(), control - 0x80 + 2, pixel);
+            }
+        }
+    } else {
+        return false;
+    }
+
+    if (pixels.size() != static_cast<size_t>(width) * height || crc32(pixels.data(), pixels.size() * sizeof(uint16_t)) != expected_crc) {
+        return false;
+    }
+
+    for (uint16_t row = 0; row < height; row++) {
+        std::memcpy(&target[(y + row) * targetWidth + x], &pixels[row * width], width * sizeof(uint16_t));
+    }
+    return true;
+}
+
+class TestClient {
+
+    int socket = -1;
+
+    bool readExactly(uint8_t* data, size_t size) {
+        const auto start_time = kernel::getTicks();
+        while (size > 0) {
+            const auto received = recv(socket, data, size, 0);
+            if (received > 0) {
+                data += received;
+                size -= received;
+            } else if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && kernel::getTicks() - start_time < kernel::millisToTicks(5000)) {
+                kernel::delayTicks(1);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool sendMessage(const std::vector<uint8_t>& message) {
+        return send(socket, message.data(), message.size(), 0) == static_cast<ssize_t>(message.size());
+    }
+
+public:
+
+    struct Frame {
+        uint32_t sequence = 0;
+        uint32_t delay = 0;
+        uint32_t inputSequence = 0;
+        uint16_t rectCount = 0;
+        size_t size = 0;
+    };
+
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint16_t maxFramesPerSecond = 0;
+    uint32_t maxBytesPerSecond = 0;
+    std::vector<uint16_t> pixels;
+    size_t corruptRectCount = 0;
+
+    ~TestClient() {
+        if (socket >= 0) {
+            close(socket);
+        }
+    }
+
+    bool connect(uint16_t port) {
+        socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        if (::connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            return false;
+        }
+        return fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK) == 0;
+    }
+
+    /** Reads messages until a frame arrives */
+    bool readFrame(Frame& frame) {
+        uint8_t type;
+        if (!readExactly(&type, 1)) {
+            return false;
+        }
+
+        if (type == static_cast<uint8_t>(MessageType::Hello)) {
+            uint8_t hello[HELLO_SIZE - 1];
+            if (!readExactly(hello, sizeof(hello)) || hello[0] != PROTOCOL_VERSION || hello[5] != static_cast<uint8_t>(PixelFormat::RGB565)) {
+                return false;
+            }
+            width = readUint16(hello + 1);
+            height = readUint16(hello + 3);
+            maxFramesPerSecond = readUint16(hello + 6);
+            maxBytesPerSecond = readUint32(hello + 8);
+            pixels.assign(width * height, 0);
+            return readFrame(frame);
+        }
+
+        uint8_t header[FRAME_HEADER_SIZE - 1];
+        if (type != static_cast<uint8_t>(MessageType::Frame) || !readExactly(header, sizeof(header))) {
+            return false;
+        }
+        frame.sequence = readUint32(header);
+        frame.delay = readUint32(header + 4);
+        frame.inputSequence = readUint32(header + 8);
+        frame.rectCount = readUint16(header + 12);
+        frame.size = FRAME_HEADER_SIZE;
+
+        for (uint16_t i = 0; i < frame.rectCount; i++) {
+            uint8_t rect_header[RECT_HEADER_SIZE];
+            if (!readExactly(rect_header, sizeof(rect_header))) {
+                return false;
+            }
+            std::vector<uint8_t> payload(readUint32(rect_header + 13));
+            if (!readExactly(payload.data(), payload.size())) {
+                return false;
+            }
+            if (!decodeRect(rect_header, payload.data(), pixels, width)) {
+                corruptRectCount++;
+            }
+            frame.size += sizeof(rect_header) + payload.size();
+        }
+        return true;
+    }
+
+    bool sendPointer(uint32_t sequence, int16_t x, int16_t y, bool pressed) {
+        std::vector<uint8_t> message = { static_cast<uint8_t>(MessageType::Pointer) };
+        appendUint32(message, sequence);
+        appendUint16(message, x);
+        appendUint16(message, y);
+        message.push_back(pressed ? 1 : 0);
+        return sendMessage(message);
+    }
+
+    bool sendKey(uint32_t sequence, uint32_t key, bool pressed) {
+        std::vector<uint8_t> message = { static_cast<uint8_t>(MessageType::Key) };
+        appendUint32(message, sequence);
+        appendUint32(message, key);
+        message.push_back(pressed ? 1 : 0);
+        return sendMessage(message);
+    }
+
+    bool sendConfigure(uint16_t framesPerSecond, uint32_t bytesPerSecond) {
+        std::vector<uint8_t> message = { static_cast<uint8_t>(MessageType::Configure) };
+        appendUint16(message, framesPerSecond);
+        appendUint32(message, bytesPerSecond);
+        return sendMessage(message);
+    }
+
+    bool sendRefresh() {
+        return sendMessage({ static_cast<uint8_t>(MessageType::Refresh) });
+    }
+};
+
+// endregion
+
+// region Test source
+
+/** A screen that draws a square where it's touched, like a UI would redraw after input */
+class TestScreenSource final : public ScreenSource {
+
+public:
+
+    static constexpr uint16_t WIDTH = 160;
+    static constexpr uint16_t HEIGHT = 120;
+
+    Mutex mutex = Mutex(Mutex::Type::Recursive);
+    std::shared_ptr<ScreenBuffer> buffer;
+    std::vector<uint16_t> screen = std::vector<uint16_t>(WIDTH * HEIGHT);
+    std::vector<uint32_t> keys;
+    uint32_t noiseState = 0x12345678;
+
+    void draw(const Area& area, uint16_t color) {
+        for (uint16_t y = area.y; y < area.y + area.height; y++) {
+            std::fill_n(&screen[y * WIDTH + area.x], area.width, color);
+        }
+        flush(area);
+    }
+
+    void drawNoise(const Area& area) {
+        for (uint16_t y = area.y; y < area.y + area.height; y++) {
+            for (uint16_t x = area.x; x < area.x + area.width; x++) {
+                noiseState ^= noiseState << 13;
+                noiseState ^= noiseState >> 17;
+                noiseState ^= noiseState << 5;
+                screen[y * WIDTH + x] = noiseState;
+            }
+        }
+        flush(area);
+    }
+
+    void flush(const Area& area) {
+        if (buffer != nullptr) {
+            buffer->write(area, reinterpret_cast<const uint8_t*>(&screen[area.y * WIDTH + area.x]), WIDTH * sizeof(uint16_t), ScreenBuffer::PixelFormat::RGB565);
+        }
+    }
+
+    bool start(std::shared_ptr<ScreenBuffer> newBuffer) override {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        buffer = std::move(newBuffer);
+        buffer->setSize(WIDTH, HEIGHT);
+        draw({ .x = 0, .y = 0, .width = WIDTH, .height = 40 }, 0x001F);
+        draw({ .x = 0, .y = 40, .width = WIDTH, .height = 80 }, 0xFFFF);
+        drawNoise({ .x = 10, .y = 50, .width = 30, .height = 20 });
+        return true;
+    }
+
+    void stop() override {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        buffer = nullptr;
+    }
+
+    void refresh() override {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        flush({ .x = 0, .y = 0, .width = WIDTH, .height = HEIGHT });
+    }
+
+    void injectPointer(uint32_t sequence, int16_t x, int16_t y, bool pressed) override {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        if (buffer != nullptr) {
+            buffer->setConsumedInputSequence(sequence);
+            if (pressed) {
+                draw({ .x = static_cast<uint16_t>(x), .y = static_cast<uint16_t>(y), .width = 8, .height = 8 }, sequence * 0x0841);
+            }
+        }
+    }
+
+    void injectKey(uint32_t sequence, uint32_t key, bool pressed) override {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        if (pressed) {
+            keys.push_back(key);
+        }
+    }
+
+    std::vector<uint16_t> getScreen() {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        return screen;
+    }
+};
+
+// endregion
+
+static std::vector<uint16_t> decodeAll(const std::vector<uint8_t>& rect, uint16_t width, uint16_t height) {
+    std::vector<uint16_t> pixels(width * height);
+    CHECK(decodeRect(rect.data(), rect.data() + RECT_HEADER_SIZE, pixels, width));
+    return pixels;
+}
+
+TEST_CASE("rects are run-length encoded unless raw pixels are smaller") {
+    constexpr uint16_t width = 50;
+    constexpr uint16_t height = 4;
+    std::vector<uint16_t> pixels(width * height, 0xF800);
+    // Row 1: literals and short runs, row 2: a run longer than a packet, row 3: a run across the row boundary
+    for (uint16_t x = 0; x < width; x++) {
+        pixels[width + x] = (x % 7 < 2) ? 0x1234 : x;
+    }
+    std::fill_n(&pixels[2 * width + 10], 40, 0x07E0);
+
+    std::vector<uint8_t> rect;
+    appendRect(rect, 0, 0, pixels.data(), width, height, width);
+    CHECK_EQ(rect[8], static_cast<uint8_t>(Encoding::Rle));
+    CHECK_LT(rect.size() - RECT_HEADER_SIZE, width * height);
+    CHECK_EQ(decodeAll(rect, width, height), pixels);
+
+    // A sub-area, using the stride
+    rect.clear();
+    appendRect(rect, 5, 1, &pixels[width + 5], 20, 2, width);
+    CHECK_EQ(readUint16(rect.data()), 5);
+    CHECK_EQ(readUint16(rect.data() + 2), 1);
+    std::vector<uint16_t> decoded(width * height);
+    CHECK(decodeRect(rect.data(), rect.data() + RECT_HEADER_SIZE, decoded, width));
+    for (uint16_t y = 1; y < 3; y++) {
+        for (uint16_t x = 5; x < 25; x++) {
+            CHECK_EQ(decoded[y * width + x], pixels[y * width + x]);
+        }
+    }
+
+    // Noise doesn't compress
+    uint32_t state = 1;
+    for (auto& pixel : pixels) {
+        state = state * 1103515245 + 12345;
+        pixel = state >> 16;
+    }
+    rect.clear();
+    appendRect(rect, 0, 0, pixels.data(), width, height, width);
+    CHECK_EQ(rect[8], static_cast<uint8_t>(Encoding::Raw));
+    CHECK_EQ(rect.size(), RECT_HEADER_SIZE + width * height * 2);
+    CHECK_EQ(decodeAll(rect, width, height), pixels);
+
+    // A corrupted payload is detected
+    rect[RECT_HEADER_SIZE + 10] ^= 0x01;
+    CHECK_FALSE(decodeRect(rect.data(), rect.data() + RECT_HEADER_SIZE, decoded, width));
+}
+
+TEST_CASE("the screen buffer merges changed areas") {
+    ScreenBuffer buffer;
+    REQUIRE(buffer.setSize(100, 80));
+    CHECK_FALSE(buffer.hasChanges());
+
+    const std::vector<uint16_t> pixels(100 * 80, 0xFFFF);
+    const auto* data = reinterpret_cast<const uint8_t*>(pixels.data());
+
+    // Bands of the same area, as a display driver flushes them
+    buffer.write({ .x = 10, .y = 10, .width = 50, .height = 10 }, data, 100, ScreenBuffer::PixelFormat::RGB565);
+    buffer.write({ .x = 10, .y = 20, .width = 50, .height = 10 }, data, 100, ScreenBuffer::PixelFormat::RGB565);
+    // Contained in the above
+    buffer.write({ .x = 20, .y = 15, .width = 5, .height = 5 }, data, 100, ScreenBuffer::PixelFormat::RGB565);
+    // Separate
+    buffer.write({ .x = 90, .y = 70, .width = 5, .height = 5 }, data, 100, ScreenBuffer::PixelFormat::RGB565);
+
+    ScreenBuffer::Changes changes;
+    REQUIRE(buffer.takeChanges(changes));
+    REQUIRE_EQ(changes.areas.size(), 2);
+    CHECK_EQ(changes.areas[0].x, 10);
+    CHECK_EQ(changes.areas[0].y, 10);
+    CHECK_EQ(changes.areas[0].width, 50);
+    CHECK_EQ(changes.areas[0].height, 20);
+    CHECK_EQ(changes.areas[1].getSize(), 25);
+    CHECK_FALSE(buffer.hasChanges());
+    CHECK_FALSE(buffer.takeChanges(changes));
+
+    // Many separate areas are merged, but all of them stay covered
+    std::vector<Area> written;
+    for (uint16_t i = 0; i < 20; i++) {
+        Area area = { .x = static_cast<uint16_t>((i * 37) % 95), .y = static_cast<uint16_t>((i * 23) % 75), .width = 3, .height = 3 };
+        buffer.write(area, data, 100, ScreenBuffer::PixelFormat::RGB565);
+        written.push_back(area);
+    }
+    REQUIRE(buffer.takeChanges(changes));
+    CHECK_LE(changes.areas.size(), ScreenBuffer::MAX_DIRTY_AREAS);
+    for (const auto& area : written) {
+        bool covered = std::ranges::any_of(changes.areas, [&area](const auto& changed) {
+            return area.x >= changed.x && area.y >= changed.y &&
+                area.x + area.width <= changed.x + changed.width &&
+                area.y + area.height <= changed.y + changed.height;
+        });
+        CHECK(covered);
+    }
+}
+
+TEST_CASE("the screen buffer converts colors and clips areas") {
+    ScreenBuffer buffer;
+    REQUIRE(buffer.setSize(4, 2));
+
+    // LVGL stores blue first
+    const uint8_t rgb888[] = { 0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xFF };
+    buffer.write({ .x = 0, .y = 0, .width = 3, .height = 1 }, rgb888, sizeof(rgb888), ScreenBuffer::PixelFormat::RGB888);
+    const uint8_t xrgb8888[] = { 0xFF, 0xFF, 0xFF, 0x00, 0x08, 0x04, 0x08, 0x00 };
+    // Partially outside of the buffer
+    buffer.write({ .x = 2, .y = 1, .width = 4, .height = 3 }, xrgb8888, 16, ScreenBuffer::PixelFormat::XRGB8888);
+
+    ScreenBuffer::Changes changes;
+    REQUIRE(buffer.takeChanges(changes));
+    REQUIRE_EQ(changes.areas.size(), 2);
+    CHECK_EQ(changes.areas[1].width, 2);
+    CHECK_EQ(changes.areas[1].height, 1);
+
+    std::vector<uint8_t> rect;
+    buffer.encode({ .x = 0, .y = 0, .width = 4, .height = 2 }, rect);
+    CHECK_EQ(decodeAll(rect, 4, 2), std::vector<uint16_t> { 0x001F, 0x07E0, 0xF800, 0x0000, 0x0000, 0x0000, 0xFFFF, 0x0821 });
+
+    // Areas that were taken before a resize are clipped
+    REQUIRE(buffer.setSize(2, 2));
+    rect.clear();
+    buffer.encode({ .x = 1, .y = 0, .width = 4, .height = 2 }, rect);
+    CHECK_EQ(readUint16(rect.data() + 4), 1);
+    CHECK_EQ(readUint16(rect.data() + 6), 2);
+}
+
+TEST_CASE("the screen stream delivers the screen and the result of injected input") {
+    auto source = std::make_shared<TestScreenSource>();
+    ScreenStreamServer server(source, { .address = "127.0.0.1", .port = 0, .maxFramesPerSecond = 60, .maxBandPixels = 1000 });
+    REQUIRE(server.start());
+    REQUIRE_NE(server.getPort(), 0);
+
+    TestClient client;
+    REQUIRE(client.connect(server.getPort()));
+
+    TestClient::Frame frame;
+    REQUIRE(client.readFrame(frame));
+    CHECK_EQ(client.width, TestScreenSource::WIDTH);
+    CHECK_EQ(client.height, TestScreenSource::HEIGHT);
+    CHECK_EQ(client.maxFramesPerSecond, 60);
+    CHECK_EQ(frame.sequence, 1);
+    // The screen is split into bands of at most 1000 pixels
+    CHECK_GE(frame.rectCount, TestScreenSource::WIDTH * TestScreenSource::HEIGHT / 1000);
+    CHECK_EQ(client.pixels, source->getScreen());
+
+    // Measure the time from sending input until receiving the frame that shows its result
+    constexpr uint32_t input_count = 20;
+    int64_t total_latency = 0;
+    int64_t max_latency = 0;
+    for (uint32_t sequence = 1; sequence <= input_count; sequence++) {
+        const auto start_time = kernel::getMicros();
+        REQUIRE(client.sendPointer(sequence, (sequence * 7) % 150, (sequence * 5) % 110, true));
+        REQUIRE(client.sendPointer(sequence, (sequence * 7) % 150, (sequence * 5) % 110, false));
+        do {
+            REQUIRE(client.readFrame(frame));
+        } while (frame.inputSequence < sequence);
+        const auto latency = kernel::getMicros() - start_time;
+        total_latency += latency;
+        max_latency = std::max(max_latency, latency);
+    }
+    MESSAGE("Input to frame latency: ", total_latency / input_count / 1000.0, " ms average, ", max_latency / 1000.0, " ms max");
+
+    CHECK_EQ(client.corruptRectCount, 0);
+    CHECK_EQ(client.pixels, source->getScreen());
+
+    REQUIRE(client.sendKey(21, 'a', true));
+    REQUIRE(client.sendKey(22, 'a', false));
+    REQUIRE(client.sendRefresh());
+    REQUIRE(client.readFrame(frame));
+    CHECK_EQ(frame.rectCount, TestScreenSource::WIDTH * TestScreenSource::HEIGHT / 1000 + 1);
+    CHECK_EQ(source->keys, std::vector<uint32_t> { 'a' });
+    CHECK_EQ(client.pixels, source->getScreen());
+
+    server.stop();
+    CHECK_FALSE(server.isStarted());
+    CHECK_EQ(source->buffer, nullptr);
+}
+
+TEST_CASE("the screen stream is limited by frame rate and bandwidth") {
+    auto source = std::make_shared<TestScreenSource>();
+    ScreenStreamServer server(source, { .address = "127.0.0.1", .port = 0, .maxFramesPerSecond = 50, .maxBytesPerSecond = 1024 * 1024 });
+    REQUIRE(server.start());
+
+    // Keeps changing the screen, much faster than it's streamed
+    std::atomic<bool> animating = true;
+    Thread animation("animation", 4096, [&source, &animating] {
+        while (animating) {
+            {
+                auto lock = source->mutex.asScopedLock();
+                lock.lock();
+                source->drawNoise({ .x = 0, .y = 0, .width = TestScreenSource::WIDTH, .height = 40 });
+            }
+            kernel::delayMillis(2);
+        }
+        return 0;
+    });
+    animation.start();
+
+    TestClient client;
+    REQUIRE(client.connect(server.getPort()));
+    TestClient::Frame frame;
+    REQUIRE(client.readFrame(frame));
+
+    auto measure = [&client, &frame](uint32_t millis, size_t& frameCount, size_t& byteCount) {
+        frameCount = 0;
+        byteCount = 0;
+        const auto start_time = kernel::getMicros();
+        while (kernel::getMicros() - start_time < millis * 1000) {
+            REQUIRE(client.readFrame(frame));
+            frameCount++;
+            byteCount += frame.size;
+        }
+    };
+
+    size_t frame_count;
+    size_t byte_count;
+
+    REQUIRE(client.sendConfigure(10, 0));
+    // Let the frame that was paced by the previous configuration pass
+    REQUIRE(client.readFrame(frame));
+    measure(1000, frame_count, byte_count);
+    MESSAGE("10 fps limit: ", frame_count, " frames, ", byte_count, " bytes in 1 s");
+    CHECK_LE(frame_count, 12);
+    CHECK_GE(frame_count, 5);
+
+    constexpr uint32_t bytes_per_second = 40000;
+    // A band of noise is 12.8 kB raw
+    constexpr size_t max_frame_size = TestScreenSource::WIDTH * 40 * 2 + 1024;
+    REQUIRE(client.sendConfigure(0, bytes_per_second));
+    REQUIRE(client.readFrame(frame));
+    measure(2000, frame_count, byte_count);
+    MESSAGE("40 kB/s limit: ", frame_count, " frames, ", byte_count, " bytes in 2 s");
+    CHECK_LE(byte_count, 2 * bytes_per_second + max_frame_size);
+    CHECK_GE(byte_count, bytes_per_second);
+    CHECK_EQ(client.corruptRectCount, 0);
+
+    animating = false;
+    animation.join();
+    server.stop();
+}
@@ -0,0 +1,379 @@
+#include "doctest.h"
+
+#include <Tactility/Tactility.h>
+#include <Tactility/file/PropertiesFile.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/settings/SettingsStore.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace tt;
+using namespace tt::settings;
+
+constexpr auto* JOURNAL_FILE = "settings_test.journal";
+constexpr auto* COPY_FILE = "settings_test_copy.journal";
+
+static void removeJournal(const char* path) {
+    remove(path);
+    remove((std::string(path) + ".tmp").c_str());
+}
+
+static std::vector<uint8_t> readFileData(const char* path) {
+    std::vector<uint8_t> data;
+    auto* file = fopen(path, "rb");
+    if (file != nullptr) {
+        uint8_t buffer[256];
+        size_t size;
+        while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            data.insert(data.end(), buffer, buffer + size);
+        }
+        fclose(file);
+    }
+    return data;
+}
+
+static void writeFileData(const char* path, const uint8_t* data, size_t size) {
+    auto* file = fopen(path, "wb");
+    REQUIRE(file != nullptr);
+    if (size > 0) {
+        fwrite(data, size, 1, file);
+    }
+    fclose(file);
+}
+
+typedef std::map<std::string, std::string> State;
+
+/** The keys that the fault injection test uses */
+static const std::pair<const char*, const char*> stateKeys[] = {
+    { "display", "orientation" },
+    { "display", "backlightDuty" },
+    { "wifi.ap.home", "password" },
+    { "wifi.ap.home", "autoConnect" },
+    { "system", "language" }
+};
+
+static State getState(SettingsStore& store) {
+    State state;
+    for (const auto& [namespace_name, key] : stateKeys) {
+        auto value = store.get(namespace_name, key);
+        if (value.has_value()) {
+            state[std::string(namespace_name) + "/" + key] = store.getString(namespace_name, key);
+        }
+    }
+    return state;
+}
+
+TEST_CASE("SettingsStore keeps values after reopening") {
+    removeJournal(JOURNAL_FILE);
+
+    {
+        SettingsStore store(JOURNAL_FILE, 0);
+        CHECK(store.open());
+        store.setBool("system", "timeFormat24h", false);
+        store.setInt("display", "backlightDuty", 150);
+        store.setString("display", "orientation", "Portrait");
+        store.set("wifi.ap.home", "password", "secret");
+        store.set("wifi.ap.work", "password", "other");
+        store.set("wifi.ap.work", "channel", 6);
+        store.remove("display", "orientation");
+        CHECK(store.flush());
+        store.removeNamespace("wifi.ap.work");
+        // Destructor flushes
+    }
+
+    SettingsStore store(JOURNAL_FILE, 0);
+    CHECK(store.open());
+    CHECK_EQ(store.getBool("system", "timeFormat24h", true), false);
+    CHECK_EQ(store.getInt("display", "backlightDuty", 0), 150);
+    CHECK_FALSE(store.contains("display", "orientation"));
+    CHECK_EQ(store.getString("wifi.ap.home", "password"), "secret");
+    CHECK_FALSE(store.containsNamespace("wifi.ap.work"));
+    CHECK_EQ(store.getNamespaces("wifi.ap."), std::vector<std::string> { "wifi.ap.home" });
+
+    // Wrong types fall back to the default
+    CHECK_EQ(store.getInt("wifi.ap.home", "password", 7), 7);
+    CHECK_EQ(store.getInt("display", "missing", 3), 3);
+
+    removeJournal(JOURNAL_FILE);
+}
+
+TEST_CASE("SettingsStore coalesces changes and publishes them") {
+    removeJournal(JOURNAL_FILE);
+    SettingsStore store(JOURNAL_FILE, 0);
+
+    std::vector<std::string> changes;
+    auto subscription = store.getPubsub()->subscribe([&changes](const SettingsStore::Change& change) {
+        changes.push_back(change.namespaceName + "/" + change.key);
+    });
+
+    store.setInt("display", "backlightDuty", 1);
+    CHECK(store.flush());
+    auto size_after_one = store.getJournalSize();
+
+    for (int i = 0; i < 100; i++) {
+        store.setInt("display", "backlightDuty", i + 2);
+    }
+    // The same value again doesn't cause a change
+    store.setInt("display", "backlightDuty", 101);
+    CHECK(store.flush());
+
+    // One value entry and one commit entry
+    CHECK_LT(store.getJournalSize() - size_after_one, size_after_one);
+    CHECK_EQ(changes.size(), 101);
+    CHECK_EQ(changes.front(), "display/backlightDuty");
+
+    store.getPubsub()->unsubscribe(subscription);
+    removeJournal(JOURNAL_FILE);
+}
+
+TEST_CASE("SettingsStore flushes after a delay") {
+    removeJournal(JOURNAL_FILE);
+    SettingsStore store(JOURNAL_FILE, 50);
+    store.setString("system", "language", "nl_NL");
+    CHECK_EQ(store.getJournalSize(), 0);
+
+    // The timer dispatches the flush to the main dispatcher
+    for (int i = 0; i < 100 && store.getJournalSize() == 0; i++) {
+        getMainDispatcher().consume(kernel::millisToTicks(10));
+    }
+
+    SettingsStore reopened_store(JOURNAL_FILE, 0);
+    CHECK_EQ(reopened_store.getString("system", "language"), "nl_NL");
+    removeJournal(JOURNAL_FILE);
+}
+
+TEST_CASE("SettingsStore rejects names that are too long") {
+    removeJournal(JOURNAL_FILE);
+    SettingsStore store(JOURNAL_FILE, 0);
+    const std::string long_name(SettingsStore::maxNameLength + 1, 'a');
+    const std::string max_name(SettingsStore::maxNameLength, 'a');
+
+    CHECK_FALSE(store.setInt(long_name, "key", 1));
+    CHECK_FALSE(store.setInt("display", long_name, 1));
+    CHECK_FALSE(store.remove("display", long_name));
+    CHECK(store.setInt(max_name, max_name, 2));
+    CHECK(store.flush());
+    CHECK_FALSE(store.containsNamespace(long_name));
+
+    SettingsStore reopened_store(JOURNAL_FILE, 0);
+    CHECK_EQ(reopened_store.getInt(max_name, max_name, 0), 2);
+    removeJournal(JOURNAL_FILE);
+}
+
+TEST_CASE("SettingsStore recovers from a power loss at any point in the journal") {
+    removeJournal(JOURNAL_FILE);
+
+    // Write batches and remember the state after each of them
+    std::vector<std::pair<uint32_t, State>> commits;
+    {
+        SettingsStore store(JOURNAL_FILE, 0);
+        commits.emplace_back(0, State());
+
+        store.setString("display", "orientation", "Landscape");
+        store.setInt("display", "backlightDuty", 200);
+        CHECK(store.flush());
+        commits.emplace_back(store.getJournalSize(), getState(store));
+
+        store.setString("wifi.ap.home", "password", "0123456789abcdef");
+        store.setBool("wifi.ap.home", "autoConnect", true);
+        store.setInt("display", "backlightDuty", 80);
+        CHECK(store.flush());
+        commits.emplace_back(store.getJournalSize(), getState(store));
+
+        store.removeNamespace("wifi.ap.home");
+        store.setString("system", "language", "de_DE");
+        CHECK(store.flush());
+        commits.emplace_back(store.getJournalSize(), getState(store));
+
+        store.remove("display", "orientation");
+        CHECK(store.flush());
+        commits.emplace_back(store.getJournalSize(), getState(store));
+    }
+
+    auto data = readFileData(JOURNAL_FILE);
+    REQUIRE_EQ(data.size(), commits.back().first);
+
+    // Cut the journal at every byte: the state must be the one of the last complete commit
+    for (size_t size = 0; size <= data.size(); size++) {
+        removeJournal(COPY_FILE);
+        writeFileData(COPY_FILE, data.data(), size);
+
+        State expected_state;
+        for (const auto& [commit_size, state] : commits) {
+            if (commit_size <= size) {
+                expected_state = state;
+            }
+        }
+
+        SettingsStore store(COPY_FILE, 0);
+        CHECK(store.open());
+        CHECK_EQ(getState(store), expected_state);
+
+        // Writing after a power loss must not resurrect the data of the interrupted batch
+        if (size % 7 == 0) {
+            store.setString("system", "language", "fr_FR");
+            CHECK(store.flush());
+            expected_state["system/language"] = "fr_FR";
+
+            SettingsStore reopened_store(COPY_FILE, 0);
+            CHECK_EQ(getState(reopened_store), expected_state);
+        }
+    }
+
+    // A corrupt byte invalidates the rest of the journal
+    auto corrupt_data = data;
+    corrupt_data[commits[2].first + 5] ^= 0xFF;
+    removeJournal(COPY_FILE);
+    writeFileData(COPY_FILE, corrupt_data.data(), corrupt_data.size());
+    {
+        SettingsStore store(COPY_FILE, 0);
+        CHECK_EQ(getState(store), commits[2].second);
+    }
+
+    removeJournal(COPY_FILE);
+    removeJournal(JOURNAL_FILE);
+}
+
+TEST_CASE("SettingsStore doesn't replace a journal it can't read") {
+    removeJournal(JOURNAL_FILE);
+    const uint8_t unknown_data[] = { 'T', 'T', 'S', 'J', 99, 0, 0, 0 };
+    writeFileData(JOURNAL_FILE, unknown_data, sizeof(unknown_data));
+
+    {
+        SettingsStore store(JOURNAL_FILE, 0);
+        CHECK_FALSE(store.open());
+        store.setInt("display", "backlightDuty", 10);
+        CHECK_EQ(store.getInt("display", "backlightDuty", 0), 10);
+        CHECK_FALSE(store.flush());
+    }
+
+    CHECK_EQ(readFileData(JOURNAL_FILE).size(), sizeof(unknown_data));
+    removeJournal(JOURNAL_FILE);
+}
+
+TEST_CASE("SettingsStore compacts the journal") {
+    removeJournal(JOURNAL_FILE);
+    uint32_t compacted_size;
+    {
+        SettingsStore store(JOURNAL_FILE, 0);
+        store.setString("system", "language", "en_US");
+        for (int i = 0; i < 500; i++) {
+            store.setInt("display", "backlightDuty", i);
+            CHECK(store.flush());
+        }
+        CHECK_GT(store.getCompactionCount(), 0);
+        compacted_size = store.getJournalSize();
+        CHECK_LT(compacted_size, 8192);
+    }
+
+    {
+        SettingsStore store(JOURNAL_FILE, 0);
+        CHECK_EQ(store.getInt("display", "backlightDuty", 0), 499);
+        CHECK_EQ(store.getString("system", "language"), "en_US");
+        CHECK_EQ(store.getJournalSize(), compacted_size);
+    }
+
+    // Interrupted after the old journal was removed and before the new one was renamed
+    auto temp_path = std::string(JOURNAL_FILE) + ".tmp";
+    CHECK_EQ(rename(JOURNAL_FILE, temp_path.c_str()), 0);
+    {
+        SettingsStore store(JOURNAL_FILE, 0);
+        CHECK_EQ(store.getInt("display", "backlightDuty", 0), 499);
+    }
+
+    // Interrupted while the new journal was written: it is incomplete and ignored
+    const uint8_t partial_data[] = { 'T', 'T', 'S' };
+    writeFileData(temp_path.c_str(), partial_data, sizeof(partial_data));
+    {
+        SettingsStore store(JOURNAL_FILE, 0);
+        CHECK_EQ(store.getInt("display", "backlightDuty", 0), 499);
+    }
+    CHECK_EQ(fopen(temp_path.c_str(), "rb"), nullptr);
+
+    removeJournal(JOURNAL_FILE);
+}
+
+TEST_CASE("SettingsStore imports properties files") {
+    removeJournal(JOURNAL_FILE);
+    constexpr auto* PROPERTIES_FILE = "settings_test.properties";
+    REQUIRE(file::savePropertiesFile(PROPERTIES_FILE, { { "orientation", "Portrait" }, { "backlightDuty", "120" }, { "enabled", "true" } }));
+
+    SettingsStore store(JOURNAL_FILE, 0);
+    CHECK(store.importPropertiesFile(PROPERTIES_FILE, "display"));
+    CHECK_FALSE(store.importPropertiesFile(PROPERTIES_FILE, "display"));
+    CHECK_EQ(store.getString("display", "orientation"), "Portrait");
+    CHECK_EQ(store.getInt("display", "backlightDuty", 0), 120);
+    CHECK_EQ(store.getBool("display", "enabled", false), true);
+
+    // The import is remembered after reopening
+    SettingsStore reopened_store(JOURNAL_FILE, 0);
+    CHECK_FALSE(reopened_store.importPropertiesFile(PROPERTIES_FILE, "display"));
+
+    remove(PROPERTIES_FILE);
+    removeJournal(JOURNAL_FILE);
+}
+
+TEST_CASE("SettingsStore benchmark: properties files vs. journal") {
+    constexpr auto* PROPERTIES_FILE = "settings_benchmark.properties";
+    constexpr int LOAD_COUNT = 1000;
+    constexpr int SAVE_COUNT = 100;
+    removeJournal(JOURNAL_FILE);
+
+    // Load the display settings like DisplaySettings::load() did
+    std::map<std::string, std::string> properties = { { "orientation", "Portrait" }, { "gammaCurve", "1" }, { "backlightDuty", "200" } };
+    REQUIRE(file::savePropertiesFile(PROPERTIES_FILE, properties));
+    auto start_time = kernel::getMicros();
+    int checksum = 0;
+    for (int i = 0; i < LOAD_COUNT; i++) {
+        std::map<std::string, std::string> map;
+        file::loadPropertiesFile(PROPERTIES_FILE, map);
+        checksum += atoi(map["backlightDuty"].c_str());
+    }
+    auto properties_load_duration = kernel::getMicros() - start_time;
+
+    start_time = kernel::getMicros();
+    for (int i = 0; i < SAVE_COUNT; i++) {
+        properties["backlightDuty"] = std::to_string(i);
+        file::savePropertiesFile(PROPERTIES_FILE, properties);
+    }
+    auto properties_save_duration = kernel::getMicros() - start_time;
+    remove(PROPERTIES_FILE);
+
+    SettingsStore store(JOURNAL_FILE, 0);
+    store.setString("display", "orientation", "Portrait");
+    store.setInt("display", "gammaCurve", 1);
+    store.setInt("display", "backlightDuty", 200);
+    CHECK(store.flush());
+
+    start_time = kernel::getMicros();
+    for (int i = 0; i < LOAD_COUNT; i++) {
+        checksum -= store.getInt("display", "backlightDuty", 0);
+    }
+    auto store_load_duration = kernel::getMicros() - start_time;
+    CHECK_EQ(checksum, 0);
+
+    // Unlike savePropertiesFile(), every flush is synced to storage
+    start_time = kernel::getMicros();
+    for (int i = 0; i < SAVE_COUNT; i++) {
+        store.setInt("display", "backlightDuty", i);
+        store.flush();
+    }
+    auto store_save_duration = kernel::getMicros() - start_time;
+
+    // A burst of changes is written once
+    start_time = kernel::getMicros();
+    for (int i = 0; i < SAVE_COUNT; i++) {
+        store.setInt("display", "backlightDuty", i + 1);
+    }
+    store.flush();
+    auto store_burst_duration = kernel::getMicros() - start_time;
+
+    MESSAGE("load: properties file ", properties_load_duration / LOAD_COUNT, " us, store ", (store_load_duration * 1000) / LOAD_COUNT, " ns");
+    MESSAGE("save: properties file ", properties_save_duration / SAVE_COUNT, " us, store with fsync ", store_save_duration / SAVE_COUNT, " us");
+    MESSAGE("save burst of ", SAVE_COUNT, " changes: ", store_burst_duration, " us");
+
+    removeJournal(JOURNAL_FILE);
+}
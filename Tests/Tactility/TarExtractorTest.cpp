@@ -0,0 +1,217 @@
+#include "doctest.h"
+
+#include <Tactility/file/TarExtractor.h>
+
+#include <array>
+#include <cstring>
+#include <format>
+#include <string>
+#include <vector>
+
+using namespace tt;
+
+static constexpr auto* EXTRACT_PATH = "/tmp/tar_extractor_test";
+
+/** Creates ustar archives in memory */
+class TarBuilder {
+
+    std::vector<uint8_t> data;
+
+    void addHeader(const std::string& path, size_t size, char type) {
+        std::array<char, 512> header = {};
+        strncpy(header.data(), path.c_str(), 100);
+        snprintf(header.data() + 100, 8, "%07o", 0644);
+        snprintf(header.data() + 108, 8, "%07o", 0);
+        snprintf(header.data() + 116, 8, "%07o", 0);
+        snprintf(header.data() + 124, 12, "%011o", static_cast<unsigned int>(size));
+        snprintf(header.data() + 136, 12, "%011o", 0);
+        header[156] = type;
+        memcpy(header.data() + 257, "ustar\0" "00", 8);
+        memset(header.data() + 148, ' ', 8);
+        unsigned int checksum = 0;
+        for (auto value : header) {
+            checksum += static_cast<uint8_t>(value);
+        }
+        snprintf(header.data() + 148, 8, "%06o", checksum);
+        data.insert(data.end(), header.begin(), header.end());
+    }
+
+public:
+
+    TarBuilder& addEntry(const std::string& path, const std::string& content, char type) {
+        addHeader(path, content.size(), type);
+        data.insert(data.end(), content.begin(), content.end());
+        data.resize((data.size() + 511) / 512 * 512, 0);
+        return *this;
+    }
+
+    TarBuilder& addFile(const std::string& path, const std::string& content) {
+        return addEntry(path, content, '0');
+    }
+
+    /** Adds a GNU long name header for the next entry */
+    TarBuilder& addLongName(const std::string& path) {
+        return addEntry("././@LongLink", path + '\0', 'L');
+    }
+
+    /** Adds a pax extended header with a single record for the next entry */
+    TarBuilder& addPaxRecord(const std::string& key, const std::string& value) {
+        auto record = std::format(" {}={}\n", key, value);
+        // The length includes its own digits
+        auto length = record.size() + std::to_string(record.size()).size();
+        length = record.size() + std::to_string(length).size();
+        return addEntry("PaxHeaders/file", std::format("{}{}", length, record), 'x');
+    }
+
+    TarBuilder& addDirectory(const std::string& path) {
+        addHeader(path, 0, '5');
+        return *this;
+    }
+
+    std::vector<uint8_t> build() {
+        auto result = data;
+        result.resize(result.size() + 1024, 0);
+        return result;
+    }
+};
+
+static std::string readFile(const std::string& path) {
+    auto data = file::readString(path);
+    return (data != nullptr) ? std::string(reinterpret_cast<const char*>(data.get())) : std::string();
+}
+
+static bool extract(const std::vector<uint8_t>& archive, size_t chunkSize, file::TarExtractor& extractor) {
+    for (size_t offset = 0; offset < archive.size(); offset += chunkSize) {
+        if (!extractor.write(archive.data() + offset, std::min(chunkSize, archive.size() - offset))) {
+            return false;
+        }
+    }
+    return extractor.finish();
+}
+
+TEST_CASE("TarExtractor extracts files regardless of chunk size") {
+    const std::string manifest = "[app]\nid=one.tactility.test\n";
+    auto archive = TarBuilder()
+        .addDirectory("./")
+        .addFile("manifest.properties", manifest)
+        .addFile("elf/esp32s3.elf", std::string(1500, 'x'))
+        .addFile("empty.txt", "")
+        .addFile("assets/images/icon.png", "icon")
+        .build();
+
+    for (size_t chunk_size : { 1, 7, 512, 4096 }) {
+        CAPTURE(chunk_size);
+        file::deleteRecursively(EXTRACT_PATH);
+        file::TarExtractor extractor(EXTRACT_PATH);
+        CHECK_EQ(extract(archive, chunk_size, extractor), true);
+        CHECK_EQ(readFile(std::format("{}/manifest.properties", EXTRACT_PATH)), manifest);
+        CHECK_EQ(readFile(std::format("{}/elf/esp32s3.elf", EXTRACT_PATH)), std::string(1500, 'x'));
+        CHECK_EQ(file::isFile(std::format("{}/empty.txt", EXTRACT_PATH)), true);
+        CHECK_EQ(readFile(std::format("{}/assets/images/icon.png", EXTRACT_PATH)), "icon");
+        CHECK_EQ(extractor.getStatistics().fileCount, 4);
+        CHECK_EQ(extractor.getStatistics().bytesWritten, manifest.size() + 1500 + 4);
+    }
+
+    file::deleteRecursively(EXTRACT_PATH);
+}
+
+TEST_CASE("TarExtractor looks up every directory only once") {
+    TarBuilder builder;
+    for (int i = 0; i < 10; i++) {
+        builder.addFile(std::format("assets/file{}.txt", i), "data");
+    }
+    builder.addFile("assets/nested/file.txt", "data");
+
+    file::deleteRecursively(EXTRACT_PATH);
+    file::TarExtractor extractor(EXTRACT_PATH);
+    CHECK_EQ(extract(builder.build(), 512, extractor), true);
+    // "assets" (which creates the destination too) and "assets/nested"
+    CHECK_EQ(extractor.getStatistics().directoryLookupCount, 2);
+    CHECK_EQ(extractor.getStatistics().fileCount, 11);
+
+    file::deleteRecursively(EXTRACT_PATH);
+}
+
+TEST_CASE("TarExtractor rejects paths outside of the destination") {
+    file::deleteRecursively(EXTRACT_PATH);
+    file::TarExtractor extractor(EXTRACT_PATH);
+    auto archive = TarBuilder().addFile("../escaped.txt", "data").build();
+    CHECK_EQ(extract(archive, 512, extractor), false);
+    CHECK_EQ(extractor.hasFailed(), true);
+    CHECK_EQ(file::isFile("/tmp/escaped.txt"), false);
+
+    file::TarExtractor absolute_extractor(EXTRACT_PATH);
+    archive = TarBuilder().addFile("/tmp/escaped.txt", "data").build();
+    CHECK_EQ(extract(archive, 512, absolute_extractor), false);
+    CHECK_EQ(file::isFile("/tmp/escaped.txt"), false);
+
+    file::deleteRecursively(EXTRACT_PATH);
+}
+
+TEST_CASE("TarExtractor fails on corrupt and truncated archives") {
+    file::deleteRecursively(EXTRACT_PATH);
+    auto archive = TarBuilder().addFile("file.txt", std::string(1000, 'x')).build();
+
+    auto corrupt = archive;
+    corrupt[10] ^= 0x01;
+    file::TarExtractor corrupt_extractor(EXTRACT_PATH);
+    CHECK_EQ(corrupt_extractor.write(corrupt.data(), corrupt.size()), false);
+    // Once failed, it stays failed
+    CHECK_EQ(corrupt_extractor.write(archive.data(), archive.size()), false);
+
+    file::TarExtractor truncated_extractor(EXTRACT_PATH);
+    CHECK_EQ(truncated_extractor.write(archive.data(), 700), true);
+    CHECK_EQ(truncated_extractor.finish(), false);
+
+    file::deleteRecursively(EXTRACT_PATH);
+}
+
+TEST_CASE("TarExtractor applies long paths from GNU and pax extended headers") {
+    const std::string directory = std::string(60, 'd');
+    const std::string gnu_path = std::format("{}/{}", directory, std::string(80, 'g'));
+    const std::string pax_path = std::format("{}/{}", directory, std::string(80, 'p'));
+    auto archive = TarBuilder()
+        .addLongName(gnu_path)
+        .addFile(gnu_path.substr(0, 100), "gnu")
+        .addPaxRecord("path", pax_path)
+        .addFile(pax_path.substr(0, 100), "pax")
+        .addFile("short.txt", "short")
+        .build();
+
+    for (size_t chunk_size : { 1, 512 }) {
+        CAPTURE(chunk_size);
+        file::deleteRecursively(EXTRACT_PATH);
+        file::TarExtractor extractor(EXTRACT_PATH);
+        CHECK_EQ(extract(archive, chunk_size, extractor), true);
+        CHECK_EQ(readFile(std::format("{}/{}", EXTRACT_PATH, gnu_path)), "gnu");
+        CHECK_EQ(readFile(std::format("{}/{}", EXTRACT_PATH, pax_path)), "pax");
+        CHECK_EQ(readFile(std::format("{}/short.txt", EXTRACT_PATH)), "short");
+        CHECK_EQ(extractor.getStatistics().fileCount, 3);
+    }
+
+    file::deleteRecursively(EXTRACT_PATH);
+}
+
+TEST_CASE("TarExtractor rejects invalid extended headers") {
+    file::deleteRecursively(EXTRACT_PATH);
+
+    file::TarExtractor escape_extractor(EXTRACT_PATH);
+    auto archive = TarBuilder().addPaxRecord("path", "../escaped.txt").addFile("file.txt", "data").build();
+    CHECK_EQ(extract(archive, 512, escape_extractor), false);
+    CHECK_EQ(file::isFile("/tmp/escaped.txt"), false);
+
+    file::TarExtractor invalid_extractor(EXTRACT_PATH);
+    archive = TarBuilder().addEntry("PaxHeaders/file", "invalid\n", 'x').addFile("file.txt", "data").build();
+    CHECK_EQ(extract(archive, 512, invalid_extractor), false);
+
+    file::TarExtractor large_extractor(EXTRACT_PATH);
+    archive = TarBuilder().addLongName(std::string(5000, 'x')).addFile("file.txt", "data").build();
+    CHECK_EQ(extract(archive, 512, large_extractor), false);
+
+    // An extended header without an entry
+    file::TarExtractor dangling_extractor(EXTRACT_PATH);
+    archive = TarBuilder().addLongName("file.txt").build();
+    CHECK_EQ(extract(archive, 512, dangling_extractor), false);
+
+    file::deleteRecursively(EXTRACT_PATH);
+}
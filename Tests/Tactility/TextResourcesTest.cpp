@@ -0,0 +1,131 @@
+#include "doctest.h"
+
+#include <Tactility/file/File.h>
+#include <Tactility/i18n/TextResources.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace tt;
+
+static constexpr auto* I18N_PATH = "/tmp/text_resources_test";
+
+static void writeBinaryData(const std::vector<uint8_t>& data) {
+    auto* file = fopen((std::string(I18N_PATH) + "/en-US.i18nb").c_str(), "wb");
+    REQUIRE_NE(file, nullptr);
+    fwrite(data.data(), 1, data.size(), file);
+    fclose(file);
+}
+
+/** Writes en-US.i18nb, the format generated by Translations/generate.py */
+static void writeBinaryFile(const std::vector<std::string>& texts, uint16_t version = 1) {
+    std::vector<uint8_t> blob;
+    std::vector<uint32_t> offsets;
+    for (const auto& text : texts) {
+        offsets.push_back(blob.size());
+        blob.insert(blob.end(), text.begin(), text.end());
+        blob.push_back('\0');
+    }
+    offsets.push_back(blob.size());
+
+    std::vector<uint8_t> data = { 'T', 'T', 'I', '1', static_cast<uint8_t>(version), 0, 0, 0 };
+    for (uint32_t value : { static_cast<uint32_t>(texts.size()), static_cast<uint32_t>(blob.size()) }) {
+        for (int i = 0; i < 4; i++) {
+            data.push_back((value >> (i * 8)) & 0xFF);
+        }
+    }
+    for (auto offset : offsets) {
+        for (int i = 0; i < 4; i++) {
+            data.push_back((offset >> (i * 8)) & 0xFF);
+        }
+    }
+    data.insert(data.end(), blob.begin(), blob.end());
+    writeBinaryData(data);
+}
+
+static void removeFiles() {
+    remove((std::string(I18N_PATH) + "/en-US.i18nb").c_str());
+    remove((std::string(I18N_PATH) + "/en-US.i18n").c_str());
+}
+
+static void resetDirectory() {
+    file::findOrCreateDirectory(I18N_PATH, 0777);
+    removeFiles();
+}
+
+TEST_CASE("TextResources loads binary string tables") {
+    resetDirectory();
+    writeBinaryFile({ "OK", "", "Caf\xC3\xA9" });
+
+    i18n::TextResources resources(I18N_PATH);
+    REQUIRE_EQ(resources.load(), true);
+    CHECK_EQ(resources.getCount(), 3);
+    CHECK_EQ(resources[0], "OK");
+    CHECK_EQ(resources[1], "");
+    CHECK_EQ(resources[2], "Caf\xC3\xA9");
+    // Texts are null-terminated, so they can be passed to C APIs
+    CHECK_EQ(strcmp(resources[2].data(), "Caf\xC3\xA9"), 0);
+    CHECK_EQ(resources[3], i18n::TextResources::ERROR_RESULT);
+    CHECK_EQ(resources[-1], i18n::TextResources::ERROR_RESULT);
+
+    removeFiles();
+}
+
+TEST_CASE("TextResources prefers binary files over text files") {
+    resetDirectory();
+    writeBinaryFile({ "binary" });
+    file::writeString(std::string(I18N_PATH) + "/en-US.i18n", "text\n");
+
+    i18n::TextResources resources(I18N_PATH);
+    REQUIRE_EQ(resources.load(), true);
+    CHECK_EQ(resources[0], "binary");
+
+    removeFiles();
+}
+
+TEST_CASE("TextResources loads text files") {
+    resetDirectory();
+    file::writeString(std::string(I18N_PATH) + "/en-US.i18n", "Yes\nNo\r\n\nCancel");
+
+    i18n::TextResources resources(I18N_PATH);
+    REQUIRE_EQ(resources.load(), true);
+    CHECK_EQ(resources.getCount(), 4);
+    CHECK_EQ(resources[0], "Yes");
+    CHECK_EQ(resources[1], "No");
+    CHECK_EQ(resources[2], "");
+    CHECK_EQ(resources[3], "Cancel");
+
+    removeFiles();
+}
+
+TEST_CASE("TextResources rejects invalid binary files") {
+    resetDirectory();
+    writeBinaryFile({ "text" }, 2);
+
+    i18n::TextResources resources(I18N_PATH);
+    CHECK_EQ(resources.load(), false);
+    CHECK_EQ(resources[0], i18n::TextResources::ERROR_RESULT);
+
+    removeFiles();
+}
+
+TEST_CASE("TextResources rejects binary files with a string count that exceeds the file size") {
+    resetDirectory();
+    // With 32-bit size_t, the offset table size of 0x3FFFFFFF + 1 strings wraps around to 0
+    writeBinaryData({
+        'T', 'T', 'I', '1', 1, 0, 0, 0,
+        0xFF, 0xFF, 0xFF, 0x3F, // count
+        0x04, 0x00, 0x00, 0x00, // blob size
+        0x00, 0x00, 0x00, 0x00 // blob
+    });
+
+    i18n::TextResources resources(I18N_PATH);
+    CHECK_EQ(resources.load(), false);
+
+    // A file that only has a header
+    writeBinaryData({ 'T', 'T', 'I', '1', 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+    CHECK_EQ(resources.load(), false);
+
+    removeFiles();
+}
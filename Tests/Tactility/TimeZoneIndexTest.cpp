@@ -0,0 +1,74 @@
+#include "doctest.h"
+
+#include <Tactility/app/timezone/TimeZoneIndex.h>
+#include <Tactility/file/File.h>
+
+#include <string>
+
+using namespace tt;
+using namespace tt::app::timezone;
+
+static constexpr auto* CSV_PATH = "/tmp/timezone_index_test.csv";
+
+static std::shared_ptr<const TimeZoneIndex> createIndex() {
+    file::writeString(CSV_PATH,
+        "\"Europe/Amsterdam\",\"CET-1CEST,M3.5.0,M10.5.0/3\"\n"
+        "\"America/New_York\",\"EST5EDT,M3.2.0,M11.1.0\"\n"
+        "\"Etc/GMT\",\"GMT0\"\n"
+        "\"Europe/Andorra\",\"CET-1CEST,M3.5.0,M10.5.0/3\"\n"
+        "\"America/Anchorage\",\"AKST9AKDT,M3.2.0,M11.1.0\"\n"
+    );
+    std::shared_ptr<const TimeZoneIndex> index = TimeZoneIndex::load(CSV_PATH);
+    file::deleteFile(CSV_PATH);
+    return index;
+}
+
+TEST_CASE("TimeZoneIndex sorts the timezones by name") {
+    auto index = createIndex();
+    REQUIRE_NE(index, nullptr);
+    REQUIRE_EQ(index->getCount(), 5);
+    CHECK_EQ(std::string(index->getName(0)), "America/Anchorage");
+    CHECK_EQ(std::string(index->getCode(0)), "AKST9AKDT,M3.2.0,M11.1.0");
+    CHECK_EQ(std::string(index->getName(4)), "Europe/Andorra");
+    CHECK_EQ(std::string(index->getLowercaseName(1)), "america/new_york");
+    CHECK_EQ(std::string(index->getCode(2)), "GMT0");
+}
+
+TEST_CASE("TimeZoneIndex fails when the file doesn't exist") {
+    CHECK_EQ(TimeZoneIndex::load("/tmp/timezone_index_test_missing.csv"), nullptr);
+}
+
+TEST_CASE("TimeZoneFilter matches case-insensitive substrings") {
+    TimeZoneFilter filter(createIndex());
+    CHECK_EQ(filter.getMatches().size(), 5);
+
+    filter.setQuery("AN");
+    CHECK_EQ(filter.getMatches(), std::vector<uint16_t> { 0, 4 });
+
+    filter.setQuery("");
+    CHECK_EQ(filter.getMatches().size(), 5);
+
+    filter.setQuery("xyz");
+    CHECK_EQ(filter.getMatches().empty(), true);
+}
+
+TEST_CASE("TimeZoneFilter refines the previous matches while typing") {
+    TimeZoneFilter filter(createIndex());
+
+    filter.setQuery("e");
+    CHECK_EQ(filter.getLastComparisonCount(), 5);
+    auto e_matches = filter.getMatches().size();
+
+    filter.setQuery("eu");
+    CHECK_EQ(filter.getLastComparisonCount(), e_matches);
+    CHECK_EQ(filter.getMatches(), std::vector<uint16_t> { 3, 4 });
+
+    filter.setQuery("europe/and");
+    CHECK_EQ(filter.getLastComparisonCount(), 2);
+    CHECK_EQ(filter.getMatches(), std::vector<uint16_t> { 4 });
+
+    // Removing characters needs a full search
+    filter.setQuery("europe/a");
+    CHECK_EQ(filter.getLastComparisonCount(), 5);
+    CHECK_EQ(filter.getMatches(), std::vector<uint16_t> { 3, 4 });
+}
@@ -0,0 +1,152 @@
+#include "doctest.h"
+#include <Tactility/hal/uart/LineReader.h>
+#include <Tactility/hal/uart/UartPosix.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace tt;
+
+/**
+ * A pseudo-terminal: the test writes to its master side as the remote device (e.g. a fake GPS),
+ * while UartPosix opens its slave side like any other serial device.
+ */
+class Pty final {
+
+    int masterFd = -1;
+    std::string slavePath;
+
+public:
+
+    Pty() {
+        masterFd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (masterFd >= 0 && grantpt(masterFd) == 0 && unlockpt(masterFd) == 0) {
+            slavePath = ptsname(masterFd);
+        }
+    }
+
+    ~Pty() {
+        if (masterFd >= 0) close(masterFd);
+    }
+
+    const std::string& getSlavePath() const { return slavePath; }
+
+    /** Write data as the remote device */
+    void send(const std::string& data) const {
+        size_t offset = 0;
+        while (offset < data.size()) {
+            auto written = write(masterFd, data.data() + offset, data.size() - offset);
+            if (written <= 0) {
+                break;
+            }
+            offset += written;
+        }
+    }
+};
+
+static const char* nmeaLog[] = {
+    "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n",
+    "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n",
+    "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n",
+    "$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75\r\n",
+    "$GPGSV,2,2,08,15,44,158,42,17,61,062,45,19,11,174,37,22,58,259,40*7E\r\n",
+    "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n"
+};
+
+constexpr size_t nmeaLogSize = sizeof(nmeaLog) / sizeof(nmeaLog[0]);
+
+TEST_CASE("LineReader splits chunked input into lines") {
+    Pty pty;
+    REQUIRE_FALSE(pty.getSlavePath().empty());
+    // UartPosix keeps a reference to its configuration
+    const hal::uart::Configuration configuration = { .name = pty.getSlavePath(), .baudRate = B115200 };
+    hal::uart::UartPosix uart(configuration);
+    REQUIRE(uart.start());
+    hal::uart::LineReader reader(uart, 256);
+
+    // Split a sentence over 2 writes
+    pty.send("$GPRMC,123519,A,4807.038,N,");
+    pty.send("01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n$GPVTG,054.7,T*48\r\n");
+
+    std::string_view line;
+    REQUIRE(reader.readLine(line, 100));
+    CHECK_EQ(line, "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r");
+    // Null-terminated for C APIs
+    CHECK_EQ(line.data()[line.size()], '\0');
+
+    REQUIRE(reader.readLine(line, 100));
+    CHECK_EQ(line, "$GPVTG,054.7,T*48\r");
+
+    CHECK_FALSE(reader.readLine(line, 10));
+    CHECK_EQ(reader.getStatistics().lineCount, 2);
+}
+
+TEST_CASE("LineReader discards lines that don't fit in its buffer") {
+    Pty pty;
+    REQUIRE_FALSE(pty.getSlavePath().empty());
+    // UartPosix keeps a reference to its configuration
+    const hal::uart::Configuration configuration = { .name = pty.getSlavePath(), .baudRate = B115200 };
+    hal::uart::UartPosix uart(configuration);
+    REQUIRE(uart.start());
+    hal::uart::LineReader reader(uart, 16);
+
+    pty.send("this line is much longer than 16 bytes\nshort\n");
+
+    std::string_view line;
+    REQUIRE(reader.readLine(line, 100));
+    CHECK_EQ(line, "short");
+    CHECK_EQ(reader.getStatistics().overflowCount, 1);
+}
+
+TEST_CASE("LineReader benchmark: NMEA replay vs readUntil()") {
+    constexpr int REPLAY_COUNT = 20;
+    Pty pty;
+    REQUIRE_FALSE(pty.getSlavePath().empty());
+    // UartPosix keeps a reference to its configuration
+    const hal::uart::Configuration configuration = { .name = pty.getSlavePath(), .baudRate = B115200 };
+    hal::uart::UartPosix uart(configuration);
+    REQUIRE(uart.start());
+
+    std::string replay_block;
+    for (auto* sentence : nmeaLog) {
+        replay_block += sentence;
+    }
+
+    // Byte-at-a-time
+    char buffer[256];
+    uint32_t until_lines = 0;
+    auto until_start = kernel::getMicros();
+    for (int i = 0; i < REPLAY_COUNT; i++) {
+        pty.send(replay_block);
+        for (size_t line = 0; line < nmeaLogSize; line++) {
+            if (uart.readUntil(reinterpret_cast<std::byte*>(buffer), sizeof(buffer), '\n', 100) > 0) {
+                until_lines++;
+            }
+        }
+    }
+    auto until_duration = kernel::getMicros() - until_start;
+
+    // Buffered
+    hal::uart::LineReader reader(uart, 512);
+    std::string_view line;
+    uint32_t reader_lines = 0;
+    auto reader_start = kernel::getMicros();
+    for (int i = 0; i < REPLAY_COUNT; i++) {
+        pty.send(replay_block);
+        for (size_t sentence = 0; sentence < nmeaLogSize; sentence++) {
+            if (reader.readLine(line, 100)) {
+                reader_lines++;
+            }
+        }
+    }
+    auto reader_duration = kernel::getMicros() - reader_start;
+
+    CHECK_EQ(until_lines, REPLAY_COUNT * nmeaLogSize);
+    CHECK_EQ(reader_lines, REPLAY_COUNT * nmeaLogSize);
+    MESSAGE("readUntil(): ", until_lines, " lines in ", until_duration, " us");
+    MESSAGE("LineReader: ", reader_lines, " lines in ", reader_duration, " us with ", reader.getStatistics().readCount, " reads");
+}
@@ -0,0 +1,19 @@
+#include "doctest.h"
+
+#include <Tactility/Crc32.h>
+
+#include <cstring>
+
+using namespace tt;
+
+TEST_CASE("crc32 matches the standard check value") {
+    const char* data = "123456789";
+    CHECK_EQ(crc32(data, strlen(data)), 0xCBF43926);
+    CHECK_EQ(crc32(data, 0), 0);
+}
+
+TEST_CASE("crc32 can be calculated over multiple buffers") {
+    const char* data = "123456789";
+    auto crc = crc32(data, 4);
+    CHECK_EQ(crc32(data + 4, 5, crc), 0xCBF43926);
+}
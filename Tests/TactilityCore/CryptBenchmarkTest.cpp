@@ -0,0 +1,107 @@
+#include "doctest.h"
+#include <Tactility/TactilityCore.h>
+#include <Tactility/crypt/Crypt.h>
+#include <Tactility/crypt/Session.h>
+
+#include <cstring>
+#include <mbedtls/aes.h>
+#include <vector>
+
+using namespace tt;
+
+constexpr size_t BENCHMARK_BUFFER_SIZE = 4096;
+constexpr uint32_t BENCHMARK_BUFFER_COUNT = 256;
+constexpr size_t BENCHMARK_RECORD_SIZE = 32;
+constexpr uint32_t BENCHMARK_RECORD_COUNT = 10000;
+
+static constexpr uint8_t BENCHMARK_IV[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+static constexpr uint8_t BENCHMARK_KEY[32] = { 0 };
+
+/**
+ * What encrypt() did for every call before it used a cached session: set up a new key schedule.
+ * On a device it also read the key material from NVS and the MAC, so this is the lower bound of the uncached cost.
+ */
+static int encryptUncached(const uint8_t* inData, uint8_t* outData, size_t dataLength) {
+    uint8_t iv[16];
+    memcpy(iv, BENCHMARK_IV, sizeof(iv));
+    mbedtls_aes_context context;
+    mbedtls_aes_init(&context);
+    mbedtls_aes_setkey_enc(&context, BENCHMARK_KEY, 256);
+    int result = mbedtls_aes_crypt_cbc(&context, MBEDTLS_AES_ENCRYPT, dataLength, iv, inData, outData);
+    mbedtls_aes_free(&context);
+    return result;
+}
+
+static double getMegabytesPerSecond(uint64_t bytes, uint64_t micros) {
+    return (double)bytes / (double)(micros > 0 ? micros : 1);
+}
+
+static double getMicrosPerCall(uint32_t calls, uint64_t micros) {
+    return (double)micros / (double)calls;
+}
+
+template<typename Function>
+static uint64_t measureMicros(uint32_t count, Function function) {
+    auto start_time = kernel::getMicros();
+    for (uint32_t i = 0; i < count; i++) {
+        CHECK_EQ(function(), 0);
+    }
+    return kernel::getMicros() - start_time;
+}
+
+TEST_CASE("crypt benchmark: throughput of encrypt() vs session") {
+    std::vector<uint8_t> input(BENCHMARK_BUFFER_SIZE, 0x5A);
+    std::vector<uint8_t> output(BENCHMARK_BUFFER_SIZE);
+    constexpr uint64_t total_bytes = (uint64_t)BENCHMARK_BUFFER_SIZE * BENCHMARK_BUFFER_COUNT;
+
+    auto uncached_micros = measureMicros(BENCHMARK_BUFFER_COUNT, [&] {
+        return encryptUncached(input.data(), output.data(), input.size());
+    });
+
+    auto legacy_micros = measureMicros(BENCHMARK_BUFFER_COUNT, [&] {
+        return crypt::encrypt(BENCHMARK_IV, input.data(), output.data(), input.size());
+    });
+
+    crypt::Session session;
+    auto cbc_micros = measureMicros(BENCHMARK_BUFFER_COUNT, [&] {
+        return session.encryptCbc(BENCHMARK_IV, input.data(), output.data(), input.size());
+    });
+
+    crypt::CtrStream stream(session, BENCHMARK_IV);
+    auto ctr_micros = measureMicros(BENCHMARK_BUFFER_COUNT, [&] {
+        return stream.update(input.data(), output.data(), input.size());
+    });
+
+    MESSAGE("uncached setup per call: ", getMegabytesPerSecond(total_bytes, uncached_micros), " MB/s");
+    MESSAGE("encrypt() (shared session): ", getMegabytesPerSecond(total_bytes, legacy_micros), " MB/s");
+    MESSAGE("session CBC: ", getMegabytesPerSecond(total_bytes, cbc_micros), " MB/s");
+    MESSAGE("session CTR: ", getMegabytesPerSecond(total_bytes, ctr_micros), " MB/s");
+}
+
+TEST_CASE("crypt benchmark: latency of small records with encrypt() vs session") {
+    uint8_t input[BENCHMARK_RECORD_SIZE] = {};
+    uint8_t output[BENCHMARK_RECORD_SIZE];
+
+    auto uncached_micros = measureMicros(BENCHMARK_RECORD_COUNT, [&] {
+        return encryptUncached(input, output, BENCHMARK_RECORD_SIZE);
+    });
+
+    auto legacy_micros = measureMicros(BENCHMARK_RECORD_COUNT, [&] {
+        return crypt::encrypt(BENCHMARK_IV, input, output, BENCHMARK_RECORD_SIZE);
+    });
+
+    crypt::Session session;
+    auto session_micros = measureMicros(BENCHMARK_RECORD_COUNT, [&] {
+        return session.encryptCbc(BENCHMARK_IV, input, output, BENCHMARK_RECORD_SIZE);
+    });
+
+    auto setup_micros = measureMicros(BENCHMARK_RECORD_COUNT, [&] {
+        crypt::Session record_session;
+        return record_session.encryptCbc(BENCHMARK_IV, input, output, BENCHMARK_RECORD_SIZE);
+    });
+
+    MESSAGE("uncached setup per call: ", getMicrosPerCall(BENCHMARK_RECORD_COUNT, uncached_micros), " us/record");
+    MESSAGE("encrypt() (shared session): ", getMicrosPerCall(BENCHMARK_RECORD_COUNT, legacy_micros), " us/record");
+    MESSAGE("session CBC: ", getMicrosPerCall(BENCHMARK_RECORD_COUNT, session_micros), " us/record");
+    MESSAGE("new session per record: ", getMicrosPerCall(BENCHMARK_RECORD_COUNT, setup_micros), " us/record");
+}
@@ -0,0 +1,112 @@
+#include "doctest.h"
+#include <Tactility/crypt/Crypt.h>
+#include <Tactility/crypt/Session.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace tt;
+
+// Test vectors from NIST SP 800-38A (F.2.5 and F.5.5)
+static constexpr uint8_t NIST_KEY[32] = {
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+    0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+};
+static constexpr uint8_t NIST_PLAINTEXT[16] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a
+};
+static constexpr uint8_t NIST_CBC_IV[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static constexpr uint8_t NIST_CBC_CIPHERTEXT[16] = {
+    0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba, 0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6
+};
+static constexpr uint8_t NIST_CTR_NONCE[16] = {
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+static constexpr uint8_t NIST_CTR_CIPHERTEXT[16] = {
+    0x60, 0x1e, 0xc3, 0x13, 0x77, 0x57, 0x89, 0xa5, 0xb7, 0xa7, 0xf5, 0x04, 0xbb, 0xf3, 0xd2, 0x28
+};
+
+static std::vector<uint8_t> createData(size_t length) {
+    std::vector<uint8_t> data(length);
+    for (size_t i = 0; i < length; i++) {
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    return data;
+}
+
+TEST_CASE("crypt session encrypts and decrypts CBC test vectors") {
+    crypt::Session session(NIST_KEY);
+    uint8_t iv[16];
+    memcpy(iv, NIST_CBC_IV, sizeof(iv));
+
+    uint8_t encrypted[16];
+    CHECK_EQ(session.encryptCbc(iv, NIST_PLAINTEXT, encrypted, sizeof(encrypted)), 0);
+    CHECK_EQ(memcmp(encrypted, NIST_CBC_CIPHERTEXT, sizeof(encrypted)), 0);
+    // The IV must not be modified
+    CHECK_EQ(memcmp(iv, NIST_CBC_IV, sizeof(iv)), 0);
+
+    uint8_t decrypted[16];
+    CHECK_EQ(session.decryptCbc(iv, encrypted, decrypted, sizeof(decrypted)), 0);
+    CHECK_EQ(memcmp(decrypted, NIST_PLAINTEXT, sizeof(decrypted)), 0);
+}
+
+TEST_CASE("crypt session rejects CBC data that is not a multiple of 16 bytes") {
+    crypt::Session session(NIST_KEY);
+    uint8_t data[20] = {};
+    CHECK_NE(session.encryptCbc(NIST_CBC_IV, data, data, 20), 0);
+    CHECK_NE(session.decryptCbc(NIST_CBC_IV, data, data, 0), 0);
+}
+
+TEST_CASE("crypt session with the device key has the same output as encrypt() and decrypt()") {
+    auto data = createData(64);
+    uint8_t iv[16];
+    crypt::getIv(data.data(), data.size(), iv);
+
+    std::vector<uint8_t> expected(data.size());
+    CHECK_EQ(crypt::encrypt(iv, data.data(), expected.data(), data.size()), 0);
+
+    crypt::Session session;
+    std::vector<uint8_t> encrypted(data.size());
+    CHECK_EQ(session.encryptCbc(iv, data.data(), encrypted.data(), data.size()), 0);
+    CHECK_EQ(encrypted, expected);
+
+    std::vector<uint8_t> decrypted(data.size());
+    CHECK_EQ(crypt::decrypt(iv, encrypted.data(), decrypted.data(), data.size()), 0);
+    CHECK_EQ(decrypted, data);
+}
+
+TEST_CASE("crypt CTR stream encrypts a test vector") {
+    crypt::Session session(NIST_KEY);
+    crypt::CtrStream stream(session, NIST_CTR_NONCE);
+    uint8_t encrypted[16];
+    CHECK_EQ(stream.update(NIST_PLAINTEXT, encrypted, sizeof(encrypted)), 0);
+    CHECK_EQ(memcmp(encrypted, NIST_CTR_CIPHERTEXT, sizeof(encrypted)), 0);
+}
+
+TEST_CASE("crypt CTR stream output doesn't depend on the chunk sizes") {
+    crypt::Session session(NIST_KEY);
+    auto data = createData(1000);
+
+    std::vector<uint8_t> expected(data.size());
+    crypt::CtrStream one_shot(session, NIST_CTR_NONCE);
+    CHECK_EQ(one_shot.update(data.data(), expected.data(), data.size()), 0);
+
+    for (size_t chunk_size : { 1, 5, 16, 17, 333 }) {
+        CAPTURE(chunk_size);
+        std::vector<uint8_t> encrypted(data.size());
+        crypt::CtrStream stream(session, NIST_CTR_NONCE);
+        for (size_t offset = 0; offset < data.size(); offset += chunk_size) {
+            auto length = std::min(chunk_size, data.size() - offset);
+            CHECK_EQ(stream.update(data.data() + offset, encrypted.data() + offset, length), 0);
+        }
+        CHECK_EQ(encrypted, expected);
+    }
+
+    // Decrypting is the same operation, done in place here
+    crypt::CtrStream decrypt_stream(session, NIST_CTR_NONCE);
+    CHECK_EQ(decrypt_stream.update(expected.data(), expected.data(), 7), 0);
+    CHECK_EQ(decrypt_stream.update(expected.data() + 7, expected.data() + 7, expected.size() - 7), 0);
+    CHECK_EQ(expected, data);
+}
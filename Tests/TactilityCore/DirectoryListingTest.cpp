@@ -0,0 +1,126 @@
+#include "doctest.h"
+
+#include <Tactility/file/DirectoryListing.h>
+#include <Tactility/file/File.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <format>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace tt;
+
+/** A directory with files and subdirectories that is removed when the test ends */
+class TestDirectory {
+
+    std::string path;
+    std::vector<std::string> files;
+    std::vector<std::string> directories;
+
+public:
+
+    explicit TestDirectory(std::string path) : path(std::move(path)) {
+        mkdir(this->path.c_str(), 0777);
+    }
+
+    ~TestDirectory() {
+        for (const auto& file : files) {
+            remove(file.c_str());
+        }
+        for (const auto& directory : directories) {
+            rmdir(directory.c_str());
+        }
+        rmdir(path.c_str());
+    }
+
+    const std::string& getPath() const { return path; }
+
+    void addFile(const std::string& name) {
+        auto file_path = std::format("{}/{}", path, name);
+        CHECK(file::writeString(file_path, "data"));
+        files.push_back(file_path);
+    }
+
+    void addDirectory(const std::string& name) {
+        auto directory_path = std::format("{}/{}", path, name);
+        mkdir(directory_path.c_str(), 0777);
+        directories.push_back(directory_path);
+    }
+};
+
+TEST_CASE("DirectoryListing reads directories first and sorts by name") {
+    TestDirectory directory("/tmp/directory_listing_test");
+    directory.addFile("b.txt");
+    directory.addFile("a.txt");
+    directory.addDirectory("zdir");
+    directory.addDirectory("adir");
+    directory.addFile("C.txt");
+
+    auto listing = file::DirectoryListing::read(directory.getPath());
+    REQUIRE_NE(listing, nullptr);
+    CHECK_EQ(listing->getPath(), directory.getPath());
+    REQUIRE_EQ(listing->getCount(), 5);
+
+    CHECK_EQ(std::string(listing->getName(0)), "adir");
+    CHECK_EQ(std::string(listing->getName(1)), "zdir");
+    CHECK_EQ(std::string(listing->getName(2)), "C.txt");
+    CHECK_EQ(std::string(listing->getName(3)), "a.txt");
+    CHECK_EQ(std::string(listing->getName(4)), "b.txt");
+    CHECK_EQ(listing->getNameLength(2), 5);
+
+    CHECK(listing->isDirectory(0));
+    CHECK_EQ(listing->getType(0), file::TT_DT_DIR);
+    CHECK_FALSE(listing->isDirectory(2));
+    CHECK_EQ(listing->getType(2), file::TT_DT_REG);
+}
+
+TEST_CASE("DirectoryListing reports pages and can be cancelled") {
+    TestDirectory directory("/tmp/directory_listing_page_test");
+    for (int i = 0; i < 10; i++) {
+        directory.addFile(std::format("file{}", i));
+    }
+
+    std::vector<size_t> counts;
+    auto listing = file::DirectoryListing::read(directory.getPath(), [&counts](size_t count) {
+        counts.push_back(count);
+        return true;
+    }, 4);
+    REQUIRE_NE(listing, nullptr);
+    CHECK_EQ(listing->getCount(), 10);
+    CHECK_EQ(counts, std::vector<size_t> { 4, 8 });
+
+    auto cancelled = file::DirectoryListing::read(directory.getPath(), [](size_t) { return false; }, 4);
+    CHECK_EQ(cancelled, nullptr);
+}
+
+TEST_CASE("DirectoryListing fails for a directory that doesn't exist") {
+    CHECK_EQ(file::DirectoryListing::read("/tmp/directory_listing_missing"), nullptr);
+}
+
+TEST_CASE("directory listing benchmark") {
+    constexpr int FILE_COUNT = 5000;
+    TestDirectory directory("/tmp/directory_listing_benchmark");
+    for (int i = 0; i < FILE_COUNT; i++) {
+        directory.addFile(std::format("IMG_{:05}.jpg", (i * 7919) % FILE_COUNT));
+    }
+
+    auto start_time = kernel::getMicros();
+    std::vector<dirent> dirents;
+    file::scandir(directory.getPath(), dirents, file::direntFilterDotEntries, file::direntSortAlphaAndType);
+    auto scandir_duration = kernel::getMicros() - start_time;
+
+    start_time = kernel::getMicros();
+    auto listing = file::DirectoryListing::read(directory.getPath());
+    auto listing_duration = kernel::getMicros() - start_time;
+
+    REQUIRE_NE(listing, nullptr);
+    REQUIRE_EQ(listing->getCount(), dirents.size());
+    for (size_t i = 0; i < dirents.size(); i++) {
+        CHECK_EQ(std::string(listing->getName(i)), dirents[i].d_name);
+    }
+
+    MESSAGE("scandir: ", scandir_duration, " us, ", dirents.capacity() * sizeof(dirent), " bytes");
+    MESSAGE("DirectoryListing: ", listing_duration, " us, ", listing->getMemoryUsage(), " bytes");
+}
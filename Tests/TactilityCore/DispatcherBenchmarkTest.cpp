@@ -0,0 +1,96 @@
+#include "doctest.h"
+#include <Tactility/TactilityCore.h>
+#include <Tactility/Dispatcher.h>
+#include <Tactility/Thread.h>
+
+#include <atomic>
+
+using namespace tt;
+
+constexpr uint32_t BENCHMARK_BATCH_SIZE = 256;
+constexpr uint32_t BENCHMARK_BATCH_COUNT = 200;
+
+static double measureOpsPerSecond(Dispatcher& dispatcher) {
+    uint32_t counter = 0;
+    auto start_time = kernel::getMicros();
+    for (uint32_t batch = 0; batch < BENCHMARK_BATCH_COUNT; batch++) {
+        for (uint32_t i = 0; i < BENCHMARK_BATCH_SIZE; i++) {
+            dispatcher.dispatch([&counter]() { counter++; });
+        }
+        dispatcher.consume(0);
+    }
+    auto duration = kernel::getMicros() - start_time;
+    CHECK_EQ(counter, BENCHMARK_BATCH_SIZE * BENCHMARK_BATCH_COUNT);
+    return (counter * 1000000.0) / (double)(duration > 0 ? duration : 1);
+}
+
+TEST_CASE("dispatcher benchmark: unbounded vs bounded") {
+    Dispatcher unbounded;
+    Dispatcher bounded(BENCHMARK_BATCH_SIZE);
+
+    auto unbounded_ops = measureOpsPerSecond(unbounded);
+    auto bounded_ops = measureOpsPerSecond(bounded);
+
+    MESSAGE("unbounded dispatcher: ", (uint64_t)unbounded_ops, " ops/s");
+    MESSAGE("bounded dispatcher: ", (uint64_t)bounded_ops, " ops/s");
+    CHECK_EQ(bounded.getStatistics().highWaterMark, BENCHMARK_BATCH_SIZE);
+}
+
+TEST_CASE("bounded dispatcher should receive all functions from multiple producers") {
+    constexpr int PRODUCER_COUNT = 3;
+    constexpr int ITEMS_PER_PRODUCER = 1000;
+
+    Dispatcher dispatcher(32, Dispatcher::OverflowPolicy::Block);
+    std::atomic<int> counter = 0;
+
+    std::unique_ptr<Thread> producers[PRODUCER_COUNT];
+    for (auto& producer : producers) {
+        producer = std::make_unique<Thread>("producer", 4096, [&dispatcher, &counter] {
+            for (int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+                dispatcher.dispatch([&counter]() { counter++; });
+            }
+            return 0;
+        });
+        producer->start();
+    }
+
+    int consumed = 0;
+    while (consumed < PRODUCER_COUNT * ITEMS_PER_PRODUCER) {
+        consumed += dispatcher.consume(100);
+    }
+
+    for (auto& producer : producers) {
+        producer->join();
+    }
+
+    CHECK_EQ(counter, PRODUCER_COUNT * ITEMS_PER_PRODUCER);
+    CHECK_EQ(dispatcher.getStatistics().rejected, 0);
+    CHECK_LE(dispatcher.getStatistics().highWaterMark, 32);
+}
+
+TEST_CASE("bounded dispatcher with block policy should resume a waiting producer when space is made") {
+    Dispatcher dispatcher(2, Dispatcher::OverflowPolicy::Block);
+    CHECK(dispatcher.dispatch([]() { /* NO-OP */ }));
+    CHECK(dispatcher.dispatch([]() { /* NO-OP */ }));
+
+    std::atomic<bool> dispatched = false;
+    std::atomic<TickType_t> wait_ticks = 0;
+    Thread producer("producer", 4096, [&dispatcher, &dispatched, &wait_ticks] {
+        auto start_ticks = kernel::getTicks();
+        dispatched = dispatcher.dispatch([]() { /* NO-OP */ }, kernel::millisToTicks(5000));
+        wait_ticks = kernel::getTicks() - start_ticks;
+        return 0;
+    });
+    producer.start();
+
+    kernel::delayMillis(50);
+    CHECK_FALSE(dispatched);
+    CHECK_EQ(dispatcher.consume(100, 1), 1);
+    producer.join();
+
+    CHECK(dispatched);
+    // Woken by the consumer, not by the timeout
+    CHECK_LT(wait_ticks.load(), kernel::millisToTicks(1000));
+    CHECK_EQ(dispatcher.consume(100), 2);
+    CHECK_EQ(dispatcher.getStatistics().rejected, 0);
+}
@@ -2,6 +2,8 @@
 #include <Tactility/TactilityCore.h>
 #include <Tactility/Dispatcher.h>
 
+#include <vector>
+
 using namespace tt;
 
 TEST_CASE("dispatcher should not call callback if consume isn't called") {
@@ -36,3 +38,108 @@ TEST_CASE("message should be passed on correctly") {
     dispatcher.dispatch([]() { /* NO-OP */ });
     dispatcher.consume(100);
 }
+
+TEST_CASE("bounded dispatcher should call callback when consume is called") {
+    int counter = 0;
+    Dispatcher dispatcher(4);
+
+    CHECK(dispatcher.dispatch([&counter]() { counter++; }));
+    CHECK_EQ(dispatcher.consume(100), 1);
+
+    CHECK_EQ(counter, 1);
+}
+
+TEST_CASE("bounded dispatcher with reject policy should fail when full") {
+    Dispatcher dispatcher(2, Dispatcher::OverflowPolicy::Reject);
+
+    CHECK(dispatcher.dispatch([]() { /* NO-OP */ }));
+    CHECK(dispatcher.dispatch([]() { /* NO-OP */ }));
+    CHECK_FALSE(dispatcher.dispatch([]() { /* NO-OP */ }));
+
+    auto statistics = dispatcher.getStatistics();
+    CHECK_EQ(statistics.capacity, 2);
+    CHECK_EQ(statistics.pending, 2);
+    CHECK_EQ(statistics.highWaterMark, 2);
+    CHECK_EQ(statistics.rejected, 1);
+}
+
+TEST_CASE("bounded dispatcher with block policy should time out when full") {
+    Dispatcher dispatcher(2, Dispatcher::OverflowPolicy::Block);
+
+    CHECK(dispatcher.dispatch([]() { /* NO-OP */ }));
+    CHECK(dispatcher.dispatch([]() { /* NO-OP */ }));
+    CHECK_FALSE(dispatcher.dispatch([]() { /* NO-OP */ }, 5));
+    CHECK_EQ(dispatcher.getStatistics().rejected, 1);
+}
+
+TEST_CASE("dispatcher should consume in batches") {
+    int counter = 0;
+    Dispatcher dispatcher(8);
+
+    for (int i = 0; i < 5; i++) {
+        dispatcher.dispatch([&counter]() { counter++; });
+    }
+
+    CHECK_EQ(dispatcher.consume(100, 2), 2);
+    CHECK_EQ(counter, 2);
+    // Remaining items must not wait for a new signal
+    CHECK_EQ(dispatcher.consume(0), 3);
+    CHECK_EQ(counter, 5);
+    CHECK_EQ(dispatcher.getStatistics().pending, 0);
+    CHECK_EQ(dispatcher.getStatistics().highWaterMark, 5);
+}
+
+TEST_CASE("bounded dispatcher should preserve order") {
+    std::vector<int> values;
+    Dispatcher dispatcher(16);
+
+    for (int i = 0; i < 10; i++) {
+        dispatcher.dispatch([&values, i]() { values.push_back(i); });
+    }
+    dispatcher.consume(100);
+
+    REQUIRE_EQ(values.size(), 10);
+    for (int i = 0; i < 10; i++) {
+        CHECK_EQ(values[i], i);
+    }
+}
+
+TEST_CASE("bounded dispatcher with spill policy should preserve order when full") {
+    std::vector<int> values;
+    Dispatcher dispatcher(2, Dispatcher::OverflowPolicy::Spill);
+
+    for (int i = 0; i < 5; i++) {
+        CHECK(dispatcher.dispatch([&values, i]() { values.push_back(i); }));
+    }
+
+    auto statistics = dispatcher.getStatistics();
+    CHECK_EQ(statistics.pending, 5);
+    CHECK_EQ(statistics.spilled, 3);
+    CHECK_EQ(statistics.rejected, 0);
+
+    // Space in the ring doesn't let new functions overtake the spilled ones
+    CHECK_EQ(dispatcher.consume(100, 1), 1);
+    CHECK(dispatcher.dispatch([&values]() { values.push_back(5); }));
+
+    CHECK_EQ(dispatcher.consume(100), 5);
+    CHECK_EQ(values, std::vector<int> { 0, 1, 2, 3, 4, 5 });
+    CHECK_EQ(dispatcher.getStatistics().pending, 0);
+}
+
+TEST_CASE("bounded dispatcher with block policy should spill when the consumer dispatches to itself") {
+    std::vector<int> values;
+    Dispatcher dispatcher(2, Dispatcher::OverflowPolicy::Block);
+
+    CHECK(dispatcher.dispatch([&dispatcher, &values]() {
+        values.push_back(0);
+        for (int i = 2; i < 5; i++) {
+            CHECK(dispatcher.dispatch([&values, i]() { values.push_back(i); }));
+        }
+    }));
+    CHECK(dispatcher.dispatch([&values]() { values.push_back(1); }));
+
+    CHECK_EQ(dispatcher.consume(100), 5);
+    CHECK_EQ(values, std::vector<int> { 0, 1, 2, 3, 4 });
+    CHECK_EQ(dispatcher.getStatistics().spilled, 2);
+    CHECK_EQ(dispatcher.getStatistics().rejected, 0);
+}
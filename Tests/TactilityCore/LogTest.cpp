@@ -0,0 +1,233 @@
+#include "doctest.h"
+#include <Tactility/Log.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace tt;
+
+constexpr auto* TAG = "LogTest";
+
+/** Redirects stdout to a file, so the log output can be checked */
+class CapturedOutput {
+
+    const char* path;
+    int savedStdout;
+
+public:
+
+    explicit CapturedOutput(const char* path = "log_test.tmp") : path(path) {
+        fflush(stdout);
+        savedStdout = dup(STDOUT_FILENO);
+        int file = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        dup2(file, STDOUT_FILENO);
+        close(file);
+    }
+
+    ~CapturedOutput() {
+        restore();
+        remove(path);
+    }
+
+    void restore() {
+        if (savedStdout >= 0) {
+            fflush(stdout);
+            dup2(savedStdout, STDOUT_FILENO);
+            close(savedStdout);
+            savedStdout = -1;
+        }
+    }
+
+    std::string read() {
+        restore();
+        auto* file = fopen(path, "r");
+        std::string content;
+        char buffer[256];
+        size_t size;
+        while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            content.append(buffer, size);
+        }
+        fclose(file);
+        return content;
+    }
+};
+
+static void logMessages() {
+    std::string path = "/data/apps/one";
+    int64_t big = 1234567890123LL;
+    TT_LOG_I(TAG, "Registering app at %s", path.c_str());
+    TT_LOG_I(TAG, "values %d %u %ld %lld %zu %x %c %5.2f %% %p", -5, 7U, 123456L, (long long)big, (size_t)42, 255, 'z', 3.14159, (void*)0x1234);
+    TT_LOG_I(TAG, "width %*d|%-6s|%.*s", 4, 9, "ab", 3, "abcdef");
+    TT_LOG_W(TAG, "a long message that doesn't fit: %s %s", "0123456789012345678901234567890123456789", "0123456789012345678901234567890123456789012345678901234567890123456789");
+    TT_LOG_D(TAG, "null %s", (const char*)nullptr);
+}
+
+static const char* expectedMessages[] = {
+    "Registering app at /data/apps/one",
+    "values -5 7 123456 1234567890123 42 ff z  3.14 % 0x1234",
+    "width    9|ab    |abc",
+    "a long message that doesn't fit: 0123456789012345678901234567890123456789 0123456789012345678901234567890123456789012345678901234567890123456789",
+    "null (null)"
+};
+
+TEST_CASE("deferred log messages are the same as immediate ones") {
+    std::string immediate_output;
+    {
+        CapturedOutput output;
+        logMessages();
+        immediate_output = output.read();
+    }
+
+    std::string deferred_output;
+    auto statistics_before = getLogStatistics();
+    {
+        CapturedOutput output;
+        startLogThread();
+        logMessages();
+        flushLog();
+        stopLogThread();
+        deferred_output = output.read();
+    }
+    auto statistics_after = getLogStatistics();
+    // The long message doesn't fit in a record, so it is written right away
+    CHECK_EQ(statistics_after.deferred - statistics_before.deferred, 4);
+    CHECK_EQ(statistics_after.immediate - statistics_before.immediate, 1);
+
+    for (auto* message : expectedMessages) {
+        CHECK_NE(immediate_output.find(message), std::string::npos);
+        CHECK_NE(deferred_output.find(message), std::string::npos);
+    }
+
+    // Messages of the same task keep their order
+    CHECK_LT(immediate_output.find(expectedMessages[0]), immediate_output.find(expectedMessages[1]));
+    CHECK_LT(deferred_output.find(expectedMessages[0]), deferred_output.find(expectedMessages[1]));
+}
+
+TEST_CASE("deferred string arguments with a precision don't have to be terminated") {
+    // The text is at the end of a page that is followed by one that can't be read: reading past the text crashes
+    const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto* pages = static_cast<char*>(mmap(nullptr, page_size * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    REQUIRE_NE(pages, MAP_FAILED);
+    REQUIRE_EQ(mprotect(pages + page_size, page_size, PROT_NONE), 0);
+    char* text = pages + page_size - 6;
+    memcpy(text, "abcdef", 6);
+
+    auto statistics_before = getLogStatistics();
+    std::string output_text;
+    {
+        CapturedOutput output;
+        startLogThread();
+        TT_LOG_I(TAG, "unterminated %.*s|%.2s", 6, text, text + 4);
+        flushLog();
+        stopLogThread();
+        output_text = output.read();
+    }
+    munmap(pages, page_size * 2);
+
+    CHECK_EQ(getLogStatistics().deferred - statistics_before.deferred, 1);
+    CHECK_NE(output_text.find("unterminated abcdef|ef"), std::string::npos);
+}
+
+TEST_CASE("log levels can be set per tag") {
+    auto statistics_before = getLogStatistics();
+    std::string output_text;
+    {
+        CapturedOutput output;
+        setLogLevel(TAG, LogLevel::Warning);
+        TT_LOG_I(TAG, "hidden");
+        TT_LOG_W(TAG, "shown");
+        TT_LOG_I("OtherTag", "other");
+        setLogLevel(TAG, LogLevel::Verbose);
+        TT_LOG_I(TAG, "visible again");
+        output_text = output.read();
+    }
+
+    CHECK_EQ(getLogLevel(TAG), LogLevel::Verbose);
+    CHECK_EQ(getLogLevel("OtherTag"), getLogLevel(nullptr));
+    CHECK_EQ(output_text.find("hidden"), std::string::npos);
+    CHECK_NE(output_text.find("shown"), std::string::npos);
+    CHECK_NE(output_text.find("other"), std::string::npos);
+    CHECK_NE(output_text.find("visible again"), std::string::npos);
+    CHECK_EQ(getLogStatistics().filtered - statistics_before.filtered, 1);
+}
+
+TEST_CASE("errors are written right away") {
+    CapturedOutput output;
+    startLogThread();
+    auto statistics_before = getLogStatistics();
+    TT_LOG_E(TAG, "error %d", 1);
+    auto statistics_after = getLogStatistics();
+    stopLogThread();
+    CHECK_EQ(statistics_after.immediate - statistics_before.immediate, 1);
+    CHECK_EQ(statistics_after.deferred, statistics_before.deferred);
+    CHECK_NE(output.read().find("error 1"), std::string::npos);
+}
+
+/** The implementation before deferred logging */
+static void legacyLog(LogLevel level, const char* tag, const char* format, ...) {
+    std::stringstream buffer;
+    buffer << kernel::getMillis() << " [" << "\033[32m" << 'I' << "\033[0m" << "] [" << tag << "] " << "\033[0m" << format  << "\033[0m\n";
+
+    va_list args;
+    va_start(args, format);
+    vprintf(buffer.str().c_str(), args);
+    va_end(args);
+}
+
+TEST_CASE("log benchmark: per-call cost") {
+    constexpr int BATCH_SIZE = 200;
+    constexpr int BATCH_COUNT = 50;
+    constexpr int CALL_COUNT = BATCH_SIZE * BATCH_COUNT;
+    std::string path = "/sdcard/tactility/apps/one.app";
+    int64_t legacy_duration = 0;
+    int64_t immediate_duration = 0;
+    int64_t deferred_duration = 0;
+
+    {
+        // Write to /dev/null: on a device the output (UART, USB) would make the immediate calls even slower
+        CapturedOutput output("/dev/null");
+
+        for (int batch = 0; batch < BATCH_COUNT; batch++) {
+            auto start_time = kernel::getMicros();
+            for (int i = 0; i < BATCH_SIZE; i++) {
+                legacyLog(LogLevel::Info, TAG, "Registering app %d at %s (%lu bytes)", i, path.c_str(), 123456UL);
+            }
+            legacy_duration += kernel::getMicros() - start_time;
+        }
+
+        for (int batch = 0; batch < BATCH_COUNT; batch++) {
+            auto start_time = kernel::getMicros();
+            for (int i = 0; i < BATCH_SIZE; i++) {
+                TT_LOG_I(TAG, "Registering app %d at %s (%lu bytes)", i, path.c_str(), 123456UL);
+            }
+            immediate_duration += kernel::getMicros() - start_time;
+        }
+
+        startLogThread();
+        auto statistics_before = getLogStatistics();
+        for (int batch = 0; batch < BATCH_COUNT; batch++) {
+            auto start_time = kernel::getMicros();
+            for (int i = 0; i < BATCH_SIZE; i++) {
+                TT_LOG_I(TAG, "Registering app %d at %s (%lu bytes)", i, path.c_str(), 123456UL);
+            }
+            deferred_duration += kernel::getMicros() - start_time;
+            // Bursts: the log thread catches up in between
+            flushLog();
+        }
+        auto statistics_after = getLogStatistics();
+        stopLogThread();
+        CHECK_EQ(statistics_after.deferred - statistics_before.deferred, CALL_COUNT);
+        CHECK_EQ(statistics_after.dropped, statistics_before.dropped);
+    }
+
+    MESSAGE("legacy (stringstream + vprintf): ", (legacy_duration * 1000.0) / CALL_COUNT, " ns/call");
+    MESSAGE("immediate: ", (immediate_duration * 1000.0) / CALL_COUNT, " ns/call");
+    MESSAGE("deferred: ", (deferred_duration * 1000.0) / CALL_COUNT, " ns/call");
+}
@@ -33,3 +33,130 @@ TEST_CASE("PubSub unsubscribed subscription does not receive published data") {
 
     CHECK_EQ(value, 0);
 }
+
+TEST_CASE("PubSub subscriber can publish from within its callback") {
+    PubSub<int> pubsub;
+    int value = 0;
+
+    auto subscription = pubsub.subscribe([&pubsub, &value](auto newValue) {
+        value = newValue;
+        if (newValue < 3) {
+            pubsub.publish(newValue + 1);
+        }
+    });
+    pubsub.publish(1);
+
+    CHECK_EQ(value, 3);
+    pubsub.unsubscribe(subscription);
+}
+
+TEST_CASE("PubSub subscriber can unsubscribe from within its callback") {
+    PubSub<int> pubsub;
+    int counter = 0;
+    PubSub<int>::SubscriptionHandle subscription = nullptr;
+
+    subscription = pubsub.subscribe([&pubsub, &counter, &subscription](auto) {
+        counter++;
+        pubsub.unsubscribe(subscription);
+    });
+    pubsub.publish(1);
+    pubsub.publish(2);
+
+    CHECK_EQ(counter, 1);
+    CHECK_EQ(pubsub.getSubscriptionCount(), 0);
+}
+
+TEST_CASE("PubSub subscriber can unsubscribe an outer subscription from a nested callback") {
+    PubSub<int> outer_pubsub;
+    PubSub<int> inner_pubsub;
+    int counter = 0;
+    PubSub<int>::SubscriptionHandle outer_subscription = nullptr;
+
+    outer_subscription = outer_pubsub.subscribe([&inner_pubsub, &counter](auto value) {
+        counter++;
+        inner_pubsub.publish(value);
+    });
+    auto inner_subscription = inner_pubsub.subscribe([&outer_pubsub, &outer_subscription](auto) {
+        outer_pubsub.unsubscribe(outer_subscription);
+    });
+    outer_pubsub.publish(1);
+    outer_pubsub.publish(2);
+
+    CHECK_EQ(counter, 1);
+    CHECK_EQ(outer_pubsub.getSubscriptionCount(), 0);
+    inner_pubsub.unsubscribe(inner_subscription);
+}
+
+TEST_CASE("PubSub re-entered subscriber can unsubscribe from within its callback") {
+    PubSub<int> pubsub;
+    int counter = 0;
+    PubSub<int>::SubscriptionHandle subscription = nullptr;
+
+    subscription = pubsub.subscribe([&pubsub, &counter, &subscription](auto value) {
+        counter++;
+        if (value < 3) {
+            pubsub.publish(value + 1);
+        } else {
+            pubsub.unsubscribe(subscription);
+        }
+    });
+    pubsub.publish(1);
+    pubsub.publish(1);
+
+    CHECK_EQ(counter, 3);
+    CHECK_EQ(pubsub.getSubscriptionCount(), 0);
+}
+
+TEST_CASE("PubSub subscription added during publish does not receive the current message") {
+    PubSub<int> pubsub;
+    int late_value = 0;
+    PubSub<int>::SubscriptionHandle late_subscription = nullptr;
+
+    auto subscription = pubsub.subscribe([&](auto) {
+        if (late_subscription == nullptr) {
+            late_subscription = pubsub.subscribe([&late_value](auto newValue) {
+                late_value = newValue;
+            });
+        }
+    });
+    pubsub.publish(1);
+    CHECK_EQ(late_value, 0);
+
+    pubsub.publish(2);
+    CHECK_EQ(late_value, 2);
+
+    pubsub.unsubscribe(subscription);
+    pubsub.unsubscribe(late_subscription);
+}
+
+TEST_CASE("PubSub async subscription receives data through its dispatcher") {
+    PubSub<int> pubsub;
+    Dispatcher dispatcher;
+    int value = 0;
+
+    auto subscription = pubsub.subscribe([&value](auto newValue) {
+        value = newValue;
+    }, dispatcher);
+    pubsub.publish(1);
+    CHECK_EQ(value, 0);
+
+    dispatcher.consume(100);
+    CHECK_EQ(value, 1);
+
+    pubsub.unsubscribe(subscription);
+}
+
+TEST_CASE("PubSub async subscription drops queued data after unsubscribe") {
+    PubSub<int> pubsub;
+    Dispatcher dispatcher;
+    int value = 0;
+
+    auto subscription = pubsub.subscribe([&value](auto newValue) {
+        value = newValue;
+    }, dispatcher);
+    pubsub.publish(1);
+    pubsub.unsubscribe(subscription);
+
+    dispatcher.consume(100);
+    CHECK_EQ(value, 0);
+}
@@ -9,7 +9,8 @@ def generate(csv_file, header_file, header_namespace, data_path):
     if os.path.isfile(csv_file_path):
         print(f"Processing {csv_file}")
         script_path = f"{get_project_root()}/Translations/generate.py"
-        os.system(f"python {script_path} {csv_file} {header_file} {header_namespace} {data_path}")
+        # System translations use the binary format, which is faster to load
+        os.system(f"python {script_path} {csv_file} {header_file} {header_namespace} {data_path} binary")
     else:
         print(f"Skipping {csv_file} (not found)")
 
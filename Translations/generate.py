@@ -1,4 +1,5 @@
 import csv
+import struct
 import sys
 from pathlib import Path
 from typing import List
@@ -30,24 +31,47 @@ def load_csv(path: str, delimiter: str = ",", quotechar: str = '"', encoding: st
     return rows
 
 def print_help():
-    print("Usage: python generate.py [csv_file] [header_file_path] [header_namespace] [i18n_directory]\n\n")
+    print("Usage: python generate.py [csv_file] [header_file_path] [header_namespace] [i18n_directory] [format]\n\n")
     print("\t[csv_file]            the CSV file containing the translations, exported from the .ods file")
     print("\t[header_file_path]    the path to the header file to be generated")
     print("\t[header_namespace]    the C++ namespace to use for the generated header file")
     print("\t[i18n_directory]      the directory where the .i18n files will be generated")
+    print("\t[format]              optional: \"text\" for .i18n files (default), \"binary\" for .i18nb files or \"both\"")
 
-def open_i18n_files(row, i18n_path):
+def get_translations(rows, language_index):
     result = []
-    for i in range(1, len(row)):
-        filepath = f"{i18n_path}/{row[i]}.i18n"
-        print(f"Opening {filepath}")
-        file = open(filepath, "w")
-        result.append(file)
+    for i in range(1, len(rows)):
+        value = rows[i][language_index]
+        if value == "":
+            value = f"{rows[i][0]}_untranslated"
+        result.append(value)
     return result
 
-def close_i18n_files(files):
-    for file in files:
-        file.close()
+def write_text_file(filepath, translations):
+    print(f"Writing {filepath}")
+    with open(filepath, "w", encoding="utf-8") as file:
+        for translation in translations:
+            file.write(translation)
+            file.write("\n")
+
+def write_binary_file(filepath, translations):
+    """
+    Write a string table that TextResources can use without parsing (all values are little-endian):
+    - header: magic "TTI1", u16 version (1), u16 reserved (0), u32 string count, u32 blob size
+    - offsets: u32 offset into the blob for every string, followed by the blob size
+    - blob: the null-terminated UTF-8 strings
+    """
+    blob = bytearray()
+    offsets = []
+    for translation in translations:
+        offsets.append(len(blob))
+        blob += translation.encode("utf-8") + b"\0"
+    offsets.append(len(blob))
+    print(f"Writing {filepath}")
+    with open(filepath, "wb") as file:
+        file.write(struct.pack("<4sHHII", b"TTI1", 1, 0, len(translations), len(blob)))
+        file.write(struct.pack(f"<{len(offsets)}I", *offsets))
+        file.write(blob)
 
 def generate_header(filepath, namespace, rows):
     file = open(filepath, "w")
@@ -64,21 +88,17 @@ def generate_header(filepath, namespace, rows):
     file.write("\n}\n")
     file.close()
 
-def translate(rows, language_index, file):
-    for i in range(1, len(rows)):
-        value = rows[i][language_index]
-        if value == "":
-            value = f"{rows[i][0]}_untranslated"
-        file.write(value)
-        file.write("\n")
-
 if __name__ == "__main__":
     if "--help" in sys.argv:
         print_help()
         sys.exit()
-    if len(sys.argv) != 5:
+    if len(sys.argv) != 5 and len(sys.argv) != 6:
         print_help()
         sys.exit()
+    output_format = sys.argv[5] if len(sys.argv) == 6 else "text"
+    if output_format not in ["text", "binary", "both"]:
+        print_help()
+        sys.exit(1)
     project_root_path = get_project_root()
     csv_file = f"{project_root_path}/Translations/{sys.argv[1]}"
     header_path = f"{project_root_path}/{sys.argv[2]}"
@@ -89,8 +109,10 @@ if __name__ == "__main__":
         print("Error: CSV file is empty.")
         sys.exit(1)
     generate_header(header_path, header_namespace, rows)
-    i18n_files = open_i18n_files(rows[0], i18n_path)
-    for i in range(0, len(i18n_files)):
-        i18n_file = i18n_files[i]
-        translate(rows, i + 1, i18n_file)
-    close_i18n_files(i18n_files)
+    for language_index in range(1, len(rows[0])):
+        locale = rows[0][language_index]
+        translations = get_translations(rows, language_index)
+        if output_format != "binary":
+            write_text_file(f"{i18n_path}/{locale}.i18n", translations)
+        if output_format != "text":
+            write_binary_file(f"{i18n_path}/{locale}.i18nb", translations)